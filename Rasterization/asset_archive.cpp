@@ -0,0 +1,475 @@
+#include "asset_archive.h"
+#include "deflate.h"
+#include "job_system.h"
+#include "lz4.h"
+
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <cstdio>
+#include <cstring>
+#include <filesystem>
+#include <functional>
+#include <iostream>
+#include <thread>
+
+#ifdef _WIN32
+#define WIN32_LEAN_AND_MEAN
+#define NOMINMAX
+#include <windows.h>
+#else
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#endif
+
+using namespace std;
+namespace fs = std::filesystem;
+
+typedef chrono::high_resolution_clock Clock;
+
+static_assert(sizeof(ArchiveHeader) == 48 && sizeof(ArchiveEntry) == 40 && sizeof(ArchiveChunk) == 16,
+	"the archive structs are the file layout");
+
+uint64_t hashAssetName(const string& name)
+{
+	uint64_t hash = 14695981039346656037ull;
+	for (char c : name)
+	{
+		hash ^= (uint8_t)c;
+		hash *= 1099511628211ull;
+	}
+	return hash;
+}
+
+static uint64_t alignUp(uint64_t value, uint64_t alignment)
+{
+	return (value + alignment - 1) / alignment * alignment;
+}
+
+AssetArchiveBuilder::AssetArchiveBuilder(uint32_t chunkSize, uint32_t alignment)
+	: chunkSize(max<uint32_t>(chunkSize, 1024)), alignment(min<uint32_t>(max<uint32_t>(alignment, 1), 4096))
+{
+}
+
+void AssetArchiveBuilder::add(const string& name, vector<uint8_t> bytes)
+{
+	assets.push_back({ name, move(bytes) });
+}
+
+bool AssetArchiveBuilder::addFile(const string& name, const string& path)
+{
+	FILE* file = fopen(path.c_str(), "rb");
+	if (!file)
+	{
+		cout << "ERROR::ARCHIVE::FILE_NOT_READ " << path << endl;
+		return false;
+	}
+	vector<uint8_t> bytes;
+	uint8_t buffer[65536];
+	size_t read;
+	while ((read = fread(buffer, 1, sizeof(buffer), file)) > 0)
+		bytes.insert(bytes.end(), buffer, buffer + read);
+	bool ok = !ferror(file);
+	fclose(file);
+	if (!ok)
+	{
+		cout << "ERROR::ARCHIVE::FILE_NOT_READ " << path << endl;
+		return false;
+	}
+	add(name, move(bytes));
+	return true;
+}
+
+bool AssetArchiveBuilder::addDirectory(const string& directory)
+{
+	error_code error;
+	vector<fs::path> files;
+	for (fs::recursive_directory_iterator it(directory, error), end; !error && it != end; it.increment(error))
+		if (it->is_regular_file(error))
+			files.push_back(it->path());
+	if (error)
+	{
+		cout << "ERROR::ARCHIVE::DIRECTORY_NOT_READ " << directory << ": " << error.message() << endl;
+		return false;
+	}
+	// the order the iterator gives is the file system's; sort so the same
+	// directory always makes the same archive
+	sort(files.begin(), files.end());
+	for (const fs::path& file : files)
+		if (!addFile(file.lexically_relative(directory).generic_string(), file.string()))
+			return false;
+	return true;
+}
+
+bool AssetArchiveBuilder::write(const string& path, JobSystem* jobs, Stats* stats) const
+{
+	auto start = Clock::now();
+
+	// the table of contents in hash order, names breaking ties so the order
+	// and the duplicate check don't depend on the order of add()
+	vector<uint32_t> order(assets.size());
+	vector<uint64_t> hashes(assets.size());
+	for (size_t i = 0; i < assets.size(); i++)
+	{
+		order[i] = (uint32_t)i;
+		hashes[i] = hashAssetName(assets[i].name);
+	}
+	sort(order.begin(), order.end(), [&](uint32_t a, uint32_t b)
+	{
+		return hashes[a] != hashes[b] ? hashes[a] < hashes[b] : assets[a].name < assets[b].name;
+	});
+	for (size_t i = 1; i < order.size(); i++)
+	{
+		if (assets[order[i]].name == assets[order[i - 1]].name)
+		{
+			cout << "ERROR::ARCHIVE::DUPLICATE_NAME " << assets[order[i]].name << endl;
+			return false;
+		}
+	}
+
+	vector<ArchiveEntry> entries(assets.size());
+	struct ChunkSource
+	{
+		const uint8_t* data;
+		uint32_t bytes;
+	};
+	vector<ChunkSource> sources;
+	string names;
+	for (size_t i = 0; i < order.size(); i++)
+	{
+		const Asset& asset = assets[order[i]];
+		ArchiveEntry& entry = entries[i];
+		entry.nameHash = hashes[order[i]];
+		entry.size = asset.bytes.size();
+		entry.firstChunk = (uint32_t)sources.size();
+		entry.chunkCount = (uint32_t)((asset.bytes.size() + chunkSize - 1) / chunkSize);
+		entry.nameOffset = (uint32_t)names.size();
+		entry.nameLength = (uint32_t)asset.name.size();
+		entry.crc32 = crc32(0, asset.bytes.data(), asset.bytes.size());
+		entry.flags = 0;
+		names += asset.name;
+		for (size_t offset = 0; offset < asset.bytes.size(); offset += chunkSize)
+			sources.push_back({ asset.bytes.data() + offset, (uint32_t)min<size_t>(chunkSize, asset.bytes.size() - offset) });
+	}
+
+	// each chunk into its own buffer, empty when it stays uncompressed
+	vector<vector<uint8_t>> compressed(sources.size());
+	auto compressChunks = [&](size_t begin, size_t end)
+	{
+		for (size_t i = begin; i < end; i++)
+		{
+			size_t bytes = lz4Compress(sources[i].data, sources[i].bytes, compressed[i]);
+			if (bytes > sources[i].bytes - sources[i].bytes / 16)
+				vector<uint8_t>().swap(compressed[i]);
+		}
+	};
+	if (jobs)
+		jobs->parallelFor(0, sources.size(), compressChunks, 1);
+	else
+		compressChunks(0, sources.size());
+
+	ArchiveHeader header = {};
+	header.magic = ARCHIVE_MAGIC;
+	header.version = ARCHIVE_VERSION;
+	header.assetCount = (uint32_t)entries.size();
+	header.chunkCount = (uint32_t)sources.size();
+	header.chunkSize = chunkSize;
+	header.alignment = alignment;
+	header.namesOffset = sizeof(ArchiveHeader) + entries.size() * sizeof(ArchiveEntry) + sources.size() * sizeof(ArchiveChunk);
+	header.namesBytes = names.size();
+
+	vector<ArchiveChunk> chunks(sources.size());
+	uint64_t offset = header.namesOffset + header.namesBytes;
+	size_t storedChunks = 0;
+	for (ArchiveEntry& entry : entries)
+	{
+		offset = alignUp(offset, alignment);
+		bool stored = true;
+		for (uint32_t i = entry.firstChunk; i < entry.firstChunk + entry.chunkCount; i++)
+		{
+			chunks[i].offset = offset;
+			chunks[i].rawBytes = sources[i].bytes;
+			chunks[i].storedBytes = compressed[i].empty() ? sources[i].bytes : (uint32_t)compressed[i].size();
+			offset += chunks[i].storedBytes;
+			stored = stored && compressed[i].empty();
+			storedChunks += compressed[i].empty();
+		}
+		entry.flags = stored ? ARCHIVE_ENTRY_STORED : 0;
+	}
+	header.fileBytes = offset;
+
+	// a temporary name first, so a reader never maps half an archive
+	string temporary = path + "." + to_string(hash<thread::id>()(this_thread::get_id())) + ".tmp";
+	FILE* file = fopen(temporary.c_str(), "wb");
+	if (!file)
+	{
+		cout << "ERROR::ARCHIVE::FILE_NOT_WRITTEN " << path << endl;
+		return false;
+	}
+	bool ok = fwrite(&header, sizeof(header), 1, file) == 1
+		&& fwrite(entries.data(), sizeof(ArchiveEntry), entries.size(), file) == entries.size()
+		&& fwrite(chunks.data(), sizeof(ArchiveChunk), chunks.size(), file) == chunks.size()
+		&& fwrite(names.data(), 1, names.size(), file) == names.size();
+	uint64_t written = header.namesOffset + header.namesBytes;
+	static const uint8_t zeros[4096] = {};
+	for (size_t i = 0; i < chunks.size() && ok; i++)
+	{
+		if (chunks[i].offset > written)
+			ok = fwrite(zeros, 1, (size_t)(chunks[i].offset - written), file) == chunks[i].offset - written;
+		const uint8_t* data = compressed[i].empty() ? sources[i].data : compressed[i].data();
+		ok = ok && fwrite(data, 1, chunks[i].storedBytes, file) == chunks[i].storedBytes;
+		written = chunks[i].offset + chunks[i].storedBytes;
+	}
+	ok = fclose(file) == 0 && ok;
+	error_code error;
+	if (ok)
+		fs::rename(temporary, path, error);
+	if (!ok || error)
+	{
+		fs::remove(temporary, error);
+		cout << "ERROR::ARCHIVE::FILE_NOT_WRITTEN " << path << endl;
+		return false;
+	}
+
+	if (stats)
+	{
+		stats->assets = entries.size();
+		stats->chunks = chunks.size();
+		stats->storedChunks = storedChunks;
+		stats->rawBytes = 0;
+		for (const Asset& asset : assets)
+			stats->rawBytes += asset.bytes.size();
+		stats->fileBytes = header.fileBytes;
+		stats->milliseconds = chrono::duration<double, milli>(Clock::now() - start).count();
+	}
+	return true;
+}
+
+AssetArchive::~AssetArchive()
+{
+	close();
+}
+
+bool AssetArchive::open(const string& path)
+{
+	close();
+#ifdef _WIN32
+	HANDLE file = CreateFileA(path.c_str(), GENERIC_READ, FILE_SHARE_READ, nullptr, OPEN_EXISTING,
+		FILE_ATTRIBUTE_NORMAL, nullptr);
+	if (file == INVALID_HANDLE_VALUE)
+	{
+		cout << "ERROR::ARCHIVE::FILE_NOT_OPENED " << path << endl;
+		return false;
+	}
+	LARGE_INTEGER fileSize;
+	HANDLE mapping = nullptr;
+	const void* view = nullptr;
+	if (GetFileSizeEx(file, &fileSize) && fileSize.QuadPart > 0)
+		mapping = CreateFileMappingA(file, nullptr, PAGE_READONLY, 0, 0, nullptr);
+	if (mapping)
+		view = MapViewOfFile(mapping, FILE_MAP_READ, 0, 0, 0);
+	if (!view)
+	{
+		if (mapping)
+			CloseHandle(mapping);
+		CloseHandle(file);
+		cout << "ERROR::ARCHIVE::FILE_NOT_MAPPED " << path << endl;
+		return false;
+	}
+	fileHandle = file;
+	mappingHandle = mapping;
+	base = (const uint8_t*)view;
+	mappedBytes = (size_t)fileSize.QuadPart;
+#else
+	int file = ::open(path.c_str(), O_RDONLY);
+	if (file < 0)
+	{
+		cout << "ERROR::ARCHIVE::FILE_NOT_OPENED " << path << endl;
+		return false;
+	}
+	struct stat status;
+	void* view = MAP_FAILED;
+	if (fstat(file, &status) == 0 && status.st_size > 0)
+		view = mmap(nullptr, (size_t)status.st_size, PROT_READ, MAP_SHARED, file, 0);
+	// the mapping keeps the file open
+	::close(file);
+	if (view == MAP_FAILED)
+	{
+		cout << "ERROR::ARCHIVE::FILE_NOT_MAPPED " << path << endl;
+		return false;
+	}
+	base = (const uint8_t*)view;
+	mappedBytes = (size_t)status.st_size;
+#endif
+
+	// nothing below trusts the file further than these checks
+	const ArchiveHeader* h = (const ArchiveHeader*)base;
+	uint64_t tableEnd = 0;
+	bool ok = mappedBytes >= sizeof(ArchiveHeader) && h->magic == ARCHIVE_MAGIC && h->version == ARCHIVE_VERSION
+		&& h->fileBytes == mappedBytes && h->chunkSize > 0 && h->alignment > 0;
+	if (ok)
+	{
+		tableEnd = sizeof(ArchiveHeader) + (uint64_t)h->assetCount * sizeof(ArchiveEntry)
+			+ (uint64_t)h->chunkCount * sizeof(ArchiveChunk);
+		ok = h->namesOffset == tableEnd && h->namesBytes <= mappedBytes - min<uint64_t>(tableEnd, mappedBytes)
+			&& tableEnd <= mappedBytes;
+	}
+	if (ok)
+	{
+		header = h;
+		entries = (const ArchiveEntry*)(base + sizeof(ArchiveHeader));
+		chunks = (const ArchiveChunk*)(entries + h->assetCount);
+		names = (const char*)(base + h->namesOffset);
+		uint64_t dataStart = h->namesOffset + h->namesBytes;
+		for (uint32_t i = 0; i < h->chunkCount && ok; i++)
+		{
+			const ArchiveChunk& chunk = chunks[i];
+			ok = chunk.rawBytes > 0 && chunk.rawBytes <= h->chunkSize && chunk.storedBytes <= chunk.rawBytes
+				&& chunk.offset >= dataStart && chunk.offset <= mappedBytes && chunk.storedBytes <= mappedBytes - chunk.offset;
+		}
+		uint32_t nextChunk = 0;
+		for (uint32_t i = 0; i < h->assetCount && ok; i++)
+		{
+			const ArchiveEntry& entry = entries[i];
+			ok = (i == 0 || entries[i - 1].nameHash <= entry.nameHash)
+				&& entry.firstChunk == nextChunk && entry.chunkCount <= h->chunkCount - entry.firstChunk
+				&& (uint64_t)entry.nameOffset + entry.nameLength <= h->namesBytes;
+			uint64_t bytes = 0;
+			for (uint32_t c = 0; c < entry.chunkCount && ok; c++)
+			{
+				const ArchiveChunk& chunk = chunks[entry.firstChunk + c];
+				// every chunk but the last is full, and a stored asset's
+				// chunks follow each other so storedData() is one range
+				ok = (c + 1 == entry.chunkCount || chunk.rawBytes == h->chunkSize)
+					&& (!(entry.flags & ARCHIVE_ENTRY_STORED) || (chunk.storedBytes == chunk.rawBytes
+					&& chunk.offset == chunks[entry.firstChunk].offset + bytes));
+				bytes += chunk.rawBytes;
+			}
+			ok = ok && bytes == entry.size;
+			nextChunk = entry.firstChunk + entry.chunkCount;
+		}
+		ok = ok && nextChunk == h->chunkCount;
+	}
+	if (!ok)
+	{
+		cout << "ERROR::ARCHIVE::INVALID_FILE " << path << endl;
+		close();
+		return false;
+	}
+	return true;
+}
+
+void AssetArchive::close()
+{
+	if (!base)
+		return;
+#ifdef _WIN32
+	UnmapViewOfFile(base);
+	CloseHandle((HANDLE)mappingHandle);
+	CloseHandle((HANDLE)fileHandle);
+	fileHandle = nullptr;
+	mappingHandle = nullptr;
+#else
+	munmap((void*)base, mappedBytes);
+#endif
+	base = nullptr;
+	mappedBytes = 0;
+	header = nullptr;
+	entries = nullptr;
+	chunks = nullptr;
+	names = nullptr;
+}
+
+uint32_t AssetArchive::find(const string& name) const
+{
+	if (!header)
+		return NOT_FOUND;
+	uint64_t hash = hashAssetName(name);
+	const ArchiveEntry* end = entries + header->assetCount;
+	const ArchiveEntry* it = lower_bound(entries, end, hash,
+		[](const ArchiveEntry& entry, uint64_t h) { return entry.nameHash < h; });
+	// names of the same hash are next to each other
+	for (; it != end && it->nameHash == hash; ++it)
+	{
+		if (it->nameLength == name.size() && memcmp(names + it->nameOffset, name.data(), name.size()) == 0)
+			return (uint32_t)(it - entries);
+	}
+	return NOT_FOUND;
+}
+
+string AssetArchive::name(uint32_t asset) const
+{
+	return string(names + entries[asset].nameOffset, entries[asset].nameLength);
+}
+
+const uint8_t* AssetArchive::storedData(uint32_t asset) const
+{
+	const ArchiveEntry& entry = entries[asset];
+	if (!(entry.flags & ARCHIVE_ENTRY_STORED))
+		return nullptr;
+	return entry.chunkCount ? base + chunks[entry.firstChunk].offset : base;
+}
+
+bool AssetArchive::readChunk(const ArchiveChunk& chunk, uint8_t* out) const
+{
+	if (chunk.storedBytes == chunk.rawBytes)
+	{
+		memcpy(out, base + chunk.offset, chunk.rawBytes);
+		return true;
+	}
+	return lz4Decompress(base + chunk.offset, chunk.storedBytes, out, chunk.rawBytes);
+}
+
+bool AssetArchive::read(uint32_t asset, uint8_t* out, JobSystem* jobs) const
+{
+	return read(&asset, &out, 1, jobs);
+}
+
+bool AssetArchive::read(uint32_t asset, vector<uint8_t>& out, JobSystem* jobs) const
+{
+	out.resize(size(asset));
+	return read(asset, out.data(), jobs);
+}
+
+bool AssetArchive::read(const uint32_t* assets, uint8_t* const* outs, size_t count, JobSystem* jobs) const
+{
+	// where each chunk goes: the assets' chunks numbered one after another
+	vector<size_t> firstIndex(count + 1, 0);
+	for (size_t i = 0; i < count; i++)
+		firstIndex[i + 1] = firstIndex[i] + entries[assets[i]].chunkCount;
+	atomic<bool> ok{ true };
+	auto readChunks = [&](size_t begin, size_t end)
+	{
+		size_t i = upper_bound(firstIndex.begin(), firstIndex.end(), begin) - firstIndex.begin() - 1;
+		for (size_t index = begin; index < end; index++)
+		{
+			while (index >= firstIndex[i + 1])
+				i++;
+			size_t c = index - firstIndex[i];
+			const ArchiveEntry& entry = entries[assets[i]];
+			if (!readChunk(chunks[entry.firstChunk + c], outs[i] + c * header->chunkSize))
+				ok.store(false, memory_order_relaxed);
+		}
+	};
+	if (jobs && firstIndex[count] > 1)
+		jobs->parallelFor(0, firstIndex[count], readChunks, 1);
+	else
+		readChunks(0, firstIndex[count]);
+	return ok.load();
+}
+
+bool AssetArchive::verify(JobSystem* jobs) const
+{
+	vector<uint8_t> bytes;
+	for (uint32_t asset = 0; asset < count(); asset++)
+	{
+		if (!read(asset, bytes, jobs) || crc32(0, bytes.data(), bytes.size()) != entries[asset].crc32)
+		{
+			cout << "ERROR::ARCHIVE::CORRUPT_ASSET " << name(asset) << endl;
+			return false;
+		}
+	}
+	return true;
+}
@@ -0,0 +1,164 @@
+#ifndef ASSET_ARCHIVE_H
+#define ASSET_ARCHIVE_H
+
+#include <cstddef>
+#include <cstdint>
+#include <string>
+#include <vector>
+
+class JobSystem;
+
+// Layout of an archive file, every field little-endian:
+//   ArchiveHeader
+//   ArchiveEntry[assetCount], sorted by nameHash
+//   ArchiveChunk[chunkCount], each asset's chunks one after another
+//   the names, not terminated, at namesOffset
+//   the chunk data: an asset's chunks back to back, starting on a multiple of
+//   alignment, so a stored asset can go to glBufferSubData or a texture
+//   upload straight from the mapping
+// Assets are cut into chunkSize pieces compressed with LZ4 each, so one asset
+// decompresses on as many threads as it has chunks. A chunk that LZ4 can't
+// shrink by at least 1/16 is stored as it is.
+const uint32_t ARCHIVE_MAGIC = 0x4b415041;		// "APAK"
+const uint32_t ARCHIVE_VERSION = 1;
+
+struct ArchiveHeader
+{
+	uint32_t magic;
+	uint32_t version;
+	uint32_t assetCount;
+	uint32_t chunkCount;
+	uint32_t chunkSize;
+	uint32_t alignment;
+	uint64_t namesOffset;
+	uint64_t namesBytes;
+	uint64_t fileBytes;		// catches a truncated file
+};
+
+struct ArchiveEntry
+{
+	uint64_t nameHash;		// 64-bit FNV-1a of the name
+	uint64_t size;			// uncompressed
+	uint32_t firstChunk;
+	uint32_t chunkCount;
+	uint32_t nameOffset;	// into the names
+	uint32_t nameLength;
+	uint32_t crc32;			// of the uncompressed bytes, for verify()
+	uint32_t flags;
+};
+
+// every chunk of the asset is stored uncompressed: storedData() has it
+const uint32_t ARCHIVE_ENTRY_STORED = 1;
+
+struct ArchiveChunk
+{
+	uint64_t offset;		// from the start of the file
+	uint32_t storedBytes;	// rawBytes when stored, else the LZ4 block's size
+	uint32_t rawBytes;
+};
+
+// Collects assets and writes them into an archive. Names are what
+// AssetArchive::find() takes, for files of a directory their path under it
+// with forward slashes. Alignment is at most 4096.
+class AssetArchiveBuilder
+{
+public:
+	explicit AssetArchiveBuilder(uint32_t chunkSize = 64 * 1024, uint32_t alignment = 64);
+
+	void add(const std::string& name, std::vector<uint8_t> bytes);
+	bool addFile(const std::string& name, const std::string& path);
+	// every regular file under directory, recursively
+	bool addDirectory(const std::string& directory);
+
+	size_t count() const { return assets.size(); }
+
+	struct Stats
+	{
+		size_t assets = 0;
+		size_t chunks = 0;
+		size_t storedChunks = 0;	// left uncompressed
+		uint64_t rawBytes = 0;
+		uint64_t fileBytes = 0;
+		double milliseconds = 0.0;
+	};
+
+	// Compresses the chunks, on every thread of jobs when given, and writes
+	// the archive under a temporary name renamed to path when it is
+	// complete. Fails on two assets of the same name. Call it from the
+	// thread that made the job system.
+	bool write(const std::string& path, JobSystem* jobs = nullptr, Stats* stats = nullptr) const;
+
+private:
+	struct Asset
+	{
+		std::string name;
+		std::vector<uint8_t> bytes;
+	};
+
+	uint32_t chunkSize;
+	uint32_t alignment;
+	std::vector<Asset> assets;
+};
+
+// An archive mapped into memory read-only, so opening it reads nothing but
+// the header and the table of contents and the pages of an asset are only
+// read from disk when it is. find() is a binary search on the name's hash.
+// Everything is const and safe to use from several threads once open.
+class AssetArchive
+{
+public:
+	static const uint32_t NOT_FOUND = 0xffffffffu;
+
+	AssetArchive() = default;
+	~AssetArchive();
+
+	AssetArchive(const AssetArchive&) = delete;
+	AssetArchive& operator=(const AssetArchive&) = delete;
+
+	// maps path and checks the header, that the table of contents is sorted
+	// and every chunk and name lies inside the file
+	bool open(const std::string& path);
+	void close();
+	bool isOpen() const { return base != nullptr; }
+
+	uint32_t count() const { return header ? header->assetCount : 0; }
+	uint32_t find(const std::string& name) const;
+	std::string name(uint32_t asset) const;
+	size_t size(uint32_t asset) const { return (size_t)entries[asset].size; }
+
+	// the asset's bytes in the mapping when it is stored uncompressed,
+	// nullptr when it has to be read()
+	const uint8_t* storedData(uint32_t asset) const;
+
+	// decompresses the asset into size(asset) bytes at out, its chunks spread
+	// over the threads of jobs when given; false when a chunk is corrupt
+	bool read(uint32_t asset, uint8_t* out, JobSystem* jobs = nullptr) const;
+	bool read(uint32_t asset, std::vector<uint8_t>& out, JobSystem* jobs = nullptr) const;
+	// count assets at once, the chunks of all of them spread over the threads,
+	// which keeps every thread busy when the assets are small
+	bool read(const uint32_t* assets, uint8_t* const* outs, size_t count, JobSystem* jobs = nullptr) const;
+
+	// decompresses everything and checks it against the stored CRC-32s
+	bool verify(JobSystem* jobs = nullptr) const;
+
+	size_t fileBytes() const { return mappedBytes; }
+
+private:
+	bool readChunk(const ArchiveChunk& chunk, uint8_t* out) const;
+
+	const uint8_t* base = nullptr;
+	size_t mappedBytes = 0;
+	const ArchiveHeader* header = nullptr;
+	const ArchiveEntry* entries = nullptr;
+	const ArchiveChunk* chunks = nullptr;
+	const char* names = nullptr;
+#ifdef _WIN32
+	void* fileHandle = nullptr;
+	void* mappingHandle = nullptr;
+#endif
+};
+
+// the hash find() looks names up by
+uint64_t hashAssetName(const std::string& name);
+
+#endif
@@ -0,0 +1,301 @@
+#include "asset_archive.h"
+#include "benchmarks.h"
+#include "frame_encoder.h"
+#include "job_system.h"
+#include "lz4.h"
+
+#include <algorithm>
+#include <chrono>
+#include <cmath>
+#include <cstdio>
+#include <filesystem>
+#include <iostream>
+#include <string>
+#include <thread>
+#include <vector>
+
+using namespace std;
+namespace fs = std::filesystem;
+
+typedef chrono::high_resolution_clock Clock;
+
+// what a game's data directory holds, a quarter each: shader and level text,
+// raw RGBA texels, QOI images and bytes that don't compress at all, from a
+// few hundred bytes to over a hundred KB
+static void makeAsset(int index, uint32_t& random, vector<uint8_t>& bytes)
+{
+	auto next = [&random]()
+	{
+		random = random * 1664525u + 1013904223u;
+		return random >> 8;
+	};
+	size_t size = (size_t)256 << (next() % 9);
+	size += next() % size;
+	bytes.clear();
+	switch (index % 4)
+	{
+	case 0:
+	{
+		static const char* const words[] = { "uniform ", "vec3 ", "float ", "texture(", "normalize(", "gl_Position",
+			" = ", ";\n", "material.", "light", "\t", "0.5", "{\n", "}\n", "position", "color" };
+		string text;
+		while (text.size() < size)
+			text += words[next() % 16];
+		bytes.assign(text.begin(), text.begin() + size);
+		break;
+	}
+	case 1:
+	{
+		int side = max(1, (int)sqrt((double)size / 4));
+		for (int y = 0; y < side; y++)
+		{
+			for (int x = 0; x < side; x++)
+			{
+				uint8_t texel[4] = { (uint8_t)(x * 255 / side), (uint8_t)(y * 255 / side), (uint8_t)((x ^ y) & 0xe0), 255 };
+				bytes.insert(bytes.end(), texel, texel + 4);
+			}
+		}
+		break;
+	}
+	case 2:
+	{
+		int side = max(1, (int)sqrt((double)size / 3));
+		vector<uint8_t> rgb((size_t)side * side * 3);
+		for (size_t i = 0; i < rgb.size(); i++)
+			rgb[i] = (uint8_t)(128.0 + 100.0 * sin(i * 0.001) + (next() & 7));
+		encodeQOI(rgb.data(), side, side, bytes);
+		break;
+	}
+	default:
+		bytes.resize(size);
+		for (uint8_t& b : bytes)
+			b = (uint8_t)next();
+		break;
+	}
+}
+
+static bool roundTrip(const vector<uint8_t>& data)
+{
+	vector<uint8_t> compressed, decoded(data.size() + 1);
+	size_t bytes = lz4Compress(data.data(), data.size(), compressed);
+	// one byte too many or too few asked for must fail
+	return bytes <= lz4CompressBound(data.size()) && lz4Decompress(compressed.data(), bytes, decoded.data(), data.size())
+		&& equal(data.begin(), data.end(), decoded.begin())
+		&& !lz4Decompress(compressed.data(), bytes, decoded.data(), data.size() + 1)
+		&& (data.empty() || !lz4Decompress(compressed.data(), bytes, decoded.data(), data.size() - 1));
+}
+
+// the block format's corners: nothing, less than a match may take, lengths
+// that need 255 continuation bytes, overlapping copies, offsets near 64 KB,
+// and garbage that must be rejected without reading or writing out of bounds
+static bool checkLz4()
+{
+	vector<vector<uint8_t>> cases;
+	cases.push_back({});
+	cases.push_back({ 7 });
+	cases.push_back(vector<uint8_t>(12, 'a'));
+	cases.push_back(vector<uint8_t>(13, 'a'));
+	cases.push_back(vector<uint8_t>(1 << 20, 0));
+	vector<uint8_t> pattern(100000);
+	for (size_t i = 0; i < pattern.size(); i++)
+		pattern[i] = (uint8_t)("abcdefg"[i % 7]);
+	cases.push_back(pattern);
+	uint32_t random = 99;
+	vector<uint8_t> far(200000);
+	for (size_t i = 0; i < 65000; i++)
+	{
+		random = random * 1664525u + 1013904223u;
+		far[i] = (uint8_t)(random >> 24);
+	}
+	for (size_t i = 65000; i < far.size(); i++)
+		far[i] = far[i - 65000 + (i / 65000 % 2) * 500];
+	cases.push_back(far);
+	for (const vector<uint8_t>& data : cases)
+	{
+		if (!roundTrip(data))
+		{
+			cout << "ERROR::BENCHMARK::ARCHIVE::LZ4_ROUND_TRIP " << data.size() << " bytes" << endl;
+			return false;
+		}
+	}
+
+	vector<uint8_t> compressed, decoded(pattern.size());
+	size_t bytes = lz4Compress(pattern.data(), pattern.size(), compressed);
+	for (int trial = 0; trial < 2000; trial++)
+	{
+		vector<uint8_t> broken(compressed.begin(), compressed.begin() + bytes);
+		random = random * 1664525u + 1013904223u;
+		if (trial % 2)
+			broken.resize(random % bytes);
+		else
+			broken[random % bytes] ^= (uint8_t)(1 + (random >> 24) % 255);
+		// a flipped literal still decodes; anything else must stop cleanly
+		lz4Decompress(broken.data(), broken.size(), decoded.data(), decoded.size());
+	}
+	return true;
+}
+
+int runArchiveBenchmark(int fileCount)
+{
+	const int threads = (int)max(1u, thread::hardware_concurrency());
+	cout << "Asset archive benchmark: " << fileCount << " files, 1 thread against " << threads << endl;
+
+	int exitCode = 0;
+	if (!checkLz4())
+		exitCode = 1;
+
+	fs::path directory = fs::temp_directory_path() / "asset_archive_benchmark";
+	fs::path looseDirectory = directory / "loose";
+	string archivePath = (directory / "assets.pak").string();
+	error_code error;
+	fs::remove_all(directory, error);
+
+	// the loose files, a few directories deep like a real data folder
+	vector<string> names(fileCount);
+	vector<vector<uint8_t>> originals(fileCount);
+	uint32_t random = 1;
+	uint64_t totalBytes = 0;
+	static const char* const folders[] = { "shaders", "textures/raw", "textures/qoi", "blobs" };
+	for (int i = 0; i < fileCount; i++)
+	{
+		makeAsset(i, random, originals[i]);
+		names[i] = string(folders[i % 4]) + "/" + to_string(i / 4 % 16) + "/asset" + to_string(i) + ".bin";
+		fs::path path = looseDirectory / names[i];
+		fs::create_directories(path.parent_path(), error);
+		FILE* file = fopen(path.string().c_str(), "wb");
+		bool written = file && fwrite(originals[i].data(), 1, originals[i].size(), file) == originals[i].size();
+		if (file)
+			written = fclose(file) == 0 && written;
+		if (!written)
+		{
+			cout << "ERROR::BENCHMARK::ARCHIVE::FILE_NOT_WRITTEN " << path.string() << endl;
+			fs::remove_all(directory, error);
+			return 1;
+		}
+		totalBytes += originals[i].size();
+	}
+
+	JobSystem jobs(threads);
+	AssetArchiveBuilder builder;
+	AssetArchiveBuilder::Stats build;
+	if (!builder.addDirectory(looseDirectory.string()) || !builder.write(archivePath, &jobs, &build))
+	{
+		fs::remove_all(directory, error);
+		return 1;
+	}
+	cout << "  built in " << build.milliseconds << " ms: " << totalBytes / 1024 << " KB in " << build.chunks
+		<< " chunks to " << build.fileBytes / 1024 << " KB (" << 100.0 * build.fileBytes / max<uint64_t>(totalBytes, 1)
+		<< "%), " << build.storedChunks << " chunks stored uncompressed" << endl;
+
+	// Every pass reads into the same buffers, allocated up front, so the
+	// times are the loading alone. Both sides are in the page cache, the
+	// files having just been written: what is compared is a system call per
+	// file against a lookup in a mapped table, and a copy against LZ4. The
+	// best of a few passes after a warm-up, which also maps the archive's
+	// pages in once.
+	vector<vector<uint8_t>> loose(fileCount), single(fileCount), pooled(fileCount);
+	for (int i = 0; i < fileCount; i++)
+	{
+		loose[i].resize(originals[i].size());
+		single[i].resize(originals[i].size());
+		pooled[i].resize(originals[i].size());
+	}
+	vector<uint8_t*> outs(fileCount);
+	vector<uint32_t> assets(fileCount);
+	AssetArchive archive;
+	bool ok = true;
+	auto readLoose = [&]()
+	{
+		for (int i = 0; i < fileCount; i++)
+		{
+			FILE* file = fopen((looseDirectory / names[i]).string().c_str(), "rb");
+			bool read = file && fseek(file, 0, SEEK_END) == 0 && (size_t)ftell(file) == loose[i].size()
+				&& fseek(file, 0, SEEK_SET) == 0 && fread(loose[i].data(), 1, loose[i].size(), file) == loose[i].size();
+			if (file)
+				fclose(file);
+			ok = ok && read;
+		}
+	};
+	// open, find every name and decompress it, one asset after another or
+	// all the chunks at once over the job system
+	auto readArchive = [&](vector<vector<uint8_t>>& out, JobSystem* pool)
+	{
+		ok = ok && archive.open(archivePath);
+		for (int i = 0; i < fileCount && ok; i++)
+		{
+			assets[i] = archive.find(names[i]);
+			ok = assets[i] != AssetArchive::NOT_FOUND && archive.size(assets[i]) == out[i].size();
+			outs[i] = out[i].data();
+			if (ok && !pool)
+				ok = archive.read(assets[i], outs[i]);
+		}
+		if (ok && pool)
+			ok = archive.read(assets.data(), outs.data(), fileCount, pool);
+	};
+	double looseMilliseconds = 1e30, singleMilliseconds = 1e30, pooledMilliseconds = 1e30;
+	for (int pass = 0; pass < 4; pass++)
+	{
+		auto start = Clock::now();
+		readLoose();
+		auto looseEnd = Clock::now();
+		readArchive(single, nullptr);
+		auto singleEnd = Clock::now();
+		archive.close();
+		auto pooledStart = Clock::now();
+		readArchive(pooled, &jobs);
+		auto pooledEnd = Clock::now();
+		if (pass > 0)
+		{
+			looseMilliseconds = min(looseMilliseconds, chrono::duration<double, milli>(looseEnd - start).count());
+			singleMilliseconds = min(singleMilliseconds, chrono::duration<double, milli>(singleEnd - looseEnd).count());
+			pooledMilliseconds = min(pooledMilliseconds, chrono::duration<double, milli>(pooledEnd - pooledStart).count());
+		}
+		if (pass < 3)
+			archive.close();
+	}
+
+	cout << "  loose files: " << looseMilliseconds << " ms; archive: " << singleMilliseconds << " ms on 1 thread ("
+		<< looseMilliseconds / singleMilliseconds << "x), " << pooledMilliseconds << " ms on " << threads << " ("
+		<< looseMilliseconds / pooledMilliseconds << "x)" << endl;
+
+	if (!ok || loose != originals || single != originals || pooled != originals)
+	{
+		cout << "ERROR::BENCHMARK::ARCHIVE::CONTENTS_DIFFER" << endl;
+		exitCode = 1;
+	}
+	if (!archive.verify(&jobs) || archive.find("missing/asset.bin") != AssetArchive::NOT_FOUND)
+		exitCode = 1;
+
+	// a stored asset is usable in place, at the alignment it was written with
+	size_t storedAssets = 0;
+	for (uint32_t asset = 0; asset < archive.count(); asset++)
+	{
+		const uint8_t* stored = archive.storedData(asset);
+		if (!stored)
+			continue;
+		storedAssets++;
+		uint32_t index = (uint32_t)(find(names.begin(), names.end(), archive.name(asset)) - names.begin());
+		if ((uintptr_t)stored % 64 != 0 || index == names.size()
+			|| !equal(originals[index].begin(), originals[index].end(), stored))
+		{
+			cout << "ERROR::BENCHMARK::ARCHIVE::STORED_ASSET " << archive.name(asset) << endl;
+			exitCode = 1;
+			break;
+		}
+	}
+	cout << "  " << storedAssets << " of " << archive.count() << " assets readable in place from the mapping" << endl;
+	archive.close();
+
+	// a truncated archive must not open
+	cout << "  opening the archive cut short by a byte, which must fail:" << endl;
+	fs::resize_file(archivePath, build.fileBytes - 1, error);
+	if (error || archive.open(archivePath))
+	{
+		cout << "ERROR::BENCHMARK::ARCHIVE::TRUNCATED_FILE_OPENED" << endl;
+		exitCode = 1;
+	}
+	archive.close();
+
+	fs::remove_all(directory, error);
+	return exitCode;
+}
@@ -0,0 +1,119 @@
+#include "benchmarks.h"
+#include "frame_capture.h"
+#include "gpu_memory.h"
+
+#include <atomic>
+#include <chrono>
+#include <iostream>
+#include <vector>
+
+using namespace std;
+
+static const int CAPTURE_WIDTH = 3840;
+static const int CAPTURE_HEIGHT = 2160;
+
+typedef chrono::high_resolution_clock Clock;
+
+// each frame is cleared to a color that encodes its number
+static uint32_t frameColor(uint64_t frame)
+{
+	return (uint32_t)(frame & 0xff) | (uint32_t)((frame >> 8) & 0xff) << 8 | 0x55u << 16 | 0xffu << 24;
+}
+
+static void drawFrame(uint64_t frame)
+{
+	uint32_t color = frameColor(frame);
+	glClearColor((color & 0xff) / 255.0f, ((color >> 8) & 0xff) / 255.0f, ((color >> 16) & 0xff) / 255.0f, 1.0f);
+	glClear(GL_COLOR_BUFFER_BIT);
+}
+
+// checks that frames arrive in order with the right contents
+class CheckingSink : public FrameSink
+{
+public:
+	void consume(const CapturedFrame& frame) override
+	{
+		size_t last = (size_t)frame.width * frame.height - 1;
+		uint32_t expected = frameColor(frame.index);
+		if (frame.index != next || frame.pixels[0] != expected || frame.pixels[last / 2] != expected || frame.pixels[last] != expected)
+			wrongFrames++;
+		next = frame.index + 1;
+	}
+
+	uint64_t next = 0;
+	atomic<int> wrongFrames{ 0 };
+};
+
+int runCaptureBenchmark(GLFWwindow* window, int frameCount)
+{
+	GLuint framebuffer, renderbuffer;
+	glGenFramebuffers(1, &framebuffer);
+	glGenRenderbuffers(1, &renderbuffer);
+	glBindRenderbuffer(GL_RENDERBUFFER, renderbuffer);
+	glRenderbufferStorage(GL_RENDERBUFFER, GL_RGBA8, CAPTURE_WIDTH, CAPTURE_HEIGHT);
+	gpuMemory.trackRenderbuffer(renderbuffer, GPU_MEMORY_RENDER_TARGET, gpuImageBytes(GL_RGBA8, CAPTURE_WIDTH, CAPTURE_HEIGHT));
+	glBindFramebuffer(GL_FRAMEBUFFER, framebuffer);
+	glFramebufferRenderbuffer(GL_FRAMEBUFFER, GL_COLOR_ATTACHMENT0, GL_RENDERBUFFER, renderbuffer);
+	glViewport(0, 0, CAPTURE_WIDTH, CAPTURE_HEIGHT);
+
+	cout << "Frame capture benchmark: " << frameCount << " frames of " << CAPTURE_WIDTH << "x" << CAPTURE_HEIGHT
+		<< " RGBA8, render thread time per frame" << endl;
+
+	// glReadPixels into client memory waits for the frame and copies it
+	vector<uint32_t> pixels((size_t)CAPTURE_WIDTH * CAPTURE_HEIGHT);
+	int wrongFrames = 0;
+	double readMilliseconds = 0.0;
+	auto start = Clock::now();
+	for (int frame = 0; frame < frameCount; frame++)
+	{
+		drawFrame(frame);
+		auto readStart = Clock::now();
+		glReadPixels(0, 0, CAPTURE_WIDTH, CAPTURE_HEIGHT, GL_RGBA, GL_UNSIGNED_BYTE, pixels.data());
+		readMilliseconds += chrono::duration<double, milli>(Clock::now() - readStart).count();
+		if (pixels[0] != frameColor(frame) || pixels.back() != frameColor(frame))
+			wrongFrames++;
+	}
+	double syncMilliseconds = chrono::duration<double, milli>(Clock::now() - start).count();
+
+	// the PBO ring
+	CheckingSink sink;
+	FrameCapture capture;
+	int exitCode = 0;
+	if (capture.start(window, &sink))
+	{
+		start = Clock::now();
+		for (int frame = 0; frame < frameCount; frame++)
+		{
+			drawFrame(frame);
+			capture.capture(CAPTURE_WIDTH, CAPTURE_HEIGHT);
+		}
+		double renderMilliseconds = chrono::duration<double, milli>(Clock::now() - start).count();
+		gpuMemory.report("  GPU memory with the ring full");
+		capture.stop();
+		double drainMilliseconds = chrono::duration<double, milli>(Clock::now() - start).count();
+		FrameCapture::Stats stats = capture.stats();
+
+		cout << "  glReadPixels: " << syncMilliseconds / frameCount << " ms per frame, "
+			<< readMilliseconds / frameCount << " ms in the read" << endl;
+		cout << "  PBO ring: " << renderMilliseconds / frameCount << " ms per frame, "
+			<< stats.issueMilliseconds / frameCount << " ms in capture(), " << stats.stalls << " stalls ("
+			<< stats.stallMilliseconds << " ms), " << drainMilliseconds / frameCount << " ms per frame until the last one was consumed" << endl;
+
+		if (wrongFrames > 0 || sink.wrongFrames > 0 || sink.next != (uint64_t)frameCount)
+		{
+			cout << "ERROR::BENCHMARK::CAPTURE::WRONG_FRAMES " << wrongFrames << " read, " << sink.wrongFrames
+				<< " captured, " << sink.next << " of " << frameCount << " arrived" << endl;
+			exitCode = 1;
+		}
+	}
+	else
+	{
+		exitCode = 1;
+	}
+
+	glBindFramebuffer(GL_FRAMEBUFFER, 0);
+	glDeleteFramebuffers(1, &framebuffer);
+	gpuMemory.forgetRenderbuffer(renderbuffer);
+	glDeleteRenderbuffers(1, &renderbuffer);
+	return exitCode;
+}
@@ -0,0 +1,124 @@
+#include "benchmarks.h"
+#include "job_system.h"
+#include "texture_compressor.h"
+
+#include <chrono>
+#include <cmath>
+#include <filesystem>
+#include <iostream>
+#include <thread>
+#include <vector>
+
+using namespace std;
+namespace fs = std::filesystem;
+
+typedef chrono::high_resolution_clock Clock;
+
+// smooth gradients, hard edges, noise and a soft alpha ramp: the kinds of
+// blocks the encoders find easy and hard
+static void makeImage(int size, RgbaImage& image)
+{
+	image.resize(size, size);
+	uint32_t noise = 12345;
+	for (int y = 0; y < size; y++)
+	{
+		uint32_t* row = image.row(y);
+		for (int x = 0; x < size; x++)
+		{
+			noise = noise * 1664525u + 1013904223u;
+			int r = (int)(128.0f + 127.0f * sinf(x * 0.013f) * cosf(y * 0.007f));
+			int g = ((x / 64) ^ (y / 64)) & 1 ? 200 : 40;
+			int b = (x + y) * 255 / (2 * size) + (int)(noise >> 28);
+			int a = min(255, (int)(hypotf((float)(x - size / 2), (float)(y - size / 2)) * 512.0f / size));
+			row[x] = (uint32_t)r | (uint32_t)g << 8 | (uint32_t)min(b, 255) << 16 | (uint32_t)a << 24;
+		}
+	}
+}
+
+// over RGB, and alpha too unless the format drops it
+static double rootMeanSquareError(const RgbaImage& a, const RgbaImage& b, int channels)
+{
+	double sum = 0.0;
+	for (size_t i = 0; i < a.pixels.size(); i++)
+	{
+		for (int c = 0; c < channels; c++)
+		{
+			int d = (int)((a.pixels[i] >> (c * 8)) & 0xff) - (int)((b.pixels[i] >> (c * 8)) & 0xff);
+			sum += d * d;
+		}
+	}
+	return sqrt(sum / ((double)a.pixels.size() * channels));
+}
+
+int runCompressionBenchmark(int size)
+{
+	const int threads = (int)max(1u, thread::hardware_concurrency());
+	RgbaImage image, decoded;
+	makeImage(size, image);
+	const double megabytes = image.pixels.size() * sizeof(uint32_t) / 1048576.0;
+	// RGBA8 with a full mip chain, what the uncompressed upload takes
+	const double uncompressedBytes = image.pixels.size() * sizeof(uint32_t) * 4.0 / 3.0;
+
+	cout << "Texture compression benchmark: " << size << "x" << size << " RGBA, 1 thread against " << threads << endl;
+
+	// generous: mode 6 BC7 and four color BC1 are well under these on this image
+	static const double maximumError[3] = { 6.0, 6.0, 4.0 };
+	JobSystem jobs(threads);
+	MipOptions mips;
+	int exitCode = 0;
+	for (int f = BLOCK_FORMAT_BC1; f <= BLOCK_FORMAT_BC7; f++)
+	{
+		BlockFormat format = (BlockFormat)f;
+		vector<uint8_t> single(compressedLevelBytes(format, size, size)), pooled(single.size());
+
+		auto start = Clock::now();
+		compressImage(image, format, single.data());
+		double singleSeconds = chrono::duration<double>(Clock::now() - start).count();
+		start = Clock::now();
+		compressImage(image, format, pooled.data(), &jobs);
+		double pooledSeconds = chrono::duration<double>(Clock::now() - start).count();
+
+		decompressImage(format, single.data(), size, size, decoded);
+		double error = rootMeanSquareError(image, decoded, format == BLOCK_FORMAT_BC1 ? 3 : 4);
+		CompressedTexture texture;
+		compressTexture(image, format, &mips, texture, &jobs);
+
+		cout << "  " << blockFormatName(format) << ": " << megabytes / singleSeconds << " MB/s on 1 thread, "
+			<< megabytes / pooledSeconds << " MB/s on " << threads << " (" << singleSeconds / pooledSeconds << "x), RMSE "
+			<< error << ", mipmapped " << texture.data.size() / 1024 << " KB against " << (size_t)uncompressedBytes / 1024
+			<< " KB RGBA8, " << (1.0 - texture.data.size() / uncompressedBytes) * 100.0 << "% of the VRAM saved" << endl;
+
+		if (single != pooled)
+		{
+			cout << "ERROR::BENCHMARK::COMPRESSION::RESULTS_DIFFER " << blockFormatName(format) << endl;
+			exitCode = 1;
+		}
+		if (!(error <= maximumError[f]))
+		{
+			cout << "ERROR::BENCHMARK::COMPRESSION::QUALITY " << blockFormatName(format) << " RMSE " << error << endl;
+			exitCode = 1;
+		}
+	}
+
+	// a cooked texture must come back from the cache exactly as it went in
+	fs::path directory = fs::temp_directory_path() / "texture_compression_benchmark";
+	CookedTextureCache cache(directory.string());
+	CompressedTexture cooked, loaded;
+	compressTexture(image, BLOCK_FORMAT_BC7, &mips, cooked, &jobs);
+	uint64_t key = CookedTextureCache::key(0x0123456789abcdefull, BLOCK_FORMAT_BC7, &mips);
+	auto start = Clock::now();
+	bool stored = cache.store(key, cooked);
+	double storeMilliseconds = chrono::duration<double, milli>(Clock::now() - start).count();
+	start = Clock::now();
+	bool found = stored && cache.load(key, loaded);
+	double loadMilliseconds = chrono::duration<double, milli>(Clock::now() - start).count();
+	error_code removeError;
+	fs::remove_all(directory, removeError);
+	cout << "  cooked BC7 mip chain: stored in " << storeMilliseconds << " ms, loaded in " << loadMilliseconds << " ms" << endl;
+	if (!found || loaded.data != cooked.data || loaded.levelOffsets != cooked.levelOffsets)
+	{
+		cout << "ERROR::BENCHMARK::COMPRESSION::CACHE_MISMATCH" << endl;
+		exitCode = 1;
+	}
+	return exitCode;
+}
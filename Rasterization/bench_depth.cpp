@@ -0,0 +1,198 @@
+#include "benchmarks.h"
+#include "soft_shader.h"
+
+#include <algorithm>
+#include <chrono>
+#include <iostream>
+#include <numeric>
+#include <random>
+#include <vector>
+
+using namespace std;
+
+static const int BENCH_WIDTH = 1024;
+static const int BENCH_HEIGHT = 768;
+
+static const char* layerVertexSource = R"(#version 330 core
+layout (location = 0) in vec3 aPos;
+layout (location = 1) in vec3 aColor;
+out vec3 color;
+void main()
+{
+	gl_Position = vec4(aPos, 1.0);
+	color = aColor;
+}
+)";
+
+// enough work per fragment that skipping it shows
+static const char* layerFragmentSource = R"(#version 330 core
+in vec3 color;
+out vec4 FragColor;
+void main()
+{
+	vec3 c = color;
+	for (int i = 0; i < 4; i++)
+		c = c * 0.9 + c * c * 0.1 + float(i) * 0.01;
+	FragColor = vec4(c, 1.0);
+}
+)";
+
+struct Layer
+{
+	float x0, y0, x1, y1, z;
+	float r, g, b;
+};
+
+// Overlapping screen-aligned rectangles, each a quarter to half of the
+// screen across, enough of them that every pixel is covered about
+// depthComplexity times.
+static vector<Layer> makeLayers(int depthComplexity)
+{
+	mt19937 random(2024);
+	uniform_real_distribution<float> unit(0.0f, 1.0f);
+	vector<Layer> layers;
+	float covered = 0.0f;
+	while (covered < (float)depthComplexity)
+	{
+		Layer layer;
+		float w = 0.5f + 0.5f * unit(random), h = 0.5f + 0.5f * unit(random);
+		layer.x0 = -1.0f + (2.0f - w) * unit(random);
+		layer.y0 = -1.0f + (2.0f - h) * unit(random);
+		layer.x1 = layer.x0 + w;
+		layer.y1 = layer.y0 + h;
+		layer.z = unit(random) * 1.8f - 0.9f;
+		layer.r = unit(random);
+		layer.g = unit(random);
+		layer.b = unit(random);
+		layers.push_back(layer);
+		covered += w * h * 0.25f;
+	}
+	return layers;
+}
+
+// two triangles per layer, aPos and aColor interleaved
+static vector<float> makeVertices(const vector<Layer>& layers, const vector<int>& order)
+{
+	vector<float> data;
+	for (int i : order)
+	{
+		const Layer& l = layers[i];
+		const float corners[6][2] = { { l.x0, l.y0 }, { l.x1, l.y0 }, { l.x1, l.y1 }, { l.x0, l.y0 }, { l.x1, l.y1 }, { l.x0, l.y1 } };
+		for (const auto& c : corners)
+			data.insert(data.end(), { c[0], c[1], l.z, l.r, l.g, l.b });
+	}
+	return data;
+}
+
+struct DepthRun
+{
+	SoftRasterStats stats;
+	double milliseconds;
+};
+
+// one frame: clear, draw, repeated for at least a quarter of a second
+static DepthRun measure(SoftRasterizer& rasterizer, SoftFramebuffer& framebuffer, SoftDepthBuffer& depth,
+	SoftProgram& program, const SoftVertexBuffer& vertices)
+{
+	typedef chrono::high_resolution_clock Clock;
+	DepthRun run;
+	int frames = 0;
+	double seconds = 0.0;
+	auto start = Clock::now();
+	while (seconds < 0.25)
+	{
+		framebuffer.clear(0);
+		depth.clear(1.0f);
+		rasterizer.resetStats();
+		rasterizer.drawTriangles(vertices, nullptr, 0, program);
+		frames++;
+		seconds = chrono::duration<double>(Clock::now() - start).count();
+	}
+	run.stats = rasterizer.stats();
+	run.milliseconds = seconds * 1e3 / frames;
+	return run;
+}
+
+int runDepthBenchmark(int depthComplexity)
+{
+	SoftFramebuffer framebuffer;
+	framebuffer.resize(BENCH_WIDTH, BENCH_HEIGHT);
+	SoftDepthBuffer depth;
+	depth.resize(BENCH_WIDTH, BENCH_HEIGHT);
+	SoftRasterizer rasterizer;
+	rasterizer.setTarget(&framebuffer);
+
+	SoftProgram program;
+	string log;
+	if (!program.build(layerVertexSource, layerFragmentSource, &log))
+	{
+		cout << "ERROR::BENCHMARK::DEPTH::BUILD_FAILED\n" << log << endl;
+		return 1;
+	}
+
+	vector<Layer> layers = makeLayers(depthComplexity);
+	cout << "CPU early depth benchmark: " << layers.size() << " layers, depth complexity " << depthComplexity << ", "
+		<< BENCH_WIDTH << "x" << BENCH_HEIGHT << ", " << SOFT_DEPTH_TILE_SIZE << "x" << SOFT_DEPTH_TILE_SIZE << " tiles" << endl;
+
+	vector<int> order(layers.size());
+	iota(order.begin(), order.end(), 0);
+	struct Order
+	{
+		const char* name;
+		vector<int> layers;
+	};
+	vector<Order> orders(3);
+	orders[0].name = "front to back";
+	orders[0].layers = order;
+	sort(orders[0].layers.begin(), orders[0].layers.end(), [&](int a, int b) { return layers[a].z < layers[b].z; });
+	orders[1].name = "random";
+	orders[1].layers = order;
+	shuffle(orders[1].layers.begin(), orders[1].layers.end(), mt19937(7));
+	orders[2].name = "back to front";
+	orders[2].layers = orders[0].layers;
+	reverse(orders[2].layers.begin(), orders[2].layers.end());
+
+	const double pixels = (double)BENCH_WIDTH * BENCH_HEIGHT;
+	for (const Order& o : orders)
+	{
+		vector<float> data = makeVertices(layers, o.layers);
+		int vertexCount = (int)(data.size() / 6);
+		SoftVertexArray input;
+		input.attributes[0] = { data.data(), 3, 6 };
+		input.attributes[1] = { data.data() + 3, 3, 6 };
+		SoftVertexBuffer vertices;
+		program.runVertexShader(input, vertexCount, 0, vertices);
+
+		// without a depth test every covered fragment is shaded, which is
+		// also what a depth test after the shader would cost
+		rasterizer.setDepthTarget(nullptr);
+		DepthRun all = measure(rasterizer, framebuffer, depth, program, vertices);
+
+		rasterizer.setDepthTarget(&depth);
+		rasterizer.setHierarchicalDepth(false);
+		DepthRun early = measure(rasterizer, framebuffer, depth, program, vertices);
+		vector<uint32_t> earlyColor = framebuffer.color;
+
+		rasterizer.setHierarchicalDepth(true);
+		DepthRun tiled = measure(rasterizer, framebuffer, depth, program, vertices);
+		if (framebuffer.color != earlyColor)
+		{
+			cout << "ERROR::BENCHMARK::DEPTH::TILE_REJECTION_CHANGED_THE_IMAGE " << o.name << endl;
+			return 1;
+		}
+
+		cout << "  " << o.name << ":" << endl;
+		const pair<const char*, const DepthRun*> runs[] = { { "no depth test", &all }, { "early Z", &early }, { "early Z + tile min/max", &tiled } };
+		for (const auto& r : runs)
+		{
+			const SoftRasterStats& s = r.second->stats;
+			cout << "    " << r.first << ": " << r.second->milliseconds << " ms, "
+				<< s.shadedFragments / pixels << " shaded fragments per pixel ("
+				<< 100.0 * s.shadedFragments / all.stats.shadedFragments << "%), "
+				<< s.blocks << " covered blocks, " << s.depthRejectedBlocks << " blocks and "
+				<< s.depthRejectedTiles << " tiles rejected" << endl;
+		}
+	}
+	rasterizer.setDepthTarget(nullptr);
+	return 0;
+}
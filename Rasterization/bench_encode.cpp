@@ -0,0 +1,133 @@
+#include "benchmarks.h"
+#include "frame_encoder.h"
+
+#include <algorithm>
+#include <chrono>
+#include <iostream>
+#include <random>
+#include <thread>
+#include <vector>
+
+using namespace std;
+
+static const int FRAME_WIDTH = 1920;
+static const int FRAME_HEIGHT = 1080;
+
+typedef chrono::high_resolution_clock Clock;
+
+// something like a rendered frame: a smooth background, flat and shaded
+// shapes with hard edges, a little noise; moving a bit every frame
+static vector<uint32_t> makeFrame(int frame)
+{
+	mt19937 random(7);
+	uniform_int_distribution<int> coordinate(0, FRAME_WIDTH), size(20, 300), channel(0, 255), noise(0, 15);
+	vector<uint32_t> pixels((size_t)FRAME_WIDTH * FRAME_HEIGHT);
+	for (int y = 0; y < FRAME_HEIGHT; y++)
+	{
+		for (int x = 0; x < FRAME_WIDTH; x++)
+			pixels[(size_t)y * FRAME_WIDTH + x] = 0xff000000u | (51 + y * 60 / FRAME_HEIGHT) << 8 | (76 + x * 40 / FRAME_WIDTH) << 16 | 51;
+	}
+	for (int shape = 0; shape < 200; shape++)
+	{
+		int x0 = coordinate(random) + frame * 3, y0 = coordinate(random) % FRAME_HEIGHT, w = size(random), h = size(random);
+		int r = channel(random), g = channel(random), b = channel(random);
+		bool shaded = shape % 2 == 0;
+		for (int y = max(y0, 0); y < min(y0 + h, FRAME_HEIGHT); y++)
+		{
+			for (int x = max(x0, 0); x < min(x0 + w, FRAME_WIDTH); x++)
+			{
+				int shade = shaded ? (x - x0) * 128 / w : 128;
+				pixels[(size_t)y * FRAME_WIDTH + x] = 0xff000000u | (r * shade / 128 & 0xff) | (g * shade / 128 & 0xff) << 8 | (b & 0xff) << 16;
+			}
+		}
+	}
+	for (uint32_t& p : pixels)
+	{
+		if (noise(random) == 0)
+			p ^= 0x030303;
+	}
+	return pixels;
+}
+
+int runEncodeBenchmark(int frameCount)
+{
+	const int threads = max(1u, thread::hardware_concurrency());
+	const int bands = max(1, min(FRAME_HEIGHT / 64, 2 * threads));
+	vector<vector<uint32_t>> frames;
+	for (int i = 0; i < min(frameCount, 8); i++)
+		frames.push_back(makeFrame(i));
+	const double rawMegabytes = (double)FRAME_WIDTH * FRAME_HEIGHT * 4 / (1 << 20);
+
+	cout << "Frame encoding benchmark: " << frameCount << " frames of " << FRAME_WIDTH << "x" << FRAME_HEIGHT
+		<< ", " << threads << " threads" << endl;
+
+	int exitCode = 0;
+	const FrameFormat formats[] = { FRAME_FORMAT_QOI, FRAME_FORMAT_PNG };
+	for (FrameFormat format : formats)
+	{
+		const char* name = format == FRAME_FORMAT_QOI ? "QOI" : "PNG";
+
+		// one thread, one band: what dumping from the render loop costs
+		vector<uint8_t> rgb((size_t)FRAME_WIDTH * FRAME_HEIGHT * 3), encoded;
+		uint64_t expectedBytes = 0;
+		auto start = Clock::now();
+		for (int i = 0; i < frameCount; i++)
+		{
+			const vector<uint32_t>& frame = frames[i % frames.size()];
+			CapturedFrame captured = { (uint64_t)i, FRAME_WIDTH, FRAME_HEIGHT, frame.data() };
+			packFrameRGB(captured, rgb.data());
+			if (format == FRAME_FORMAT_QOI)
+				encodeQOI(rgb.data(), FRAME_WIDTH, FRAME_HEIGHT, encoded);
+			else
+				encodePNG(rgb.data(), FRAME_WIDTH, FRAME_HEIGHT, 1, encoded);
+			expectedBytes += encoded.size();
+		}
+		double serialMilliseconds = chrono::duration<double, milli>(Clock::now() - start).count() / frameCount;
+		double ratio = (double)FRAME_WIDTH * FRAME_HEIGHT * 3 * frameCount / expectedBytes;
+
+		// the pool, with PNG split into bands
+		FrameEncoder::Stats stats;
+		start = Clock::now();
+		double consumeMilliseconds = 0.0;
+		{
+			FrameEncoder encoder("", format, threads);
+			for (int i = 0; i < frameCount; i++)
+			{
+				const vector<uint32_t>& frame = frames[i % frames.size()];
+				CapturedFrame captured = { (uint64_t)i, FRAME_WIDTH, FRAME_HEIGHT, frame.data() };
+				auto consumeStart = Clock::now();
+				encoder.consume(captured);
+				consumeMilliseconds += chrono::duration<double, milli>(Clock::now() - consumeStart).count();
+			}
+			encoder.finish();
+			stats = encoder.stats();
+		}
+		double poolMilliseconds = chrono::duration<double, milli>(Clock::now() - start).count() / frameCount;
+
+		// the bands cost a little ratio; QOI must come out byte for byte the same
+		if (format == FRAME_FORMAT_PNG)
+		{
+			expectedBytes = 0;
+			for (int i = 0; i < frameCount; i++)
+			{
+				CapturedFrame captured = { (uint64_t)i, FRAME_WIDTH, FRAME_HEIGHT, frames[i % frames.size()].data() };
+				packFrameRGB(captured, rgb.data());
+				encodePNG(rgb.data(), FRAME_WIDTH, FRAME_HEIGHT, bands, encoded);
+				expectedBytes += encoded.size();
+			}
+		}
+		if (stats.encodedBytes != expectedBytes)
+		{
+			cout << "ERROR::BENCHMARK::ENCODE::POOL_OUTPUT_DIFFERS " << name << endl;
+			exitCode = 1;
+		}
+
+		cout << "  " << name << ": " << ratio << ":1" << endl;
+		cout << "    one thread: " << serialMilliseconds << " ms per frame, " << rawMegabytes / serialMilliseconds * 1e3 << " MB/s" << endl;
+		cout << "    pool" << (format == FRAME_FORMAT_PNG ? ", " + to_string(bands) + " bands" : string()) << ": "
+			<< poolMilliseconds << " ms per frame, " << rawMegabytes / poolMilliseconds * 1e3 << " MB/s, "
+			<< consumeMilliseconds / frameCount << " ms in consume(), " << stats.budgetWaits << " waits for memory, peak "
+			<< stats.peakBytes / (1 << 20) << " MB" << endl;
+	}
+	return exitCode;
+}
@@ -0,0 +1,154 @@
+#include "benchmarks.h"
+#include "soft_raster.h"
+
+#include <chrono>
+#include <cmath>
+#include <iostream>
+#include <random>
+#include <vector>
+
+using namespace std;
+
+static const int BENCH_WIDTH = 1024;
+static const int BENCH_HEIGHT = 768;
+
+// sums the varyings into the color so none of them can be optimized away
+class VaryingSumShader : public SoftFragmentShader
+{
+public:
+	int shade(const SoftFragmentBlock& block, vec8f rgba[4]) override
+	{
+		vec8f sum[4] = { vec8f::zero(), vec8f::zero(), vec8f::zero(), vec8f::zero() };
+		for (int i = 0; i < block.varyingCount; i++)
+			sum[i & 3] = sum[i & 3] + block.varyings[i];
+		vec8f scale(block.varyingCount > 4 ? 4.0f / block.varyingCount : 1.0f);
+		for (int c = 0; c < 4; c++)
+			rgba[c] = sum[c] * scale;
+		return block.mask;
+	}
+};
+
+// recomputes every covered pixel of one triangle in double precision from
+// the unsnapped vertices and keeps the largest difference
+class ReferenceShader : public SoftFragmentShader
+{
+public:
+	ReferenceShader(const SoftVertexBuffer& vertices, int first) : vertices(vertices), first(first) {}
+
+	int shade(const SoftFragmentBlock& block, vec8f rgba[4]) override
+	{
+		double x[3], y[3], invW[3];
+		for (int k = 0; k < 3; k++)
+		{
+			int v = first + k;
+			invW[k] = 1.0 / vertices.column(3)[v];
+			x[k] = (vertices.column(0)[v] * invW[k] + 1.0) * 0.5 * BENCH_WIDTH;
+			y[k] = (vertices.column(1)[v] * invW[k] + 1.0) * 0.5 * BENCH_HEIGHT;
+		}
+		double area = (x[1] - x[0]) * (y[2] - y[0]) - (x[2] - x[0]) * (y[1] - y[0]);
+
+		for (int l = 0; l < 8; l++)
+		{
+			if (!(block.mask & (1 << l)))
+				continue;
+			double px = block.x + (l & 3) + 0.5;
+			double py = block.y + (l >> 2) + 0.5;
+			double l1 = ((x[2] - x[0]) * (py - y[0]) - (y[2] - y[0]) * (px - x[0])) / -area;
+			double l2 = ((x[1] - x[0]) * (py - y[0]) - (y[1] - y[0]) * (px - x[0])) / area;
+			double q0 = (1.0 - l1 - l2) * invW[0], q1 = l1 * invW[1], q2 = l2 * invW[2];
+			double sum = q0 + q1 + q2;
+			for (int i = 0; i < block.varyingCount; i++)
+			{
+				const float* a = vertices.varying(i) + first;
+				double expected = (q0 * a[0] + q1 * a[1] + q2 * a[2]) / sum;
+				maxError = max(maxError, fabs(expected - lane(block.varyings[i], l)));
+			}
+		}
+		for (int c = 0; c < 4; c++)
+			rgba[c] = vec8f(1.0f);
+		return block.mask;
+	}
+
+	double maxError = 0.0;
+
+private:
+	const SoftVertexBuffer& vertices;
+	int first;
+};
+
+// triangles of 20-60 pixels across at random depths, w from 1 to 8
+static void makeTriangles(SoftVertexBuffer& vertices, int triangleCount, int varyingCount)
+{
+	mt19937 random(1234);
+	uniform_real_distribution<float> unit(0.0f, 1.0f);
+	vertices.resize(triangleCount * 3, varyingCount);
+	for (int t = 0; t < triangleCount; t++)
+	{
+		float cx = unit(random) * BENCH_WIDTH, cy = unit(random) * BENCH_HEIGHT;
+		float size = 20.0f + 40.0f * unit(random);
+		for (int k = 0; k < 3; k++)
+		{
+			int v = t * 3 + k;
+			float angle = (t * 0.7f) + k * 2.0944f;
+			float x = cx + size * 0.5f * cos(angle), y = cy + size * 0.5f * sin(angle);
+			float w = 1.0f + 7.0f * unit(random);
+			vertices.setPosition(v, (x / BENCH_WIDTH * 2.0f - 1.0f) * w, (y / BENCH_HEIGHT * 2.0f - 1.0f) * w, unit(random) * w, w);
+			for (int i = 0; i < varyingCount; i++)
+				vertices.varying(i)[v] = unit(random);
+		}
+	}
+}
+
+int runInterpolationBenchmark(int triangleCount)
+{
+	SoftFramebuffer framebuffer;
+	framebuffer.resize(BENCH_WIDTH, BENCH_HEIGHT);
+	SoftRasterizer rasterizer;
+	rasterizer.setTarget(&framebuffer);
+
+	cout << "CPU varying interpolation benchmark: " << triangleCount << " triangles, "
+		<< BENCH_WIDTH << "x" << BENCH_HEIGHT << ", " << (SIMD_AVX2 ? "AVX2" : "SSE2") << ", one core" << endl;
+
+	int exitCode = 0;
+	const int varyingCounts[] = { 0, 4, 8, 16 };
+	for (int varyingCount : varyingCounts)
+	{
+		SoftVertexBuffer vertices;
+		makeTriangles(vertices, triangleCount, varyingCount);
+
+		// correctness first, on a few hundred triangles
+		double maxError = 0.0;
+		for (int t = 0; t < min(triangleCount, 256); t++)
+		{
+			uint32_t indices[3] = { (uint32_t)t * 3, (uint32_t)t * 3 + 1, (uint32_t)t * 3 + 2 };
+			ReferenceShader reference(vertices, t * 3);
+			rasterizer.drawTriangles(vertices, indices, 3, reference);
+			maxError = max(maxError, reference.maxError);
+		}
+
+		typedef chrono::high_resolution_clock Clock;
+		VaryingSumShader shader;
+		rasterizer.resetStats();
+		auto start = Clock::now();
+		double seconds = 0.0;
+		while (seconds < 0.5)
+		{
+			rasterizer.drawTriangles(vertices, nullptr, 0, shader);
+			seconds = chrono::duration<double>(Clock::now() - start).count();
+		}
+
+		const SoftRasterStats& stats = rasterizer.stats();
+		double fragmentsPerSecond = stats.fragments / seconds;
+		cout << "  " << varyingCount << " varyings: " << fragmentsPerSecond * 1e-6 << " Mfragments/s, "
+			<< fragmentsPerSecond * varyingCount * 1e-9 << " Gvaryings/s, "
+			<< seconds * 1e9 / stats.blocks << " ns/block, max error " << maxError << endl;
+
+		// the reference uses unsnapped vertices, so allow for the 1/256 pixel snap
+		if (maxError > 1e-3)
+		{
+			cout << "ERROR::BENCHMARK::INTERPOLATION::MISMATCH" << endl;
+			exitCode = 1;
+		}
+	}
+	return exitCode;
+}
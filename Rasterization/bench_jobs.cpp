@@ -0,0 +1,184 @@
+#include "benchmarks.h"
+#include "gpu_culling.h"
+#include "job_system.h"
+#include "math3d.h"
+#include "soft_texture.h"
+
+#include <chrono>
+#include <cmath>
+#include <iostream>
+#include <vector>
+
+using namespace std;
+
+typedef chrono::high_resolution_clock Clock;
+
+static const int CULL_OBJECTS = 1000000;
+static const int MESH_SIZE = 1024;			// vertices per side of the height field
+static const int TEXTURE_COUNT = 32;
+static const int TEXTURE_SIZE = 256;
+
+// bounding spheres against the frustum, one flag per object
+static void cullRange(const vector<CullObject>& objects, const Vec4 planes[6], vector<uint8_t>& visible, size_t begin, size_t end)
+{
+	for (size_t i = begin; i < end; i++)
+	{
+		const std430::Vec4& s = objects[i].sphere;
+		bool inside = true;
+		for (int p = 0; p < 6; p++)
+			inside = inside && planes[p].x * s.x + planes[p].y * s.y + planes[p].z * s.z + planes[p].w + s.w > 0.0f;
+		visible[i] = inside ? 1 : 0;
+	}
+}
+
+// a height field: every vertex transformed, with its normal from the
+// neighbouring heights
+static void processMeshRows(const vector<float>& heights, const Mat4& transform, vector<Vec4>& positions, vector<Vec3>& normals,
+	size_t beginRow, size_t endRow)
+{
+	for (size_t y = beginRow; y < endRow; y++)
+	{
+		for (int x = 0; x < MESH_SIZE; x++)
+		{
+			size_t i = y * MESH_SIZE + x;
+			int left = max(x - 1, 0), right = min(x + 1, MESH_SIZE - 1);
+			size_t down = y > 0 ? y - 1 : 0, up = min(y + 1, (size_t)MESH_SIZE - 1);
+			Vec3 dx = { (float)(right - left), heights[y * MESH_SIZE + right] - heights[y * MESH_SIZE + left], 0.0f };
+			Vec3 dz = { 0.0f, heights[up * MESH_SIZE + x] - heights[down * MESH_SIZE + x], (float)(up - down) };
+			normals[i] = normalize(cross(dz, dx));
+			positions[i] = transform * Vec4{ (float)x, heights[i], (float)y, 1.0f };
+		}
+	}
+}
+
+// stands in for decoding an image file
+static void decodeTexture(int index, vector<uint32_t>& pixels)
+{
+	pixels.resize((size_t)TEXTURE_SIZE * TEXTURE_SIZE);
+	for (int y = 0; y < TEXTURE_SIZE; y++)
+	{
+		for (int x = 0; x < TEXTURE_SIZE; x++)
+		{
+			uint32_t r = (uint32_t)(128.0f + 127.0f * sinf(x * 0.05f + index));
+			uint32_t g = (uint32_t)(128.0f + 127.0f * cosf(y * 0.07f - index));
+			pixels[(size_t)y * TEXTURE_SIZE + x] = 0xff000000u | (uint32_t)((x ^ y) & 0xff) << 16 | g << 8 | r;
+		}
+	}
+}
+
+struct TextureTask
+{
+	int index;
+	vector<uint32_t> pixels;
+	SoftTexture texture;
+	JobCounter decoded;
+};
+
+struct Workload
+{
+	const char* name = nullptr;
+	double milliseconds[8] = {};
+	uint64_t checksum[8] = {};
+};
+
+int runJobBenchmark(int maxThreads)
+{
+	if (maxThreads <= 0)
+		maxThreads = max(1u, thread::hardware_concurrency());
+	vector<int> threadCounts;
+	for (int threads = 1; threads < maxThreads && threadCounts.size() < 7; threads *= 2)
+		threadCounts.push_back(threads);
+	threadCounts.push_back(maxThreads);
+
+	vector<CullObject> objects = makeCullingScene(CULL_OBJECTS);
+	Vec4 planes[6];
+	frustumPlanes(cullingCamera(1.0f, 16.0f / 9.0f), planes);
+	vector<uint8_t> visible(objects.size());
+
+	vector<float> heights((size_t)MESH_SIZE * MESH_SIZE);
+	for (size_t i = 0; i < heights.size(); i++)
+		heights[i] = sinf((i % MESH_SIZE) * 0.02f) * cosf((i / MESH_SIZE) * 0.03f) * 8.0f;
+	Mat4 transform = perspective(1.0f, 1.0f, 0.1f, 100.0f) * lookAt({ 512.0f, 200.0f, -100.0f }, { 512.0f, 0.0f, 512.0f }, { 0.0f, 1.0f, 0.0f });
+	vector<Vec4> positions(heights.size());
+	vector<Vec3> normals(heights.size());
+
+	Workload workloads[3] = { { "culling" }, { "mesh processing" }, { "texture loading" } };
+	const int repeats = 5;
+
+	cout << "Job system benchmark: " << CULL_OBJECTS << " spheres culled, " << MESH_SIZE << "x" << MESH_SIZE
+		<< " mesh vertices, " << TEXTURE_COUNT << " textures of " << TEXTURE_SIZE << "x" << TEXTURE_SIZE
+		<< " decoded then tiled and mipmapped" << endl;
+
+	for (size_t t = 0; t < threadCounts.size(); t++)
+	{
+		JobSystem jobs(threadCounts[t]);
+
+		auto start = Clock::now();
+		for (int r = 0; r < repeats; r++)
+			jobs.parallelFor(0, objects.size(), [&](size_t b, size_t e) { cullRange(objects, planes, visible, b, e); });
+		workloads[0].milliseconds[t] = chrono::duration<double, milli>(Clock::now() - start).count() / repeats;
+		workloads[0].checksum[t] = 0;
+		for (size_t i = 0; i < visible.size(); i++)
+			workloads[0].checksum[t] += visible[i] * i;
+
+		start = Clock::now();
+		for (int r = 0; r < repeats; r++)
+			jobs.parallelFor(0, MESH_SIZE, [&](size_t b, size_t e) { processMeshRows(heights, transform, positions, normals, b, e); });
+		workloads[1].milliseconds[t] = chrono::duration<double, milli>(Clock::now() - start).count() / repeats;
+		double sum = 0.0;
+		for (size_t i = 0; i < positions.size(); i += 97)
+			sum += positions[i].x + positions[i].w + normals[i].y;
+		workloads[1].checksum[t] = (uint64_t)llround(sum * 1000.0);
+
+		// each texture is decoded by one job and loaded by a second one that
+		// depends on it; all of them run at once
+		start = Clock::now();
+		uint64_t texels = 0;
+		for (int r = 0; r < repeats; r++)
+		{
+			unique_ptr<TextureTask[]> tasks(new TextureTask[TEXTURE_COUNT]);
+			JobCounter loaded;
+			for (int i = 0; i < TEXTURE_COUNT; i++)
+			{
+				tasks[i].index = i;
+				jobs.run([](void* data) {
+					TextureTask& task = *(TextureTask*)data;
+					decodeTexture(task.index, task.pixels);
+				}, &tasks[i], &tasks[i].decoded);
+				jobs.runAfter(tasks[i].decoded, [](void* data) {
+					TextureTask& task = *(TextureTask*)data;
+					task.texture.load(TEXTURE_SIZE, TEXTURE_SIZE, task.pixels.data());
+				}, &tasks[i], &loaded);
+			}
+			jobs.wait(loaded);
+			texels = 0;
+			for (int i = 0; i < TEXTURE_COUNT; i++)
+				texels += tasks[i].texture.levelCount() * 1000003ull + tasks[i].texture.texel(1, 7, 9);
+		}
+		workloads[2].milliseconds[t] = chrono::duration<double, milli>(Clock::now() - start).count() / repeats;
+		workloads[2].checksum[t] = texels;
+
+		JobSystem::Stats stats = jobs.stats();
+		cout << "  " << threadCounts[t] << " threads: " << stats.jobs << " jobs, " << stats.steals << " stolen, "
+			<< stats.sleeps << " sleeps" << endl;
+	}
+
+	int exitCode = 0;
+	for (const Workload& workload : workloads)
+	{
+		cout << "  " << workload.name << ":";
+		for (size_t t = 0; t < threadCounts.size(); t++)
+		{
+			cout << " " << threadCounts[t] << "T " << workload.milliseconds[t] << " ms";
+			if (t > 0)
+				cout << " (" << workload.milliseconds[0] / workload.milliseconds[t] << "x)";
+			if (workload.checksum[t] != workload.checksum[0])
+			{
+				cout << endl << "ERROR::BENCHMARK::JOBS::RESULTS_DIFFER " << workload.name << " with " << threadCounts[t] << " threads";
+				exitCode = 1;
+			}
+		}
+		cout << endl;
+	}
+	return exitCode;
+}
@@ -0,0 +1,147 @@
+#include "benchmarks.h"
+#include "job_system.h"
+#include "mip_generator.h"
+
+#include <chrono>
+#include <cmath>
+#include <cstdlib>
+#include <iostream>
+#include <thread>
+#include <vector>
+
+using namespace std;
+
+typedef chrono::high_resolution_clock Clock;
+
+// a photo-like mix of gradients and edges, and alpha-tested blades of grass
+static void makeImage(int width, int height, RgbaImage& image)
+{
+	image.resize(width, height);
+	for (int y = 0; y < height; y++)
+	{
+		uint32_t* row = image.row(y);
+		for (int x = 0; x < width; x++)
+		{
+			int r = (int)(128.0f + 127.0f * sinf(x * 0.021f + y * 0.004f));
+			int g = ((x / 37) ^ (y / 29)) & 1 ? 190 : 60;
+			int b = (x * 255) / width;
+			float blade = sinf(x * 0.9f + 3.0f * sinf(y * 0.05f));
+			int a = blade > 0.3f + 0.6f * y / height ? 255 : (int)(max(blade, 0.0f) * 180.0f);
+			row[x] = (uint32_t)r | (uint32_t)g << 8 | (uint32_t)b << 16 | (uint32_t)a << 24;
+		}
+	}
+}
+
+static double alphaCoverage(const RgbaImage& image, float cutoff)
+{
+	size_t covered = 0;
+	for (uint32_t pixel : image.pixels)
+		covered += (pixel >> 24) / 255.0f >= cutoff ? 1 : 0;
+	return (double)covered / image.pixels.size();
+}
+
+int runMipBenchmark(int size)
+{
+	const int threads = (int)max(1u, thread::hardware_concurrency());
+	RgbaImage image;
+	makeImage(size, size, image);
+	const double megapixels = (double)size * size / 1e6;
+	cout << "Mip generation benchmark: " << size << "x" << size << " sRGB RGBA down to 1x1, 1 thread against " << threads << endl;
+
+	int exitCode = 0;
+	JobSystem jobs(threads);
+	vector<RgbaImage> single, pooled;
+	for (int f = MIP_FILTER_BOX; f <= MIP_FILTER_LANCZOS; f++)
+	{
+		MipOptions options;
+		options.filter = (MipFilter)f;
+		auto start = Clock::now();
+		generateMips(image, options, single);
+		double singleSeconds = chrono::duration<double>(Clock::now() - start).count();
+		start = Clock::now();
+		generateMips(image, options, pooled, &jobs);
+		double pooledSeconds = chrono::duration<double>(Clock::now() - start).count();
+		cout << "  " << mipFilterName(options.filter) << ": " << megapixels / singleSeconds << " MPixels/s on 1 thread, "
+			<< megapixels / pooledSeconds << " MPixels/s on " << threads << " (" << singleSeconds / pooledSeconds << "x)" << endl;
+
+		bool same = single.size() == pooled.size();
+		for (size_t i = 0; i < single.size() && same; i++)
+			same = single[i].pixels == pooled[i].pixels;
+		if (!same)
+		{
+			cout << "ERROR::BENCHMARK::MIPS::RESULTS_DIFFER " << mipFilterName(options.filter) << endl;
+			exitCode = 1;
+		}
+	}
+
+	// black and white texels average to half the light, sRGB 188, not 128
+	RgbaImage checker;
+	checker.resize(64, 64);
+	for (int y = 0; y < 64; y++)
+	{
+		for (int x = 0; x < 64; x++)
+			checker.row(y)[x] = (x ^ y) & 1 ? 0xffffffffu : 0xff000000u;
+	}
+	MipOptions box;
+	box.filter = MIP_FILTER_BOX;
+	generateMips(checker, box, single);
+	int grey = (int)(single[0].row(16)[16] & 0xff);
+	cout << "  black and white checkerboard, one level down: " << grey << " (128 without linearizing)" << endl;
+	if (abs(grey - 188) > 1)
+	{
+		cout << "ERROR::BENCHMARK::MIPS::NOT_GAMMA_CORRECT " << grey << endl;
+		exitCode = 1;
+	}
+
+	// any size: one color stays that color at every level, each level half
+	// the one above rounded down
+	RgbaImage odd;
+	odd.resize(size * 3 / 4 + 1, size / 3 + 5);
+	fill(odd.pixels.begin(), odd.pixels.end(), 0xc0407fd0u);
+	for (int f = MIP_FILTER_BOX; f <= MIP_FILTER_LANCZOS; f++)
+	{
+		MipOptions options;
+		options.filter = (MipFilter)f;
+		generateMips(odd, options, single, &jobs);
+		int width = odd.width, height = odd.height, largest = 0;
+		bool sizes = true;
+		for (const RgbaImage& level : single)
+		{
+			width = max(width / 2, 1);
+			height = max(height / 2, 1);
+			sizes = sizes && level.width == width && level.height == height;
+			for (uint32_t pixel : level.pixels)
+			{
+				for (int shift = 0; shift < 32; shift += 8)
+					largest = max(largest, abs((int)((pixel >> shift) & 0xff) - (int)((0xc0407fd0u >> shift) & 0xff)));
+			}
+		}
+		if (!sizes || width != 1 || height != 1 || largest > 1)
+		{
+			cout << "ERROR::BENCHMARK::MIPS::NON_POWER_OF_TWO " << mipFilterName(options.filter) << " " << odd.width << "x"
+				<< odd.height << ", off by " << largest << (sizes && width == 1 && height == 1 ? "" : ", wrong level sizes") << endl;
+			exitCode = 1;
+		}
+	}
+
+	// alpha tested at 0.5: without help the blades thin out level by level
+	MipOptions plain, kept;
+	kept.alphaCutoff = 0.5f;
+	generateMips(image, plain, single, &jobs);
+	generateMips(image, kept, pooled, &jobs);
+	double target = alphaCoverage(image, 0.5f), worst = 0.0;
+	cout << "  alpha coverage " << target * 100.0 << "% at the top, by level without and with preservation:";
+	for (size_t i = 0; i < single.size() && single[i].pixels.size() >= 64; i++)
+	{
+		double without = alphaCoverage(single[i], 0.5f), with = alphaCoverage(pooled[i], 0.5f);
+		cout << " " << (int)(without * 100.0 + 0.5) << "/" << (int)(with * 100.0 + 0.5);
+		worst = max(worst, fabs(with - target));
+	}
+	cout << endl;
+	if (worst > 0.02)
+	{
+		cout << "ERROR::BENCHMARK::MIPS::COVERAGE_LOST " << worst * 100.0 << "%" << endl;
+		exitCode = 1;
+	}
+	return exitCode;
+}
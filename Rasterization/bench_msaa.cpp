@@ -0,0 +1,297 @@
+#include "benchmarks.h"
+#include "gpu_memory.h"
+#include "shader_utils.h"
+#include "soft_msaa.h"
+#include "soft_shader.h"
+
+#include <chrono>
+#include <cmath>
+#include <cstdlib>
+#include <iostream>
+#include <random>
+#include <vector>
+
+using namespace std;
+
+static const int BENCH_WIDTH = 1024;
+static const int BENCH_HEIGHT = 768;
+
+// compiled for both GL and the CPU, so the two run the same shader
+static const char* msaaVertexSource = R"(#version 330 core
+layout (location = 0) in vec3 aPos;
+layout (location = 1) in vec3 aColor;
+out vec3 color;
+void main()
+{
+	gl_Position = vec4(aPos, 1.0);
+	color = aColor;
+}
+)";
+
+static const char* msaaFragmentSource = R"(#version 330 core
+in vec3 color;
+out vec4 FragColor;
+void main()
+{
+	FragColor = vec4(color, 1.0);
+}
+)";
+
+// aPos and aColor of depth tested triangles 50-300 pixels across,
+// interleaved like the triangle's VBO
+static vector<float> makeMsaaScene(int triangleCount)
+{
+	mt19937 random(99);
+	uniform_real_distribution<float> unit(0.0f, 1.0f);
+	vector<float> data((size_t)triangleCount * 3 * 6);
+	for (int t = 0; t < triangleCount; t++)
+	{
+		float cx = unit(random) * BENCH_WIDTH, cy = unit(random) * BENCH_HEIGHT;
+		float size = 50.0f + 250.0f * unit(random);
+		for (int k = 0; k < 3; k++)
+		{
+			float* v = &data[((size_t)t * 3 + k) * 6];
+			float angle = (t * 0.7f) + k * 2.0944f;
+			v[0] = (cx + size * 0.5f * cos(angle)) / BENCH_WIDTH * 2.0f - 1.0f;
+			v[1] = (cy + size * 0.5f * sin(angle)) / BENCH_HEIGHT * 2.0f - 1.0f;
+			v[2] = unit(random) * 1.8f - 0.9f;
+			v[3] = unit(random);
+			v[4] = unit(random);
+			v[5] = unit(random);
+		}
+	}
+	return data;
+}
+
+static bool buildMsaaProgram(SoftProgram& program, const vector<float>& scene, SoftVertexBuffer& vertices)
+{
+	string log;
+	if (!program.build(msaaVertexSource, msaaFragmentSource, &log))
+	{
+		cout << "ERROR::BENCHMARK::MSAA::BUILD_FAILED\n" << log << endl;
+		return false;
+	}
+	SoftVertexArray input;
+	input.attributes[0] = { scene.data(), 3, 6 };
+	input.attributes[1] = { scene.data() + 3, 3, 6 };
+	program.runVertexShader(input, (int)(scene.size() / 6), 0, vertices);
+	return true;
+}
+
+// draws the scene into a multisampled target of the given sample count and
+// resolves it into out
+static void renderMsaa(SoftRasterizer& rasterizer, SoftMultisampleFramebuffer& target, SoftDepthBuffer& depth,
+	SoftProgram& program, const SoftVertexBuffer& vertices, SoftFramebuffer& out)
+{
+	target.clear(0);
+	depth.clear(1.0f);
+	rasterizer.setTarget(&target);
+	rasterizer.setDepthTarget(&depth);
+	rasterizer.drawTriangles(vertices, nullptr, 0, program);
+	target.resolve(out);
+}
+
+int runMsaaBenchmark(int triangleCount)
+{
+	typedef chrono::high_resolution_clock Clock;
+	vector<float> scene = makeMsaaScene(triangleCount);
+	SoftProgram program;
+	SoftVertexBuffer vertices;
+	if (!buildMsaaProgram(program, scene, vertices))
+		return 1;
+
+	cout << "CPU MSAA benchmark: " << triangleCount << " depth tested triangles, " << BENCH_WIDTH << "x" << BENCH_HEIGHT
+		<< ", " << SOFT_DEPTH_TILE_SIZE << "x" << SOFT_DEPTH_TILE_SIZE << " tiles" << endl;
+
+	SoftRasterizer rasterizer;
+	SoftFramebuffer out;
+	double baseMilliseconds = 0.0;
+	size_t baseBytes = 0;
+	for (int samples : { 1, 4, 8 })
+	{
+		// 1x draws straight into out, the others resolve into it
+		SoftMultisampleFramebuffer target;
+		SoftDepthBuffer depth;
+		depth.resize(BENCH_WIDTH, BENCH_HEIGHT, samples);
+		out.resize(BENCH_WIDTH, BENCH_HEIGHT);
+		if (samples > 1)
+			target.resize(BENCH_WIDTH, BENCH_HEIGHT, samples);
+
+		// draw and resolve timed apart, each the best of several frames
+		double drawMilliseconds = 1e30, resolveMilliseconds = 1e30;
+		size_t colorBytes = 0;
+		int expanded = 0;
+		double seconds = 0.0;
+		auto begin = Clock::now();
+		for (int frame = 0; frame < 3 || seconds < 0.5; frame++)
+		{
+			auto start = Clock::now();
+			depth.clear(1.0f);
+			rasterizer.setDepthTarget(nullptr);
+			if (samples > 1)
+			{
+				target.clear(0);
+				rasterizer.setTarget(&target);
+			}
+			else
+			{
+				out.clear(0);
+				rasterizer.setTarget(&out);
+			}
+			rasterizer.setDepthTarget(&depth);
+			rasterizer.resetStats();
+			rasterizer.drawTriangles(vertices, nullptr, 0, program);
+			auto drawn = Clock::now();
+			expanded = target.expandedTiles();
+			colorBytes = samples > 1 ? target.memoryBytes() : out.color.size() * sizeof(uint32_t);
+			if (samples > 1)
+				target.resolve(out);
+			auto resolved = Clock::now();
+			drawMilliseconds = min(drawMilliseconds, chrono::duration<double, milli>(drawn - start).count());
+			resolveMilliseconds = min(resolveMilliseconds, chrono::duration<double, milli>(resolved - drawn).count());
+			seconds = chrono::duration<double>(resolved - begin).count();
+		}
+
+		double total = drawMilliseconds + resolveMilliseconds;
+		size_t depthBytes = depth.blocks.size() * sizeof(vec8f);
+		if (samples == 1)
+		{
+			baseMilliseconds = total;
+			baseBytes = colorBytes + depthBytes;
+		}
+		// what the color would take with a value per sample everywhere
+		size_t uncompressed = (size_t)BENCH_WIDTH * BENCH_HEIGHT * samples * sizeof(uint32_t);
+		const double mb = 1.0 / (1 << 20);
+		cout << "  " << samples << "x: " << expanded << " of " << depth.tilesX * depth.tilesY << " tiles expanded, color "
+			<< colorBytes * mb << " MB (" << uncompressed * mb << " MB without compression), depth " << depthBytes * mb << " MB, "
+			<< (double)(colorBytes + depthBytes) / baseBytes << "x the memory of 1x" << endl;
+		cout << "      " << rasterizer.stats().shadedFragments << " fragments shaded, draw " << drawMilliseconds << " ms, resolve "
+			<< resolveMilliseconds << " ms, " << total / baseMilliseconds << "x the time of 1x" << endl;
+	}
+	rasterizer.setTarget((SoftFramebuffer*)nullptr);
+	rasterizer.setDepthTarget(nullptr);
+	return 0;
+}
+
+int runMsaaSelfTest(int triangleCount)
+{
+	GLint maxSamples = 0;
+	glGetIntegerv(GL_MAX_SAMPLES, &maxSamples);
+	if (maxSamples < 4)
+	{
+		cout << "GL_MAX_SAMPLES is " << maxSamples << ", skipping the 4x MSAA comparison" << endl;
+		return 0;
+	}
+
+	vector<float> scene = makeMsaaScene(triangleCount);
+	SoftProgram softProgram;
+	SoftVertexBuffer vertices;
+	if (!buildMsaaProgram(softProgram, scene, vertices))
+		return 1;
+	unsigned int program = buildProgram(msaaVertexSource, msaaFragmentSource, "msaa");
+	if (!program)
+		return 1;
+
+	// 4x color and depth, resolved by a blit into a single sampled target
+	GLuint framebuffers[2], renderbuffers[3];
+	glGenFramebuffers(2, framebuffers);
+	glGenRenderbuffers(3, renderbuffers);
+	glBindRenderbuffer(GL_RENDERBUFFER, renderbuffers[0]);
+	glRenderbufferStorageMultisample(GL_RENDERBUFFER, 4, GL_RGBA8, BENCH_WIDTH, BENCH_HEIGHT);
+	glBindRenderbuffer(GL_RENDERBUFFER, renderbuffers[1]);
+	glRenderbufferStorageMultisample(GL_RENDERBUFFER, 4, GL_DEPTH_COMPONENT32F, BENCH_WIDTH, BENCH_HEIGHT);
+	glBindRenderbuffer(GL_RENDERBUFFER, renderbuffers[2]);
+	glRenderbufferStorage(GL_RENDERBUFFER, GL_RGBA8, BENCH_WIDTH, BENCH_HEIGHT);
+	gpuMemory.trackRenderbuffer(renderbuffers[0], GPU_MEMORY_RENDER_TARGET, gpuImageBytes(GL_RGBA8, BENCH_WIDTH, BENCH_HEIGHT, 4));
+	gpuMemory.trackRenderbuffer(renderbuffers[1], GPU_MEMORY_RENDER_TARGET, gpuImageBytes(GL_DEPTH_COMPONENT32F, BENCH_WIDTH, BENCH_HEIGHT, 4));
+	gpuMemory.trackRenderbuffer(renderbuffers[2], GPU_MEMORY_RENDER_TARGET, gpuImageBytes(GL_RGBA8, BENCH_WIDTH, BENCH_HEIGHT));
+	glBindFramebuffer(GL_FRAMEBUFFER, framebuffers[0]);
+	glFramebufferRenderbuffer(GL_FRAMEBUFFER, GL_COLOR_ATTACHMENT0, GL_RENDERBUFFER, renderbuffers[0]);
+	glFramebufferRenderbuffer(GL_FRAMEBUFFER, GL_DEPTH_ATTACHMENT, GL_RENDERBUFFER, renderbuffers[1]);
+	glBindFramebuffer(GL_FRAMEBUFFER, framebuffers[1]);
+	glFramebufferRenderbuffer(GL_FRAMEBUFFER, GL_COLOR_ATTACHMENT0, GL_RENDERBUFFER, renderbuffers[2]);
+
+	// the comparison only means something with the same sample positions
+	glBindFramebuffer(GL_FRAMEBUFFER, framebuffers[0]);
+	const SoftSamplePattern& pattern = softSamplePattern(4);
+	bool samePattern = true;
+	for (int s = 0; s < 4; s++)
+	{
+		float position[2];
+		glGetMultisamplefv(GL_SAMPLE_POSITION, s, position);
+		samePattern = samePattern && lrintf((position[0] - 0.5f) * 256.0f) == pattern.x[s] && lrintf((position[1] - 0.5f) * 256.0f) == pattern.y[s];
+	}
+	if (!samePattern)
+		cout << "GL uses other 4x sample positions, expect differences along edges" << endl;
+
+	GLuint vao, vbo;
+	glGenVertexArrays(1, &vao);
+	glGenBuffers(1, &vbo);
+	glBindVertexArray(vao);
+	glBindBuffer(GL_ARRAY_BUFFER, vbo);
+	glBufferData(GL_ARRAY_BUFFER, scene.size() * sizeof(float), scene.data(), GL_STATIC_DRAW);
+	gpuMemory.trackBuffer(vbo, GPU_MEMORY_VERTEX, scene.size() * sizeof(float));
+	glVertexAttribPointer(0, 3, GL_FLOAT, GL_FALSE, 6 * sizeof(float), (void*)0);
+	glEnableVertexAttribArray(0);
+	glVertexAttribPointer(1, 3, GL_FLOAT, GL_FALSE, 6 * sizeof(float), (void*)(3 * sizeof(float)));
+	glEnableVertexAttribArray(1);
+
+	glViewport(0, 0, BENCH_WIDTH, BENCH_HEIGHT);
+	glClearColor(0.0f, 0.0f, 0.0f, 0.0f);
+	glClear(GL_COLOR_BUFFER_BIT | GL_DEPTH_BUFFER_BIT);
+	glEnable(GL_DEPTH_TEST);
+	glUseProgram(program);
+	glDrawArrays(GL_TRIANGLES, 0, triangleCount * 3);
+	glDisable(GL_DEPTH_TEST);
+	glBindFramebuffer(GL_READ_FRAMEBUFFER, framebuffers[0]);
+	glBindFramebuffer(GL_DRAW_FRAMEBUFFER, framebuffers[1]);
+	glBlitFramebuffer(0, 0, BENCH_WIDTH, BENCH_HEIGHT, 0, 0, BENCH_WIDTH, BENCH_HEIGHT, GL_COLOR_BUFFER_BIT, GL_NEAREST);
+	glBindFramebuffer(GL_READ_FRAMEBUFFER, framebuffers[1]);
+	vector<uint32_t> gl((size_t)BENCH_WIDTH * BENCH_HEIGHT);
+	glPixelStorei(GL_PACK_ALIGNMENT, 4);
+	glReadPixels(0, 0, BENCH_WIDTH, BENCH_HEIGHT, GL_RGBA, GL_UNSIGNED_BYTE, gl.data());
+
+	gpuMemory.report("GPU memory for the GL side");
+	glBindFramebuffer(GL_FRAMEBUFFER, 0);
+	glDeleteVertexArrays(1, &vao);
+	gpuMemory.forgetBuffer(vbo);
+	glDeleteBuffers(1, &vbo);
+	for (GLuint renderbuffer : renderbuffers)
+		gpuMemory.forgetRenderbuffer(renderbuffer);
+	glDeleteRenderbuffers(3, renderbuffers);
+	glDeleteFramebuffers(2, framebuffers);
+	glDeleteProgram(program);
+
+	SoftRasterizer rasterizer;
+	SoftMultisampleFramebuffer target;
+	target.resize(BENCH_WIDTH, BENCH_HEIGHT, 4);
+	SoftDepthBuffer depth;
+	depth.resize(BENCH_WIDTH, BENCH_HEIGHT, 4);
+	SoftFramebuffer out;
+	renderMsaa(rasterizer, target, depth, softProgram, vertices, out);
+
+	// edge pixels average the same samples, so they agree up to rounding;
+	// only pixels where two triangles' depths tie may pick other samples
+	int differing = 0, largest = 0;
+	for (int y = 0; y < BENCH_HEIGHT; y++)
+	{
+		for (int x = 0; x < BENCH_WIDTH; x++)
+		{
+			uint32_t a = gl[(size_t)y * BENCH_WIDTH + x], b = out.pixel(x, y);
+			int difference = 0;
+			for (int c = 0; c < 32; c += 8)
+				difference = max(difference, abs((int)((a >> c) & 0xff) - (int)((b >> c) & 0xff)));
+			largest = max(largest, difference);
+			differing += difference > 1 ? 1 : 0;
+		}
+	}
+	double fraction = (double)differing / ((double)BENCH_WIDTH * BENCH_HEIGHT);
+	cout << "4x MSAA against GL: " << differing << " pixels differ by more than 1 (" << fraction * 100.0 << "%), largest difference "
+		<< largest << ", " << target.expandedTiles() << " tiles expanded" << endl;
+	if (fraction > 1e-3)
+	{
+		cout << "ERROR::BENCHMARK::MSAA::MISMATCH" << endl;
+		return 1;
+	}
+	return 0;
+}
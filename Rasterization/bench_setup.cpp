@@ -0,0 +1,132 @@
+#include "benchmarks.h"
+#include "soft_raster.h"
+
+#include <chrono>
+#include <cmath>
+#include <iostream>
+#include <random>
+#include <vector>
+
+using namespace std;
+
+static const int BENCH_WIDTH = 1024;
+static const int BENCH_HEIGHT = 768;
+
+// one color, so the time goes to setup rather than shading
+class FlatShader : public SoftFragmentShader
+{
+public:
+	int shade(const SoftFragmentBlock& block, vec8f rgba[4]) override
+	{
+		rgba[0] = vec8f(1.0f);
+		rgba[1] = vec8f(0.5f);
+		rgba[2] = vec8f(0.2f);
+		rgba[3] = vec8f(1.0f);
+		return block.mask;
+	}
+};
+
+struct SetupScene
+{
+	const char* name;
+	float size;			// pixels across
+	float spread;		// centers in [-spread, spread] in NDC
+	float nearPlane;	// chance of a vertex in front of the near plane
+	SoftCullMode cull;
+};
+
+// random triangles of about size pixels with a random winding
+static void makeScene(const SetupScene& scene, int triangleCount, SoftVertexBuffer& vertices)
+{
+	mt19937 random(1234);
+	uniform_real_distribution<float> unit(0.0f, 1.0f);
+	vertices.resize(triangleCount * 3, 0);
+	for (int t = 0; t < triangleCount; t++)
+	{
+		float cx = (unit(random) * 2.0f - 1.0f) * scene.spread;
+		float cy = (unit(random) * 2.0f - 1.0f) * scene.spread;
+		for (int k = 0; k < 3; k++)
+		{
+			float x = cx + (unit(random) - 0.5f) * scene.size * 2.0f / BENCH_WIDTH;
+			float y = cy + (unit(random) - 0.5f) * scene.size * 2.0f / BENCH_HEIGHT;
+			float w = 0.5f + unit(random);
+			float z = unit(random) < scene.nearPlane ? -1.5f : unit(random) * 1.8f - 0.9f;
+			vertices.setPosition(t * 3 + k, x * w, y * w, z * w, w);
+		}
+	}
+}
+
+struct SetupRun
+{
+	double milliseconds;
+	SoftRasterStats stats;
+	vector<uint32_t> color;
+};
+
+static SetupRun measure(SoftRasterizer& rasterizer, SoftFramebuffer& framebuffer, const SoftVertexBuffer& vertices)
+{
+	typedef chrono::high_resolution_clock Clock;
+	FlatShader shader;
+	SetupRun run;
+	int frames = 0;
+	double seconds = 0.0;
+	auto start = Clock::now();
+	while (seconds < 0.25)
+	{
+		framebuffer.clear(0);
+		rasterizer.resetStats();
+		rasterizer.drawTriangles(vertices, nullptr, 0, shader);
+		frames++;
+		seconds = chrono::duration<double>(Clock::now() - start).count();
+	}
+	run.milliseconds = seconds * 1e3 / frames;
+	run.stats = rasterizer.stats();
+	run.color = framebuffer.color;
+	return run;
+}
+
+int runSetupBenchmark(int triangleCount)
+{
+	SoftFramebuffer framebuffer;
+	framebuffer.resize(BENCH_WIDTH, BENCH_HEIGHT);
+	SoftRasterizer rasterizer;
+	rasterizer.setTarget(&framebuffer);
+
+	cout << "CPU triangle setup benchmark: " << triangleCount << " triangles, " << BENCH_WIDTH << "x" << BENCH_HEIGHT
+		<< ", guard band " << SOFT_GUARD_BAND << " pixels" << endl;
+
+	const SetupScene scenes[] = {
+		{ "small on screen", 4.0f, 1.0f, 0.0f, SOFT_CULL_NONE },
+		{ "small, back faces culled", 4.0f, 1.0f, 0.0f, SOFT_CULL_BACK },
+		{ "mostly outside the view", 40.0f, 6.0f, 0.0f, SOFT_CULL_NONE },
+		{ "small, a third crossing the near plane", 4.0f, 1.0f, 0.15f, SOFT_CULL_NONE },
+	};
+	for (const SetupScene& scene : scenes)
+	{
+		SoftVertexBuffer vertices;
+		makeScene(scene, triangleCount, vertices);
+		rasterizer.setCullMode(scene.cull);
+
+		rasterizer.setBatchedSetup(false);
+		SetupRun single = measure(rasterizer, framebuffer, vertices);
+		rasterizer.setBatchedSetup(true);
+		SetupRun batched = measure(rasterizer, framebuffer, vertices);
+		if (single.color != batched.color)
+		{
+			cout << "ERROR::BENCHMARK::SETUP::BATCHING_CHANGED_THE_IMAGE " << scene.name << endl;
+			return 1;
+		}
+
+		const SoftRasterStats& s = batched.stats;
+		cout << "  " << scene.name << ": " << s.culledTriangles << " culled, " << s.clippedTriangles << " clipped, "
+			<< s.fragments << " fragments" << endl;
+		const pair<const char*, const SetupRun*> runs[] = { { "one at a time", &single }, { "8 per batch", &batched } };
+		for (const auto& r : runs)
+		{
+			cout << "    " << r.first << ": " << r.second->milliseconds << " ms, "
+				<< triangleCount / (r.second->milliseconds * 1e3) << " Mtriangles/s" << endl;
+		}
+	}
+	rasterizer.setCullMode(SOFT_CULL_NONE);
+	return 0;
+}
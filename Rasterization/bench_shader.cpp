@@ -0,0 +1,197 @@
+#include "benchmarks.h"
+#include "soft_shader.h"
+#include "soft_texture.h"
+
+#include <chrono>
+#include <cmath>
+#include <iostream>
+#include <random>
+#include <vector>
+
+using namespace std;
+
+static const int BENCH_WIDTH = 1024;
+static const int BENCH_HEIGHT = 768;
+
+// a heavier shader than the triangle: normalize, pow in a loop, a texture
+// read and a divergent branch per fragment
+static const char* litVertexSource = R"(#version 330 core
+layout (location = 0) in vec3 aPos;
+layout (location = 1) in vec3 aColor;
+out vec3 normal;
+out vec2 uv;
+out vec3 color;
+void main()
+{
+	gl_Position = vec4(aPos, 1.0);
+	normal = aColor * 2.0 - 1.0;
+	uv = aPos.xy * 4.0;
+	color = aColor;
+}
+)";
+
+static const char* litFragmentSource = R"(#version 330 core
+in vec3 normal;
+in vec2 uv;
+in vec3 color;
+uniform sampler2D albedo;
+uniform vec3 lightDir;
+out vec4 FragColor;
+
+float checker(vec2 p)
+{
+	vec2 cell = floor(p * 8.0);
+	return mod(cell.x + cell.y, 2.0);
+}
+
+void main()
+{
+	vec3 n = normalize(normal);
+	float diffuse = max(dot(n, lightDir), 0.0);
+	vec3 base = texture(albedo, uv).rgb * color;
+	float rim = 0.0;
+	for (int i = 0; i < 4; i++)
+		rim += pow(1.0 - abs(n.z), float(i + 1)) * 0.1;
+	if (checker(uv) > 0.5)
+		base *= 0.8;
+	else
+		base = mix(base, vec3(1.0), 0.1);
+	FragColor = vec4(base * (0.2 + diffuse) + rim, 1.0);
+}
+)";
+
+// a 4x4 checkerboard per unit of s and t, 16 texels per cell
+static void makeCheckerTexture(SoftTexture& texture)
+{
+	const int size = 64;
+	vector<uint32_t> texels((size_t)size * size);
+	for (int y = 0; y < size; y++)
+	{
+		for (int x = 0; x < size; x++)
+		{
+			int value = ((x / 16 + y / 16) & 1) ? 191 : 64;
+			texels[(size_t)y * size + x] = packRGBA8(value, value, value, 255);
+		}
+	}
+	texture.load(size, size, texels.data());
+}
+
+// aPos and aColor of triangles 20-60 pixels across, interleaved like the
+// triangle's VBO
+static vector<float> makeTriangles(int triangleCount)
+{
+	mt19937 random(4321);
+	uniform_real_distribution<float> unit(0.0f, 1.0f);
+	vector<float> data((size_t)triangleCount * 3 * 6);
+	for (int t = 0; t < triangleCount; t++)
+	{
+		float cx = unit(random) * BENCH_WIDTH, cy = unit(random) * BENCH_HEIGHT;
+		float size = 20.0f + 40.0f * unit(random);
+		for (int k = 0; k < 3; k++)
+		{
+			float* v = &data[((size_t)t * 3 + k) * 6];
+			float angle = (t * 0.7f) + k * 2.0944f;
+			v[0] = (cx + size * 0.5f * cos(angle)) / BENCH_WIDTH * 2.0f - 1.0f;
+			v[1] = (cy + size * 0.5f * sin(angle)) / BENCH_HEIGHT * 2.0f - 1.0f;
+			v[2] = unit(random) * 2.0f - 1.0f;
+			v[3] = unit(random);
+			v[4] = unit(random);
+			v[5] = unit(random);
+		}
+	}
+	return data;
+}
+
+// vertex shading once, then fragment shading repeated for at least half a second
+static void measure(const char* name, SoftProgram& program, const vector<float>& triangles, SoftRasterizer& rasterizer)
+{
+	typedef chrono::high_resolution_clock Clock;
+	int vertexCount = (int)(triangles.size() / 6);
+	SoftVertexArray input;
+	input.attributes[0] = { triangles.data(), 3, 6 };
+	input.attributes[1] = { triangles.data() + 3, 3, 6 };
+
+	SoftVertexBuffer vertices;
+	auto start = Clock::now();
+	program.runVertexShader(input, vertexCount, 0, vertices);
+	double vertexSeconds = chrono::duration<double>(Clock::now() - start).count();
+
+	rasterizer.resetStats();
+	uint64_t firstInstruction = program.instructionCount();
+	start = Clock::now();
+	double seconds = 0.0;
+	while (seconds < 0.5)
+	{
+		rasterizer.drawTriangles(vertices, nullptr, 0, program);
+		seconds = chrono::duration<double>(Clock::now() - start).count();
+	}
+
+	const SoftRasterStats& stats = rasterizer.stats();
+	double instructions = (double)(program.instructionCount() - firstInstruction);
+	cout << "  " << name << ": " << stats.fragments / seconds * 1e-6 << " Mfragments/s, "
+		<< vertexCount / vertexSeconds * 1e-6 << " Mvertices/s, "
+		<< instructions / stats.blocks << " instructions per 8 fragments" << endl;
+}
+
+int runShaderBenchmark(const ShaderProgramDesc& triangleDesc, int triangleCount)
+{
+	SoftFramebuffer framebuffer;
+	framebuffer.resize(BENCH_WIDTH, BENCH_HEIGHT);
+	SoftRasterizer rasterizer;
+	rasterizer.setTarget(&framebuffer);
+	vector<float> triangles = makeTriangles(triangleCount);
+
+	cout << "CPU shader benchmark: " << triangleCount << " triangles, " << BENCH_WIDTH << "x" << BENCH_HEIGHT
+		<< ", " << (SIMD_AVX2 ? "AVX2" : "SSE2") << ", one core" << endl;
+
+	// the triangle shaders, preprocessed like their GL permutations
+	struct Variant
+	{
+		const char* name;
+		unsigned int mask;
+	};
+	const Variant variants[] = { { "triangle", 0 }, { "triangle + vertex color", 1 } };
+	for (const Variant& variant : variants)
+	{
+		SoftProgram program;
+		string log;
+		if (!program.build(triangleDesc, variant.mask, &log))
+		{
+			cout << "ERROR::BENCHMARK::SHADER::BUILD_FAILED " << variant.name << "\n" << log << endl;
+			return 1;
+		}
+		measure(variant.name, program, triangles, rasterizer);
+
+		// BASE_COLOR from common.glsl
+		if (variant.mask == 0)
+		{
+			framebuffer.clear(0);
+			float one[] = { -0.5f, -0.5f, 0.0f, 0.5f, -0.5f, 0.0f, 0.0f, 0.5f, 0.0f };
+			SoftVertexArray input;
+			input.attributes[0] = { one, 3, 3 };
+			SoftVertexBuffer vertices;
+			program.runVertexShader(input, 3, 0, vertices);
+			rasterizer.drawTriangles(vertices, nullptr, 0, program);
+			if (framebuffer.pixel(BENCH_WIDTH / 2, BENCH_HEIGHT / 2) != packRGBA8(255, 128, 51, 255))
+			{
+				cout << "ERROR::BENCHMARK::SHADER::WRONG_COLOR" << endl;
+				return 1;
+			}
+		}
+	}
+
+	SoftProgram lit;
+	string log;
+	if (!lit.build(litVertexSource, litFragmentSource, &log))
+	{
+		cout << "ERROR::BENCHMARK::SHADER::BUILD_FAILED lit\n" << log << endl;
+		return 1;
+	}
+	SoftTexture checker;
+	makeCheckerTexture(checker);
+	const float lightDir[] = { 0.267f, 0.535f, 0.802f };
+	lit.setUniform(lit.uniformLocation("lightDir"), lightDir, 3);
+	lit.setSampler(lit.uniformLocation("albedo"), &checker);
+	measure("lit (loop, branch, texture)", lit, triangles, rasterizer);
+	return 0;
+}
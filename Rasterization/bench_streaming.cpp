@@ -0,0 +1,273 @@
+#include "benchmarks.h"
+#include "frame_encoder.h"
+#include "gl_ext.h"
+#include "gpu_memory.h"
+#include "image_compare.h"
+#include "texture_compressor.h"
+#include "texture_streamer.h"
+
+#include <chrono>
+#include <cmath>
+#include <cstdlib>
+#include <cstdio>
+#include <filesystem>
+#include <iostream>
+#include <thread>
+#include <vector>
+
+using namespace std;
+namespace fs = std::filesystem;
+
+typedef chrono::high_resolution_clock Clock;
+
+static const int STREAM_TEXTURE_SIZE = 1024;
+
+// a different smooth pattern per texture, RGB rows top-down for encodeQOI
+static void makeTexture(int index, vector<uint8_t>& rgb)
+{
+	rgb.resize((size_t)STREAM_TEXTURE_SIZE * STREAM_TEXTURE_SIZE * 3);
+	uint8_t* out = rgb.data();
+	for (int y = 0; y < STREAM_TEXTURE_SIZE; y++)
+	{
+		for (int x = 0; x < STREAM_TEXTURE_SIZE; x++, out += 3)
+		{
+			out[0] = (uint8_t)(128.0f + 127.0f * sinf(x * 0.011f + index));
+			out[1] = (uint8_t)(128.0f + 127.0f * cosf(y * 0.017f - index * 0.5f));
+			out[2] = (uint8_t)((x + y + index * 16) >> 3);
+		}
+	}
+}
+
+// FNV-1a over the RGB of bottom-up RGBA rows, the same for both sides
+static uint64_t hashRGBA(const uint32_t* pixels, size_t count)
+{
+	uint64_t hash = 14695981039346656037ull;
+	for (size_t i = 0; i < count; i++)
+		hash = (hash ^ (pixels[i] & 0xffffff)) * 1099511628211ull;
+	return hash;
+}
+
+// the largest difference of any channel, for decoders allowed to round apart
+static int maxChannelDifference(const uint32_t* a, const uint32_t* b, size_t count)
+{
+	int largest = 0;
+	for (size_t i = 0; i < count; i++)
+	{
+		for (int shift = 0; shift < 32; shift += 8)
+			largest = max(largest, abs((int)((a[i] >> shift) & 0xff) - (int)((b[i] >> shift) & 0xff)));
+	}
+	return largest;
+}
+
+struct StreamRun
+{
+	vector<int> handles;
+	double milliseconds = 0.0;
+	int frames = 0;
+	double longestFrame = 0.0;
+	bool timedOut = false;
+};
+
+// every path through streamer while the render thread keeps drawing frames,
+// paced like vsync at 60 Hz, leaving the cores to the loaders in between
+static StreamRun streamTextures(TextureStreamer& streamer, const vector<string>& paths)
+{
+	StreamRun run;
+	auto start = Clock::now();
+	for (const string& path : paths)
+		run.handles.push_back(streamer.load(path));
+	auto nextFrame = start;
+	while (!streamer.idle() && !run.timedOut)
+	{
+		auto frameStart = Clock::now();
+		glClear(GL_COLOR_BUFFER_BIT);
+		streamer.update();
+		for (int handle : run.handles)
+			glBindTexture(GL_TEXTURE_2D, streamer.texture(handle));
+		glBindTexture(GL_TEXTURE_2D, 0);
+		glFlush();
+		run.frames++;
+		run.longestFrame = max(run.longestFrame, chrono::duration<double, milli>(Clock::now() - frameStart).count());
+		run.timedOut = chrono::duration<double>(Clock::now() - start).count() > 120.0;
+		nextFrame += chrono::microseconds(16667);
+		this_thread::sleep_until(nextFrame);
+	}
+	run.milliseconds = chrono::duration<double, milli>(Clock::now() - start).count();
+	return run;
+}
+
+// the files again, block compressed: once into an empty cache and once from
+// it. What the GPU decodes must match decompressImage() of the cooked blocks,
+// up to the rounding of BC1 and BC3 colors, which S3TC leaves to the driver.
+static int streamCompressed(GLFWwindow* window, const vector<string>& paths, const fs::path& directory,
+	uint64_t uncompressedBytes)
+{
+	BlockFormat format = BLOCK_FORMAT_BC7;
+	if (!glext.bptc)
+		format = BLOCK_FORMAT_BC1;
+	if (format == BLOCK_FORMAT_BC1 && !glext.s3tcSrgb)
+	{
+		cout << "  no BC7 or sRGB BC1 on this driver, compressed streaming skipped" << endl;
+		return 0;
+	}
+	const string cacheDirectory = (directory / "cooked").string();
+	CookedTextureCache cache(cacheDirectory);
+	MipOptions mips;		// the streamer's, for sRGB files
+	int failures = 0;
+	vector<uint32_t> pixels((size_t)STREAM_TEXTURE_SIZE * STREAM_TEXTURE_SIZE);
+	for (int pass = 0; pass < 2; pass++)
+	{
+		TextureStreamer streamer;
+		streamer.setCompression(format, cacheDirectory);
+		if (!streamer.start(window))
+			return 1;
+		StreamRun run = streamTextures(streamer, paths);
+		TextureStreamer::Stats stats = streamer.stats();
+
+		int wrong = 0;
+		CompressedTexture cooked;
+		RgbaImage decoded;
+		for (size_t i = 0; i < paths.size(); i++)
+		{
+			uint64_t contentHash = 0;
+			if (!streamer.resident(run.handles[i]) || !hashFile(paths[i], contentHash)
+				|| !cache.load(CookedTextureCache::key(contentHash, format, &mips), cooked))
+			{
+				wrong++;
+				continue;
+			}
+			decompressImage(format, cooked.level(0), cooked.width, cooked.height, decoded);
+			glBindTexture(GL_TEXTURE_2D, streamer.texture(run.handles[i]));
+			glPixelStorei(GL_PACK_ALIGNMENT, 4);
+			glGetTexImage(GL_TEXTURE_2D, 0, GL_RGBA, GL_UNSIGNED_BYTE, pixels.data());
+			if (maxChannelDifference(pixels.data(), decoded.pixels.data(), pixels.size()) > 1)
+				wrong++;
+		}
+		glBindTexture(GL_TEXTURE_2D, 0);
+		streamer.stop();
+
+		cout << "  " << blockFormatName(format) << (pass == 0 ? ", cooking: " : ", from the cache: ") << run.milliseconds
+			<< " ms, " << paths.size() * 1000.0 / run.milliseconds << " textures/s, " << stats.cacheHits << " cache hits, "
+			<< stats.compressMilliseconds / paths.size() << " ms compressing per texture, longest frame "
+			<< run.longestFrame << " ms; " << stats.textureBytes / 1048576.0 << " MB of textures against "
+			<< uncompressedBytes / 1048576.0 << " MB uncompressed" << endl;
+		if (run.timedOut || wrong > 0 || stats.failed > 0 || (pass == 1 && stats.cacheHits != paths.size()))
+		{
+			cout << "ERROR::BENCHMARK::STREAMING::WRONG_COMPRESSED_TEXTURES " << wrong << " of " << paths.size()
+				<< " wrong or missing, " << stats.failed << " failed, " << stats.cacheHits << " cache hits"
+				<< (run.timedOut ? ", timed out" : "") << endl;
+			failures++;
+		}
+	}
+	return failures > 0 ? 1 : 0;
+}
+
+int runStreamingBenchmark(GLFWwindow* window, int textureCount)
+{
+	fs::path directory = fs::temp_directory_path() / "texture_streaming_benchmark";
+	error_code error;
+	fs::create_directories(directory, error);
+
+	// the files and what each should look like once uploaded
+	vector<string> paths;
+	vector<uint64_t> hashes;
+	vector<uint8_t> rgb, encoded;
+	RgbaImage image;
+	size_t fileBytes = 0;
+	for (int i = 0; i < textureCount; i++)
+	{
+		makeTexture(i, rgb);
+		encodeQOI(rgb.data(), STREAM_TEXTURE_SIZE, STREAM_TEXTURE_SIZE, encoded);
+		paths.push_back((directory / ("texture_" + to_string(i) + ".qoi")).string());
+		FILE* file = fopen(paths.back().c_str(), "wb");
+		bool written = file && fwrite(encoded.data(), 1, encoded.size(), file) == encoded.size();
+		if (file)
+			written = fclose(file) == 0 && written;
+		if (!written || !readQOI(paths.back(), image))
+		{
+			cout << "ERROR::BENCHMARK::STREAMING::WRITE_FAILED " << paths.back() << endl;
+			fs::remove_all(directory, error);
+			return 1;
+		}
+		hashes.push_back(hashRGBA(image.pixels.data(), image.pixels.size()));
+		fileBytes += encoded.size();
+	}
+
+	cout << "Texture streaming benchmark: " << textureCount << " QOI textures of " << STREAM_TEXTURE_SIZE << "x"
+		<< STREAM_TEXTURE_SIZE << ", " << fileBytes / (1 << 20) << " MB of files, mipmapped" << endl;
+
+	// loading on the render thread: every texture is a frame that waits
+	// for the decode and the upload
+	double longestSync = 0.0;
+	auto start = Clock::now();
+	for (int i = 0; i < textureCount; i++)
+	{
+		auto textureStart = Clock::now();
+		readQOI(paths[i], image);
+		GLuint texture;
+		glGenTextures(1, &texture);
+		glBindTexture(GL_TEXTURE_2D, texture);
+		glPixelStorei(GL_UNPACK_ALIGNMENT, 4);
+		glTexImage2D(GL_TEXTURE_2D, 0, GL_SRGB8_ALPHA8, image.width, image.height, 0, GL_RGBA, GL_UNSIGNED_BYTE, image.pixels.data());
+		glGenerateMipmap(GL_TEXTURE_2D);
+		glBindTexture(GL_TEXTURE_2D, 0);
+		glFinish();
+		glDeleteTextures(1, &texture);
+		longestSync = max(longestSync, chrono::duration<double, milli>(Clock::now() - textureStart).count());
+	}
+	double syncMilliseconds = chrono::duration<double, milli>(Clock::now() - start).count();
+
+	// streamed: the render thread keeps drawing frames while they load
+	TextureStreamer streamer;
+	if (!streamer.start(window))
+	{
+		fs::remove_all(directory, error);
+		return 1;
+	}
+	StreamRun run = streamTextures(streamer, paths);
+	const vector<int>& handles = run.handles;
+	TextureStreamer::Stats stats = streamer.stats();
+	gpuMemory.report("  GPU memory with every texture resident");
+
+	// what arrived: the base level as written, the mip chain there
+	int wrong = 0;
+	vector<uint32_t> pixels((size_t)STREAM_TEXTURE_SIZE * STREAM_TEXTURE_SIZE);
+	for (int i = 0; i < textureCount; i++)
+	{
+		if (!streamer.resident(handles[i]))
+		{
+			wrong++;
+			continue;
+		}
+		GLint lastWidth = 0;
+		glBindTexture(GL_TEXTURE_2D, streamer.texture(handles[i]));
+		glPixelStorei(GL_PACK_ALIGNMENT, 4);
+		glGetTexImage(GL_TEXTURE_2D, 0, GL_RGBA, GL_UNSIGNED_BYTE, pixels.data());
+		glGetTexLevelParameteriv(GL_TEXTURE_2D, (int)log2(STREAM_TEXTURE_SIZE), GL_TEXTURE_WIDTH, &lastWidth);
+		if (hashRGBA(pixels.data(), pixels.size()) != hashes[i] || lastWidth != 1)
+			wrong++;
+	}
+	glBindTexture(GL_TEXTURE_2D, 0);
+	streamer.stop();
+
+	cout << "  render thread loading: " << syncMilliseconds << " ms, " << syncMilliseconds / textureCount
+		<< " ms per texture, longest frame " << longestSync << " ms" << endl;
+	cout << "  streamed: " << run.milliseconds << " ms, " << textureCount * 1000.0 / run.milliseconds << " textures/s, "
+		<< stats.uploadedBytes / 1048576.0 * 1000.0 / run.milliseconds << " MB/s through the staging buffers" << endl;
+	cout << "  " << run.frames << " frames meanwhile, longest " << run.longestFrame << " ms, update() at most "
+		<< stats.maxUpdateMilliseconds << " ms; " << stats.decodeMilliseconds / textureCount << " ms decoding ("
+		<< stats.mipMilliseconds / textureCount << " ms of it mips) and "
+		<< stats.uploadMilliseconds / textureCount << " ms uploading per texture, " << stats.stagingWaits << " staging waits" << endl;
+
+	int exitCode = 0;
+	if (run.timedOut || wrong > 0 || stats.failed > 0)
+	{
+		cout << "ERROR::BENCHMARK::STREAMING::WRONG_TEXTURES " << wrong << " of " << textureCount << " wrong or missing, "
+			<< stats.failed << " failed" << (run.timedOut ? ", timed out" : "") << endl;
+		exitCode = 1;
+	}
+	if (streamCompressed(window, paths, directory, stats.textureBytes) != 0)
+		exitCode = 1;
+	fs::remove_all(directory, error);
+	return exitCode;
+}
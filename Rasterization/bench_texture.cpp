@@ -0,0 +1,140 @@
+#include "benchmarks.h"
+#include "soft_texture.h"
+
+#include <chrono>
+#include <cmath>
+#include <iostream>
+#include <random>
+#include <vector>
+
+using namespace std;
+
+static const int BENCH_WIDTH = 1024;
+static const int BENCH_HEIGHT = 768;
+
+// smooth color ramps with noise on top, so neighbouring mips differ
+static vector<uint32_t> makeImage(int size)
+{
+	mt19937 random(99);
+	uniform_int_distribution<int> noise(0, 63);
+	vector<uint32_t> image((size_t)size * size);
+	for (int y = 0; y < size; y++)
+	{
+		for (int x = 0; x < size; x++)
+		{
+			int r = x * 192 / size + noise(random);
+			int g = y * 192 / size + noise(random);
+			int b = ((x / 16 + y / 16) & 1) * 128 + noise(random);
+			image[(size_t)y * size + x] = packRGBA8(r, g, b, 255);
+		}
+	}
+	return image;
+}
+
+// how the screen maps to the texture: texels per pixel and rotation
+struct AccessPattern
+{
+	const char* name;
+	float texelsPerPixel;
+	float degrees;
+};
+
+struct TextureRun
+{
+	double milliseconds;
+	uint64_t fetches;
+	double checksum;
+};
+
+// texture() for every pixel of the screen, walked in the rasterizer's 8x8
+// tiles of 4x2 blocks, with the LOD taken from the quads; repeated for at
+// least a quarter of a second
+static TextureRun measure(SoftTexture& texture, const AccessPattern& pattern)
+{
+	typedef chrono::high_resolution_clock Clock;
+	float angle = pattern.degrees * 3.14159265f / 180.0f;
+	float scale = pattern.texelsPerPixel / texture.width();
+	float dsdx = cos(angle) * scale, dtdx = sin(angle) * scale;
+	float dsdy = -sin(angle) * scale, dtdy = cos(angle) * scale;
+	const vec8f laneX(0, 1, 2, 3, 0, 1, 2, 3), laneY(0, 0, 0, 0, 1, 1, 1, 1);
+	const vec8f laneS = laneX * vec8f(dsdx) + laneY * vec8f(dsdy);
+	const vec8f laneT = laneX * vec8f(dtdx) + laneY * vec8f(dtdy);
+
+	TextureRun run;
+	int frames = 0;
+	double seconds = 0.0;
+	vec8f sum = vec8f::zero();
+	texture.takeFetchCount();
+	auto start = Clock::now();
+	while (seconds < 0.25)
+	{
+		sum = vec8f::zero();
+		for (int ty = 0; ty < BENCH_HEIGHT; ty += SOFT_DEPTH_TILE_SIZE)
+		{
+			for (int tx = 0; tx < BENCH_WIDTH; tx += SOFT_DEPTH_TILE_SIZE)
+			{
+				for (int y = ty; y < ty + SOFT_DEPTH_TILE_SIZE; y += 2)
+				{
+					for (int x = tx; x < tx + SOFT_DEPTH_TILE_SIZE; x += 4)
+					{
+						// pixel centers
+						float px = x + 0.5f, py = y + 0.5f;
+						vec8f s = laneS + vec8f(px * dsdx + py * dsdy);
+						vec8f t = laneT + vec8f(px * dtdx + py * dtdy);
+						vec8f rgba[4];
+						texture.sample(s, t, nullptr, rgba);
+						sum = sum + rgba[0] + rgba[1] + rgba[2];
+					}
+				}
+			}
+		}
+		frames++;
+		seconds = chrono::duration<double>(Clock::now() - start).count();
+	}
+	run.milliseconds = seconds * 1e3 / frames;
+	run.fetches = texture.takeFetchCount() / frames;
+	alignas(32) float lanes[8];
+	sum.store(lanes);
+	run.checksum = 0.0;
+	for (float l : lanes)
+		run.checksum += l;
+	return run;
+}
+
+int runTextureBenchmark(int size)
+{
+	vector<uint32_t> image = makeImage(size);
+	SoftTexture morton, linear;
+	morton.load(size, size, image.data(), SOFT_TEXTURE_MORTON);
+	linear.load(size, size, image.data(), SOFT_TEXTURE_LINEAR);
+
+	cout << "CPU texture benchmark: " << size << "x" << size << " RGBA8, " << morton.levelCount() << " levels, "
+		<< morton.memoryBytes() / (1024.0 * 1024.0) << " MB, trilinear, " << BENCH_WIDTH << "x" << BENCH_HEIGHT << " samples per frame" << endl;
+
+	const AccessPattern patterns[] = {
+		{ "magnified 4x", 0.25f, 0.0f },
+		{ "minified 2.5x", 2.5f, 0.0f },
+		{ "rotated 70 degrees, 1.2x", 1.2f, 70.0f },
+	};
+	const double samples = (double)BENCH_WIDTH * BENCH_HEIGHT;
+	for (const AccessPattern& pattern : patterns)
+	{
+		TextureRun z = measure(morton, pattern);
+		TextureRun rows = measure(linear, pattern);
+		if (z.checksum != rows.checksum)
+		{
+			cout << "ERROR::BENCHMARK::TEXTURE::LAYOUTS_DISAGREE " << pattern.name << endl;
+			return 1;
+		}
+		cout << "  " << pattern.name << ": " << z.fetches / samples << " texel fetches per sample" << endl;
+		const pair<const char*, const TextureRun*> runs[] = { { "Z-order tiles", &z }, { "linear rows", &rows } };
+		for (const auto& r : runs)
+		{
+			double perSecond = 1e3 / r.second->milliseconds;
+			cout << "    " << r.first << ": " << r.second->milliseconds << " ms, "
+				<< samples * perSecond / 1e6 << " M filtered texels/s, "
+				<< r.second->fetches * perSecond / 1e6 << " M texel fetches/s" << endl;
+		}
+	}
+	return 0;
+}
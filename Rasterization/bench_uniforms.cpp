@@ -0,0 +1,152 @@
+#include "benchmarks.h"
+#include "frame_arena.h"
+#include "gpu_memory.h"
+#include "heap_guard.h"
+#include "std140.h"
+#include "uniform_arena.h"
+
+#include <chrono>
+#include <cmath>
+#include <iostream>
+
+using namespace std;
+
+// mirrors DrawBlock in shaders/draw_params.glsl
+struct DrawBlock
+{
+	std140::Vec4 offsetScale;
+	std140::Vec4 drawColor;
+};
+STD140_OFFSET(DrawBlock, offsetScale, 0);
+STD140_OFFSET(DrawBlock, drawColor, 16);
+
+static const GLuint DRAW_BLOCK_BINDING = 0;
+
+// spread the draws over the screen on a grid so they all get rasterized
+static DrawBlock drawParams(int draw, int drawCount)
+{
+	int side = (int)ceil(sqrt((double)drawCount));
+	float cell = 2.0f / side;
+	DrawBlock block;
+	block.offsetScale = { -1.0f + cell * (draw % side + 0.5f), -1.0f + cell * (draw / side + 0.5f), cell, cell };
+	block.drawColor = { (float)(draw % 7) / 6.0f, (float)(draw % 5) / 4.0f, (float)(draw % 3) / 2.0f, 1.0f };
+	return block;
+}
+
+struct FrameTimes
+{
+	double submitSeconds = 0.0;
+	double frameSeconds = 0.0;
+};
+
+static void report(const char* name, const FrameTimes& times, int drawCount, int frameCount)
+{
+	double draws = (double)drawCount * frameCount;
+	cout << "  " << name << ": " << times.submitSeconds * 1e9 / draws << " ns/draw CPU submit, "
+		<< times.frameSeconds * 1e3 / frameCount << " ms/frame incl. glFinish" << endl;
+}
+
+int runUniformBenchmark(GLFWwindow* window, unsigned int plainProgram, unsigned int blockProgram,
+	unsigned int vao, int drawCount, int frameCount)
+{
+	if (!plainProgram || !blockProgram)
+	{
+		cout << "ERROR::BENCHMARK::UNIFORMS::MISSING_PROGRAM" << endl;
+		return 1;
+	}
+
+	GLuint blockIndex = glGetUniformBlockIndex(blockProgram, "DrawBlock");
+	if (blockIndex == GL_INVALID_INDEX ||
+		!checkUniformBlockLayout(blockProgram, "DrawBlock", {
+			{ "offsetScale", offsetof(DrawBlock, offsetScale) },
+			{ "drawColor", offsetof(DrawBlock, drawColor) } }, sizeof(DrawBlock)))
+	{
+		return 1;
+	}
+	glUniformBlockBinding(blockProgram, blockIndex, DRAW_BLOCK_BINDING);
+
+	UniformArena arena;
+	const int framesInFlight = 3;
+	if (!arena.init(GL_UNIFORM_BUFFER, (size_t)drawCount * 256, framesInFlight))
+		return 1;
+
+	int offsetScaleLocation = glGetUniformLocation(plainProgram, "offsetScale");
+	int drawColorLocation = glGetUniformLocation(plainProgram, "drawColor");
+
+	glfwSwapInterval(0);
+	glBindVertexArray(vao);
+
+	cout << "Uniform update benchmark: " << drawCount << " draws x " << frameCount << " frames ("
+		<< (arena.persistent() ? "persistent mapped" : "glBufferSubData") << " arena, "
+		<< arena.alignment() << " byte alignment)" << endl;
+
+	typedef chrono::high_resolution_clock Clock;
+	FrameTimes uniformTimes, arenaTimes;
+	// one untimed frame of each first, so program/buffer setup costs aren't
+	// counted; after it the render thread must not touch the heap
+	for (int frame = -1; frame < frameCount; frame++)
+	{
+		if (frame == 0)
+			armHeapGuard();
+		frameArena.beginFrame();
+
+		// glUniform per draw
+		auto start = Clock::now();
+		glUseProgram(plainProgram);
+		for (int i = 0; i < drawCount; i++)
+		{
+			DrawBlock params = drawParams(i, drawCount);
+			glUniform4fv(offsetScaleLocation, 1, &params.offsetScale.x);
+			glUniform4fv(drawColorLocation, 1, &params.drawColor.x);
+			glDrawArrays(GL_TRIANGLES, 0, 3);
+		}
+		auto submitted = Clock::now();
+		glFinish();
+		auto finished = Clock::now();
+		if (frame >= 0)
+		{
+			uniformTimes.submitSeconds += chrono::duration<double>(submitted - start).count();
+			uniformTimes.frameSeconds += chrono::duration<double>(finished - start).count();
+		}
+
+		// one arena slice per draw
+		start = Clock::now();
+		arena.beginFrame();
+		glUseProgram(blockProgram);
+		UniformSlice* slices = frameArena.allocateArray<UniformSlice>(drawCount);
+		for (int i = 0; i < drawCount; i++)
+			slices[i] = arena.push(drawParams(i, drawCount));
+		arena.flush();
+		for (int i = 0; i < drawCount; i++)
+		{
+			arena.bind(slices[i], DRAW_BLOCK_BINDING);
+			glDrawArrays(GL_TRIANGLES, 0, 3);
+		}
+		arena.endFrame();
+		submitted = Clock::now();
+		glFinish();
+		finished = Clock::now();
+		if (frame >= 0)
+		{
+			arenaTimes.submitSeconds += chrono::duration<double>(submitted - start).count();
+			arenaTimes.frameSeconds += chrono::duration<double>(finished - start).count();
+		}
+
+		glfwSwapBuffers(window);
+		glfwPollEvents();
+		gpuMemory.endFrame();
+	}
+
+	HeapGuardCounts heap = disarmHeapGuard();
+
+	report("glUniform4fv x2  ", uniformTimes, drawCount, frameCount);
+	report("UBO arena slices ", arenaTimes, drawCount, frameCount);
+	gpuMemory.report("GPU memory");
+	if (heap.allocations > 0)
+	{
+		cout << "ERROR::BENCHMARK::UNIFORMS::HEAP_ALLOCATIONS " << heap.allocations << " (" << heap.bytes
+			<< " bytes, the first " << heap.firstSize << ") after the first frame" << endl;
+		return 1;
+	}
+	return 0;
+}
@@ -0,0 +1,99 @@
+#include "benchmarks.h"
+#include "simd.h"
+#include "video_sink.h"
+
+#include <chrono>
+#include <filesystem>
+#include <iostream>
+#include <random>
+#include <vector>
+
+using namespace std;
+namespace fs = std::filesystem;
+
+typedef chrono::high_resolution_clock Clock;
+
+static vector<uint32_t> makeFrame(int width, int height)
+{
+	mt19937 random(3);
+	vector<uint32_t> pixels((size_t)width * height);
+	for (size_t i = 0; i < pixels.size(); i++)
+		pixels[i] = random() | 0xff000000u;
+	return pixels;
+}
+
+// the SIMD conversion must match the scalar one byte for byte, in both
+// layouts, including the odd row and column of odd sizes
+static bool checkConversion(int width, int height)
+{
+	vector<uint32_t> pixels = makeFrame(width, height);
+	CapturedFrame frame = { 0, width, height, pixels.data() };
+	const size_t lumaBytes = (size_t)width * height, chromaBytes = (size_t)(width + 1) / 2 * ((height + 1) / 2);
+	vector<uint8_t> expected(lumaBytes + chromaBytes * 2), actual(expected.size());
+	for (int step = 1; step <= 2; step++)
+	{
+		uint8_t* u0 = expected.data() + lumaBytes;
+		uint8_t* u1 = actual.data() + lumaBytes;
+		const size_t vOffset = step == 1 ? chromaBytes : 1;
+		convertFrameYUV420Reference(frame, expected.data(), u0, u0 + vOffset, step);
+		convertFrameYUV420(frame, actual.data(), u1, u1 + vOffset, step);
+		if (expected != actual)
+			return false;
+	}
+	return true;
+}
+
+int runVideoBenchmark(int frameCount)
+{
+	struct Size { const char* name; int width; int height; };
+	const Size sizes[] = { { "1080p", 1920, 1080 }, { "4K", 3840, 2160 } };
+
+	cout << "Video capture benchmark: " << frameCount << " frames, BT.709 4:2:0" << endl;
+	if (!checkConversion(1920, 1080) || !checkConversion(37, 23))
+	{
+		cout << "ERROR::BENCHMARK::VIDEO::SIMD_MISMATCH" << endl;
+		return 1;
+	}
+
+	const fs::path file = fs::temp_directory_path() / "bench_video.y4m";
+	for (const Size& size : sizes)
+	{
+		vector<uint32_t> pixels = makeFrame(size.width, size.height);
+		vector<uint8_t> yuv((size_t)size.width * size.height * 3 / 2);
+		uint8_t* chroma = yuv.data() + (size_t)size.width * size.height;
+		CapturedFrame frame = { 0, size.width, size.height, pixels.data() };
+
+		auto start = Clock::now();
+		for (int i = 0; i < frameCount; i++)
+			convertFrameYUV420Reference(frame, yuv.data(), chroma, chroma + 1, 2);
+		double scalarMilliseconds = chrono::duration<double, milli>(Clock::now() - start).count() / frameCount;
+		start = Clock::now();
+		for (int i = 0; i < frameCount; i++)
+			convertFrameYUV420(frame, yuv.data(), chroma, chroma + 1, 2);
+		double simdMilliseconds = chrono::duration<double, milli>(Clock::now() - start).count() / frameCount;
+
+		// the whole sink, converting while the writer thread pushes the
+		// previous frame into a file
+		start = Clock::now();
+		VideoSink::Stats stats;
+		{
+			VideoSink sink(file.string(), VIDEO_LAYOUT_Y4M);
+			for (int i = 0; i < frameCount; i++)
+			{
+				frame.index = i;
+				sink.consume(frame);
+			}
+			sink.finish();
+			stats = sink.stats();
+		}
+		double sinkMilliseconds = chrono::duration<double, milli>(Clock::now() - start).count() / frameCount;
+
+		cout << "  " << size.name << ": scalar " << 1000.0 / scalarMilliseconds << " fps, " << (SIMD_AVX2 ? "AVX2 " : "without AVX2 ") << 1000.0 / simdMilliseconds
+			<< " fps (" << scalarMilliseconds / simdMilliseconds << "x)" << endl;
+		cout << "    Y4M into a file: " << 1000.0 / sinkMilliseconds << " fps sustained, " << stats.writeWaits
+			<< " waits for the writer, " << stats.bytes / (1 << 20) << " MB" << endl;
+	}
+	error_code error;
+	fs::remove(file, error);
+	return 0;
+}
@@ -0,0 +1,275 @@
+#include "benchmarks.h"
+#include "gpu_memory.h"
+#include "image_compare.h"
+#include "job_system.h"
+#include "shader_variants.h"
+#include "virtual_texture.h"
+
+#include <chrono>
+#include <cmath>
+#include <iostream>
+#include <thread>
+#include <vector>
+
+using namespace std;
+
+typedef chrono::high_resolution_clock Clock;
+
+static const int BENCH_WIDTH = 960;
+static const int BENCH_HEIGHT = 540;
+
+// feature bits of shaders/virtual_texture.frag
+static const unsigned int VT_FEEDBACK = 1;
+static const unsigned int VT_REFERENCE = 2;
+
+struct TerrainPrograms
+{
+	GLuint main;
+	GLuint feedback;
+	GLuint reference;
+};
+
+static void drawGround(GLuint program, const Mat4& viewProj, GLuint vertexArray)
+{
+	glUniformMatrix4fv(glGetUniformLocation(program, "viewProj"), 1, GL_FALSE, viewProj.m);
+	glUniform1f(glGetUniformLocation(program, "planeSize"), TERRAIN_PLANE_SIZE);
+	glBindVertexArray(vertexArray);
+	glDrawArrays(GL_TRIANGLES, 0, 6);
+	glBindVertexArray(0);
+}
+
+// one frame as the demo draws it: the last feedback's tiles in, this frame's
+// feedback out, then the frame into framebuffer
+static void drawFrame(VirtualTexture& texture, const TerrainPrograms& programs, const Mat4& viewProj, GLuint vertexArray,
+	GLuint framebuffer)
+{
+	texture.update();
+	texture.beginFeedback(BENCH_WIDTH, BENCH_HEIGHT);
+	glUseProgram(programs.feedback);
+	texture.bind(programs.feedback, true);
+	drawGround(programs.feedback, viewProj, vertexArray);
+	texture.endFeedback();
+
+	glBindFramebuffer(GL_FRAMEBUFFER, framebuffer);
+	glClearColor(0.0f, 0.0f, 0.0f, 1.0f);
+	glClear(GL_COLOR_BUFFER_BIT | GL_DEPTH_BUFFER_BIT);
+	glUseProgram(programs.main);
+	texture.bind(programs.main, false);
+	drawGround(programs.main, viewProj, vertexArray);
+}
+
+static void readFrame(RgbaImage& image)
+{
+	image.resize(BENCH_WIDTH, BENCH_HEIGHT);
+	glPixelStorei(GL_PACK_ALIGNMENT, 4);
+	glReadPixels(0, 0, BENCH_WIDTH, BENCH_HEIGHT, GL_RGBA, GL_UNSIGNED_BYTE, image.pixels.data());
+}
+
+// a grid of one texel lines over soft colored squares: sampling the wrong
+// texel, a tile off or across a tile's border shows
+static void makeImage(int size, RgbaImage& image)
+{
+	image.resize(size, size);
+	for (int y = 0; y < size; y++)
+	{
+		uint32_t* row = image.row(y);
+		for (int x = 0; x < size; x++)
+		{
+			int r = (int)(128.0f + 100.0f * sinf(x * 0.05f) * cosf(y * 0.031f));
+			int g = ((x / 16) ^ (y / 16)) & 1 ? 170 : 70;
+			int b = (x * 3 + y * 5) * 255 / (8 * size);
+			if (x % 30 == 0 || y % 30 == 0)
+				r = g = b = 255;
+			row[x] = (uint32_t)r | (uint32_t)g << 8 | (uint32_t)b << 16 | 0xff000000u;
+		}
+	}
+}
+
+static size_t liveGpuBytes()
+{
+	return gpuMemory.stats().liveBytes;
+}
+
+// an image small enough to upload whole, through a cache it fits in: once
+// every page the view asks for is resident the frame must be the mipmapped
+// texture's, sampled at the same level
+static int checkAgainstReference(const TerrainPrograms& programs, GLuint vertexArray, GLuint framebuffer)
+{
+	const int pages = 8;
+	RgbaImage image;
+	makeImage(pages * VIRTUAL_TILE_CONTENT, image);
+	JobSystem jobs(0);
+	ImageTileSource source(image, MipOptions(), &jobs);
+
+	GLTexture reference = GLTexture::create();
+	glBindTexture(GL_TEXTURE_2D, reference.get());
+	glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MIN_FILTER, GL_LINEAR_MIPMAP_NEAREST);
+	glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MAG_FILTER, GL_LINEAR);
+	glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_WRAP_S, GL_CLAMP_TO_EDGE);
+	glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_WRAP_T, GL_CLAMP_TO_EDGE);
+	glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MAX_LEVEL, (GLint)source.levels().size() - 1);
+	glPixelStorei(GL_UNPACK_ALIGNMENT, 4);
+	for (size_t level = 0; level < source.levels().size(); level++)
+	{
+		const RgbaImage& mip = source.levels()[level];
+		glTexImage2D(GL_TEXTURE_2D, (GLint)level, GL_SRGB8_ALPHA8, mip.width, mip.height, 0, GL_RGBA, GL_UNSIGNED_BYTE, mip.pixels.data());
+	}
+	gpuMemory.trackTexture(reference.get(), GPU_MEMORY_TEXTURE, gpuImageBytes(GL_SRGB8_ALPHA8, image.width, image.height, 1, true));
+	glBindTexture(GL_TEXTURE_2D, 0);
+
+	// 100 slots for the 85 pages of all four levels
+	VirtualTexture texture(source, 10);
+	if (!texture.init())
+		return 1;
+	// low over one corner, looking across: every level from 0 at the near
+	// edge to the coarsest at the far one
+	Vec3 eye = { -700.0f, 30.0f, 700.0f };
+	Mat4 viewProj = perspective(1.0f, (float)BENCH_WIDTH / BENCH_HEIGHT, 1.0f, 5000.0f)
+		* lookAt(eye, { 0.0f, 0.0f, 0.0f }, { 0.0f, 1.0f, 0.0f });
+
+	RgbaImage frame, expected, first;
+	glBindFramebuffer(GL_FRAMEBUFFER, framebuffer);
+	glViewport(0, 0, BENCH_WIDTH, BENCH_HEIGHT);
+	glUseProgram(programs.reference);
+	glActiveTexture(GL_TEXTURE2);
+	glBindTexture(GL_TEXTURE_2D, reference.get());
+	glActiveTexture(GL_TEXTURE0);
+	glUniform1i(glGetUniformLocation(programs.reference, "reference"), 2);
+	texture.bind(programs.reference, false);
+	glClearColor(0.0f, 0.0f, 0.0f, 1.0f);
+	glClear(GL_COLOR_BUFFER_BIT | GL_DEPTH_BUFFER_BIT);
+	drawGround(programs.reference, viewProj, vertexArray);
+	readFrame(expected);
+
+	auto start = Clock::now();
+	int frames = 0;
+	bool settled = false;
+	for (; frames < 600 && !settled; frames++)
+	{
+		drawFrame(texture, programs, viewProj, vertexArray, framebuffer);
+		if (frames == 0)
+			readFrame(first);
+		glObjects.endFrame();
+		settled = texture.settled();
+		this_thread::sleep_for(chrono::milliseconds(2));
+	}
+	double milliseconds = chrono::duration<double, milli>(Clock::now() - start).count();
+	drawFrame(texture, programs, viewProj, vertexArray, framebuffer);
+	readFrame(frame);
+	glBindFramebuffer(GL_FRAMEBUFFER, 0);
+	glActiveTexture(GL_TEXTURE2);
+	glBindTexture(GL_TEXTURE_2D, 0);
+	glActiveTexture(GL_TEXTURE0);
+	VirtualTexture::Stats stats = texture.stats();
+	texture.release();
+
+	ImageComparison blurry, converged;
+	compareImages(first, expected, 2, blurry);
+	compareImages(frame, expected, 2, converged);
+	cout << "  " << image.width << "x" << image.height << " image, " << pages << "x" << pages << " pages: first frame "
+		<< blurry.psnr << " dB from the whole texture with only the coarsest page, " << stats.residentTiles << " tiles resident after "
+		<< frames << " frames (" << milliseconds << " ms), then " << converged.psnr << " dB, largest difference "
+		<< converged.largestDifference << endl;
+	if (!settled || converged.psnr < 40.0)
+	{
+		cout << "ERROR::BENCHMARK::VIRTUAL_TEXTURE::WRONG_TEXELS " << converged.psnr << " dB, "
+			<< converged.differingPixels << " pixels off" << (settled ? "" : ", never settled") << endl;
+		return 1;
+	}
+	return 0;
+}
+
+int runVirtualTextureBenchmark(int pages)
+{
+	ShaderProgramDesc desc;
+	desc.vertexPath = "shaders/virtual_texture.vert";
+	desc.fragmentPath = "shaders/virtual_texture.frag";
+	desc.featureDefines = { "VT_FEEDBACK", "VT_REFERENCE" };
+	ShaderVariantCache shaders(desc);
+	TerrainPrograms programs = { shaders.require(0), shaders.require(VT_FEEDBACK), shaders.require(VT_REFERENCE) };
+	if (!programs.main || !programs.feedback || !programs.reference)
+	{
+		shaders.release();
+		return 1;
+	}
+
+	GLTexture color = GLTexture::create(), depth = GLTexture::create();
+	glBindTexture(GL_TEXTURE_2D, color.get());
+	glTexImage2D(GL_TEXTURE_2D, 0, GL_RGBA8, BENCH_WIDTH, BENCH_HEIGHT, 0, GL_RGBA, GL_UNSIGNED_BYTE, NULL);
+	gpuMemory.trackTexture(color.get(), GPU_MEMORY_RENDER_TARGET, gpuImageBytes(GL_RGBA8, BENCH_WIDTH, BENCH_HEIGHT));
+	glBindTexture(GL_TEXTURE_2D, depth.get());
+	glTexImage2D(GL_TEXTURE_2D, 0, GL_DEPTH_COMPONENT24, BENCH_WIDTH, BENCH_HEIGHT, 0, GL_DEPTH_COMPONENT, GL_UNSIGNED_INT, NULL);
+	gpuMemory.trackTexture(depth.get(), GPU_MEMORY_RENDER_TARGET, gpuImageBytes(GL_DEPTH_COMPONENT24, BENCH_WIDTH, BENCH_HEIGHT));
+	glBindTexture(GL_TEXTURE_2D, 0);
+	GLFramebuffer framebuffer = GLFramebuffer::create();
+	glBindFramebuffer(GL_FRAMEBUFFER, framebuffer.get());
+	glFramebufferTexture2D(GL_FRAMEBUFFER, GL_COLOR_ATTACHMENT0, GL_TEXTURE_2D, color.get(), 0);
+	glFramebufferTexture2D(GL_FRAMEBUFFER, GL_DEPTH_ATTACHMENT, GL_TEXTURE_2D, depth.get(), 0);
+	glBindFramebuffer(GL_FRAMEBUFFER, 0);
+	GLVertexArray vertexArray = GLVertexArray::create();
+
+	cout << "Virtual texture benchmark: " << BENCH_WIDTH << "x" << BENCH_HEIGHT << ", tiles of " << VIRTUAL_TILE_CONTENT
+		<< " texels and a " << VIRTUAL_TILE_BORDER << " texel border, feedback at 1/" << VirtualTexture::FEEDBACK_DIVISOR << endl;
+	int exitCode = checkAgainstReference(programs, vertexArray.get(), framebuffer.get());
+
+	// flying over a texture hundreds of times the cache at 4x the demo's
+	// speed: GPU memory must not move once the first frame made the feedback
+	// target, however many tiles come and go
+	ProceduralTerrainSource terrain(pages);
+	VirtualTexture texture(terrain);
+	if (exitCode == 0 && texture.init())
+	{
+		const int frames = 300;
+		size_t baseline = 0, largest = 0;
+		double longestFrame = 0.0;
+		auto start = Clock::now();
+		for (int frame = 0; frame < frames; frame++)
+		{
+			auto frameStart = Clock::now();
+			Mat4 viewProj = terrainCamera(frame * 4.0f / 60.0f, (float)BENCH_WIDTH / BENCH_HEIGHT);
+			drawFrame(texture, programs, viewProj, vertexArray.get(), framebuffer.get());
+			glFinish();
+			glObjects.endFrame();
+			gpuMemory.endFrame();
+			longestFrame = max(longestFrame, chrono::duration<double, milli>(Clock::now() - frameStart).count());
+			if (frame == 0)
+				baseline = liveGpuBytes();
+			largest = max(largest, liveGpuBytes());
+		}
+		double seconds = chrono::duration<double>(Clock::now() - start).count();
+		glBindFramebuffer(GL_FRAMEBUFFER, 0);
+		VirtualTexture::Stats stats = texture.stats();
+
+		const double virtualTexels = (double)pages * VIRTUAL_TILE_CONTENT * pages * VIRTUAL_TILE_CONTENT;
+		const double mb = 1.0 / (1 << 20);
+		cout << "  " << pages * VIRTUAL_TILE_CONTENT << "x" << pages * VIRTUAL_TILE_CONTENT << " terrain, "
+			<< virtualTexels * 4.0 * 4.0 / 3.0 / (1 << 30) << " GB as RGBA8 with mips: atlas " << stats.atlasBytes * mb << " MB ("
+			<< stats.slots << " tiles), page table " << stats.pageTableBytes * mb << " MB" << endl;
+		cout << "  " << frames << " frames in " << seconds << " s, longest " << longestFrame << " ms; " << stats.tilesLoaded
+			<< " tiles loaded (" << (stats.tilesLoaded ? stats.loadMilliseconds / stats.tilesLoaded : 0.0) << " ms each), "
+			<< stats.tilesUploaded << " uploaded, " << stats.evictions << " evicted, " << stats.cacheFull << " dropped for a full cache"
+			<< endl;
+		cout << "  " << stats.feedbackFrames << " feedback readbacks (" << stats.feedbackDropped << " dropped), "
+			<< (stats.pagesRequested ? 100.0 * stats.pagesResident / stats.pagesRequested : 0.0) << "% of "
+			<< stats.pagesRequested << " requested pages resident, update() " << stats.updateMilliseconds / frames
+			<< " ms a frame, at most " << stats.maxUpdateMilliseconds << " ms; GPU memory " << baseline * mb << " MB after the first frame, "
+			<< largest * mb << " MB at most" << endl;
+		if (largest != baseline || stats.residentTiles > stats.slots)
+		{
+			cout << "ERROR::BENCHMARK::VIRTUAL_TEXTURE::MEMORY_GREW from " << baseline << " to " << largest << " bytes" << endl;
+			exitCode = 1;
+		}
+	}
+	else if (exitCode == 0)
+	{
+		exitCode = 1;
+	}
+	texture.release();
+
+	vertexArray.reset();
+	framebuffer.reset();
+	color.reset();
+	depth.reset();
+	shaders.release();
+	return exitCode;
+}
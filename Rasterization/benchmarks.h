@@ -0,0 +1,118 @@
+#ifndef BENCHMARKS_H
+#define BENCHMARKS_H
+
+#include <glad/glad.h>
+#include <GLFW/glfw3.h>
+
+#include "shader_variants.h"
+
+// Benchmarks selected from the command line. Each prints its results to
+// stdout and returns the process exit code.
+
+// per-draw cost of glUniform* against UniformArena slices + glBindBufferRange.
+// plainProgram uses "uniform vec4 offsetScale, drawColor", blockProgram the
+// DrawBlock uniform block; vao holds one triangle.
+int runUniformBenchmark(GLFWwindow* window, unsigned int plainProgram, unsigned int blockProgram,
+	unsigned int vao, int drawCount, int frameCount);
+
+// CPU rasterizer fragment throughput with 0, 4, 8 and 16 perspective-correct
+// varyings, checked against a double precision reference. Needs no GL.
+int runInterpolationBenchmark(int triangleCount);
+
+// fragments per second per core of GLSL compiled for the CPU: the triangle
+// shaders of triangleDesc and a lit, textured shader with a loop and a branch.
+// Needs no GL.
+int runShaderBenchmark(const ShaderProgramDesc& triangleDesc, int triangleCount);
+
+// fragments shaded and time per frame for overlapping layers drawn front to
+// back, shuffled and back to front, with no depth test, early per-block
+// depth test and early test plus tile min/max rejection. Needs no GL.
+int runDepthBenchmark(int depthComplexity);
+
+// memory and time of 4x and 8x multisampling with compressed tiles against
+// 1x, drawing and resolving separately. Needs no GL.
+int runMsaaBenchmark(int triangleCount);
+
+// triangles per second through setup, clipping and culling, one triangle
+// at a time against 8 per SIMD batch, for small, culled, off-screen and
+// near-plane crossing triangles. Needs no GL.
+int runSetupBenchmark(int triangleCount);
+
+// filtered texels per second of SoftTexture for magnified, minified and
+// rotated access over a size x size texture, Z-order tiles against linear
+// rows. Needs no GL.
+int runTextureBenchmark(int size);
+
+// the CPU's 4x MSAA against GL's on the same scene and shader: resolved
+// pixels must agree up to rounding. Needs a current GL context.
+int runMsaaSelfTest(int triangleCount);
+
+// render thread time per 4K frame of reading every frame back with
+// glReadPixels against FrameCapture's PBO ring, checking that every frame
+// reaches the sink in order. window is the main window, for the worker's
+// shared context.
+int runCaptureBenchmark(GLFWwindow* window, int frameCount);
+
+// loads textureCount 1024x1024 QOI textures on the render thread, then
+// through TextureStreamer while frames keep going, and reports the longest
+// frame of each; checks every streamed texture arrived whole with its mip
+// chain. Then streams them block compressed, BC7 where the driver has it,
+// twice: cooking into an empty cache and from the cache, checking the GPU
+// decodes the blocks like decompressImage(). window is the main window, for
+// the loader's shared context.
+int runStreamingBenchmark(GLFWwindow* window, int textureCount);
+
+// 1080p frames per second through FrameEncoder's QOI and PNG encoders, one
+// thread against the pool, checking the pool writes the same bytes. Needs
+// no GL.
+int runEncodeBenchmark(int frameCount);
+
+// frames per second of the BT.709 4:2:0 conversion, scalar against AVX2, and
+// of VideoSink writing Y4M into a temporary file, at 1080p and 4K. Needs no
+// GL.
+int runVideoBenchmark(int frameCount);
+
+// JobSystem with 1, 2, 4... up to maxThreads threads (0 for one per core) on
+// frustum culling 1M spheres, transforming a 1M vertex mesh with normals and
+// decoding textures followed by dependent mip chain builds, checking every
+// thread count gets the results of one. Needs no GL.
+int runJobBenchmark(int maxThreads);
+
+// MB/s of BC1, BC3 and BC7 compression of a size x size image, one thread
+// against a JobSystem with one per core, checking both write the same
+// blocks; the RMSE of each and the VRAM its mip chain saves against RGBA8,
+// and a round trip through CookedTextureCache. Needs no GL.
+int runCompressionBenchmark(int size);
+
+// MPixels/s of generateMips() on a size x size sRGB image with the box,
+// Kaiser and Lanczos filters, one thread against a JobSystem with one per
+// core, checking both make the same levels; that black and white average to
+// half the light, that a non-power-of-two image of one color keeps it at
+// every level, and that alpha tested coverage holds. Needs no GL.
+int runMipBenchmark(int size);
+
+// fileCount assets of mixed kinds as loose files and packed into an
+// AssetArchive: the build time and compression ratio, then opening and
+// reading every one from the loose files against from the archive on one
+// thread and on one per core, checking all three give the same bytes; LZ4
+// round trips of the block format's corner cases and that a truncated
+// archive is refused. Needs no GL.
+int runArchiveBenchmark(int fileCount);
+
+// VirtualTexture against a mipmapped texture of the same image, which it
+// must match once the feedback settles, then a flight over a procedural
+// terrain of pages x pages pages, reporting tiles loaded and evicted, how
+// many requested pages were resident and the time in update(), and checking
+// GPU memory stays where the first frame left it. Needs a current GL context.
+int runVirtualTextureBenchmark(int pages);
+
+// reads back the frame just drawn into the back buffer and compares it with
+// golden/<name>.ppm, or when there is none with the CPU rasterizer's render
+// of vertices and triangleDesc's variant 0 over main()'s clear color. Writes
+// golden/<name>.diff.ppm and returns 1 when too many pixels, the PSNR or the
+// FLIP are off; update stores the frame as the new reference instead. Needs a
+// current GL context.
+int runGoldenTest(const ShaderProgramDesc& triangleDesc, const float* vertices, int vertexCount,
+	int width, int height, const std::string& name, bool update);
+
+#endif
@@ -0,0 +1,489 @@
+#include "deflate.h"
+
+#include <algorithm>
+#include <queue>
+
+using namespace std;
+
+static const int WINDOW_SIZE = 32768;
+static const int MIN_MATCH = 3;
+static const int MAX_MATCH = 258;
+static const int HASH_BITS = 15;
+static const int MAX_CHAIN = 32;			// candidates tried per position
+static const size_t BLOCK_SYMBOLS = 1 << 15;	// literals and matches per Huffman block
+
+static const int LITLEN_CODES = 286;
+static const int DIST_CODES = 30;
+static const int CODELEN_CODES = 19;
+
+static const uint16_t lengthBase[29] = { 3, 4, 5, 6, 7, 8, 9, 10, 11, 13, 15, 17, 19, 23, 27, 31,
+	35, 43, 51, 59, 67, 83, 99, 115, 131, 163, 195, 227, 258 };
+static const uint8_t lengthExtra[29] = { 0, 0, 0, 0, 0, 0, 0, 0, 1, 1, 1, 1, 2, 2, 2, 2,
+	3, 3, 3, 3, 4, 4, 4, 4, 5, 5, 5, 5, 0 };
+static const uint16_t distBase[30] = { 1, 2, 3, 4, 5, 7, 9, 13, 17, 25, 33, 49, 65, 97, 129, 193,
+	257, 385, 513, 769, 1025, 1537, 2049, 3073, 4097, 6145, 8193, 12289, 16385, 24577 };
+static const uint8_t distExtra[30] = { 0, 0, 0, 0, 1, 1, 2, 2, 3, 3, 4, 4, 5, 5, 6, 6,
+	7, 7, 8, 8, 9, 9, 10, 10, 11, 11, 12, 12, 13, 13 };
+static const uint8_t codeLengthOrder[CODELEN_CODES] = { 16, 17, 18, 0, 8, 7, 9, 6, 10, 5, 11, 4, 12, 3, 13, 2, 14, 1, 15 };
+
+// length 3..258 to its code - 257, distance - 1 to its code in two ranges
+struct SymbolTables
+{
+	uint8_t lengthCode[MAX_MATCH + 1];
+	uint8_t distCode[512];
+
+	SymbolTables()
+	{
+		for (int code = 0; code < 29; code++)
+		{
+			for (int length = lengthBase[code]; length < lengthBase[code] + (1 << lengthExtra[code]) && length <= MAX_MATCH; length++)
+				lengthCode[length] = (uint8_t)code;
+		}
+		// the last code is 258 alone, not 227 + 31
+		lengthCode[MAX_MATCH] = 28;
+		for (int code = 0; code < DIST_CODES; code++)
+		{
+			for (int d = distBase[code] - 1; d < distBase[code] - 1 + (1 << distExtra[code]); d++)
+			{
+				if (d < 256)
+					distCode[d] = (uint8_t)code;
+				else
+					distCode[256 + (d >> 7)] = (uint8_t)code;
+			}
+		}
+	}
+
+	int distanceCode(int distance) const
+	{
+		int d = distance - 1;
+		return d < 256 ? distCode[d] : distCode[256 + (d >> 7)];
+	}
+};
+
+static const SymbolTables tables;
+
+// LSB first, as deflate packs everything but the Huffman codes themselves
+class BitWriter
+{
+public:
+	explicit BitWriter(vector<uint8_t>& output) : out(output) {}
+
+	void put(uint32_t value, int count)
+	{
+		bits |= (uint64_t)value << used;
+		used += count;
+		while (used >= 8)
+		{
+			out.push_back((uint8_t)bits);
+			bits >>= 8;
+			used -= 8;
+		}
+	}
+
+	void alignToByte()
+	{
+		if (used > 0)
+			put(0, 8 - used);
+	}
+
+private:
+	vector<uint8_t>& out;
+	uint64_t bits = 0;
+	int used = 0;
+};
+
+// a literal (distance 0) or a match
+struct Symbol
+{
+	uint16_t length;
+	uint16_t distance;
+};
+
+// Huffman code lengths of at most limit bits that form a complete code, as
+// zlib's inflate requires; a code with one symbol gets a second one
+static void buildLengths(const uint32_t* freq, int count, int limit, uint8_t* lengths)
+{
+	fill(lengths, lengths + count, 0);
+	vector<int> used;
+	for (int s = 0; s < count; s++)
+	{
+		if (freq[s] > 0)
+			used.push_back(s);
+	}
+	if (used.size() < 2)
+	{
+		int s = used.empty() ? 0 : used[0];
+		lengths[s] = 1;
+		lengths[s == 0 ? 1 : 0] = 1;
+		return;
+	}
+
+	// the tree: leaves first, then each merge, so the root comes last
+	const int leaves = (int)used.size();
+	vector<int> parent(2 * leaves - 1, -1);
+	typedef pair<uint64_t, int> Entry;
+	priority_queue<Entry, vector<Entry>, greater<Entry>> heap;
+	for (int i = 0; i < leaves; i++)
+		heap.push(Entry(freq[used[i]], i));
+	for (int node = leaves; node < 2 * leaves - 1; node++)
+	{
+		Entry a = heap.top();
+		heap.pop();
+		Entry b = heap.top();
+		heap.pop();
+		parent[a.second] = parent[b.second] = node;
+		heap.push(Entry(a.first + b.first, node));
+	}
+	vector<int> depth(2 * leaves - 1, 0);
+	for (int node = 2 * leaves - 3; node >= 0; node--)
+		depth[node] = depth[parent[node]] + 1;
+
+	// too long codes are cut to the limit, which oversubscribes the code;
+	// lengthening the longest codes below the limit pays that back, and any
+	// room left over goes to shortening the longest codes again
+	const uint32_t full = 1u << limit;
+	uint32_t kraft = 0;
+	for (int i = 0; i < leaves; i++)
+	{
+		lengths[used[i]] = (uint8_t)min(depth[i], limit);
+		kraft += full >> lengths[used[i]];
+	}
+	// most frequent first, so ties go to the cheapest change
+	sort(used.begin(), used.end(), [&](int a, int b) { return freq[a] > freq[b]; });
+	while (kraft > full)
+	{
+		int best = -1;
+		for (int s : used)
+		{
+			if (lengths[s] < limit && (best < 0 || lengths[s] > lengths[best]))
+				best = s;
+		}
+		lengths[best]++;
+		kraft -= full >> lengths[best];
+	}
+	while (kraft < full)
+	{
+		int best = -1;
+		for (int s : used)
+		{
+			if (lengths[s] > 1 && (full >> lengths[s]) <= full - kraft && (best < 0 || lengths[s] > lengths[best]))
+				best = s;
+		}
+		kraft += full >> lengths[best];
+		lengths[best]--;
+	}
+}
+
+// canonical codes, bit reversed for the LSB first stream
+static void buildCodes(const uint8_t* lengths, int count, uint16_t* codes)
+{
+	int lengthCount[16] = {};
+	for (int s = 0; s < count; s++)
+		lengthCount[lengths[s]]++;
+	lengthCount[0] = 0;
+	int next[16] = {};
+	for (int bits = 1, code = 0; bits < 16; bits++)
+	{
+		code = (code + lengthCount[bits - 1]) << 1;
+		next[bits] = code;
+	}
+	for (int s = 0; s < count; s++)
+	{
+		int length = lengths[s];
+		if (length == 0)
+			continue;
+		int code = next[length]++, reversed = 0;
+		for (int i = 0; i < length; i++)
+			reversed |= ((code >> i) & 1) << (length - 1 - i);
+		codes[s] = (uint16_t)reversed;
+	}
+}
+
+static void writeBlock(BitWriter& writer, const vector<Symbol>& symbols, bool final)
+{
+	uint32_t litlenFreq[LITLEN_CODES] = {}, distFreq[DIST_CODES] = {};
+	for (const Symbol& s : symbols)
+	{
+		if (s.distance == 0)
+		{
+			litlenFreq[s.length]++;
+		}
+		else
+		{
+			litlenFreq[257 + tables.lengthCode[s.length]]++;
+			distFreq[tables.distanceCode(s.distance)]++;
+		}
+	}
+	litlenFreq[256] = 1;
+
+	uint8_t litlenLengths[LITLEN_CODES], distLengths[DIST_CODES];
+	buildLengths(litlenFreq, LITLEN_CODES, 15, litlenLengths);
+	buildLengths(distFreq, DIST_CODES, 15, distLengths);
+	int litlenCount = LITLEN_CODES, distCount = DIST_CODES;
+	while (litlenCount > 257 && litlenLengths[litlenCount - 1] == 0)
+		litlenCount--;
+	while (distCount > 1 && distLengths[distCount - 1] == 0)
+		distCount--;
+	uint8_t lengths[LITLEN_CODES + DIST_CODES];
+	copy(litlenLengths, litlenLengths + litlenCount, lengths);
+	copy(distLengths, distLengths + distCount, lengths + litlenCount);
+
+	// both sets of lengths, run-length coded: 16 repeats the last length
+	// 3-6 times, 17 and 18 are 3-10 and 11-138 zeros
+	struct CodeLength
+	{
+		uint8_t symbol;
+		uint8_t extra;
+	};
+	vector<CodeLength> runs;
+	const int total = litlenCount + distCount;
+	for (int i = 0; i < total; )
+	{
+		int length = lengths[i], run = 1;
+		while (i + run < total && lengths[i + run] == length)
+			run++;
+		i += run;
+		if (length == 0)
+		{
+			while (run >= 11)
+			{
+				int n = min(run, 138);
+				runs.push_back({ 18, (uint8_t)(n - 11) });
+				run -= n;
+			}
+			if (run >= 3)
+			{
+				runs.push_back({ 17, (uint8_t)(run - 3) });
+				run = 0;
+			}
+		}
+		else
+		{
+			runs.push_back({ (uint8_t)length, 0 });
+			run--;
+			while (run >= 3)
+			{
+				int n = min(run, 6);
+				runs.push_back({ 16, (uint8_t)(n - 3) });
+				run -= n;
+			}
+		}
+		for (; run > 0; run--)
+			runs.push_back({ (uint8_t)length, 0 });
+	}
+	uint32_t codeLengthFreq[CODELEN_CODES] = {};
+	for (const CodeLength& r : runs)
+		codeLengthFreq[r.symbol]++;
+	uint8_t codeLengthLengths[CODELEN_CODES];
+	buildLengths(codeLengthFreq, CODELEN_CODES, 7, codeLengthLengths);
+	int orderCount = CODELEN_CODES;
+	while (orderCount > 4 && codeLengthLengths[codeLengthOrder[orderCount - 1]] == 0)
+		orderCount--;
+
+	uint16_t litlenCodes[LITLEN_CODES], distCodes[DIST_CODES], codeLengthCodes[CODELEN_CODES];
+	buildCodes(litlenLengths, LITLEN_CODES, litlenCodes);
+	buildCodes(distLengths, DIST_CODES, distCodes);
+	buildCodes(codeLengthLengths, CODELEN_CODES, codeLengthCodes);
+
+	writer.put(final ? 1 : 0, 1);
+	writer.put(2, 2);
+	writer.put(litlenCount - 257, 5);
+	writer.put(distCount - 1, 5);
+	writer.put(orderCount - 4, 4);
+	for (int i = 0; i < orderCount; i++)
+		writer.put(codeLengthLengths[codeLengthOrder[i]], 3);
+	for (const CodeLength& r : runs)
+	{
+		writer.put(codeLengthCodes[r.symbol], codeLengthLengths[r.symbol]);
+		if (r.symbol >= 16)
+			writer.put(r.extra, r.symbol == 16 ? 2 : r.symbol == 17 ? 3 : 7);
+	}
+
+	for (const Symbol& s : symbols)
+	{
+		if (s.distance == 0)
+		{
+			writer.put(litlenCodes[s.length], litlenLengths[s.length]);
+			continue;
+		}
+		int lengthCode = tables.lengthCode[s.length];
+		writer.put(litlenCodes[257 + lengthCode], litlenLengths[257 + lengthCode]);
+		writer.put(s.length - lengthBase[lengthCode], lengthExtra[lengthCode]);
+		int distCode = tables.distanceCode(s.distance);
+		writer.put(distCodes[distCode], distLengths[distCode]);
+		writer.put(s.distance - distBase[distCode], distExtra[distCode]);
+	}
+	writer.put(litlenCodes[256], litlenLengths[256]);
+}
+
+static inline uint32_t hash3(const uint8_t* p)
+{
+	uint32_t v = (uint32_t)p[0] | ((uint32_t)p[1] << 8) | ((uint32_t)p[2] << 16);
+	return (v * 2654435761u) >> (32 - HASH_BITS);
+}
+
+void deflatePiece(const uint8_t* data, size_t begin, size_t end, bool final, vector<uint8_t>& out)
+{
+	// positions are relative to the start of the history
+	const size_t historyStart = begin > (size_t)WINDOW_SIZE ? begin - WINDOW_SIZE : 0;
+	const uint8_t* base = data + historyStart;
+	const int start = (int)(begin - historyStart), stop = (int)(end - historyStart);
+	vector<int32_t> head((size_t)1 << HASH_BITS, -1);
+	vector<int32_t> prev(WINDOW_SIZE, -1);
+	auto insert = [&](int p)
+	{
+		if (p + MIN_MATCH <= stop)
+		{
+			uint32_t h = hash3(base + p);
+			prev[p & (WINDOW_SIZE - 1)] = head[h];
+			head[h] = p;
+		}
+	};
+	for (int p = 0; p < start; p++)
+		insert(p);
+
+	BitWriter writer(out);
+	bool finished = false;
+	vector<Symbol> symbols;
+	symbols.reserve(BLOCK_SYMBOLS);
+	for (int pos = start; pos < stop; )
+	{
+		int best = 0, bestDistance = 0;
+		const int maxLength = min(MAX_MATCH, stop - pos);
+		if (maxLength >= MIN_MATCH)
+		{
+			const uint8_t* current = base + pos;
+			int candidate = head[hash3(current)];
+			for (int chain = MAX_CHAIN; candidate >= 0 && pos - candidate <= WINDOW_SIZE && chain > 0; chain--)
+			{
+				const uint8_t* match = base + candidate;
+				if (match[best] == current[best])
+				{
+					int length = 0;
+					while (length < maxLength && match[length] == current[length])
+						length++;
+					if (length > best)
+					{
+						best = length;
+						bestDistance = pos - candidate;
+						if (length == maxLength)
+							break;
+					}
+				}
+				int next = prev[candidate & (WINDOW_SIZE - 1)];
+				if (next >= candidate)
+					break;
+				candidate = next;
+			}
+		}
+
+		if (best >= MIN_MATCH)
+		{
+			symbols.push_back({ (uint16_t)best, (uint16_t)bestDistance });
+			for (int i = 0; i < best; i++)
+				insert(pos + i);
+			pos += best;
+		}
+		else
+		{
+			symbols.push_back({ base[pos], 0 });
+			insert(pos);
+			pos++;
+		}
+		if (symbols.size() == BLOCK_SYMBOLS)
+		{
+			finished = final && pos == stop;
+			writeBlock(writer, symbols, finished);
+			symbols.clear();
+		}
+	}
+	if (!finished && (!symbols.empty() || final))
+		writeBlock(writer, symbols, final);
+
+	if (!final)
+	{
+		// an empty stored block ends the piece on a byte boundary
+		writer.put(0, 3);
+		writer.alignToByte();
+		const uint8_t empty[4] = { 0, 0, 0xff, 0xff };
+		out.insert(out.end(), empty, empty + 4);
+	}
+	writer.alignToByte();
+}
+
+uint32_t adler32(uint32_t adler, const uint8_t* data, size_t size)
+{
+	const uint32_t BASE = 65521;
+	uint32_t a = adler & 0xffff, b = adler >> 16;
+	while (size > 0)
+	{
+		// 5552 bytes keep b below 2^32 between reductions
+		size_t n = min(size, (size_t)5552);
+		size -= n;
+		for (; n > 0; n--)
+		{
+			a += *data++;
+			b += a;
+		}
+		a %= BASE;
+		b %= BASE;
+	}
+	return a | (b << 16);
+}
+
+uint32_t adler32Combine(uint32_t a, uint32_t b, size_t sizeB)
+{
+	const uint32_t BASE = 65521;
+	uint32_t rem = (uint32_t)(sizeB % BASE);
+	uint32_t sum1 = a & 0xffff;
+	uint32_t sum2 = (uint32_t)(((uint64_t)rem * sum1) % BASE);
+	sum1 += (b & 0xffff) + BASE - 1;
+	sum2 += (a >> 16) + (b >> 16) + BASE - rem;
+	if (sum1 >= BASE)
+		sum1 -= BASE;
+	if (sum1 >= BASE)
+		sum1 -= BASE;
+	if (sum2 >= 2 * BASE)
+		sum2 -= 2 * BASE;
+	if (sum2 >= BASE)
+		sum2 -= BASE;
+	return sum1 | (sum2 << 16);
+}
+
+// slicing by 4: four tables, one word of input per step
+struct CrcTables
+{
+	uint32_t table[4][256];
+
+	CrcTables()
+	{
+		for (uint32_t i = 0; i < 256; i++)
+		{
+			uint32_t c = i;
+			for (int k = 0; k < 8; k++)
+				c = (c & 1) ? 0xedb88320u ^ (c >> 1) : c >> 1;
+			table[0][i] = c;
+		}
+		for (uint32_t i = 0; i < 256; i++)
+		{
+			for (int t = 1; t < 4; t++)
+				table[t][i] = (table[t - 1][i] >> 8) ^ table[0][table[t - 1][i] & 0xff];
+		}
+	}
+};
+
+static const CrcTables crcTables;
+
+uint32_t crc32(uint32_t crc, const uint8_t* data, size_t size)
+{
+	const uint32_t(*t)[256] = crcTables.table;
+	crc = ~crc;
+	for (; size >= 4; size -= 4, data += 4)
+	{
+		crc ^= (uint32_t)data[0] | ((uint32_t)data[1] << 8) | ((uint32_t)data[2] << 16) | ((uint32_t)data[3] << 24);
+		crc = t[3][crc & 0xff] ^ t[2][(crc >> 8) & 0xff] ^ t[1][(crc >> 16) & 0xff] ^ t[0][crc >> 24];
+	}
+	for (; size > 0; size--)
+		crc = t[0][(crc ^ *data++) & 0xff] ^ (crc >> 8);
+	return ~crc;
+}
@@ -0,0 +1,27 @@
+#ifndef DEFLATE_H
+#define DEFLATE_H
+
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+// A small deflate (RFC 1951) compressor for PNG frame dumps: greedy LZ77
+// over hash chains and dynamic Huffman blocks.
+//
+// A stream can be compressed in pieces on different threads, like pigz:
+// every piece but the last ends with an empty stored block, which leaves
+// it on a byte boundary, so the pieces can simply be concatenated. Matches
+// may reach up to 32 KB back into the bytes before a piece, which the
+// caller passes in so that splitting costs almost nothing in ratio.
+
+// appends the compressed data[begin, end) to out; data[0, begin) is history
+// that matches may refer to but that isn't output. final ends the stream.
+void deflatePiece(const uint8_t* data, size_t begin, size_t end, bool final, std::vector<uint8_t>& out);
+
+// running checksums, start with adler = 1 and crc = 0
+uint32_t adler32(uint32_t adler, const uint8_t* data, size_t size);
+// the adler32 of a followed by b, from theirs and b's length
+uint32_t adler32Combine(uint32_t a, uint32_t b, size_t sizeB);
+uint32_t crc32(uint32_t crc, const uint8_t* data, size_t size);
+
+#endif
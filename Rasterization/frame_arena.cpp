@@ -0,0 +1,63 @@
+#include "frame_arena.h"
+
+#include <algorithm>
+
+using namespace std;
+
+FrameArena frameArena;
+
+LinearArena::LinearArena(size_t initialCapacity)
+	: blockSize(initialCapacity)
+{
+	if (blockSize)
+		block = new char[blockSize];
+}
+
+LinearArena::~LinearArena()
+{
+	reset();
+	delete[] block;
+}
+
+void* LinearArena::allocateOverflow(size_t bytes, size_t alignment)
+{
+	char* extra = new char[bytes + alignment];
+	overflow.push_back(extra);
+	overflowBytes += bytes + alignment;
+	uintptr_t address = ((uintptr_t)extra + alignment - 1) & ~(uintptr_t)(alignment - 1);
+	return (void*)address;
+}
+
+void LinearArena::reset()
+{
+	peak = max(peak, used());
+	if (!overflow.empty())
+	{
+		for (char* extra : overflow)
+			delete[] extra;
+		overflow.clear();
+		// room for the whole last frame and then some, so growing stops soon
+		delete[] block;
+		blockSize = max(blockSize * 2, (offset + overflowBytes) * 3 / 2);
+		block = new char[blockSize];
+		growCount++;
+	}
+	offset = 0;
+	overflowBytes = 0;
+}
+
+FrameArena::FrameArena(size_t initialCapacity)
+	: arenas{ LinearArena(initialCapacity), LinearArena(initialCapacity) }
+{
+}
+
+void FrameArena::beginFrame()
+{
+	current ^= 1;
+	arenas[current].reset();
+}
+
+size_t FrameArena::highWater() const
+{
+	return max(arenas[0].highWater(), arenas[1].highWater());
+}
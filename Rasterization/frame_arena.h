@@ -0,0 +1,117 @@
+#ifndef FRAME_ARENA_H
+#define FRAME_ARENA_H
+
+#include <cstddef>
+#include <cstdint>
+#include <new>
+#include <type_traits>
+#include <vector>
+
+// Bump allocation from one block, freed all at once by reset(). What doesn't
+// fit goes to extra blocks from the heap, and the next reset() replaces the
+// block by one big enough for everything, so after a few frames of warm-up
+// the arena stops touching the heap.
+class LinearArena
+{
+public:
+	explicit LinearArena(size_t initialCapacity = 0);
+	~LinearArena();
+
+	LinearArena(const LinearArena&) = delete;
+	LinearArena& operator=(const LinearArena&) = delete;
+
+	// alignment must be a power of two
+	void* allocate(size_t bytes, size_t alignment = alignof(std::max_align_t))
+	{
+		uintptr_t base = (uintptr_t)block;
+		size_t start = (size_t)(((base + offset + alignment - 1) & ~(uintptr_t)(alignment - 1)) - base);
+		if (block && start + bytes <= blockSize)
+		{
+			offset = start + bytes;
+			return block + start;
+		}
+		return allocateOverflow(bytes, alignment);
+	}
+
+	void reset();
+
+	size_t capacity() const { return blockSize; }
+	size_t used() const { return offset + overflowBytes; }
+	// the most used() between two resets
+	size_t highWater() const { return peak; }
+	// reset() calls that had to grow the block
+	uint64_t growths() const { return growCount; }
+
+private:
+	void* allocateOverflow(size_t bytes, size_t alignment);
+
+	char* block = nullptr;
+	size_t blockSize = 0;
+	size_t offset = 0;
+	std::vector<char*> overflow;
+	size_t overflowBytes = 0;
+	size_t peak = 0;
+	uint64_t growCount = 0;
+};
+
+// Scratch memory for data built and thrown away every frame: draw lists,
+// culling output, uniform staging. Two arenas take turns, so what was
+// allocated during frame N is still valid during frame N + 1 and is only
+// reused by frame N + 2. Nothing is destroyed, so only trivially
+// destructible types go in. Render thread only.
+class FrameArena
+{
+public:
+	explicit FrameArena(size_t initialCapacity = 1 << 20);
+
+	// switches arenas at the start of a frame
+	void beginFrame();
+
+	void* allocate(size_t bytes, size_t alignment = alignof(std::max_align_t))
+	{
+		return arenas[current].allocate(bytes, alignment);
+	}
+
+	template<class T>
+	T* allocateArray(size_t count)
+	{
+		static_assert(std::is_trivially_destructible<T>::value, "frame arena memory is never destroyed");
+		T* items = (T*)allocate(count * sizeof(T), alignof(T));
+		for (size_t i = 0; i < count; i++)
+			new (items + i) T();
+		return items;
+	}
+
+	size_t highWater() const;
+	uint64_t growths() const { return arenas[0].growths() + arenas[1].growths(); }
+
+private:
+	LinearArena arenas[2];
+	int current = 0;
+};
+
+extern FrameArena frameArena;
+
+// lets standard containers live in the frame arena, e.g.
+// std::vector<int, FrameAllocator<int>>; nothing is freed until the arena
+// comes around again, so grow them once with reserve()
+template<class T>
+class FrameAllocator
+{
+public:
+	typedef T value_type;
+
+	FrameAllocator() = default;
+	template<class U>
+	FrameAllocator(const FrameAllocator<U>&) {}
+
+	T* allocate(size_t count) { return (T*)frameArena.allocate(count * sizeof(T), alignof(T)); }
+	void deallocate(T*, size_t) {}
+
+	template<class U>
+	bool operator==(const FrameAllocator<U>&) const { return true; }
+	template<class U>
+	bool operator!=(const FrameAllocator<U>&) const { return false; }
+};
+
+#endif
@@ -0,0 +1,180 @@
+#include "frame_capture.h"
+#include "gpu_memory.h"
+#include "image_compare.h"
+
+#include <chrono>
+#include <cstdio>
+#include <filesystem>
+#include <iostream>
+
+using namespace std;
+namespace fs = std::filesystem;
+
+typedef chrono::high_resolution_clock Clock;
+
+FrameCapture::FrameCapture(int ringSize)
+	: slots(ringSize < 2 ? 2 : ringSize)
+{
+}
+
+FrameCapture::~FrameCapture()
+{
+	stop();
+}
+
+bool FrameCapture::start(GLFWwindow* mainWindow, FrameSink* frameSink)
+{
+	// like ShaderHotReloader: a hidden window for a context in the main share
+	// group, the fences and buffers are shared, their bindings are not
+	glfwWindowHint(GLFW_VISIBLE, GLFW_FALSE);
+	workerWindow = glfwCreateWindow(1, 1, "frame capture", NULL, mainWindow);
+	glfwWindowHint(GLFW_VISIBLE, GLFW_TRUE);
+	if (workerWindow == NULL)
+	{
+		cout << "ERROR::CAPTURE::SHARED_CONTEXT_FAILED" << endl;
+		return false;
+	}
+
+	for (Slot& slot : slots)
+		glGenBuffers(1, &slot.buffer);
+	sink = frameSink;
+	issued = consumed = 0;
+	stopping = false;
+	counters = Stats();
+	worker = thread(&FrameCapture::workerLoop, this);
+	return true;
+}
+
+void FrameCapture::stop()
+{
+	if (!worker.joinable())
+		return;
+	{
+		lock_guard<mutex> lock(ringMutex);
+		stopping = true;
+	}
+	queued.notify_one();
+	worker.join();
+
+	for (Slot& slot : slots)
+	{
+		gpuMemory.forgetBuffer(slot.buffer);
+		glDeleteBuffers(1, &slot.buffer);
+		slot = Slot();
+	}
+	glfwDestroyWindow(workerWindow);
+	workerWindow = nullptr;
+}
+
+void FrameCapture::capture(int width, int height)
+{
+	if (!worker.joinable() || width <= 0 || height <= 0)
+		return;
+
+	auto start = Clock::now();
+	unique_lock<mutex> lock(ringMutex);
+	Slot& slot = slots[issued % slots.size()];
+	if (issued - consumed == slots.size())
+	{
+		counters.stalls++;
+		freed.wait(lock, [this] { return issued - consumed < slots.size(); });
+		counters.stallMilliseconds += chrono::duration<double, milli>(Clock::now() - start).count();
+	}
+	slot.index = issued;
+	lock.unlock();
+
+	glBindBuffer(GL_PIXEL_PACK_BUFFER, slot.buffer);
+	size_t bytes = (size_t)width * height * 4;
+	if (slot.bytes != bytes)
+	{
+		glBufferData(GL_PIXEL_PACK_BUFFER, bytes, NULL, GL_STREAM_READ);
+		gpuMemory.trackBuffer(slot.buffer, GPU_MEMORY_READBACK, bytes);
+		slot.bytes = bytes;
+	}
+	slot.width = width;
+	slot.height = height;
+	glPixelStorei(GL_PACK_ALIGNMENT, 4);
+	glReadPixels(0, 0, width, height, GL_RGBA, GL_UNSIGNED_BYTE, (void*)0);
+	glBindBuffer(GL_PIXEL_PACK_BUFFER, 0);
+	// the worker can only wait for a fence this context has flushed
+	slot.fence = glFenceSync(GL_SYNC_GPU_COMMANDS_COMPLETE, 0);
+	glFlush();
+
+	lock.lock();
+	issued++;
+	counters.frames++;
+	counters.issueMilliseconds += chrono::duration<double, milli>(Clock::now() - start).count();
+	lock.unlock();
+	queued.notify_one();
+}
+
+FrameCapture::Stats FrameCapture::stats() const
+{
+	lock_guard<mutex> lock(ringMutex);
+	return counters;
+}
+
+void FrameCapture::workerLoop()
+{
+	glfwMakeContextCurrent(workerWindow);
+
+	for (;;)
+	{
+		unique_lock<mutex> lock(ringMutex);
+		queued.wait(lock, [this] { return consumed < issued || stopping; });
+		if (consumed == issued)
+			break;
+		Slot& slot = slots[consumed % slots.size()];
+		lock.unlock();
+
+		// a second at a time, so a lost context can't hang stop() for good
+		GLenum status;
+		do
+			status = glClientWaitSync(slot.fence, 0, 1000000000ull);
+		while (status == GL_TIMEOUT_EXPIRED);
+		glDeleteSync(slot.fence);
+		slot.fence = 0;
+
+		// binding the buffer after the fence picks up the storage the render
+		// thread allocated for it
+		glBindBuffer(GL_PIXEL_PACK_BUFFER, slot.buffer);
+		const void* pixels = status == GL_WAIT_FAILED ? nullptr : glMapBufferRange(GL_PIXEL_PACK_BUFFER, 0, slot.bytes, GL_MAP_READ_BIT);
+		if (pixels)
+		{
+			CapturedFrame frame = { slot.index, slot.width, slot.height, (const uint32_t*)pixels };
+			sink->consume(frame);
+			glUnmapBuffer(GL_PIXEL_PACK_BUFFER);
+		}
+		else
+		{
+			cout << "ERROR::CAPTURE::MAP_FAILED frame " << slot.index << endl;
+		}
+		glBindBuffer(GL_PIXEL_PACK_BUFFER, 0);
+
+		lock.lock();
+		consumed++;
+		lock.unlock();
+		freed.notify_one();
+	}
+
+	sink->finish();
+	glfwMakeContextCurrent(NULL);
+}
+
+PpmSequenceSink::PpmSequenceSink(const string& dir)
+	: directory(dir)
+{
+	error_code error;
+	fs::create_directories(directory, error);
+}
+
+void PpmSequenceSink::consume(const CapturedFrame& frame)
+{
+	char name[32];
+	snprintf(name, sizeof(name), "/frame_%05llu.ppm", (unsigned long long)frame.index);
+	if (!writePPM(directory + name, frame.width, frame.height, frame.pixels) && !failed)
+	{
+		cout << "ERROR::CAPTURE::WRITE_FAILED " << directory + name << endl;
+		failed = true;
+	}
+}
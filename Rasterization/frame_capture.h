@@ -0,0 +1,113 @@
+#ifndef FRAME_CAPTURE_H
+#define FRAME_CAPTURE_H
+
+#include <condition_variable>
+#include <cstdint>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <vector>
+
+#include <glad/glad.h>
+#include <GLFW/glfw3.h>
+
+// one frame read back by FrameCapture: RGBA8 packed like packRGBA8(), rows
+// bottom-up like glReadPixels. pixels is only valid during consume().
+struct CapturedFrame
+{
+	uint64_t index;		// 0 for the first capture() call
+	int width;
+	int height;
+	const uint32_t* pixels;
+};
+
+// Where captured frames go. Called on the capture worker thread, one frame
+// at a time in capture order; while consume() runs the render thread can
+// queue ring size - 1 more frames before capture() has to wait.
+class FrameSink
+{
+public:
+	virtual ~FrameSink() {}
+	virtual void consume(const CapturedFrame& frame) = 0;
+	// after the last frame, still on the worker thread
+	virtual void finish() {}
+};
+
+// Frame readback that doesn't stall the render thread. capture() issues
+// glReadPixels into the next pixel pack buffer of a ring and a fence behind
+// it, which returns as soon as the commands are queued. A worker thread
+// with its own context in the main window's share group waits for each
+// fence, maps the buffer and hands the pixels to the sink, so the copy to
+// system memory and whatever the sink does with it overlap with the next
+// frames. The render thread only waits when the sink falls a whole ring
+// behind.
+class FrameCapture
+{
+public:
+	explicit FrameCapture(int ringSize = 3);
+	~FrameCapture();
+
+	FrameCapture(const FrameCapture&) = delete;
+	FrameCapture& operator=(const FrameCapture&) = delete;
+
+	// must be called on the main thread with mainWindow's context current
+	bool start(GLFWwindow* mainWindow, FrameSink* sink);
+
+	// hands every queued frame to the sink, then stops the worker and
+	// releases the buffers; call before glfwTerminate()
+	void stop();
+
+	// reads width x height from the bound read framebuffer's read buffer
+	void capture(int width, int height);
+
+	struct Stats
+	{
+		uint64_t frames = 0;
+		uint64_t stalls = 0;			// capture() calls that waited for a free buffer
+		double issueMilliseconds = 0.0;	// render thread time in capture(), stalls included
+		double stallMilliseconds = 0.0;
+	};
+	Stats stats() const;
+
+private:
+	struct Slot
+	{
+		GLuint buffer = 0;
+		GLsync fence = 0;
+		size_t bytes = 0;
+		int width = 0;
+		int height = 0;
+		uint64_t index = 0;
+	};
+
+	void workerLoop();
+
+	std::vector<Slot> slots;
+	FrameSink* sink = nullptr;
+	GLFWwindow* workerWindow = nullptr;
+	std::thread worker;
+
+	// slot i % ring size belongs to the worker while consumed <= i < issued
+	mutable std::mutex ringMutex;
+	std::condition_variable queued;
+	std::condition_variable freed;
+	uint64_t issued = 0;
+	uint64_t consumed = 0;
+	bool stopping = false;
+
+	Stats counters;
+};
+
+// writes frame_00000.ppm, frame_00001.ppm, ... into a directory
+class PpmSequenceSink : public FrameSink
+{
+public:
+	explicit PpmSequenceSink(const std::string& directory);
+	void consume(const CapturedFrame& frame) override;
+
+private:
+	std::string directory;
+	bool failed = false;
+};
+
+#endif
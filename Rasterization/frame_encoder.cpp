@@ -0,0 +1,429 @@
+#include "frame_encoder.h"
+#include "deflate.h"
+#include "simd.h"
+
+#include <algorithm>
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <filesystem>
+#include <iostream>
+
+using namespace std;
+namespace fs = std::filesystem;
+
+typedef chrono::high_resolution_clock Clock;
+
+// rows per PNG band at least, so the bands' block headers stay negligible
+static const int PNG_MIN_BAND_ROWS = 64;
+
+void packFrameRGB(const CapturedFrame& frame, uint8_t* rgb)
+{
+	const int width = frame.width, height = frame.height;
+	for (int y = 0; y < height; y++)
+	{
+		// glReadPixels rows are bottom-up, image files top-down
+		const uint32_t* in = frame.pixels + (size_t)(height - 1 - y) * width;
+		uint8_t* out = rgb + (size_t)y * width * 3;
+		int x = 0;
+#if SIMD_AVX2
+		// each 128-bit half packs 4 pixels into its low 12 bytes; the second
+		// store runs 4 bytes past the 8 pixels, so the last row stops early
+		const __m256i dropAlpha = _mm256_setr_epi8(0, 1, 2, 4, 5, 6, 8, 9, 10, 12, 13, 14, -1, -1, -1, -1,
+			0, 1, 2, 4, 5, 6, 8, 9, 10, 12, 13, 14, -1, -1, -1, -1);
+		const int simdEnd = y == height - 1 ? width - 2 : width;
+		for (; x + 8 <= simdEnd; x += 8)
+		{
+			__m256i packed = _mm256_shuffle_epi8(vec8i::loadu(in + x).v, dropAlpha);
+			_mm_storeu_si128((__m128i*)(out + x * 3), _mm256_castsi256_si128(packed));
+			_mm_storeu_si128((__m128i*)(out + x * 3 + 12), _mm256_extracti128_si256(packed, 1));
+		}
+#endif
+		for (; x < width; x++)
+		{
+			out[x * 3] = (uint8_t)in[x];
+			out[x * 3 + 1] = (uint8_t)(in[x] >> 8);
+			out[x * 3 + 2] = (uint8_t)(in[x] >> 16);
+		}
+	}
+}
+
+static void putBigEndian(vector<uint8_t>& out, uint32_t value)
+{
+	const uint8_t bytes[4] = { (uint8_t)(value >> 24), (uint8_t)(value >> 16), (uint8_t)(value >> 8), (uint8_t)value };
+	out.insert(out.end(), bytes, bytes + 4);
+}
+
+// QOI with 3 channels: runs, a 64 entry cache of recent colors, small
+// differences to the previous pixel, and whole pixels otherwise
+void encodeQOI(const uint8_t* rgb, int width, int height, vector<uint8_t>& out)
+{
+	out.clear();
+	out.reserve((size_t)width * height * 4 / 3 + 22);
+	const uint8_t magic[4] = { 'q', 'o', 'i', 'f' };
+	out.insert(out.end(), magic, magic + 4);
+	putBigEndian(out, width);
+	putBigEndian(out, height);
+	out.push_back(3);
+	out.push_back(0);
+
+	uint32_t seen[64] = {};
+	int r = 0, g = 0, b = 0, run = 0;
+	const size_t count = (size_t)width * height;
+	for (size_t i = 0; i < count; i++, rgb += 3)
+	{
+		if (rgb[0] == r && rgb[1] == g && rgb[2] == b)
+		{
+			if (++run == 62)
+			{
+				out.push_back(0xc0 | (run - 1));
+				run = 0;
+			}
+			continue;
+		}
+		if (run > 0)
+		{
+			out.push_back(0xc0 | (run - 1));
+			run = 0;
+		}
+		int dr = rgb[0] - r, dg = rgb[1] - g, db = rgb[2] - b;
+		r = rgb[0];
+		g = rgb[1];
+		b = rgb[2];
+		uint32_t color = (uint32_t)r | ((uint32_t)g << 8) | ((uint32_t)b << 16) | 0xff000000u;
+		int slot = (r * 3 + g * 5 + b * 7 + 255 * 11) & 63;
+		if (seen[slot] == color)
+		{
+			out.push_back((uint8_t)slot);
+			continue;
+		}
+		seen[slot] = color;
+
+		// the differences wrap around like the decoder's byte arithmetic
+		dr = (int8_t)dr;
+		dg = (int8_t)dg;
+		db = (int8_t)db;
+		int drg = dr - dg, dbg = db - dg;
+		if (dr >= -2 && dr <= 1 && dg >= -2 && dg <= 1 && db >= -2 && db <= 1)
+		{
+			out.push_back(0x40 | ((dr + 2) << 4) | ((dg + 2) << 2) | (db + 2));
+		}
+		else if (dg >= -32 && dg <= 31 && drg >= -8 && drg <= 7 && dbg >= -8 && dbg <= 7)
+		{
+			out.push_back(0x80 | (dg + 32));
+			out.push_back((uint8_t)(((drg + 8) << 4) | (dbg + 8)));
+		}
+		else
+		{
+			const uint8_t op[4] = { 0xfe, (uint8_t)r, (uint8_t)g, (uint8_t)b };
+			out.insert(out.end(), op, op + 4);
+		}
+	}
+	if (run > 0)
+		out.push_back(0xc0 | (run - 1));
+	const uint8_t end[8] = { 0, 0, 0, 0, 0, 0, 0, 1 };
+	out.insert(out.end(), end, end + 8);
+}
+
+static inline int paeth(int a, int b, int c)
+{
+	int p = a + b - c;
+	int pa = abs(p - a), pb = abs(p - b), pc = abs(p - c);
+	return pa <= pb && pa <= pc ? a : pb <= pc ? b : c;
+}
+
+// the filter byte and filtered bytes of row y: each of the five filters is
+// tried and the one with the smallest sum of absolute values kept
+static void filterRow(const uint8_t* rgb, int width, int y, uint8_t* out, vector<uint8_t>& scratch)
+{
+	const int bytes = width * 3;
+	const uint8_t* row = rgb + (size_t)y * bytes;
+	const uint8_t* above = y > 0 ? row - bytes : nullptr;
+	scratch.resize((size_t)bytes * 5);
+	uint8_t* trial[5];
+	for (int f = 0; f < 5; f++)
+		trial[f] = &scratch[(size_t)f * bytes];
+	for (int i = 0; i < bytes; i++)
+	{
+		int a = i >= 3 ? row[i - 3] : 0;
+		int b = above ? above[i] : 0;
+		int c = above && i >= 3 ? above[i - 3] : 0;
+		trial[0][i] = row[i];
+		trial[1][i] = (uint8_t)(row[i] - a);
+		trial[2][i] = (uint8_t)(row[i] - b);
+		trial[3][i] = (uint8_t)(row[i] - ((a + b) >> 1));
+		trial[4][i] = (uint8_t)(row[i] - paeth(a, b, c));
+	}
+	int best = 0;
+	uint64_t bestSum = ~0ull;
+	for (int f = 0; f < 5; f++)
+	{
+		uint64_t sum = 0;
+		for (int i = 0; i < bytes; i++)
+			sum += (uint64_t)abs((int8_t)trial[f][i]);
+		if (sum < bestSum)
+		{
+			best = f;
+			bestSum = sum;
+		}
+	}
+	out[0] = (uint8_t)best;
+	copy(trial[best], trial[best] + bytes, out + 1);
+}
+
+// rows [firstRow, endRow) filtered and deflated; the rows before are
+// filtered again as the 32 KB of history matches may reach into
+static void deflateBand(const uint8_t* rgb, int width, int firstRow, int endRow, bool last,
+	uint32_t& adler, vector<uint8_t>& out)
+{
+	const size_t rowBytes = (size_t)width * 3 + 1;
+	const int historyRows = min(firstRow, (int)((32768 + rowBytes - 1) / rowBytes));
+	vector<uint8_t> filtered(rowBytes * (historyRows + endRow - firstRow)), scratch;
+	for (int y = firstRow - historyRows; y < endRow; y++)
+		filterRow(rgb, width, y, &filtered[(y - firstRow + historyRows) * rowBytes], scratch);
+	const size_t begin = historyRows * rowBytes;
+	adler = adler32(1, &filtered[begin], filtered.size() - begin);
+	deflatePiece(filtered.data(), begin, filtered.size(), last, out);
+}
+
+static void beginChunk(vector<uint8_t>& out, const char* type)
+{
+	putBigEndian(out, 0);
+	out.insert(out.end(), type, type + 4);
+}
+
+// fills in the length and appends the CRC of a chunk started at start
+static void endChunk(vector<uint8_t>& out, size_t start)
+{
+	uint32_t length = (uint32_t)(out.size() - start - 8);
+	for (int i = 0; i < 4; i++)
+		out[start + i] = (uint8_t)(length >> (24 - 8 * i));
+	putBigEndian(out, crc32(0, &out[start + 4], length + 4));
+}
+
+// 8-bit RGB, one IDAT chunk holding the zlib stream of the bands
+static void writePNG(int width, int height, const vector<vector<uint8_t>>& bands, const vector<uint32_t>& adlers,
+	const vector<size_t>& bandBytes, vector<uint8_t>& out)
+{
+	size_t total = 0;
+	for (const vector<uint8_t>& band : bands)
+		total += band.size();
+	out.clear();
+	out.reserve(total + 64);
+	const uint8_t signature[8] = { 0x89, 'P', 'N', 'G', '\r', '\n', 0x1a, '\n' };
+	out.insert(out.end(), signature, signature + 8);
+
+	size_t start = out.size();
+	beginChunk(out, "IHDR");
+	putBigEndian(out, width);
+	putBigEndian(out, height);
+	const uint8_t format[5] = { 8, 2, 0, 0, 0 };
+	out.insert(out.end(), format, format + 5);
+	endChunk(out, start);
+
+	start = out.size();
+	beginChunk(out, "IDAT");
+	// deflate with a 32 KB window, no dictionary, fastest level hint
+	out.push_back(0x78);
+	out.push_back(0x01);
+	uint32_t adler = 1;
+	for (size_t i = 0; i < bands.size(); i++)
+	{
+		out.insert(out.end(), bands[i].begin(), bands[i].end());
+		adler = adler32Combine(adler, adlers[i], bandBytes[i]);
+	}
+	putBigEndian(out, adler);
+	endChunk(out, start);
+
+	start = out.size();
+	beginChunk(out, "IEND");
+	endChunk(out, start);
+}
+
+void encodePNG(const uint8_t* rgb, int width, int height, int bandCount, vector<uint8_t>& out)
+{
+	bandCount = max(1, min(bandCount, height));
+	vector<vector<uint8_t>> bands(bandCount);
+	vector<uint32_t> adlers(bandCount);
+	vector<size_t> bandBytes(bandCount);
+	for (int i = 0; i < bandCount; i++)
+	{
+		int firstRow = height * i / bandCount, endRow = height * (i + 1) / bandCount;
+		deflateBand(rgb, width, firstRow, endRow, i == bandCount - 1, adlers[i], bands[i]);
+		bandBytes[i] = (size_t)(endRow - firstRow) * (width * 3 + 1);
+	}
+	writePNG(width, height, bands, adlers, bandBytes, out);
+}
+
+FrameEncoder::FrameEncoder(const string& dir, FrameFormat frameFormat, int threadCount, size_t memoryBudget)
+	: directory(dir), format(frameFormat), budget(memoryBudget)
+{
+	if (!directory.empty())
+	{
+		error_code error;
+		fs::create_directories(directory, error);
+	}
+	if (threadCount <= 0)
+		threadCount = max(1u, thread::hardware_concurrency());
+	for (int i = 0; i < threadCount; i++)
+		workers.emplace_back(&FrameEncoder::workerLoop, this);
+}
+
+FrameEncoder::~FrameEncoder()
+{
+	finish();
+	{
+		lock_guard<mutex> lock(queueMutex);
+		stopping = true;
+	}
+	jobReady.notify_all();
+	for (thread& worker : workers)
+		worker.join();
+}
+
+void FrameEncoder::consume(const CapturedFrame& captured)
+{
+	auto frame = make_shared<Frame>();
+	frame->index = captured.index;
+	frame->width = captured.width;
+	frame->height = captured.height;
+	// the RGB copy, plus the filtered rows or the output while it's encoded
+	const size_t rgbBytes = (size_t)captured.width * captured.height * 3;
+	frame->bytes = rgbBytes * 2;
+
+	{
+		unique_lock<mutex> lock(queueMutex);
+		if (bytesInUse > 0 && bytesInUse + frame->bytes > budget)
+		{
+			auto start = Clock::now();
+			counters.budgetWaits++;
+			memoryFreed.wait(lock, [&] { return bytesInUse == 0 || bytesInUse + frame->bytes <= budget; });
+			counters.waitMilliseconds += chrono::duration<double, milli>(Clock::now() - start).count();
+		}
+		bytesInUse += frame->bytes;
+		framesInFlight++;
+		counters.frames++;
+		counters.rawBytes += rgbBytes;
+		counters.peakBytes = max(counters.peakBytes, bytesInUse);
+		if (!spareBuffers.empty())
+		{
+			frame->rgb.swap(spareBuffers.back());
+			spareBuffers.pop_back();
+		}
+	}
+
+	// a reused buffer is already paged in, which a fresh 4K one takes milliseconds for
+	frame->rgb.resize(rgbBytes);
+	packFrameRGB(captured, frame->rgb.data());
+
+	int bandCount = 1;
+	if (format == FRAME_FORMAT_PNG)
+	{
+		// twice as many bands as threads, so one slow band doesn't idle the rest
+		bandCount = max(1, min(frame->height / PNG_MIN_BAND_ROWS, 2 * (int)workers.size()));
+		frame->bands.resize(bandCount);
+		for (int i = 0; i < bandCount; i++)
+		{
+			frame->bands[i].firstRow = frame->height * i / bandCount;
+			frame->bands[i].endRow = frame->height * (i + 1) / bandCount;
+		}
+	}
+	{
+		lock_guard<mutex> lock(queueMutex);
+		frame->bandsLeft = bandCount;
+		for (int i = 0; i < bandCount; i++)
+			jobs.push_back({ frame, i });
+	}
+	jobReady.notify_all();
+}
+
+void FrameEncoder::finish()
+{
+	unique_lock<mutex> lock(queueMutex);
+	memoryFreed.wait(lock, [this] { return framesInFlight == 0; });
+}
+
+FrameEncoder::Stats FrameEncoder::stats() const
+{
+	lock_guard<mutex> lock(queueMutex);
+	return counters;
+}
+
+void FrameEncoder::workerLoop()
+{
+	vector<uint8_t> encoded;
+	for (;;)
+	{
+		unique_lock<mutex> lock(queueMutex);
+		jobReady.wait(lock, [this] { return !jobs.empty() || stopping; });
+		if (jobs.empty())
+			return;
+		Job job = move(jobs.front());
+		jobs.pop_front();
+		lock.unlock();
+
+		Frame& frame = *job.frame;
+		if (format == FRAME_FORMAT_QOI)
+		{
+			encodeQOI(frame.rgb.data(), frame.width, frame.height, encoded);
+			writeFrame(frame, encoded);
+			continue;
+		}
+
+		Band& band = frame.bands[job.band];
+		deflateBand(frame.rgb.data(), frame.width, band.firstRow, band.endRow, job.band == (int)frame.bands.size() - 1,
+			band.adler, band.data);
+		lock.lock();
+		bool lastBand = --frame.bandsLeft == 0;
+		lock.unlock();
+		if (!lastBand)
+			continue;
+
+		// whoever finishes the last band puts the file together
+		vector<vector<uint8_t>> bands;
+		vector<uint32_t> adlers;
+		vector<size_t> bandBytes;
+		for (Band& b : frame.bands)
+		{
+			bands.push_back(move(b.data));
+			adlers.push_back(b.adler);
+			bandBytes.push_back((size_t)(b.endRow - b.firstRow) * (frame.width * 3 + 1));
+		}
+		writePNG(frame.width, frame.height, bands, adlers, bandBytes, encoded);
+		writeFrame(frame, encoded);
+	}
+}
+
+void FrameEncoder::writeFrame(Frame& frame, const vector<uint8_t>& encoded)
+{
+	bool ok = true;
+	string path;
+	if (!directory.empty())
+	{
+		char name[32];
+		snprintf(name, sizeof(name), "/frame_%05llu.%s", (unsigned long long)frame.index,
+			format == FRAME_FORMAT_QOI ? "qoi" : "png");
+		path = directory + name;
+		FILE* file = fopen(path.c_str(), "wb");
+		ok = file && fwrite(encoded.data(), 1, encoded.size(), file) == encoded.size();
+		ok = file && fclose(file) == 0 && ok;
+	}
+	frame.bands.clear();
+
+	{
+		lock_guard<mutex> lock(queueMutex);
+		// as many spares as frames the budget holds at once
+		if (spareBuffers.size() * frame.bytes < budget)
+			spareBuffers.push_back(move(frame.rgb));
+		frame.rgb = vector<uint8_t>();
+		if (!ok && !failed)
+		{
+			cout << "ERROR::CAPTURE::WRITE_FAILED " << path << endl;
+			failed = true;
+		}
+		counters.encodedBytes += encoded.size();
+		bytesInUse -= frame.bytes;
+		framesInFlight--;
+	}
+	memoryFreed.notify_all();
+}
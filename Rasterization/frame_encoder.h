@@ -0,0 +1,108 @@
+#ifndef FRAME_ENCODER_H
+#define FRAME_ENCODER_H
+
+#include <condition_variable>
+#include <cstdint>
+#include <deque>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <vector>
+
+#include "frame_capture.h"
+
+enum FrameFormat
+{
+	FRAME_FORMAT_QOI,	// fast, about 3x larger than PNG on rendered frames
+	FRAME_FORMAT_PNG,
+};
+
+// 8-bit RGB rows top-down, 3 bytes per pixel, from a captured RGBA frame
+void packFrameRGB(const CapturedFrame& frame, uint8_t* rgb);
+
+void encodeQOI(const uint8_t* rgb, int width, int height, std::vector<uint8_t>& out);
+// bands > 1 splits the deflate stream into independently compressed row
+// bands, the way FrameEncoder does across threads
+void encodePNG(const uint8_t* rgb, int width, int height, int bands, std::vector<uint8_t>& out);
+
+// A FrameSink that encodes frames on a pool of threads and writes them to
+// directory/frame_NNNNN.qoi or .png. consume() only converts the frame to
+// RGB and queues it, so it returns as soon as the PBO is copied, and a QOI
+// frame or a band of a PNG frame is one job for the pool. consume() waits
+// only while the frames queued or being encoded use more than memoryBudget
+// bytes, which is also when FrameCapture and then the render thread start
+// waiting. An empty directory encodes without writing, for benchmarks.
+class FrameEncoder : public FrameSink
+{
+public:
+	FrameEncoder(const std::string& directory, FrameFormat format, int threadCount = 0,
+		size_t memoryBudget = 512u << 20);
+	~FrameEncoder();
+
+	FrameEncoder(const FrameEncoder&) = delete;
+	FrameEncoder& operator=(const FrameEncoder&) = delete;
+
+	void consume(const CapturedFrame& frame) override;
+	// waits until every queued frame is written
+	void finish() override;
+
+	struct Stats
+	{
+		uint64_t frames = 0;
+		uint64_t budgetWaits = 0;		// consume() calls that waited for memory
+		double waitMilliseconds = 0.0;
+		uint64_t rawBytes = 0;			// RGB
+		uint64_t encodedBytes = 0;
+		size_t peakBytes = 0;
+	};
+	Stats stats() const;
+
+private:
+	struct Band
+	{
+		int firstRow;
+		int endRow;
+		uint32_t adler;
+		std::vector<uint8_t> data;
+	};
+
+	struct Frame
+	{
+		uint64_t index;
+		int width;
+		int height;
+		std::vector<uint8_t> rgb;
+		std::vector<Band> bands;
+		int bandsLeft;		// guarded by queueMutex
+		size_t bytes;		// charged against the budget
+	};
+
+	struct Job
+	{
+		std::shared_ptr<Frame> frame;
+		int band;
+	};
+
+	void workerLoop();
+	void writeFrame(Frame& frame, const std::vector<uint8_t>& encoded);
+
+	std::string directory;
+	FrameFormat format;
+	size_t budget;
+	std::vector<std::thread> workers;
+
+	mutable std::mutex queueMutex;
+	std::condition_variable jobReady;
+	std::condition_variable memoryFreed;
+	std::deque<Job> jobs;
+	std::vector<std::vector<uint8_t>> spareBuffers;	// RGB buffers of written frames, reused
+	size_t bytesInUse = 0;
+	int framesInFlight = 0;
+	bool stopping = false;
+	bool failed = false;
+
+	Stats counters;
+};
+
+#endif
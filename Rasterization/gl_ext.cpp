@@ -0,0 +1,75 @@
+#include "gl_ext.h"
+
+#include <algorithm>
+#include <cstring>
+#include <vector>
+
+using namespace std;
+
+GLExtensions glext;
+
+static bool versionAtLeast(int major, int minor)
+{
+	return glext.major > major || (glext.major == major && glext.minor >= minor);
+}
+
+void loadGLExtensions(GLADloadproc load)
+{
+	glGetIntegerv(GL_MAJOR_VERSION, &glext.major);
+	glGetIntegerv(GL_MINOR_VERSION, &glext.minor);
+
+	// the extension strings once, sorted, rather than all of them again for
+	// every extension asked about below; they live as long as the context
+	int count = 0;
+	glGetIntegerv(GL_NUM_EXTENSIONS, &count);
+	vector<const char*> extensions;
+	extensions.reserve(count);
+	for (int i = 0; i < count; i++)
+	{
+		const char* extension = (const char*)glGetStringi(GL_EXTENSIONS, i);
+		if (extension)
+			extensions.push_back(extension);
+	}
+	auto less = [](const char* a, const char* b) { return strcmp(a, b) < 0; };
+	sort(extensions.begin(), extensions.end(), less);
+	auto supported = [&](const char* name) { return binary_search(extensions.begin(), extensions.end(), name, less); };
+
+	glext.ShaderBinary = (PFNEXT_SHADERBINARY)load("glShaderBinary");
+	if (versionAtLeast(4, 6))
+		glext.SpecializeShader = (PFNEXT_SPECIALIZESHADER)load("glSpecializeShader");
+	else if (supported("GL_ARB_gl_spirv"))
+		glext.SpecializeShader = (PFNEXT_SPECIALIZESHADER)load("glSpecializeShaderARB");
+	glext.spirv = glext.ShaderBinary && glext.SpecializeShader;
+
+	if (versionAtLeast(4, 4) || supported("GL_ARB_buffer_storage"))
+		glext.BufferStorage = (PFNEXT_BUFFERSTORAGE)load("glBufferStorage");
+	glext.bufferStorage = glext.BufferStorage != nullptr;
+
+	if (versionAtLeast(4, 2) || supported("GL_ARB_texture_storage"))
+		glext.TexStorage2D = (PFNEXT_TEXSTORAGE2D)load("glTexStorage2D");
+	glext.textureStorage = glext.TexStorage2D != nullptr;
+
+	glext.shaderStorage = versionAtLeast(4, 3) || supported("GL_ARB_shader_storage_buffer_object");
+
+	if (versionAtLeast(4, 3))
+	{
+		glext.DispatchCompute = (PFNEXT_DISPATCHCOMPUTE)load("glDispatchCompute");
+		glext.MemoryBarrier = (PFNEXT_MEMORYBARRIER)load("glMemoryBarrier");
+		glext.ClearBufferData = (PFNEXT_CLEARBUFFERDATA)load("glClearBufferData");
+		glext.MultiDrawArraysIndirect = (PFNEXT_MULTIDRAWARRAYSINDIRECT)load("glMultiDrawArraysIndirect");
+	}
+	glext.compute = glext.DispatchCompute && glext.MemoryBarrier && glext.ClearBufferData && glext.MultiDrawArraysIndirect;
+
+	if (versionAtLeast(4, 6))
+		glext.MultiDrawArraysIndirectCount = (PFNEXT_MULTIDRAWARRAYSINDIRECTCOUNT)load("glMultiDrawArraysIndirectCount");
+	else if (supported("GL_ARB_indirect_parameters"))
+		glext.MultiDrawArraysIndirectCount = (PFNEXT_MULTIDRAWARRAYSINDIRECTCOUNT)load("glMultiDrawArraysIndirectCountARB");
+	glext.indirectCount = glext.MultiDrawArraysIndirectCount != nullptr;
+
+	glext.s3tc = supported("GL_EXT_texture_compression_s3tc");
+	glext.s3tcSrgb = glext.s3tc && (supported("GL_EXT_texture_sRGB") || supported("GL_EXT_texture_compression_s3tc_srgb"));
+	glext.bptc = versionAtLeast(4, 2) || supported("GL_ARB_texture_compression_bptc");
+
+	glext.nvxMemoryInfo = supported("GL_NVX_gpu_memory_info");
+	glext.atiMeminfo = supported("GL_ATI_meminfo");
+}
@@ -0,0 +1,128 @@
+#ifndef GL_EXT_H
+#define GL_EXT_H
+
+#include <glad/glad.h>
+
+// Entry points and enums newer than the GL 3.3 core glad was generated for.
+// They are looked up through the same loader as gl_loader.h, and are null when
+// the driver doesn't provide them, so check the flags before calling.
+
+#ifndef GL_SHADER_BINARY_FORMAT_SPIR_V
+#define GL_SHADER_BINARY_FORMAT_SPIR_V 0x9551
+#endif
+#ifndef GL_SPIR_V_BINARY
+#define GL_SPIR_V_BINARY 0x9552
+#endif
+
+#ifndef GL_MAP_PERSISTENT_BIT
+#define GL_MAP_PERSISTENT_BIT 0x0040
+#endif
+#ifndef GL_MAP_COHERENT_BIT
+#define GL_MAP_COHERENT_BIT 0x0080
+#endif
+#ifndef GL_SHADER_STORAGE_BUFFER
+#define GL_SHADER_STORAGE_BUFFER 0x90D2
+#endif
+#ifndef GL_SHADER_STORAGE_BUFFER_OFFSET_ALIGNMENT
+#define GL_SHADER_STORAGE_BUFFER_OFFSET_ALIGNMENT 0x90DF
+#endif
+#ifndef GL_COMPUTE_SHADER
+#define GL_COMPUTE_SHADER 0x91B9
+#endif
+#ifndef GL_DRAW_INDIRECT_BUFFER
+#define GL_DRAW_INDIRECT_BUFFER 0x8F3F
+#endif
+#ifndef GL_PARAMETER_BUFFER
+#define GL_PARAMETER_BUFFER 0x80EE
+#endif
+#ifndef GL_COMMAND_BARRIER_BIT
+#define GL_COMMAND_BARRIER_BIT 0x00000040
+#endif
+#ifndef GL_SHADER_STORAGE_BARRIER_BIT
+#define GL_SHADER_STORAGE_BARRIER_BIT 0x00002000
+#endif
+#ifndef GL_COMPRESSED_RGB_S3TC_DXT1_EXT
+#define GL_COMPRESSED_RGB_S3TC_DXT1_EXT 0x83F0
+#define GL_COMPRESSED_RGBA_S3TC_DXT5_EXT 0x83F3
+#endif
+#ifndef GL_COMPRESSED_SRGB_S3TC_DXT1_EXT
+#define GL_COMPRESSED_SRGB_S3TC_DXT1_EXT 0x8C4C
+#define GL_COMPRESSED_SRGB_ALPHA_S3TC_DXT5_EXT 0x8C4F
+#endif
+#ifndef GL_COMPRESSED_RGBA_BPTC_UNORM
+#define GL_COMPRESSED_RGBA_BPTC_UNORM 0x8E8C
+#define GL_COMPRESSED_SRGB_ALPHA_BPTC_UNORM 0x8E8D
+#endif
+#ifndef GL_GPU_MEMORY_INFO_DEDICATED_VIDMEM_NVX
+#define GL_GPU_MEMORY_INFO_DEDICATED_VIDMEM_NVX 0x9047
+#define GL_GPU_MEMORY_INFO_TOTAL_AVAILABLE_MEMORY_NVX 0x9048
+#define GL_GPU_MEMORY_INFO_CURRENT_AVAILABLE_VIDMEM_NVX 0x9049
+#define GL_GPU_MEMORY_INFO_EVICTION_COUNT_NVX 0x904A
+#define GL_GPU_MEMORY_INFO_EVICTED_MEMORY_NVX 0x904B
+#endif
+#ifndef GL_VBO_FREE_MEMORY_ATI
+#define GL_VBO_FREE_MEMORY_ATI 0x87FB
+#define GL_TEXTURE_FREE_MEMORY_ATI 0x87FC
+#define GL_RENDERBUFFER_FREE_MEMORY_ATI 0x87FD
+#endif
+
+typedef void (APIENTRY *PFNEXT_SHADERBINARY)(GLsizei count, const GLuint* shaders, GLenum binaryformat, const void* binary, GLsizei length);
+typedef void (APIENTRY *PFNEXT_SPECIALIZESHADER)(GLuint shader, const GLchar* pEntryPoint, GLuint numSpecializationConstants, const GLuint* pConstantIndex, const GLuint* pConstantValue);
+typedef void (APIENTRY *PFNEXT_BUFFERSTORAGE)(GLenum target, GLsizeiptr size, const void* data, GLbitfield flags);
+typedef void (APIENTRY *PFNEXT_DISPATCHCOMPUTE)(GLuint x, GLuint y, GLuint z);
+typedef void (APIENTRY *PFNEXT_MEMORYBARRIER)(GLbitfield barriers);
+typedef void (APIENTRY *PFNEXT_CLEARBUFFERDATA)(GLenum target, GLenum internalformat, GLenum format, GLenum type, const void* data);
+typedef void (APIENTRY *PFNEXT_MULTIDRAWARRAYSINDIRECT)(GLenum mode, const void* indirect, GLsizei drawcount, GLsizei stride);
+typedef void (APIENTRY *PFNEXT_TEXSTORAGE2D)(GLenum target, GLsizei levels, GLenum internalformat, GLsizei width, GLsizei height);
+typedef void (APIENTRY *PFNEXT_MULTIDRAWARRAYSINDIRECTCOUNT)(GLenum mode, const void* indirect, GLintptr drawcount, GLsizei maxdrawcount, GLsizei stride);
+
+struct GLExtensions
+{
+	int major = 0;
+	int minor = 0;
+
+	// GL 4.6 or GL_ARB_gl_spirv
+	bool spirv = false;
+	PFNEXT_SHADERBINARY ShaderBinary = nullptr;
+	PFNEXT_SPECIALIZESHADER SpecializeShader = nullptr;
+
+	// GL 4.4 or GL_ARB_buffer_storage, for persistently mapped buffers
+	bool bufferStorage = false;
+	PFNEXT_BUFFERSTORAGE BufferStorage = nullptr;
+
+	// GL 4.2 or GL_ARB_texture_storage, immutable textures
+	bool textureStorage = false;
+	PFNEXT_TEXSTORAGE2D TexStorage2D = nullptr;
+
+	// GL 4.3 or GL_ARB_shader_storage_buffer_object
+	bool shaderStorage = false;
+
+	// GL 4.3: compute shaders, SSBOs and multi-draw indirect together
+	bool compute = false;
+	PFNEXT_DISPATCHCOMPUTE DispatchCompute = nullptr;
+	PFNEXT_MEMORYBARRIER MemoryBarrier = nullptr;
+	PFNEXT_CLEARBUFFERDATA ClearBufferData = nullptr;
+	PFNEXT_MULTIDRAWARRAYSINDIRECT MultiDrawArraysIndirect = nullptr;
+
+	// GL 4.6 or GL_ARB_indirect_parameters, draw count read from a buffer
+	bool indirectCount = false;
+	PFNEXT_MULTIDRAWARRAYSINDIRECTCOUNT MultiDrawArraysIndirectCount = nullptr;
+
+	// block compressed textures: BC1 and BC3 through GL_EXT_texture_compression_s3tc,
+	// their sRGB versions through GL_EXT_texture_sRGB, BC7 through GL 4.2 or
+	// GL_ARB_texture_compression_bptc; plain glCompressedTexImage2D enums
+	bool s3tc = false;
+	bool s3tcSrgb = false;
+	bool bptc = false;
+
+	// video memory queries, plain glGetIntegerv enums
+	bool nvxMemoryInfo = false;
+	bool atiMeminfo = false;
+};
+
+extern GLExtensions glext;
+
+// call once after loadGL() with the context current
+void loadGLExtensions(GLADloadproc load);
+
+#endif
@@ -0,0 +1,372 @@
+// The GL 1.0 to 3.3 core functions glad.h declares, one GL_FUNCTION(return
+// type, name without the gl, parameters, arguments) each, for gl_loader.cpp
+// to expand. No include guard: include it with GL_FUNCTION defined.
+
+// GL 1.0
+GL_FUNCTION(void, CullFace, (GLenum mode), (mode))
+GL_FUNCTION(void, FrontFace, (GLenum mode), (mode))
+GL_FUNCTION(void, Hint, (GLenum target, GLenum mode), (target, mode))
+GL_FUNCTION(void, LineWidth, (GLfloat width), (width))
+GL_FUNCTION(void, PointSize, (GLfloat size), (size))
+GL_FUNCTION(void, PolygonMode, (GLenum face, GLenum mode), (face, mode))
+GL_FUNCTION(void, Scissor, (GLint x, GLint y, GLsizei width, GLsizei height), (x, y, width, height))
+GL_FUNCTION(void, TexParameterf, (GLenum target, GLenum pname, GLfloat param), (target, pname, param))
+GL_FUNCTION(void, TexParameterfv, (GLenum target, GLenum pname, const GLfloat* params), (target, pname, params))
+GL_FUNCTION(void, TexParameteri, (GLenum target, GLenum pname, GLint param), (target, pname, param))
+GL_FUNCTION(void, TexParameteriv, (GLenum target, GLenum pname, const GLint* params), (target, pname, params))
+GL_FUNCTION(void, TexImage1D, (GLenum target, GLint level, GLint internalformat, GLsizei width, GLint border, GLenum format, GLenum type, const void* pixels), (target, level, internalformat, width, border, format, type, pixels))
+GL_FUNCTION(void, TexImage2D, (GLenum target, GLint level, GLint internalformat, GLsizei width, GLsizei height, GLint border, GLenum format, GLenum type, const void* pixels), (target, level, internalformat, width, height, border, format, type, pixels))
+GL_FUNCTION(void, DrawBuffer, (GLenum buf), (buf))
+GL_FUNCTION(void, Clear, (GLbitfield mask), (mask))
+GL_FUNCTION(void, ClearColor, (GLfloat red, GLfloat green, GLfloat blue, GLfloat alpha), (red, green, blue, alpha))
+GL_FUNCTION(void, ClearStencil, (GLint s), (s))
+GL_FUNCTION(void, ClearDepth, (GLdouble depth), (depth))
+GL_FUNCTION(void, StencilMask, (GLuint mask), (mask))
+GL_FUNCTION(void, ColorMask, (GLboolean red, GLboolean green, GLboolean blue, GLboolean alpha), (red, green, blue, alpha))
+GL_FUNCTION(void, DepthMask, (GLboolean flag), (flag))
+GL_FUNCTION(void, Disable, (GLenum cap), (cap))
+GL_FUNCTION(void, Enable, (GLenum cap), (cap))
+GL_FUNCTION(void, Finish, (), ())
+GL_FUNCTION(void, Flush, (), ())
+GL_FUNCTION(void, BlendFunc, (GLenum sfactor, GLenum dfactor), (sfactor, dfactor))
+GL_FUNCTION(void, LogicOp, (GLenum opcode), (opcode))
+GL_FUNCTION(void, StencilFunc, (GLenum func, GLint ref, GLuint mask), (func, ref, mask))
+GL_FUNCTION(void, StencilOp, (GLenum fail, GLenum zfail, GLenum zpass), (fail, zfail, zpass))
+GL_FUNCTION(void, DepthFunc, (GLenum func), (func))
+GL_FUNCTION(void, PixelStoref, (GLenum pname, GLfloat param), (pname, param))
+GL_FUNCTION(void, PixelStorei, (GLenum pname, GLint param), (pname, param))
+GL_FUNCTION(void, ReadBuffer, (GLenum src), (src))
+GL_FUNCTION(void, ReadPixels, (GLint x, GLint y, GLsizei width, GLsizei height, GLenum format, GLenum type, void* pixels), (x, y, width, height, format, type, pixels))
+GL_FUNCTION(void, GetBooleanv, (GLenum pname, GLboolean* data), (pname, data))
+GL_FUNCTION(void, GetDoublev, (GLenum pname, GLdouble* data), (pname, data))
+GL_FUNCTION(GLenum, GetError, (), ())
+GL_FUNCTION(void, GetFloatv, (GLenum pname, GLfloat* data), (pname, data))
+GL_FUNCTION(void, GetIntegerv, (GLenum pname, GLint* data), (pname, data))
+GL_FUNCTION(const GLubyte*, GetString, (GLenum name), (name))
+GL_FUNCTION(void, GetTexImage, (GLenum target, GLint level, GLenum format, GLenum type, void* pixels), (target, level, format, type, pixels))
+GL_FUNCTION(void, GetTexParameterfv, (GLenum target, GLenum pname, GLfloat* params), (target, pname, params))
+GL_FUNCTION(void, GetTexParameteriv, (GLenum target, GLenum pname, GLint* params), (target, pname, params))
+GL_FUNCTION(void, GetTexLevelParameterfv, (GLenum target, GLint level, GLenum pname, GLfloat* params), (target, level, pname, params))
+GL_FUNCTION(void, GetTexLevelParameteriv, (GLenum target, GLint level, GLenum pname, GLint* params), (target, level, pname, params))
+GL_FUNCTION(GLboolean, IsEnabled, (GLenum cap), (cap))
+GL_FUNCTION(void, DepthRange, (GLdouble n, GLdouble f), (n, f))
+GL_FUNCTION(void, Viewport, (GLint x, GLint y, GLsizei width, GLsizei height), (x, y, width, height))
+
+// GL 1.1
+GL_FUNCTION(void, DrawArrays, (GLenum mode, GLint first, GLsizei count), (mode, first, count))
+GL_FUNCTION(void, DrawElements, (GLenum mode, GLsizei count, GLenum type, const void* indices), (mode, count, type, indices))
+GL_FUNCTION(void, GetPointerv, (GLenum pname, void** params), (pname, params))
+GL_FUNCTION(void, PolygonOffset, (GLfloat factor, GLfloat units), (factor, units))
+GL_FUNCTION(void, CopyTexImage1D, (GLenum target, GLint level, GLenum internalformat, GLint x, GLint y, GLsizei width, GLint border), (target, level, internalformat, x, y, width, border))
+GL_FUNCTION(void, CopyTexImage2D, (GLenum target, GLint level, GLenum internalformat, GLint x, GLint y, GLsizei width, GLsizei height, GLint border), (target, level, internalformat, x, y, width, height, border))
+GL_FUNCTION(void, CopyTexSubImage1D, (GLenum target, GLint level, GLint xoffset, GLint x, GLint y, GLsizei width), (target, level, xoffset, x, y, width))
+GL_FUNCTION(void, CopyTexSubImage2D, (GLenum target, GLint level, GLint xoffset, GLint yoffset, GLint x, GLint y, GLsizei width, GLsizei height), (target, level, xoffset, yoffset, x, y, width, height))
+GL_FUNCTION(void, TexSubImage1D, (GLenum target, GLint level, GLint xoffset, GLsizei width, GLenum format, GLenum type, const void* pixels), (target, level, xoffset, width, format, type, pixels))
+GL_FUNCTION(void, TexSubImage2D, (GLenum target, GLint level, GLint xoffset, GLint yoffset, GLsizei width, GLsizei height, GLenum format, GLenum type, const void* pixels), (target, level, xoffset, yoffset, width, height, format, type, pixels))
+GL_FUNCTION(void, BindTexture, (GLenum target, GLuint texture), (target, texture))
+GL_FUNCTION(void, DeleteTextures, (GLsizei n, const GLuint* textures), (n, textures))
+GL_FUNCTION(void, GenTextures, (GLsizei n, GLuint* textures), (n, textures))
+GL_FUNCTION(GLboolean, IsTexture, (GLuint texture), (texture))
+
+// GL 1.2
+GL_FUNCTION(void, DrawRangeElements, (GLenum mode, GLuint start, GLuint end, GLsizei count, GLenum type, const void* indices), (mode, start, end, count, type, indices))
+GL_FUNCTION(void, TexImage3D, (GLenum target, GLint level, GLint internalformat, GLsizei width, GLsizei height, GLsizei depth, GLint border, GLenum format, GLenum type, const void* pixels), (target, level, internalformat, width, height, depth, border, format, type, pixels))
+GL_FUNCTION(void, TexSubImage3D, (GLenum target, GLint level, GLint xoffset, GLint yoffset, GLint zoffset, GLsizei width, GLsizei height, GLsizei depth, GLenum format, GLenum type, const void* pixels), (target, level, xoffset, yoffset, zoffset, width, height, depth, format, type, pixels))
+GL_FUNCTION(void, CopyTexSubImage3D, (GLenum target, GLint level, GLint xoffset, GLint yoffset, GLint zoffset, GLint x, GLint y, GLsizei width, GLsizei height), (target, level, xoffset, yoffset, zoffset, x, y, width, height))
+
+// GL 1.3
+GL_FUNCTION(void, ActiveTexture, (GLenum texture), (texture))
+GL_FUNCTION(void, SampleCoverage, (GLfloat value, GLboolean invert), (value, invert))
+GL_FUNCTION(void, CompressedTexImage3D, (GLenum target, GLint level, GLenum internalformat, GLsizei width, GLsizei height, GLsizei depth, GLint border, GLsizei imageSize, const void* data), (target, level, internalformat, width, height, depth, border, imageSize, data))
+GL_FUNCTION(void, CompressedTexImage2D, (GLenum target, GLint level, GLenum internalformat, GLsizei width, GLsizei height, GLint border, GLsizei imageSize, const void* data), (target, level, internalformat, width, height, border, imageSize, data))
+GL_FUNCTION(void, CompressedTexImage1D, (GLenum target, GLint level, GLenum internalformat, GLsizei width, GLint border, GLsizei imageSize, const void* data), (target, level, internalformat, width, border, imageSize, data))
+GL_FUNCTION(void, CompressedTexSubImage3D, (GLenum target, GLint level, GLint xoffset, GLint yoffset, GLint zoffset, GLsizei width, GLsizei height, GLsizei depth, GLenum format, GLsizei imageSize, const void* data), (target, level, xoffset, yoffset, zoffset, width, height, depth, format, imageSize, data))
+GL_FUNCTION(void, CompressedTexSubImage2D, (GLenum target, GLint level, GLint xoffset, GLint yoffset, GLsizei width, GLsizei height, GLenum format, GLsizei imageSize, const void* data), (target, level, xoffset, yoffset, width, height, format, imageSize, data))
+GL_FUNCTION(void, CompressedTexSubImage1D, (GLenum target, GLint level, GLint xoffset, GLsizei width, GLenum format, GLsizei imageSize, const void* data), (target, level, xoffset, width, format, imageSize, data))
+GL_FUNCTION(void, GetCompressedTexImage, (GLenum target, GLint level, void* img), (target, level, img))
+
+// GL 1.4
+GL_FUNCTION(void, BlendFuncSeparate, (GLenum sfactorRGB, GLenum dfactorRGB, GLenum sfactorAlpha, GLenum dfactorAlpha), (sfactorRGB, dfactorRGB, sfactorAlpha, dfactorAlpha))
+GL_FUNCTION(void, MultiDrawArrays, (GLenum mode, const GLint* first, const GLsizei* count, GLsizei drawcount), (mode, first, count, drawcount))
+GL_FUNCTION(void, MultiDrawElements, (GLenum mode, const GLsizei* count, GLenum type, const void* const* indices, GLsizei drawcount), (mode, count, type, indices, drawcount))
+GL_FUNCTION(void, PointParameterf, (GLenum pname, GLfloat param), (pname, param))
+GL_FUNCTION(void, PointParameterfv, (GLenum pname, const GLfloat* params), (pname, params))
+GL_FUNCTION(void, PointParameteri, (GLenum pname, GLint param), (pname, param))
+GL_FUNCTION(void, PointParameteriv, (GLenum pname, const GLint* params), (pname, params))
+GL_FUNCTION(void, BlendColor, (GLfloat red, GLfloat green, GLfloat blue, GLfloat alpha), (red, green, blue, alpha))
+GL_FUNCTION(void, BlendEquation, (GLenum mode), (mode))
+
+// GL 1.5
+GL_FUNCTION(void, GenQueries, (GLsizei n, GLuint* ids), (n, ids))
+GL_FUNCTION(void, DeleteQueries, (GLsizei n, const GLuint* ids), (n, ids))
+GL_FUNCTION(GLboolean, IsQuery, (GLuint id), (id))
+GL_FUNCTION(void, BeginQuery, (GLenum target, GLuint id), (target, id))
+GL_FUNCTION(void, EndQuery, (GLenum target), (target))
+GL_FUNCTION(void, GetQueryiv, (GLenum target, GLenum pname, GLint* params), (target, pname, params))
+GL_FUNCTION(void, GetQueryObjectiv, (GLuint id, GLenum pname, GLint* params), (id, pname, params))
+GL_FUNCTION(void, GetQueryObjectuiv, (GLuint id, GLenum pname, GLuint* params), (id, pname, params))
+GL_FUNCTION(void, BindBuffer, (GLenum target, GLuint buffer), (target, buffer))
+GL_FUNCTION(void, DeleteBuffers, (GLsizei n, const GLuint* buffers), (n, buffers))
+GL_FUNCTION(void, GenBuffers, (GLsizei n, GLuint* buffers), (n, buffers))
+GL_FUNCTION(GLboolean, IsBuffer, (GLuint buffer), (buffer))
+GL_FUNCTION(void, BufferData, (GLenum target, GLsizeiptr size, const void* data, GLenum usage), (target, size, data, usage))
+GL_FUNCTION(void, BufferSubData, (GLenum target, GLintptr offset, GLsizeiptr size, const void* data), (target, offset, size, data))
+GL_FUNCTION(void, GetBufferSubData, (GLenum target, GLintptr offset, GLsizeiptr size, void* data), (target, offset, size, data))
+GL_FUNCTION(void*, MapBuffer, (GLenum target, GLenum access), (target, access))
+GL_FUNCTION(GLboolean, UnmapBuffer, (GLenum target), (target))
+GL_FUNCTION(void, GetBufferParameteriv, (GLenum target, GLenum pname, GLint* params), (target, pname, params))
+GL_FUNCTION(void, GetBufferPointerv, (GLenum target, GLenum pname, void** params), (target, pname, params))
+
+// GL 2.0
+GL_FUNCTION(void, BlendEquationSeparate, (GLenum modeRGB, GLenum modeAlpha), (modeRGB, modeAlpha))
+GL_FUNCTION(void, DrawBuffers, (GLsizei n, const GLenum* bufs), (n, bufs))
+GL_FUNCTION(void, StencilOpSeparate, (GLenum face, GLenum sfail, GLenum dpfail, GLenum dppass), (face, sfail, dpfail, dppass))
+GL_FUNCTION(void, StencilFuncSeparate, (GLenum face, GLenum func, GLint ref, GLuint mask), (face, func, ref, mask))
+GL_FUNCTION(void, StencilMaskSeparate, (GLenum face, GLuint mask), (face, mask))
+GL_FUNCTION(void, AttachShader, (GLuint program, GLuint shader), (program, shader))
+GL_FUNCTION(void, BindAttribLocation, (GLuint program, GLuint index, const GLchar* name), (program, index, name))
+GL_FUNCTION(void, CompileShader, (GLuint shader), (shader))
+GL_FUNCTION(GLuint, CreateProgram, (), ())
+GL_FUNCTION(GLuint, CreateShader, (GLenum type), (type))
+GL_FUNCTION(void, DeleteProgram, (GLuint program), (program))
+GL_FUNCTION(void, DeleteShader, (GLuint shader), (shader))
+GL_FUNCTION(void, DetachShader, (GLuint program, GLuint shader), (program, shader))
+GL_FUNCTION(void, DisableVertexAttribArray, (GLuint index), (index))
+GL_FUNCTION(void, EnableVertexAttribArray, (GLuint index), (index))
+GL_FUNCTION(void, GetActiveAttrib, (GLuint program, GLuint index, GLsizei bufSize, GLsizei* length, GLint* size, GLenum* type, GLchar* name), (program, index, bufSize, length, size, type, name))
+GL_FUNCTION(void, GetActiveUniform, (GLuint program, GLuint index, GLsizei bufSize, GLsizei* length, GLint* size, GLenum* type, GLchar* name), (program, index, bufSize, length, size, type, name))
+GL_FUNCTION(void, GetAttachedShaders, (GLuint program, GLsizei maxCount, GLsizei* count, GLuint* shaders), (program, maxCount, count, shaders))
+GL_FUNCTION(GLint, GetAttribLocation, (GLuint program, const GLchar* name), (program, name))
+GL_FUNCTION(void, GetProgramiv, (GLuint program, GLenum pname, GLint* params), (program, pname, params))
+GL_FUNCTION(void, GetProgramInfoLog, (GLuint program, GLsizei bufSize, GLsizei* length, GLchar* infoLog), (program, bufSize, length, infoLog))
+GL_FUNCTION(void, GetShaderiv, (GLuint shader, GLenum pname, GLint* params), (shader, pname, params))
+GL_FUNCTION(void, GetShaderInfoLog, (GLuint shader, GLsizei bufSize, GLsizei* length, GLchar* infoLog), (shader, bufSize, length, infoLog))
+GL_FUNCTION(void, GetShaderSource, (GLuint shader, GLsizei bufSize, GLsizei* length, GLchar* source), (shader, bufSize, length, source))
+GL_FUNCTION(GLint, GetUniformLocation, (GLuint program, const GLchar* name), (program, name))
+GL_FUNCTION(void, GetUniformfv, (GLuint program, GLint location, GLfloat* params), (program, location, params))
+GL_FUNCTION(void, GetUniformiv, (GLuint program, GLint location, GLint* params), (program, location, params))
+GL_FUNCTION(void, GetVertexAttribdv, (GLuint index, GLenum pname, GLdouble* params), (index, pname, params))
+GL_FUNCTION(void, GetVertexAttribfv, (GLuint index, GLenum pname, GLfloat* params), (index, pname, params))
+GL_FUNCTION(void, GetVertexAttribiv, (GLuint index, GLenum pname, GLint* params), (index, pname, params))
+GL_FUNCTION(void, GetVertexAttribPointerv, (GLuint index, GLenum pname, void** pointer), (index, pname, pointer))
+GL_FUNCTION(GLboolean, IsProgram, (GLuint program), (program))
+GL_FUNCTION(GLboolean, IsShader, (GLuint shader), (shader))
+GL_FUNCTION(void, LinkProgram, (GLuint program), (program))
+GL_FUNCTION(void, ShaderSource, (GLuint shader, GLsizei count, const GLchar* const* string, const GLint* length), (shader, count, string, length))
+GL_FUNCTION(void, UseProgram, (GLuint program), (program))
+GL_FUNCTION(void, Uniform1f, (GLint location, GLfloat v0), (location, v0))
+GL_FUNCTION(void, Uniform2f, (GLint location, GLfloat v0, GLfloat v1), (location, v0, v1))
+GL_FUNCTION(void, Uniform3f, (GLint location, GLfloat v0, GLfloat v1, GLfloat v2), (location, v0, v1, v2))
+GL_FUNCTION(void, Uniform4f, (GLint location, GLfloat v0, GLfloat v1, GLfloat v2, GLfloat v3), (location, v0, v1, v2, v3))
+GL_FUNCTION(void, Uniform1i, (GLint location, GLint v0), (location, v0))
+GL_FUNCTION(void, Uniform2i, (GLint location, GLint v0, GLint v1), (location, v0, v1))
+GL_FUNCTION(void, Uniform3i, (GLint location, GLint v0, GLint v1, GLint v2), (location, v0, v1, v2))
+GL_FUNCTION(void, Uniform4i, (GLint location, GLint v0, GLint v1, GLint v2, GLint v3), (location, v0, v1, v2, v3))
+GL_FUNCTION(void, Uniform1fv, (GLint location, GLsizei count, const GLfloat* value), (location, count, value))
+GL_FUNCTION(void, Uniform2fv, (GLint location, GLsizei count, const GLfloat* value), (location, count, value))
+GL_FUNCTION(void, Uniform3fv, (GLint location, GLsizei count, const GLfloat* value), (location, count, value))
+GL_FUNCTION(void, Uniform4fv, (GLint location, GLsizei count, const GLfloat* value), (location, count, value))
+GL_FUNCTION(void, Uniform1iv, (GLint location, GLsizei count, const GLint* value), (location, count, value))
+GL_FUNCTION(void, Uniform2iv, (GLint location, GLsizei count, const GLint* value), (location, count, value))
+GL_FUNCTION(void, Uniform3iv, (GLint location, GLsizei count, const GLint* value), (location, count, value))
+GL_FUNCTION(void, Uniform4iv, (GLint location, GLsizei count, const GLint* value), (location, count, value))
+GL_FUNCTION(void, UniformMatrix2fv, (GLint location, GLsizei count, GLboolean transpose, const GLfloat* value), (location, count, transpose, value))
+GL_FUNCTION(void, UniformMatrix3fv, (GLint location, GLsizei count, GLboolean transpose, const GLfloat* value), (location, count, transpose, value))
+GL_FUNCTION(void, UniformMatrix4fv, (GLint location, GLsizei count, GLboolean transpose, const GLfloat* value), (location, count, transpose, value))
+GL_FUNCTION(void, ValidateProgram, (GLuint program), (program))
+GL_FUNCTION(void, VertexAttrib1d, (GLuint index, GLdouble x), (index, x))
+GL_FUNCTION(void, VertexAttrib1dv, (GLuint index, const GLdouble* v), (index, v))
+GL_FUNCTION(void, VertexAttrib1f, (GLuint index, GLfloat x), (index, x))
+GL_FUNCTION(void, VertexAttrib1fv, (GLuint index, const GLfloat* v), (index, v))
+GL_FUNCTION(void, VertexAttrib1s, (GLuint index, GLshort x), (index, x))
+GL_FUNCTION(void, VertexAttrib1sv, (GLuint index, const GLshort* v), (index, v))
+GL_FUNCTION(void, VertexAttrib2d, (GLuint index, GLdouble x, GLdouble y), (index, x, y))
+GL_FUNCTION(void, VertexAttrib2dv, (GLuint index, const GLdouble* v), (index, v))
+GL_FUNCTION(void, VertexAttrib2f, (GLuint index, GLfloat x, GLfloat y), (index, x, y))
+GL_FUNCTION(void, VertexAttrib2fv, (GLuint index, const GLfloat* v), (index, v))
+GL_FUNCTION(void, VertexAttrib2s, (GLuint index, GLshort x, GLshort y), (index, x, y))
+GL_FUNCTION(void, VertexAttrib2sv, (GLuint index, const GLshort* v), (index, v))
+GL_FUNCTION(void, VertexAttrib3d, (GLuint index, GLdouble x, GLdouble y, GLdouble z), (index, x, y, z))
+GL_FUNCTION(void, VertexAttrib3dv, (GLuint index, const GLdouble* v), (index, v))
+GL_FUNCTION(void, VertexAttrib3f, (GLuint index, GLfloat x, GLfloat y, GLfloat z), (index, x, y, z))
+GL_FUNCTION(void, VertexAttrib3fv, (GLuint index, const GLfloat* v), (index, v))
+GL_FUNCTION(void, VertexAttrib3s, (GLuint index, GLshort x, GLshort y, GLshort z), (index, x, y, z))
+GL_FUNCTION(void, VertexAttrib3sv, (GLuint index, const GLshort* v), (index, v))
+GL_FUNCTION(void, VertexAttrib4Nbv, (GLuint index, const GLbyte* v), (index, v))
+GL_FUNCTION(void, VertexAttrib4Niv, (GLuint index, const GLint* v), (index, v))
+GL_FUNCTION(void, VertexAttrib4Nsv, (GLuint index, const GLshort* v), (index, v))
+GL_FUNCTION(void, VertexAttrib4Nub, (GLuint index, GLubyte x, GLubyte y, GLubyte z, GLubyte w), (index, x, y, z, w))
+GL_FUNCTION(void, VertexAttrib4Nubv, (GLuint index, const GLubyte* v), (index, v))
+GL_FUNCTION(void, VertexAttrib4Nuiv, (GLuint index, const GLuint* v), (index, v))
+GL_FUNCTION(void, VertexAttrib4Nusv, (GLuint index, const GLushort* v), (index, v))
+GL_FUNCTION(void, VertexAttrib4bv, (GLuint index, const GLbyte* v), (index, v))
+GL_FUNCTION(void, VertexAttrib4d, (GLuint index, GLdouble x, GLdouble y, GLdouble z, GLdouble w), (index, x, y, z, w))
+GL_FUNCTION(void, VertexAttrib4dv, (GLuint index, const GLdouble* v), (index, v))
+GL_FUNCTION(void, VertexAttrib4f, (GLuint index, GLfloat x, GLfloat y, GLfloat z, GLfloat w), (index, x, y, z, w))
+GL_FUNCTION(void, VertexAttrib4fv, (GLuint index, const GLfloat* v), (index, v))
+GL_FUNCTION(void, VertexAttrib4iv, (GLuint index, const GLint* v), (index, v))
+GL_FUNCTION(void, VertexAttrib4s, (GLuint index, GLshort x, GLshort y, GLshort z, GLshort w), (index, x, y, z, w))
+GL_FUNCTION(void, VertexAttrib4sv, (GLuint index, const GLshort* v), (index, v))
+GL_FUNCTION(void, VertexAttrib4ubv, (GLuint index, const GLubyte* v), (index, v))
+GL_FUNCTION(void, VertexAttrib4uiv, (GLuint index, const GLuint* v), (index, v))
+GL_FUNCTION(void, VertexAttrib4usv, (GLuint index, const GLushort* v), (index, v))
+GL_FUNCTION(void, VertexAttribPointer, (GLuint index, GLint size, GLenum type, GLboolean normalized, GLsizei stride, const void* pointer), (index, size, type, normalized, stride, pointer))
+
+// GL 2.1
+GL_FUNCTION(void, UniformMatrix2x3fv, (GLint location, GLsizei count, GLboolean transpose, const GLfloat* value), (location, count, transpose, value))
+GL_FUNCTION(void, UniformMatrix3x2fv, (GLint location, GLsizei count, GLboolean transpose, const GLfloat* value), (location, count, transpose, value))
+GL_FUNCTION(void, UniformMatrix2x4fv, (GLint location, GLsizei count, GLboolean transpose, const GLfloat* value), (location, count, transpose, value))
+GL_FUNCTION(void, UniformMatrix4x2fv, (GLint location, GLsizei count, GLboolean transpose, const GLfloat* value), (location, count, transpose, value))
+GL_FUNCTION(void, UniformMatrix3x4fv, (GLint location, GLsizei count, GLboolean transpose, const GLfloat* value), (location, count, transpose, value))
+GL_FUNCTION(void, UniformMatrix4x3fv, (GLint location, GLsizei count, GLboolean transpose, const GLfloat* value), (location, count, transpose, value))
+
+// GL 3.0
+GL_FUNCTION(void, ColorMaski, (GLuint index, GLboolean r, GLboolean g, GLboolean b, GLboolean a), (index, r, g, b, a))
+GL_FUNCTION(void, GetBooleani_v, (GLenum target, GLuint index, GLboolean* data), (target, index, data))
+GL_FUNCTION(void, GetIntegeri_v, (GLenum target, GLuint index, GLint* data), (target, index, data))
+GL_FUNCTION(void, Enablei, (GLenum target, GLuint index), (target, index))
+GL_FUNCTION(void, Disablei, (GLenum target, GLuint index), (target, index))
+GL_FUNCTION(GLboolean, IsEnabledi, (GLenum target, GLuint index), (target, index))
+GL_FUNCTION(void, BeginTransformFeedback, (GLenum primitiveMode), (primitiveMode))
+GL_FUNCTION(void, EndTransformFeedback, (), ())
+GL_FUNCTION(void, BindBufferRange, (GLenum target, GLuint index, GLuint buffer, GLintptr offset, GLsizeiptr size), (target, index, buffer, offset, size))
+GL_FUNCTION(void, BindBufferBase, (GLenum target, GLuint index, GLuint buffer), (target, index, buffer))
+GL_FUNCTION(void, TransformFeedbackVaryings, (GLuint program, GLsizei count, const GLchar* const* varyings, GLenum bufferMode), (program, count, varyings, bufferMode))
+GL_FUNCTION(void, GetTransformFeedbackVarying, (GLuint program, GLuint index, GLsizei bufSize, GLsizei* length, GLsizei* size, GLenum* type, GLchar* name), (program, index, bufSize, length, size, type, name))
+GL_FUNCTION(void, ClampColor, (GLenum target, GLenum clamp), (target, clamp))
+GL_FUNCTION(void, BeginConditionalRender, (GLuint id, GLenum mode), (id, mode))
+GL_FUNCTION(void, EndConditionalRender, (), ())
+GL_FUNCTION(void, VertexAttribIPointer, (GLuint index, GLint size, GLenum type, GLsizei stride, const void* pointer), (index, size, type, stride, pointer))
+GL_FUNCTION(void, GetVertexAttribIiv, (GLuint index, GLenum pname, GLint* params), (index, pname, params))
+GL_FUNCTION(void, GetVertexAttribIuiv, (GLuint index, GLenum pname, GLuint* params), (index, pname, params))
+GL_FUNCTION(void, VertexAttribI1i, (GLuint index, GLint x), (index, x))
+GL_FUNCTION(void, VertexAttribI2i, (GLuint index, GLint x, GLint y), (index, x, y))
+GL_FUNCTION(void, VertexAttribI3i, (GLuint index, GLint x, GLint y, GLint z), (index, x, y, z))
+GL_FUNCTION(void, VertexAttribI4i, (GLuint index, GLint x, GLint y, GLint z, GLint w), (index, x, y, z, w))
+GL_FUNCTION(void, VertexAttribI1ui, (GLuint index, GLuint x), (index, x))
+GL_FUNCTION(void, VertexAttribI2ui, (GLuint index, GLuint x, GLuint y), (index, x, y))
+GL_FUNCTION(void, VertexAttribI3ui, (GLuint index, GLuint x, GLuint y, GLuint z), (index, x, y, z))
+GL_FUNCTION(void, VertexAttribI4ui, (GLuint index, GLuint x, GLuint y, GLuint z, GLuint w), (index, x, y, z, w))
+GL_FUNCTION(void, VertexAttribI1iv, (GLuint index, const GLint* v), (index, v))
+GL_FUNCTION(void, VertexAttribI2iv, (GLuint index, const GLint* v), (index, v))
+GL_FUNCTION(void, VertexAttribI3iv, (GLuint index, const GLint* v), (index, v))
+GL_FUNCTION(void, VertexAttribI4iv, (GLuint index, const GLint* v), (index, v))
+GL_FUNCTION(void, VertexAttribI1uiv, (GLuint index, const GLuint* v), (index, v))
+GL_FUNCTION(void, VertexAttribI2uiv, (GLuint index, const GLuint* v), (index, v))
+GL_FUNCTION(void, VertexAttribI3uiv, (GLuint index, const GLuint* v), (index, v))
+GL_FUNCTION(void, VertexAttribI4uiv, (GLuint index, const GLuint* v), (index, v))
+GL_FUNCTION(void, VertexAttribI4bv, (GLuint index, const GLbyte* v), (index, v))
+GL_FUNCTION(void, VertexAttribI4sv, (GLuint index, const GLshort* v), (index, v))
+GL_FUNCTION(void, VertexAttribI4ubv, (GLuint index, const GLubyte* v), (index, v))
+GL_FUNCTION(void, VertexAttribI4usv, (GLuint index, const GLushort* v), (index, v))
+GL_FUNCTION(void, GetUniformuiv, (GLuint program, GLint location, GLuint* params), (program, location, params))
+GL_FUNCTION(void, BindFragDataLocation, (GLuint program, GLuint color, const GLchar* name), (program, color, name))
+GL_FUNCTION(GLint, GetFragDataLocation, (GLuint program, const GLchar* name), (program, name))
+GL_FUNCTION(void, Uniform1ui, (GLint location, GLuint v0), (location, v0))
+GL_FUNCTION(void, Uniform2ui, (GLint location, GLuint v0, GLuint v1), (location, v0, v1))
+GL_FUNCTION(void, Uniform3ui, (GLint location, GLuint v0, GLuint v1, GLuint v2), (location, v0, v1, v2))
+GL_FUNCTION(void, Uniform4ui, (GLint location, GLuint v0, GLuint v1, GLuint v2, GLuint v3), (location, v0, v1, v2, v3))
+GL_FUNCTION(void, Uniform1uiv, (GLint location, GLsizei count, const GLuint* value), (location, count, value))
+GL_FUNCTION(void, Uniform2uiv, (GLint location, GLsizei count, const GLuint* value), (location, count, value))
+GL_FUNCTION(void, Uniform3uiv, (GLint location, GLsizei count, const GLuint* value), (location, count, value))
+GL_FUNCTION(void, Uniform4uiv, (GLint location, GLsizei count, const GLuint* value), (location, count, value))
+GL_FUNCTION(void, TexParameterIiv, (GLenum target, GLenum pname, const GLint* params), (target, pname, params))
+GL_FUNCTION(void, TexParameterIuiv, (GLenum target, GLenum pname, const GLuint* params), (target, pname, params))
+GL_FUNCTION(void, GetTexParameterIiv, (GLenum target, GLenum pname, GLint* params), (target, pname, params))
+GL_FUNCTION(void, GetTexParameterIuiv, (GLenum target, GLenum pname, GLuint* params), (target, pname, params))
+GL_FUNCTION(void, ClearBufferiv, (GLenum buffer, GLint drawbuffer, const GLint* value), (buffer, drawbuffer, value))
+GL_FUNCTION(void, ClearBufferuiv, (GLenum buffer, GLint drawbuffer, const GLuint* value), (buffer, drawbuffer, value))
+GL_FUNCTION(void, ClearBufferfv, (GLenum buffer, GLint drawbuffer, const GLfloat* value), (buffer, drawbuffer, value))
+GL_FUNCTION(void, ClearBufferfi, (GLenum buffer, GLint drawbuffer, GLfloat depth, GLint stencil), (buffer, drawbuffer, depth, stencil))
+GL_FUNCTION(const GLubyte*, GetStringi, (GLenum name, GLuint index), (name, index))
+GL_FUNCTION(GLboolean, IsRenderbuffer, (GLuint renderbuffer), (renderbuffer))
+GL_FUNCTION(void, BindRenderbuffer, (GLenum target, GLuint renderbuffer), (target, renderbuffer))
+GL_FUNCTION(void, DeleteRenderbuffers, (GLsizei n, const GLuint* renderbuffers), (n, renderbuffers))
+GL_FUNCTION(void, GenRenderbuffers, (GLsizei n, GLuint* renderbuffers), (n, renderbuffers))
+GL_FUNCTION(void, RenderbufferStorage, (GLenum target, GLenum internalformat, GLsizei width, GLsizei height), (target, internalformat, width, height))
+GL_FUNCTION(void, GetRenderbufferParameteriv, (GLenum target, GLenum pname, GLint* params), (target, pname, params))
+GL_FUNCTION(GLboolean, IsFramebuffer, (GLuint framebuffer), (framebuffer))
+GL_FUNCTION(void, BindFramebuffer, (GLenum target, GLuint framebuffer), (target, framebuffer))
+GL_FUNCTION(void, DeleteFramebuffers, (GLsizei n, const GLuint* framebuffers), (n, framebuffers))
+GL_FUNCTION(void, GenFramebuffers, (GLsizei n, GLuint* framebuffers), (n, framebuffers))
+GL_FUNCTION(GLenum, CheckFramebufferStatus, (GLenum target), (target))
+GL_FUNCTION(void, FramebufferTexture1D, (GLenum target, GLenum attachment, GLenum textarget, GLuint texture, GLint level), (target, attachment, textarget, texture, level))
+GL_FUNCTION(void, FramebufferTexture2D, (GLenum target, GLenum attachment, GLenum textarget, GLuint texture, GLint level), (target, attachment, textarget, texture, level))
+GL_FUNCTION(void, FramebufferTexture3D, (GLenum target, GLenum attachment, GLenum textarget, GLuint texture, GLint level, GLint zoffset), (target, attachment, textarget, texture, level, zoffset))
+GL_FUNCTION(void, FramebufferRenderbuffer, (GLenum target, GLenum attachment, GLenum renderbuffertarget, GLuint renderbuffer), (target, attachment, renderbuffertarget, renderbuffer))
+GL_FUNCTION(void, GetFramebufferAttachmentParameteriv, (GLenum target, GLenum attachment, GLenum pname, GLint* params), (target, attachment, pname, params))
+GL_FUNCTION(void, GenerateMipmap, (GLenum target), (target))
+GL_FUNCTION(void, BlitFramebuffer, (GLint srcX0, GLint srcY0, GLint srcX1, GLint srcY1, GLint dstX0, GLint dstY0, GLint dstX1, GLint dstY1, GLbitfield mask, GLenum filter), (srcX0, srcY0, srcX1, srcY1, dstX0, dstY0, dstX1, dstY1, mask, filter))
+GL_FUNCTION(void, RenderbufferStorageMultisample, (GLenum target, GLsizei samples, GLenum internalformat, GLsizei width, GLsizei height), (target, samples, internalformat, width, height))
+GL_FUNCTION(void, FramebufferTextureLayer, (GLenum target, GLenum attachment, GLuint texture, GLint level, GLint layer), (target, attachment, texture, level, layer))
+GL_FUNCTION(void*, MapBufferRange, (GLenum target, GLintptr offset, GLsizeiptr length, GLbitfield access), (target, offset, length, access))
+GL_FUNCTION(void, FlushMappedBufferRange, (GLenum target, GLintptr offset, GLsizeiptr length), (target, offset, length))
+GL_FUNCTION(void, BindVertexArray, (GLuint array), (array))
+GL_FUNCTION(void, DeleteVertexArrays, (GLsizei n, const GLuint* arrays), (n, arrays))
+GL_FUNCTION(void, GenVertexArrays, (GLsizei n, GLuint* arrays), (n, arrays))
+GL_FUNCTION(GLboolean, IsVertexArray, (GLuint array), (array))
+
+// GL 3.1
+GL_FUNCTION(void, DrawArraysInstanced, (GLenum mode, GLint first, GLsizei count, GLsizei instancecount), (mode, first, count, instancecount))
+GL_FUNCTION(void, DrawElementsInstanced, (GLenum mode, GLsizei count, GLenum type, const void* indices, GLsizei instancecount), (mode, count, type, indices, instancecount))
+GL_FUNCTION(void, TexBuffer, (GLenum target, GLenum internalformat, GLuint buffer), (target, internalformat, buffer))
+GL_FUNCTION(void, PrimitiveRestartIndex, (GLuint index), (index))
+GL_FUNCTION(void, CopyBufferSubData, (GLenum readTarget, GLenum writeTarget, GLintptr readOffset, GLintptr writeOffset, GLsizeiptr size), (readTarget, writeTarget, readOffset, writeOffset, size))
+GL_FUNCTION(void, GetUniformIndices, (GLuint program, GLsizei uniformCount, const GLchar* const* uniformNames, GLuint* uniformIndices), (program, uniformCount, uniformNames, uniformIndices))
+GL_FUNCTION(void, GetActiveUniformsiv, (GLuint program, GLsizei uniformCount, const GLuint* uniformIndices, GLenum pname, GLint* params), (program, uniformCount, uniformIndices, pname, params))
+GL_FUNCTION(void, GetActiveUniformName, (GLuint program, GLuint uniformIndex, GLsizei bufSize, GLsizei* length, GLchar* uniformName), (program, uniformIndex, bufSize, length, uniformName))
+GL_FUNCTION(GLuint, GetUniformBlockIndex, (GLuint program, const GLchar* uniformBlockName), (program, uniformBlockName))
+GL_FUNCTION(void, GetActiveUniformBlockiv, (GLuint program, GLuint uniformBlockIndex, GLenum pname, GLint* params), (program, uniformBlockIndex, pname, params))
+GL_FUNCTION(void, GetActiveUniformBlockName, (GLuint program, GLuint uniformBlockIndex, GLsizei bufSize, GLsizei* length, GLchar* uniformBlockName), (program, uniformBlockIndex, bufSize, length, uniformBlockName))
+GL_FUNCTION(void, UniformBlockBinding, (GLuint program, GLuint uniformBlockIndex, GLuint uniformBlockBinding), (program, uniformBlockIndex, uniformBlockBinding))
+
+// GL 3.2
+GL_FUNCTION(void, DrawElementsBaseVertex, (GLenum mode, GLsizei count, GLenum type, const void* indices, GLint basevertex), (mode, count, type, indices, basevertex))
+GL_FUNCTION(void, DrawRangeElementsBaseVertex, (GLenum mode, GLuint start, GLuint end, GLsizei count, GLenum type, const void* indices, GLint basevertex), (mode, start, end, count, type, indices, basevertex))
+GL_FUNCTION(void, DrawElementsInstancedBaseVertex, (GLenum mode, GLsizei count, GLenum type, const void* indices, GLsizei instancecount, GLint basevertex), (mode, count, type, indices, instancecount, basevertex))
+GL_FUNCTION(void, MultiDrawElementsBaseVertex, (GLenum mode, const GLsizei* count, GLenum type, const void* const* indices, GLsizei drawcount, const GLint* basevertex), (mode, count, type, indices, drawcount, basevertex))
+GL_FUNCTION(void, ProvokingVertex, (GLenum mode), (mode))
+GL_FUNCTION(GLsync, FenceSync, (GLenum condition, GLbitfield flags), (condition, flags))
+GL_FUNCTION(GLboolean, IsSync, (GLsync sync), (sync))
+GL_FUNCTION(void, DeleteSync, (GLsync sync), (sync))
+GL_FUNCTION(GLenum, ClientWaitSync, (GLsync sync, GLbitfield flags, GLuint64 timeout), (sync, flags, timeout))
+GL_FUNCTION(void, WaitSync, (GLsync sync, GLbitfield flags, GLuint64 timeout), (sync, flags, timeout))
+GL_FUNCTION(void, GetInteger64v, (GLenum pname, GLint64* data), (pname, data))
+GL_FUNCTION(void, GetSynciv, (GLsync sync, GLenum pname, GLsizei count, GLsizei* length, GLint* values), (sync, pname, count, length, values))
+GL_FUNCTION(void, GetInteger64i_v, (GLenum target, GLuint index, GLint64* data), (target, index, data))
+GL_FUNCTION(void, GetBufferParameteri64v, (GLenum target, GLenum pname, GLint64* params), (target, pname, params))
+GL_FUNCTION(void, FramebufferTexture, (GLenum target, GLenum attachment, GLuint texture, GLint level), (target, attachment, texture, level))
+GL_FUNCTION(void, TexImage2DMultisample, (GLenum target, GLsizei samples, GLenum internalformat, GLsizei width, GLsizei height, GLboolean fixedsamplelocations), (target, samples, internalformat, width, height, fixedsamplelocations))
+GL_FUNCTION(void, TexImage3DMultisample, (GLenum target, GLsizei samples, GLenum internalformat, GLsizei width, GLsizei height, GLsizei depth, GLboolean fixedsamplelocations), (target, samples, internalformat, width, height, depth, fixedsamplelocations))
+GL_FUNCTION(void, GetMultisamplefv, (GLenum pname, GLuint index, GLfloat* val), (pname, index, val))
+GL_FUNCTION(void, SampleMaski, (GLuint maskNumber, GLbitfield mask), (maskNumber, mask))
+
+// GL 3.3
+GL_FUNCTION(void, BindFragDataLocationIndexed, (GLuint program, GLuint colorNumber, GLuint index, const GLchar* name), (program, colorNumber, index, name))
+GL_FUNCTION(GLint, GetFragDataIndex, (GLuint program, const GLchar* name), (program, name))
+GL_FUNCTION(void, GenSamplers, (GLsizei count, GLuint* samplers), (count, samplers))
+GL_FUNCTION(void, DeleteSamplers, (GLsizei count, const GLuint* samplers), (count, samplers))
+GL_FUNCTION(GLboolean, IsSampler, (GLuint sampler), (sampler))
+GL_FUNCTION(void, BindSampler, (GLuint unit, GLuint sampler), (unit, sampler))
+GL_FUNCTION(void, SamplerParameteri, (GLuint sampler, GLenum pname, GLint param), (sampler, pname, param))
+GL_FUNCTION(void, SamplerParameteriv, (GLuint sampler, GLenum pname, const GLint* param), (sampler, pname, param))
+GL_FUNCTION(void, SamplerParameterf, (GLuint sampler, GLenum pname, GLfloat param), (sampler, pname, param))
+GL_FUNCTION(void, SamplerParameterfv, (GLuint sampler, GLenum pname, const GLfloat* param), (sampler, pname, param))
+GL_FUNCTION(void, SamplerParameterIiv, (GLuint sampler, GLenum pname, const GLint* param), (sampler, pname, param))
+GL_FUNCTION(void, SamplerParameterIuiv, (GLuint sampler, GLenum pname, const GLuint* param), (sampler, pname, param))
+GL_FUNCTION(void, GetSamplerParameteriv, (GLuint sampler, GLenum pname, GLint* params), (sampler, pname, params))
+GL_FUNCTION(void, GetSamplerParameterIiv, (GLuint sampler, GLenum pname, GLint* params), (sampler, pname, params))
+GL_FUNCTION(void, GetSamplerParameterfv, (GLuint sampler, GLenum pname, GLfloat* params), (sampler, pname, params))
+GL_FUNCTION(void, GetSamplerParameterIuiv, (GLuint sampler, GLenum pname, GLuint* params), (sampler, pname, params))
+GL_FUNCTION(void, QueryCounter, (GLuint id, GLenum target), (id, target))
+GL_FUNCTION(void, GetQueryObjecti64v, (GLuint id, GLenum pname, GLint64* params), (id, pname, params))
+GL_FUNCTION(void, GetQueryObjectui64v, (GLuint id, GLenum pname, GLuint64* params), (id, pname, params))
+GL_FUNCTION(void, VertexAttribDivisor, (GLuint index, GLuint divisor), (index, divisor))
+GL_FUNCTION(void, VertexAttribP1ui, (GLuint index, GLenum type, GLboolean normalized, GLuint value), (index, type, normalized, value))
+GL_FUNCTION(void, VertexAttribP1uiv, (GLuint index, GLenum type, GLboolean normalized, const GLuint* value), (index, type, normalized, value))
+GL_FUNCTION(void, VertexAttribP2ui, (GLuint index, GLenum type, GLboolean normalized, GLuint value), (index, type, normalized, value))
+GL_FUNCTION(void, VertexAttribP2uiv, (GLuint index, GLenum type, GLboolean normalized, const GLuint* value), (index, type, normalized, value))
+GL_FUNCTION(void, VertexAttribP3ui, (GLuint index, GLenum type, GLboolean normalized, GLuint value), (index, type, normalized, value))
+GL_FUNCTION(void, VertexAttribP3uiv, (GLuint index, GLenum type, GLboolean normalized, const GLuint* value), (index, type, normalized, value))
+GL_FUNCTION(void, VertexAttribP4ui, (GLuint index, GLenum type, GLboolean normalized, GLuint value), (index, type, normalized, value))
+GL_FUNCTION(void, VertexAttribP4uiv, (GLuint index, GLenum type, GLboolean normalized, const GLuint* value), (index, type, normalized, value))
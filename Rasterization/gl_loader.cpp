@@ -0,0 +1,96 @@
+#include "gl_loader.h"
+
+#include <atomic>
+#include <chrono>
+#include <iostream>
+
+using namespace std;
+
+typedef chrono::high_resolution_clock Clock;
+
+static GLADloadproc loader = nullptr;
+static atomic<size_t> resolvedCount{ 0 };
+static atomic<size_t> missingCalls{ 0 };
+static atomic<int64_t> resolveNanoseconds{ 0 };
+
+// points *pointer at the driver's name, false when there is none
+static bool resolve(void** pointer, const char* name)
+{
+	auto start = Clock::now();
+	void* address = loader ? loader(name) : nullptr;
+	resolveNanoseconds += chrono::duration_cast<chrono::nanoseconds>(Clock::now() - start).count();
+	if (!address)
+	{
+		cout << "ERROR::GL_LOADER::FUNCTION_NOT_FOUND " << name << endl;
+		return false;
+	}
+	*pointer = address;
+	return true;
+}
+
+// a stub per function: looks it up, then calls it through the pointer it
+// just set. glad.h declares the pointers, here they are defined.
+#define GL_FUNCTION(type, name, parameters, arguments) \
+	static type APIENTRY lazy_gl##name parameters \
+	{ \
+		if (!resolve((void**)&glad_gl##name, "gl" #name)) \
+		{ \
+			missingCalls++; \
+			return (type)0; \
+		} \
+		resolvedCount++; \
+		return glad_gl##name arguments; \
+	} \
+	decltype(glad_gl##name) glad_gl##name = lazy_gl##name;
+#include "gl_functions.h"
+#undef GL_FUNCTION
+
+struct LazyFunction
+{
+	const char* name;
+	void** pointer;
+	void* stub;
+};
+
+static const LazyFunction lazyFunctions[] =
+{
+#define GL_FUNCTION(type, name, parameters, arguments) { "gl" #name, (void**)&glad_gl##name, (void*)&lazy_gl##name },
+#include "gl_functions.h"
+#undef GL_FUNCTION
+};
+
+bool loadGL(GLADloadproc load, bool eager)
+{
+	loader = load;
+	if (!load || !load("glGetString"))
+		return false;
+	if (eager)
+	{
+		// what glad does: every function, used or not, missing ones left at
+		// their stubs to report themselves when called
+		for (const LazyFunction& function : lazyFunctions)
+		{
+			if (*function.pointer != function.stub)
+				continue;
+			auto start = Clock::now();
+			void* address = load(function.name);
+			resolveNanoseconds += chrono::duration_cast<chrono::nanoseconds>(Clock::now() - start).count();
+			if (address)
+			{
+				*function.pointer = address;
+				resolvedCount++;
+			}
+		}
+	}
+	return true;
+}
+
+GLLoaderStats glLoaderStats()
+{
+	GLLoaderStats stats;
+	stats.functions = sizeof(lazyFunctions) / sizeof(lazyFunctions[0]);
+	stats.resolved = resolvedCount.load();
+	stats.missingCalls = missingCalls.load();
+	stats.resolveMilliseconds = resolveNanoseconds.load() / 1e6;
+	return stats;
+}
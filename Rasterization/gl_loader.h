@@ -0,0 +1,34 @@
+#ifndef GL_LOADER_H
+#define GL_LOADER_H
+
+#include <cstddef>
+
+#include <glad/glad.h>
+
+// Takes the place of glad.c behind glad.h. glad's loader looks up all of
+// the ~350 core entry points before the first GL call, most of which the
+// program never makes; here each glad_gl* pointer starts out at a stub that
+// looks its function up on the first call, points the pointer at it and
+// calls it, so later calls go straight to the driver and startup only pays
+// for the functions it uses.
+//
+// Threads with shared contexts may hit the same stub at once: both look up
+// the same address and store it, which is harmless. A function the driver
+// doesn't have reports ERROR::GL_LOADER::FUNCTION_NOT_FOUND on every call
+// and does nothing, returning 0.
+
+// load is called with the context current from then on, and must keep
+// working; eager looks every function up now instead, like glad. Checks that
+// the loader finds glGetString, false when it doesn't.
+bool loadGL(GLADloadproc load, bool eager = false);
+
+struct GLLoaderStats
+{
+	size_t functions = 0;		// in gl_functions.h
+	size_t resolved = 0;		// looked up so far
+	size_t missingCalls = 0;	// calls to functions the driver doesn't have
+	double resolveMilliseconds = 0.0;
+};
+GLLoaderStats glLoaderStats();
+
+#endif
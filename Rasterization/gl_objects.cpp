@@ -0,0 +1,141 @@
+#include "gl_objects.h"
+#include "gpu_memory.h"
+
+#include <algorithm>
+
+using namespace std;
+
+GLObjectPool glObjects;
+
+GLuint GLObjectPool::generate(GLObjectKind kind)
+{
+	if (kind == GL_OBJECT_KIND_PROGRAM)
+	{
+		counters.generated++;
+		return glCreateProgram();
+	}
+
+	vector<GLuint>& names = pooled[kind];
+	if (names.empty())
+	{
+		names.resize(BLOCK_SIZE);
+		switch (kind)
+		{
+		case GL_OBJECT_KIND_BUFFER: glGenBuffers(BLOCK_SIZE, names.data()); break;
+		case GL_OBJECT_KIND_VERTEX_ARRAY: glGenVertexArrays(BLOCK_SIZE, names.data()); break;
+		case GL_OBJECT_KIND_TEXTURE: glGenTextures(BLOCK_SIZE, names.data()); break;
+		case GL_OBJECT_KIND_FRAMEBUFFER: glGenFramebuffers(BLOCK_SIZE, names.data()); break;
+		default: break;
+		}
+		counters.genCalls++;
+		released = false;
+	}
+	GLuint name = names.back();
+	names.pop_back();
+	counters.generated++;
+	return name;
+}
+
+void GLObjectPool::retire(GLObjectKind kind, GLuint name)
+{
+	if (released)
+		return;
+	current.names[kind].push_back(name);
+	counters.retired++;
+}
+
+void GLObjectPool::deleteNames(GLObjectKind kind, vector<GLuint>& names)
+{
+	if (names.empty())
+		return;
+	const GLsizei count = (GLsizei)names.size();
+	for (GLuint name : names)
+	{
+		if (kind == GL_OBJECT_KIND_BUFFER)
+			gpuMemory.forgetBuffer(name);
+		else if (kind == GL_OBJECT_KIND_TEXTURE)
+			gpuMemory.forgetTexture(name);
+	}
+	switch (kind)
+	{
+	case GL_OBJECT_KIND_BUFFER: glDeleteBuffers(count, names.data()); break;
+	case GL_OBJECT_KIND_VERTEX_ARRAY: glDeleteVertexArrays(count, names.data()); break;
+	case GL_OBJECT_KIND_TEXTURE: glDeleteTextures(count, names.data()); break;
+	case GL_OBJECT_KIND_FRAMEBUFFER: glDeleteFramebuffers(count, names.data()); break;
+	case GL_OBJECT_KIND_PROGRAM:
+		for (GLuint name : names)
+			glDeleteProgram(name);
+		break;
+	default: break;
+	}
+	counters.deleted += names.size();
+	counters.deleteCalls += kind == GL_OBJECT_KIND_PROGRAM ? names.size() : 1;
+	names.clear();
+}
+
+void GLObjectPool::deleteFrame(Frame& frame)
+{
+	for (int kind = 0; kind < GL_OBJECT_KIND_COUNT; kind++)
+		deleteNames((GLObjectKind)kind, frame.names[kind]);
+	if (frame.fence)
+		glDeleteSync(frame.fence);
+	frame.fence = 0;
+}
+
+void GLObjectPool::endFrame()
+{
+	bool retiredAny = false;
+	for (const vector<GLuint>& names : current.names)
+		retiredAny = retiredAny || !names.empty();
+	if (retiredAny)
+	{
+		if (inFlightCount == inFlight.size())
+		{
+			rotate(inFlight.begin(), inFlight.begin() + head, inFlight.end());
+			head = 0;
+			inFlight.emplace_back();
+		}
+		current.fence = glFenceSync(GL_SYNC_GPU_COMMANDS_COMPLETE, 0);
+		// current takes over the slot's emptied vectors
+		swap(current, inFlight[(head + inFlightCount) % inFlight.size()]);
+		inFlightCount++;
+	}
+
+	// frames finish in order, so stop at the first one still running
+	while (inFlightCount > 0)
+	{
+		GLenum status = glClientWaitSync(inFlight[head].fence, 0, 0);
+		if (status != GL_ALREADY_SIGNALED && status != GL_CONDITION_SATISFIED)
+			break;
+		deleteFrame(inFlight[head]);
+		head = (head + 1) % inFlight.size();
+		inFlightCount--;
+	}
+}
+
+void GLObjectPool::release()
+{
+	for (Frame& frame : inFlight)
+		deleteFrame(frame);
+	inFlight.clear();
+	head = inFlightCount = 0;
+	deleteFrame(current);
+	// pooled names were never bound, so never became objects, but they are
+	// still reserved
+	for (int kind = 0; kind < GL_OBJECT_KIND_COUNT; kind++)
+		deleteNames((GLObjectKind)kind, pooled[kind]);
+	released = true;
+}
+
+size_t GLObjectPool::pendingCount() const
+{
+	size_t count = 0;
+	for (const vector<GLuint>& names : current.names)
+		count += names.size();
+	for (const Frame& frame : inFlight)
+	{
+		for (const vector<GLuint>& names : frame.names)
+			count += names.size();
+	}
+	return count;
+}
@@ -0,0 +1,133 @@
+#ifndef GL_OBJECTS_H
+#define GL_OBJECTS_H
+
+#include <cstddef>
+#include <vector>
+
+#include <glad/glad.h>
+
+enum GLObjectKind
+{
+	GL_OBJECT_KIND_BUFFER,
+	GL_OBJECT_KIND_VERTEX_ARRAY,
+	GL_OBJECT_KIND_TEXTURE,
+	GL_OBJECT_KIND_FRAMEBUFFER,
+	GL_OBJECT_KIND_PROGRAM,
+	GL_OBJECT_KIND_COUNT
+};
+
+// Names and deletion for the main context's objects, render thread only.
+// generate() hands out names glGen*'d in blocks, so creating an object
+// costs no call into the driver until it is bound. retire() doesn't delete:
+// names retired during a frame are deleted together once the fence placed
+// by that frame's endFrame() has signaled, so a driver never has to stall
+// on an object that queued draws still use, and one glDelete* call frees a
+// whole frame's worth.
+class GLObjectPool
+{
+public:
+	// names pre-generated per glGen* call
+	static const int BLOCK_SIZE = 32;
+
+	// glCreateProgram for programs, which can't be generated ahead
+	GLuint generate(GLObjectKind kind);
+	void retire(GLObjectKind kind, GLuint name);
+
+	// fences the frame's retired names and deletes those of earlier frames
+	// whose fence signaled; call once per frame, before swapping
+	void endFrame();
+
+	// deletes everything now, pooled names included; call with the context
+	// still current, before glfwTerminate(). Names retired afterwards are
+	// dropped, they went away with the context.
+	void release();
+
+	struct Stats
+	{
+		unsigned long long generated = 0;
+		unsigned long long genCalls = 0;		// glGen* calls for blocks
+		unsigned long long retired = 0;
+		unsigned long long deleted = 0;
+		unsigned long long deleteCalls = 0;
+	};
+	const Stats& stats() const { return counters; }
+	// names retired but not deleted yet
+	size_t pendingCount() const;
+
+private:
+	struct Frame
+	{
+		GLsync fence = 0;
+		std::vector<GLuint> names[GL_OBJECT_KIND_COUNT];
+	};
+
+	void deleteNames(GLObjectKind kind, std::vector<GLuint>& names);
+	void deleteFrame(Frame& frame);
+
+	std::vector<GLuint> pooled[GL_OBJECT_KIND_COUNT];
+	Frame current;
+	// fenced frames, oldest at head; a ring so that steady state frames
+	// reuse the vectors of earlier ones instead of allocating
+	std::vector<Frame> inFlight;
+	size_t head = 0;
+	size_t inFlightCount = 0;
+	bool released = false;
+
+	Stats counters;
+};
+
+extern GLObjectPool glObjects;
+
+// A move-only owner of one GL name, retired to glObjects when it goes out
+// of scope or is reset. Must be reset, or released by glObjects.release(),
+// before the context goes away.
+template<GLObjectKind kind>
+class GLHandle
+{
+public:
+	GLHandle() = default;
+	// takes ownership of a name from elsewhere, e.g. buildProgram()
+	explicit GLHandle(GLuint owned) : name(owned) {}
+	~GLHandle() { reset(); }
+
+	GLHandle(GLHandle&& other) noexcept : name(other.release()) {}
+	GLHandle& operator=(GLHandle&& other) noexcept
+	{
+		if (this != &other)
+			reset(other.release());
+		return *this;
+	}
+	GLHandle(const GLHandle&) = delete;
+	GLHandle& operator=(const GLHandle&) = delete;
+
+	static GLHandle create() { return GLHandle(glObjects.generate(kind)); }
+
+	GLuint get() const { return name; }
+	explicit operator bool() const { return name != 0; }
+
+	// gives up ownership without deleting
+	GLuint release()
+	{
+		GLuint owned = name;
+		name = 0;
+		return owned;
+	}
+
+	void reset(GLuint owned = 0)
+	{
+		if (name)
+			glObjects.retire(kind, name);
+		name = owned;
+	}
+
+private:
+	GLuint name = 0;
+};
+
+typedef GLHandle<GL_OBJECT_KIND_BUFFER> GLBuffer;
+typedef GLHandle<GL_OBJECT_KIND_VERTEX_ARRAY> GLVertexArray;
+typedef GLHandle<GL_OBJECT_KIND_TEXTURE> GLTexture;
+typedef GLHandle<GL_OBJECT_KIND_FRAMEBUFFER> GLFramebuffer;
+typedef GLHandle<GL_OBJECT_KIND_PROGRAM> GLProgram;
+
+#endif
@@ -0,0 +1,102 @@
+#include "benchmarks.h"
+#include "image_compare.h"
+#include "soft_shader.h"
+
+#include <algorithm>
+#include <filesystem>
+#include <iostream>
+
+using namespace std;
+namespace fs = std::filesystem;
+
+// a frame passes with a few edge pixels off, not with a shifted or recolored triangle
+static const int GOLDEN_TOLERANCE = 2;
+static const double GOLDEN_MAX_DIFFERING = 0.001;	// of the pixels
+static const double GOLDEN_MIN_PSNR = 40.0;
+static const double GOLDEN_MAX_MEAN_FLIP = 0.01;
+
+// what main() draws: the clear color (0.2, 0.3, 0.3 as GL stores it) and the
+// triangle with variant 0
+static bool renderReference(const ShaderProgramDesc& triangleDesc, const float* vertices, int vertexCount,
+	int width, int height, RgbaImage& image)
+{
+	SoftProgram program;
+	string log;
+	if (!program.build(triangleDesc, 0, &log))
+	{
+		cout << "ERROR::GOLDEN::CPU_BUILD_FAILED\n" << log << endl;
+		return false;
+	}
+	SoftFramebuffer framebuffer;
+	framebuffer.resize(width, height);
+	framebuffer.clear(packRGBA8(51, 76, 76, 255));
+	SoftRasterizer rasterizer;
+	rasterizer.setTarget(&framebuffer);
+	SoftVertexArray input;
+	input.attributes[0] = { vertices, 3, 3 };
+	SoftVertexBuffer clip;
+	program.runVertexShader(input, vertexCount, 0, clip);
+	rasterizer.drawTriangles(clip, nullptr, 0, program);
+
+	image.resize(width, height);
+	for (int y = 0; y < height; y++)
+		copy(framebuffer.row(y), framebuffer.row(y) + width, image.row(y));
+	return true;
+}
+
+int runGoldenTest(const ShaderProgramDesc& triangleDesc, const float* vertices, int vertexCount,
+	int width, int height, const string& name, bool update)
+{
+	// the back buffer before the swap, bottom row first
+	RgbaImage frame;
+	frame.resize(width, height);
+	glPixelStorei(GL_PACK_ALIGNMENT, 4);
+	glReadBuffer(GL_BACK);
+	glReadPixels(0, 0, width, height, GL_RGBA, GL_UNSIGNED_BYTE, frame.pixels.data());
+
+	const string directory = "golden";
+	const string referencePath = directory + "/" + name + ".ppm";
+	error_code error;
+	fs::create_directories(directory, error);
+	if (update)
+	{
+		if (!writePPM(referencePath, frame))
+		{
+			cout << "ERROR::GOLDEN::WRITE_FAILED " << referencePath << endl;
+			return 1;
+		}
+		cout << "Golden image " << referencePath << " updated" << endl;
+		return 0;
+	}
+
+	RgbaImage reference;
+	string referenceName = referencePath;
+	if (!readPPM(referencePath, reference))
+	{
+		referenceName = "the CPU rasterizer";
+		if (!renderReference(triangleDesc, vertices, vertexCount, width, height, reference))
+			return 1;
+	}
+
+	ImageComparison result;
+	if (!compareImages(frame, reference, GOLDEN_TOLERANCE, result))
+	{
+		cout << "ERROR::GOLDEN::SIZE_MISMATCH " << width << "x" << height << " against "
+			<< reference.width << "x" << reference.height << " in " << referenceName << endl;
+		return 1;
+	}
+	cout << "Golden image: " << width << "x" << height << " against " << referenceName << ", "
+		<< result.differingPixels << " pixels off by more than " << GOLDEN_TOLERANCE
+		<< " (largest " << result.largestDifference << "), PSNR " << result.psnr << " dB, FLIP mean "
+		<< result.meanFlip << " max " << result.maxFlip << endl;
+
+	if (result.differingPixels <= GOLDEN_MAX_DIFFERING * width * height && result.psnr >= GOLDEN_MIN_PSNR
+		&& result.meanFlip <= GOLDEN_MAX_MEAN_FLIP)
+		return 0;
+	const string diffPath = directory + "/" + name + ".diff.ppm";
+	const string framePath = directory + "/" + name + ".actual.ppm";
+	writePPM(diffPath, result.diff);
+	writePPM(framePath, frame);
+	cout << "ERROR::GOLDEN::IMAGE_CHANGED see " << diffPath << " and " << framePath << endl;
+	return 1;
+}
@@ -0,0 +1,275 @@
+#include "gpu_culling.h"
+#include "gl_ext.h"
+#include "gpu_memory.h"
+#include "shader_preprocessor.h"
+#include "shader_utils.h"
+
+#include <algorithm>
+#include <iostream>
+
+using namespace std;
+
+// binding points shared with cull.comp / object.vert
+static const GLuint OBJECTS_BINDING = 0;
+static const GLuint COMMANDS_BINDING = 1;
+static const GLuint COUNT_BINDING = 2;
+// object.vert's per-instance object index
+static const GLuint OBJECT_INDEX_LOCATION = 2;
+static const GLuint CULL_GROUP_SIZE = 64;
+
+struct DrawArraysIndirectCommand
+{
+	GLuint count;
+	GLuint instanceCount;
+	GLuint first;
+	GLuint baseInstance;
+};
+
+GpuCuller::~GpuCuller()
+{
+	release();
+}
+
+bool GpuCuller::supported()
+{
+	return glext.compute && glext.shaderStorage;
+}
+
+bool GpuCuller::init(const string& computePath, GLuint vertexBuffer, GLsizei vertexCount, int maxObjects)
+{
+	release();
+	if (!supported())
+	{
+		cout << "ERROR::GPU_CULLING::NEEDS_GL_4_3 (have " << glext.major << "." << glext.minor << ")" << endl;
+		return false;
+	}
+
+	ShaderPreprocessor preprocessor;
+	string source, error;
+	if (!preprocessor.process(computePath, {}, source, &error))
+	{
+		cout << "ERROR::SHADER::PREPROCESS_FAILED\n" << error << endl;
+		return false;
+	}
+	cullProgram.reset(buildComputeProgram(source.c_str(), computePath));
+	if (!cullProgram)
+		return false;
+	planesLocation = glGetUniformLocation(cullProgram.get(), "frustumPlanes");
+	objectCountLocation = glGetUniformLocation(cullProgram.get(), "objectCount");
+	vertexCountLocation = glGetUniformLocation(cullProgram.get(), "vertexCount");
+
+	capacity = maxObjects;
+	count = 0;
+	meshVertexCount = vertexCount;
+
+	objectBuffer = GLBuffer::create();
+	glBindBuffer(GL_SHADER_STORAGE_BUFFER, objectBuffer.get());
+	glBufferData(GL_SHADER_STORAGE_BUFFER, capacity * sizeof(CullObject), NULL, GL_STATIC_DRAW);
+	gpuMemory.trackBuffer(objectBuffer.get(), GPU_MEMORY_STORAGE, capacity * sizeof(CullObject));
+
+	commandBuffer = GLBuffer::create();
+	glBindBuffer(GL_SHADER_STORAGE_BUFFER, commandBuffer.get());
+	glBufferData(GL_SHADER_STORAGE_BUFFER, capacity * sizeof(DrawArraysIndirectCommand), NULL, GL_DYNAMIC_DRAW);
+	gpuMemory.trackBuffer(commandBuffer.get(), GPU_MEMORY_STORAGE, capacity * sizeof(DrawArraysIndirectCommand));
+
+	countBuffer = GLBuffer::create();
+	glBindBuffer(GL_SHADER_STORAGE_BUFFER, countBuffer.get());
+	glBufferData(GL_SHADER_STORAGE_BUFFER, sizeof(GLuint), NULL, GL_DYNAMIC_DRAW);
+	gpuMemory.trackBuffer(countBuffer.get(), GPU_MEMORY_STORAGE, sizeof(GLuint));
+	glBindBuffer(GL_SHADER_STORAGE_BUFFER, 0);
+
+	vector<GLuint> indices(capacity);
+	for (int i = 0; i < capacity; i++)
+		indices[i] = i;
+	objectIndexBuffer = GLBuffer::create();
+	glBindBuffer(GL_ARRAY_BUFFER, objectIndexBuffer.get());
+	glBufferData(GL_ARRAY_BUFFER, indices.size() * sizeof(GLuint), indices.data(), GL_STATIC_DRAW);
+	gpuMemory.trackBuffer(objectIndexBuffer.get(), GPU_MEMORY_VERTEX, indices.size() * sizeof(GLuint));
+
+	vao = GLVertexArray::create();
+	glBindVertexArray(vao.get());
+	glBindBuffer(GL_ARRAY_BUFFER, vertexBuffer);
+	glVertexAttribPointer(0, 3, GL_FLOAT, GL_FALSE, 3 * sizeof(float), (void*)0);
+	glEnableVertexAttribArray(0);
+	glBindBuffer(GL_ARRAY_BUFFER, objectIndexBuffer.get());
+	glVertexAttribIPointer(OBJECT_INDEX_LOCATION, 1, GL_UNSIGNED_INT, sizeof(GLuint), (void*)0);
+	glVertexAttribDivisor(OBJECT_INDEX_LOCATION, 1);
+	glEnableVertexAttribArray(OBJECT_INDEX_LOCATION);
+	glBindVertexArray(0);
+	glBindBuffer(GL_ARRAY_BUFFER, 0);
+	return true;
+}
+
+void GpuCuller::release()
+{
+	// deleted once the frames still drawing with them are done
+	objectBuffer.reset();
+	commandBuffer.reset();
+	countBuffer.reset();
+	objectIndexBuffer.reset();
+	vao.reset();
+	cullProgram.reset();
+	capacity = count = 0;
+}
+
+void GpuCuller::setObjects(const vector<CullObject>& objects)
+{
+	count = min((int)objects.size(), capacity);
+	glBindBuffer(GL_SHADER_STORAGE_BUFFER, objectBuffer.get());
+	glBufferSubData(GL_SHADER_STORAGE_BUFFER, 0, count * sizeof(CullObject), objects.data());
+	glBindBuffer(GL_SHADER_STORAGE_BUFFER, 0);
+}
+
+void GpuCuller::cull(const Mat4& viewProj)
+{
+	Vec4 planes[6];
+	frustumPlanes(viewProj, planes);
+
+	GLuint zero = 0;
+	glBindBuffer(GL_SHADER_STORAGE_BUFFER, countBuffer.get());
+	glBufferSubData(GL_SHADER_STORAGE_BUFFER, 0, sizeof(zero), &zero);
+	if (!glext.indirectCount)
+	{
+		// every command slot gets drawn, the unused ones must be empty
+		glBindBuffer(GL_SHADER_STORAGE_BUFFER, commandBuffer.get());
+		glext.ClearBufferData(GL_SHADER_STORAGE_BUFFER, GL_R32UI, GL_RED_INTEGER, GL_UNSIGNED_INT, &zero);
+	}
+	glBindBuffer(GL_SHADER_STORAGE_BUFFER, 0);
+
+	glUseProgram(cullProgram.get());
+	glUniform4fv(planesLocation, 6, &planes[0].x);
+	glUniform1ui(objectCountLocation, (GLuint)count);
+	glUniform1ui(vertexCountLocation, (GLuint)meshVertexCount);
+	glBindBufferBase(GL_SHADER_STORAGE_BUFFER, OBJECTS_BINDING, objectBuffer.get());
+	glBindBufferBase(GL_SHADER_STORAGE_BUFFER, COMMANDS_BINDING, commandBuffer.get());
+	glBindBufferBase(GL_SHADER_STORAGE_BUFFER, COUNT_BINDING, countBuffer.get());
+	glext.DispatchCompute((count + CULL_GROUP_SIZE - 1) / CULL_GROUP_SIZE, 1, 1);
+
+	// the commands and count are consumed as indirect draw arguments
+	glext.MemoryBarrier(GL_COMMAND_BARRIER_BIT | GL_SHADER_STORAGE_BARRIER_BIT);
+}
+
+void GpuCuller::draw() const
+{
+	glBindBufferBase(GL_SHADER_STORAGE_BUFFER, OBJECTS_BINDING, objectBuffer.get());
+	glBindVertexArray(vao.get());
+	glBindBuffer(GL_DRAW_INDIRECT_BUFFER, commandBuffer.get());
+	if (glext.indirectCount)
+	{
+		glBindBuffer(GL_PARAMETER_BUFFER, countBuffer.get());
+		glext.MultiDrawArraysIndirectCount(GL_TRIANGLES, (void*)0, 0, count, 0);
+		glBindBuffer(GL_PARAMETER_BUFFER, 0);
+	}
+	else
+	{
+		glext.MultiDrawArraysIndirect(GL_TRIANGLES, (void*)0, count, 0);
+	}
+	glBindBuffer(GL_DRAW_INDIRECT_BUFFER, 0);
+	glBindVertexArray(0);
+}
+
+vector<unsigned int> GpuCuller::readVisible() const
+{
+	GLuint visibleCount = 0;
+	glBindBuffer(GL_SHADER_STORAGE_BUFFER, countBuffer.get());
+	glGetBufferSubData(GL_SHADER_STORAGE_BUFFER, 0, sizeof(visibleCount), &visibleCount);
+
+	vector<DrawArraysIndirectCommand> commands(min((int)visibleCount, count));
+	glBindBuffer(GL_SHADER_STORAGE_BUFFER, commandBuffer.get());
+	glGetBufferSubData(GL_SHADER_STORAGE_BUFFER, 0, commands.size() * sizeof(DrawArraysIndirectCommand), commands.data());
+	glBindBuffer(GL_SHADER_STORAGE_BUFFER, 0);
+
+	vector<unsigned int> visible;
+	for (const DrawArraysIndirectCommand& command : commands)
+		visible.push_back(command.baseInstance);
+	return visible;
+}
+
+vector<CullObject> makeCullingScene(int objectCount)
+{
+	vector<CullObject> objects(objectCount);
+	unsigned int seed = 12345;
+	auto random = [&seed]() {
+		seed = seed * 1664525u + 1013904223u;
+		return (seed >> 8) / 16777216.0f;
+	};
+
+	for (CullObject& object : objects)
+	{
+		object.sphere = { random() * 200.0f - 100.0f, random() * 40.0f - 20.0f, random() * 200.0f - 100.0f, 0.5f + random() * 1.5f };
+		object.color = { 0.3f + random() * 0.7f, 0.3f + random() * 0.7f, 0.3f + random() * 0.7f, 1.0f };
+	}
+	return objects;
+}
+
+Mat4 cullingCamera(float time, float aspect)
+{
+	Vec3 eye = { 0.0f, 2.0f, 0.0f };
+	Vec3 target = { sinf(time * 0.3f) * 10.0f, 0.0f, cosf(time * 0.3f) * 10.0f };
+	return perspective(1.0f, aspect, 0.1f, 150.0f) * lookAt(eye, target, { 0.0f, 1.0f, 0.0f });
+}
+
+int runGpuCullingSelfTest(int objectCount)
+{
+	// the mesh is irrelevant for culling, but init() wants one
+	float triangle[] = { -0.5f, -0.5f, 0.0f, 0.5f, -0.5f, 0.0f, 0.0f, 0.5f, 0.0f };
+	GLBuffer vertexBuffer = GLBuffer::create();
+	glBindBuffer(GL_ARRAY_BUFFER, vertexBuffer.get());
+	glBufferData(GL_ARRAY_BUFFER, sizeof(triangle), triangle, GL_STATIC_DRAW);
+	gpuMemory.trackBuffer(vertexBuffer.get(), GPU_MEMORY_VERTEX, sizeof(triangle));
+	glBindBuffer(GL_ARRAY_BUFFER, 0);
+
+	int failures = 0;
+	GpuCuller culler;
+	if (!culler.init("shaders/cull.comp", vertexBuffer.get(), 3, objectCount))
+		return 1;
+	vector<CullObject> objects = makeCullingScene(objectCount);
+	culler.setObjects(objects);
+
+	// spheres within this distance of a plane may go either way on the GPU
+	const float epsilon = 1e-3f;
+	for (int view = 0; view < 8; view++)
+	{
+		Mat4 viewProj = cullingCamera(view * 2.5f, 4.0f / 3.0f);
+		culler.cull(viewProj);
+		vector<unsigned int> visible = culler.readVisible();
+
+		Vec4 planes[6];
+		frustumPlanes(viewProj, planes);
+		vector<char> gpuVisible(objects.size(), 0);
+		for (unsigned int index : visible)
+		{
+			if (index >= objects.size() || gpuVisible[index])
+			{
+				cout << "  view " << view << ": bad or duplicate object index " << index << endl;
+				failures++;
+				continue;
+			}
+			gpuVisible[index] = 1;
+		}
+
+		int expected = 0;
+		for (size_t i = 0; i < objects.size(); i++)
+		{
+			const std430::Vec4& s = objects[i].sphere;
+			float nearest = 1e30f;
+			for (const Vec4& p : planes)
+				nearest = min(nearest, p.x * s.x + p.y * s.y + p.z * s.z + p.w + s.w);
+			bool inside = nearest > epsilon;
+			bool outside = nearest < -epsilon;
+			expected += inside ? 1 : 0;
+			if ((inside && !gpuVisible[i]) || (outside && gpuVisible[i]))
+			{
+				cout << "  view " << view << ": object " << i << " culled wrongly" << endl;
+				failures++;
+			}
+		}
+		cout << "  view " << view << ": " << visible.size() << " / " << objects.size() << " visible (CPU " << expected << ")" << endl;
+	}
+
+	culler.release();
+	cout << "GPU culling self-test " << (failures ? "FAILED" : "passed")
+		<< (glext.indirectCount ? " (indirect count)" : " (multi-draw indirect)") << endl;
+	gpuMemory.report("GPU memory");
+	return failures ? 1 : 0;
+}
@@ -0,0 +1,82 @@
+#ifndef GPU_CULLING_H
+#define GPU_CULLING_H
+
+#include <string>
+#include <vector>
+
+#include <glad/glad.h>
+
+#include "gl_objects.h"
+#include "math3d.h"
+#include "std140.h"
+
+// mirrors ObjectData in shaders/cull.comp and shaders/object.vert
+struct CullObject
+{
+	std430::Vec4 sphere;	// xyz center, w radius
+	std430::Vec4 color;
+};
+
+// Frustum culling on the GPU. cull() runs shaders/cull.comp over every
+// object's bounding sphere and writes a compacted list of
+// DrawArraysIndirectCommands plus the number of them into buffers that
+// never come back to the CPU; draw() then issues a single
+// glMultiDrawArraysIndirectCount (or, without GL_ARB_indirect_parameters,
+// one glMultiDrawArraysIndirect over a zero-cleared command buffer).
+// All objects share one mesh, scaled by the sphere radius. Needs GL 4.3.
+class GpuCuller
+{
+public:
+	GpuCuller() = default;
+	~GpuCuller();
+
+	GpuCuller(const GpuCuller&) = delete;
+	GpuCuller& operator=(const GpuCuller&) = delete;
+
+	static bool supported();
+
+	// vertexBuffer holds vertexCount tightly packed vec3 positions
+	bool init(const std::string& computePath, GLuint vertexBuffer, GLsizei vertexCount, int maxObjects);
+	void release();
+
+	void setObjects(const std::vector<CullObject>& objects);
+
+	void cull(const Mat4& viewProj);
+
+	// draws with whatever program is current, objects are bound to SSBO binding 0
+	void draw() const;
+
+	// the object indices the last cull() kept, in command order. Waits for the
+	// GPU, only meant for tests.
+	std::vector<unsigned int> readVisible() const;
+
+	int objectCount() const { return count; }
+
+private:
+	GLProgram cullProgram;
+	GLBuffer objectBuffer;
+	GLBuffer commandBuffer;
+	GLBuffer countBuffer;
+	GLBuffer objectIndexBuffer;
+	GLVertexArray vao;
+
+	int capacity = 0;
+	int count = 0;
+	GLsizei meshVertexCount = 0;
+
+	GLint planesLocation = -1;
+	GLint objectCountLocation = -1;
+	GLint vertexCountLocation = -1;
+};
+
+// a deterministic field of objects scattered around the origin
+std::vector<CullObject> makeCullingScene(int objectCount);
+
+// a camera turning around the middle of the scene
+Mat4 cullingCamera(float time, float aspect);
+
+// culls a few views on the GPU and compares the result with the CPU,
+// returns the process exit code. Runs fine on llvmpipe.
+int runGpuCullingSelfTest(int objectCount);
+
+#endif
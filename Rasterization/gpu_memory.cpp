@@ -0,0 +1,208 @@
+#include "gpu_memory.h"
+#include "gl_ext.h"
+
+#include <algorithm>
+#include <iostream>
+
+using namespace std;
+
+GpuMemoryTracker gpuMemory;
+
+const char* gpuMemoryCategoryName(GpuMemoryCategory category)
+{
+	static const char* const names[GPU_MEMORY_CATEGORY_COUNT] = {
+		"vertex", "index", "uniform", "storage", "texture", "render target", "readback", "upload"
+	};
+	return category < GPU_MEMORY_CATEGORY_COUNT ? names[category] : "?";
+}
+
+static size_t bytesPerPixel(GLenum internalFormat)
+{
+	switch (internalFormat)
+	{
+	case GL_R8: return 1;
+	case GL_RG8: case GL_R16F: case GL_DEPTH_COMPONENT16: return 2;
+	case GL_RGB8: case GL_SRGB8: case GL_DEPTH_COMPONENT24: return 3;
+	case GL_RG16F: case GL_R32F: case GL_R11F_G11F_B10F: case GL_RGB10_A2:
+	case GL_DEPTH_COMPONENT32F: case GL_DEPTH24_STENCIL8: return 4;
+	case GL_DEPTH32F_STENCIL8: return 5;
+	case GL_RGBA16F: case GL_RG32F: return 8;
+	case GL_RGB32F: return 12;
+	case GL_RGBA32F: return 16;
+	default: return 4;	// GL_RGBA8, GL_SRGB8_ALPHA8 and everything we don't know
+	}
+}
+
+// bytes per 4x4 block of the block compressed formats, 0 for the others
+static size_t bytesPerBlock(GLenum internalFormat)
+{
+	switch (internalFormat)
+	{
+	case GL_COMPRESSED_RGB_S3TC_DXT1_EXT: case GL_COMPRESSED_SRGB_S3TC_DXT1_EXT: return 8;
+	case GL_COMPRESSED_RGBA_S3TC_DXT5_EXT: case GL_COMPRESSED_SRGB_ALPHA_S3TC_DXT5_EXT:
+	case GL_COMPRESSED_RGBA_BPTC_UNORM: case GL_COMPRESSED_SRGB_ALPHA_BPTC_UNORM: return 16;
+	default: return 0;
+	}
+}
+
+size_t gpuImageBytes(GLenum internalFormat, int width, int height, int samples, bool mipmapped)
+{
+	const size_t blockBytes = bytesPerBlock(internalFormat);
+	size_t bytes = 0;
+	for (;;)
+	{
+		if (blockBytes)
+			bytes += (size_t)((width + 3) / 4) * ((height + 3) / 4) * blockBytes;
+		else
+			bytes += (size_t)width * height * max(samples, 1) * bytesPerPixel(internalFormat);
+		if (!mipmapped || (width == 1 && height == 1))
+			return bytes;
+		width = max(width / 2, 1);
+		height = max(height / 2, 1);
+	}
+}
+
+DriverMemoryInfo queryDriverMemory()
+{
+	DriverMemoryInfo info;
+	if (glext.nvxMemoryInfo)
+	{
+		GLint value = 0;
+		info.source = "GL_NVX_gpu_memory_info";
+		glGetIntegerv(GL_GPU_MEMORY_INFO_DEDICATED_VIDMEM_NVX, &value);
+		info.totalKB = value;
+		glGetIntegerv(GL_GPU_MEMORY_INFO_CURRENT_AVAILABLE_VIDMEM_NVX, &value);
+		info.availableKB = value;
+		glGetIntegerv(GL_GPU_MEMORY_INFO_EVICTED_MEMORY_NVX, &value);
+		info.evictedKB = value;
+		glGetIntegerv(GL_GPU_MEMORY_INFO_EVICTION_COUNT_NVX, &value);
+		info.evictions = value;
+	}
+	else if (glext.atiMeminfo)
+	{
+		// free KB in the pool, largest free block, then the same for
+		// auxiliary memory; the pools overlap on current hardware
+		GLint value[4] = {};
+		info.source = "GL_ATI_meminfo";
+		glGetIntegerv(GL_TEXTURE_FREE_MEMORY_ATI, value);
+		info.availableKB = value[0];
+	}
+	return info;
+}
+
+static uint64_t allocationKey(int type, GLuint name)
+{
+	return (uint64_t)type << 32 | name;
+}
+
+void GpuMemoryTracker::track(ObjectType type, GLuint name, GpuMemoryCategory category, size_t bytes)
+{
+	lock_guard<mutex> lock(trackerMutex);
+	Allocation& allocation = allocations[allocationKey(type, name)];
+	if (allocation.bytes)
+		release(allocation);
+	allocation.category = category;
+	allocation.bytes = bytes;
+
+	CategoryStats& stats = counters.categories[category];
+	stats.liveBytes += bytes;
+	stats.peakBytes = max(stats.peakBytes, stats.liveBytes);
+	stats.objects++;
+	counters.liveBytes += bytes;
+	counters.peakBytes = max(counters.peakBytes, counters.liveBytes);
+	counters.frameAllocated += bytes;
+}
+
+void GpuMemoryTracker::release(const Allocation& allocation)
+{
+	CategoryStats& stats = counters.categories[allocation.category];
+	stats.liveBytes -= allocation.bytes;
+	stats.objects--;
+	counters.liveBytes -= allocation.bytes;
+	counters.frameFreed += allocation.bytes;
+}
+
+void GpuMemoryTracker::forget(ObjectType type, GLuint name)
+{
+	lock_guard<mutex> lock(trackerMutex);
+	auto it = allocations.find(allocationKey(type, name));
+	if (it == allocations.end())
+		return;
+	if (it->second.bytes)
+		release(it->second);
+	allocations.erase(it);
+}
+
+void GpuMemoryTracker::trackBuffer(GLuint buffer, GpuMemoryCategory category, size_t bytes)
+{
+	track(BUFFER, buffer, category, bytes);
+}
+
+void GpuMemoryTracker::trackTexture(GLuint texture, GpuMemoryCategory category, size_t bytes)
+{
+	track(TEXTURE, texture, category, bytes);
+}
+
+void GpuMemoryTracker::trackRenderbuffer(GLuint renderbuffer, GpuMemoryCategory category, size_t bytes)
+{
+	track(RENDERBUFFER, renderbuffer, category, bytes);
+}
+
+void GpuMemoryTracker::forgetBuffer(GLuint buffer)
+{
+	forget(BUFFER, buffer);
+}
+
+void GpuMemoryTracker::forgetTexture(GLuint texture)
+{
+	forget(TEXTURE, texture);
+}
+
+void GpuMemoryTracker::forgetRenderbuffer(GLuint renderbuffer)
+{
+	forget(RENDERBUFFER, renderbuffer);
+}
+
+void GpuMemoryTracker::endFrame()
+{
+	lock_guard<mutex> lock(trackerMutex);
+	counters.peakFrameChurn = max(counters.peakFrameChurn, max(counters.frameAllocated, counters.frameFreed));
+	counters.frameAllocated = counters.frameFreed = 0;
+	counters.frames++;
+}
+
+GpuMemoryTracker::Stats GpuMemoryTracker::stats() const
+{
+	lock_guard<mutex> lock(trackerMutex);
+	return counters;
+}
+
+void GpuMemoryTracker::report(const char* title) const
+{
+	const double megabyte = 1 << 20;
+	Stats snapshot = stats();
+	cout << title << ": " << snapshot.liveBytes / megabyte << " MB live, " << snapshot.peakBytes / megabyte << " MB peak";
+	if (snapshot.frames > 0)
+		cout << ", at most " << max(snapshot.peakFrameChurn, max(snapshot.frameAllocated, snapshot.frameFreed)) / megabyte
+			<< " MB allocated or freed in a frame";
+	cout << endl;
+	for (int category = 0; category < GPU_MEMORY_CATEGORY_COUNT; category++)
+	{
+		const CategoryStats& stats = snapshot.categories[category];
+		if (stats.peakBytes == 0)
+			continue;
+		cout << "  " << gpuMemoryCategoryName((GpuMemoryCategory)category) << ": " << stats.liveBytes / megabyte << " MB in "
+			<< stats.objects << " objects, peak " << stats.peakBytes / megabyte << " MB" << endl;
+	}
+
+	DriverMemoryInfo driver = queryDriverMemory();
+	if (driver.source)
+	{
+		cout << "  driver (" << driver.source << "): " << driver.availableKB / 1024 << " MB available";
+		if (driver.totalKB >= 0)
+			cout << " of " << driver.totalKB / 1024 << " MB";
+		if (driver.evictions >= 0)
+			cout << ", " << driver.evictions << " evictions (" << driver.evictedKB / 1024 << " MB)";
+		cout << endl;
+	}
+}
@@ -0,0 +1,102 @@
+#ifndef GPU_MEMORY_H
+#define GPU_MEMORY_H
+
+#include <cstddef>
+#include <cstdint>
+#include <mutex>
+#include <unordered_map>
+
+#include <glad/glad.h>
+
+enum GpuMemoryCategory
+{
+	GPU_MEMORY_VERTEX,
+	GPU_MEMORY_INDEX,
+	GPU_MEMORY_UNIFORM,
+	GPU_MEMORY_STORAGE,			// SSBOs and indirect commands
+	GPU_MEMORY_TEXTURE,
+	GPU_MEMORY_RENDER_TARGET,
+	GPU_MEMORY_READBACK,		// pixel pack buffers
+	GPU_MEMORY_UPLOAD,			// pixel unpack buffers
+	GPU_MEMORY_CATEGORY_COUNT
+};
+
+const char* gpuMemoryCategoryName(GpuMemoryCategory category);
+
+// bytes of width x height x samples of internalFormat, plus a full mip chain
+size_t gpuImageBytes(GLenum internalFormat, int width, int height, int samples = 1, bool mipmapped = false);
+
+// What the driver says about video memory: GL_NVX_gpu_memory_info or
+// GL_ATI_meminfo, in KB, -1 where the extension doesn't tell.
+struct DriverMemoryInfo
+{
+	const char* source = nullptr;		// nullptr when neither is there
+	int64_t totalKB = -1;
+	int64_t availableKB = -1;
+	int64_t evictedKB = -1;
+	int64_t evictions = -1;
+};
+DriverMemoryInfo queryDriverMemory();
+
+// Bytes of video memory the program asked for, by category. Every path that
+// gives a buffer, texture or renderbuffer storage calls track*() with the
+// object's name right after, and whatever deletes it calls forget*();
+// GLObjectPool does that for the names it deletes. Specifying storage again
+// replaces the old size. Safe to call from any thread.
+class GpuMemoryTracker
+{
+public:
+	void trackBuffer(GLuint buffer, GpuMemoryCategory category, size_t bytes);
+	void trackTexture(GLuint texture, GpuMemoryCategory category, size_t bytes);
+	void trackRenderbuffer(GLuint renderbuffer, GpuMemoryCategory category, size_t bytes);
+	void forgetBuffer(GLuint buffer);
+	void forgetTexture(GLuint texture);
+	void forgetRenderbuffer(GLuint renderbuffer);
+
+	// closes the frame's churn, call once per frame
+	void endFrame();
+
+	struct CategoryStats
+	{
+		size_t liveBytes = 0;
+		size_t peakBytes = 0;
+		size_t objects = 0;
+	};
+	struct Stats
+	{
+		CategoryStats categories[GPU_MEMORY_CATEGORY_COUNT];
+		size_t liveBytes = 0;
+		size_t peakBytes = 0;
+		// bytes allocated and freed in the frame in progress, and the most
+		// of either seen in one frame
+		size_t frameAllocated = 0;
+		size_t frameFreed = 0;
+		size_t peakFrameChurn = 0;
+		uint64_t frames = 0;
+	};
+	Stats stats() const;
+
+	// live and peak bytes per category and what the driver reports, to
+	// cout; the driver query needs the context current
+	void report(const char* title) const;
+
+private:
+	enum ObjectType { BUFFER, TEXTURE, RENDERBUFFER };
+	struct Allocation
+	{
+		GpuMemoryCategory category;
+		size_t bytes;
+	};
+
+	void track(ObjectType type, GLuint name, GpuMemoryCategory category, size_t bytes);
+	void forget(ObjectType type, GLuint name);
+	void release(const Allocation& allocation);
+
+	mutable std::mutex trackerMutex;
+	std::unordered_map<uint64_t, Allocation> allocations;
+	Stats counters;
+};
+
+extern GpuMemoryTracker gpuMemory;
+
+#endif
@@ -0,0 +1,161 @@
+#include "heap_guard.h"
+
+#include <cstdlib>
+#include <new>
+
+static thread_local bool armed = false;
+static thread_local HeapGuardCounts counts;
+
+static void count(size_t size)
+{
+	if (armed)
+	{
+		if (counts.allocations == 0)
+			counts.firstSize = size;
+		counts.allocations++;
+		counts.bytes += size;
+	}
+}
+
+static void* allocate(size_t size)
+{
+	count(size);
+	return malloc(size ? size : 1);
+}
+
+// for over-aligned types; what it returns must go to freeAligned, which
+// _aligned_malloc's blocks need on Windows
+static void* allocateAligned(size_t size, std::align_val_t alignment)
+{
+	count(size);
+	size_t align = (size_t)alignment;
+#ifdef _WIN32
+	return _aligned_malloc(size ? size : 1, align);
+#else
+	// aligned_alloc wants a multiple of the alignment
+	return aligned_alloc(align, size ? (size + align - 1) / align * align : align);
+#endif
+}
+
+static void freeAligned(void* p)
+{
+#ifdef _WIN32
+	_aligned_free(p);
+#else
+	free(p);
+#endif
+}
+
+void armHeapGuard()
+{
+	counts = HeapGuardCounts();
+	armed = true;
+}
+
+HeapGuardCounts disarmHeapGuard()
+{
+	armed = false;
+	return counts;
+}
+
+void* operator new(size_t size)
+{
+	void* p = allocate(size);
+	if (!p)
+		throw std::bad_alloc();
+	return p;
+}
+
+void* operator new[](size_t size)
+{
+	void* p = allocate(size);
+	if (!p)
+		throw std::bad_alloc();
+	return p;
+}
+
+void* operator new(size_t size, const std::nothrow_t&) noexcept
+{
+	return allocate(size);
+}
+
+void* operator new[](size_t size, const std::nothrow_t&) noexcept
+{
+	return allocate(size);
+}
+
+void operator delete(void* p) noexcept
+{
+	free(p);
+}
+
+void operator delete[](void* p) noexcept
+{
+	free(p);
+}
+
+void operator delete(void* p, size_t) noexcept
+{
+	free(p);
+}
+
+void operator delete[](void* p, size_t) noexcept
+{
+	free(p);
+}
+
+void* operator new(size_t size, std::align_val_t alignment)
+{
+	void* p = allocateAligned(size, alignment);
+	if (!p)
+		throw std::bad_alloc();
+	return p;
+}
+
+void* operator new[](size_t size, std::align_val_t alignment)
+{
+	void* p = allocateAligned(size, alignment);
+	if (!p)
+		throw std::bad_alloc();
+	return p;
+}
+
+void* operator new(size_t size, std::align_val_t alignment, const std::nothrow_t&) noexcept
+{
+	return allocateAligned(size, alignment);
+}
+
+void* operator new[](size_t size, std::align_val_t alignment, const std::nothrow_t&) noexcept
+{
+	return allocateAligned(size, alignment);
+}
+
+void operator delete(void* p, std::align_val_t) noexcept
+{
+	freeAligned(p);
+}
+
+void operator delete[](void* p, std::align_val_t) noexcept
+{
+	freeAligned(p);
+}
+
+void operator delete(void* p, size_t, std::align_val_t) noexcept
+{
+	freeAligned(p);
+}
+
+void operator delete[](void* p, size_t, std::align_val_t) noexcept
+{
+	freeAligned(p);
+}
+
+void operator delete(void* p, std::align_val_t, const std::nothrow_t&) noexcept
+{
+	freeAligned(p);
+}
+
+void operator delete[](void* p, std::align_val_t, const std::nothrow_t&) noexcept
+{
+	freeAligned(p);
+}
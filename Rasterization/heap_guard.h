@@ -0,0 +1,24 @@
+#ifndef HEAP_GUARD_H
+#define HEAP_GUARD_H
+
+#include <cstddef>
+#include <cstdint>
+
+// Counts heap allocations made through operator new on the calling thread
+// while armed, so a benchmark can check that its steady-state frames
+// allocate nothing. heap_guard.cpp replaces the global operator new and
+// delete, over-aligned ones included, with malloc and free (_aligned_malloc
+// on Windows) plus a thread-local flag, which costs nothing measurable when
+// disarmed. Other threads are never counted.
+struct HeapGuardCounts
+{
+	uint64_t allocations = 0;
+	uint64_t bytes = 0;
+	size_t firstSize = 0;	// of the first allocation counted, to help find it
+};
+
+void armHeapGuard();
+// returns what was allocated since armHeapGuard()
+HeapGuardCounts disarmHeapGuard();
+
+#endif
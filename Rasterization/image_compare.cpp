@@ -0,0 +1,448 @@
+#include "image_compare.h"
+#include "simd.h"
+
+#include <algorithm>
+#include <cmath>
+#include <cstdio>
+#include <cstring>
+#include <limits>
+
+using namespace std;
+
+void RgbaImage::resize(int w, int h)
+{
+	width = w;
+	height = h;
+	pixels.assign((size_t)w * h, 0);
+}
+
+bool readPPM(const string& path, RgbaImage& image)
+{
+	FILE* file = fopen(path.c_str(), "rb");
+	if (!file)
+		return false;
+
+	// "P6", width, height and maxval separated by whitespace and # comments
+	int values[3];
+	bool ok = fgetc(file) == 'P' && fgetc(file) == '6';
+	for (int i = 0; i < 3 && ok; i++)
+	{
+		int c = fgetc(file);
+		while (c == '#' || isspace(c))
+		{
+			if (c == '#')
+			{
+				while (c != '\n' && c != EOF)
+					c = fgetc(file);
+			}
+			c = fgetc(file);
+		}
+		ungetc(c, file);
+		ok = fscanf(file, "%d", &values[i]) == 1;
+	}
+	ok = ok && values[0] > 0 && values[1] > 0 && values[2] == 255 && isspace(fgetc(file));
+
+	vector<uint8_t> data;
+	if (ok)
+	{
+		data.resize((size_t)values[0] * values[1] * 3);
+		ok = fread(data.data(), 1, data.size(), file) == data.size();
+	}
+	fclose(file);
+	if (!ok)
+		return false;
+
+	// PPM rows go top-down
+	image.resize(values[0], values[1]);
+	for (int y = 0; y < image.height; y++)
+	{
+		const uint8_t* in = &data[(size_t)(image.height - 1 - y) * image.width * 3];
+		uint32_t* out = image.row(y);
+		for (int x = 0; x < image.width; x++, in += 3)
+			out[x] = (uint32_t)in[0] | ((uint32_t)in[1] << 8) | ((uint32_t)in[2] << 16) | 0xff000000u;
+	}
+	return true;
+}
+
+bool writePPM(const string& path, const RgbaImage& image)
+{
+	return writePPM(path, image.width, image.height, image.pixels.data());
+}
+
+bool writePPM(const string& path, int width, int height, const uint32_t* pixels)
+{
+	FILE* file = fopen(path.c_str(), "wb");
+	if (!file)
+		return false;
+	fprintf(file, "P6\n%d %d\n255\n", width, height);
+	vector<uint8_t> line((size_t)width * 3);
+	bool ok = true;
+	for (int y = height - 1; y >= 0 && ok; y--)
+	{
+		const uint32_t* in = pixels + (size_t)y * width;
+		for (int x = 0; x < width; x++)
+		{
+			line[x * 3] = (uint8_t)in[x];
+			line[x * 3 + 1] = (uint8_t)(in[x] >> 8);
+			line[x * 3 + 2] = (uint8_t)(in[x] >> 16);
+		}
+		ok = fwrite(line.data(), 1, line.size(), file) == line.size();
+	}
+	return fclose(file) == 0 && ok;
+}
+
+static uint32_t bigEndian(const uint8_t* p)
+{
+	return (uint32_t)p[0] << 24 | (uint32_t)p[1] << 16 | (uint32_t)p[2] << 8 | p[3];
+}
+
+bool readQOI(const string& path, RgbaImage& image)
+{
+	FILE* file = fopen(path.c_str(), "rb");
+	if (!file)
+		return false;
+	vector<uint8_t> data;
+	uint8_t chunk[65536];
+	size_t read;
+	while ((read = fread(chunk, 1, sizeof(chunk), file)) > 0)
+		data.insert(data.end(), chunk, chunk + read);
+	fclose(file);
+
+	// "qoif", width, height, channels, colorspace, then the ops and 7 zeros and a 1
+	const size_t headerBytes = 14, endBytes = 8;
+	if (data.size() < headerBytes + endBytes || memcmp(data.data(), "qoif", 4) != 0)
+		return false;
+	uint32_t width = bigEndian(&data[4]), height = bigEndian(&data[8]);
+	if (width == 0 || height == 0 || width > 32768 || height > 32768 || (data[12] != 3 && data[12] != 4))
+		return false;
+
+	image.resize((int)width, (int)height);
+	uint32_t seen[64] = {};
+	uint8_t r = 0, g = 0, b = 0, a = 255;
+	size_t in = headerBytes, end = data.size() - endBytes;
+	int run = 0;
+	// QOI rows go top-down
+	for (int y = image.height - 1; y >= 0; y--)
+	{
+		uint32_t* out = image.row(y);
+		for (int x = 0; x < image.width; x++)
+		{
+			if (run > 0)
+			{
+				run--;
+			}
+			else if (in < end)
+			{
+				uint8_t op = data[in++];
+				if ((op == 0xfe && in + 3 > end) || (op == 0xff && in + 4 > end))
+				{
+					return false;
+				}
+				else if (op == 0xfe)
+				{
+					r = data[in];
+					g = data[in + 1];
+					b = data[in + 2];
+					in += 3;
+				}
+				else if (op == 0xff)
+				{
+					r = data[in];
+					g = data[in + 1];
+					b = data[in + 2];
+					a = data[in + 3];
+					in += 4;
+				}
+				else if ((op & 0xc0) == 0x00)
+				{
+					uint32_t color = seen[op];
+					r = (uint8_t)color;
+					g = (uint8_t)(color >> 8);
+					b = (uint8_t)(color >> 16);
+					a = (uint8_t)(color >> 24);
+				}
+				else if ((op & 0xc0) == 0x40)
+				{
+					r += ((op >> 4) & 3) - 2;
+					g += ((op >> 2) & 3) - 2;
+					b += (op & 3) - 2;
+				}
+				else if ((op & 0xc0) == 0x80 && in < end)
+				{
+					int dg = (op & 0x3f) - 32;
+					uint8_t rb = data[in++];
+					r += dg - 8 + (rb >> 4);
+					g += dg;
+					b += dg - 8 + (rb & 0x0f);
+				}
+				else if ((op & 0xc0) == 0xc0)
+				{
+					run = op & 0x3f;
+				}
+				else
+				{
+					return false;
+				}
+			}
+			else
+			{
+				return false;
+			}
+			uint32_t color = (uint32_t)r | ((uint32_t)g << 8) | ((uint32_t)b << 16) | ((uint32_t)a << 24);
+			seen[(r * 3 + g * 5 + b * 7 + a * 11) & 63] = color;
+			out[x] = color;
+		}
+	}
+	return true;
+}
+
+// 8 pixels from x on, the ones past the end of the row repeat the last one
+static vec8i loadPixels(const uint32_t* row, int x, int width)
+{
+	if (x + 8 <= width)
+		return vec8i::loadu(row + x);
+	alignas(32) uint32_t tail[8];
+	for (int i = 0; i < 8; i++)
+		tail[i] = row[min(x + i, width - 1)];
+	return vec8i::load(tail);
+}
+
+template<int shift>
+static SIMD_INLINE vec8i channel(vec8i pixels)
+{
+	return shiftRight<shift>(pixels) & vec8i(0xff);
+}
+
+// a^p for a >= 0 and p > 0, exactly 0 for 0
+static SIMD_INLINE vec8f power(vec8f a, float p)
+{
+	return select(a > vec8f::zero(), exp2(log2(a) * vec8f(p)), vec8f::zero());
+}
+
+// One float per pixel, rows padded with copies of their first and last
+// pixel so that x - 1 and x + 1 can be loaded anywhere in the row.
+struct Plane
+{
+	static const int PAD = 8;
+	int width = 0;
+	int height = 0;
+	int stride = 0;
+	vector<float> data;
+
+	void resize(int w, int h)
+	{
+		width = w;
+		height = h;
+		stride = PAD + ((w + 7) & ~7) + PAD;
+		data.assign((size_t)stride * h, 0.0f);
+	}
+	float* row(int y) { return &data[(size_t)y * stride + PAD]; }
+	const float* row(int y) const { return &data[(size_t)y * stride + PAD]; }
+	void fillPads(int y)
+	{
+		float* r = row(y);
+		r[-1] = r[0];
+		for (int x = width; x < stride - PAD; x++)
+			r[x] = r[width - 1];
+	}
+};
+
+// CIE XYZ relative to the D65 white, from sRGB encoded pixels
+static void toXYZ(const RgbaImage& image, Plane xyz[3])
+{
+	// linear sRGB to XYZ, each row divided by the white point
+	const float m[3][3] = {
+		{ 0.4124564f / 0.95047f, 0.3575761f / 0.95047f, 0.1804375f / 0.95047f },
+		{ 0.2126729f, 0.7151522f, 0.0721750f },
+		{ 0.0193339f / 1.08883f, 0.1191920f / 1.08883f, 0.9503041f / 1.08883f },
+	};
+	for (int c = 0; c < 3; c++)
+		xyz[c].resize(image.width, image.height);
+	for (int y = 0; y < image.height; y++)
+	{
+		for (int x = 0; x < image.width; x += 8)
+		{
+			vec8i pixels = loadPixels(image.row(y), x, image.width);
+			vec8f rgb[3] = { toFloat(channel<0>(pixels)), toFloat(channel<8>(pixels)), toFloat(channel<16>(pixels)) };
+			for (int c = 0; c < 3; c++)
+			{
+				vec8f v = rgb[c] * vec8f(1.0f / 255.0f);
+				vec8f curve = power((v + vec8f(0.055f)) * vec8f(1.0f / 1.055f), 2.4f);
+				rgb[c] = select(v <= vec8f(0.04045f), v * vec8f(1.0f / 12.92f), curve);
+			}
+			for (int c = 0; c < 3; c++)
+			{
+				vec8f v = madd(rgb[2], vec8f(m[c][2]), madd(rgb[1], vec8f(m[c][1]), rgb[0] * vec8f(m[c][0])));
+				v.storeu(xyz[c].row(y) + x);
+			}
+		}
+		for (int c = 0; c < 3; c++)
+			xyz[c].fillPads(y);
+	}
+}
+
+// [1 2 1] / 4 across and then down, with the edge pixels repeated
+static void blur(Plane& plane, Plane& scratch)
+{
+	scratch.resize(plane.width, plane.height);
+	const vec8f quarter(0.25f), two(2.0f);
+	for (int y = 0; y < plane.height; y++)
+	{
+		const float* in = plane.row(y);
+		float* out = scratch.row(y);
+		for (int x = 0; x < plane.width; x += 8)
+			(madd(vec8f::loadu(in + x), two, vec8f::loadu(in + x - 1) + vec8f::loadu(in + x + 1)) * quarter).storeu(out + x);
+	}
+	for (int y = 0; y < plane.height; y++)
+	{
+		const float* above = scratch.row(min(y + 1, plane.height - 1));
+		const float* center = scratch.row(y);
+		const float* below = scratch.row(max(y - 1, 0));
+		float* out = plane.row(y);
+		for (int x = 0; x < plane.width; x += 8)
+			(madd(vec8f::loadu(center + x), two, vec8f::loadu(above + x) + vec8f::loadu(below + x)) * quarter).storeu(out + x);
+		plane.fillPads(y);
+	}
+}
+
+static SIMD_INLINE vec8f labCurve(vec8f t)
+{
+	const float delta = 6.0f / 29.0f;
+	vec8f linear = madd(t, vec8f(1.0f / (3.0f * delta * delta)), vec8f(4.0f / 29.0f));
+	return select(t > vec8f(delta * delta * delta), power(max(t, vec8f(1e-12f)), 1.0f / 3.0f), linear);
+}
+
+static SIMD_INLINE void toLab(vec8f x, vec8f y, vec8f z, vec8f lab[3])
+{
+	vec8f fx = labCurve(x), fy = labCurve(y), fz = labCurve(z);
+	lab[0] = madd(fy, vec8f(116.0f), vec8f(-16.0f));
+	lab[1] = (fx - fy) * vec8f(500.0f);
+	lab[2] = (fy - fz) * vec8f(200.0f);
+}
+
+// Hybrid distance: L apart, a and b together
+static SIMD_INLINE vec8f hyab(const vec8f a[3], const vec8f b[3])
+{
+	vec8f da = a[1] - b[1], db = a[2] - b[2];
+	return abs(a[0] - b[0]) + sqrt(madd(da, da, db * db));
+}
+
+// Sobel gradient length of the luminance, scaled to [0, sqrt(2)]
+static SIMD_INLINE vec8f edge(const Plane& luminance, int x, int y)
+{
+	const float* above = luminance.row(min(y + 1, luminance.height - 1)) + x;
+	const float* center = luminance.row(y) + x;
+	const float* below = luminance.row(max(y - 1, 0)) + x;
+	const vec8f two(2.0f);
+	vec8f right = madd(vec8f::loadu(center + 1), two, vec8f::loadu(above + 1) + vec8f::loadu(below + 1));
+	vec8f left = madd(vec8f::loadu(center - 1), two, vec8f::loadu(above - 1) + vec8f::loadu(below - 1));
+	vec8f up = madd(vec8f::loadu(above), two, vec8f::loadu(above - 1) + vec8f::loadu(above + 1));
+	vec8f down = madd(vec8f::loadu(below), two, vec8f::loadu(below - 1) + vec8f::loadu(below + 1));
+	vec8f gx = (right - left) * vec8f(0.25f), gy = (up - down) * vec8f(0.25f);
+	return sqrt(madd(gx, gx, gy * gy));
+}
+
+bool compareImages(const RgbaImage& image, const RgbaImage& reference, int tolerance, ImageComparison& result)
+{
+	if (image.width != reference.width || image.height != reference.height || image.width == 0 || image.height == 0)
+		return false;
+	const int width = image.width, height = image.height;
+
+	// per-pixel tolerance and squared error, 8 pixels at a time
+	result = ImageComparison();
+	uint64_t squaredError = 0;
+	vec8i largest = vec8i::zero();
+	for (int y = 0; y < height; y++)
+	{
+		vec8i rowError = vec8i::zero();
+		for (int x = 0; x < width; x += 8)
+		{
+			vec8i a = loadPixels(image.row(y), x, width);
+			vec8i b = loadPixels(reference.row(y), x, width);
+			vec8i valid = laneIndex() < vec8i(width - x);
+			vec8i d[3] = { channel<0>(a) - channel<0>(b), channel<8>(a) - channel<8>(b), channel<16>(a) - channel<16>(b) };
+			vec8i worst = vec8i::zero();
+			for (int c = 0; c < 3; c++)
+			{
+				d[c] = d[c] & valid;
+				rowError = rowError + d[c] * d[c];
+				worst = max(worst, max(d[c], vec8i::zero() - d[c]));
+			}
+			largest = max(largest, worst);
+			result.differingPixels += bitCount(movemask(worst > vec8i(tolerance)));
+		}
+		// at most 3 * 255^2 per pixel, so a lane holds a row of 4096 pixels
+		alignas(32) int32_t lanes[8];
+		rowError.store(lanes);
+		for (int32_t e : lanes)
+			squaredError += (uint32_t)e;
+	}
+	alignas(32) int32_t lanes[8];
+	largest.store(lanes);
+	result.largestDifference = *max_element(lanes, lanes + 8);
+	double mse = (double)squaredError / (3.0 * width * height);
+	result.psnr = mse > 0.0 ? 10.0 * log10(255.0 * 255.0 / mse) : numeric_limits<double>::infinity();
+
+	// FLIP-like error: blurred CIELAB HyAB distance, remapped to [0, 1] and
+	// raised to 1 - the edge difference
+	Plane xyz[2][3], luminance[2], scratch;
+	toXYZ(image, xyz[0]);
+	toXYZ(reference, xyz[1]);
+	for (int i = 0; i < 2; i++)
+	{
+		luminance[i] = xyz[i][1];
+		for (int c = 0; c < 3; c++)
+			blur(xyz[i][c], scratch);
+	}
+
+	// the largest color difference, green against blue, after the power
+	const float exponent = 0.7f, pc = 0.4f, pt = 0.95f;
+	vec8f green[3], blue[3];
+	toLab(vec8f(0.3575761f / 0.95047f), vec8f(0.7151522f), vec8f(0.1191920f / 1.08883f), green);
+	toLab(vec8f(0.1804375f / 0.95047f), vec8f(0.0721750f), vec8f(0.9503041f / 1.08883f), blue);
+	const float cmax = powf(lane(hyab(green, blue), 0), exponent);
+
+	result.diff.resize(width, height);
+	vec8f flipSum = vec8f::zero(), flipMax = vec8f::zero();
+	for (int y = 0; y < height; y++)
+	{
+		for (int x = 0; x < width; x += 8)
+		{
+			vec8f lab[2][3];
+			for (int i = 0; i < 2; i++)
+				toLab(vec8f::loadu(xyz[i][0].row(y) + x), vec8f::loadu(xyz[i][1].row(y) + x), vec8f::loadu(xyz[i][2].row(y) + x), lab[i]);
+			vec8f e = power(hyab(lab[0], lab[1]), exponent);
+			vec8f color = select(e < vec8f(pc * cmax), e * vec8f(pt / (pc * cmax)),
+				madd(e - vec8f(pc * cmax), vec8f((1.0f - pt) / (cmax - pc * cmax)), vec8f(pt)));
+			color = min(color, vec8f(1.0f));
+
+			vec8f feature = sqrt(abs(edge(luminance[0], x, y) - edge(luminance[1], x, y)) * vec8f(0.70710678f));
+			vec8f flip = exp2(log2(color) * max(vec8f(1.0f) - feature, vec8f(1e-4f)));
+			flip = select(color > vec8f::zero(), min(flip, vec8f(1.0f)), vec8f::zero());
+
+			vec8f valid = asFloat(laneIndex() < vec8i(width - x));
+			flipSum = flipSum + (flip & valid);
+			flipMax = max(flipMax, flip & valid);
+
+			// black, red, yellow, white
+			vec8f three(3.0f);
+			vec8i r = toIntRound(clamp(flip * three, vec8f::zero(), vec8f(1.0f)) * vec8f(255.0f));
+			vec8i g = toIntRound(clamp(flip * three - vec8f(1.0f), vec8f::zero(), vec8f(1.0f)) * vec8f(255.0f));
+			vec8i b = toIntRound(clamp(flip * three - vec8f(2.0f), vec8f::zero(), vec8f(1.0f)) * vec8f(255.0f));
+			vec8i packed = r | shiftLeft<8>(g) | shiftLeft<16>(b) | vec8i((int32_t)0xff000000u);
+			alignas(32) uint32_t out[8];
+			packed.store(out);
+			for (int i = 0; i < 8 && x + i < width; i++)
+				result.diff.row(y)[x + i] = out[i];
+		}
+	}
+	alignas(32) float sums[8], maxima[8];
+	flipSum.store(sums);
+	flipMax.store(maxima);
+	double total = 0.0;
+	for (float s : sums)
+		total += s;
+	result.meanFlip = total / ((double)width * height);
+	result.maxFlip = *max_element(maxima, maxima + 8);
+	return true;
+}
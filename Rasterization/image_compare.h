@@ -0,0 +1,46 @@
+#ifndef IMAGE_COMPARE_H
+#define IMAGE_COMPARE_H
+
+#include <cstdint>
+#include <string>
+#include <vector>
+
+// RGBA8 image, rows bottom-up like glReadPixels, packed like packRGBA8()
+struct RgbaImage
+{
+	int width = 0;
+	int height = 0;
+	std::vector<uint32_t> pixels;
+
+	void resize(int w, int h);
+	uint32_t* row(int y) { return &pixels[(size_t)y * width]; }
+	const uint32_t* row(int y) const { return &pixels[(size_t)y * width]; }
+};
+
+// binary PPM (P6), 8 bits per channel; alpha is dropped on write and 255 on read
+bool readPPM(const std::string& path, RgbaImage& image);
+bool writePPM(const std::string& path, const RgbaImage& image);
+bool writePPM(const std::string& path, int width, int height, const uint32_t* pixels);
+// QOI, RGB or RGBA, the format FrameEncoder writes
+bool readQOI(const std::string& path, RgbaImage& image);
+
+// How far an image is from a reference of the same size, RGB only.
+// flip is a simplified FLIP: both images go to a perceptual color space,
+// are blurred a little like the eye's contrast sensitivity does, and the
+// color difference is raised to a power that drops where the edges of the
+// two images differ. 0 is identical, 1 the largest difference; unlike PSNR
+// it weighs a visible shift of an edge more than noise in a smooth area.
+struct ImageComparison
+{
+	int differingPixels = 0;	// pixels with a channel off by more than the tolerance
+	int largestDifference = 0;	// in 1/255
+	double psnr = 0.0;			// dB, infinite for identical images
+	double meanFlip = 0.0;
+	double maxFlip = 0.0;
+	RgbaImage diff;				// the FLIP error per pixel, black to red to yellow to white
+};
+
+// false when the sizes differ
+bool compareImages(const RgbaImage& image, const RgbaImage& reference, int tolerance, ImageComparison& result);
+
+#endif
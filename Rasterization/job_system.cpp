@@ -0,0 +1,344 @@
+#include "job_system.h"
+
+using namespace std;
+
+// the system and worker index of the calling thread, -1 for other threads
+static thread_local const JobSystem* currentSystem = nullptr;
+static thread_local int currentIndex = -1;
+
+// Chase-Lev as corrected for weak memory models by Le, Pop, Cohen and
+// Zappa Nardelli, "Correct and Efficient Work-Stealing for Weak Memory
+// Models", PPoPP 2013
+bool WorkStealingDeque::push(Job* job)
+{
+	int64_t b = bottom.load(memory_order_relaxed);
+	int64_t t = top.load(memory_order_acquire);
+	if (b - t >= CAPACITY)
+		return false;
+	jobs[b & (CAPACITY - 1)].store(job, memory_order_relaxed);
+	// publishes the job to thieves that load bottom with acquire
+	bottom.store(b + 1, memory_order_release);
+	return true;
+}
+
+Job* WorkStealingDeque::pop()
+{
+	int64_t b = bottom.load(memory_order_relaxed) - 1;
+	bottom.store(b, memory_order_relaxed);
+	atomic_thread_fence(memory_order_seq_cst);
+	int64_t t = top.load(memory_order_relaxed);
+	if (t > b)
+	{
+		bottom.store(b + 1, memory_order_relaxed);
+		return nullptr;
+	}
+	Job* job = jobs[b & (CAPACITY - 1)].load(memory_order_relaxed);
+	if (t == b)
+	{
+		// the last job: race the thieves for it
+		if (!top.compare_exchange_strong(t, t + 1, memory_order_seq_cst, memory_order_relaxed))
+			job = nullptr;
+		bottom.store(b + 1, memory_order_relaxed);
+	}
+	return job;
+}
+
+Job* WorkStealingDeque::steal()
+{
+	int64_t t = top.load(memory_order_acquire);
+	atomic_thread_fence(memory_order_seq_cst);
+	int64_t b = bottom.load(memory_order_acquire);
+	if (t >= b)
+		return nullptr;
+	Job* job = jobs[t & (CAPACITY - 1)].load(memory_order_relaxed);
+	if (!top.compare_exchange_strong(t, t + 1, memory_order_seq_cst, memory_order_relaxed))
+		return nullptr;
+	return job;
+}
+
+bool WorkStealingDeque::empty() const
+{
+	return bottom.load(memory_order_acquire) <= top.load(memory_order_acquire);
+}
+
+JobSystem::JobSystem(int threadCount)
+{
+	if (threadCount <= 0)
+		threadCount = max(1u, thread::hardware_concurrency());
+	for (int i = 0; i < threadCount; i++)
+	{
+		workers.push_back(make_unique<Worker>());
+		workers[i]->ring.reset(new Job[RING_SIZE]);
+		workers[i]->random = 0x9e3779b9u * (i + 1);
+	}
+	currentSystem = this;
+	currentIndex = 0;
+	for (int i = 1; i < threadCount; i++)
+		workers[i]->thread = thread(&JobSystem::workerLoop, this, i);
+}
+
+JobSystem::~JobSystem()
+{
+	stopping = true;
+	{
+		lock_guard<mutex> lock(sleepMutex);
+		wakeups++;
+	}
+	wake.notify_all();
+	for (size_t i = 1; i < workers.size(); i++)
+		workers[i]->thread.join();
+	if (currentSystem == this)
+	{
+		currentSystem = nullptr;
+		currentIndex = -1;
+	}
+}
+
+int JobSystem::currentWorker() const
+{
+	return currentSystem == this ? currentIndex : -1;
+}
+
+Job* JobSystem::allocateJob()
+{
+	Worker& worker = *workers[currentWorker()];
+	Job* job = &worker.ring[worker.nextJob++ % RING_SIZE];
+	// a whole ring of jobs still running: help until the oldest is done
+	while (!job->finished.load(memory_order_acquire))
+	{
+		if (Job* other = findJob(currentWorker()))
+			execute(other);
+		else
+			this_thread::yield();
+	}
+	job->function = nullptr;
+	job->data = nullptr;
+	job->range = nullptr;
+	job->counter = nullptr;
+	job->next = nullptr;
+	job->finished.store(false, memory_order_relaxed);
+	return job;
+}
+
+void JobSystem::submit(Job* job, JobCounter* counter)
+{
+	job->counter = counter;
+	if (counter)
+		counter->value.fetch_add(1, memory_order_relaxed);
+	push(job);
+}
+
+void JobSystem::push(Job* job)
+{
+	if (!workers[currentWorker()]->deque.push(job))
+	{
+		execute(job);
+		return;
+	}
+	// pairs with the sleeper counting itself before looking at the deques
+	atomic_thread_fence(memory_order_seq_cst);
+	if (sleepers.load(memory_order_relaxed) > 0)
+	{
+		{
+			lock_guard<mutex> lock(sleepMutex);
+			wakeups++;
+		}
+		wake.notify_one();
+	}
+}
+
+void JobSystem::run(void (*function)(void*), void* data, JobCounter* counter)
+{
+	if (currentWorker() < 0)
+	{
+		// not one of ours, nowhere to queue it
+		function(data);
+		return;
+	}
+	Job* job = allocateJob();
+	job->function = function;
+	job->data = data;
+	submit(job, counter);
+}
+
+void JobSystem::runAfter(JobCounter& after, void (*function)(void*), void* data, JobCounter* counter)
+{
+	if (currentWorker() < 0)
+	{
+		wait(after);
+		function(data);
+		return;
+	}
+	Job* job = allocateJob();
+	job->function = function;
+	job->data = data;
+	job->counter = counter;
+	if (counter)
+		counter->value.fetch_add(1, memory_order_relaxed);
+
+	unique_lock<mutex> lock(after.waitersMutex);
+	if (after.value.load(memory_order_acquire) > 0)
+	{
+		job->next = after.waiters;
+		after.waiters = job;
+		return;
+	}
+	lock.unlock();
+	push(job);
+}
+
+Job* JobSystem::findJob(int self)
+{
+	Worker& worker = *workers[self];
+	if (Job* job = worker.deque.pop())
+		return job;
+
+	const int count = (int)workers.size();
+	for (int attempt = 1; attempt < count * 2; attempt++)
+	{
+		worker.random ^= worker.random << 13;
+		worker.random ^= worker.random >> 17;
+		worker.random ^= worker.random << 5;
+		int victim = (int)(worker.random % count);
+		if (victim == self)
+			continue;
+		if (Job* job = workers[victim]->deque.steal())
+		{
+			worker.steals.fetch_add(1, memory_order_relaxed);
+			return job;
+		}
+	}
+	return nullptr;
+}
+
+void JobSystem::execute(Job* job)
+{
+	if (job->range)
+	{
+		// keep the left half, offer the right half to thieves
+		while (job->end - job->begin > job->grain)
+		{
+			size_t middle = job->begin + (job->end - job->begin) / 2;
+			Job* right = allocateJob();
+			right->range = job->range;
+			right->data = job->data;
+			right->begin = middle;
+			right->end = job->end;
+			right->grain = job->grain;
+			submit(right, job->counter);
+			job->end = middle;
+		}
+		job->range(job->data, job->begin, job->end);
+	}
+	else
+	{
+		job->function(job->data);
+	}
+	workers[currentWorker()]->jobs.fetch_add(1, memory_order_relaxed);
+	finish(job);
+}
+
+void JobSystem::finish(Job* job)
+{
+	JobCounter* counter = job->counter;
+	// the ring slot may be reused from here on
+	job->finished.store(true, memory_order_release);
+	if (!counter)
+		return;
+
+	// under the lock, so runAfter() sees either a counter above zero that
+	// will start it later or zero, and wait() can't return and free the
+	// counter while this still uses it
+	Job* ready = nullptr;
+	{
+		lock_guard<mutex> lock(counter->waitersMutex);
+		if (counter->value.fetch_sub(1, memory_order_acq_rel) == 1)
+		{
+			ready = counter->waiters;
+			counter->waiters = nullptr;
+		}
+	}
+	while (ready)
+	{
+		Job* next = ready->next;
+		push(ready);
+		ready = next;
+	}
+}
+
+void JobSystem::wait(JobCounter& counter)
+{
+	int self = currentWorker();
+	while (!counter.done())
+	{
+		Job* job = self >= 0 ? findJob(self) : nullptr;
+		if (job)
+			execute(job);
+		else
+			this_thread::yield();
+	}
+	// the last finish() may still hold the lock
+	lock_guard<mutex> lock(counter.waitersMutex);
+}
+
+bool JobSystem::anyQueued() const
+{
+	for (const unique_ptr<Worker>& worker : workers)
+	{
+		if (!worker->deque.empty())
+			return true;
+	}
+	return false;
+}
+
+void JobSystem::workerLoop(int index)
+{
+	currentSystem = this;
+	currentIndex = index;
+	Worker& worker = *workers[index];
+	while (!stopping)
+	{
+		if (Job* job = findJob(index))
+		{
+			execute(job);
+			continue;
+		}
+
+		// a short spin catches the next job of a busy frame without a
+		// round trip through the kernel
+		bool found = false;
+		for (int spin = 0; spin < 64 && !found; spin++)
+		{
+			this_thread::yield();
+			found = anyQueued();
+		}
+		if (found)
+			continue;
+
+		uint64_t seen;
+		{
+			lock_guard<mutex> lock(sleepMutex);
+			seen = wakeups;
+			sleepers.fetch_add(1);
+		}
+		if (!anyQueued() && !stopping)
+		{
+			worker.sleeps.fetch_add(1, memory_order_relaxed);
+			unique_lock<mutex> lock(sleepMutex);
+			wake.wait(lock, [&] { return wakeups != seen || stopping; });
+		}
+		sleepers.fetch_sub(1);
+	}
+}
+
+JobSystem::Stats JobSystem::stats() const
+{
+	Stats total;
+	for (const unique_ptr<Worker>& worker : workers)
+	{
+		total.jobs += worker->jobs.load(memory_order_relaxed);
+		total.steals += worker->steals.load(memory_order_relaxed);
+		total.sleeps += worker->sleeps.load(memory_order_relaxed);
+	}
+	return total;
+}
@@ -0,0 +1,167 @@
+#ifndef JOB_SYSTEM_H
+#define JOB_SYSTEM_H
+
+#include <algorithm>
+#include <atomic>
+#include <condition_variable>
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+class JobSystem;
+struct Job;
+
+// Counts unfinished jobs. Jobs started with a counter add one to it and take
+// it away when they finish; JobSystem::wait() runs other jobs until it is
+// zero, and jobs started with runAfter() are held back until then. Don't
+// start new jobs on a counter that still has jobs waiting for it.
+class JobCounter
+{
+public:
+	JobCounter() = default;
+	JobCounter(const JobCounter&) = delete;
+	JobCounter& operator=(const JobCounter&) = delete;
+
+	bool done() const { return value.load(std::memory_order_acquire) == 0; }
+
+private:
+	friend class JobSystem;
+
+	std::atomic<int> value{ 0 };
+	std::mutex waitersMutex;
+	Job* waiters = nullptr;		// runAfter() jobs, linked through Job::next
+};
+
+// A job: a function pointer and its argument, or a range of a parallelFor().
+// Lives in the ring of the thread that started it until it finished.
+struct Job
+{
+	void (*function)(void* data) = nullptr;
+	void* data = nullptr;
+
+	// parallelFor() ranges: body(data, begin, end) once the range is small enough
+	void (*range)(const void* body, size_t begin, size_t end) = nullptr;
+	size_t begin = 0;
+	size_t end = 0;
+	size_t grain = 0;
+
+	JobCounter* counter = nullptr;
+	Job* next = nullptr;
+	std::atomic<bool> finished{ true };
+};
+
+// Chase-Lev work-stealing deque of job pointers: the owning thread pushes
+// and pops at the bottom without locking, other threads steal from the top
+// with one compare-and-swap. Fixed capacity; push() fails when full and the
+// caller runs the job itself.
+class WorkStealingDeque
+{
+public:
+	static const int64_t CAPACITY = 4096;
+
+	bool push(Job* job);
+	Job* pop();
+	Job* steal();
+	bool empty() const;
+
+private:
+	alignas(64) std::atomic<int64_t> top{ 0 };
+	alignas(64) std::atomic<int64_t> bottom{ 0 };
+	std::atomic<Job*> jobs[CAPACITY];
+};
+
+// Work-stealing scheduler. The thread that constructs it is worker 0 and
+// only takes part while it waits; threadCount - 1 more threads run jobs
+// all the time. Every thread has its own deque: a thread pushes the jobs it
+// starts onto its own deque and takes the newest back first, which keeps
+// the data it just touched warm, and an idle thread steals the oldest job
+// of a random other one, usually the biggest piece of work left. Threads
+// with nothing to steal sleep until a job is pushed. Jobs may only be
+// started from worker threads, including from inside jobs.
+class JobSystem
+{
+public:
+	// 0 for one thread per core
+	explicit JobSystem(int threadCount = 0);
+	~JobSystem();
+
+	JobSystem(const JobSystem&) = delete;
+	JobSystem& operator=(const JobSystem&) = delete;
+
+	int threadCount() const { return (int)workers.size(); }
+
+	void run(void (*function)(void*), void* data, JobCounter* counter = nullptr);
+	// like run(), but only starts once after is zero
+	void runAfter(JobCounter& after, void (*function)(void*), void* data, JobCounter* counter = nullptr);
+
+	// runs jobs, its own first, until counter is zero
+	void wait(JobCounter& counter);
+
+	// body(begin, end) over subranges of [begin, end) on every thread,
+	// returns when all are done. Ranges are split in halves on demand, down
+	// to grain items, or to about 8 pieces per thread when grain is 0, so
+	// an idle thread always finds a big half to steal.
+	template<class Body>
+	void parallelFor(size_t begin, size_t end, const Body& body, size_t grain = 0)
+	{
+		if (begin >= end)
+			return;
+		if (grain == 0)
+			grain = std::max<size_t>(1, (end - begin) / (workers.size() * 8));
+		JobCounter counter;
+		Job* job = allocateJob();
+		job->range = [](const void* f, size_t b, size_t e) { (*(const Body*)f)(b, e); };
+		job->data = (void*)&body;
+		job->begin = begin;
+		job->end = end;
+		job->grain = grain;
+		submit(job, &counter);
+		wait(counter);
+	}
+
+	struct Stats
+	{
+		uint64_t jobs = 0;
+		uint64_t steals = 0;
+		uint64_t sleeps = 0;
+	};
+	Stats stats() const;
+
+private:
+	struct Worker
+	{
+		WorkStealingDeque deque;
+		std::unique_ptr<Job[]> ring;	// job storage, reused round robin
+		size_t nextJob = 0;
+		uint32_t random = 1;
+		std::atomic<uint64_t> jobs{ 0 };
+		std::atomic<uint64_t> steals{ 0 };
+		std::atomic<uint64_t> sleeps{ 0 };
+		std::thread thread;
+	};
+
+	static const size_t RING_SIZE = 4096;
+
+	int currentWorker() const;
+	Job* allocateJob();
+	void submit(Job* job, JobCounter* counter);
+	void push(Job* job);
+	Job* findJob(int self);
+	void execute(Job* job);
+	void finish(Job* job);
+	void workerLoop(int index);
+	bool anyQueued() const;
+
+	std::vector<std::unique_ptr<Worker>> workers;
+	std::atomic<bool> stopping{ false };
+
+	std::mutex sleepMutex;
+	std::condition_variable wake;
+	std::atomic<int> sleepers{ 0 };
+	uint64_t wakeups = 0;		// guarded by sleepMutex
+};
+
+#endif
@@ -0,0 +1,189 @@
+#include "lz4.h"
+
+#include <cstring>
+
+using namespace std;
+
+static const size_t MIN_MATCH = 4;
+// the format's end rules: the last match starts 12 bytes before the end at
+// the latest, and the last 5 bytes are literals
+static const size_t MATCH_FIND_LIMIT = 12;
+static const size_t LAST_LITERALS = 5;
+static const size_t MAX_OFFSET = 65535;
+static const int HASH_LOG = 12;
+// without a match for 64 positions, probe every other one, then every third...
+static const int SKIP_STRENGTH = 6;
+
+static inline uint32_t read32(const uint8_t* p)
+{
+	uint32_t value;
+	memcpy(&value, p, 4);
+	return value;
+}
+
+static inline uint32_t hashSequence(uint32_t sequence)
+{
+	return (sequence * 2654435761u) >> (32 - HASH_LOG);
+}
+
+static inline uint8_t* writeLength(uint8_t* op, size_t length)
+{
+	while (length >= 255)
+	{
+		*op++ = 255;
+		length -= 255;
+	}
+	*op++ = (uint8_t)length;
+	return op;
+}
+
+// literals, then a match of matchLength bytes offset back, none when 0
+static inline uint8_t* writeSequence(uint8_t* op, const uint8_t* literals, size_t literalCount, size_t offset, size_t matchLength)
+{
+	uint8_t* token = op++;
+	*token = (uint8_t)((literalCount < 15 ? literalCount : 15) << 4);
+	if (literalCount >= 15)
+		op = writeLength(op, literalCount - 15);
+	if (literalCount)
+		memcpy(op, literals, literalCount);
+	op += literalCount;
+	if (matchLength == 0)
+		return op;
+	*op++ = (uint8_t)offset;
+	*op++ = (uint8_t)(offset >> 8);
+	size_t code = matchLength - MIN_MATCH;
+	*token |= (uint8_t)(code < 15 ? code : 15);
+	if (code >= 15)
+		op = writeLength(op, code - 15);
+	return op;
+}
+
+size_t lz4CompressBound(size_t size)
+{
+	return size + size / 255 + 16;
+}
+
+size_t lz4Compress(const uint8_t* data, size_t size, vector<uint8_t>& out)
+{
+	const size_t start = out.size();
+	out.resize(start + lz4CompressBound(size));
+	uint8_t* const begin = out.data() + start;
+	uint8_t* op = begin;
+
+	size_t anchor = 0;
+	if (size > MATCH_FIND_LIMIT)
+	{
+		// positions by the hash of the 4 bytes there; a stale or colliding
+		// entry is caught by comparing the bytes
+		uint32_t table[1 << HASH_LOG] = {};
+		const size_t matchFindEnd = size - MATCH_FIND_LIMIT;
+		const size_t matchEnd = size - LAST_LITERALS;
+		size_t ip = 0;
+		while (ip <= matchFindEnd)
+		{
+			uint32_t sequence = read32(data + ip);
+			uint32_t& slot = table[hashSequence(sequence)];
+			size_t candidate = slot;
+			slot = (uint32_t)ip;
+			if (candidate >= ip || ip - candidate > MAX_OFFSET || read32(data + candidate) != sequence)
+			{
+				ip += 1 + ((ip - anchor) >> SKIP_STRENGTH);
+				continue;
+			}
+
+			// grow the match back over the literals before it, then forward
+			while (ip > anchor && candidate > 0 && data[ip - 1] == data[candidate - 1])
+			{
+				ip--;
+				candidate--;
+			}
+			size_t length = MIN_MATCH;
+			while (ip + length < matchEnd && data[ip + length] == data[candidate + length])
+				length++;
+
+			op = writeSequence(op, data + anchor, ip - anchor, ip - candidate, length);
+			ip += length;
+			anchor = ip;
+			// the position just before the end of the match is a likely start
+			// of the next one
+			if (ip - 2 <= matchFindEnd)
+				table[hashSequence(read32(data + ip - 2))] = (uint32_t)(ip - 2);
+		}
+	}
+	op = writeSequence(op, data + anchor, size - anchor, 0, 0);
+
+	size_t written = (size_t)(op - begin);
+	out.resize(start + written);
+	return written;
+}
+
+bool lz4Decompress(const uint8_t* data, size_t size, uint8_t* out, size_t outSize)
+{
+	size_t ip = 0, op = 0;
+	while (ip < size)
+	{
+		const uint8_t token = data[ip++];
+
+		size_t literals = token >> 4;
+		if (literals == 15)
+		{
+			uint8_t extra;
+			do
+			{
+				if (ip >= size)
+					return false;
+				extra = data[ip++];
+				literals += extra;
+			} while (extra == 255);
+		}
+		if (literals > size - ip || literals > outSize - op)
+			return false;
+		if (literals)
+			memcpy(out + op, data + ip, literals);
+		ip += literals;
+		op += literals;
+		// the last sequence has no match
+		if (ip == size)
+			break;
+
+		if (size - ip < 2)
+			return false;
+		size_t offset = (size_t)data[ip] | (size_t)data[ip + 1] << 8;
+		ip += 2;
+		if (offset == 0 || offset > op)
+			return false;
+		size_t length = token & 15;
+		if (length == 15)
+		{
+			uint8_t extra;
+			do
+			{
+				if (ip >= size)
+					return false;
+				extra = data[ip++];
+				length += extra;
+			} while (extra == 255);
+		}
+		length += MIN_MATCH;
+		if (length > outSize - op)
+			return false;
+
+		uint8_t* d = out + op;
+		const uint8_t* s = d - offset;
+		if (offset >= 8 && outSize - op - length >= 8)
+		{
+			// 8 bytes at a time, overshooting into room that is there: each
+			// copy reads only bytes written before it
+			for (size_t i = 0; i < length; i += 8)
+				memcpy(d + i, s + i, 8);
+		}
+		else
+		{
+			// a short offset repeats the last few bytes, byte by byte
+			for (size_t i = 0; i < length; i++)
+				d[i] = s[i];
+		}
+		op += length;
+	}
+	return op == outSize;
+}
@@ -0,0 +1,24 @@
+#ifndef LZ4_H
+#define LZ4_H
+
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+// LZ4 block format, compatible with the reference LZ4_compress_default and
+// LZ4_decompress_safe: sequences of literals and a match of 4 or more bytes
+// up to 64 KB back, the last 5 bytes always literals. The compressor is the
+// greedy single-probe hash of LZ4's fast mode, skipping ahead faster the
+// longer it goes without a match, so incompressible data costs little; the
+// decompressor checks every length and offset against both buffers.
+
+// the most lz4Compress() can write for size bytes
+size_t lz4CompressBound(size_t size);
+
+// appends the compressed data[0, size) to out, returns the compressed size
+size_t lz4Compress(const uint8_t* data, size_t size, std::vector<uint8_t>& out);
+
+// false unless data[0, size) decodes to exactly outSize bytes
+bool lz4Decompress(const uint8_t* data, size_t size, uint8_t* out, size_t outSize);
+
+#endif
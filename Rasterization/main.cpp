@@ -1,7 +1,32 @@
+#include <algorithm>
+#include <climits>
+#include <cstdlib>
+#include <filesystem>
 #include <iostream>
+#include <memory>
+#include <string>
+#include <vector>
 #include <glad/glad.h>
 #include <GLFW/glfw3.h>
 
+#include "asset_archive.h"
+#include "benchmarks.h"
+#include "frame_capture.h"
+#include "frame_encoder.h"
+#include "frame_arena.h"
+#include "gl_objects.h"
+#include "gpu_memory.h"
+#include "heap_guard.h"
+#include "video_sink.h"
+#include "gl_ext.h"
+#include "gl_loader.h"
+#include "gpu_culling.h"
+#include "job_system.h"
+#include "shader_reloader.h"
+#include "startup_profiler.h"
+#include "texture_streamer.h"
+#include "virtual_texture.h"
+
 using namespace std;
 
 void framebuffer_size_callback(GLFWwindow* window, int width, int height);
@@ -10,26 +35,256 @@ void processInput(GLFWwindow* window);
 const unsigned int SCR_WIDTH = 800;
 const unsigned int SCR_HEIGHT = 600;
 
-const char* vertexShaderSource = "#version 330 core\n"
-"layout (location = 0) in vec3 aPos;\n"
-"void main()\n"
-"{\n"
-"	gl_Position = vec4(aPos.x, aPos.y, aPos.z, 1.0);\n"
-"}\0";
-
-const char* fragmentShaderSource = "#version 330 core\n"
-"out ver4 PragColor;\n"
-"void main()\n"
-"{\n"
-"	FragColor = vec4(1.0f, 0.5f, 0.2f, 1.0f);\n"
-"}\n\0";
-
-int main() {
+// ɫԿأӦshaders/triangle.*е#ifdef
+enum TriangleFeature
+{
+	TRIANGLE_VERTEX_COLOR = 1 << 0,
+	TRIANGLE_INSTANCING = 1 << 1,
+	TRIANGLE_DRAW_UNIFORMS = 1 << 2,
+	TRIANGLE_DRAW_BLOCK = 1 << 3,
+};
+
+// ȡ"--option [count]"пѡֲ
+static int optionalCount(int argc, char* argv[], int& i, int fallback)
+{
+	if (i + 1 < argc && argv[i + 1][0] >= '0' && argv[i + 1][0] <= '9')
+		return atoi(argv[++i]);
+	return fallback;
+}
+
+int main(int argc, char* argv[]) {
+	// ׶εĺʱ￪ʼ
+	StartupProfiler startup;
+
+	// в
+	// --bench-uniforms [draws]  ȽglUniformuniform buffer arenaÿλƿ˳
+	// --gpu-cull [objects]      compute shader׶޳Ⱦ峡
+	// --gpu-cull-test [objects] ԱGPUCPU޳˳llvmpipeУ
+	// --bench-interp [triangles] CPUդvaryingֵҪOpenGL
+	// --bench-shader [triangles] CPUGLSLɫƬҪOpenGL
+	// --bench-depth [layers]    CPUդǰȲԺͷֿ޳ٵɫҪOpenGL
+	// --bench-msaa [triangles]  CPUդ4x/8x MSAA1xڴʱ俪ҪOpenGL
+	// --bench-setup [triangles] CPUդáü޳ҪOpenGL
+	// --bench-texture [size]    CPUڷŴСתʱҪOpenGL
+	// --msaa-test [triangles]   ԱCPUGL4x MSAA˳
+	// --golden [frames]         frames֡golden/triangle.ppmûʱCPUȾȽϣһʱط
+	// --golden-update [frames]  ѵframes֡Ϊgolden/triangle.ppm
+	// --capture [frames]        PBO첽ǰframes֡浽capture/frame_NNNNN.png
+	// --capture-format <png|qoi|ppm> ¼Ƶļʽpngqoi̳߳б
+	// --capture-budget [MB]     еڴޣʱ¼ƲŻȴ
+	// --video <file|->          ÿ֡תBT.709 YUV 4:2:0дY4M"-"дstdoutܵffmpeg--capture֡
+	// --video-nv12              дԭʼNV12֡Y4M
+	// --video-fps [fps]         Y4Mͷ֡ʣĬ60
+	// --bench-video [frames]    1080p4KYUVתY4Mд֡ʣҪOpenGL
+	// --bench-jobs [threads]   ϵͳ1threadṣ߳Ĭÿһ޳صļٱȣҪOpenGL
+	// --gpu-memory              ˳ʱ𱨸Դֵÿ֡
+	// --check-allocations [frames] Ԥframes֡Ⱦ̲߳ٷڴ棬˳ʱз򷵻ط
+	// --bench-encode [frames]   ̺̳߳߳رQOI/PNGҪOpenGL
+	// --bench-capture [frames]  Ƚ4KglReadPixelsPBOռȾ̵߳ʱ˳
+	// --textures <dir>          ں̨Ŀ¼е.qoi/.ppmشڵױ߻ͼδʱʾռλ
+	// --bench-streaming [textures] ȽȾ̺߳ں̨ʽ1024x1024ʱһ֡˳
+	// --texture-compression <bc1|bc3|bc7> --texturesѹϴļݻcooked/
+	// --bench-compression [size] ̺̳߳߳ѹBC1/BC3/BC7RMSEͽʡԴ棬ҪOpenGL
+	// --mip-filter <box|kaiser|lanczos> --texturesں̨߳mipmapõ˲ĬkaiserԿռ˲
+	// --bench-mips [size]       box/Kaiser/Lanczosmipmap٤У2ݳߴalphaʣҪOpenGL
+	// --virtual-texture [pages] pages x pagesҳĳ򻯵ϵͿշУЩͼ飬Դֻй̶Сͼ
+	// --bench-virtual-texture [pages] mipmapԱȣpages x pagesҳĬ1024ĵϷУԴ治˳
+	// --build-archive <dir> <file> Ŀ¼µļɷֿLZ4ѹԴ˳
+	// --bench-archive [files]   ȽȡɢļʹڴӳԴвҡѹʱ䣬ҪOpenGL
+	// --startup-profile         ӡһ֡ʾ׶εĺʱ˳
+	// --eager-gl                ʱgladһGLǵһεʱŲңԱʱ
+	int benchUniformDraws = 0;
+	int benchInterpTriangles = 0;
+	int benchShaderTriangles = 0;
+	int benchDepthLayers = 0;
+	int benchMsaaTriangles = 0;
+	int benchSetupTriangles = 0;
+	int benchTextureSize = 0;
+	int msaaTestTriangles = 0;
+	int gpuCullObjects = 0;
+	int gpuCullTestObjects = 0;
+	int goldenFrames = 0;
+	int captureFrames = 0;
+	int benchCaptureFrames = 0;
+	string textureDirectory;
+	int benchStreamingTextures = 0;
+	string textureCompression;
+	int benchCompressionSize = 0;
+	string mipFilter;
+	int benchMipSize = 0;
+	int virtualTexturePages = 0;
+	int benchVirtualTexturePages = 0;
+	string archiveDirectory;
+	string archivePath;
+	int benchArchiveFiles = 0;
+	bool startupProfile = false;
+	bool eagerGL = false;
+	string captureFormat = "png";
+	int captureBudgetMB = 512;
+	int benchEncodeFrames = 0;
+	string videoPath;
+	bool videoNV12 = false;
+	int videoFps = 60;
+	int benchVideoFrames = 0;
+	bool benchJobs = false;
+	int benchJobThreads = 0;
+	bool gpuMemoryReport = false;
+	int checkAllocationsAfter = 0;
+	bool goldenUpdate = false;
+	for (int i = 1; i < argc; i++)
+	{
+		string arg = argv[i];
+		if (arg == "--bench-uniforms")
+			benchUniformDraws = optionalCount(argc, argv, i, 10000);
+		else if (arg == "--gpu-cull")
+			gpuCullObjects = optionalCount(argc, argv, i, 100000);
+		else if (arg == "--gpu-cull-test")
+			gpuCullTestObjects = optionalCount(argc, argv, i, 20000);
+		else if (arg == "--bench-interp")
+			benchInterpTriangles = optionalCount(argc, argv, i, 20000);
+		else if (arg == "--bench-shader")
+			benchShaderTriangles = optionalCount(argc, argv, i, 20000);
+		else if (arg == "--bench-depth")
+			benchDepthLayers = optionalCount(argc, argv, i, 16);
+		else if (arg == "--bench-msaa")
+			benchMsaaTriangles = optionalCount(argc, argv, i, 500);
+		else if (arg == "--bench-setup")
+			benchSetupTriangles = optionalCount(argc, argv, i, 100000);
+		else if (arg == "--bench-texture")
+			benchTextureSize = optionalCount(argc, argv, i, 2048);
+		else if (arg == "--msaa-test")
+			msaaTestTriangles = optionalCount(argc, argv, i, 500);
+		else if (arg == "--capture")
+			captureFrames = optionalCount(argc, argv, i, 300);
+		else if (arg == "--capture-format" && i + 1 < argc)
+			captureFormat = argv[++i];
+		else if (arg == "--capture-budget")
+			captureBudgetMB = optionalCount(argc, argv, i, 512);
+		else if (arg == "--video" && i + 1 < argc)
+			videoPath = argv[++i];
+		else if (arg == "--video-nv12")
+			videoNV12 = true;
+		else if (arg == "--video-fps")
+			videoFps = optionalCount(argc, argv, i, 60);
+		else if (arg == "--check-allocations")
+			checkAllocationsAfter = optionalCount(argc, argv, i, 60);
+		else if (arg == "--gpu-memory")
+			gpuMemoryReport = true;
+		else if (arg == "--bench-jobs")
+		{
+			benchJobs = true;
+			benchJobThreads = optionalCount(argc, argv, i, 0);
+		}
+		else if (arg == "--bench-video")
+			benchVideoFrames = optionalCount(argc, argv, i, 60);
+		else if (arg == "--bench-encode")
+			benchEncodeFrames = optionalCount(argc, argv, i, 60);
+		else if (arg == "--bench-capture")
+			benchCaptureFrames = optionalCount(argc, argv, i, 120);
+		else if (arg == "--textures" && i + 1 < argc)
+			textureDirectory = argv[++i];
+		else if (arg == "--bench-streaming")
+			benchStreamingTextures = optionalCount(argc, argv, i, 64);
+		else if (arg == "--texture-compression" && i + 1 < argc)
+			textureCompression = argv[++i];
+		else if (arg == "--bench-compression")
+			benchCompressionSize = optionalCount(argc, argv, i, 2048);
+		else if (arg == "--mip-filter" && i + 1 < argc)
+			mipFilter = argv[++i];
+		else if (arg == "--bench-mips")
+			benchMipSize = optionalCount(argc, argv, i, 2048);
+		else if (arg == "--virtual-texture")
+			virtualTexturePages = optionalCount(argc, argv, i, 512);
+		else if (arg == "--bench-virtual-texture")
+			benchVirtualTexturePages = optionalCount(argc, argv, i, 1024);
+		else if (arg == "--build-archive" && i + 2 < argc)
+		{
+			archiveDirectory = argv[++i];
+			archivePath = argv[++i];
+		}
+		else if (arg == "--bench-archive")
+			benchArchiveFiles = optionalCount(argc, argv, i, 2000);
+		else if (arg == "--startup-profile")
+			startupProfile = true;
+		else if (arg == "--eager-gl")
+			eagerGL = true;
+		else if (arg == "--golden" || arg == "--golden-update")
+		{
+			goldenUpdate = arg == "--golden-update";
+			goldenFrames = optionalCount(argc, argv, i, 3);
+		}
+		else
+			cout << "Unknown option " << arg << endl;
+	}
+	// goldenͼֻγGPU޳ʱ仯
+	if (goldenFrames > 0 && gpuCullObjects > 0)
+	{
+		cout << "--golden compares the triangle, ignoring --gpu-cull" << endl;
+		gpuCullObjects = 0;
+	}
+	if (goldenFrames > 0 && virtualTexturePages > 0)
+	{
+		cout << "--golden compares the triangle, ignoring --virtual-texture" << endl;
+		virtualTexturePages = 0;
+	}
+	bool benchmarkOnly = benchUniformDraws > 0 || gpuCullTestObjects > 0 || msaaTestTriangles > 0 || benchCaptureFrames > 0
+		|| benchStreamingTextures > 0 || benchVirtualTexturePages > 0;
+
+	// ɫCPUɫ׼ҲҪ
+	ShaderProgramDesc triangleDesc;
+	triangleDesc.vertexPath = "shaders/triangle.vert";
+	triangleDesc.fragmentPath = "shaders/triangle.frag";
+	triangleDesc.featureDefines = { "USE_VERTEX_COLOR", "USE_INSTANCING", "USE_DRAW_UNIFORMS", "USE_DRAW_BLOCK" };
+	triangleDesc.specializations = { ShaderSpecialization::floatConstant(0, "COLOR_SCALE", 1.0f) };
+
+	// CPUĻ׼Բ
+	if (benchInterpTriangles > 0)
+		return runInterpolationBenchmark(benchInterpTriangles);
+	if (benchShaderTriangles > 0)
+		return runShaderBenchmark(triangleDesc, benchShaderTriangles);
+	if (benchDepthLayers > 0)
+		return runDepthBenchmark(benchDepthLayers);
+	if (benchMsaaTriangles > 0)
+		return runMsaaBenchmark(benchMsaaTriangles);
+	if (benchSetupTriangles > 0)
+		return runSetupBenchmark(benchSetupTriangles);
+	if (benchTextureSize > 0)
+		return runTextureBenchmark(benchTextureSize);
+	if (benchEncodeFrames > 0)
+		return runEncodeBenchmark(benchEncodeFrames);
+	if (benchVideoFrames > 0)
+		return runVideoBenchmark(benchVideoFrames);
+	if (benchJobs)
+		return runJobBenchmark(benchJobThreads);
+	if (benchCompressionSize > 0)
+		return runCompressionBenchmark(benchCompressionSize);
+	if (benchMipSize > 0)
+		return runMipBenchmark(benchMipSize);
+	if (benchArchiveFiles > 0)
+		return runArchiveBenchmark(benchArchiveFiles);
+	if (!archiveDirectory.empty())
+	{
+		JobSystem jobs;
+		AssetArchiveBuilder builder;
+		AssetArchiveBuilder::Stats stats;
+		if (!builder.addDirectory(archiveDirectory) || !builder.write(archivePath, &jobs, &stats))
+			return 1;
+		cout << "Packed " << stats.assets << " files, " << stats.rawBytes / 1024 << " KB, into " << archivePath << ": "
+			<< stats.fileBytes / 1024 << " KB in " << stats.milliseconds << " ms" << endl;
+		return 0;
+	}
+	// Ƶдstdoutʱĵstderr
+	if (videoPath == "-")
+		cout.rdbuf(cerr.rdbuf());
+	if (!videoPath.empty() && captureFrames == 0)
+		captureFrames = INT_MAX;
+
 	// ʵGLFW
 	glfwInit();
 	glfwWindowHint(GLFW_CONTEXT_VERSION_MAJOR, 3);
 	glfwWindowHint(GLFW_CONTEXT_VERSION_MINOR, 3);
 	glfwWindowHint(GLFW_OPENGL_PROFILE, GLFW_OPENGL_CORE_PROFILE);
+	startup.mark("GLFW init");
 
 	//ڶ
 	//GLFWwindow* window = glfwCreateWindow(800, 600, "LearnOpenGL", NULL, NULL);
@@ -44,61 +299,28 @@ int main() {
 
 	//עframebuffer_size_callbackGLFWÿı䴰ڴСʱ
 	glfwSetFramebufferSizeCallback(window, framebuffer_size_callback);
+	startup.mark("window and context");
 
-	//ڵκopenglǰʼGLAD
-	if (!gladLoadGLLoader((GLADloadproc)glfwGetProcAddress))
+	//ڵκopenglǰʼGLÿһεʱŲҵַ
+	if (!loadGL((GLADloadproc)glfwGetProcAddress, eagerGL))
 	{
-		cout << "Failed to initialize GLAD" << endl;
+		cout << "Failed to initialize the GL loader" << endl;
 		return -1;
 	}
+	startup.mark("GL loader");
+	loadGLExtensions((GLADloadproc)glfwGetProcAddress);
+	startup.mark("GL extensions");
 
 	// build and compile our shader program
 	// ----------------
-	// vertex shader
-	unsigned int vertexShader = glCreateShader(GL_VERTEX_SHADER);
-	//ɫԴ븽ӵɫϣȻ
-	glShaderSource(vertexShader, 1, &vertexShaderSource, NULL);
-	glCompileShader(vertexShader);
-
-	// debug
-	int success;
-	char infoLog[512];
-	glGetShaderiv(vertexShader, GL_COMPILE_STATUS, &success);
-	if (!success)
+	// ɫshaders/Ŀ¼ȡļ޸ĺں̨߳±
+	ShaderHotReloader shader(triangleDesc);
+	if (!shader.start(window))
 	{
-		glGetShaderInfoLog(vertexShader, 512, NULL, infoLog);
-		cout << "ERROR::SHADER::VERTEX::COMPILATION_FAILED\n" << infoLog << endl;
-	}
-
-	//----------------
-	//fragment shader
-	unsigned int fragmentShader = glCreateShader(GL_FRAGMENT_SHADER);
-	glShaderSource(fragmentShader, 1, &fragmentShaderSource, NULL);
-	glCompileShader(fragmentShader);
-
-	// check for shader compiles errors
-	glGetShaderiv(fragmentShader, GL_COMPILE_STATUS, &success);
-	if (!success)
-	{
-		glGetShaderInfoLog(fragmentShader, 512, NULL, infoLog);
-		cout << "ERROR::SHADER::FRAGMENT::COMPILATION_FAILED\n" << infoLog << endl;
-	}
-
-	//ɫȾɫ
-	unsigned int shaderProgram = glCreateProgram();
-	glAttachShader(shaderProgram, vertexShader);
-	glAttachShader(shaderProgram, fragmentShader);
-	glLinkProgram(shaderProgram);
-
-	// check for linking errors
-	glGetProgramiv(shaderProgram, GL_LINK_STATUS, &success);
-	if (!success)
-	{
-		glGetProgramInfoLog(shaderProgram, 512, NULL, infoLog);
-		cout << "ERROR::SHADER::PROGRAM::LINKING_FAILED\n" << infoLog << endl;
+		glfwTerminate();
+		return -1;
 	}
-	glDeleteShader(vertexShader);
-	glDeleteShader(fragmentShader);
+	startup.mark("shader compile");
 
 	// set up vertex data
 	//, ÿзֱʾx, y, z
@@ -110,24 +332,151 @@ int main() {
 
 
 	// 
-	unsigned int VBO, VAO;
-	glGenVertexArrays(1, &VAO);
-	glGenBuffers(1, &VBO);
+	// ִglObjectsĳȡʱȵùǵ֡ɾ
+	GLVertexArray VAO = GLVertexArray::create();
+	GLBuffer VBO = GLBuffer::create();
 	//ѴĶ󶨵GL_ARRAY_BUFFER
-	glBindVertexArray(VAO);
-	glBindBuffer(GL_ARRAY_BUFFER, VBO);
+	glBindVertexArray(VAO.get());
+	glBindBuffer(GL_ARRAY_BUFFER, VBO.get());
 
 	glBufferData(GL_ARRAY_BUFFER, sizeof(vertices), vertices, GL_STATIC_DRAW);
+	gpuMemory.trackBuffer(VBO.get(), GPU_MEMORY_VERTEX, sizeof(vertices));
 	glVertexAttribPointer(0, 3, GL_FLOAT, GL_FALSE, 3 * sizeof(float), (void*)0);
 	glEnableVertexAttribArray(0);
 
 	glBindBuffer(GL_ARRAY_BUFFER, 0);
 	glBindVertexArray(0);
+	// ûκԵVAOֻgl_VertexIDĻƣöVBO֮
+	GLVertexArray emptyVAO = GLVertexArray::create();
+	startup.mark("buffer setup");
+
+
+	// GPU޳Χcompute shader׶޳ÿֻ֡һμӻ
+	ShaderProgramDesc objectDesc;
+	objectDesc.vertexPath = "shaders/object.vert";
+	objectDesc.fragmentPath = "shaders/object.frag";
+	ShaderHotReloader objectShader(objectDesc);
+	GpuCuller culler;
+	if (gpuCullObjects > 0)
+	{
+		if (objectShader.start(window) && culler.init("shaders/cull.comp", VBO.get(), 3, gpuCullObjects))
+		{
+			culler.setObjects(makeCullingScene(gpuCullObjects));
+		}
+		else
+		{
+			cout << "GPU culling unavailable, drawing the triangle instead" << endl;
+			gpuCullObjects = 0;
+		}
+	}
+
+	// ʽأ̳߳ؽ룬ĵļ߳̾PBOϴǰռλ
+	ShaderProgramDesc quadDesc;
+	quadDesc.vertexPath = "shaders/texture_quad.vert";
+	quadDesc.fragmentPath = "shaders/texture_quad.frag";
+	ShaderHotReloader quadShader(quadDesc);
+	TextureStreamer textureStreamer;
+	vector<int> textures;
+	if (textureCompression == "bc1")
+		textureStreamer.setCompression(BLOCK_FORMAT_BC1, "cooked");
+	else if (textureCompression == "bc3")
+		textureStreamer.setCompression(BLOCK_FORMAT_BC3, "cooked");
+	else if (textureCompression == "bc7")
+		textureStreamer.setCompression(BLOCK_FORMAT_BC7, "cooked");
+	else if (!textureCompression.empty())
+		cout << "Unknown texture compression " << textureCompression << ", loading uncompressed" << endl;
+	MipOptions mipOptions;
+	if (mipFilter == "box")
+		mipOptions.filter = MIP_FILTER_BOX;
+	else if (mipFilter == "lanczos")
+		mipOptions.filter = MIP_FILTER_LANCZOS;
+	else if (!mipFilter.empty() && mipFilter != "kaiser")
+		cout << "Unknown mip filter " << mipFilter << ", using kaiser" << endl;
+	textureStreamer.setMipOptions(mipOptions);
+	if (!textureDirectory.empty() && !benchmarkOnly && quadShader.start(window) && textureStreamer.start(window))
+	{
+		vector<string> paths;
+		error_code error;
+		for (const filesystem::directory_entry& entry : filesystem::directory_iterator(textureDirectory, error))
+		{
+			string extension = entry.path().extension().string();
+			if (extension == ".qoi" || extension == ".ppm")
+				paths.push_back(entry.path().string());
+		}
+		sort(paths.begin(), paths.end());
+		for (const string& path : paths)
+			textures.push_back(textureStreamer.load(path));
+		cout << "Streaming " << textures.size() << " textures from " << textureDirectory << endl;
+	}
+
+	// г120x120ҳpass¼ÿҪҳ̶̨߳ͼŽLRUͼ
+	ShaderProgramDesc terrainDesc;
+	terrainDesc.vertexPath = "shaders/virtual_texture.vert";
+	terrainDesc.fragmentPath = "shaders/virtual_texture.frag";
+	terrainDesc.featureDefines = { "VT_FEEDBACK", "VT_REFERENCE" };
+	ShaderHotReloader terrainShader(terrainDesc);
+	unique_ptr<ProceduralTerrainSource> terrainSource;
+	unique_ptr<VirtualTexture> virtualTexture;
+	if (virtualTexturePages > 0 && !benchmarkOnly)
+	{
+		terrainSource = make_unique<ProceduralTerrainSource>(virtualTexturePages);
+		virtualTexture = make_unique<VirtualTexture>(*terrainSource);
+		if (!terrainShader.start(window) || !virtualTexture->init())
+		{
+			cout << "Virtual texturing unavailable, drawing the triangle instead" << endl;
+			virtualTexture.reset();
+		}
+	}
 
+	// ׼ģʽ
+	int exitCode = 0;
+	if (benchUniformDraws > 0)
+		exitCode = runUniformBenchmark(window, shader.program(TRIANGLE_DRAW_UNIFORMS), shader.program(TRIANGLE_DRAW_BLOCK), VAO.get(), benchUniformDraws, 100);
+	if (gpuCullTestObjects > 0 && exitCode == 0)
+		exitCode = runGpuCullingSelfTest(gpuCullTestObjects);
+	if (msaaTestTriangles > 0 && exitCode == 0)
+		exitCode = runMsaaSelfTest(msaaTestTriangles);
+	if (benchCaptureFrames > 0 && exitCode == 0)
+		exitCode = runCaptureBenchmark(window, benchCaptureFrames);
+	if (benchStreamingTextures > 0 && exitCode == 0)
+		exitCode = runStreamingBenchmark(window, benchStreamingTextures);
+	if (benchVirtualTexturePages > 0 && exitCode == 0)
+		exitCode = runVirtualTextureBenchmark(benchVirtualTexturePages);
+
+	// ¼ƣglReadPixelsдPBǪ̵߳fenceӳ䲢дļ
+	unique_ptr<FrameSink> captureSink;
+	FrameEncoder* captureEncoder = nullptr;
+	VideoSink* captureVideo = nullptr;
+	if (captureFrames > 0 && !videoPath.empty())
+	{
+		captureVideo = new VideoSink(videoPath, videoNV12 ? VIDEO_LAYOUT_NV12 : VIDEO_LAYOUT_Y4M, videoFps);
+		captureSink.reset(captureVideo);
+	}
+	else if (captureFrames > 0 && captureFormat == "ppm")
+	{
+		captureSink = make_unique<PpmSequenceSink>("capture");
+	}
+	else if (captureFrames > 0)
+	{
+		captureEncoder = new FrameEncoder("capture", captureFormat == "qoi" ? FRAME_FORMAT_QOI : FRAME_FORMAT_PNG, 0,
+			(size_t)captureBudgetMB << 20);
+		captureSink.reset(captureEncoder);
+	}
+	FrameCapture capture;
+	if (captureFrames > 0 && !benchmarkOnly && !capture.start(window, captureSink.get()))
+		captureFrames = 0;
+
+	startup.mark("scene setup");
 
 	//ѭȾ
-	while (!glfwWindowShouldClose(window))
+	int frame = 0;
+	while (!benchmarkOnly && !glfwWindowShouldClose(window))
 	{
+		// ÿ֡ʱݴ֡arena䣬Ԥ֮֡Ӧ
+		frameArena.beginFrame();
+		if (checkAllocationsAfter > 0 && frame == checkAllocationsAfter)
+			armHeapGuard();
+
 		//
 		processInput(window);
 
@@ -135,28 +484,181 @@ int main() {
 		//-------------------
 		//ԶɫĻ
 		glClearColor(0.2f, 0.3f, 0.3f, 1.0f);
-		glClear(GL_COLOR_BUFFER_BIT);
+		glClear(GL_COLOR_BUFFER_BIT | GL_DEPTH_BUFFER_BIT);
 
 		
 		//
-		glUseProgram(shaderProgram);
-		glBindVertexArray(VAO);
-		glDrawArrays(GL_TRIANGLES, 0, 3);
-		
-
+		shader.update();
+		objectShader.update();
+		unsigned int objectProgram = objectShader.program();
+		if (gpuCullObjects > 0 && objectProgram)
+		{
+			int width, height;
+			glfwGetFramebufferSize(window, &width, &height);
+			Mat4 viewProj = cullingCamera((float)glfwGetTime(), (float)width / (height > 0 ? height : 1));
+			culler.cull(viewProj);
+
+			glEnable(GL_DEPTH_TEST);
+			glUseProgram(objectProgram);
+			glUniformMatrix4fv(glGetUniformLocation(objectProgram, "viewProj"), 1, GL_FALSE, viewProj.m);
+			culler.draw();
+			glDisable(GL_DEPTH_TEST);
+		}
+		else if (virtualTexture)
+		{
+			// һηغõͼ飬ٻ֡ķ󻭵
+			terrainShader.update();
+			unsigned int terrainProgram = terrainShader.program(0);
+			unsigned int feedbackProgram = terrainShader.program(1);
+			int width, height;
+			glfwGetFramebufferSize(window, &width, &height);
+			Mat4 viewProj = terrainCamera((float)glfwGetTime(), (float)width / (height > 0 ? height : 1));
+			virtualTexture->update();
+			glBindVertexArray(emptyVAO.get());
+			if (feedbackProgram)
+			{
+				virtualTexture->beginFeedback(width, height);
+				glUseProgram(feedbackProgram);
+				virtualTexture->bind(feedbackProgram, true);
+				glUniformMatrix4fv(glGetUniformLocation(feedbackProgram, "viewProj"), 1, GL_FALSE, viewProj.m);
+				glUniform1f(glGetUniformLocation(feedbackProgram, "planeSize"), TERRAIN_PLANE_SIZE);
+				glDrawArrays(GL_TRIANGLES, 0, 6);
+				virtualTexture->endFeedback();
+			}
+			if (terrainProgram)
+			{
+				glUseProgram(terrainProgram);
+				virtualTexture->bind(terrainProgram, false);
+				glUniformMatrix4fv(glGetUniformLocation(terrainProgram, "viewProj"), 1, GL_FALSE, viewProj.m);
+				glUniform1f(glGetUniformLocation(terrainProgram, "planeSize"), TERRAIN_PLANE_SIZE);
+				glDrawArrays(GL_TRIANGLES, 0, 6);
+			}
+		}
+		else
+		{
+			unsigned int triangleProgram = shader.program(0);
+			if (triangleProgram)
+			{
+				glUseProgram(triangleProgram);
+				glBindVertexArray(VAO.get());
+				glDrawArrays(GL_TRIANGLES, 0, 3);
+			}
+		}
+
+		// ͼشڵױУÿ8
+		textureStreamer.update();
+		quadShader.update();
+		unsigned int quadProgram = quadShader.program();
+		if (!textures.empty() && quadProgram)
+		{
+			const int perRow = 8;
+			const float size = 2.0f / perRow;
+			glUseProgram(quadProgram);
+			glUniform1i(glGetUniformLocation(quadProgram, "image"), 0);
+			GLint rectLocation = glGetUniformLocation(quadProgram, "rect");
+			glBindVertexArray(emptyVAO.get());
+			glActiveTexture(GL_TEXTURE0);
+			for (size_t i = 0; i < textures.size(); i++)
+			{
+				float x = -1.0f + (i % perRow) * size, y = -1.0f + (i / perRow) * size;
+				glUniform4f(rectLocation, x, y, x + size, y + size);
+				glBindTexture(GL_TEXTURE_2D, textureStreamer.texture(textures[i]));
+				glDrawArrays(GL_TRIANGLES, 0, 6);
+			}
+			glBindTexture(GL_TEXTURE_2D, 0);
+		}
+
+		// goldenģʽǰصgoldenFrames֡
+		if (goldenFrames > 0 && frame + 1 == goldenFrames)
+		{
+			int width, height;
+			glfwGetFramebufferSize(window, &width, &height);
+			exitCode = runGoldenTest(triangleDesc, vertices, 3, width, height, "triangle", goldenUpdate);
+			break;
+		}
+
+		if (capture.stats().frames < (uint64_t)captureFrames)
+		{
+			int width, height;
+			glfwGetFramebufferSize(window, &width, &height);
+			capture.capture(width, height);
+		}
+
+		// ɾ֡ͷŵGLҪfence
+		glObjects.endFrame();
+		gpuMemory.endFrame();
 
 		//鲢¼
 		glfwSwapBuffers(window);
+		// һ֡ꡢGPU
+		if (startupProfile && frame == 0)
+		{
+			glFinish();
+			startup.mark("first frame");
+			startup.report("Startup");
+			break;
+		}
 		glfwPollEvents();
+		frame++;
+	}
+
+	if (checkAllocationsAfter > 0)
+	{
+		HeapGuardCounts heap = disarmHeapGuard();
+		cout << max(frame - checkAllocationsAfter, 0) << " frames after warm-up: " << heap.allocations << " heap allocations ("
+			<< heap.bytes << " bytes), frame arena high water " << frameArena.highWater() << " bytes" << endl;
+		if (heap.allocations > 0)
+		{
+			cout << "ERROR::RENDER_LOOP::HEAP_ALLOCATIONS the first was " << heap.firstSize << " bytes" << endl;
+			if (exitCode == 0)
+				exitCode = 1;
+		}
+	}
+
+	if (captureFrames > 0)
+	{
+		capture.stop();
+		FrameCapture::Stats stats = capture.stats();
+		cout << "Captured " << stats.frames << " frames, " << (stats.frames ? stats.issueMilliseconds / stats.frames : 0.0)
+			<< " ms per frame on the render thread, " << stats.stalls << " stalls" << endl;
+		if (captureEncoder)
+		{
+			FrameEncoder::Stats encoded = captureEncoder->stats();
+			cout << "Encoded " << encoded.rawBytes / (1 << 20) << " MB into " << encoded.encodedBytes / (1 << 20) << " MB, "
+				<< encoded.budgetWaits << " waits for the memory budget (" << encoded.waitMilliseconds << " ms)" << endl;
+		}
+		if (captureVideo)
+		{
+			VideoSink::Stats video = captureVideo->stats();
+			cout << "Wrote " << video.bytes / (1 << 20) << " MB of video, " << (video.frames ? video.convertMilliseconds / video.frames : 0.0)
+				<< " ms per frame converting, " << video.writeWaits << " waits for the writer" << endl;
+		}
 	}
 
-	glDeleteVertexArrays(1, &VAO);
-	glDeleteBuffers(1, &VBO);
+	if (gpuMemoryReport)
+		gpuMemory.report("GPU memory");
+	VAO.reset();
+	emptyVAO.reset();
+	VBO.reset();
+	culler.release();
+	textureStreamer.stop();
+	if (virtualTexture)
+	{
+		VirtualTexture::Stats stats = virtualTexture->stats();
+		cout << "Virtual texture: " << stats.tilesUploaded << " tiles uploaded, " << stats.evictions << " evicted, "
+			<< (stats.pagesRequested ? 100.0 * stats.pagesResident / stats.pagesRequested : 0.0) << "% of requested pages resident" << endl;
+		virtualTexture->release();
+	}
+	glObjects.release();
+	quadShader.stop();
+	terrainShader.stop();
+	objectShader.stop();
+	shader.stop();
 
 	// ͷԴ
 	glfwTerminate();
 
-	return 0;
+	return exitCode;
 }
 
 // ǷEsc
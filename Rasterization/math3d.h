@@ -0,0 +1,118 @@
+#ifndef MATH3D_H
+#define MATH3D_H
+
+#include <cmath>
+
+// The little bit of matrix math the renderer needs. Matrices are column
+// major like GLSL, so m[12..14] is the translation and a Mat4 can be passed
+// straight to glUniformMatrix4fv with transpose = GL_FALSE.
+
+struct Vec3
+{
+	float x, y, z;
+};
+
+struct Vec4
+{
+	float x, y, z, w;
+};
+
+struct Mat4
+{
+	float m[16];
+
+	float& at(int row, int column) { return m[column * 4 + row]; }
+	float at(int row, int column) const { return m[column * 4 + row]; }
+};
+
+inline Vec3 operator+(Vec3 a, Vec3 b) { return { a.x + b.x, a.y + b.y, a.z + b.z }; }
+inline Vec3 operator-(Vec3 a, Vec3 b) { return { a.x - b.x, a.y - b.y, a.z - b.z }; }
+inline Vec3 operator*(Vec3 a, float s) { return { a.x * s, a.y * s, a.z * s }; }
+inline float dot(Vec3 a, Vec3 b) { return a.x * b.x + a.y * b.y + a.z * b.z; }
+inline Vec3 cross(Vec3 a, Vec3 b) { return { a.y * b.z - a.z * b.y, a.z * b.x - a.x * b.z, a.x * b.y - a.y * b.x }; }
+inline Vec3 normalize(Vec3 v) { return v * (1.0f / std::sqrt(dot(v, v))); }
+
+inline Mat4 identity()
+{
+	Mat4 r = {};
+	r.m[0] = r.m[5] = r.m[10] = r.m[15] = 1.0f;
+	return r;
+}
+
+inline Mat4 operator*(const Mat4& a, const Mat4& b)
+{
+	Mat4 r;
+	for (int column = 0; column < 4; column++)
+	{
+		for (int row = 0; row < 4; row++)
+		{
+			float sum = 0.0f;
+			for (int k = 0; k < 4; k++)
+				sum += a.at(row, k) * b.at(k, column);
+			r.at(row, column) = sum;
+		}
+	}
+	return r;
+}
+
+inline Vec4 operator*(const Mat4& a, Vec4 v)
+{
+	return {
+		a.m[0] * v.x + a.m[4] * v.y + a.m[8] * v.z + a.m[12] * v.w,
+		a.m[1] * v.x + a.m[5] * v.y + a.m[9] * v.z + a.m[13] * v.w,
+		a.m[2] * v.x + a.m[6] * v.y + a.m[10] * v.z + a.m[14] * v.w,
+		a.m[3] * v.x + a.m[7] * v.y + a.m[11] * v.z + a.m[15] * v.w,
+	};
+}
+
+// same as glm::perspective (right handed, clip z in [-w, w])
+inline Mat4 perspective(float fovyRadians, float aspect, float zNear, float zFar)
+{
+	float f = 1.0f / std::tan(fovyRadians * 0.5f);
+	Mat4 r = {};
+	r.at(0, 0) = f / aspect;
+	r.at(1, 1) = f;
+	r.at(2, 2) = (zFar + zNear) / (zNear - zFar);
+	r.at(2, 3) = 2.0f * zFar * zNear / (zNear - zFar);
+	r.at(3, 2) = -1.0f;
+	return r;
+}
+
+// same as glm::lookAt
+inline Mat4 lookAt(Vec3 eye, Vec3 center, Vec3 up)
+{
+	Vec3 f = normalize(center - eye);
+	Vec3 s = normalize(cross(f, up));
+	Vec3 u = cross(s, f);
+	Mat4 r = identity();
+	r.at(0, 0) = s.x; r.at(0, 1) = s.y; r.at(0, 2) = s.z;
+	r.at(1, 0) = u.x; r.at(1, 1) = u.y; r.at(1, 2) = u.z;
+	r.at(2, 0) = -f.x; r.at(2, 1) = -f.y; r.at(2, 2) = -f.z;
+	r.at(0, 3) = -dot(s, eye);
+	r.at(1, 3) = -dot(u, eye);
+	r.at(2, 3) = dot(f, eye);
+	return r;
+}
+
+// the six planes (left, right, bottom, top, near, far) of a view-projection
+// matrix, normalized and pointing inwards: dot(plane.xyz, p) + plane.w >= 0 inside
+inline void frustumPlanes(const Mat4& viewProj, Vec4 planes[6])
+{
+	for (int i = 0; i < 3; i++)
+	{
+		for (int side = 0; side < 2; side++)
+		{
+			float sign = side == 0 ? 1.0f : -1.0f;
+			Vec4 p = {
+				viewProj.at(3, 0) + sign * viewProj.at(i, 0),
+				viewProj.at(3, 1) + sign * viewProj.at(i, 1),
+				viewProj.at(3, 2) + sign * viewProj.at(i, 2),
+				viewProj.at(3, 3) + sign * viewProj.at(i, 3),
+			};
+			float length = std::sqrt(p.x * p.x + p.y * p.y + p.z * p.z);
+			planes[i * 2 + side] = { p.x / length, p.y / length, p.z / length, p.w / length };
+		}
+	}
+}
+
+#endif
@@ -0,0 +1,365 @@
+#include "mip_generator.h"
+#include "job_system.h"
+#include "simd.h"
+
+#include <algorithm>
+#include <cmath>
+#include <cstring>
+
+using namespace std;
+
+const char* mipFilterName(MipFilter filter)
+{
+	switch (filter)
+	{
+	case MIP_FILTER_BOX: return "box";
+	case MIP_FILTER_KAISER: return "Kaiser";
+	case MIP_FILTER_LANCZOS: return "Lanczos";
+	default: return "?";
+	}
+}
+
+static const double PI = 3.14159265358979323846;
+static const double KAISER_ALPHA = 4.0;
+static const double SINC_RADIUS = 3.0;		// Kaiser and Lanczos, in texels of the new level
+
+static double sinc(double x)
+{
+	return x == 0.0 ? 1.0 : sin(PI * x) / (PI * x);
+}
+
+// modified Bessel function of the first kind, order 0, by its series
+static double besselI0(double x)
+{
+	double sum = 1.0, term = 1.0;
+	for (int k = 1; term > sum * 1e-12; k++)
+	{
+		term *= (x * x / 4.0) / ((double)k * k);
+		sum += term;
+	}
+	return sum;
+}
+
+// x in texels of the new level from its center
+static double filterWeight(MipFilter filter, double x)
+{
+	x = fabs(x);
+	if (x >= SINC_RADIUS)
+		return 0.0;
+	if (filter == MIP_FILTER_KAISER)
+	{
+		double t = x / SINC_RADIUS;
+		return sinc(x) * besselI0(KAISER_ALPHA * sqrt(1.0 - t * t)) / besselI0(KAISER_ALPHA);
+	}
+	return sinc(x) * sinc(x / SINC_RADIUS);
+}
+
+// One axis of a level: new texel i is the sum over k < taps of
+// weight[k][i] times source texel index[k][i]. Tap-major, so the k-th taps
+// of 8 neighbouring texels are one load; sizes are padded to 8 with taps of
+// weight 0.
+struct Resampler
+{
+	int taps = 0;
+	int padded = 0;
+	vector<int32_t> index;
+	vector<float> weight;
+
+	void build(MipFilter filter, int sourceSize, int size)
+	{
+		const double scale = (double)sourceSize / size;
+		const double support = filter == MIP_FILTER_BOX ? 0.5 * scale : SINC_RADIUS * scale;
+		const int span = (int)ceil(2.0 * support) + 2;
+		vector<int> first(size);
+		vector<double> weights((size_t)size * span);
+		taps = 1;
+		for (int i = 0; i < size; i++)
+		{
+			double center = (i + 0.5) * scale;
+			int start = (int)floor(center - support) - 1;
+			double* w = &weights[(size_t)i * span];
+			double sum = 0.0;
+			int lowest = span, highest = -1;
+			for (int k = 0; k < span; k++)
+			{
+				int j = start + k;
+				if (filter == MIP_FILTER_BOX)
+					w[k] = max(0.0, min(j + 1.0, center + support) - max((double)j, center - support));
+				else
+					w[k] = filterWeight(filter, (j + 0.5 - center) / scale);
+				if (fabs(w[k]) > 1e-7)
+				{
+					lowest = min(lowest, k);
+					highest = max(highest, k);
+				}
+				sum += w[k];
+			}
+			for (int k = 0; k < span; k++)
+				w[k] /= sum;
+			// only the taps that count
+			memmove(w, w + lowest, (highest - lowest + 1) * sizeof(double));
+			fill(w + highest - lowest + 1, w + span, 0.0);
+			first[i] = start + lowest;
+			taps = max(taps, highest - lowest + 1);
+		}
+
+		padded = (size + 7) & ~7;
+		index.assign((size_t)taps * padded, 0);
+		weight.assign((size_t)taps * padded, 0.0f);
+		for (int i = 0; i < size; i++)
+		{
+			for (int k = 0; k < taps; k++)
+			{
+				// past the edges the edge texel repeats, like GL_CLAMP_TO_EDGE
+				index[(size_t)k * padded + i] = min(max(first[i] + k, 0), sourceSize - 1);
+				weight[(size_t)k * padded + i] = (float)weights[(size_t)i * span + k];
+			}
+		}
+	}
+};
+
+// premultiplied linear RGBA, a plane per channel, rows padded to 8 floats
+struct LinearImage
+{
+	int width = 0;
+	int height = 0;
+	int stride = 0;
+	vector<float> data;
+
+	void resize(int w, int h)
+	{
+		width = w;
+		height = h;
+		stride = (w + 7) & ~7;
+		// every float, padding included, is written before it's read
+		data.resize((size_t)4 * stride * h);
+	}
+	float* row(int channel, int y) { return &data[((size_t)channel * height + y) * stride]; }
+	const float* row(int channel, int y) const { return &data[((size_t)channel * height + y) * stride]; }
+};
+
+// a^p for a >= 0 and p > 0, exactly 0 for 0
+static SIMD_INLINE vec8f power(vec8f a, float p)
+{
+	return select(a > vec8f::zero(), exp2(log2(a) * vec8f(p)), vec8f::zero());
+}
+
+static SIMD_INLINE vec8f linearToSrgb(vec8f v)
+{
+	vec8f curve = madd(power(v, 1.0f / 2.4f), vec8f(1.055f), vec8f(-0.055f));
+	return select(v <= vec8f(0.0031308f), v * vec8f(12.92f), curve);
+}
+
+// rows [begin, end) on the job system's threads, or here without one; small
+// levels aren't worth splitting
+template<class Body>
+static void forRows(JobSystem* jobs, int rows, const Body& body)
+{
+	if (jobs && rows >= 16)
+		jobs->parallelFor(0, rows, [&](size_t begin, size_t end) { body((int)begin, (int)end); });
+	else
+		body(0, rows);
+}
+
+static void toLinear(const RgbaImage& image, bool srgb, LinearImage& linear, JobSystem* jobs)
+{
+	alignas(32) static float srgbToLinear[256];
+	static bool tableReady = [] {
+		for (int i = 0; i < 256; i++)
+		{
+			double v = i / 255.0;
+			srgbToLinear[i] = (float)(v <= 0.04045 ? v / 12.92 : pow((v + 0.055) / 1.055, 2.4));
+		}
+		return true;
+	}();
+	(void)tableReady;
+
+	linear.resize(image.width, image.height);
+	forRows(jobs, image.height, [&](int begin, int end) {
+		alignas(32) uint32_t tail[8];
+		for (int y = begin; y < end; y++)
+		{
+			const uint32_t* source = image.row(y);
+			for (int x = 0; x < image.width; x += 8)
+			{
+				vec8i pixels;
+				if (x + 8 <= image.width)
+				{
+					pixels = vec8i::loadu(source + x);
+				}
+				else
+				{
+					for (int i = 0; i < 8; i++)
+						tail[i] = source[min(x + i, image.width - 1)];
+					pixels = vec8i::load(tail);
+				}
+				vec8f alpha = toFloat(shiftRight<24>(pixels)) * vec8f(1.0f / 255.0f);
+				alpha.storeu(linear.row(3, y) + x);
+				vec8i rgb[3] = { pixels & vec8i(0xff), shiftRight<8>(pixels) & vec8i(0xff), shiftRight<16>(pixels) & vec8i(0xff) };
+				for (int c = 0; c < 3; c++)
+				{
+					vec8f v = srgb ? gather(srgbToLinear, rgb[c]) : toFloat(rgb[c]) * vec8f(1.0f / 255.0f);
+					(v * alpha).storeu(linear.row(c, y) + x);
+				}
+			}
+		}
+	});
+}
+
+// source rows resampled across into temporary, every channel
+static void resampleRows(const LinearImage& source, const Resampler& across, LinearImage& temporary, JobSystem* jobs)
+{
+	forRows(jobs, source.height, [&](int begin, int end) {
+		for (int c = 0; c < 4; c++)
+		{
+			for (int y = begin; y < end; y++)
+			{
+				const float* in = source.row(c, y);
+				float* out = temporary.row(c, y);
+				for (int x = 0; x < across.padded; x += 8)
+				{
+					vec8f sum = vec8f::zero();
+					for (int k = 0; k < across.taps; k++)
+					{
+						size_t tap = (size_t)k * across.padded + x;
+						sum = madd(gather(in, vec8i::loadu(&across.index[tap])), vec8f::loadu(&across.weight[tap]), sum);
+					}
+					sum.storeu(out + x);
+				}
+			}
+		}
+	});
+}
+
+// temporary's columns resampled down into level; the sincs ring below 0
+// and past the alpha, which a premultiplied color can't be
+static void resampleColumns(const LinearImage& temporary, const Resampler& down, LinearImage& level, JobSystem* jobs)
+{
+	forRows(jobs, level.height, [&](int begin, int end) {
+		for (int y = begin; y < end; y++)
+		{
+			for (int x = 0; x < level.stride; x += 8)
+			{
+				vec8f sum[4] = { vec8f::zero(), vec8f::zero(), vec8f::zero(), vec8f::zero() };
+				for (int k = 0; k < down.taps; k++)
+				{
+					size_t tap = (size_t)k * down.padded + y;
+					vec8f w(down.weight[tap]);
+					for (int c = 0; c < 4; c++)
+						sum[c] = madd(vec8f::loadu(temporary.row(c, down.index[tap]) + x), w, sum[c]);
+				}
+				vec8f alpha = clamp(sum[3], vec8f::zero(), vec8f(1.0f));
+				alpha.storeu(level.row(3, y) + x);
+				for (int c = 0; c < 3; c++)
+					clamp(sum[c], vec8f::zero(), alpha).storeu(level.row(c, y) + x);
+			}
+		}
+	});
+}
+
+// texels whose alpha, times scale, passes cutoff; the padding is 0
+static size_t alphaCoverage(const LinearImage& level, float scale, float cutoff)
+{
+	size_t count = 0;
+	for (int y = 0; y < level.height; y++)
+	{
+		const float* alpha = level.row(3, y);
+		for (int x = 0; x < level.stride; x += 8)
+			count += bitCount(movemask(vec8f::loadu(alpha + x) * vec8f(scale) >= vec8f(cutoff)));
+	}
+	return count;
+}
+
+// the smallest alpha scale that covers at least coverage of level's texels
+static float coverageScale(const LinearImage& level, float cutoff, double coverage)
+{
+	size_t target = (size_t)ceil(coverage * level.width * level.height - 1e-9);
+	if (alphaCoverage(level, 1.0f, cutoff) == target)
+		return 1.0f;
+	float low = 0.0f, high = 1.0f;
+	while (alphaCoverage(level, high, cutoff) < target && high < 1024.0f)
+		high *= 2.0f;
+	for (int i = 0; i < 20; i++)
+	{
+		float middle = (low + high) * 0.5f;
+		if (alphaCoverage(level, middle, cutoff) < target)
+			low = middle;
+		else
+			high = middle;
+	}
+	return high;
+}
+
+static void toRgba(const LinearImage& level, bool srgb, float alphaScale, RgbaImage& image, JobSystem* jobs)
+{
+	image.resize(level.width, level.height);
+	forRows(jobs, level.height, [&](int begin, int end) {
+		alignas(32) uint32_t tail[8];
+		for (int y = begin; y < end; y++)
+		{
+			uint32_t* out = image.row(y);
+			for (int x = 0; x < level.width; x += 8)
+			{
+				vec8f alpha = vec8f::loadu(level.row(3, y) + x);
+				vec8f inverse = select(alpha > vec8f::zero(), vec8f(1.0f) / max(alpha, vec8f(1e-30f)), vec8f::zero());
+				vec8i pixels = toIntRound(min(alpha * vec8f(alphaScale), vec8f(1.0f)) * vec8f(255.0f));
+				pixels = shiftLeft<24>(pixels);
+				for (int c = 0; c < 3; c++)
+				{
+					vec8f v = min(vec8f::loadu(level.row(c, y) + x) * inverse, vec8f(1.0f));
+					if (srgb)
+						v = linearToSrgb(v);
+					vec8i value = toIntRound(v * vec8f(255.0f));
+					pixels = pixels | (c == 0 ? value : c == 1 ? shiftLeft<8>(value) : shiftLeft<16>(value));
+				}
+				if (x + 8 <= level.width)
+				{
+					pixels.storeu(out + x);
+				}
+				else
+				{
+					pixels.store(tail);
+					copy(tail, tail + level.width - x, out + x);
+				}
+			}
+		}
+	});
+}
+
+void generateMips(const RgbaImage& image, const MipOptions& options, vector<RgbaImage>& mips, JobSystem* jobs)
+{
+	mips.clear();
+	if (image.width <= 0 || image.height <= 0 || (image.width == 1 && image.height == 1))
+		return;
+
+	double coverage = 0.0;
+	const bool keepCoverage = options.alphaCutoff > 0.0f;
+	if (keepCoverage)
+	{
+		size_t covered = 0;
+		for (uint32_t pixel : image.pixels)
+			covered += (pixel >> 24) / 255.0f >= options.alphaCutoff ? 1 : 0;
+		coverage = (double)covered / image.pixels.size();
+	}
+
+	LinearImage levels[2], temporary;
+	toLinear(image, options.srgb, levels[0], jobs);
+	Resampler across, down;
+	for (int level = 1; levels[(level - 1) & 1].width > 1 || levels[(level - 1) & 1].height > 1; level++)
+	{
+		const LinearImage& source = levels[(level - 1) & 1];
+		LinearImage& target = levels[level & 1];
+		const int width = max(source.width / 2, 1), height = max(source.height / 2, 1);
+		across.build(options.filter, source.width, width);
+		down.build(options.filter, source.height, height);
+
+		temporary.resize(width, source.height);
+		resampleRows(source, across, temporary, jobs);
+		target.resize(width, height);
+		resampleColumns(temporary, down, target, jobs);
+
+		float alphaScale = keepCoverage ? coverageScale(target, options.alphaCutoff, coverage) : 1.0f;
+		mips.emplace_back();
+		toRgba(target, options.srgb, alphaScale, mips.back(), jobs);
+	}
+}
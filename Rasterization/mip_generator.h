@@ -0,0 +1,37 @@
+#ifndef MIP_GENERATOR_H
+#define MIP_GENERATOR_H
+
+#include <vector>
+
+#include "image_compare.h"
+
+class JobSystem;
+
+enum MipFilter
+{
+	MIP_FILTER_BOX,			// the average of the texels under each new one, like glGenerateMipmap
+	MIP_FILTER_KAISER,		// Kaiser windowed sinc, 3 texels wide: sharp with little ringing
+	MIP_FILTER_LANCZOS,		// Lanczos 3: sharpest, rings the most at hard edges
+};
+
+const char* mipFilterName(MipFilter filter);
+
+struct MipOptions
+{
+	MipFilter filter = MIP_FILTER_KAISER;
+	bool srgb = true;			// RGB is sRGB encoded: filtered in linear light and encoded back
+	float alphaCutoff = 0.0f;	// above 0 alpha is tested against it: each level keeps the coverage of the top one
+};
+
+// Levels 1 and down of image's mip chain, to 1x1, into mips. Any size
+// works: a level is half the one above, rounded down, and the filter is
+// stretched to the exact ratio, so an odd row or column is spread over its
+// neighbours instead of dropped. Colors are filtered premultiplied by alpha
+// and in float, each level made from the float level above, so nothing is
+// rounded twice. Each level is a horizontal pass, 8 texels at once with
+// gathers, and a vertical one 8 texels of a row at once; with a job system
+// both are spread over its threads by rows (call it from the thread that
+// made the job system then).
+void generateMips(const RgbaImage& image, const MipOptions& options, std::vector<RgbaImage>& mips, JobSystem* jobs = nullptr);
+
+#endif
@@ -0,0 +1,213 @@
+#include "shader_preprocessor.h"
+#include "shader_utils.h"
+
+#include <algorithm>
+#include <cctype>
+#include <filesystem>
+#include <sstream>
+
+using namespace std;
+namespace fs = std::filesystem;
+
+// guards against include cycles that slip past #pragma once
+static const int MAX_INCLUDE_DEPTH = 32;
+
+static string canonicalPath(const string& path)
+{
+	error_code ec;
+	fs::path p = fs::weakly_canonical(fs::path(path), ec);
+	return ec ? path : p.generic_string();
+}
+
+// if line is a preprocessor directive, return its keyword and the text after it
+static bool parseDirective(const string& line, string& keyword, string& rest)
+{
+	size_t i = line.find_first_not_of(" \t");
+	if (i == string::npos || line[i] != '#')
+		return false;
+	i = line.find_first_not_of(" \t", i + 1);
+	if (i == string::npos)
+		return false;
+
+	size_t end = i;
+	while (end < line.size() && (isalnum((unsigned char)line[end]) || line[end] == '_'))
+		end++;
+	keyword = line.substr(i, end - i);
+	size_t restStart = line.find_first_not_of(" \t", end);
+	rest = restStart == string::npos ? string() : line.substr(restStart);
+	while (!rest.empty() && (rest.back() == '\r' || rest.back() == ' ' || rest.back() == '\t'))
+		rest.pop_back();
+	return true;
+}
+
+static bool containsIdentifier(const string& text, const string& name)
+{
+	for (size_t pos = text.find(name); pos != string::npos; pos = text.find(name, pos + 1))
+	{
+		bool startOk = pos == 0 || !(isalnum((unsigned char)text[pos - 1]) || text[pos - 1] == '_');
+		size_t after = pos + name.size();
+		bool endOk = after >= text.size() || !(isalnum((unsigned char)text[after]) || text[after] == '_');
+		if (startOk && endOk)
+			return true;
+	}
+	return false;
+}
+
+uint64_t hashShaderSource(const string& source, uint64_t seed)
+{
+	uint64_t hash = seed;
+	for (unsigned char c : source)
+	{
+		hash ^= c;
+		hash *= 1099511628211ull;
+	}
+	return hash;
+}
+
+void ShaderPreprocessor::addIncludeDir(const string& dir)
+{
+	includeDirs.push_back(dir);
+}
+
+string ShaderPreprocessor::resolve(const string& name, const string& includer, bool angled) const
+{
+	if (!angled)
+	{
+		fs::path local = fs::path(includer).parent_path() / name;
+		if (fs::exists(local))
+			return local.generic_string();
+	}
+	for (const string& dir : includeDirs)
+	{
+		fs::path candidate = fs::path(dir) / name;
+		if (fs::exists(candidate))
+			return candidate.generic_string();
+	}
+	return string();
+}
+
+bool ShaderPreprocessor::expand(const string& path, int depth, string& body, string* error)
+{
+	string canonical = canonicalPath(path);
+	if (find(onceFiles.begin(), onceFiles.end(), canonical) != onceFiles.end())
+		return true;
+	if (depth > MAX_INCLUDE_DEPTH || find(includeStack.begin(), includeStack.end(), canonical) != includeStack.end())
+	{
+		if (error)
+			*error = "include cycle through " + path;
+		return false;
+	}
+
+	string source;
+	if (!readTextFile(path, source))
+	{
+		if (error)
+			*error = "can't read " + path;
+		return false;
+	}
+
+	int fileIndex = (int)files.size();
+	files.push_back(path);
+	includeStack.push_back(canonical);
+	body += "#line 1 " + to_string(fileIndex) + "\n";
+
+	istringstream lines(source);
+	string line, keyword, rest;
+	int lineNumber = 0;
+	while (getline(lines, line))
+	{
+		lineNumber++;
+		if (!parseDirective(line, keyword, rest))
+		{
+			body += line;
+			body += '\n';
+			continue;
+		}
+
+		if (keyword == "version")
+		{
+			if (depth > 0 || !version.empty())
+			{
+				if (error)
+					*error = path + ":" + to_string(lineNumber) + ": #version is only allowed once, in the root file";
+				return false;
+			}
+			// hoisted to the top of the output, keep the line count intact
+			version = line;
+			body += '\n';
+		}
+		else if (keyword == "extension" && rest.compare(0, 27, "GL_GOOGLE_include_directive") == 0)
+		{
+			// only there so glslangValidator accepts #include, drivers don't know it
+			body += '\n';
+		}
+		else if (keyword == "pragma" && rest == "once")
+		{
+			onceFiles.push_back(canonical);
+			body += '\n';
+		}
+		else if (keyword == "include")
+		{
+			bool angled = !rest.empty() && rest[0] == '<';
+			char close = angled ? '>' : '"';
+			size_t end = rest.find(close, 1);
+			if (rest.size() < 2 || (rest[0] != '"' && rest[0] != '<') || end == string::npos)
+			{
+				if (error)
+					*error = path + ":" + to_string(lineNumber) + ": malformed #include";
+				return false;
+			}
+
+			string name = rest.substr(1, end - 1);
+			string resolved = resolve(name, path, angled);
+			if (resolved.empty())
+			{
+				if (error)
+					*error = path + ":" + to_string(lineNumber) + ": can't find include " + name;
+				return false;
+			}
+			if (!expand(resolved, depth + 1, body, error))
+				return false;
+			body += "#line " + to_string(lineNumber + 1) + " " + to_string(fileIndex) + "\n";
+		}
+		else
+		{
+			body += line;
+			body += '\n';
+		}
+	}
+
+	includeStack.pop_back();
+	return true;
+}
+
+bool ShaderPreprocessor::process(const string& path, const vector<ShaderDefine>& defines, string& out, string* error)
+{
+	files.clear();
+	onceFiles.clear();
+	includeStack.clear();
+	version.clear();
+
+	string body;
+	if (!expand(path, 0, body, error))
+		return false;
+
+	out.clear();
+	out.reserve(body.size() + 256);
+	if (!version.empty())
+	{
+		out += version;
+		out += '\n';
+	}
+	for (const ShaderDefine& define : defines)
+	{
+		if (!containsIdentifier(body, define.name))
+			continue;
+		out += "#define " + define.name;
+		if (!define.value.empty())
+			out += " " + define.value;
+		out += '\n';
+	}
+	out += body;
+	return true;
+}
@@ -0,0 +1,48 @@
+#ifndef SHADER_PREPROCESSOR_H
+#define SHADER_PREPROCESSOR_H
+
+#include <cstdint>
+#include <string>
+#include <vector>
+
+struct ShaderDefine
+{
+	std::string name;
+	std::string value;
+};
+
+// Expands a GLSL file before it is handed to glShaderSource:
+//  - #include "file" / <file> is resolved relative to the including file,
+//    then against the include directories; #pragma once is honoured
+//  - the given defines are injected right after #version. A define is only
+//    emitted if its name appears in the expanded source, so permutations
+//    that differ only in features a shader ignores expand to the same text
+//  - "#extension GL_GOOGLE_include_directive" (needed by glslangValidator
+//    for the SPIR-V build step) is dropped
+//  - #line directives keep compiler line numbers pointing into the right
+//    file, the number after the line is an index into dependencies()
+class ShaderPreprocessor
+{
+public:
+	void addIncludeDir(const std::string& dir);
+
+	bool process(const std::string& path, const std::vector<ShaderDefine>& defines, std::string& out, std::string* error = nullptr);
+
+	// every file read by the last process() call, [0] is the root file
+	const std::vector<std::string>& dependencies() const { return files; }
+
+private:
+	bool expand(const std::string& path, int depth, std::string& body, std::string* error);
+	std::string resolve(const std::string& name, const std::string& includer, bool angled) const;
+
+	std::vector<std::string> includeDirs;
+	std::vector<std::string> files;
+	std::vector<std::string> onceFiles;
+	std::vector<std::string> includeStack;
+	std::string version;
+};
+
+// 64-bit FNV-1a, stable across runs so it can key on-disk caches as well
+uint64_t hashShaderSource(const std::string& source, uint64_t seed = 14695981039346656037ull);
+
+#endif
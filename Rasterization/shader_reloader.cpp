@@ -0,0 +1,246 @@
+#include "shader_reloader.h"
+
+#include <chrono>
+#include <filesystem>
+#include <iostream>
+
+#ifdef __linux__
+#include <poll.h>
+#include <sys/inotify.h>
+#include <unistd.h>
+#endif
+
+using namespace std;
+namespace fs = std::filesystem;
+
+// how long the worker waits between checks for stop()/timestamp changes
+static const int WATCH_INTERVAL_MS = 200;
+// editors often write a file in several steps, give them time to finish
+static const int DEBOUNCE_MS = 50;
+
+static long long writeTime(const string& path)
+{
+	error_code ec;
+	auto time = fs::last_write_time(path, ec);
+	if (ec)
+		return 0;
+	return (long long)time.time_since_epoch().count();
+}
+
+ShaderHotReloader::ShaderHotReloader(const ShaderProgramDesc& desc)
+	: desc(desc)
+{
+}
+
+ShaderHotReloader::~ShaderHotReloader()
+{
+	stop();
+}
+
+bool ShaderHotReloader::start(GLFWwindow* mainWindow)
+{
+	if (!fs::exists(desc.vertexPath) || !fs::exists(desc.fragmentPath))
+	{
+		cout << "ERROR::SHADER::FILE_NOT_FOUND " << desc.vertexPath << " / " << desc.fragmentPath << endl;
+		return false;
+	}
+
+	current = make_unique<ShaderVariantCache>(desc);
+	program(0);
+
+	// a hidden 1x1 window gives the worker its own context in mainWindow's share group,
+	// the context hints set up for the main window are still active here
+	glfwWindowHint(GLFW_VISIBLE, GLFW_FALSE);
+	workerWindow = glfwCreateWindow(1, 1, "shader reloader", NULL, mainWindow);
+	glfwWindowHint(GLFW_VISIBLE, GLFW_TRUE);
+	if (workerWindow == NULL)
+	{
+		cout << "ERROR::SHADER::RELOADER::SHARED_CONTEXT_FAILED" << endl;
+		return false;
+	}
+
+#ifdef __linux__
+	inotifyFd = inotify_init1(IN_NONBLOCK | IN_CLOEXEC);
+#endif
+	// a failed first build reads no includes, but the root files are always worth watching
+	vector<string> files = current->dependencies();
+	files.push_back(desc.vertexPath);
+	files.push_back(desc.fragmentPath);
+	watchFiles(files);
+
+	running = true;
+	worker = thread(&ShaderHotReloader::workerLoop, this);
+	return true;
+}
+
+void ShaderHotReloader::stop()
+{
+	if (running.exchange(false))
+		worker.join();
+
+#ifdef __linux__
+	if (inotifyFd >= 0)
+	{
+		close(inotifyFd);
+		inotifyFd = -1;
+	}
+#endif
+	watched.clear();
+
+	if (pending)
+	{
+		glDeleteSync(pendingFence);
+		pending.reset();
+	}
+	current.reset();
+	if (workerWindow)
+	{
+		glfwDestroyWindow(workerWindow);
+		workerWindow = nullptr;
+	}
+}
+
+unsigned int ShaderHotReloader::program(unsigned int mask)
+{
+	if (!current || mask >= MAX_SHADER_VARIANTS)
+		return 0;
+
+	unsigned int program = current->get(mask);
+	if (program)
+		return program;
+
+	requestedMasks.fetch_or(1ull << mask);
+	return current->require(mask);
+}
+
+void ShaderHotReloader::watchFiles(const vector<string>& paths)
+{
+	for (const string& path : paths)
+	{
+		bool known = false;
+		for (const WatchedFile& file : watched)
+			known = known || file.path == path;
+		if (known)
+			continue;
+
+		WatchedFile file;
+		file.wd = -1;
+		file.path = path;
+		file.name = fs::path(path).filename().string();
+		file.writeTime = writeTime(path);
+#ifdef __linux__
+		// watch the directory rather than the file, most editors save by
+		// writing a temporary file and renaming it over the original
+		if (inotifyFd >= 0)
+		{
+			string dir = fs::path(path).parent_path().string();
+			file.wd = inotify_add_watch(inotifyFd, dir.empty() ? "." : dir.c_str(), IN_CLOSE_WRITE | IN_MOVED_TO | IN_CREATE);
+		}
+#endif
+		watched.push_back(file);
+	}
+}
+
+bool ShaderHotReloader::waitForChange()
+{
+#ifdef __linux__
+	if (inotifyFd >= 0)
+	{
+		pollfd pfd = { inotifyFd, POLLIN, 0 };
+		if (poll(&pfd, 1, WATCH_INTERVAL_MS) <= 0)
+			return false;
+
+		bool changed = false;
+		alignas(inotify_event) char buffer[4096];
+		ssize_t length;
+		while ((length = read(inotifyFd, buffer, sizeof(buffer))) > 0)
+		{
+			for (char* p = buffer; p < buffer + length; )
+			{
+				const inotify_event* event = (const inotify_event*)p;
+				for (const WatchedFile& file : watched)
+				{
+					if (event->len > 0 && event->wd == file.wd && file.name == event->name)
+						changed = true;
+				}
+				p += sizeof(inotify_event) + event->len;
+			}
+		}
+		return changed;
+	}
+#endif
+
+	this_thread::sleep_for(chrono::milliseconds(WATCH_INTERVAL_MS));
+	bool changed = false;
+	for (WatchedFile& file : watched)
+	{
+		long long time = writeTime(file.path);
+		changed = changed || time != file.writeTime;
+		file.writeTime = time;
+	}
+	return changed;
+}
+
+void ShaderHotReloader::workerLoop()
+{
+	glfwMakeContextCurrent(workerWindow);
+
+	while (running)
+	{
+		if (!waitForChange())
+			continue;
+
+		this_thread::sleep_for(chrono::milliseconds(DEBOUNCE_MS));
+		cout << "Reloading shaders " << desc.vertexPath << " + " << desc.fragmentPath << endl;
+
+		// the embedded SPIR-V was compiled from the files as they were at build time
+		ShaderProgramDesc editedDesc = desc;
+		editedDesc.useEmbeddedSpirv = false;
+		auto cache = make_unique<ShaderVariantCache>(editedDesc);
+		uint64_t masks = requestedMasks.load() | 1;
+		bool ok = true;
+		for (unsigned int mask = 0; mask < MAX_SHADER_VARIANTS && ok; mask++)
+		{
+			if (masks & (1ull << mask))
+				ok = cache->build(mask);
+		}
+		// an edit may have added includes, even a failed build reports what it read
+		watchFiles(cache->dependencies());
+		if (!ok)
+			continue;
+
+		// the render thread must not use the programs before the commands
+		// that built them on this context have completed
+		GLsync fence = glFenceSync(GL_SYNC_GPU_COMMANDS_COMPLETE, 0);
+		glFlush();
+
+		lock_guard<mutex> lock(pendingMutex);
+		if (pending)
+		{
+			// the render thread never picked up the previous edit, drop it
+			glDeleteSync(pendingFence);
+			pending.reset();
+		}
+		pending = move(cache);
+		pendingFence = fence;
+	}
+
+	glfwMakeContextCurrent(NULL);
+}
+
+void ShaderHotReloader::update()
+{
+	unique_lock<mutex> lock(pendingMutex, try_to_lock);
+	if (!lock.owns_lock() || !pending)
+		return;
+
+	GLenum status = glClientWaitSync(pendingFence, 0, 0);
+	if (status != GL_ALREADY_SIGNALED && status != GL_CONDITION_SATISFIED)
+		return;
+
+	glDeleteSync(pendingFence);
+	pendingFence = 0;
+	// GL defers deleting a program that is still current until it no longer is
+	current = move(pending);
+	cout << "Shaders reloaded" << endl;
+}
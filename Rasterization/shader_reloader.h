@@ -0,0 +1,81 @@
+#ifndef SHADER_RELOADER_H
+#define SHADER_RELOADER_H
+
+#include <atomic>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <vector>
+
+#include <glad/glad.h>
+#include <GLFW/glfw3.h>
+
+#include "shader_variants.h"
+
+// Loads a family of programs from files and keeps them up to date while the
+// program runs. The files and everything they #include are watched (inotify
+// on Linux, timestamp polling elsewhere) and a fresh ShaderVariantCache with
+// every permutation used so far is rebuilt on a worker thread that owns a
+// hidden GLFW window whose context shares objects with the main one. The new
+// cache is only handed to the render thread after every permutation linked
+// and its fence signaled, so a broken edit keeps the last good programs.
+class ShaderHotReloader
+{
+public:
+	explicit ShaderHotReloader(const ShaderProgramDesc& desc);
+	~ShaderHotReloader();
+
+	ShaderHotReloader(const ShaderHotReloader&) = delete;
+	ShaderHotReloader& operator=(const ShaderHotReloader&) = delete;
+
+	// must be called on the main thread with mainWindow's context current.
+	// compiles the base permutation synchronously and starts watching.
+	// returns false only if the files or the shared context are unavailable,
+	// a compile error just leaves program() at 0 until the file is fixed.
+	bool start(GLFWwindow* mainWindow);
+
+	// stops the worker and releases its context, call before glfwTerminate()
+	void stop();
+
+	// call once per frame on the render thread, never blocks
+	void update();
+
+	// the program for a feature mask, compiled on first use
+	unsigned int program(unsigned int mask = 0);
+
+private:
+	struct WatchedFile
+	{
+		int wd;
+		std::string path;
+		std::string name;
+		long long writeTime;
+	};
+
+	void workerLoop();
+	bool waitForChange();
+	void watchFiles(const std::vector<std::string>& paths);
+
+	ShaderProgramDesc desc;
+
+	GLFWwindow* workerWindow = nullptr;
+	std::thread worker;
+	std::atomic<bool> running{ false };
+
+	// permutations the render thread has asked for, rebuilt on every reload
+	std::atomic<uint64_t> requestedMasks{ 0 };
+
+	// guarded by pendingMutex, the render thread only ever try_locks it
+	std::mutex pendingMutex;
+	std::unique_ptr<ShaderVariantCache> pending;
+	GLsync pendingFence = 0;
+
+	std::unique_ptr<ShaderVariantCache> current;
+
+	// change detection state, only touched by the worker once it runs
+	int inotifyFd = -1;
+	std::vector<WatchedFile> watched;
+};
+
+#endif
@@ -0,0 +1,208 @@
+#include "shader_utils.h"
+#include "gl_ext.h"
+#include "spirv_modules.h"
+
+#include <cstring>
+#include <fstream>
+#include <iostream>
+#include <sstream>
+#include <vector>
+
+using namespace std;
+
+bool readTextFile(const string& path, string& out)
+{
+	ifstream file(path, ios::in | ios::binary);
+	if (!file)
+		return false;
+
+	stringstream ss;
+	ss << file.rdbuf();
+	out = ss.str();
+	return true;
+}
+
+const char* shaderStageName(GLenum type)
+{
+	switch (type)
+	{
+	case GL_VERTEX_SHADER: return "VERTEX";
+	case GL_FRAGMENT_SHADER: return "FRAGMENT";
+	case GL_GEOMETRY_SHADER: return "GEOMETRY";
+	case GL_COMPUTE_SHADER: return "COMPUTE";
+	default: return "UNKNOWN";
+	}
+}
+
+unsigned int compileShader(GLenum type, const char* source, string* log)
+{
+	unsigned int shader = glCreateShader(type);
+	glShaderSource(shader, 1, &source, NULL);
+	glCompileShader(shader);
+
+	int success;
+	glGetShaderiv(shader, GL_COMPILE_STATUS, &success);
+	if (!success)
+	{
+		if (log)
+		{
+			int length = 0;
+			glGetShaderiv(shader, GL_INFO_LOG_LENGTH, &length);
+			vector<char> infoLog(length > 1 ? length : 1);
+			glGetShaderInfoLog(shader, (GLsizei)infoLog.size(), NULL, infoLog.data());
+			*log = infoLog.data();
+		}
+		glDeleteShader(shader);
+		return 0;
+	}
+	return shader;
+}
+
+ShaderSpecialization ShaderSpecialization::floatConstant(unsigned int id, const string& name, float value)
+{
+	ShaderSpecialization spec;
+	spec.id = id;
+	spec.name = name;
+	memcpy(&spec.bits, &value, sizeof(value));
+	ostringstream literal;
+	literal.precision(9);
+	literal << showpoint << value;
+	spec.literal = literal.str();
+	return spec;
+}
+
+ShaderSpecialization ShaderSpecialization::intConstant(unsigned int id, const string& name, int value)
+{
+	ShaderSpecialization spec;
+	spec.id = id;
+	spec.name = name;
+	spec.bits = (uint32_t)value;
+	spec.literal = to_string(value);
+	return spec;
+}
+
+unsigned int compileSpirvShader(GLenum type, const uint32_t* words, size_t wordCount,
+	const vector<ShaderSpecialization>& specializations, string* log)
+{
+	if (!glext.spirv)
+	{
+		if (log)
+			*log = "GL_ARB_gl_spirv is not supported";
+		return 0;
+	}
+
+	vector<GLuint> indices, values;
+	for (const ShaderSpecialization& spec : specializations)
+	{
+		if (!spirvDeclaresSpecId(words, wordCount, spec.id))
+			continue;
+		indices.push_back(spec.id);
+		values.push_back(spec.bits);
+	}
+
+	unsigned int shader = glCreateShader(type);
+	glext.ShaderBinary(1, &shader, GL_SHADER_BINARY_FORMAT_SPIR_V, words, (GLsizei)(wordCount * sizeof(uint32_t)));
+	glext.SpecializeShader(shader, "main", (GLuint)indices.size(), indices.data(), values.data());
+
+	int success;
+	glGetShaderiv(shader, GL_COMPILE_STATUS, &success);
+	if (!success)
+	{
+		if (log)
+		{
+			int length = 0;
+			glGetShaderiv(shader, GL_INFO_LOG_LENGTH, &length);
+			vector<char> infoLog(length > 1 ? length : 1);
+			glGetShaderInfoLog(shader, (GLsizei)infoLog.size(), NULL, infoLog.data());
+			*log = infoLog.data();
+		}
+		glDeleteShader(shader);
+		return 0;
+	}
+	return shader;
+}
+
+unsigned int linkProgram(unsigned int vertexShader, unsigned int fragmentShader, string* log)
+{
+	unsigned int program = glCreateProgram();
+	glAttachShader(program, vertexShader);
+	glAttachShader(program, fragmentShader);
+	glLinkProgram(program);
+	glDetachShader(program, vertexShader);
+	glDetachShader(program, fragmentShader);
+
+	int success;
+	glGetProgramiv(program, GL_LINK_STATUS, &success);
+	if (!success)
+	{
+		if (log)
+		{
+			int length = 0;
+			glGetProgramiv(program, GL_INFO_LOG_LENGTH, &length);
+			vector<char> infoLog(length > 1 ? length : 1);
+			glGetProgramInfoLog(program, (GLsizei)infoLog.size(), NULL, infoLog.data());
+			*log = infoLog.data();
+		}
+		glDeleteProgram(program);
+		return 0;
+	}
+	return program;
+}
+
+unsigned int buildProgram(const char* vertexSource, const char* fragmentSource, const string& name)
+{
+	string log;
+	unsigned int vertexShader = compileShader(GL_VERTEX_SHADER, vertexSource, &log);
+	if (!vertexShader)
+	{
+		cout << "ERROR::SHADER::VERTEX::COMPILATION_FAILED (" << name << ")\n" << log << endl;
+		return 0;
+	}
+
+	unsigned int fragmentShader = compileShader(GL_FRAGMENT_SHADER, fragmentSource, &log);
+	if (!fragmentShader)
+	{
+		cout << "ERROR::SHADER::FRAGMENT::COMPILATION_FAILED (" << name << ")\n" << log << endl;
+		glDeleteShader(vertexShader);
+		return 0;
+	}
+
+	unsigned int program = linkProgram(vertexShader, fragmentShader, &log);
+	if (!program)
+		cout << "ERROR::SHADER::PROGRAM::LINKING_FAILED (" << name << ")\n" << log << endl;
+
+	glDeleteShader(vertexShader);
+	glDeleteShader(fragmentShader);
+	return program;
+}
+
+unsigned int buildComputeProgram(const char* source, const string& name)
+{
+	string log;
+	unsigned int shader = compileShader(GL_COMPUTE_SHADER, source, &log);
+	if (!shader)
+	{
+		cout << "ERROR::SHADER::COMPUTE::COMPILATION_FAILED (" << name << ")\n" << log << endl;
+		return 0;
+	}
+
+	unsigned int program = glCreateProgram();
+	glAttachShader(program, shader);
+	glLinkProgram(program);
+	glDetachShader(program, shader);
+	glDeleteShader(shader);
+
+	int success;
+	glGetProgramiv(program, GL_LINK_STATUS, &success);
+	if (!success)
+	{
+		int length = 0;
+		glGetProgramiv(program, GL_INFO_LOG_LENGTH, &length);
+		vector<char> infoLog(length > 1 ? length : 1);
+		glGetProgramInfoLog(program, (GLsizei)infoLog.size(), NULL, infoLog.data());
+		cout << "ERROR::SHADER::PROGRAM::LINKING_FAILED (" << name << ")\n" << infoLog.data() << endl;
+		glDeleteProgram(program);
+		return 0;
+	}
+	return program;
+}
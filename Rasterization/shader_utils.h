@@ -0,0 +1,48 @@
+#ifndef SHADER_UTILS_H
+#define SHADER_UTILS_H
+
+#include <cstddef>
+#include <cstdint>
+#include <string>
+#include <vector>
+#include <glad/glad.h>
+
+// A SPIR-V specialization constant (layout(constant_id = id)). The GLSL
+// source path has no such thing, there the same value is injected as
+// "#define name literal" instead.
+struct ShaderSpecialization
+{
+	unsigned int id;
+	std::string name;
+	uint32_t bits;
+	std::string literal;
+
+	static ShaderSpecialization floatConstant(unsigned int id, const std::string& name, float value);
+	static ShaderSpecialization intConstant(unsigned int id, const std::string& name, int value);
+};
+
+// read a whole text file into out, returns false if it can't be opened
+bool readTextFile(const std::string& path, std::string& out);
+
+// compile a single shader stage, returns 0 and fills log on failure
+unsigned int compileShader(GLenum type, const char* source, std::string* log = nullptr);
+
+// create a shader stage from a SPIR-V module (GL 4.6 / GL_ARB_gl_spirv),
+// returns 0 and fills log if the driver can't take it. Specializations the
+// module doesn't declare are left out, so one list can serve every stage.
+unsigned int compileSpirvShader(GLenum type, const uint32_t* words, size_t wordCount,
+	const std::vector<ShaderSpecialization>& specializations, std::string* log = nullptr);
+
+// link the given stages into a program, returns 0 and fills log on failure
+// the shaders are detached but not deleted
+unsigned int linkProgram(unsigned int vertexShader, unsigned int fragmentShader, std::string* log = nullptr);
+
+// compile + link a vertex/fragment pair, printing errors the way main() used to
+unsigned int buildProgram(const char* vertexSource, const char* fragmentSource, const std::string& name);
+
+// compile + link a compute shader (GL 4.3), printing errors like buildProgram()
+unsigned int buildComputeProgram(const char* source, const std::string& name);
+
+const char* shaderStageName(GLenum type);
+
+#endif
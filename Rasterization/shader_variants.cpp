@@ -0,0 +1,138 @@
+#include "shader_variants.h"
+#include "gl_ext.h"
+#include "spirv_modules.h"
+
+#include <algorithm>
+#include <iostream>
+
+using namespace std;
+
+vector<ShaderDefine> variantDefines(const ShaderProgramDesc& desc, unsigned int mask)
+{
+	vector<ShaderDefine> defines;
+	for (size_t i = 0; i < desc.featureDefines.size(); i++)
+	{
+		if (mask & (1u << i))
+			defines.push_back({ desc.featureDefines[i], "1" });
+	}
+	for (const ShaderSpecialization& spec : desc.specializations)
+		defines.push_back({ spec.name, spec.literal });
+	return defines;
+}
+
+ShaderVariantCache::ShaderVariantCache(const ShaderProgramDesc& desc)
+	: programDesc(desc)
+{
+	for (const string& dir : desc.includeDirs)
+		preprocessor.addIncludeDir(dir);
+}
+
+ShaderVariantCache::~ShaderVariantCache()
+{
+	release();
+}
+
+void ShaderVariantCache::release()
+{
+	for (auto& entry : programsByHash)
+		glDeleteProgram(entry.second);
+	programsByHash.clear();
+	fill(begin(programs), end(programs), 0u);
+	requested = 0;
+	files.clear();
+}
+
+bool ShaderVariantCache::build(unsigned int mask)
+{
+	if (mask >= MAX_SHADER_VARIANTS || (mask >> programDesc.featureDefines.size()) != 0)
+	{
+		cout << "ERROR::SHADER::VARIANT::BAD_FEATURE_MASK " << mask << endl;
+		return false;
+	}
+	requested |= 1ull << mask;
+	if (programs[mask])
+		return true;
+
+	vector<ShaderDefine> defines = variantDefines(programDesc, mask);
+	string vertexSource, fragmentSource, error;
+	if (!preprocessor.process(programDesc.vertexPath, defines, vertexSource, &error))
+	{
+		cout << "ERROR::SHADER::PREPROCESS_FAILED\n" << error << endl;
+		return false;
+	}
+	vector<string> deps = preprocessor.dependencies();
+	if (!preprocessor.process(programDesc.fragmentPath, defines, fragmentSource, &error))
+	{
+		cout << "ERROR::SHADER::PREPROCESS_FAILED\n" << error << endl;
+		return false;
+	}
+	deps.insert(deps.end(), preprocessor.dependencies().begin(), preprocessor.dependencies().end());
+	for (const string& dep : deps)
+	{
+		if (find(files.begin(), files.end(), dep) == files.end())
+			files.push_back(dep);
+	}
+
+	uint64_t hash = hashShaderSource(fragmentSource, hashShaderSource(vertexSource));
+	auto found = programsByHash.find(hash);
+	if (found != programsByHash.end())
+	{
+		programs[mask] = found->second;
+		return true;
+	}
+
+	// SPIR-V the driver rejects has its error logged by buildFromSpirv() and
+	// the GLSL source is compiled instead, so the base variant still exists
+	unsigned int program = 0;
+	if (mask == 0 && spirvAvailable())
+		program = buildFromSpirv();
+	if (!program)
+	{
+		program = buildProgram(vertexSource.c_str(), fragmentSource.c_str(),
+			programDesc.vertexPath + " + " + programDesc.fragmentPath + " mask " + to_string(mask));
+	}
+	if (!program)
+		return false;
+
+	programsByHash[hash] = program;
+	programs[mask] = program;
+	return true;
+}
+
+bool ShaderVariantCache::spirvAvailable() const
+{
+	return programDesc.useEmbeddedSpirv && glext.spirv && findSpirvModule(programDesc.vertexPath)
+		&& findSpirvModule(programDesc.fragmentPath);
+}
+
+unsigned int ShaderVariantCache::buildFromSpirv()
+{
+	const SpirvModule* vertexModule = findSpirvModule(programDesc.vertexPath);
+	const SpirvModule* fragmentModule = findSpirvModule(programDesc.fragmentPath);
+
+	string log;
+	unsigned int vertexShader = compileSpirvShader(GL_VERTEX_SHADER, vertexModule->words, vertexModule->wordCount, programDesc.specializations, &log);
+	unsigned int fragmentShader = compileSpirvShader(GL_FRAGMENT_SHADER, fragmentModule->words, fragmentModule->wordCount, programDesc.specializations, &log);
+	unsigned int program = 0;
+	if (vertexShader && fragmentShader)
+		program = linkProgram(vertexShader, fragmentShader, &log);
+	if (!program)
+		cout << "ERROR::SHADER::SPIRV::BUILD_FAILED " << programDesc.vertexPath << " + " << programDesc.fragmentPath << "\n" << log << endl;
+
+	if (vertexShader)
+		glDeleteShader(vertexShader);
+	if (fragmentShader)
+		glDeleteShader(fragmentShader);
+	return program;
+}
+
+unsigned int ShaderVariantCache::require(unsigned int mask)
+{
+	if (mask < MAX_SHADER_VARIANTS && programs[mask])
+		return programs[mask];
+	// a failed permutation is only retried when the cache is rebuilt
+	if (mask < MAX_SHADER_VARIANTS && (requested & (1ull << mask)))
+		return 0;
+	build(mask);
+	return get(mask);
+}
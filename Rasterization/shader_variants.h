@@ -0,0 +1,81 @@
+#ifndef SHADER_VARIANTS_H
+#define SHADER_VARIANTS_H
+
+#include <cstdint>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+#include "shader_preprocessor.h"
+#include "shader_utils.h"
+
+// a feature mask indexes a flat table, so keep the table small
+const int MAX_SHADER_FEATURES = 6;
+const unsigned int MAX_SHADER_VARIANTS = 1u << MAX_SHADER_FEATURES;
+
+// Describes a family of programs built from one vertex/fragment file pair.
+// Bit i of a feature mask turns on the define featureDefines[i].
+struct ShaderProgramDesc
+{
+	std::string vertexPath;
+	std::string fragmentPath;
+	std::vector<std::string> featureDefines;
+	std::vector<std::string> includeDirs;
+	std::vector<ShaderSpecialization> specializations;
+
+	// build the base permutation from the SPIR-V embedded at build time when
+	// the driver supports it. SPIR-V the driver rejects is reported as
+	// ERROR::SHADER::SPIRV::BUILD_FAILED and the GLSL source built instead.
+	// Turned off once the files have been edited.
+	bool useEmbeddedSpirv = true;
+};
+
+// the defines permutation mask of desc is preprocessed with
+std::vector<ShaderDefine> variantDefines(const ShaderProgramDesc& desc, unsigned int mask);
+
+// Compiles each permutation of a ShaderProgramDesc at most once.
+// get() is a table lookup by feature mask; permutations whose expanded
+// sources hash the same (e.g. a feature neither stage uses) share one program.
+// All calls need a current GL context from the share group the programs live in.
+class ShaderVariantCache
+{
+public:
+	explicit ShaderVariantCache(const ShaderProgramDesc& desc);
+	~ShaderVariantCache();
+
+	ShaderVariantCache(const ShaderVariantCache&) = delete;
+	ShaderVariantCache& operator=(const ShaderVariantCache&) = delete;
+
+	// compile the permutation if needed, false if it failed to build
+	bool build(unsigned int mask);
+
+	// O(1), 0 if the permutation hasn't been built (or failed)
+	unsigned int get(unsigned int mask) const { return mask < MAX_SHADER_VARIANTS ? programs[mask] : 0; }
+
+	// get(), building on first use
+	unsigned int require(unsigned int mask);
+
+	// bit i set if permutation i has been requested
+	uint64_t builtMasks() const { return requested; }
+
+	// every file the built permutations read, for change watching
+	const std::vector<std::string>& dependencies() const { return files; }
+
+	const ShaderProgramDesc& desc() const { return programDesc; }
+
+	void release();
+
+private:
+	bool spirvAvailable() const;
+	unsigned int buildFromSpirv();
+
+	ShaderProgramDesc programDesc;
+	ShaderPreprocessor preprocessor;
+
+	unsigned int programs[MAX_SHADER_VARIANTS] = {};
+	uint64_t requested = 0;
+	std::unordered_map<uint64_t, unsigned int> programsByHash;
+	std::vector<std::string> files;
+};
+
+#endif
@@ -0,0 +1,14 @@
+// helpers shared by the triangle shaders
+// include guards rather than #pragma once so glslangValidator takes it too
+#ifndef COMMON_GLSL
+#define COMMON_GLSL
+
+const vec4 BASE_COLOR = vec4(1.0, 0.5, 0.2, 1.0);
+
+// lay instances out on a 4x4 grid around the origin
+vec2 instanceOffset(int instance)
+{
+	return vec2(float(instance % 4) - 1.5, float(instance / 4) - 1.5) * 0.5;
+}
+
+#endif
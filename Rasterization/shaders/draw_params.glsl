@@ -0,0 +1,21 @@
+// per-draw parameters, either as a uniform block fed from a UniformArena
+// slice or as plain uniforms set with glUniform*
+#ifndef DRAW_PARAMS_GLSL
+#define DRAW_PARAMS_GLSL
+
+#if defined(USE_DRAW_BLOCK)
+layout (std140) uniform DrawBlock
+{
+	vec4 offsetScale;	// xy offset, zw scale
+	vec4 drawColor;
+};
+#elif defined(USE_DRAW_UNIFORMS)
+uniform vec4 offsetScale;
+uniform vec4 drawColor;
+#endif
+
+#if defined(USE_DRAW_BLOCK) || defined(USE_DRAW_UNIFORMS)
+#define HAS_DRAW_PARAMS
+#endif
+
+#endif
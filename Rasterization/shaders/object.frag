@@ -0,0 +1,8 @@
+#version 430 core
+in vec4 objectColor;
+layout (location = 0) out vec4 FragColor;
+
+void main()
+{
+	FragColor = objectColor;
+}
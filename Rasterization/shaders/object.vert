@@ -0,0 +1,28 @@
+#version 430 core
+// draws the objects that cull.comp left visible, one indirect command each
+
+struct ObjectData
+{
+	vec4 sphere;	// xyz center, w radius
+	vec4 color;
+};
+
+layout (std430, binding = 0) readonly buffer Objects
+{
+	ObjectData objects[];
+};
+
+layout (location = 0) in vec3 aPos;
+// per instance, offset by the command's baseInstance
+layout (location = 2) in uint aObjectIndex;
+
+uniform mat4 viewProj;
+
+out vec4 objectColor;
+
+void main()
+{
+	ObjectData object = objects[aObjectIndex];
+	gl_Position = viewProj * vec4(object.sphere.xyz + aPos * object.sphere.w, 1.0);
+	objectColor = object.color;
+}
@@ -0,0 +1,18 @@
+#version 330 core
+in vec2 texCoord;
+layout (location = 0) out vec4 FragColor;
+
+uniform sampler2D image;
+
+// sRGB textures sample as linear and the window's framebuffer stores what it
+// gets, so encode again
+vec3 linearToSrgb(vec3 c)
+{
+	return mix(c * 12.92, 1.055 * pow(c, vec3(1.0 / 2.4)) - 0.055, step(vec3(0.0031308), c));
+}
+
+void main()
+{
+	vec4 color = texture(image, texCoord);
+	FragColor = vec4(linearToSrgb(color.rgb), color.a);
+}
@@ -0,0 +1,13 @@
+#version 330 core
+// a screen rectangle without vertex buffers: two triangles from gl_VertexID
+
+uniform vec4 rect;	// x0, y0, x1, y1 in NDC
+
+out vec2 texCoord;
+
+void main()
+{
+	const vec2 corners[6] = vec2[6](vec2(0.0, 0.0), vec2(1.0, 0.0), vec2(1.0, 1.0), vec2(0.0, 0.0), vec2(1.0, 1.0), vec2(0.0, 1.0));
+	texCoord = corners[gl_VertexID];
+	gl_Position = vec4(mix(rect.xy, rect.zw, texCoord), 0.0, 1.0);
+}
@@ -0,0 +1,27 @@
+#version 330 core
+#extension GL_GOOGLE_include_directive : require
+#include "common.glsl"
+#include "draw_params.glsl"
+
+// a specialization constant when loaded as SPIR-V, a #define otherwise
+#ifdef GL_SPIRV
+layout (constant_id = 0) const float COLOR_SCALE = 1.0;
+#elif !defined(COLOR_SCALE)
+#define COLOR_SCALE 1.0
+#endif
+
+#ifdef USE_VERTEX_COLOR
+in vec3 vertexColor;
+#endif
+layout (location = 0) out vec4 FragColor;
+
+void main()
+{
+#if defined(USE_VERTEX_COLOR)
+	FragColor = vec4(vertexColor * COLOR_SCALE, 1.0);
+#elif defined(HAS_DRAW_PARAMS)
+	FragColor = vec4(drawColor.rgb * COLOR_SCALE, drawColor.a);
+#else
+	FragColor = vec4(BASE_COLOR.rgb * COLOR_SCALE, BASE_COLOR.a);
+#endif
+}
@@ -0,0 +1,25 @@
+#version 330 core
+#extension GL_GOOGLE_include_directive : require
+#include "common.glsl"
+#include "draw_params.glsl"
+
+layout (location = 0) in vec3 aPos;
+#ifdef USE_VERTEX_COLOR
+layout (location = 1) in vec3 aColor;
+out vec3 vertexColor;
+#endif
+
+void main()
+{
+	vec3 position = aPos;
+#ifdef USE_INSTANCING
+	position.xy += instanceOffset(gl_InstanceID);
+#endif
+#ifdef HAS_DRAW_PARAMS
+	position.xy = position.xy * offsetScale.zw + offsetScale.xy;
+#endif
+	gl_Position = vec4(position, 1.0);
+#ifdef USE_VERTEX_COLOR
+	vertexColor = aColor;
+#endif
+}
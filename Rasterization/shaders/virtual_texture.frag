@@ -0,0 +1,66 @@
+#version 330 core
+// Samples a VirtualTexture: the page table says which tile of the atlas holds
+// the page at the level the derivatives ask for, or its closest resident
+// ancestor, and the atlas is sampled bilinearly there. VT_FEEDBACK writes
+// that page and level instead, for the feedback pass; VT_REFERENCE samples a
+// whole mipmapped texture at the same level, to check against.
+in vec2 texCoord;
+layout (location = 0) out vec4 FragColor;
+
+// VIRTUAL_TILE_* in virtual_texture.h
+const float TILE_CONTENT = 120.0;
+const float TILE_BORDER = 4.0;
+const float TILE_SIZE = 128.0;
+
+uniform sampler2D pageTable;	// per page of each level: slot x, slot y, level of the page in it
+uniform sampler2D atlas;
+uniform sampler2D reference;
+uniform int pages;				// of level 0, per side
+uniform int maxLevel;
+uniform float atlasTiles;		// per side
+uniform float lodBias;
+
+// the level of detail of uv over the whole texture, like the hardware picks
+// it for a mipmapped texture of that size
+float virtualLod(vec2 uv)
+{
+	vec2 texels = uv * float(pages) * TILE_CONTENT;
+	vec2 dx = dFdx(texels), dy = dFdy(texels);
+	float lod = 0.5 * log2(max(dot(dx, dx), dot(dy, dy))) + lodBias;
+	return clamp(lod, 0.0, float(maxLevel));
+}
+
+vec3 linearToSrgb(vec3 c)
+{
+	return mix(c * 12.92, 1.055 * pow(c, vec3(1.0 / 2.4)) - 0.055, step(vec3(0.0031308), c));
+}
+
+void main()
+{
+	vec2 uv = clamp(texCoord, 0.0, 1.0);
+	// the finer of the two levels a trilinear filter would blend
+	int level = int(virtualLod(uv));
+	int levelPages = pages >> level;
+	ivec2 page = min(ivec2(uv * float(levelPages)), ivec2(levelPages - 1));
+
+#if defined(VT_FEEDBACK)
+	// x and y's low bytes, their high nibbles, the level; VirtualTexture
+	// clears alpha to 255 where nothing is drawn
+	FragColor = vec4(vec2(page & 255), float((page.x >> 8) | ((page.y >> 8) << 4)), float(level)) / 255.0;
+#else
+#if defined(VT_REFERENCE)
+	vec4 color = textureLod(reference, uv, float(level));
+#else
+	ivec3 entry = ivec3(texelFetch(pageTable, page, level).rgb * 255.0 + 0.5);
+	// the resident page covering this one, and where uv falls in it
+	int residentPages = pages >> entry.b;
+	ivec2 resident = page >> (entry.b - level);
+	vec2 inPage = (uv * float(residentPages) - vec2(resident)) * TILE_CONTENT;
+	vec2 physical = (vec2(entry.rg) * TILE_SIZE + TILE_BORDER + inPage) / (atlasTiles * TILE_SIZE);
+	vec4 color = textureLod(atlas, physical, 0.0);
+#endif
+	// sRGB textures sample as linear and the window's framebuffer stores
+	// what it gets, so encode again
+	FragColor = vec4(linearToSrgb(color.rgb), 1.0);
+#endif
+}
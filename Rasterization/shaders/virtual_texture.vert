@@ -0,0 +1,16 @@
+#version 330 core
+// the ground without vertex buffers: a square at y = 0 of two triangles from
+// gl_VertexID, the virtual texture stretched over it once
+
+uniform mat4 viewProj;
+uniform float planeSize;
+
+out vec2 texCoord;
+
+void main()
+{
+	const vec2 corners[6] = vec2[6](vec2(0.0, 0.0), vec2(1.0, 0.0), vec2(1.0, 1.0), vec2(0.0, 0.0), vec2(1.0, 1.0), vec2(0.0, 1.0));
+	texCoord = corners[gl_VertexID];
+	vec2 ground = (texCoord - 0.5) * planeSize;
+	gl_Position = viewProj * vec4(ground.x, 0.0, -ground.y, 1.0);
+}
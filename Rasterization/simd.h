@@ -0,0 +1,372 @@
+#ifndef SIMD_H
+#define SIMD_H
+
+#include <cmath>
+#include <cstdint>
+#include <cstring>
+
+// 8-wide float / int32 vectors for the CPU render path. With AVX2 enabled
+// (/arch:AVX2, -mavx2) each is one 256-bit register; otherwise they are a
+// pair of SSE2 registers with the same interface, so code is written once.
+//
+// Comparisons return a vec8f/vec8i with all bits set in the lanes where they
+// hold; movemask() turns that into one bit per lane (lane 0 = bit 0).
+
+#if defined(__AVX2__)
+#define SIMD_AVX2 1
+#include <immintrin.h>
+#else
+#define SIMD_AVX2 0
+#include <emmintrin.h>
+#endif
+
+#if SIMD_AVX2 && (defined(__FMA__) || defined(_MSC_VER))
+#define SIMD_FMA 1
+#else
+#define SIMD_FMA 0
+#endif
+
+#if defined(_MSC_VER)
+#define SIMD_INLINE __forceinline
+#else
+#define SIMD_INLINE inline __attribute__((always_inline))
+#endif
+
+struct vec8i;
+
+#if SIMD_AVX2
+
+struct vec8f
+{
+	__m256 v;
+
+	vec8f() = default;
+	SIMD_INLINE vec8f(__m256 value) : v(value) {}
+	SIMD_INLINE explicit vec8f(float value) : v(_mm256_set1_ps(value)) {}
+	SIMD_INLINE vec8f(float a, float b, float c, float d, float e, float f, float g, float h) : v(_mm256_setr_ps(a, b, c, d, e, f, g, h)) {}
+
+	static SIMD_INLINE vec8f zero() { return _mm256_setzero_ps(); }
+	static SIMD_INLINE vec8f load(const float* p) { return _mm256_load_ps(p); }
+	static SIMD_INLINE vec8f loadu(const float* p) { return _mm256_loadu_ps(p); }
+	SIMD_INLINE void store(float* p) const { _mm256_store_ps(p, v); }
+	SIMD_INLINE void storeu(float* p) const { _mm256_storeu_ps(p, v); }
+};
+
+struct vec8i
+{
+	__m256i v;
+
+	vec8i() = default;
+	SIMD_INLINE vec8i(__m256i value) : v(value) {}
+	SIMD_INLINE explicit vec8i(int32_t value) : v(_mm256_set1_epi32(value)) {}
+	SIMD_INLINE vec8i(int32_t a, int32_t b, int32_t c, int32_t d, int32_t e, int32_t f, int32_t g, int32_t h) : v(_mm256_setr_epi32(a, b, c, d, e, f, g, h)) {}
+
+	static SIMD_INLINE vec8i zero() { return _mm256_setzero_si256(); }
+	static SIMD_INLINE vec8i load(const void* p) { return _mm256_load_si256((const __m256i*)p); }
+	static SIMD_INLINE vec8i loadu(const void* p) { return _mm256_loadu_si256((const __m256i*)p); }
+	SIMD_INLINE void store(void* p) const { _mm256_store_si256((__m256i*)p, v); }
+	SIMD_INLINE void storeu(void* p) const { _mm256_storeu_si256((__m256i*)p, v); }
+	// lanes 0..3 from/to lo, 4..7 from/to hi, e.g. two rows of an image
+	static SIMD_INLINE vec8i load2(const void* lo, const void* hi) { return _mm256_loadu2_m128i((const __m128i*)hi, (const __m128i*)lo); }
+	SIMD_INLINE void store2(void* lo, void* hi) const { _mm256_storeu2_m128i((__m128i*)hi, (__m128i*)lo, v); }
+};
+
+SIMD_INLINE vec8f operator+(vec8f a, vec8f b) { return _mm256_add_ps(a.v, b.v); }
+SIMD_INLINE vec8f operator-(vec8f a, vec8f b) { return _mm256_sub_ps(a.v, b.v); }
+SIMD_INLINE vec8f operator*(vec8f a, vec8f b) { return _mm256_mul_ps(a.v, b.v); }
+SIMD_INLINE vec8f operator/(vec8f a, vec8f b) { return _mm256_div_ps(a.v, b.v); }
+SIMD_INLINE vec8f operator-(vec8f a) { return _mm256_xor_ps(a.v, _mm256_set1_ps(-0.0f)); }
+SIMD_INLINE vec8f operator&(vec8f a, vec8f b) { return _mm256_and_ps(a.v, b.v); }
+SIMD_INLINE vec8f operator|(vec8f a, vec8f b) { return _mm256_or_ps(a.v, b.v); }
+SIMD_INLINE vec8f operator^(vec8f a, vec8f b) { return _mm256_xor_ps(a.v, b.v); }
+SIMD_INLINE vec8f andnot(vec8f mask, vec8f a) { return _mm256_andnot_ps(mask.v, a.v); }
+
+SIMD_INLINE vec8f operator<(vec8f a, vec8f b) { return _mm256_cmp_ps(a.v, b.v, _CMP_LT_OQ); }
+SIMD_INLINE vec8f operator<=(vec8f a, vec8f b) { return _mm256_cmp_ps(a.v, b.v, _CMP_LE_OQ); }
+SIMD_INLINE vec8f operator>(vec8f a, vec8f b) { return _mm256_cmp_ps(a.v, b.v, _CMP_GT_OQ); }
+SIMD_INLINE vec8f operator>=(vec8f a, vec8f b) { return _mm256_cmp_ps(a.v, b.v, _CMP_GE_OQ); }
+SIMD_INLINE vec8f operator==(vec8f a, vec8f b) { return _mm256_cmp_ps(a.v, b.v, _CMP_EQ_OQ); }
+SIMD_INLINE vec8f operator!=(vec8f a, vec8f b) { return _mm256_cmp_ps(a.v, b.v, _CMP_NEQ_UQ); }
+
+SIMD_INLINE vec8f min(vec8f a, vec8f b) { return _mm256_min_ps(a.v, b.v); }
+SIMD_INLINE vec8f max(vec8f a, vec8f b) { return _mm256_max_ps(a.v, b.v); }
+SIMD_INLINE vec8f sqrt(vec8f a) { return _mm256_sqrt_ps(a.v); }
+SIMD_INLINE vec8f floor(vec8f a) { return _mm256_floor_ps(a.v); }
+SIMD_INLINE vec8f select(vec8f mask, vec8f a, vec8f b) { return _mm256_blendv_ps(b.v, a.v, mask.v); }
+SIMD_INLINE int movemask(vec8f mask) { return _mm256_movemask_ps(mask.v); }
+
+// a * b + c, fused when the CPU can
+SIMD_INLINE vec8f madd(vec8f a, vec8f b, vec8f c)
+{
+#if SIMD_FMA
+	return _mm256_fmadd_ps(a.v, b.v, c.v);
+#else
+	return _mm256_add_ps(_mm256_mul_ps(a.v, b.v), c.v);
+#endif
+}
+
+SIMD_INLINE vec8i operator+(vec8i a, vec8i b) { return _mm256_add_epi32(a.v, b.v); }
+SIMD_INLINE vec8i operator-(vec8i a, vec8i b) { return _mm256_sub_epi32(a.v, b.v); }
+SIMD_INLINE vec8i operator*(vec8i a, vec8i b) { return _mm256_mullo_epi32(a.v, b.v); }
+SIMD_INLINE vec8i operator&(vec8i a, vec8i b) { return _mm256_and_si256(a.v, b.v); }
+SIMD_INLINE vec8i operator|(vec8i a, vec8i b) { return _mm256_or_si256(a.v, b.v); }
+SIMD_INLINE vec8i operator^(vec8i a, vec8i b) { return _mm256_xor_si256(a.v, b.v); }
+SIMD_INLINE vec8i andnot(vec8i mask, vec8i a) { return _mm256_andnot_si256(mask.v, a.v); }
+SIMD_INLINE vec8i operator>(vec8i a, vec8i b) { return _mm256_cmpgt_epi32(a.v, b.v); }
+SIMD_INLINE vec8i operator<(vec8i a, vec8i b) { return _mm256_cmpgt_epi32(b.v, a.v); }
+SIMD_INLINE vec8i operator==(vec8i a, vec8i b) { return _mm256_cmpeq_epi32(a.v, b.v); }
+template<int n> SIMD_INLINE vec8i shiftLeft(vec8i a) { return _mm256_slli_epi32(a.v, n); }
+template<int n> SIMD_INLINE vec8i shiftRight(vec8i a) { return _mm256_srli_epi32(a.v, n); }
+template<int n> SIMD_INLINE vec8i shiftRightArithmetic(vec8i a) { return _mm256_srai_epi32(a.v, n); }
+SIMD_INLINE vec8i min(vec8i a, vec8i b) { return _mm256_min_epi32(a.v, b.v); }
+SIMD_INLINE vec8i max(vec8i a, vec8i b) { return _mm256_max_epi32(a.v, b.v); }
+SIMD_INLINE vec8i select(vec8i mask, vec8i a, vec8i b) { return _mm256_blendv_epi8(b.v, a.v, mask.v); }
+SIMD_INLINE int movemask(vec8i mask) { return _mm256_movemask_ps(_mm256_castsi256_ps(mask.v)); }
+
+SIMD_INLINE vec8f toFloat(vec8i a) { return _mm256_cvtepi32_ps(a.v); }
+// round to nearest even, like the hardware default
+SIMD_INLINE vec8i toIntRound(vec8f a) { return _mm256_cvtps_epi32(a.v); }
+SIMD_INLINE vec8i toIntTruncate(vec8f a) { return _mm256_cvttps_epi32(a.v); }
+SIMD_INLINE vec8f asFloat(vec8i a) { return _mm256_castsi256_ps(a.v); }
+SIMD_INLINE vec8i asInt(vec8f a) { return _mm256_castps_si256(a.v); }
+
+SIMD_INLINE vec8f gather(const float* base, vec8i index) { return _mm256_i32gather_ps(base, index.v, 4); }
+SIMD_INLINE vec8i gather(const int32_t* base, vec8i index) { return _mm256_i32gather_epi32((const int*)base, index.v, 4); }
+
+// lanes = bytes 0..7 of a vector of 8-bit values, zero extended
+SIMD_INLINE vec8i loadBytes(const uint8_t* p) { return _mm256_cvtepu8_epi32(_mm_loadl_epi64((const __m128i*)p)); }
+
+#else // SSE2
+
+struct vec8f
+{
+	__m128 lo, hi;
+
+	vec8f() = default;
+	SIMD_INLINE vec8f(__m128 l, __m128 h) : lo(l), hi(h) {}
+	SIMD_INLINE explicit vec8f(float value) : lo(_mm_set1_ps(value)), hi(_mm_set1_ps(value)) {}
+	SIMD_INLINE vec8f(float a, float b, float c, float d, float e, float f, float g, float h) : lo(_mm_setr_ps(a, b, c, d)), hi(_mm_setr_ps(e, f, g, h)) {}
+
+	static SIMD_INLINE vec8f zero() { return vec8f(_mm_setzero_ps(), _mm_setzero_ps()); }
+	static SIMD_INLINE vec8f load(const float* p) { return vec8f(_mm_load_ps(p), _mm_load_ps(p + 4)); }
+	static SIMD_INLINE vec8f loadu(const float* p) { return vec8f(_mm_loadu_ps(p), _mm_loadu_ps(p + 4)); }
+	SIMD_INLINE void store(float* p) const { _mm_store_ps(p, lo); _mm_store_ps(p + 4, hi); }
+	SIMD_INLINE void storeu(float* p) const { _mm_storeu_ps(p, lo); _mm_storeu_ps(p + 4, hi); }
+};
+
+struct vec8i
+{
+	__m128i lo, hi;
+
+	vec8i() = default;
+	SIMD_INLINE vec8i(__m128i l, __m128i h) : lo(l), hi(h) {}
+	SIMD_INLINE explicit vec8i(int32_t value) : lo(_mm_set1_epi32(value)), hi(_mm_set1_epi32(value)) {}
+	SIMD_INLINE vec8i(int32_t a, int32_t b, int32_t c, int32_t d, int32_t e, int32_t f, int32_t g, int32_t h) : lo(_mm_setr_epi32(a, b, c, d)), hi(_mm_setr_epi32(e, f, g, h)) {}
+
+	static SIMD_INLINE vec8i zero() { return vec8i(_mm_setzero_si128(), _mm_setzero_si128()); }
+	static SIMD_INLINE vec8i load(const void* p) { return vec8i(_mm_load_si128((const __m128i*)p), _mm_load_si128((const __m128i*)p + 1)); }
+	static SIMD_INLINE vec8i loadu(const void* p) { return vec8i(_mm_loadu_si128((const __m128i*)p), _mm_loadu_si128((const __m128i*)p + 1)); }
+	SIMD_INLINE void store(void* p) const { _mm_store_si128((__m128i*)p, lo); _mm_store_si128((__m128i*)p + 1, hi); }
+	SIMD_INLINE void storeu(void* p) const { _mm_storeu_si128((__m128i*)p, lo); _mm_storeu_si128((__m128i*)p + 1, hi); }
+	static SIMD_INLINE vec8i load2(const void* l, const void* h) { return vec8i(_mm_loadu_si128((const __m128i*)l), _mm_loadu_si128((const __m128i*)h)); }
+	SIMD_INLINE void store2(void* l, void* h) const { _mm_storeu_si128((__m128i*)l, lo); _mm_storeu_si128((__m128i*)h, hi); }
+};
+
+#define SIMD_F2(op) vec8f(op(a.lo, b.lo), op(a.hi, b.hi))
+#define SIMD_I2(op) vec8i(op(a.lo, b.lo), op(a.hi, b.hi))
+
+SIMD_INLINE vec8f operator+(vec8f a, vec8f b) { return SIMD_F2(_mm_add_ps); }
+SIMD_INLINE vec8f operator-(vec8f a, vec8f b) { return SIMD_F2(_mm_sub_ps); }
+SIMD_INLINE vec8f operator*(vec8f a, vec8f b) { return SIMD_F2(_mm_mul_ps); }
+SIMD_INLINE vec8f operator/(vec8f a, vec8f b) { return SIMD_F2(_mm_div_ps); }
+SIMD_INLINE vec8f operator&(vec8f a, vec8f b) { return SIMD_F2(_mm_and_ps); }
+SIMD_INLINE vec8f operator|(vec8f a, vec8f b) { return SIMD_F2(_mm_or_ps); }
+SIMD_INLINE vec8f operator^(vec8f a, vec8f b) { return SIMD_F2(_mm_xor_ps); }
+SIMD_INLINE vec8f operator-(vec8f a) { return a ^ vec8f(-0.0f); }
+SIMD_INLINE vec8f andnot(vec8f a, vec8f b) { return SIMD_F2(_mm_andnot_ps); }
+
+SIMD_INLINE vec8f operator<(vec8f a, vec8f b) { return SIMD_F2(_mm_cmplt_ps); }
+SIMD_INLINE vec8f operator<=(vec8f a, vec8f b) { return SIMD_F2(_mm_cmple_ps); }
+SIMD_INLINE vec8f operator>(vec8f a, vec8f b) { return SIMD_F2(_mm_cmpgt_ps); }
+SIMD_INLINE vec8f operator>=(vec8f a, vec8f b) { return SIMD_F2(_mm_cmpge_ps); }
+SIMD_INLINE vec8f operator==(vec8f a, vec8f b) { return SIMD_F2(_mm_cmpeq_ps); }
+SIMD_INLINE vec8f operator!=(vec8f a, vec8f b) { return SIMD_F2(_mm_cmpneq_ps); }
+
+SIMD_INLINE vec8f min(vec8f a, vec8f b) { return SIMD_F2(_mm_min_ps); }
+SIMD_INLINE vec8f max(vec8f a, vec8f b) { return SIMD_F2(_mm_max_ps); }
+SIMD_INLINE vec8f sqrt(vec8f a) { return vec8f(_mm_sqrt_ps(a.lo), _mm_sqrt_ps(a.hi)); }
+SIMD_INLINE vec8f select(vec8f mask, vec8f a, vec8f b) { return (mask & a) | andnot(mask, b); }
+SIMD_INLINE int movemask(vec8f mask) { return _mm_movemask_ps(mask.lo) | (_mm_movemask_ps(mask.hi) << 4); }
+SIMD_INLINE vec8f madd(vec8f a, vec8f b, vec8f c) { return a * b + c; }
+
+SIMD_INLINE vec8i operator+(vec8i a, vec8i b) { return SIMD_I2(_mm_add_epi32); }
+SIMD_INLINE vec8i operator-(vec8i a, vec8i b) { return SIMD_I2(_mm_sub_epi32); }
+SIMD_INLINE vec8i operator&(vec8i a, vec8i b) { return SIMD_I2(_mm_and_si128); }
+SIMD_INLINE vec8i operator|(vec8i a, vec8i b) { return SIMD_I2(_mm_or_si128); }
+SIMD_INLINE vec8i operator^(vec8i a, vec8i b) { return SIMD_I2(_mm_xor_si128); }
+SIMD_INLINE vec8i andnot(vec8i a, vec8i b) { return SIMD_I2(_mm_andnot_si128); }
+SIMD_INLINE vec8i operator>(vec8i a, vec8i b) { return SIMD_I2(_mm_cmpgt_epi32); }
+SIMD_INLINE vec8i operator<(vec8i a, vec8i b) { return SIMD_I2(_mm_cmplt_epi32); }
+SIMD_INLINE vec8i operator==(vec8i a, vec8i b) { return SIMD_I2(_mm_cmpeq_epi32); }
+template<int n> SIMD_INLINE vec8i shiftLeft(vec8i a) { return vec8i(_mm_slli_epi32(a.lo, n), _mm_slli_epi32(a.hi, n)); }
+template<int n> SIMD_INLINE vec8i shiftRight(vec8i a) { return vec8i(_mm_srli_epi32(a.lo, n), _mm_srli_epi32(a.hi, n)); }
+template<int n> SIMD_INLINE vec8i shiftRightArithmetic(vec8i a) { return vec8i(_mm_srai_epi32(a.lo, n), _mm_srai_epi32(a.hi, n)); }
+SIMD_INLINE vec8i select(vec8i mask, vec8i a, vec8i b) { return (mask & a) | andnot(mask, b); }
+SIMD_INLINE vec8i min(vec8i a, vec8i b) { return select(a < b, a, b); }
+SIMD_INLINE vec8i max(vec8i a, vec8i b) { return select(a > b, a, b); }
+SIMD_INLINE int movemask(vec8i mask) { return _mm_movemask_ps(_mm_castsi128_ps(mask.lo)) | (_mm_movemask_ps(_mm_castsi128_ps(mask.hi)) << 4); }
+
+// SSE2 has no 32-bit low multiply, build it from two 32x32->64 multiplies
+static SIMD_INLINE __m128i simdMullo(__m128i a, __m128i b)
+{
+	__m128i even = _mm_mul_epu32(a, b);
+	__m128i odd = _mm_mul_epu32(_mm_srli_epi64(a, 32), _mm_srli_epi64(b, 32));
+	return _mm_unpacklo_epi32(_mm_shuffle_epi32(even, _MM_SHUFFLE(0, 0, 2, 0)), _mm_shuffle_epi32(odd, _MM_SHUFFLE(0, 0, 2, 0)));
+}
+SIMD_INLINE vec8i operator*(vec8i a, vec8i b) { return SIMD_I2(simdMullo); }
+
+SIMD_INLINE vec8f toFloat(vec8i a) { return vec8f(_mm_cvtepi32_ps(a.lo), _mm_cvtepi32_ps(a.hi)); }
+SIMD_INLINE vec8i toIntRound(vec8f a) { return vec8i(_mm_cvtps_epi32(a.lo), _mm_cvtps_epi32(a.hi)); }
+SIMD_INLINE vec8i toIntTruncate(vec8f a) { return vec8i(_mm_cvttps_epi32(a.lo), _mm_cvttps_epi32(a.hi)); }
+SIMD_INLINE vec8f asFloat(vec8i a) { return vec8f(_mm_castsi128_ps(a.lo), _mm_castsi128_ps(a.hi)); }
+SIMD_INLINE vec8i asInt(vec8f a) { return vec8i(_mm_castps_si128(a.lo), _mm_castps_si128(a.hi)); }
+
+// valid for |a| < 2^31, which is all the renderer ever floors
+SIMD_INLINE vec8f floor(vec8f a)
+{
+	vec8f truncated = toFloat(toIntTruncate(a));
+	return truncated - (asFloat(asInt(truncated > a) & vec8i(0x3f800000)));
+}
+
+SIMD_INLINE vec8f gather(const float* base, vec8i index)
+{
+	alignas(32) int32_t i[8];
+	index.store(i);
+	return vec8f(base[i[0]], base[i[1]], base[i[2]], base[i[3]], base[i[4]], base[i[5]], base[i[6]], base[i[7]]);
+}
+
+SIMD_INLINE vec8i gather(const int32_t* base, vec8i index)
+{
+	alignas(32) int32_t i[8];
+	index.store(i);
+	return vec8i(base[i[0]], base[i[1]], base[i[2]], base[i[3]], base[i[4]], base[i[5]], base[i[6]], base[i[7]]);
+}
+
+SIMD_INLINE vec8i loadBytes(const uint8_t* p)
+{
+	__m128i bytes = _mm_loadl_epi64((const __m128i*)p);
+	__m128i words = _mm_unpacklo_epi8(bytes, _mm_setzero_si128());
+	return vec8i(_mm_unpacklo_epi16(words, _mm_setzero_si128()), _mm_unpackhi_epi16(words, _mm_setzero_si128()));
+}
+
+#undef SIMD_F2
+#undef SIMD_I2
+
+#endif
+
+SIMD_INLINE vec8f abs(vec8f a) { return andnot(vec8f(-0.0f), a); }
+SIMD_INLINE vec8f clamp(vec8f a, vec8f lo, vec8f hi) { return min(max(a, lo), hi); }
+SIMD_INLINE vec8f lerp(vec8f a, vec8f b, vec8f t) { return madd(b - a, t, a); }
+
+// 2^a to about 2 ulp, a clamped to the normal range [-126, 126]
+SIMD_INLINE vec8f exp2(vec8f a)
+{
+	a = clamp(a, vec8f(-126.0f), vec8f(126.0f));
+	vec8i whole = toIntRound(a);
+	vec8f f = a - toFloat(whole);		// [-0.5, 0.5]
+	// Taylor series of e^(f ln 2), the degree 7 term is below float precision
+	vec8f p(1.5252733e-5f);
+	p = madd(p, f, vec8f(1.5403530e-4f));
+	p = madd(p, f, vec8f(1.3333558e-3f));
+	p = madd(p, f, vec8f(9.6181291e-3f));
+	p = madd(p, f, vec8f(5.5504109e-2f));
+	p = madd(p, f, vec8f(2.4022651e-1f));
+	p = madd(p, f, vec8f(6.9314718e-1f));
+	p = madd(p, f, vec8f(1.0f));
+	return p * asFloat(shiftLeft<23>(whole + vec8i(127)));
+}
+
+// log2(a) to about 2 ulp; -inf for 0, NaN for negative lanes
+SIMD_INLINE vec8f log2(vec8f a)
+{
+	vec8i bits = asInt(a);
+	vec8i exponent = shiftRight<23>(bits & vec8i(0x7f800000)) - vec8i(127);
+	vec8f m = asFloat((bits & vec8i(0x007fffff)) | vec8i(0x3f800000));	// [1, 2)
+	// center the mantissa on 1: [sqrt(1/2), sqrt(2))
+	vec8f big = m > vec8f(1.41421356f);
+	m = select(big, m * vec8f(0.5f), m);
+	vec8f e = toFloat(exponent) + (big & vec8f(1.0f));
+	// log2(m) = 2 atanh(t) / ln 2 with t = (m - 1) / (m + 1), |t| < 0.172
+	vec8f t = (m - vec8f(1.0f)) / (m + vec8f(1.0f));
+	vec8f t2 = t * t;
+	vec8f p(0.32059874f);			// 2 / (9 ln 2)
+	p = madd(p, t2, vec8f(0.41219842f));	// 2 / (7 ln 2)
+	p = madd(p, t2, vec8f(0.57707801f));	// 2 / (5 ln 2)
+	p = madd(p, t2, vec8f(0.96179669f));	// 2 / (3 ln 2)
+	p = madd(p, t2, vec8f(2.88539008f));	// 2 / ln 2
+	vec8f r = madd(p, t, e);
+	r = select(a == vec8f(0.0f), vec8f(-INFINITY), r);
+	r = select(a < vec8f(0.0f), vec8f(NAN), r);
+	return select(a == vec8f(INFINITY), a, r);
+}
+
+// a lane-index vector 0..7, handy for building per-lane offsets
+SIMD_INLINE vec8i laneIndex() { return vec8i(0, 1, 2, 3, 4, 5, 6, 7); }
+
+// the inverse of movemask(): all bits set in the lanes whose bit is set
+SIMD_INLINE vec8i maskFromBits(int bits)
+{
+	vec8i laneBits(1, 2, 4, 8, 16, 32, 64, 128);
+	return (vec8i(bits) & laneBits) == laneBits;
+}
+
+// number of set bits in a lane mask
+SIMD_INLINE int bitCount(int bits)
+{
+	bits = bits - ((bits >> 1) & 0x55);
+	bits = (bits & 0x33) + ((bits >> 2) & 0x33);
+	return (bits + (bits >> 4)) & 0x0f;
+}
+
+SIMD_INLINE float lane(vec8f a, int i)
+{
+	alignas(32) float values[8];
+	a.store(values);
+	return values[i];
+}
+
+SIMD_INLINE int32_t lane(vec8i a, int i)
+{
+	alignas(32) int32_t values[8];
+	a.store(values);
+	return values[i];
+}
+
+SIMD_INLINE float horizontalMin(vec8f a)
+{
+	alignas(32) float values[8];
+	a.store(values);
+	float r = values[0];
+	for (int i = 1; i < 8; i++)
+		r = values[i] < r ? values[i] : r;
+	return r;
+}
+
+SIMD_INLINE float horizontalMax(vec8f a)
+{
+	alignas(32) float values[8];
+	a.store(values);
+	float r = values[0];
+	for (int i = 1; i < 8; i++)
+		r = values[i] > r ? values[i] : r;
+	return r;
+}
+
+SIMD_INLINE float horizontalSum(vec8f a)
+{
+	alignas(32) float values[8];
+	a.store(values);
+	return ((values[0] + values[1]) + (values[2] + values[3])) + ((values[4] + values[5]) + (values[6] + values[7]));
+}
+
+#endif
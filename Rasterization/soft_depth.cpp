@@ -0,0 +1,45 @@
+#include "soft_depth.h"
+
+#include <algorithm>
+
+using namespace std;
+
+void SoftDepthBuffer::resize(int w, int h, int sampleCount)
+{
+	width = w;
+	height = h;
+	samples = sampleCount;
+	tilesX = (w + SOFT_DEPTH_TILE_SIZE - 1) / SOFT_DEPTH_TILE_SIZE;
+	tilesY = (h + SOFT_DEPTH_TILE_SIZE - 1) / SOFT_DEPTH_TILE_SIZE;
+	blocks.assign((size_t)tilesX * tilesY * 8 * samples, vec8f(1.0f));
+	tileMin.assign((size_t)tilesX * tilesY, 1.0f);
+	tileMax.assign((size_t)tilesX * tilesY, 1.0f);
+}
+
+void SoftDepthBuffer::clear(float value)
+{
+	fill(blocks.begin(), blocks.end(), vec8f(value));
+	fill(tileMin.begin(), tileMin.end(), value);
+	fill(tileMax.begin(), tileMax.end(), value);
+}
+
+float SoftDepthBuffer::depth(int x, int y, int sample) const
+{
+	int tile = tileIndex(x, y);
+	int inside = (y % SOFT_DEPTH_TILE_SIZE) / 2 * 2 + (x % SOFT_DEPTH_TILE_SIZE) / 4;
+	return lane(blocks[((size_t)tile * 8 + inside) * samples + sample], (y & 1) * 4 + (x & 3));
+}
+
+void SoftDepthBuffer::updateTile(int x, int y)
+{
+	int tile = tileIndex(x, y);
+	const vec8f* b = &blocks[(size_t)tile * 8 * samples];
+	vec8f lo = b[0], hi = b[0];
+	for (int i = 1; i < 8 * samples; i++)
+	{
+		lo = min(lo, b[i]);
+		hi = max(hi, b[i]);
+	}
+	tileMin[tile] = horizontalMin(lo);
+	tileMax[tile] = horizontalMax(hi);
+}
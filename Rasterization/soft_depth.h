@@ -0,0 +1,55 @@
+#ifndef SOFT_DEPTH_H
+#define SOFT_DEPTH_H
+
+#include <vector>
+
+#include "simd.h"
+
+// 8x8 pixel tiles; each is the rasterizer's 4x2 block 8 times over
+const int SOFT_DEPTH_TILE_SIZE = 8;
+
+enum SoftDepthFunc
+{
+	SOFT_DEPTH_LESS,
+	SOFT_DEPTH_LEQUAL,
+	SOFT_DEPTH_ALWAYS,
+};
+
+// 32-bit float depth in window space [0, 1], rows bottom-up like
+// SoftFramebuffer. Stored tile by tile and, inside a tile, one vec8f per 4x2
+// block in the rasterizer's lane order, so a depth test is one aligned load.
+// Every tile also keeps the min and max depth it holds; the max lets a
+// triangle skip a whole tile it is behind everywhere. A multisampled buffer
+// keeps one vec8f per sample for each block, next to each other.
+struct SoftDepthBuffer
+{
+	int width = 0;
+	int height = 0;
+	int samples = 1;
+	int tilesX = 0;
+	int tilesY = 0;
+
+	std::vector<vec8f> blocks;
+	std::vector<float> tileMin;
+	std::vector<float> tileMax;
+
+	void resize(int w, int h, int sampleCount = 1);
+	void clear(float depth);
+
+	int tileIndex(int x, int y) const { return (y / SOFT_DEPTH_TILE_SIZE) * tilesX + x / SOFT_DEPTH_TILE_SIZE; }
+
+	// the block holding pixel (x, y), x a multiple of 4 and y of 2
+	vec8f& block(int x, int y, int sample = 0)
+	{
+		int tile = tileIndex(x, y);
+		int inside = (y % SOFT_DEPTH_TILE_SIZE) / 2 * 2 + (x % SOFT_DEPTH_TILE_SIZE) / 4;
+		return blocks[((size_t)tile * 8 + inside) * samples + sample];
+	}
+
+	float depth(int x, int y, int sample = 0) const;
+
+	// recompute min and max of the tile holding (x, y) after writing to it
+	void updateTile(int x, int y);
+};
+
+#endif
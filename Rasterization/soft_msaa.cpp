@@ -0,0 +1,153 @@
+#include "soft_msaa.h"
+
+#include <algorithm>
+#include <cstring>
+
+using namespace std;
+
+// the D3D tables are in 1/16 pixel, hence the multiples of 16
+static const SoftSamplePattern patterns[] = {
+	{ 1, { 0 }, { 0 } },
+	{ 2, { 64, -64 }, { 64, -64 } },
+	{ 4, { -32, 96, -96, 32 }, { -96, -32, 32, 96 } },
+	{ 8, { 16, -16, 80, -48, -80, -112, 48, 112 }, { -48, 48, 16, -80, 80, -16, 112, -112 } },
+};
+
+const SoftSamplePattern& softSamplePattern(int samples)
+{
+	for (const SoftSamplePattern& pattern : patterns)
+	{
+		if (pattern.count >= samples)
+			return pattern;
+	}
+	return patterns[3];
+}
+
+void SoftMultisampleFramebuffer::resize(int w, int h, int sampleCount)
+{
+	width = w;
+	height = h;
+	samples = softSamplePattern(sampleCount).count;
+	tilesX = (w + SOFT_DEPTH_TILE_SIZE - 1) / SOFT_DEPTH_TILE_SIZE;
+	tilesY = (h + SOFT_DEPTH_TILE_SIZE - 1) / SOFT_DEPTH_TILE_SIZE;
+	stride = tilesX * SOFT_DEPTH_TILE_SIZE;
+	color.assign((size_t)stride * tilesY * SOFT_DEPTH_TILE_SIZE, 0);
+	tileSlot.assign((size_t)tilesX * tilesY, -1);
+	sampleColor.clear();
+	freeSlots.clear();
+}
+
+void SoftMultisampleFramebuffer::clear(uint32_t rgba)
+{
+	fill(color.begin(), color.end(), rgba);
+	fill(tileSlot.begin(), tileSlot.end(), -1);
+	// keeps the capacity, so expanding tiles again doesn't allocate
+	sampleColor.clear();
+	freeSlots.clear();
+}
+
+void SoftMultisampleFramebuffer::expandTile(int tile)
+{
+	int slot;
+	if (freeSlots.empty())
+	{
+		slot = (int)(sampleColor.size() / (8 * samples));
+		sampleColor.resize(sampleColor.size() + 8 * samples);
+	}
+	else
+	{
+		slot = freeSlots.back();
+		freeSlots.pop_back();
+	}
+	tileSlot[tile] = slot;
+
+	int tx = tile % tilesX * SOFT_DEPTH_TILE_SIZE;
+	int ty = tile / tilesX * SOFT_DEPTH_TILE_SIZE;
+	vec8i* out = &sampleColor[(size_t)slot * 8 * samples];
+	for (int y = ty; y < ty + SOFT_DEPTH_TILE_SIZE; y += 2)
+	{
+		for (int x = tx; x < tx + SOFT_DEPTH_TILE_SIZE; x += 4)
+		{
+			vec8i pixels = vec8i::load2(row(y) + x, row(y + 1) + x);
+			for (int s = 0; s < samples; s++)
+				*out++ = pixels;
+		}
+	}
+}
+
+void SoftMultisampleFramebuffer::resolve(SoftFramebuffer& target)
+{
+	if (target.width != width || target.height != height)
+		target.resize(width, height);
+
+	const vec8i byteMask(0xff);
+	const vec8f scale(1.0f / samples);
+	for (int tile = 0; tile < tilesX * tilesY; tile++)
+	{
+		int tx = tile % tilesX * SOFT_DEPTH_TILE_SIZE;
+		int ty = tile / tilesX * SOFT_DEPTH_TILE_SIZE;
+		if (tileSlot[tile] < 0)
+		{
+			int count = min(SOFT_DEPTH_TILE_SIZE, width - tx);
+			for (int y = ty; y < min(ty + SOFT_DEPTH_TILE_SIZE, height); y++)
+				memcpy(target.row(y) + tx, row(y) + tx, count * sizeof(uint32_t));
+			continue;
+		}
+
+		bool uniform = true;
+		for (int y = ty; y < ty + SOFT_DEPTH_TILE_SIZE; y += 2)
+		{
+			for (int x = tx; x < tx + SOFT_DEPTH_TILE_SIZE; x += 4)
+			{
+				const vec8i* in = sampleBlock(tile, x, y);
+				vec8i sum[4] = { vec8i::zero(), vec8i::zero(), vec8i::zero(), vec8i::zero() };
+				int same = 0xff;
+				for (int s = 0; s < samples; s++)
+				{
+					vec8i c = in[s];
+					sum[0] = sum[0] + (c & byteMask);
+					sum[1] = sum[1] + (shiftRight<8>(c) & byteMask);
+					sum[2] = sum[2] + (shiftRight<16>(c) & byteMask);
+					sum[3] = sum[3] + shiftRight<24>(c);
+					same &= movemask(c == in[0]);
+				}
+				uniform = uniform && same == 0xff;
+				if (x >= width || y >= height)
+					continue;
+
+				vec8i average[4];
+				for (int c = 0; c < 4; c++)
+					average[c] = toIntRound(toFloat(sum[c]) * scale);
+				vec8i packed = average[0] | shiftLeft<8>(average[1]) | shiftLeft<16>(average[2]) | shiftLeft<24>(average[3]);
+				packed.store2(target.row(y) + x, target.row(y + 1) + x);
+			}
+		}
+
+		// every pixel's samples agree again, e.g. after a triangle covered the
+		// whole tile: back to one color per pixel
+		if (uniform)
+		{
+			for (int y = ty; y < ty + SOFT_DEPTH_TILE_SIZE; y += 2)
+			{
+				for (int x = tx; x < tx + SOFT_DEPTH_TILE_SIZE; x += 4)
+					sampleBlock(tile, x, y)[0].store2(row(y) + x, row(y + 1) + x);
+			}
+			freeSlots.push_back(tileSlot[tile]);
+			tileSlot[tile] = -1;
+		}
+	}
+}
+
+uint32_t SoftMultisampleFramebuffer::sample(int x, int y, int s) const
+{
+	int tile = tileIndex(x, y);
+	if (tileSlot[tile] < 0)
+		return color[(size_t)y * stride + x];
+	int inside = (y % SOFT_DEPTH_TILE_SIZE) / 2 * 2 + (x % SOFT_DEPTH_TILE_SIZE) / 4;
+	return (uint32_t)lane(sampleColor[((size_t)tileSlot[tile] * 8 + inside) * samples + s], (y & 1) * 4 + (x & 3));
+}
+
+size_t SoftMultisampleFramebuffer::memoryBytes() const
+{
+	return color.size() * sizeof(uint32_t) + tileSlot.size() * sizeof(int32_t) + (size_t)expandedTiles() * 8 * samples * sizeof(vec8i);
+}
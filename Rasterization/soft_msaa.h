@@ -0,0 +1,75 @@
+#ifndef SOFT_MSAA_H
+#define SOFT_MSAA_H
+
+#include <cstdint>
+#include <vector>
+
+#include "simd.h"
+#include "soft_depth.h"
+#include "soft_raster.h"
+
+const int SOFT_MAX_SAMPLES = 8;
+
+// Sample positions relative to the pixel center in 1/256 pixel, y up. These
+// are the standard D3D patterns, which Mesa and most GL drivers report for
+// GL_SAMPLE_POSITION too.
+struct SoftSamplePattern
+{
+	int count;
+	int x[SOFT_MAX_SAMPLES];
+	int y[SOFT_MAX_SAMPLES];
+};
+
+// 1, 2, 4 or 8 samples; other counts get the next larger pattern
+const SoftSamplePattern& softSamplePattern(int samples);
+
+// Multisampled RGBA8 color in the same 8x8 tiles as SoftDepthBuffer. The
+// rasterizer shades once per pixel and writes the color to the covered
+// samples. As long as every pixel of a tile had all its samples covered the
+// tile is compressed: it keeps one color per pixel, like a 1x framebuffer.
+// The first partially covered pixel expands the tile to a color per sample,
+// stored per 4x2 block as one vec8i per sample. Only triangle edges expand
+// tiles, so memory and resolve cost grow with the edges, not the area.
+struct SoftMultisampleFramebuffer
+{
+	int width = 0;
+	int height = 0;
+	int samples = 1;
+	int tilesX = 0;
+	int tilesY = 0;
+	int stride = 0;		// pixels per row, whole tiles
+
+	std::vector<uint32_t> color;		// per pixel, valid for compressed tiles
+	std::vector<int32_t> tileSlot;		// per tile: -1 compressed, else index into sampleColor
+	std::vector<vec8i> sampleColor;		// 8 blocks * samples per expanded tile
+	std::vector<int32_t> freeSlots;
+
+	void resize(int w, int h, int sampleCount);
+	void clear(uint32_t rgba);
+
+	uint32_t* row(int y) { return &color[(size_t)y * stride]; }
+	int tileIndex(int x, int y) const { return (y / SOFT_DEPTH_TILE_SIZE) * tilesX + x / SOFT_DEPTH_TILE_SIZE; }
+
+	// the per-sample colors of the block holding pixel (x, y) in tile, which
+	// must be expanded: samples vec8i in a row
+	vec8i* sampleBlock(int tile, int x, int y)
+	{
+		int inside = (y % SOFT_DEPTH_TILE_SIZE) / 2 * 2 + (x % SOFT_DEPTH_TILE_SIZE) / 4;
+		return &sampleColor[((size_t)tileSlot[tile] * 8 + inside) * samples];
+	}
+
+	// switch a compressed tile to a color per sample, copying each pixel's
+	// color to all its samples
+	void expandTile(int tile);
+
+	// average the samples of every pixel into target, 8 pixels at a time;
+	// expanded tiles whose pixels turn out uniform are compressed again
+	void resolve(SoftFramebuffer& target);
+
+	uint32_t sample(int x, int y, int s) const;
+	int expandedTiles() const { return (int)(sampleColor.size() / (8 * samples)) - (int)freeSlots.size(); }
+	// bytes in use: the per-pixel colors, the tile table and expanded tiles
+	size_t memoryBytes() const;
+};
+
+#endif
@@ -0,0 +1,659 @@
+#include "soft_raster.h"
+#include "soft_msaa.h"
+
+#include <algorithm>
+#include <cmath>
+#include <cstring>
+#include <iostream>
+
+using namespace std;
+
+void SoftFramebuffer::resize(int w, int h)
+{
+	width = w;
+	height = h;
+	stride = (w + 3) & ~3;
+	color.assign((size_t)stride * ((h + 1) & ~1), 0);
+}
+
+void SoftFramebuffer::clear(uint32_t rgba)
+{
+	fill(color.begin(), color.end(), rgba);
+}
+
+void SoftVertexBuffer::resize(int vertexCount, int varyings)
+{
+	count = vertexCount;
+	varyingCount = min(varyings, SOFT_MAX_VARYINGS);
+	stride = (vertexCount + 7) & ~7;
+	data.assign((size_t)stride * (4 + varyingCount), 0.0f);
+}
+
+void SoftVertexBuffer::setPosition(int vertex, float x, float y, float z, float w)
+{
+	column(0)[vertex] = x;
+	column(1)[vertex] = y;
+	column(2)[vertex] = z;
+	column(3)[vertex] = w;
+}
+
+void SoftInterpolator::setup(const SoftVertexBuffer& vertices, int v0, int v1, int v2, const float z[3])
+{
+	const float* w = vertices.column(3);
+	invW[0] = 1.0f / w[v0];
+	invW[1] = 1.0f / w[v1];
+	invW[2] = 1.0f / w[v2];
+	z0 = z[0];
+	dz1 = z[1] - z[0];
+	dz2 = z[2] - z[0];
+
+	varyingCount = vertices.varyingCount;
+	for (int i = 0; i < varyingCount; i++)
+	{
+		const float* v = vertices.varying(i);
+		base[i] = v[v0];
+		delta1[i] = v[v1] - v[v0];
+		delta2[i] = v[v2] - v[v0];
+	}
+}
+
+void SoftRasterizer::setTarget(SoftFramebuffer* target)
+{
+	framebuffer = target;
+	multisample = nullptr;
+}
+
+void SoftRasterizer::setTarget(SoftMultisampleFramebuffer* target)
+{
+	framebuffer = nullptr;
+	multisample = target;
+}
+
+void SoftRasterizer::setDepthTarget(SoftDepthBuffer* depth, SoftDepthFunc func, bool write)
+{
+	depthBuffer = depth;
+	depthFunc = func;
+	depthWrite = write;
+}
+
+// The triangle's view from setupTriangles: window positions, orientation and
+// the pixels it can cover
+struct SoftRasterizer::Triangle
+{
+	int index[3];			// counter-clockwise
+	int32_t fx[3], fy[3];		// window position in 1/256 pixel
+	float z[3];			// window depth
+	int64_t area;			// twice the area in 1/256 pixel units, > 0
+	int minX, minY, maxX, maxY;	// bounding box clamped to the target
+};
+
+// outcode bits: outside the view volume, or needing the clipper
+enum
+{
+	CLIP_LEFT = 1,
+	CLIP_RIGHT = 2,
+	CLIP_BOTTOM = 4,
+	CLIP_TOP = 8,
+	CLIP_NEAR = 16,
+	CLIP_FAR = 32,
+	CLIP_GUARD = 64,		// past the guard band, or w <= 0
+};
+
+void SoftRasterizer::drawTriangles(const SoftVertexBuffer& vertices, const uint32_t* indices, int indexCount, SoftFragmentShader& shader)
+{
+	if (!framebuffer && !multisample)
+		return;
+	int width = framebuffer ? framebuffer->width : multisample->width;
+	int height = framebuffer ? framebuffer->height : multisample->height;
+	int samples = framebuffer ? 1 : multisample->samples;
+	if (depthBuffer && (depthBuffer->width != width || depthBuffer->height != height || depthBuffer->samples != samples))
+	{
+		cout << "ERROR::SOFT_RASTER::DEPTH_TARGET_SIZE_MISMATCH" << endl;
+		return;
+	}
+	if (!indices)
+		indexCount = vertices.count;
+
+	const int triangleCount = indexCount / 3;
+	const int batchSize = batchedSetup ? 8 : 1;
+	int32_t index[3 * 8];
+	Triangle batch[8];
+	counters.triangles += triangleCount;
+	for (int first = 0; first < triangleCount; first += batchSize)
+	{
+		int count = min(batchSize, triangleCount - first);
+		for (int i = 0; i < 3 * count; i++)
+			index[i] = indices ? (int32_t)indices[3 * first + i] : 3 * first + i;
+		int clip = 0;
+		int accepted = setupTriangles(vertices, index, count, CLIP_NEAR | CLIP_FAR | CLIP_GUARD, batch, clip);
+		counters.culledTriangles += bitCount(((1 << count) - 1) & ~accepted & ~clip);
+
+		// in order, which the depth test's ties and the color writes depend on
+		for (int t = 0; t < count; t++)
+		{
+			if (clip & (1 << t))
+				drawClipped(vertices, &index[3 * t], shader);
+			else if (accepted & (1 << t))
+			{
+				if (multisample)
+					drawTriangle<true>(vertices, batch[t], shader);
+				else
+					drawTriangle<false>(vertices, batch[t], shader);
+			}
+		}
+	}
+}
+
+int SoftRasterizer::setupTriangles(const SoftVertexBuffer& vertices, const int32_t* index, int count, int clipPlanes,
+	Triangle* out, int& clipMask) const
+{
+	const int width = multisample ? multisample->width : framebuffer->width;
+	const int height = multisample ? multisample->height : framebuffer->height;
+	const float halfWidth = 0.5f * width;
+	const float halfHeight = 0.5f * height;
+	const int valid = (1 << count) - 1;
+
+	// lane t is triangle t; the lanes past count repeat triangle 0
+	alignas(32) int32_t vertexIndex[3][8];
+	for (int t = 0; t < 8; t++)
+	{
+		for (int k = 0; k < 3; k++)
+			vertexIndex[k][t] = index[3 * (t < count ? t : 0) + k];
+	}
+
+	// outcodes per vertex, ANDed to reject triangles outside one plane and
+	// ORed to find the ones to clip
+	const vec8f guardX(SOFT_GUARD_BAND / halfWidth), guardY(SOFT_GUARD_BAND / halfHeight);
+	vec8f x[3], y[3], z[3], w[3];
+	vec8f outsideAll[6], outsideAny[7];
+	for (int k = 0; k < 3; k++)
+	{
+		vec8i i = vec8i::load(vertexIndex[k]);
+		x[k] = gather(vertices.column(0), i);
+		y[k] = gather(vertices.column(1), i);
+		z[k] = gather(vertices.column(2), i);
+		w[k] = gather(vertices.column(3), i);
+		// a NaN position fails the guard test and goes to the clipper,
+		// which drops it
+		vec8f inside = (w[k] > vec8f::zero()) & (abs(x[k]) <= guardX * w[k]) & (abs(y[k]) <= guardY * w[k]);
+		const vec8f outside[7] = { x[k] < -w[k], x[k] > w[k], y[k] < -w[k], y[k] > w[k], z[k] < -w[k], z[k] > w[k], andnot(inside, asFloat(vec8i(-1))) };
+		for (int p = 0; p < 7; p++)
+		{
+			if (p < 6)
+				outsideAll[p] = k == 0 ? outside[p] : outsideAll[p] & outside[p];
+			outsideAny[p] = k == 0 ? outside[p] : outsideAny[p] | outside[p];
+		}
+	}
+	int rejected = 0;
+	clipMask = 0;
+	for (int p = 0; p < 7; p++)
+	{
+		if (p < 6)
+			rejected |= movemask(outsideAll[p]);
+		if (clipPlanes & (1 << p))
+			clipMask |= movemask(outsideAny[p]);
+	}
+	clipMask &= valid & ~rejected;
+	int accepted = valid & ~rejected & ~clipMask;
+	if (!accepted)
+		return 0;
+
+	// viewport transform and snapping to the subpixel grid, in the order GL
+	// applies them so that rounding agrees
+	const vec8f subpixel((float)(1 << SOFT_SUBPIXEL_BITS));
+	vec8i fx[3], fy[3];
+	vec8f windowZ[3];
+	for (int k = 0; k < 3; k++)
+	{
+		vec8f invW = vec8f(1.0f) / w[k];
+		fx[k] = toIntRound((x[k] * invW * vec8f(halfWidth) + vec8f(halfWidth)) * subpixel);
+		fy[k] = toIntRound((y[k] * invW * vec8f(halfHeight) + vec8f(halfHeight)) * subpixel);
+		windowZ[k] = clamp(z[k] * invW * vec8f(0.5f) + vec8f(0.5f), vec8f::zero(), vec8f(1.0f));
+	}
+
+	// The differences are below 2^20 and exact in float, the products are
+	// not: the float area is off by less than 2^18, so only a larger one
+	// decides the winding here. The exact area below settles the rest.
+	vec8f dx1 = toFloat(fx[1] - fx[0]), dy1 = toFloat(fy[1] - fy[0]);
+	vec8f dx2 = toFloat(fx[2] - fx[0]), dy2 = toFloat(fy[2] - fy[0]);
+	vec8f area = dx1 * dy2 - dx2 * dy1;
+	const vec8f certain((float)(1 << 18));
+	if (cullMode == SOFT_CULL_BACK)
+		accepted &= ~movemask(area < -certain);
+	else if (cullMode == SOFT_CULL_FRONT)
+		accepted &= ~movemask(area > certain);
+
+	// bounding box of the pixels that may be covered, clamped to the target;
+	// with multisampling no sample is more than half a pixel from the center
+	const int half = 1 << (SOFT_SUBPIXEL_BITS - 1);
+	const int reach = multisample ? half : 0;
+	vec8i minX = max(vec8i::zero(), shiftRightArithmetic<SOFT_SUBPIXEL_BITS>(min(min(fx[0], fx[1]), fx[2]) + vec8i((1 << SOFT_SUBPIXEL_BITS) - 1 - half - reach)));
+	vec8i minY = max(vec8i::zero(), shiftRightArithmetic<SOFT_SUBPIXEL_BITS>(min(min(fy[0], fy[1]), fy[2]) + vec8i((1 << SOFT_SUBPIXEL_BITS) - 1 - half - reach)));
+	vec8i maxX = min(vec8i(width - 1), shiftRightArithmetic<SOFT_SUBPIXEL_BITS>(max(max(fx[0], fx[1]), fx[2]) + vec8i(reach - half)));
+	vec8i maxY = min(vec8i(height - 1), shiftRightArithmetic<SOFT_SUBPIXEL_BITS>(max(max(fy[0], fy[1]), fy[2]) + vec8i(reach - half)));
+	accepted &= ~movemask((minX > maxX) | (minY > maxY));
+	if (!accepted)
+		return 0;
+
+	alignas(32) int32_t laneFx[3][8], laneFy[3][8], box[4][8];
+	alignas(32) float laneZ[3][8];
+	for (int k = 0; k < 3; k++)
+	{
+		fx[k].store(laneFx[k]);
+		fy[k].store(laneFy[k]);
+		windowZ[k].store(laneZ[k]);
+	}
+	minX.store(box[0]);
+	minY.store(box[1]);
+	maxX.store(box[2]);
+	maxY.store(box[3]);
+	for (int t = 0; t < count; t++)
+	{
+		if (!(accepted & (1 << t)))
+			continue;
+		Triangle& triangle = out[t];
+		for (int k = 0; k < 3; k++)
+		{
+			triangle.index[k] = vertexIndex[k][t];
+			triangle.fx[k] = laneFx[k][t];
+			triangle.fy[k] = laneFy[k][t];
+			triangle.z[k] = laneZ[k][t];
+		}
+		int64_t exact = ((int64_t)triangle.fx[1] - triangle.fx[0]) * ((int64_t)triangle.fy[2] - triangle.fy[0])
+			- ((int64_t)triangle.fx[2] - triangle.fx[0]) * ((int64_t)triangle.fy[1] - triangle.fy[0]);
+		if (exact == 0 || (cullMode == SOFT_CULL_BACK && exact < 0) || (cullMode == SOFT_CULL_FRONT && exact > 0))
+		{
+			accepted &= ~(1 << t);
+			continue;
+		}
+		if (exact < 0)
+		{
+			// make it counter-clockwise, the interpolator follows the new order
+			swap(triangle.index[1], triangle.index[2]);
+			swap(triangle.fx[1], triangle.fx[2]);
+			swap(triangle.fy[1], triangle.fy[2]);
+			swap(triangle.z[1], triangle.z[2]);
+			exact = -exact;
+		}
+		triangle.area = exact;
+		triangle.minX = box[0][t];
+		triangle.minY = box[1][t];
+		triangle.maxX = box[2][t];
+		triangle.maxY = box[3][t];
+	}
+	return accepted;
+}
+
+// Sutherland-Hodgman in clip space against the near and far planes and the
+// guard band, whichever the triangle crosses. Varyings are interpolated
+// linearly in clip space, which keeps them perspective-correct. The polygon
+// is drawn as a fan.
+void SoftRasterizer::drawClipped(const SoftVertexBuffer& vertices, const int32_t index[3], SoftFragmentShader& shader)
+{
+	counters.clippedTriangles++;
+	const int width = multisample ? multisample->width : framebuffer->width;
+	const int height = multisample ? multisample->height : framebuffer->height;
+	const int components = 4 + vertices.varyingCount;
+
+	// a pixel inside the guard band, so the clipped vertices pass its test
+	// despite rounding
+	const float guardX = (SOFT_GUARD_BAND - 1) / (0.5f * width);
+	const float guardY = (SOFT_GUARD_BAND - 1) / (0.5f * height);
+	const float planes[6][4] = {
+		{ 0.0f, 0.0f, 1.0f, 1.0f },		// near: z >= -w
+		{ 0.0f, 0.0f, -1.0f, 1.0f },		// far: z <= w
+		{ 1.0f, 0.0f, 0.0f, guardX },
+		{ -1.0f, 0.0f, 0.0f, guardX },
+		{ 0.0f, 1.0f, 0.0f, guardY },
+		{ 0.0f, -1.0f, 0.0f, guardY },
+	};
+
+	// every plane adds at most one vertex
+	const int maxVertices = 3 + 6;
+	float polygon[2][maxVertices][4 + SOFT_MAX_VARYINGS];
+	int count = 3;
+	for (int k = 0; k < 3; k++)
+	{
+		for (int c = 0; c < components; c++)
+			polygon[0][k][c] = vertices.column(c)[index[k]];
+	}
+
+	int current = 0;
+	for (const auto& plane : planes)
+	{
+		float distance[maxVertices];
+		bool outside = false;
+		for (int k = 0; k < count; k++)
+		{
+			const float* v = polygon[current][k];
+			distance[k] = plane[0] * v[0] + plane[1] * v[1] + plane[2] * v[2] + plane[3] * v[3];
+			outside = outside || !(distance[k] >= 0.0f);
+		}
+		if (!outside)
+			continue;
+
+		int next = 0;
+		for (int k = 0; k < count; k++)
+		{
+			int l = k + 1 < count ? k + 1 : 0;
+			const float* a = polygon[current][k];
+			const float* b = polygon[current][l];
+			if (distance[k] >= 0.0f)
+				memcpy(polygon[1 - current][next++], a, components * sizeof(float));
+			if ((distance[k] >= 0.0f && distance[l] < 0.0f) || (distance[k] < 0.0f && distance[l] >= 0.0f))
+			{
+				float t = distance[k] / (distance[k] - distance[l]);
+				float* v = polygon[1 - current][next++];
+				for (int c = 0; c < components; c++)
+					v[c] = a[c] + (b[c] - a[c]) * t;
+			}
+		}
+		current = 1 - current;
+		count = next;
+		if (count < 3)
+			return;
+	}
+
+	clipped.resize(count, vertices.varyingCount);
+	for (int k = 0; k < count; k++)
+	{
+		for (int c = 0; c < components; c++)
+			clipped.column(c)[k] = polygon[current][k][c];
+	}
+
+	// at most 7 triangles, one batch; a vertex that still ends up past the
+	// guard band or at w <= 0 after all drops its triangle
+	int32_t fan[3 * 8];
+	Triangle batch[8];
+	for (int t = 0; t < count - 2; t++)
+	{
+		fan[3 * t] = 0;
+		fan[3 * t + 1] = t + 1;
+		fan[3 * t + 2] = t + 2;
+	}
+	int rest = 0;
+	int accepted = setupTriangles(clipped, fan, count - 2, CLIP_GUARD, batch, rest);
+	for (int t = 0; t < count - 2; t++)
+	{
+		if (!(accepted & (1 << t)))
+			continue;
+		if (multisample)
+			drawTriangle<true>(clipped, batch[t], shader);
+		else
+			drawTriangle<false>(clipped, batch[t], shader);
+	}
+}
+
+// edge function E(p) = a * p.x + b * p.y + c in 1/256 pixel units, positive
+// inside a counter-clockwise triangle
+struct EdgeFunction
+{
+	int64_t a, b, c;
+	int64_t bias;		// 0 on edges that own their pixels, -1 elsewhere, so E + bias >= 0 is inside
+};
+
+static EdgeFunction makeEdge(int32_t ax, int32_t ay, int32_t bx, int32_t by)
+{
+	EdgeFunction e;
+	e.a = (int64_t)ay - by;
+	e.b = (int64_t)bx - ax;
+	e.c = -(e.a * ax + e.b * ay);
+	// GL leaves the tie-break to the implementation. This is the top-left
+	// rule seen with y pointing down, as Mesa does it: with y up, edges
+	// running downwards and horizontal edges running left to right own the
+	// pixel centers they pass through.
+	bool owner = e.a > 0 || (e.a == 0 && e.b > 0);
+	e.bias = owner ? 0 : -1;
+	return e;
+}
+
+template<bool multisampled>
+void SoftRasterizer::drawTriangle(const SoftVertexBuffer& vertices, const Triangle& triangle, SoftFragmentShader& shader)
+{
+	const int width = multisampled ? multisample->width : framebuffer->width;
+	const int height = multisampled ? multisample->height : framebuffer->height;
+	const int* index = triangle.index;
+	const int32_t* fx = triangle.fx;
+	const int32_t* fy = triangle.fy;
+	const float* z = triangle.z;
+	const int64_t area = triangle.area;
+
+	// with multisampling every pixel is covered at its samples instead of its
+	// center; none is more than half a pixel from the center
+	const SoftSamplePattern& pattern = softSamplePattern(multisampled ? multisample->samples : 1);
+	const int sampleCount = multisampled ? pattern.count : 1;
+	const int half = 1 << (SOFT_SUBPIXEL_BITS - 1);
+	const int reach = multisampled ? half : 0;
+
+	// whole blocks from the lower left
+	const int minX = triangle.minX & ~3;
+	const int minY = triangle.minY & ~1;
+	const int maxX = triangle.maxX;
+	const int maxY = triangle.maxY;
+
+	// edge k is opposite vertex k, so E_k / area is its barycentric
+	EdgeFunction edges[3] = {
+		makeEdge(fx[1], fy[1], fx[2], fy[2]),
+		makeEdge(fx[2], fy[2], fx[0], fy[0]),
+		makeEdge(fx[0], fy[0], fx[1], fy[1]),
+	};
+
+	// Each edge is evaluated exactly in int64 once per block and per lane in
+	// int32. The guard band bounds a and b by 2^19, so a block spans less
+	// than 2^29 and a sample offset less than 2^27; clamping the block value
+	// to +-2^30 can't change any lane's sign and keeps the lanes from
+	// overflowing.
+	const vec8i laneX = laneIndex() & vec8i(3);
+	const vec8i laneY = shiftRight<2>(laneIndex());
+	const int64_t limit = (int64_t)1 << 30;
+	// a and b are signed, and shifting a negative value left is undefined
+	const int64_t subpixel = (int64_t)1 << SOFT_SUBPIXEL_BITS;
+	vec8i laneOffset[3];
+	vec8f laneBary[2];
+	const float invArea = 1.0f / (float)area;
+	for (int k = 0; k < 3; k++)
+	{
+		laneOffset[k] = laneX * vec8i((int32_t)(edges[k].a * subpixel)) + laneY * vec8i((int32_t)(edges[k].b * subpixel));
+		if (k > 0)
+			laneBary[k - 1] = toFloat(laneOffset[k]) * vec8f(invArea);
+	}
+
+	// Shading happens at the pixel center; coverage and depth per sample,
+	// with depth extrapolated from the center along the triangle's plane
+	const float dzdx = (float)(((double)(z[1] - z[0]) * edges[1].a + (double)(z[2] - z[0]) * edges[2].a) / (double)area);
+	const float dzdy = (float)(((double)(z[1] - z[0]) * edges[1].b + (double)(z[2] - z[0]) * edges[2].b) / (double)area);
+	vec8i sampleOffset[SOFT_MAX_SAMPLES][3];
+	float sampleDz[SOFT_MAX_SAMPLES];
+	for (int s = 0; s < sampleCount; s++)
+	{
+		for (int k = 0; k < 3; k++)
+			sampleOffset[s][k] = vec8i((int32_t)(edges[k].a * pattern.x[s] + edges[k].b * pattern.y[s]));
+		sampleDz[s] = dzdx * pattern.x[s] + dzdy * pattern.y[s];
+	}
+
+	SoftInterpolator interpolator;
+	interpolator.setup(vertices, index[0], index[1], index[2], z);
+
+	SoftFragmentBlock block;
+	block.varyingCount = vertices.varyingCount;
+
+	// Window depth is a plane over the triangle, so its extremes over a tile
+	// are at the tile's corners, widened by how far samples reach. The margin
+	// covers the float rounding of the per-pixel depth, keeping the tile
+	// bounds conservative.
+	const double depthScale = 1.0 / (double)area;
+	const float depthMargin = 1.0f / (1 << 18) + (fabs(dzdx) + fabs(dzdy)) * reach;
+	const float triangleMinZ = min({ z[0], z[1], z[2] });
+	const float triangleMaxZ = max({ z[0], z[1], z[2] });
+	auto edgeAt = [&](int k, int px, int py)
+	{
+		return edges[k].a * (((int64_t)px << SOFT_SUBPIXEL_BITS) + half) + edges[k].b * (((int64_t)py << SOFT_SUBPIXEL_BITS) + half) + edges[k].c;
+	};
+	auto depthAt = [&](int px, int py)
+	{
+		return (float)(z[0] + ((z[1] - z[0]) * (double)edgeAt(1, px, py) + (z[2] - z[0]) * (double)edgeAt(2, px, py)) * depthScale);
+	};
+
+	int64_t blockStep[3];
+	int64_t edgeReach[3];
+	for (int k = 0; k < 3; k++)
+	{
+		blockStep[k] = edges[k].a * subpixel * 4;
+		edgeReach[k] = (llabs(edges[k].a) + llabs(edges[k].b)) * reach;
+	}
+
+	const int tile = SOFT_DEPTH_TILE_SIZE;
+	for (int ty = minY & ~(tile - 1); ty <= maxY; ty += tile)
+	{
+		for (int tx = minX & ~(tile - 1); tx <= maxX; tx += tile)
+		{
+			// the part of the bounding box in this tile, still whole blocks
+			int x0 = max(tx, minX), x1 = min(tx + tile - 1, maxX);
+			int y0 = max(ty, minY), y1 = min(ty + tile - 1, maxY);
+
+			// the corner where each edge function is largest
+			bool outside = false;
+			for (int k = 0; k < 3 && !outside; k++)
+				outside = edgeAt(k, edges[k].a > 0 ? x1 : x0, edges[k].b > 0 ? y1 : y0) + edgeReach[k] + edges[k].bias < 0;
+			if (outside)
+				continue;
+
+			bool depthTest = depthBuffer && depthFunc != SOFT_DEPTH_ALWAYS;
+			if (depthTest && hierarchicalDepth)
+			{
+				float lo = triangleMaxZ, hi = triangleMinZ;
+				const int cornerX[4] = { x0, x1, x0, x1 };
+				const int cornerY[4] = { y0, y0, y1, y1 };
+				for (int c = 0; c < 4; c++)
+				{
+					float d = depthAt(cornerX[c], cornerY[c]);
+					lo = min(lo, d);
+					hi = max(hi, d);
+				}
+				lo = max(lo - depthMargin, triangleMinZ - 1.0f / (1 << 18));
+				hi = min(hi + depthMargin, triangleMaxZ + 1.0f / (1 << 18));
+
+				int index = depthBuffer->tileIndex(tx, ty);
+				float tileMax = depthBuffer->tileMax[index];
+				if (depthFunc == SOFT_DEPTH_LESS ? lo >= tileMax : lo > tileMax)
+				{
+					counters.depthRejectedTiles++;
+					continue;
+				}
+				// in front of everything in the tile: every sample passes
+				if (hi < depthBuffer->tileMin[index])
+					depthTest = false;
+			}
+
+			bool depthWritten = false;
+			for (int y = y0; y <= y1; y += 2)
+			{
+				int rowBits = y + 1 < height ? 0xff : 0x0f;
+				int64_t value[3];
+				for (int k = 0; k < 3; k++)
+					value[k] = edgeAt(k, x0, y) - blockStep[k];
+				uint32_t* row0 = multisampled ? multisample->row(y) : framebuffer->row(y);
+				uint32_t* row1 = multisampled ? multisample->row(y + 1) : framebuffer->row(y + 1);
+				for (int x = x0; x <= x1; x += 4)
+				{
+					vec8i lanes[3];
+					for (int k = 0; k < 3; k++)
+					{
+						value[k] += blockStep[k];
+						int64_t biased = max(-limit, min(limit, value[k] + edges[k].bias));
+						lanes[k] = vec8i((int32_t)biased) + laneOffset[k];
+					}
+
+					// covered lanes per sample, and pixels with any sample covered
+					int columnBits = x + 4 <= width ? 0x0f : (1 << (width - x)) - 1;
+					int valid = (columnBits | (columnBits << 4)) & rowBits;
+					int sampleMask[SOFT_MAX_SAMPLES];
+					int mask = 0;
+					if (!multisampled)
+						mask = sampleMask[0] = ~movemask(lanes[0] | lanes[1] | lanes[2]) & valid;
+					for (int s = 0; s < sampleCount && multisampled; s++)
+					{
+						vec8i outside = (lanes[0] + sampleOffset[s][0]) | (lanes[1] + sampleOffset[s][1]) | (lanes[2] + sampleOffset[s][2]);
+						sampleMask[s] = ~movemask(outside) & valid;
+						mask |= sampleMask[s];
+					}
+					if (!mask)
+						continue;
+					counters.blocks++;
+
+					vec8f l1 = vec8f((float)value[1] * invArea) + laneBary[0];
+					vec8f l2 = vec8f((float)value[2] * invArea) + laneBary[1];
+					block.z = interpolator.depth(l1, l2);
+
+					// early depth test, 8 pixels at once per sample
+					if (depthTest)
+					{
+						mask = 0;
+						for (int s = 0; s < sampleCount; s++)
+						{
+							vec8f sampleZ = block.z + vec8f(sampleDz[s]);
+							vec8f stored = depthBuffer->block(x, y, s);
+							vec8f pass = depthFunc == SOFT_DEPTH_LESS ? sampleZ < stored : sampleZ <= stored;
+							sampleMask[s] &= movemask(pass);
+							mask |= sampleMask[s];
+						}
+						if (!mask)
+						{
+							counters.depthRejectedBlocks++;
+							continue;
+						}
+					}
+
+					vec8f p1, p2;
+					interpolator.perspective(l1, l2, p1, p2, block.invW);
+					interpolator.interpolate(p1, p2, block.varyings);
+					block.x = x;
+					block.y = y;
+					block.mask = mask;
+
+					vec8f rgba[4];
+					counters.shadedFragments += bitCount(mask);
+					mask &= shader.shade(block, rgba);
+					if (!mask)
+						continue;
+					counters.fragments += bitCount(mask);
+
+					if (depthBuffer && depthWrite)
+					{
+						for (int s = 0; s < sampleCount; s++)
+						{
+							vec8f& stored = depthBuffer->block(x, y, s);
+							stored = select(asFloat(maskFromBits(sampleMask[s] & mask)), block.z + vec8f(sampleDz[s]), stored);
+						}
+						depthWritten = true;
+					}
+
+					vec8i channel[4];
+					for (int c = 0; c < 4; c++)
+						channel[c] = toIntRound(clamp(rgba[c], vec8f(0.0f), vec8f(1.0f)) * vec8f(255.0f));
+					vec8i packed = channel[0] | shiftLeft<8>(channel[1]) | shiftLeft<16>(channel[2]) | shiftLeft<24>(channel[3]);
+
+					// Pixels with every sample covered keep one color while
+					// the tile is compressed; any other pixel expands it.
+					int fullMask = mask;
+					for (int s = 0; s < sampleCount; s++)
+						fullMask &= sampleMask[s];
+					int colorTile = multisampled ? multisample->tileIndex(x, y) : 0;
+					if (!multisampled || (multisample->tileSlot[colorTile] < 0 && fullMask == mask))
+					{
+						vec8i old = vec8i::load2(row0 + x, row1 + x);
+						select(maskFromBits(mask), packed, old).store2(row0 + x, row1 + x);
+						continue;
+					}
+					if (multisample->tileSlot[colorTile] < 0)
+						multisample->expandTile(colorTile);
+					vec8i* sampleColor = multisample->sampleBlock(colorTile, x, y);
+					for (int s = 0; s < sampleCount; s++)
+						sampleColor[s] = select(maskFromBits(sampleMask[s] & mask), packed, sampleColor[s]);
+				}
+			}
+			if (depthWritten)
+				depthBuffer->updateTile(tx, ty);
+		}
+	}
+}
@@ -0,0 +1,214 @@
+#ifndef SOFT_RASTER_H
+#define SOFT_RASTER_H
+
+#include <cstdint>
+#include <vector>
+
+#include "simd.h"
+#include "soft_depth.h"
+
+// CPU rasterizer for machines without a GPU. It follows the GL rules the
+// hardware path uses: vertices snap to 1/256 pixel, pixels are sampled at
+// their centers, a pixel on a shared edge belongs to exactly one of the
+// triangles (same tie-break as Mesa) and varyings are interpolated
+// perspective-correctly, so the result matches glReadPixels of the same
+// draw up to float rounding.
+//
+// Triangles are set up 8 at a time, one per SIMD lane: projection, snapping,
+// bounding boxes and culling. Only triangles crossing the near or far plane,
+// or reaching past the guard band, are clipped, in homogeneous space; the
+// rest are drawn unclipped and the viewport bounds their pixels.
+//
+// Pixels are processed in 4x2 blocks, two 2x2 quads side by side, one SIMD
+// lane per pixel: lane = (y - block.y) * 4 + (x - block.x). A triangle is
+// walked in 8x8 tiles; a tile outside an edge, or behind everything the depth
+// buffer holds there, is skipped before any coverage is computed.
+
+struct SoftMultisampleFramebuffer;
+
+const int SOFT_MAX_VARYINGS = 16;
+const int SOFT_SUBPIXEL_BITS = 8;
+// triangles reaching further than this many pixels from the viewport center
+// are clipped to it, which keeps every edge function of a 4x2 block inside
+// int32
+const int SOFT_GUARD_BAND = 1024;
+
+// which winding is culled; counter-clockwise in window space is the front,
+// GL's default
+enum SoftCullMode
+{
+	SOFT_CULL_NONE,
+	SOFT_CULL_BACK,
+	SOFT_CULL_FRONT,
+};
+
+// RGBA8 color, rows bottom-up like GL window coordinates so that pixel(x, y)
+// and glReadPixels agree. Storage is padded to whole 4x2 blocks.
+struct SoftFramebuffer
+{
+	int width = 0;
+	int height = 0;
+	int stride = 0;		// pixels per row
+	std::vector<uint32_t> color;
+
+	void resize(int w, int h);
+	void clear(uint32_t rgba);
+
+	uint32_t pixel(int x, int y) const { return color[(size_t)y * stride + x]; }
+	uint32_t* row(int y) { return &color[(size_t)y * stride]; }
+	const uint32_t* row(int y) const { return &color[(size_t)y * stride]; }
+};
+
+inline uint32_t packRGBA8(int r, int g, int b, int a)
+{
+	return (uint32_t)r | ((uint32_t)g << 8) | ((uint32_t)b << 16) | ((uint32_t)a << 24);
+}
+
+// Vertex shader outputs in structure-of-arrays layout: one column of floats
+// per component, clip space position x, y, z, w first and then the varyings,
+// so the vertex stage can write 8 vertices with one store per output.
+struct SoftVertexBuffer
+{
+	int count = 0;
+	int varyingCount = 0;
+	int stride = 0;		// floats per column, count rounded up to 8
+
+	std::vector<float> data;
+
+	void resize(int vertexCount, int varyings);
+
+	float* column(int c) { return &data[(size_t)c * stride]; }
+	const float* column(int c) const { return &data[(size_t)c * stride]; }
+	float* varying(int i) { return column(4 + i); }
+	const float* varying(int i) const { return column(4 + i); }
+
+	void setPosition(int vertex, float x, float y, float z, float w);
+};
+
+// Perspective-correct interpolation for one triangle. setup() keeps each
+// varying as a0, a1 - a0, a2 - a0; perspective() turns the screen space
+// barycentrics of 8 pixels into perspective-correct ones with a single
+// divide, after which every varying costs two multiply-adds per 8 pixels.
+struct SoftInterpolator
+{
+	int varyingCount = 0;
+	float invW[3];
+	float z0, dz1, dz2;
+	float base[SOFT_MAX_VARYINGS];
+	float delta1[SOFT_MAX_VARYINGS];
+	float delta2[SOFT_MAX_VARYINGS];
+
+	// v0..v2 index into vertices; z are the three window space depths
+	void setup(const SoftVertexBuffer& vertices, int v0, int v1, int v2, const float z[3]);
+
+	// window depth is interpolated linearly in screen space, as in GL
+	SIMD_INLINE vec8f depth(vec8f l1, vec8f l2) const
+	{
+		return madd(l2, vec8f(dz2), madd(l1, vec8f(dz1), vec8f(z0)));
+	}
+
+	// oneOverW is the interpolated 1 / clip w, gl_FragCoord.w
+	SIMD_INLINE void perspective(vec8f l1, vec8f l2, vec8f& p1, vec8f& p2, vec8f& oneOverW) const
+	{
+		vec8f q1 = l1 * vec8f(invW[1]);
+		vec8f q2 = l2 * vec8f(invW[2]);
+		vec8f q0 = (vec8f(1.0f) - l1 - l2) * vec8f(invW[0]);
+		oneOverW = q0 + q1 + q2;
+		vec8f r = vec8f(1.0f) / oneOverW;
+		p1 = q1 * r;
+		p2 = q2 * r;
+	}
+
+	SIMD_INLINE void interpolate(vec8f p1, vec8f p2, vec8f* out) const
+	{
+		for (int i = 0; i < varyingCount; i++)
+			out[i] = madd(p2, vec8f(delta2[i]), madd(p1, vec8f(delta1[i]), vec8f(base[i])));
+	}
+};
+
+// the input of one fragment shader invocation: 8 pixels of one triangle
+struct SoftFragmentBlock
+{
+	vec8f z;
+	vec8f invW;		// 1 / clip w
+	vec8f varyings[SOFT_MAX_VARYINGS];
+	int x, y;		// lower left pixel of the block
+	int mask;		// covered lanes
+	int varyingCount;
+};
+
+class SoftFragmentShader
+{
+public:
+	virtual ~SoftFragmentShader() = default;
+
+	// writes RGBA in [0, 1] per lane and returns the lanes to keep, which
+	// lets a shader discard
+	virtual int shade(const SoftFragmentBlock& block, vec8f rgba[4]) = 0;
+};
+
+struct SoftRasterStats
+{
+	uint64_t triangles = 0;
+	uint64_t culledTriangles = 0;		// outside the view, facing away, or covering no pixel
+	uint64_t clippedTriangles = 0;		// crossing the near or far plane or the guard band
+	uint64_t blocks = 0;			// blocks with covered pixels
+	uint64_t depthRejectedTiles = 0;	// tiles skipped on their max depth
+	uint64_t depthRejectedBlocks = 0;	// covered blocks that failed the depth test
+	uint64_t shadedFragments = 0;		// lanes passed to the fragment shader, one per pixel
+	uint64_t fragments = 0;			// lanes written
+};
+
+class SoftRasterizer
+{
+public:
+	void setTarget(SoftFramebuffer* target);
+	// multisampled: coverage and depth per sample, shading once per pixel
+	void setTarget(SoftMultisampleFramebuffer* target);
+
+	// Depth test against a buffer with the size and sample count of the
+	// target, null to disable.
+	// The test runs before the fragment shader, which is safe because
+	// shaders can't write gl_FragDepth; the write happens after it so that
+	// discarded lanes keep their depth.
+	void setDepthTarget(SoftDepthBuffer* depth, SoftDepthFunc func = SOFT_DEPTH_LESS, bool write = true);
+	// tile min/max rejection on top of the per-pixel test, on by default
+	void setHierarchicalDepth(bool enabled) { hierarchicalDepth = enabled; }
+
+	void setCullMode(SoftCullMode mode) { cullMode = mode; }
+	// triangle setup for 8 triangles per SIMD batch, on by default; off sets
+	// up one triangle at a time with the same code, for comparison
+	void setBatchedSetup(bool enabled) { batchedSetup = enabled; }
+
+	// triangles from indices[0..indexCount), or vertices 0,1,2, 3,4,5, ...
+	// when indices is null
+	void drawTriangles(const SoftVertexBuffer& vertices, const uint32_t* indices, int indexCount, SoftFragmentShader& shader);
+
+	const SoftRasterStats& stats() const { return counters; }
+	void resetStats() { counters = SoftRasterStats(); }
+
+private:
+	struct Triangle;
+
+	// Sets up index[3 * t .. 3 * t + 2] for t < count, at most 8, and
+	// returns the triangles to draw as a lane mask. Triangles outside one of
+	// the clipPlanes come back in clipMask instead.
+	int setupTriangles(const SoftVertexBuffer& vertices, const int32_t* index, int count, int clipPlanes,
+		Triangle* out, int& clipMask) const;
+	void drawClipped(const SoftVertexBuffer& vertices, const int32_t index[3], SoftFragmentShader& shader);
+	template<bool multisampled>
+	void drawTriangle(const SoftVertexBuffer& vertices, const Triangle& triangle, SoftFragmentShader& shader);
+
+	SoftFramebuffer* framebuffer = nullptr;
+	SoftMultisampleFramebuffer* multisample = nullptr;
+	SoftDepthBuffer* depthBuffer = nullptr;
+	SoftDepthFunc depthFunc = SOFT_DEPTH_LESS;
+	bool depthWrite = true;
+	bool hierarchicalDepth = true;
+	SoftCullMode cullMode = SOFT_CULL_NONE;
+	bool batchedSetup = true;
+	SoftVertexBuffer clipped;		// the polygon of the triangle being clipped
+	SoftRasterStats counters;
+};
+
+#endif
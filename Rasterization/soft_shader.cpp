@@ -0,0 +1,376 @@
+#include "soft_shader.h"
+#include "shader_preprocessor.h"
+
+#include <algorithm>
+#include <cmath>
+
+using namespace std;
+
+template <typename F>
+static SIMD_INLINE vec8f perLane(vec8f a, F f)
+{
+	alignas(32) float v[8];
+	a.store(v);
+	for (int i = 0; i < 8; i++)
+		v[i] = f(v[i]);
+	return vec8f::load(v);
+}
+
+template <typename F>
+static SIMD_INLINE vec8f perLane(vec8f a, vec8f b, F f)
+{
+	alignas(32) float u[8], v[8];
+	a.store(u);
+	b.store(v);
+	for (int i = 0; i < 8; i++)
+		u[i] = f(u[i], v[i]);
+	return vec8f::load(u);
+}
+
+// lane = row * 4 + column, a quad is columns 0-1 or 2-3 of both rows.
+// The difference is taken across the pixel's own quad, GL's dFdxFine.
+static vec8f quadDerivative(vec8f a, int lanePair)
+{
+	alignas(32) float v[8], d[8];
+	a.store(v);
+	for (int i = 0; i < 8; i++)
+		d[i] = v[i | lanePair] - v[i & ~lanePair];
+	return vec8f::load(d);
+}
+
+void SoftProgram::execute(const SoftShader& shader, vec8f* r, SoftSampler* const* stageSamplers, int lanes)
+{
+	const vec8f zero = vec8f::zero();
+	const vec8f one(1.0f);
+	vec8f exec = asFloat(maskFromBits(lanes));
+	maskStack.clear();
+
+	const SoftInstruction* code = shader.code.data();
+	const int count = (int)shader.code.size();
+	uint64_t steps = 0;
+	for (int pc = 0; pc < count; pc++)
+	{
+		const SoftInstruction& in = code[pc];
+		steps++;
+		switch (in.op)
+		{
+		case SOFT_OP_MOV: r[in.dst] = r[in.a]; break;
+		case SOFT_OP_MOVM: r[in.dst] = select(exec, r[in.a], r[in.dst]); break;
+		case SOFT_OP_ADD: r[in.dst] = r[in.a] + r[in.b]; break;
+		case SOFT_OP_SUB: r[in.dst] = r[in.a] - r[in.b]; break;
+		case SOFT_OP_MUL: r[in.dst] = r[in.a] * r[in.b]; break;
+		case SOFT_OP_DIV: r[in.dst] = r[in.a] / r[in.b]; break;
+		case SOFT_OP_NEG: r[in.dst] = zero - r[in.a]; break;
+		case SOFT_OP_MADD: r[in.dst] = madd(r[in.a], r[in.b], r[in.c]); break;
+		case SOFT_OP_MIN: r[in.dst] = min(r[in.a], r[in.b]); break;
+		case SOFT_OP_MAX: r[in.dst] = max(r[in.a], r[in.b]); break;
+		case SOFT_OP_ABS: r[in.dst] = abs(r[in.a]); break;
+		case SOFT_OP_SIGN: r[in.dst] = ((r[in.a] > zero) & one) - ((r[in.a] < zero) & one); break;
+		case SOFT_OP_FLOOR: r[in.dst] = floor(r[in.a]); break;
+		case SOFT_OP_CEIL: r[in.dst] = zero - floor(zero - r[in.a]); break;
+		case SOFT_OP_FRACT: r[in.dst] = r[in.a] - floor(r[in.a]); break;
+		case SOFT_OP_TRUNC: r[in.dst] = toFloat(toIntTruncate(r[in.a])); break;
+		case SOFT_OP_ROUND: r[in.dst] = toFloat(toIntRound(r[in.a])); break;
+		case SOFT_OP_MOD: r[in.dst] = r[in.a] - r[in.b] * floor(r[in.a] / r[in.b]); break;
+		case SOFT_OP_IDIV: r[in.dst] = toFloat(toIntTruncate(r[in.a] / r[in.b])); break;
+		case SOFT_OP_IMOD: r[in.dst] = r[in.a] - r[in.b] * toFloat(toIntTruncate(r[in.a] / r[in.b])); break;
+		case SOFT_OP_SQRT: r[in.dst] = sqrt(r[in.a]); break;
+		case SOFT_OP_RSQRT: r[in.dst] = one / sqrt(r[in.a]); break;
+		case SOFT_OP_POW: r[in.dst] = exp2(r[in.b] * log2(r[in.a])); break;
+		case SOFT_OP_EXP: r[in.dst] = exp2(r[in.a] * vec8f(1.44269504f)); break;
+		case SOFT_OP_EXP2: r[in.dst] = exp2(r[in.a]); break;
+		case SOFT_OP_LOG: r[in.dst] = log2(r[in.a]) * vec8f(0.69314718f); break;
+		case SOFT_OP_LOG2: r[in.dst] = log2(r[in.a]); break;
+		case SOFT_OP_SIN: r[in.dst] = perLane(r[in.a], [](float x) { return sinf(x); }); break;
+		case SOFT_OP_COS: r[in.dst] = perLane(r[in.a], [](float x) { return cosf(x); }); break;
+		case SOFT_OP_TAN: r[in.dst] = perLane(r[in.a], [](float x) { return tanf(x); }); break;
+		case SOFT_OP_ASIN: r[in.dst] = perLane(r[in.a], [](float x) { return asinf(x); }); break;
+		case SOFT_OP_ACOS: r[in.dst] = perLane(r[in.a], [](float x) { return acosf(x); }); break;
+		case SOFT_OP_ATAN: r[in.dst] = perLane(r[in.a], [](float x) { return atanf(x); }); break;
+		case SOFT_OP_ATAN2: r[in.dst] = perLane(r[in.a], r[in.b], [](float y, float x) { return atan2f(y, x); }); break;
+		case SOFT_OP_LT: r[in.dst] = (r[in.a] < r[in.b]) & one; break;
+		case SOFT_OP_LE: r[in.dst] = (r[in.a] <= r[in.b]) & one; break;
+		case SOFT_OP_GT: r[in.dst] = (r[in.a] > r[in.b]) & one; break;
+		case SOFT_OP_GE: r[in.dst] = (r[in.a] >= r[in.b]) & one; break;
+		case SOFT_OP_EQ: r[in.dst] = (r[in.a] == r[in.b]) & one; break;
+		case SOFT_OP_NE: r[in.dst] = (r[in.a] != r[in.b]) & one; break;
+		case SOFT_OP_AND: r[in.dst] = (r[in.a] != zero) & (r[in.b] != zero) & one; break;
+		case SOFT_OP_OR: r[in.dst] = ((r[in.a] != zero) | (r[in.b] != zero)) & one; break;
+		case SOFT_OP_XOR: r[in.dst] = ((r[in.a] != zero) ^ (r[in.b] != zero)) & one; break;
+		case SOFT_OP_NOT: r[in.dst] = (r[in.a] == zero) & one; break;
+		case SOFT_OP_SELECT: r[in.dst] = select(r[in.a] != zero, r[in.b], r[in.c]); break;
+		case SOFT_OP_CLAMP: r[in.dst] = min(max(r[in.a], r[in.b]), r[in.c]); break;
+		case SOFT_OP_MIX: r[in.dst] = madd(r[in.b] - r[in.a], r[in.c], r[in.a]); break;
+		case SOFT_OP_STEP: r[in.dst] = andnot(r[in.b] < r[in.a], one); break;
+		case SOFT_OP_SMOOTHSTEP:
+		{
+			vec8f t = clamp((r[in.c] - r[in.a]) / (r[in.b] - r[in.a]), zero, one);
+			r[in.dst] = t * t * (vec8f(3.0f) - vec8f(2.0f) * t);
+			break;
+		}
+		case SOFT_OP_DFDX: r[in.dst] = quadDerivative(r[in.a], 1); break;
+		case SOFT_OP_DFDY: r[in.dst] = quadDerivative(r[in.a], 4); break;
+		case SOFT_OP_TEX:
+		case SOFT_OP_TEXLOD:
+		{
+			SoftSampler* sampler = stageSamplers[in.imm];
+			if (sampler)
+			{
+				sampler->sample(r[in.a], r[in.b], in.op == SOFT_OP_TEXLOD ? &r[in.c] : nullptr, &r[in.dst]);
+			}
+			else
+			{
+				// an unbound sampler reads as (0, 0, 0, 1) like an incomplete texture
+				r[in.dst] = r[in.dst + 1] = r[in.dst + 2] = zero;
+				r[in.dst + 3] = one;
+			}
+			break;
+		}
+		case SOFT_OP_PUSH: maskStack.push_back(exec); break;
+		case SOFT_OP_POP: exec = maskStack.back(); maskStack.pop_back(); break;
+		case SOFT_OP_EXEC_AND: exec = exec & (r[in.a] != zero); break;
+		case SOFT_OP_EXEC_ANDNOT: exec = andnot(r[in.a] != zero, exec); break;
+		case SOFT_OP_EXEC_OR: exec = exec | (r[in.a] != zero); break;
+		case SOFT_OP_ELSE: exec = andnot(r[in.a] != zero, maskStack.back()); break;
+		case SOFT_OP_KILL: r[in.dst] = select(exec, one, r[in.dst]); exec = zero; break;
+		case SOFT_OP_CLEAR: r[in.dst] = zero; break;
+		case SOFT_OP_JMP: pc = in.imm - 1; break;
+		case SOFT_OP_JNONE: if (!movemask(exec)) pc = in.imm - 1; break;
+		case SOFT_OP_JANY: if (movemask(exec)) pc = in.imm - 1; break;
+		}
+	}
+	executed += steps;
+}
+
+static void initRegisters(const SoftShader& shader, vector<vec8f>& registers)
+{
+	registers.assign(shader.registerCount, vec8f::zero());
+	for (size_t i = 0; i < shader.constants.size(); i++)
+		registers[shader.constantBase + i] = vec8f(shader.constants[i]);
+}
+
+bool SoftProgram::build(const string& vertexSource, const string& fragmentSource, string* log)
+{
+	string messages, stageLog;
+	bool ok = true;
+	if (!vertexShader.compile(SOFT_VERTEX_SHADER, vertexSource, &stageLog))
+	{
+		messages += "vertex shader:\n" + stageLog;
+		ok = false;
+	}
+	if (!fragmentShader.compile(SOFT_FRAGMENT_SHADER, fragmentSource, &stageLog))
+	{
+		messages += "fragment shader:\n" + stageLog;
+		ok = false;
+	}
+
+	// varyings: vertex outputs matched to fragment inputs by name, packed
+	// into slots in vertex output order
+	outputSlots.assign(vertexShader.outputs.size(), -1);
+	inputSlots.assign(fragmentShader.inputs.size(), -1);
+	varyings = 0;
+	for (size_t i = 0; ok && i < vertexShader.outputs.size(); i++)
+	{
+		const SoftShaderVariable& output = vertexShader.outputs[i];
+		for (size_t j = 0; j < fragmentShader.inputs.size(); j++)
+		{
+			const SoftShaderVariable& input = fragmentShader.inputs[j];
+			if (input.name != output.name)
+				continue;
+			if (input.components != output.components)
+			{
+				messages += "link: " + input.name + " has different types in the two stages\n";
+				ok = false;
+				break;
+			}
+			outputSlots[i] = varyings;
+			inputSlots[j] = varyings;
+			varyings += output.components;
+		}
+	}
+	for (size_t j = 0; ok && j < fragmentShader.inputs.size(); j++)
+	{
+		if (inputSlots[j] < 0)
+		{
+			messages += "link: fragment input " + fragmentShader.inputs[j].name + " isn't written by the vertex shader\n";
+			ok = false;
+		}
+	}
+	if (ok && varyings > SOFT_MAX_VARYINGS)
+	{
+		messages += "link: " + to_string(varyings) + " varying components, at most " + to_string(SOFT_MAX_VARYINGS) + "\n";
+		ok = false;
+	}
+
+	// the color output: location 0, or the only one
+	colorReg = -1;
+	colorComponents = 0;
+	for (const SoftShaderVariable& output : fragmentShader.outputs)
+	{
+		if (output.location == 0 || colorReg < 0)
+		{
+			colorReg = output.reg;
+			colorComponents = output.components;
+		}
+	}
+
+	// uniforms and samplers share one location space across both stages
+	uniformTable.clear();
+	auto addUniform = [&](const SoftShaderVariable& variable, bool vertex, bool sampler) {
+		auto found = find_if(uniformTable.begin(), uniformTable.end(), [&](const Uniform& u) { return u.name == variable.name; });
+		if (found == uniformTable.end())
+		{
+			uniformTable.push_back({ variable.name, variable.components, -1, -1, -1, -1 });
+			found = uniformTable.end() - 1;
+		}
+		else if (found->components != variable.components)
+		{
+			messages += "link: uniform " + variable.name + " has different types in the two stages\n";
+			ok = false;
+		}
+		int& slot = sampler ? (vertex ? found->vertexSampler : found->fragmentSampler) : (vertex ? found->vertexReg : found->fragmentReg);
+		slot = variable.reg;
+	};
+	for (const SoftShaderVariable& u : vertexShader.uniforms)
+		addUniform(u, true, false);
+	for (const SoftShaderVariable& u : fragmentShader.uniforms)
+		addUniform(u, false, false);
+	for (const SoftShaderVariable& u : vertexShader.samplers)
+		addUniform(u, true, true);
+	for (const SoftShaderVariable& u : fragmentShader.samplers)
+		addUniform(u, false, true);
+
+	initRegisters(vertexShader, vertexRegisters);
+	initRegisters(fragmentShader, fragmentRegisters);
+	vertexSamplers.assign(vertexShader.samplers.size() + 1, nullptr);
+	fragmentSamplers.assign(fragmentShader.samplers.size() + 1, nullptr);
+	executed = 0;
+
+	if (log)
+		*log = messages;
+	return ok;
+}
+
+bool SoftProgram::build(const ShaderProgramDesc& desc, unsigned int mask, string* log)
+{
+	ShaderPreprocessor preprocessor;
+	for (const string& dir : desc.includeDirs)
+		preprocessor.addIncludeDir(dir);
+	vector<ShaderDefine> defines = variantDefines(desc, mask);
+	string vertexSource, fragmentSource;
+	if (!preprocessor.process(desc.vertexPath, defines, vertexSource, log) ||
+		!preprocessor.process(desc.fragmentPath, defines, fragmentSource, log))
+		return false;
+	return build(vertexSource, fragmentSource, log);
+}
+
+int SoftProgram::uniformLocation(const string& name) const
+{
+	for (size_t i = 0; i < uniformTable.size(); i++)
+	{
+		if (uniformTable[i].name == name)
+			return (int)i;
+	}
+	return -1;
+}
+
+void SoftProgram::setUniform(int location, const float* values, int components)
+{
+	if (location < 0 || location >= (int)uniformTable.size())
+		return;
+	const Uniform& u = uniformTable[location];
+	int n = min(components, u.components);
+	for (int c = 0; c < n; c++)
+	{
+		if (u.vertexReg >= 0)
+			vertexRegisters[u.vertexReg + c] = vec8f(values[c]);
+		if (u.fragmentReg >= 0)
+			fragmentRegisters[u.fragmentReg + c] = vec8f(values[c]);
+	}
+}
+
+void SoftProgram::setSampler(int location, SoftSampler* sampler)
+{
+	if (location < 0 || location >= (int)uniformTable.size())
+		return;
+	const Uniform& u = uniformTable[location];
+	if (u.vertexSampler >= 0)
+		vertexSamplers[u.vertexSampler] = sampler;
+	if (u.fragmentSampler >= 0)
+		fragmentSamplers[u.fragmentSampler] = sampler;
+}
+
+void SoftProgram::runVertexShader(const SoftVertexArray& input, int vertexCount, int instance, SoftVertexBuffer& out)
+{
+	out.resize(vertexCount, varyings);
+	vec8f* r = vertexRegisters.data();
+	for (int first = 0; first < vertexCount; first += 8)
+	{
+		int n = min(8, vertexCount - first);
+
+		// missing attribute components read as (0, 0, 0, 1), as in GL
+		for (const SoftShaderVariable& in : vertexShader.inputs)
+		{
+			const SoftAttribute* attribute = in.location >= 0 && in.location < SOFT_MAX_ATTRIBUTES ? &input.attributes[in.location] : nullptr;
+			for (int c = 0; c < in.components; c++)
+			{
+				alignas(32) float v[8];
+				float fallback = c == 3 ? 1.0f : 0.0f;
+				for (int i = 0; i < 8; i++)
+				{
+					bool present = i < n && attribute && attribute->data && c < attribute->size;
+					v[i] = present ? attribute->data[(size_t)(first + i) * attribute->stride + c] : fallback;
+				}
+				r[in.reg + c] = vec8f::load(v);
+			}
+		}
+		if (vertexShader.vertexIdReg >= 0)
+			r[vertexShader.vertexIdReg] = toFloat(vec8i(first) + laneIndex());
+		if (vertexShader.instanceIdReg >= 0)
+			r[vertexShader.instanceIdReg] = vec8f((float)instance);
+
+		execute(vertexShader, r, vertexSamplers.data(), (1 << n) - 1);
+
+		// the columns are padded to 8, so whole vectors can be stored
+		for (int c = 0; c < 4; c++)
+			r[vertexShader.positionReg + c].storeu(out.column(c) + first);
+		for (size_t i = 0; i < vertexShader.outputs.size(); i++)
+		{
+			if (outputSlots[i] < 0)
+				continue;
+			const SoftShaderVariable& output = vertexShader.outputs[i];
+			for (int c = 0; c < output.components; c++)
+				r[output.reg + c].storeu(out.varying(outputSlots[i] + c) + first);
+		}
+	}
+}
+
+int SoftProgram::shade(const SoftFragmentBlock& block, vec8f rgba[4])
+{
+	vec8f* r = fragmentRegisters.data();
+	for (size_t i = 0; i < fragmentShader.inputs.size(); i++)
+	{
+		const SoftShaderVariable& in = fragmentShader.inputs[i];
+		for (int c = 0; c < in.components; c++)
+			r[in.reg + c] = block.varyings[inputSlots[i] + c];
+	}
+	if (fragmentShader.fragCoordReg >= 0)
+	{
+		vec8f* coord = r + fragmentShader.fragCoordReg;
+		coord[0] = toFloat(vec8i(block.x) + (laneIndex() & vec8i(3))) + vec8f(0.5f);
+		coord[1] = toFloat(vec8i(block.y) + shiftRight<2>(laneIndex())) + vec8f(0.5f);
+		coord[2] = block.z;
+		coord[3] = block.invW;
+	}
+	if (fragmentShader.discardReg >= 0)
+		r[fragmentShader.discardReg] = vec8f::zero();
+
+	execute(fragmentShader, r, fragmentSamplers.data(), block.mask);
+
+	for (int c = 0; c < 4; c++)
+		rgba[c] = c < colorComponents ? r[colorReg + c] : vec8f(c == 3 ? 1.0f : 0.0f);
+	int keep = block.mask;
+	if (fragmentShader.discardReg >= 0)
+		keep &= ~movemask(r[fragmentShader.discardReg] != vec8f::zero());
+	return keep;
+}
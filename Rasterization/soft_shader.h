@@ -0,0 +1,191 @@
+#ifndef SOFT_SHADER_H
+#define SOFT_SHADER_H
+
+#include <cstdint>
+#include <string>
+#include <vector>
+
+#include "shader_variants.h"
+#include "simd.h"
+#include "soft_raster.h"
+
+// GLSL on the CPU. A practical subset of GLSL 3.30 is compiled to a
+// bytecode whose registers are vec8f, so every instruction works on one
+// scalar component of 8 vertices or 8 fragments (one 4x2 SoftFragmentBlock)
+// at once. Supported:
+//  - float/int/bool scalars, vec2-4, ivec2-4, bvec2-4, mat2-4, sampler2D
+//  - in/out/uniform/const globals, layout(location = N), std140 uniform
+//    blocks without an instance name (members become plain uniforms)
+//  - arithmetic, swizzles, constructors, the common built-in functions,
+//    texture(), textureLod(), dFdx/dFdy, user functions (inlined, with
+//    in/out/inout parameters)
+//  - if/else, for, while, do-while, break, continue, return and discard,
+//    all per lane through execution masks
+//  - #define, #undef, #if/#ifdef/#ifndef/#elif/#else/#endif, #line
+// Not supported: structs, arrays, dynamic indexing, function-like macros.
+// int is carried in float lanes, so it is exact up to 2^24. Constant
+// expressions are folded and for loops with constant bounds unrolled.
+
+enum SoftShaderStage
+{
+	SOFT_VERTEX_SHADER,
+	SOFT_FRAGMENT_SHADER,
+};
+
+enum SoftOp : uint16_t
+{
+	SOFT_OP_MOV, SOFT_OP_MOVM,
+	SOFT_OP_ADD, SOFT_OP_SUB, SOFT_OP_MUL, SOFT_OP_DIV, SOFT_OP_NEG, SOFT_OP_MADD,
+	SOFT_OP_MIN, SOFT_OP_MAX, SOFT_OP_ABS, SOFT_OP_SIGN,
+	SOFT_OP_FLOOR, SOFT_OP_CEIL, SOFT_OP_FRACT, SOFT_OP_TRUNC, SOFT_OP_ROUND,
+	SOFT_OP_MOD, SOFT_OP_IDIV, SOFT_OP_IMOD,
+	SOFT_OP_SQRT, SOFT_OP_RSQRT, SOFT_OP_POW, SOFT_OP_EXP, SOFT_OP_EXP2, SOFT_OP_LOG, SOFT_OP_LOG2,
+	SOFT_OP_SIN, SOFT_OP_COS, SOFT_OP_TAN, SOFT_OP_ASIN, SOFT_OP_ACOS, SOFT_OP_ATAN, SOFT_OP_ATAN2,
+	SOFT_OP_LT, SOFT_OP_LE, SOFT_OP_GT, SOFT_OP_GE, SOFT_OP_EQ, SOFT_OP_NE,
+	SOFT_OP_AND, SOFT_OP_OR, SOFT_OP_XOR, SOFT_OP_NOT,
+	SOFT_OP_SELECT, SOFT_OP_CLAMP, SOFT_OP_MIX, SOFT_OP_STEP, SOFT_OP_SMOOTHSTEP,
+	SOFT_OP_DFDX, SOFT_OP_DFDY,
+	SOFT_OP_TEX,		// dst..dst+3 = texture(sampler imm, vec2(a, b))
+	SOFT_OP_TEXLOD,		// dst..dst+3 = textureLod(sampler imm, vec2(a, b), c)
+	// execution mask
+	SOFT_OP_PUSH, SOFT_OP_POP,
+	SOFT_OP_EXEC_AND, SOFT_OP_EXEC_ANDNOT, SOFT_OP_EXEC_OR,
+	SOFT_OP_ELSE,		// exec = pushed mask & !a
+	SOFT_OP_KILL,		// dst |= exec, exec = 0
+	SOFT_OP_CLEAR,		// dst = 0
+	SOFT_OP_JMP, SOFT_OP_JNONE, SOFT_OP_JANY,
+	SOFT_OP_COUNT
+};
+
+struct SoftInstruction
+{
+	uint16_t op;
+	uint16_t dst;
+	uint16_t a, b, c;
+	int32_t imm;		// jump target or sampler index
+};
+
+// an input, output, uniform or sampler of one stage. Its components live in
+// registers reg .. reg + components - 1.
+struct SoftShaderVariable
+{
+	std::string name;
+	int components = 0;
+	int location = -1;		// layout(location = N)
+	int reg = -1;			// samplers: the sampler index instead
+};
+
+// texture() for the CPU shaders
+class SoftSampler
+{
+public:
+	virtual ~SoftSampler() = default;
+
+	// lod is null for texture() in a fragment shader: the lanes are two 2x2
+	// quads, so the sampler can take the derivatives of s and t itself
+	virtual void sample(const vec8f& s, const vec8f& t, const vec8f* lod, vec8f rgba[4]) = 0;
+};
+
+// one compiled stage
+class SoftShader
+{
+public:
+	bool compile(SoftShaderStage stage, const std::string& source, std::string* log = nullptr);
+
+	SoftShaderStage stage = SOFT_VERTEX_SHADER;
+	std::vector<SoftInstruction> code;
+	int registerCount = 0;
+	// constants occupy the registers from constantBase on
+	int constantBase = 0;
+	std::vector<float> constants;
+
+	std::vector<SoftShaderVariable> inputs;
+	std::vector<SoftShaderVariable> outputs;
+	std::vector<SoftShaderVariable> uniforms;
+	std::vector<SoftShaderVariable> samplers;
+
+	// built-in variables, -1 when the shader doesn't use them
+	int positionReg = -1;		// gl_Position
+	int vertexIdReg = -1;		// gl_VertexID
+	int instanceIdReg = -1;		// gl_InstanceID
+	int fragCoordReg = -1;		// gl_FragCoord
+	int discardReg = -1;		// lanes that executed discard
+};
+
+// like glVertexAttribPointer with GL_FLOAT: size floats per vertex, stride
+// floats apart
+struct SoftAttribute
+{
+	const float* data = nullptr;
+	int size = 0;
+	int stride = 0;
+};
+
+const int SOFT_MAX_ATTRIBUTES = 8;
+
+struct SoftVertexArray
+{
+	SoftAttribute attributes[SOFT_MAX_ATTRIBUTES];
+};
+
+// A linked vertex + fragment shader. runVertexShader() fills a
+// SoftVertexBuffer for SoftRasterizer, and the program is itself the
+// SoftFragmentShader to rasterize it with. Uniforms and samplers are set by
+// location like their GL counterparts. Keeps its registers between
+// invocations, so one program is used by one thread at a time.
+class SoftProgram : public SoftFragmentShader
+{
+public:
+	bool build(const std::string& vertexSource, const std::string& fragmentSource, std::string* log = nullptr);
+
+	// preprocesses the files of a ShaderVariantCache permutation the same way
+	bool build(const ShaderProgramDesc& desc, unsigned int mask, std::string* log = nullptr);
+
+	int uniformLocation(const std::string& name) const;
+	// components floats, a mat4 is 16 in column-major order
+	void setUniform(int location, const float* values, int components);
+	void setSampler(int location, SoftSampler* sampler);
+
+	int varyingCount() const { return varyings; }
+
+	void runVertexShader(const SoftVertexArray& input, int vertexCount, int instance, SoftVertexBuffer& out);
+
+	int shade(const SoftFragmentBlock& block, vec8f rgba[4]) override;
+
+	// instructions executed, a rough cost measure
+	uint64_t instructionCount() const { return executed; }
+
+private:
+	struct Uniform
+	{
+		std::string name;
+		int components;
+		int vertexReg;
+		int fragmentReg;
+		int vertexSampler;
+		int fragmentSampler;
+	};
+
+	void execute(const SoftShader& shader, vec8f* registers, SoftSampler* const* stageSamplers, int lanes);
+
+	SoftShader vertexShader;
+	SoftShader fragmentShader;
+	std::vector<vec8f> vertexRegisters;
+	std::vector<vec8f> fragmentRegisters;
+	std::vector<SoftSampler*> vertexSamplers;
+	std::vector<SoftSampler*> fragmentSamplers;
+	std::vector<Uniform> uniformTable;
+
+	// per vertex output: the first varying slot, or -1 for outputs the
+	// fragment shader doesn't read; per fragment input: its varying slot
+	std::vector<int> outputSlots;
+	std::vector<int> inputSlots;
+	int varyings = 0;
+	int colorReg = -1;
+	int colorComponents = 0;
+
+	std::vector<vec8f> maskStack;
+	uint64_t executed = 0;
+};
+
+#endif
@@ -0,0 +1,3059 @@
+#include "soft_shader.h"
+
+#include <algorithm>
+#include <cctype>
+#include <cmath>
+#include <cstdlib>
+#include <cstring>
+#include <map>
+#include <memory>
+
+using namespace std;
+
+// GLSL subset -> SoftShader bytecode. Three passes: a preprocessor that
+// evaluates conditionals and expands object-like macros into tokens, a
+// recursive descent parser that builds a small AST, and a code generator
+// that inlines every function call and scalarizes vector and matrix math
+// into one instruction per component. Errors are collected in a log as
+// "file:line: message" like the GL compilers print them.
+
+namespace
+{
+
+// ---------------------------------------------------------------- tokens
+
+enum TokenKind
+{
+	TOKEN_IDENTIFIER,
+	TOKEN_NUMBER,
+	TOKEN_PUNCT,
+	TOKEN_END,
+};
+
+struct Token
+{
+	TokenKind kind = TOKEN_END;
+	string text;
+	int line = 0;
+	int file = 0;
+};
+
+bool isIdentifierStart(char c) { return isalpha((unsigned char)c) || c == '_'; }
+bool isIdentifierChar(char c) { return isalnum((unsigned char)c) || c == '_'; }
+
+// block comments become spaces, newlines survive so line numbers do too
+string stripComments(const string& source)
+{
+	string out;
+	out.reserve(source.size());
+	for (size_t i = 0; i < source.size(); i++)
+	{
+		if (source.compare(i, 2, "//") == 0)
+		{
+			while (i < source.size() && source[i] != '\n')
+				i++;
+			if (i < source.size())
+				out += '\n';
+		}
+		else if (source.compare(i, 2, "/*") == 0)
+		{
+			i += 2;
+			while (i < source.size() && source.compare(i, 2, "*/") != 0)
+			{
+				if (source[i] == '\n')
+					out += '\n';
+				i++;
+			}
+			i++;
+			out += ' ';
+		}
+		else
+		{
+			out += source[i];
+		}
+	}
+	return out;
+}
+
+void tokenizeLine(const string& line, int lineNumber, int file, vector<Token>& out)
+{
+	static const char* pairs[] = { "++", "--", "+=", "-=", "*=", "/=", "%=", "==", "!=", "<=", ">=", "&&", "||", "^^", "<<", ">>" };
+	size_t i = 0;
+	while (i < line.size())
+	{
+		char c = line[i];
+		if (isspace((unsigned char)c))
+		{
+			i++;
+			continue;
+		}
+		Token token;
+		token.line = lineNumber;
+		token.file = file;
+		size_t start = i;
+		if (isIdentifierStart(c))
+		{
+			while (i < line.size() && isIdentifierChar(line[i]))
+				i++;
+			token.kind = TOKEN_IDENTIFIER;
+		}
+		else if (isdigit((unsigned char)c) || (c == '.' && i + 1 < line.size() && isdigit((unsigned char)line[i + 1])))
+		{
+			if (c == '0' && i + 1 < line.size() && (line[i + 1] == 'x' || line[i + 1] == 'X'))
+			{
+				i += 2;
+				while (i < line.size() && isxdigit((unsigned char)line[i]))
+					i++;
+			}
+			else
+			{
+				while (i < line.size() && (isdigit((unsigned char)line[i]) || line[i] == '.'))
+					i++;
+				if (i < line.size() && (line[i] == 'e' || line[i] == 'E'))
+				{
+					i++;
+					if (i < line.size() && (line[i] == '+' || line[i] == '-'))
+						i++;
+					while (i < line.size() && isdigit((unsigned char)line[i]))
+						i++;
+				}
+			}
+			if (i < line.size() && strchr("fFuU", line[i]))
+				i++;
+			token.kind = TOKEN_NUMBER;
+		}
+		else
+		{
+			i++;
+			for (const char* pair : pairs)
+			{
+				if (line.compare(start, 2, pair) == 0)
+				{
+					i = start + 2;
+					break;
+				}
+			}
+			token.kind = TOKEN_PUNCT;
+		}
+		token.text = line.substr(start, i - start);
+		out.push_back(token);
+	}
+}
+
+bool isFloatLiteral(const string& text)
+{
+	if (text.size() > 1 && (text[1] == 'x' || text[1] == 'X'))
+		return false;
+	return text.find_first_of(".eEfF") != string::npos;
+}
+
+double literalValue(const string& text)
+{
+	if (text.size() > 1 && (text[1] == 'x' || text[1] == 'X'))
+		return (double)strtoll(text.c_str(), nullptr, 16);
+	return strtod(text.c_str(), nullptr);
+}
+
+// ---------------------------------------------------------------- preprocessor
+
+class Preprocessor
+{
+public:
+	explicit Preprocessor(string& log) : log(log) {}
+
+	bool run(const string& source, vector<Token>& out);
+
+private:
+	struct Conditional
+	{
+		bool active;		// this branch is being compiled
+		bool taken;			// some branch of the chain was
+		bool outerActive;
+	};
+
+	bool directive(const string& text, const vector<Token>& tokens, int line, int file);
+	void expand(const vector<Token>& in, vector<Token>& out, vector<string>& expanding) const;
+	bool evaluate(const vector<Token>& tokens, long long& value, int line, int file);
+	bool error(int line, int file, const string& message);
+
+	// #if expression, a recursive descent over evalTokens
+	long long evalBinary(int level);
+	long long evalUnary();
+
+	bool active() const { return conditionals.empty() || conditionals.back().active; }
+
+	string& log;
+	map<string, vector<Token>> macros;
+	vector<Conditional> conditionals;
+	vector<Token> evalTokens;
+	size_t evalPos = 0;
+	bool evalFailed = false;
+	int nextLine = 1;
+	int currentFile = 0;
+};
+
+bool Preprocessor::error(int line, int file, const string& message)
+{
+	log += to_string(file) + ":" + to_string(line) + ": error: " + message + "\n";
+	return false;
+}
+
+bool Preprocessor::run(const string& source, vector<Token>& out)
+{
+	Token version;
+	version.kind = TOKEN_NUMBER;
+	version.text = "330";
+	macros["__VERSION__"] = { version };
+	macros["GL_core_profile"] = { Token{ TOKEN_NUMBER, "1", 0, 0 } };
+
+	string text = stripComments(source);
+	size_t start = 0;
+	bool ok = true;
+	while (start <= text.size())
+	{
+		size_t end = text.find('\n', start);
+		if (end == string::npos)
+			end = text.size();
+		string line = text.substr(start, end - start);
+		int lineNumber = nextLine++;
+
+		vector<Token> tokens;
+		tokenizeLine(line, lineNumber, currentFile, tokens);
+		if (!tokens.empty() && tokens[0].text == "#")
+		{
+			if (!directive(line, tokens, lineNumber, currentFile))
+				ok = false;
+		}
+		else if (active() && !tokens.empty())
+		{
+			vector<string> expanding;
+			expand(tokens, out, expanding);
+		}
+		start = end + 1;
+	}
+	if (!conditionals.empty())
+		ok = error(nextLine - 1, currentFile, "unterminated #if");
+
+	Token end;
+	end.kind = TOKEN_END;
+	end.line = nextLine - 1;
+	end.file = currentFile;
+	out.push_back(end);
+	return ok;
+}
+
+void Preprocessor::expand(const vector<Token>& in, vector<Token>& out, vector<string>& expanding) const
+{
+	for (const Token& token : in)
+	{
+		if (token.kind == TOKEN_IDENTIFIER)
+		{
+			auto macro = macros.find(token.text);
+			if (macro != macros.end() && find(expanding.begin(), expanding.end(), token.text) == expanding.end())
+			{
+				vector<Token> body = macro->second;
+				for (Token& t : body)
+				{
+					t.line = token.line;
+					t.file = token.file;
+				}
+				expanding.push_back(token.text);
+				expand(body, out, expanding);
+				expanding.pop_back();
+				continue;
+			}
+		}
+		out.push_back(token);
+	}
+}
+
+bool Preprocessor::directive(const string& text, const vector<Token>& tokens, int line, int file)
+{
+	if (tokens.size() < 2)
+		return true;
+	const string& name = tokens[1].text;
+	vector<Token> rest(tokens.begin() + 2, tokens.end());
+
+	if (name == "ifdef" || name == "ifndef")
+	{
+		bool defined = !rest.empty() && macros.count(rest[0].text);
+		bool condition = name == "ifdef" ? defined : !defined;
+		conditionals.push_back({ active() && condition, condition, active() });
+		return true;
+	}
+	if (name == "if")
+	{
+		long long value = 0;
+		bool ok = !active() || evaluate(rest, value, line, file);
+		conditionals.push_back({ active() && value != 0, value != 0, active() });
+		return ok;
+	}
+	if (name == "elif" || name == "else" || name == "endif")
+	{
+		if (conditionals.empty())
+			return error(line, file, "#" + name + " without #if");
+		Conditional& top = conditionals.back();
+		if (name == "endif")
+		{
+			conditionals.pop_back();
+			return true;
+		}
+		if (top.taken)
+		{
+			top.active = false;
+			return true;
+		}
+		long long value = 1;
+		bool ok = true;
+		if (name == "elif" && top.outerActive)
+			ok = evaluate(rest, value, line, file);
+		top.active = top.outerActive && value != 0;
+		top.taken = value != 0;
+		return ok;
+	}
+	if (!active())
+		return true;
+
+	if (name == "define")
+	{
+		if (rest.empty() || rest[0].kind != TOKEN_IDENTIFIER)
+			return error(line, file, "#define needs a name");
+		// "NAME(" without a space is a function-like macro
+		size_t nameEnd = text.find(rest[0].text, text.find("define") + 6) + rest[0].text.size();
+		if (nameEnd < text.size() && text[nameEnd] == '(')
+			return error(line, file, "function-like macros are not supported: " + rest[0].text);
+		macros[rest[0].text] = vector<Token>(rest.begin() + 1, rest.end());
+		return true;
+	}
+	if (name == "undef")
+	{
+		if (!rest.empty())
+			macros.erase(rest[0].text);
+		return true;
+	}
+	if (name == "line")
+	{
+		if (!rest.empty())
+			nextLine = atoi(rest[0].text.c_str());
+		if (rest.size() > 1)
+			currentFile = atoi(rest[1].text.c_str());
+		return true;
+	}
+	if (name == "version" || name == "extension" || name == "pragma")
+		return true;
+	if (name == "error")
+		return error(line, file, "#error");
+	return error(line, file, "unknown directive #" + name);
+}
+
+bool Preprocessor::evaluate(const vector<Token>& tokens, long long& value, int line, int file)
+{
+	// defined X / defined(X) before macro expansion
+	vector<Token> resolved;
+	for (size_t i = 0; i < tokens.size(); i++)
+	{
+		if (tokens[i].text == "defined")
+		{
+			bool parenthesized = i + 1 < tokens.size() && tokens[i + 1].text == "(";
+			size_t nameIndex = i + (parenthesized ? 2 : 1);
+			if (nameIndex >= tokens.size())
+				return error(line, file, "defined without a name");
+			Token result;
+			result.kind = TOKEN_NUMBER;
+			result.text = macros.count(tokens[nameIndex].text) ? "1" : "0";
+			resolved.push_back(result);
+			i = nameIndex + (parenthesized ? 1 : 0);
+			continue;
+		}
+		resolved.push_back(tokens[i]);
+	}
+	evalTokens.clear();
+	vector<string> expanding;
+	expand(resolved, evalTokens, expanding);
+	evalPos = 0;
+	evalFailed = false;
+	value = evalBinary(0);
+	if (evalFailed || evalPos != evalTokens.size())
+		return error(line, file, "bad #if expression");
+	return true;
+}
+
+long long Preprocessor::evalUnary()
+{
+	if (evalPos >= evalTokens.size())
+	{
+		evalFailed = true;
+		return 0;
+	}
+	const Token& token = evalTokens[evalPos++];
+	if (token.text == "!")
+		return !evalUnary();
+	if (token.text == "-")
+		return -evalUnary();
+	if (token.text == "+")
+		return evalUnary();
+	if (token.text == "~")
+		return ~evalUnary();
+	if (token.text == "(")
+	{
+		long long value = evalBinary(0);
+		if (evalPos < evalTokens.size() && evalTokens[evalPos].text == ")")
+			evalPos++;
+		else
+			evalFailed = true;
+		return value;
+	}
+	if (token.kind == TOKEN_NUMBER)
+		return (long long)literalValue(token.text);
+	if (token.kind == TOKEN_IDENTIFIER)
+		return 0;		// undefined names are 0, as in C
+	evalFailed = true;
+	return 0;
+}
+
+long long Preprocessor::evalBinary(int level)
+{
+	static const vector<vector<string>> levels = {
+		{ "||" }, { "&&" }, { "|" }, { "^" }, { "&" }, { "==", "!=" },
+		{ "<", ">", "<=", ">=" }, { "<<", ">>" }, { "+", "-" }, { "*", "/", "%" },
+	};
+	if (level == (int)levels.size())
+		return evalUnary();
+	long long left = evalBinary(level + 1);
+	while (evalPos < evalTokens.size())
+	{
+		const string& op = evalTokens[evalPos].text;
+		if (find(levels[level].begin(), levels[level].end(), op) == levels[level].end())
+			break;
+		evalPos++;
+		long long right = evalBinary(level + 1);
+		if (op == "||") left = left || right;
+		else if (op == "&&") left = left && right;
+		else if (op == "|") left |= right;
+		else if (op == "^") left ^= right;
+		else if (op == "&") left &= right;
+		else if (op == "==") left = left == right;
+		else if (op == "!=") left = left != right;
+		else if (op == "<") left = left < right;
+		else if (op == ">") left = left > right;
+		else if (op == "<=") left = left <= right;
+		else if (op == ">=") left = left >= right;
+		else if (op == "<<") left <<= right;
+		else if (op == ">>") left >>= right;
+		else if (op == "+") left += right;
+		else if (op == "-") left -= right;
+		else if (op == "*") left *= right;
+		else if (right == 0) evalFailed = true;
+		else if (op == "/") left /= right;
+		else left %= right;
+	}
+	return left;
+}
+
+// ---------------------------------------------------------------- types and AST
+
+enum BaseType
+{
+	TYPE_VOID,
+	TYPE_FLOAT,
+	TYPE_INT,
+	TYPE_BOOL,
+	TYPE_SAMPLER,
+};
+
+struct Type
+{
+	BaseType base = TYPE_VOID;
+	int rows = 1;		// vector size, or matrix rows
+	int columns = 1;	// matrix columns
+
+	int size() const { return base == TYPE_VOID || base == TYPE_SAMPLER ? 0 : rows * columns; }
+	bool isScalar() const { return size() == 1; }
+	bool isVector() const { return columns == 1 && rows > 1; }
+	bool isMatrix() const { return columns > 1; }
+	bool isNumeric() const { return base == TYPE_FLOAT || base == TYPE_INT; }
+	bool operator==(const Type& other) const { return base == other.base && rows == other.rows && columns == other.columns; }
+	bool operator!=(const Type& other) const { return !(*this == other); }
+};
+
+Type makeType(BaseType base, int rows = 1, int columns = 1)
+{
+	Type type;
+	type.base = base;
+	type.rows = rows;
+	type.columns = columns;
+	return type;
+}
+
+bool lookupType(const string& name, Type& type)
+{
+	static const struct { const char* name; BaseType base; int rows, columns; } types[] = {
+		{ "void", TYPE_VOID, 1, 1 }, { "float", TYPE_FLOAT, 1, 1 }, { "int", TYPE_INT, 1, 1 },
+		{ "uint", TYPE_INT, 1, 1 }, { "bool", TYPE_BOOL, 1, 1 },
+		{ "vec2", TYPE_FLOAT, 2, 1 }, { "vec3", TYPE_FLOAT, 3, 1 }, { "vec4", TYPE_FLOAT, 4, 1 },
+		{ "ivec2", TYPE_INT, 2, 1 }, { "ivec3", TYPE_INT, 3, 1 }, { "ivec4", TYPE_INT, 4, 1 },
+		{ "uvec2", TYPE_INT, 2, 1 }, { "uvec3", TYPE_INT, 3, 1 }, { "uvec4", TYPE_INT, 4, 1 },
+		{ "bvec2", TYPE_BOOL, 2, 1 }, { "bvec3", TYPE_BOOL, 3, 1 }, { "bvec4", TYPE_BOOL, 4, 1 },
+		{ "mat2", TYPE_FLOAT, 2, 2 }, { "mat3", TYPE_FLOAT, 3, 3 }, { "mat4", TYPE_FLOAT, 4, 4 },
+		{ "mat2x2", TYPE_FLOAT, 2, 2 }, { "mat3x3", TYPE_FLOAT, 3, 3 }, { "mat4x4", TYPE_FLOAT, 4, 4 },
+		{ "mat2x3", TYPE_FLOAT, 3, 2 }, { "mat2x4", TYPE_FLOAT, 4, 2 }, { "mat3x2", TYPE_FLOAT, 2, 3 },
+		{ "mat3x4", TYPE_FLOAT, 4, 3 }, { "mat4x2", TYPE_FLOAT, 2, 4 }, { "mat4x3", TYPE_FLOAT, 3, 4 },
+		{ "sampler2D", TYPE_SAMPLER, 1, 1 },
+	};
+	for (const auto& entry : types)
+	{
+		if (name == entry.name)
+		{
+			type = makeType(entry.base, entry.rows, entry.columns);
+			return true;
+		}
+	}
+	return false;
+}
+
+string typeName(const Type& type)
+{
+	static const char* scalars[] = { "void", "float", "int", "bool", "sampler2D" };
+	static const char* prefixes[] = { "", "vec", "ivec", "bvec", "" };
+	if (type.isMatrix())
+		return "mat" + to_string(type.columns) + (type.rows == type.columns ? "" : "x" + to_string(type.rows));
+	if (type.isVector())
+		return prefixes[type.base] + to_string(type.rows);
+	return scalars[type.base];
+}
+
+struct Expr
+{
+	enum Kind { LITERAL, NAME, UNARY, BINARY, ASSIGN, PREFIX, POSTFIX, CALL, FIELD, INDEX, TERNARY };
+
+	Kind kind = LITERAL;
+	string text;		// operator, name or field
+	double value = 0.0;
+	BaseType literalType = TYPE_FLOAT;
+	vector<unique_ptr<Expr>> args;
+	int line = 0;
+	int file = 0;
+};
+
+struct Stmt
+{
+	enum Kind { BLOCK, DECLARATION, EXPRESSION, IF, FOR, WHILE, DO, BREAK, CONTINUE, RETURN, DISCARD, EMPTY };
+
+	Kind kind = EMPTY;
+	vector<unique_ptr<Stmt>> children;	// block statements; if: then, else; loops: body
+	unique_ptr<Stmt> init;
+	unique_ptr<Expr> condition;
+	unique_ptr<Expr> step;			// for step, return value or expression
+	Type type;
+	bool constant = false;
+	vector<string> names;
+	vector<unique_ptr<Expr>> initializers;
+	int line = 0;
+	int file = 0;
+};
+
+struct Parameter
+{
+	Type type;
+	string name;
+	bool in = true;
+	bool out = false;
+};
+
+struct Function
+{
+	Type returnType;
+	string name;
+	vector<Parameter> params;
+	unique_ptr<Stmt> body;
+	bool divergentReturn = false;	// returns from inside control flow
+	int line = 0;
+	int file = 0;
+};
+
+enum Storage
+{
+	STORAGE_GLOBAL,
+	STORAGE_CONST,
+	STORAGE_IN,
+	STORAGE_OUT,
+	STORAGE_UNIFORM,
+};
+
+struct Global
+{
+	Storage storage = STORAGE_GLOBAL;
+	Type type;
+	string name;
+	int location = -1;
+	unique_ptr<Expr> initializer;
+	int line = 0;
+	int file = 0;
+};
+
+struct Module
+{
+	vector<Global> globals;
+	vector<unique_ptr<Function>> functions;
+};
+
+// ---------------------------------------------------------------- parser
+
+class Parser
+{
+public:
+	Parser(const vector<Token>& tokens, string& log) : tokens(tokens), log(log) {}
+
+	bool parse(Module& module);
+
+private:
+	const Token& peek(int ahead = 0) const { return tokens[min(pos + ahead, tokens.size() - 1)]; }
+	const Token& next() { const Token& t = peek(); if (pos < tokens.size() - 1) pos++; return t; }
+	bool check(const char* text) const { return peek().kind != TOKEN_END && peek().text == text; }
+	bool accept(const char* text) { if (!check(text)) return false; next(); return true; }
+	bool expect(const char* text);
+	bool error(const string& message);
+	bool isTypeName(const Token& token) const { Type type; return token.kind == TOKEN_IDENTIFIER && lookupType(token.text, type); }
+
+	bool externalDeclaration(Module& module);
+	bool layoutQualifier(int& location);
+	bool parseType(Type& type);
+	unique_ptr<Function> functionDefinition(const Type& returnType, const string& name);
+
+	unique_ptr<Stmt> statement();
+	unique_ptr<Stmt> block();
+	unique_ptr<Stmt> declaration(bool constant);
+	unique_ptr<Stmt> makeStmt(Stmt::Kind kind);
+
+	unique_ptr<Expr> expression();
+	unique_ptr<Expr> assignment();
+	unique_ptr<Expr> ternary();
+	unique_ptr<Expr> binary(int level);
+	unique_ptr<Expr> unary();
+	unique_ptr<Expr> postfix();
+	unique_ptr<Expr> primary();
+	unique_ptr<Expr> makeExpr(Expr::Kind kind, const string& text);
+
+	const vector<Token>& tokens;
+	size_t pos = 0;
+	string& log;
+	bool failed = false;
+};
+
+bool Parser::error(const string& message)
+{
+	if (!failed)
+	{
+		const Token& at = peek();
+		log += to_string(at.file) + ":" + to_string(at.line) + ": error: " + message +
+			(at.kind == TOKEN_END ? " at end of input" : " near '" + at.text + "'") + "\n";
+	}
+	failed = true;
+	return false;
+}
+
+bool Parser::expect(const char* text)
+{
+	if (accept(text))
+		return true;
+	return error(string("expected '") + text + "'");
+}
+
+unique_ptr<Expr> Parser::makeExpr(Expr::Kind kind, const string& text)
+{
+	unique_ptr<Expr> expr(new Expr());
+	expr->kind = kind;
+	expr->text = text;
+	expr->line = peek().line;
+	expr->file = peek().file;
+	return expr;
+}
+
+unique_ptr<Stmt> Parser::makeStmt(Stmt::Kind kind)
+{
+	unique_ptr<Stmt> stmt(new Stmt());
+	stmt->kind = kind;
+	stmt->line = peek().line;
+	stmt->file = peek().file;
+	return stmt;
+}
+
+bool Parser::parse(Module& module)
+{
+	while (peek().kind != TOKEN_END && !failed)
+		externalDeclaration(module);
+	return !failed;
+}
+
+bool Parser::layoutQualifier(int& location)
+{
+	if (!expect("("))
+		return false;
+	while (!failed && !accept(")"))
+	{
+		string name = next().text;
+		if (accept("="))
+		{
+			const Token& value = next();
+			if (name == "location")
+				location = atoi(value.text.c_str());
+		}
+		if (!check(")") && !expect(","))
+			return false;
+	}
+	return !failed;
+}
+
+bool Parser::parseType(Type& type)
+{
+	if (!isTypeName(peek()))
+		return error("expected a type");
+	lookupType(next().text, type);
+	if (check("["))
+		return error("arrays are not supported");
+	return true;
+}
+
+bool Parser::externalDeclaration(Module& module)
+{
+	if (accept(";"))
+		return true;
+	if (accept("precision"))
+	{
+		while (!failed && !accept(";"))
+		{
+			if (peek().kind == TOKEN_END)
+				return error("expected ';'");
+			next();
+		}
+		return true;
+	}
+
+	Storage storage = STORAGE_GLOBAL;
+	int location = -1;
+	for (;;)
+	{
+		if (accept("layout"))
+		{
+			if (!layoutQualifier(location))
+				return false;
+		}
+		else if (accept("in")) storage = STORAGE_IN;
+		else if (accept("out")) storage = STORAGE_OUT;
+		else if (accept("uniform")) storage = STORAGE_UNIFORM;
+		else if (accept("const")) storage = STORAGE_CONST;
+		else if (accept("flat") || accept("smooth") || accept("noperspective") || accept("centroid") ||
+			accept("invariant") || accept("highp") || accept("mediump") || accept("lowp"))
+		{
+		}
+		else
+			break;
+	}
+
+	// uniform block: its members become plain uniforms
+	if (storage == STORAGE_UNIFORM && peek().kind == TOKEN_IDENTIFIER && !isTypeName(peek()) && peek(1).text == "{")
+	{
+		next();
+		next();
+		while (!failed && !accept("}"))
+		{
+			int ignored = -1;
+			if (accept("layout") && !layoutQualifier(ignored))
+				return false;
+			while (accept("highp") || accept("mediump") || accept("lowp"))
+			{
+			}
+			Type type;
+			if (!parseType(type))
+				return false;
+			do
+			{
+				Global global;
+				global.storage = STORAGE_UNIFORM;
+				global.type = type;
+				global.line = peek().line;
+				global.file = peek().file;
+				if (peek().kind != TOKEN_IDENTIFIER)
+					return error("expected a name");
+				global.name = next().text;
+				module.globals.push_back(move(global));
+			} while (accept(","));
+			if (!expect(";"))
+				return false;
+		}
+		if (peek().kind == TOKEN_IDENTIFIER)
+			return error("uniform block instance names are not supported");
+		return expect(";");
+	}
+
+	Type type;
+	if (!parseType(type))
+		return false;
+	if (peek().kind != TOKEN_IDENTIFIER)
+		return error("expected a name");
+	string name = next().text;
+
+	if (accept("("))
+	{
+		unique_ptr<Function> function = functionDefinition(type, name);
+		if (function)
+			module.functions.push_back(move(function));
+		return !failed;
+	}
+
+	for (;;)
+	{
+		Global global;
+		global.storage = storage;
+		global.type = type;
+		global.name = name;
+		global.location = location;
+		global.line = peek().line;
+		global.file = peek().file;
+		if (check("["))
+			return error("arrays are not supported");
+		if (accept("="))
+			global.initializer = assignment();
+		module.globals.push_back(move(global));
+		if (failed || !accept(","))
+			break;
+		if (peek().kind != TOKEN_IDENTIFIER)
+			return error("expected a name");
+		name = next().text;
+		location = -1;
+	}
+	return expect(";");
+}
+
+unique_ptr<Function> Parser::functionDefinition(const Type& returnType, const string& name)
+{
+	unique_ptr<Function> function(new Function());
+	function->returnType = returnType;
+	function->name = name;
+	function->line = peek().line;
+	function->file = peek().file;
+
+	if (!(check("void") && peek(1).text == ")"))
+	{
+		while (!failed && !check(")"))
+		{
+			Parameter param;
+			for (;;)
+			{
+				if (accept("in")) param.in = true;
+				else if (accept("out")) { param.in = false; param.out = true; }
+				else if (accept("inout")) { param.in = true; param.out = true; }
+				else if (accept("const") || accept("highp") || accept("mediump") || accept("lowp")) {}
+				else break;
+			}
+			if (!parseType(param.type))
+				return nullptr;
+			if (peek().kind == TOKEN_IDENTIFIER)
+				param.name = next().text;
+			function->params.push_back(param);
+			if (!check(")") && !expect(","))
+				return nullptr;
+		}
+	}
+	else
+	{
+		next();
+	}
+	if (!expect(")"))
+		return nullptr;
+	if (accept(";"))
+		return nullptr;		// a prototype, the definition follows
+	function->body = block();
+	return failed ? nullptr : move(function);
+}
+
+unique_ptr<Stmt> Parser::block()
+{
+	unique_ptr<Stmt> stmt = makeStmt(Stmt::BLOCK);
+	if (!expect("{"))
+		return nullptr;
+	while (!failed && !accept("}"))
+	{
+		if (peek().kind == TOKEN_END)
+		{
+			error("expected '}'");
+			return nullptr;
+		}
+		unique_ptr<Stmt> child = statement();
+		if (child)
+			stmt->children.push_back(move(child));
+	}
+	return failed ? nullptr : move(stmt);
+}
+
+unique_ptr<Stmt> Parser::declaration(bool constant)
+{
+	unique_ptr<Stmt> stmt = makeStmt(Stmt::DECLARATION);
+	stmt->constant = constant;
+	while (accept("highp") || accept("mediump") || accept("lowp"))
+	{
+	}
+	if (!parseType(stmt->type))
+		return nullptr;
+	do
+	{
+		if (peek().kind != TOKEN_IDENTIFIER)
+		{
+			error("expected a name");
+			return nullptr;
+		}
+		stmt->names.push_back(next().text);
+		if (check("["))
+		{
+			error("arrays are not supported");
+			return nullptr;
+		}
+		stmt->initializers.push_back(accept("=") ? assignment() : nullptr);
+	} while (!failed && accept(","));
+	if (!expect(";"))
+		return nullptr;
+	return stmt;
+}
+
+unique_ptr<Stmt> Parser::statement()
+{
+	if (check("{"))
+		return block();
+	if (accept(";"))
+		return makeStmt(Stmt::EMPTY);
+
+	if (accept("if"))
+	{
+		unique_ptr<Stmt> stmt = makeStmt(Stmt::IF);
+		if (!expect("("))
+			return nullptr;
+		stmt->condition = expression();
+		if (!expect(")"))
+			return nullptr;
+		stmt->children.push_back(statement());
+		if (accept("else"))
+			stmt->children.push_back(statement());
+		return failed ? nullptr : move(stmt);
+	}
+	if (accept("for"))
+	{
+		unique_ptr<Stmt> stmt = makeStmt(Stmt::FOR);
+		if (!expect("("))
+			return nullptr;
+		if (!accept(";"))
+			stmt->init = statement();
+		if (!check(";"))
+			stmt->condition = expression();
+		if (!expect(";"))
+			return nullptr;
+		if (!check(")"))
+			stmt->step = expression();
+		if (!expect(")"))
+			return nullptr;
+		stmt->children.push_back(statement());
+		return failed ? nullptr : move(stmt);
+	}
+	if (accept("while"))
+	{
+		unique_ptr<Stmt> stmt = makeStmt(Stmt::WHILE);
+		if (!expect("("))
+			return nullptr;
+		stmt->condition = expression();
+		if (!expect(")"))
+			return nullptr;
+		stmt->children.push_back(statement());
+		return failed ? nullptr : move(stmt);
+	}
+	if (accept("do"))
+	{
+		unique_ptr<Stmt> stmt = makeStmt(Stmt::DO);
+		stmt->children.push_back(statement());
+		if (!expect("while") || !expect("("))
+			return nullptr;
+		stmt->condition = expression();
+		if (!expect(")") || !expect(";"))
+			return nullptr;
+		return stmt;
+	}
+	if (check("break") || check("continue") || check("discard"))
+	{
+		Stmt::Kind kind = check("break") ? Stmt::BREAK : check("continue") ? Stmt::CONTINUE : Stmt::DISCARD;
+		unique_ptr<Stmt> stmt = makeStmt(kind);
+		next();
+		return expect(";") ? move(stmt) : nullptr;
+	}
+	if (check("return"))
+	{
+		unique_ptr<Stmt> stmt = makeStmt(Stmt::RETURN);
+		next();
+		if (!check(";"))
+			stmt->step = expression();
+		return expect(";") ? move(stmt) : nullptr;
+	}
+
+	if (accept("const"))
+		return declaration(true);
+	if (check("highp") || check("mediump") || check("lowp") || (isTypeName(peek()) && peek(1).kind == TOKEN_IDENTIFIER))
+		return declaration(false);
+
+	unique_ptr<Stmt> stmt = makeStmt(Stmt::EXPRESSION);
+	stmt->step = expression();
+	if (!expect(";"))
+		return nullptr;
+	return failed ? nullptr : move(stmt);
+}
+
+unique_ptr<Expr> Parser::expression()
+{
+	unique_ptr<Expr> expr = assignment();
+	if (check(","))
+		error("the comma operator is not supported");
+	return failed ? nullptr : move(expr);
+}
+
+unique_ptr<Expr> Parser::assignment()
+{
+	unique_ptr<Expr> left = ternary();
+	static const char* ops[] = { "=", "+=", "-=", "*=", "/=", "%=" };
+	for (const char* op : ops)
+	{
+		if (check(op))
+		{
+			unique_ptr<Expr> expr = makeExpr(Expr::ASSIGN, op);
+			next();
+			expr->args.push_back(move(left));
+			expr->args.push_back(assignment());
+			return failed ? nullptr : move(expr);
+		}
+	}
+	return left;
+}
+
+unique_ptr<Expr> Parser::ternary()
+{
+	unique_ptr<Expr> condition = binary(0);
+	if (!check("?"))
+		return condition;
+	unique_ptr<Expr> expr = makeExpr(Expr::TERNARY, "?");
+	next();
+	expr->args.push_back(move(condition));
+	expr->args.push_back(assignment());
+	if (!expect(":"))
+		return nullptr;
+	expr->args.push_back(assignment());
+	return failed ? nullptr : move(expr);
+}
+
+unique_ptr<Expr> Parser::binary(int level)
+{
+	static const vector<vector<string>> levels = {
+		{ "||" }, { "^^" }, { "&&" }, { "==", "!=" }, { "<", ">", "<=", ">=" }, { "+", "-" }, { "*", "/", "%" },
+	};
+	if (level == (int)levels.size())
+		return unary();
+	unique_ptr<Expr> left = binary(level + 1);
+	while (!failed && peek().kind == TOKEN_PUNCT &&
+		find(levels[level].begin(), levels[level].end(), peek().text) != levels[level].end())
+	{
+		unique_ptr<Expr> expr = makeExpr(Expr::BINARY, next().text);
+		expr->args.push_back(move(left));
+		expr->args.push_back(binary(level + 1));
+		left = move(expr);
+	}
+	return failed ? nullptr : move(left);
+}
+
+unique_ptr<Expr> Parser::unary()
+{
+	if (check("-") || check("+") || check("!"))
+	{
+		unique_ptr<Expr> expr = makeExpr(Expr::UNARY, next().text);
+		expr->args.push_back(unary());
+		return failed ? nullptr : move(expr);
+	}
+	if (check("++") || check("--"))
+	{
+		unique_ptr<Expr> expr = makeExpr(Expr::PREFIX, next().text);
+		expr->args.push_back(unary());
+		return failed ? nullptr : move(expr);
+	}
+	if (check("~"))
+	{
+		error("bitwise operators are not supported");
+		return nullptr;
+	}
+	return postfix();
+}
+
+unique_ptr<Expr> Parser::postfix()
+{
+	unique_ptr<Expr> expr = primary();
+	while (!failed)
+	{
+		if (accept("."))
+		{
+			unique_ptr<Expr> field = makeExpr(Expr::FIELD, next().text);
+			field->args.push_back(move(expr));
+			expr = move(field);
+		}
+		else if (accept("["))
+		{
+			unique_ptr<Expr> index = makeExpr(Expr::INDEX, "[");
+			index->args.push_back(move(expr));
+			index->args.push_back(expression());
+			if (!expect("]"))
+				return nullptr;
+			expr = move(index);
+		}
+		else if (check("++") || check("--"))
+		{
+			unique_ptr<Expr> op = makeExpr(Expr::POSTFIX, next().text);
+			op->args.push_back(move(expr));
+			expr = move(op);
+		}
+		else
+			break;
+	}
+	return failed ? nullptr : move(expr);
+}
+
+unique_ptr<Expr> Parser::primary()
+{
+	const Token& token = peek();
+	if (token.kind == TOKEN_NUMBER)
+	{
+		unique_ptr<Expr> expr = makeExpr(Expr::LITERAL, token.text);
+		expr->value = literalValue(token.text);
+		expr->literalType = isFloatLiteral(token.text) ? TYPE_FLOAT : TYPE_INT;
+		next();
+		return expr;
+	}
+	if (token.text == "true" || token.text == "false")
+	{
+		unique_ptr<Expr> expr = makeExpr(Expr::LITERAL, token.text);
+		expr->value = token.text == "true" ? 1.0 : 0.0;
+		expr->literalType = TYPE_BOOL;
+		next();
+		return expr;
+	}
+	if (token.kind == TOKEN_IDENTIFIER)
+	{
+		string name = next().text;
+		if (!accept("("))
+			return makeExpr(Expr::NAME, name);
+		unique_ptr<Expr> call = makeExpr(Expr::CALL, name);
+		if (check("void") && peek(1).text == ")")
+			next();
+		while (!failed && !accept(")"))
+		{
+			call->args.push_back(assignment());
+			if (!check(")") && !expect(","))
+				return nullptr;
+		}
+		return failed ? nullptr : move(call);
+	}
+	if (accept("("))
+	{
+		unique_ptr<Expr> expr = expression();
+		if (!expect(")"))
+			return nullptr;
+		return expr;
+	}
+	error("expected an expression");
+	return nullptr;
+}
+
+// ---------------------------------------------------------------- code generation
+
+// registers at or above this are constants until the final layout pass
+const int CONSTANT_TAG = 1 << 24;
+
+struct Instr
+{
+	SoftOp op;
+	int dst, a, b, c;
+	int imm;
+};
+
+struct Value
+{
+	Type type;
+	vector<int> regs;
+	bool assignable = false;
+	int sampler = -1;
+};
+
+struct Variable
+{
+	Type type;
+	vector<int> regs;
+	bool assignable = true;
+	int sampler = -1;
+};
+
+float evaluateScalar(SoftOp op, float a, float b, float c)
+{
+	switch (op)
+	{
+	case SOFT_OP_MOV: return a;
+	case SOFT_OP_ADD: return a + b;
+	case SOFT_OP_SUB: return a - b;
+	case SOFT_OP_MUL: return a * b;
+	case SOFT_OP_DIV: return a / b;
+	case SOFT_OP_NEG: return -a;
+	case SOFT_OP_MADD: return a * b + c;
+	case SOFT_OP_MIN: return min(a, b);
+	case SOFT_OP_MAX: return max(a, b);
+	case SOFT_OP_ABS: return fabs(a);
+	case SOFT_OP_SIGN: return (float)((a > 0.0f) - (a < 0.0f));
+	case SOFT_OP_FLOOR: return floor(a);
+	case SOFT_OP_CEIL: return ceil(a);
+	case SOFT_OP_FRACT: return a - floor(a);
+	case SOFT_OP_TRUNC: return trunc(a);
+	case SOFT_OP_ROUND: return nearbyint(a);
+	case SOFT_OP_MOD: return a - b * floor(a / b);
+	case SOFT_OP_IDIV: return trunc(a / b);
+	case SOFT_OP_IMOD: return a - b * trunc(a / b);
+	case SOFT_OP_SQRT: return sqrt(a);
+	case SOFT_OP_RSQRT: return 1.0f / sqrt(a);
+	case SOFT_OP_POW: return pow(a, b);
+	case SOFT_OP_EXP: return exp(a);
+	case SOFT_OP_EXP2: return exp2(a);
+	case SOFT_OP_LOG: return log(a);
+	case SOFT_OP_LOG2: return log2(a);
+	case SOFT_OP_SIN: return sin(a);
+	case SOFT_OP_COS: return cos(a);
+	case SOFT_OP_TAN: return tan(a);
+	case SOFT_OP_ASIN: return asin(a);
+	case SOFT_OP_ACOS: return acos(a);
+	case SOFT_OP_ATAN: return atan(a);
+	case SOFT_OP_ATAN2: return atan2(a, b);
+	case SOFT_OP_LT: return a < b ? 1.0f : 0.0f;
+	case SOFT_OP_LE: return a <= b ? 1.0f : 0.0f;
+	case SOFT_OP_GT: return a > b ? 1.0f : 0.0f;
+	case SOFT_OP_GE: return a >= b ? 1.0f : 0.0f;
+	case SOFT_OP_EQ: return a == b ? 1.0f : 0.0f;
+	case SOFT_OP_NE: return a != b ? 1.0f : 0.0f;
+	case SOFT_OP_AND: return a != 0.0f && b != 0.0f ? 1.0f : 0.0f;
+	case SOFT_OP_OR: return a != 0.0f || b != 0.0f ? 1.0f : 0.0f;
+	case SOFT_OP_XOR: return (a != 0.0f) != (b != 0.0f) ? 1.0f : 0.0f;
+	case SOFT_OP_NOT: return a == 0.0f ? 1.0f : 0.0f;
+	case SOFT_OP_SELECT: return a != 0.0f ? b : c;
+	case SOFT_OP_CLAMP: return min(max(a, b), c);
+	case SOFT_OP_MIX: return a + (b - a) * c;
+	case SOFT_OP_STEP: return b < a ? 0.0f : 1.0f;
+	case SOFT_OP_SMOOTHSTEP:
+	{
+		float t = min(max((c - a) / (b - a), 0.0f), 1.0f);
+		return t * t * (3.0f - 2.0f * t);
+	}
+	default: return 0.0f;
+	}
+}
+
+bool isFoldable(SoftOp op)
+{
+	return op <= SOFT_OP_SMOOTHSTEP;
+}
+
+// the variable an l-value expression writes to
+const string* rootName(const Expr* expr)
+{
+	while (expr && (expr->kind == Expr::FIELD || expr->kind == Expr::INDEX))
+		expr = expr->args[0].get();
+	return expr && expr->kind == Expr::NAME ? &expr->text : nullptr;
+}
+
+// constructors and built-in functions, none of them has out parameters
+bool isIntrinsic(const string& name)
+{
+	static const char* names[] = {
+		"sin", "cos", "tan", "asin", "acos", "atan", "exp", "log", "exp2", "log2", "sqrt", "inversesqrt",
+		"abs", "sign", "floor", "ceil", "fract", "trunc", "round", "roundEven", "pow", "mod", "min", "max",
+		"step", "clamp", "mix", "smoothstep", "dFdx", "dFdy", "fwidth", "radians", "degrees", "dot", "length",
+		"distance", "normalize", "cross", "reflect", "lessThan", "lessThanEqual", "greaterThan",
+		"greaterThanEqual", "equal", "notEqual", "any", "all", "not", "transpose", "matrixCompMult",
+		"texture", "texture2D", "textureLod",
+	};
+	Type type;
+	if (lookupType(name, type))
+		return true;
+	for (const char* intrinsic : names)
+	{
+		if (name == intrinsic)
+			return true;
+	}
+	return false;
+}
+
+// could the expression assign name? Calls of user functions count, name may
+// be an out argument
+bool writes(const Expr* expr, const string& name)
+{
+	if (!expr)
+		return false;
+	bool assigns = expr->kind == Expr::ASSIGN || expr->kind == Expr::PREFIX || expr->kind == Expr::POSTFIX ||
+		(expr->kind == Expr::CALL && !isIntrinsic(expr->text));
+	for (size_t i = 0; i < expr->args.size(); i++)
+	{
+		const string* root = rootName(expr->args[i].get());
+		if (root && *root == name && assigns && (i == 0 || expr->kind == Expr::CALL))
+			return true;
+		if (writes(expr->args[i].get(), name))
+			return true;
+	}
+	return false;
+}
+
+bool writes(const Stmt* stmt, const string& name)
+{
+	if (!stmt)
+		return false;
+	// a redeclaration would shadow it, treat that as a write too
+	if (find(stmt->names.begin(), stmt->names.end(), name) != stmt->names.end())
+		return true;
+	if (writes(stmt->init.get(), name) || writes(stmt->condition.get(), name) || writes(stmt->step.get(), name))
+		return true;
+	for (const auto& init : stmt->initializers)
+	{
+		if (writes(init.get(), name))
+			return true;
+	}
+	for (const auto& child : stmt->children)
+	{
+		if (writes(child.get(), name))
+			return true;
+	}
+	return false;
+}
+
+class CodeGenerator
+{
+public:
+	CodeGenerator(SoftShaderStage stage, Module& module, SoftShader& shader, string& log)
+		: stage(stage), module(module), shader(shader), log(log) {}
+
+	bool generate(const vector<Token>& tokens);
+
+private:
+	struct Loop
+	{
+		int breakReg = -1;
+		int continueReg = -1;
+	};
+
+	struct FunctionContext
+	{
+		const Function* function = nullptr;
+		vector<int> result;
+		int returnReg = -1;		// lanes that returned, divergent functions only
+		int entryDepth = 0;
+		bool killed = false;	// some lanes left through return/break/continue/discard
+		bool returned = false;	// a top level return was generated, skip the rest
+		vector<Loop> loops;
+	};
+
+	bool error(int line, int file, const string& message);
+	bool error(const Expr& at, const string& message) { return error(at.line, at.file, message); }
+
+	int allocate(int count);
+	int constant(float value);
+	bool isConstant(int reg) const { return reg >= CONSTANT_TAG; }
+	float constantValue(int reg) const { return constants[reg - CONSTANT_TAG]; }
+	bool isTemporary(int reg) const { return !isConstant(reg) && reg >= statementMark; }
+
+	int emit(SoftOp op, int a = -1, int b = -1, int c = -1);
+	void emitRaw(SoftOp op, int dst, int a = -1, int b = -1, int c = -1, int imm = 0);
+	int emitJump(SoftOp op) { emitRaw(op, -1); return (int)code.size() - 1; }
+	void patch(int jump) { code[jump].imm = (int)code.size(); }
+	void restoreKilledLanes();
+	bool needsMask() const;
+
+	void pushScope() { scopes.emplace_back(); }
+	void popScope() { scopes.pop_back(); }
+	const Variable* findVariable(const string& name) const;
+	Variable& declare(const string& name, const Type& type);
+
+	// statements
+	void statement(const Stmt& stmt);
+	void declarationStatement(const Stmt& stmt);
+	void ifStatement(const Stmt& stmt);
+	void loopStatement(const Stmt& stmt);
+	bool unrollLoop(const Stmt& stmt);
+	void killStatement(const Stmt& stmt);
+	int condition(const Expr& expr);
+
+	// expressions
+	Value value(const Expr& expr);
+	Value name(const Expr& expr);
+	Value field(const Expr& expr);
+	Value index(const Expr& expr);
+	Value unaryOp(const Expr& expr);
+	Value binaryOp(const Expr& expr);
+	Value assign(const Expr& expr);
+	Value increment(const Expr& expr);
+	Value ternaryOp(const Expr& expr);
+	Value call(const Expr& expr);
+	Value construct(const Expr& expr, const Type& type, const vector<Value>& args);
+	bool builtin(const Expr& expr, const vector<Value>& args, Value& result);
+	Value userCall(const Expr& expr, vector<Value>& args);
+
+	Value arithmetic(const Expr& at, const string& op, Value a, Value b);
+	Value componentwise(SoftOp op, const Type& type, const vector<Value>& args, const vector<int>& broadcast = {});
+	int dot(const Value& a, const Value& b);
+	Value scalar(int reg, BaseType base = TYPE_FLOAT) { Value v; v.type = makeType(base); v.regs = { reg }; return v; }
+	Value convert(const Value& v, BaseType base);
+	void store(const Expr& at, const Value& target, const Value& source);
+	Value copy(const Value& v);
+
+	SoftShaderStage stage;
+	Module& module;
+	SoftShader& shader;
+	string& log;
+	bool failed = false;
+
+	vector<Instr> code;
+	vector<float> constants;
+	map<uint32_t, int> constantIndex;
+	int nextReg = 0;
+	int maxReg = 0;
+	int statementMark = 0;
+	int maskDepth = 0;
+	int discardReg = -1;
+	int samplerCount = 0;
+	int callDepth = 0;
+	// the statements after the one being generated in its block, to see
+	// whether a local is ever assigned
+	const vector<unique_ptr<Stmt>>* blockStatements = nullptr;
+	size_t blockIndex = 0;
+
+	vector<map<string, Variable>> scopes;
+	vector<FunctionContext> functions;
+};
+
+bool CodeGenerator::error(int line, int file, const string& message)
+{
+	if (!failed)
+		log += to_string(file) + ":" + to_string(line) + ": error: " + message + "\n";
+	failed = true;
+	return false;
+}
+
+int CodeGenerator::allocate(int count)
+{
+	int first = nextReg;
+	nextReg += count;
+	maxReg = max(maxReg, nextReg);
+	return first;
+}
+
+int CodeGenerator::constant(float value)
+{
+	uint32_t bits;
+	memcpy(&bits, &value, sizeof(bits));
+	auto found = constantIndex.find(bits);
+	if (found != constantIndex.end())
+		return found->second;
+	int reg = CONSTANT_TAG + (int)constants.size();
+	constants.push_back(value);
+	constantIndex[bits] = reg;
+	return reg;
+}
+
+void CodeGenerator::emitRaw(SoftOp op, int dst, int a, int b, int c, int imm)
+{
+	code.push_back({ op, dst, a, b, c, imm });
+}
+
+int CodeGenerator::emit(SoftOp op, int a, int b, int c)
+{
+	bool constantOperands = (a < 0 || isConstant(a)) && (b < 0 || isConstant(b)) && (c < 0 || isConstant(c));
+	if (isFoldable(op) && constantOperands)
+	{
+		return constant(evaluateScalar(op, a < 0 ? 0.0f : constantValue(a),
+			b < 0 ? 0.0f : constantValue(b), c < 0 ? 0.0f : constantValue(c)));
+	}
+	// x * 1, x / 1, x + 0, x - 0
+	if ((op == SOFT_OP_MUL || op == SOFT_OP_DIV) && isConstant(b) && constantValue(b) == 1.0f)
+		return a;
+	if (op == SOFT_OP_MUL && isConstant(a) && constantValue(a) == 1.0f)
+		return b;
+	if ((op == SOFT_OP_ADD || op == SOFT_OP_SUB) && isConstant(b) && constantValue(b) == 0.0f)
+		return a;
+	if (op == SOFT_OP_ADD && isConstant(a) && constantValue(a) == 0.0f)
+		return b;
+	int dst = allocate(1);
+	emitRaw(op, dst, a, b, c);
+	return dst;
+}
+
+bool CodeGenerator::needsMask() const
+{
+	if (maskDepth > 0)
+		return true;
+	for (const FunctionContext& context : functions)
+	{
+		if (context.killed)
+			return true;
+	}
+	return false;
+}
+
+// after a POP brings back the lanes that entered a construct, drop the ones
+// that left through a kill inside it
+void CodeGenerator::restoreKilledLanes()
+{
+	const FunctionContext& context = functions.back();
+	if (context.returnReg >= 0)
+		emitRaw(SOFT_OP_EXEC_ANDNOT, -1, context.returnReg);
+	if (!context.loops.empty())
+	{
+		const Loop& loop = context.loops.back();
+		if (loop.breakReg >= 0)
+			emitRaw(SOFT_OP_EXEC_ANDNOT, -1, loop.breakReg);
+		if (loop.continueReg >= 0)
+			emitRaw(SOFT_OP_EXEC_ANDNOT, -1, loop.continueReg);
+	}
+	if (discardReg >= 0)
+		emitRaw(SOFT_OP_EXEC_ANDNOT, -1, discardReg);
+}
+
+const Variable* CodeGenerator::findVariable(const string& name) const
+{
+	for (auto scope = scopes.rbegin(); scope != scopes.rend(); ++scope)
+	{
+		auto found = scope->find(name);
+		if (found != scope->end())
+			return &found->second;
+	}
+	return nullptr;
+}
+
+Variable& CodeGenerator::declare(const string& name, const Type& type)
+{
+	Variable& variable = scopes.back()[name];
+	variable.type = type;
+	variable.regs.clear();
+	int first = allocate(type.size());
+	for (int i = 0; i < type.size(); i++)
+		variable.regs.push_back(first + i);
+	return variable;
+}
+
+// does the statement tree contain a statement of this kind, not counting
+// nested loops when looking for break/continue
+bool contains(const Stmt* stmt, Stmt::Kind kind, bool intoLoops)
+{
+	if (!stmt)
+		return false;
+	if (stmt->kind == kind)
+		return true;
+	bool loop = stmt->kind == Stmt::FOR || stmt->kind == Stmt::WHILE || stmt->kind == Stmt::DO;
+	if (loop && !intoLoops)
+		return false;
+	for (const auto& child : stmt->children)
+	{
+		if (contains(child.get(), kind, intoLoops))
+			return true;
+	}
+	return false;
+}
+
+bool hasNestedReturn(const Stmt* stmt, bool nested)
+{
+	if (!stmt)
+		return false;
+	if (stmt->kind == Stmt::RETURN)
+		return nested;
+	bool inner = nested || stmt->kind != Stmt::BLOCK;
+	for (const auto& child : stmt->children)
+	{
+		if (hasNestedReturn(child.get(), inner))
+			return true;
+	}
+	return false;
+}
+
+bool CodeGenerator::generate(const vector<Token>& tokens)
+{
+	pushScope();
+
+	auto uses = [&](const char* name) {
+		for (const Token& token : tokens)
+		{
+			if (token.text == name)
+				return true;
+		}
+		return false;
+	};
+
+	// built-in variables
+	if (stage == SOFT_VERTEX_SHADER)
+	{
+		Variable& position = declare("gl_Position", makeType(TYPE_FLOAT, 4));
+		shader.positionReg = position.regs[0];
+		if (uses("gl_VertexID"))
+		{
+			Variable& id = declare("gl_VertexID", makeType(TYPE_INT));
+			id.assignable = false;
+			shader.vertexIdReg = id.regs[0];
+		}
+		if (uses("gl_InstanceID"))
+		{
+			Variable& id = declare("gl_InstanceID", makeType(TYPE_INT));
+			id.assignable = false;
+			shader.instanceIdReg = id.regs[0];
+		}
+	}
+	else
+	{
+		if (uses("gl_FragCoord"))
+		{
+			Variable& coord = declare("gl_FragCoord", makeType(TYPE_FLOAT, 4));
+			coord.assignable = false;
+			shader.fragCoordReg = coord.regs[0];
+		}
+		for (const auto& function : module.functions)
+		{
+			if (contains(function->body.get(), Stmt::DISCARD, true))
+			{
+				discardReg = allocate(1);
+				shader.discardReg = discardReg;
+				break;
+			}
+		}
+	}
+
+	// globals get registers up front, initializers run at the top of main
+	int inputCount = 0, outputCount = 0;
+	for (Global& global : module.globals)
+	{
+		if (findVariable(global.name) && scopes.back().count(global.name))
+			return error(global.line, global.file, "redefinition of " + global.name);
+		if (global.type.base == TYPE_SAMPLER)
+		{
+			if (global.storage != STORAGE_UNIFORM)
+				return error(global.line, global.file, "samplers must be uniforms");
+			Variable& variable = scopes.back()[global.name];
+			variable.type = global.type;
+			variable.assignable = false;
+			variable.sampler = samplerCount++;
+			shader.samplers.push_back({ global.name, 0, -1, variable.sampler });
+			continue;
+		}
+		Variable& variable = declare(global.name, global.type);
+		SoftShaderVariable exported{ global.name, global.type.size(), global.location, variable.regs[0] };
+		switch (global.storage)
+		{
+		case STORAGE_IN:
+			variable.assignable = false;
+			if (exported.location < 0)
+				exported.location = inputCount;
+			inputCount++;
+			shader.inputs.push_back(exported);
+			break;
+		case STORAGE_OUT:
+			if (exported.location < 0)
+				exported.location = outputCount;
+			outputCount++;
+			shader.outputs.push_back(exported);
+			break;
+		case STORAGE_UNIFORM:
+			variable.assignable = false;
+			shader.uniforms.push_back(exported);
+			break;
+		default:
+			break;
+		}
+	}
+
+	const Function* mainFunction = nullptr;
+	for (const auto& function : module.functions)
+	{
+		if (function->name == "main" && function->params.empty())
+			mainFunction = function.get();
+		function->divergentReturn = hasNestedReturn(function->body.get(), false);
+	}
+	if (!mainFunction)
+		return error(0, 0, "no main() function");
+
+	FunctionContext context;
+	context.function = mainFunction;
+	functions.push_back(context);
+	pushScope();
+
+	// global initializers, const ones with constant values cost nothing
+	for (Global& global : module.globals)
+	{
+		if (!global.initializer || failed)
+			continue;
+		statementMark = nextReg;
+		Value init = value(*global.initializer);
+		if (failed)
+			break;
+		Variable& variable = scopes.front()[global.name];
+		bool allConstant = all_of(init.regs.begin(), init.regs.end(), [&](int r) { return isConstant(r); });
+		bool neverWritten = global.storage == STORAGE_CONST;
+		if (global.storage == STORAGE_GLOBAL)
+		{
+			neverWritten = true;
+			for (const auto& function : module.functions)
+				neverWritten = neverWritten && !writes(function->body.get(), global.name);
+			for (const Global& other : module.globals)
+				neverWritten = neverWritten && !writes(other.initializer.get(), global.name);
+		}
+		if (neverWritten && allConstant && init.type == variable.type)
+		{
+			variable.regs = init.regs;
+			variable.assignable = false;
+			continue;
+		}
+		Value target;
+		target.type = variable.type;
+		target.regs = variable.regs;
+		target.assignable = true;
+		store(*global.initializer, target, init);
+		if (global.storage == STORAGE_CONST)
+			variable.assignable = false;
+		nextReg = statementMark;
+	}
+
+	if (mainFunction->divergentReturn)
+	{
+		functions.back().returnReg = allocate(1);
+		emitRaw(SOFT_OP_CLEAR, functions.back().returnReg);
+	}
+	statement(*mainFunction->body);
+	popScope();
+	functions.pop_back();
+	if (failed)
+		return false;
+
+	// final layout: working registers, then constants
+	shader.stage = stage;
+	shader.constantBase = maxReg;
+	shader.constants = constants;
+	shader.registerCount = maxReg + (int)constants.size();
+	if (shader.registerCount > 0xffff)
+		return error(0, 0, "shader needs too many registers");
+	auto place = [&](int reg) { return (uint16_t)(reg < 0 ? 0 : reg >= CONSTANT_TAG ? maxReg + reg - CONSTANT_TAG : reg); };
+	shader.code.clear();
+	for (const Instr& instr : code)
+		shader.code.push_back({ (uint16_t)instr.op, place(instr.dst), place(instr.a), place(instr.b), place(instr.c), instr.imm });
+	return true;
+}
+
+// ---------------------------------------------------------------- statements
+
+void CodeGenerator::statement(const Stmt& stmt)
+{
+	if (failed || functions.back().returned)
+		return;
+	int mark = nextReg;
+	statementMark = mark;
+	switch (stmt.kind)
+	{
+	case Stmt::BLOCK:
+	{
+		auto outerBlock = blockStatements;
+		size_t outerIndex = blockIndex;
+		pushScope();
+		for (size_t i = 0; i < stmt.children.size(); i++)
+		{
+			blockStatements = &stmt.children;
+			blockIndex = i;
+			statement(*stmt.children[i]);
+		}
+		popScope();
+		blockStatements = outerBlock;
+		blockIndex = outerIndex;
+		break;
+	}
+	case Stmt::DECLARATION:
+		declarationStatement(stmt);
+		return;		// keeps its registers
+	case Stmt::EXPRESSION:
+		value(*stmt.step);
+		break;
+	case Stmt::IF:
+		ifStatement(stmt);
+		break;
+	case Stmt::FOR:
+	case Stmt::WHILE:
+	case Stmt::DO:
+		loopStatement(stmt);
+		break;
+	case Stmt::BREAK:
+	case Stmt::CONTINUE:
+	case Stmt::RETURN:
+	case Stmt::DISCARD:
+		killStatement(stmt);
+		break;
+	case Stmt::EMPTY:
+		break;
+	}
+	nextReg = mark;
+}
+
+void CodeGenerator::declarationStatement(const Stmt& stmt)
+{
+	for (size_t i = 0; i < stmt.names.size() && !failed; i++)
+	{
+		if (scopes.back().count(stmt.names[i]))
+		{
+			error(stmt.line, stmt.file, "redefinition of " + stmt.names[i]);
+			return;
+		}
+		const Expr* initializer = stmt.initializers[i].get();
+		if (!initializer)
+		{
+			if (stmt.constant)
+				error(stmt.line, stmt.file, "const " + stmt.names[i] + " needs an initializer");
+			declare(stmt.names[i], stmt.type);
+			continue;
+		}
+
+		statementMark = nextReg;
+		int mark = nextReg;
+		Value init = value(*initializer);
+		if (failed)
+			return;
+		bool allConstant = all_of(init.regs.begin(), init.regs.end(), [&](int r) { return isConstant(r); });
+		// a local that is never assigned after a constant initializer is
+		// as good as const
+		bool neverWritten = stmt.constant;
+		if (!neverWritten && blockStatements && (*blockStatements)[blockIndex].get() == &stmt)
+		{
+			neverWritten = true;
+			for (size_t k = blockIndex + 1; k < blockStatements->size() && neverWritten; k++)
+				neverWritten = !writes((*blockStatements)[k].get(), stmt.names[i]);
+			for (size_t k = i + 1; k < stmt.names.size() && neverWritten; k++)
+				neverWritten = !writes(stmt.initializers[k].get(), stmt.names[i]);
+		}
+		if (neverWritten && allConstant && init.type == stmt.type)
+		{
+			nextReg = mark;
+			Variable& variable = scopes.back()[stmt.names[i]];
+			variable.type = stmt.type;
+			variable.regs = init.regs;
+			variable.assignable = false;
+			continue;
+		}
+
+		// the initializer's temporaries sit below the variable, that only
+		// wastes registers until the end of the scope
+		Variable& variable = declare(stmt.names[i], stmt.type);
+		Value target;
+		target.type = variable.type;
+		target.regs = variable.regs;
+		target.assignable = true;
+		// a fresh variable doesn't need a masked store
+		int depth = maskDepth;
+		bool killed = functions.back().killed;
+		maskDepth = 0;
+		functions.back().killed = false;
+		bool outerKilled = needsMask();
+		if (outerKilled)
+		{
+			maskDepth = depth;
+			functions.back().killed = killed;
+		}
+		store(*initializer, target, init);
+		maskDepth = depth;
+		functions.back().killed = killed;
+		variable.assignable = !stmt.constant;
+	}
+}
+
+// evaluates a condition into a register the statement owns
+int CodeGenerator::condition(const Expr& expr)
+{
+	Value c = value(expr);
+	if (failed)
+		return -1;
+	if (!c.type.isScalar() || c.type.base != TYPE_BOOL)
+	{
+		error(expr, "condition must be a bool, not " + typeName(c.type));
+		return -1;
+	}
+	if (isTemporary(c.regs[0]) || isConstant(c.regs[0]))
+		return c.regs[0];
+	int reg = allocate(1);
+	emitRaw(SOFT_OP_MOV, reg, c.regs[0]);
+	return reg;
+}
+
+void CodeGenerator::ifStatement(const Stmt& stmt)
+{
+	int c = condition(*stmt.condition);
+	if (failed)
+		return;
+	const Stmt* thenBranch = stmt.children[0].get();
+	const Stmt* elseBranch = stmt.children.size() > 1 ? stmt.children[1].get() : nullptr;
+
+	// a constant condition compiles just the branch it selects
+	if (isConstant(c))
+	{
+		const Stmt* taken = constantValue(c) != 0.0f ? thenBranch : elseBranch;
+		if (taken)
+			statement(*taken);
+		return;
+	}
+
+	emitRaw(SOFT_OP_PUSH, -1);
+	emitRaw(SOFT_OP_EXEC_AND, -1, c);
+	int skipThen = emitJump(SOFT_OP_JNONE);
+	maskDepth++;
+	if (thenBranch)
+		statement(*thenBranch);
+	maskDepth--;
+	bool returnedInThen = functions.back().returned;
+	functions.back().returned = false;
+	patch(skipThen);
+	if (elseBranch)
+	{
+		emitRaw(SOFT_OP_ELSE, -1, c);
+		int skipElse = emitJump(SOFT_OP_JNONE);
+		maskDepth++;
+		statement(*elseBranch);
+		maskDepth--;
+		functions.back().returned = false;
+		patch(skipElse);
+	}
+	(void)returnedInThen;
+	emitRaw(SOFT_OP_POP, -1);
+	restoreKilledLanes();
+}
+
+// for (int i = a; i < b; i++) with constant a and b, no break or continue and
+// nothing else touching i becomes b - a copies of the body with i folded
+// into a constant, which removes the mask bookkeeping and lets i * k and
+// float(i) fold as well
+bool CodeGenerator::unrollLoop(const Stmt& stmt)
+{
+	const int MAX_UNROLL = 32;
+	const Stmt* init = stmt.init.get();
+	const Stmt* body = stmt.children[0].get();
+	const Expr* cond = stmt.condition.get();
+	const Expr* step = stmt.step.get();
+	if (stmt.kind != Stmt::FOR || !init || !cond || !step || init->kind != Stmt::DECLARATION ||
+		init->names.size() != 1 || !init->initializers[0] || !init->type.isScalar() || init->type.base == TYPE_BOOL)
+		return false;
+	const string& name = init->names[0];
+	if (cond->kind != Expr::BINARY || cond->args[0]->kind != Expr::NAME || cond->args[0]->text != name)
+		return false;
+	if (contains(body, Stmt::BREAK, false) || contains(body, Stmt::CONTINUE, false) ||
+		writes(body, name) || writes(cond->args[1].get(), name))
+		return false;
+
+	bool increment = (step->kind == Expr::PREFIX || step->kind == Expr::POSTFIX) && step->args[0]->kind == Expr::NAME;
+	bool compound = step->kind == Expr::ASSIGN && (step->text == "+=" || step->text == "-=") && step->args[0]->kind == Expr::NAME;
+	if (!(increment || compound) || step->args[0]->text != name)
+		return false;
+
+	// the bounds must fold to constants; throw away anything they emitted
+	size_t codeMark = code.size();
+	int regMark = nextReg;
+	Value start = value(*init->initializers[0]);
+	Value limit = value(*cond->args[1]);
+	Value amount = compound ? value(*step->args[1]) : scalar(constant(step->text == "++" ? 1.0f : -1.0f));
+	bool foldable = !failed && start.type.isScalar() && limit.type.isScalar() && amount.type.isScalar() &&
+		isConstant(start.regs[0]) && isConstant(limit.regs[0]) && isConstant(amount.regs[0]);
+	code.resize(codeMark);
+	nextReg = regMark;
+	if (!foldable)
+		return false;
+
+	float delta = constantValue(amount.regs[0]) * (step->text == "-=" ? -1.0f : 1.0f);
+	float bound = constantValue(limit.regs[0]);
+	vector<float> iterations;
+	for (float x = constantValue(start.regs[0]);; x += delta)
+	{
+		bool more = cond->text == "<" ? x < bound : cond->text == "<=" ? x <= bound : cond->text == ">" ? x > bound :
+			cond->text == ">=" ? x >= bound : cond->text == "!=" ? x != bound : false;
+		if (!more)
+			break;
+		if ((int)iterations.size() == MAX_UNROLL)
+			return false;
+		iterations.push_back(x);
+	}
+
+	pushScope();
+	for (float x : iterations)
+	{
+		Variable& counter = scopes.back()[name];
+		counter.type = init->type;
+		counter.regs = { constant(x) };
+		counter.assignable = false;
+		statement(*body);
+		if (failed || functions.back().returned)
+			break;
+	}
+	popScope();
+	return true;
+}
+
+void CodeGenerator::loopStatement(const Stmt& stmt)
+{
+	if (unrollLoop(stmt))
+		return;
+	pushScope();
+	if (stmt.init)
+	{
+		statement(*stmt.init);
+		statementMark = nextReg;
+	}
+
+	const Stmt* body = stmt.children[0].get();
+	Loop loop;
+	if (contains(body, Stmt::BREAK, false))
+	{
+		loop.breakReg = allocate(1);
+		emitRaw(SOFT_OP_CLEAR, loop.breakReg);
+	}
+	if (contains(body, Stmt::CONTINUE, false))
+		loop.continueReg = allocate(1);
+	int mark = nextReg;
+
+	emitRaw(SOFT_OP_PUSH, -1);
+	int top = (int)code.size();
+	if (loop.continueReg >= 0)
+		emitRaw(SOFT_OP_CLEAR, loop.continueReg);
+
+	int exitJump = -1;
+	if (stmt.kind != Stmt::DO && stmt.condition)
+	{
+		statementMark = nextReg;
+		int c = condition(*stmt.condition);
+		if (failed)
+			return;
+		if (!isConstant(c))
+			emitRaw(SOFT_OP_EXEC_AND, -1, c);
+		else if (constantValue(c) == 0.0f)
+			emitRaw(SOFT_OP_CLEAR, -1);		// never runs, keep it simple and mask everything off below
+		nextReg = mark;
+		exitJump = emitJump(SOFT_OP_JNONE);
+	}
+
+	functions.back().loops.push_back(loop);
+	maskDepth++;
+	statement(*body);
+	if (loop.continueReg >= 0)
+		emitRaw(SOFT_OP_EXEC_OR, -1, loop.continueReg);
+	if (stmt.step)
+	{
+		statementMark = nextReg;
+		value(*stmt.step);
+		nextReg = mark;
+	}
+	if (stmt.kind == Stmt::DO)
+	{
+		statementMark = nextReg;
+		int c = condition(*stmt.condition);
+		if (failed)
+			return;
+		emitRaw(SOFT_OP_EXEC_AND, -1, c);
+		nextReg = mark;
+		emitRaw(SOFT_OP_JANY, -1, -1, -1, -1, top);
+	}
+	else
+	{
+		emitRaw(SOFT_OP_JMP, -1, -1, -1, -1, top);
+	}
+	maskDepth--;
+	functions.back().loops.pop_back();
+	functions.back().returned = false;
+	if (exitJump >= 0)
+		patch(exitJump);
+	emitRaw(SOFT_OP_POP, -1);
+	restoreKilledLanes();
+	popScope();
+}
+
+void CodeGenerator::killStatement(const Stmt& stmt)
+{
+	FunctionContext& context = functions.back();
+	switch (stmt.kind)
+	{
+	case Stmt::BREAK:
+	case Stmt::CONTINUE:
+		if (context.loops.empty())
+		{
+			error(stmt.line, stmt.file, string(stmt.kind == Stmt::BREAK ? "break" : "continue") + " outside a loop");
+			return;
+		}
+		emitRaw(SOFT_OP_KILL, stmt.kind == Stmt::BREAK ? context.loops.back().breakReg : context.loops.back().continueReg);
+		context.killed = true;
+		return;
+	case Stmt::DISCARD:
+		if (stage != SOFT_FRAGMENT_SHADER)
+		{
+			error(stmt.line, stmt.file, "discard outside a fragment shader");
+			return;
+		}
+		emitRaw(SOFT_OP_KILL, discardReg);
+		context.killed = true;
+		return;
+	default:
+		break;
+	}
+
+	// return
+	const Function* function = context.function;
+	if (stmt.step)
+	{
+		Value result = value(*stmt.step);
+		if (failed)
+			return;
+		if (function->returnType.base == TYPE_VOID)
+		{
+			error(stmt.line, stmt.file, "void function returns a value");
+			return;
+		}
+		Value target;
+		target.type = function->returnType;
+		target.regs = context.result;
+		target.assignable = true;
+		store(*stmt.step, target, result);
+	}
+	else if (function->returnType.base != TYPE_VOID)
+	{
+		error(stmt.line, stmt.file, "missing return value");
+		return;
+	}
+
+	if (maskDepth > context.entryDepth && context.returnReg >= 0)
+	{
+		emitRaw(SOFT_OP_KILL, context.returnReg);
+		context.killed = true;
+	}
+	else
+	{
+		context.returned = true;
+	}
+}
+
+// ---------------------------------------------------------------- expressions
+
+Value CodeGenerator::value(const Expr& expr)
+{
+	if (failed)
+		return Value();
+	switch (expr.kind)
+	{
+	case Expr::LITERAL:
+		return scalar(constant((float)expr.value), expr.literalType);
+	case Expr::NAME:
+		return name(expr);
+	case Expr::UNARY:
+		return unaryOp(expr);
+	case Expr::BINARY:
+		return binaryOp(expr);
+	case Expr::ASSIGN:
+		return assign(expr);
+	case Expr::PREFIX:
+	case Expr::POSTFIX:
+		return increment(expr);
+	case Expr::CALL:
+		return call(expr);
+	case Expr::FIELD:
+		return field(expr);
+	case Expr::INDEX:
+		return index(expr);
+	case Expr::TERNARY:
+		return ternaryOp(expr);
+	}
+	return Value();
+}
+
+Value CodeGenerator::name(const Expr& expr)
+{
+	const Variable* variable = findVariable(expr.text);
+	if (!variable)
+	{
+		error(expr, "undeclared identifier " + expr.text);
+		return Value();
+	}
+	Value v;
+	v.type = variable->type;
+	v.regs = variable->regs;
+	v.assignable = variable->assignable;
+	v.sampler = variable->sampler;
+	return v;
+}
+
+Value CodeGenerator::field(const Expr& expr)
+{
+	Value base = value(*expr.args[0]);
+	if (failed)
+		return Value();
+	if (!(base.type.isScalar() || base.type.isVector()))
+	{
+		error(expr, "can't take ." + expr.text + " of " + typeName(base.type));
+		return Value();
+	}
+	static const char* sets[] = { "xyzw", "rgba", "stpq" };
+	Value v;
+	v.assignable = base.assignable;
+	for (char c : expr.text)
+	{
+		int component = -1;
+		for (const char* set : sets)
+		{
+			const char* at = strchr(set, c);
+			if (at && (component < 0))
+				component = (int)(at - set);
+		}
+		if (component < 0 || component >= base.type.rows || expr.text.size() > 4)
+		{
+			error(expr, "bad swizzle ." + expr.text + " on " + typeName(base.type));
+			return Value();
+		}
+		if (find(v.regs.begin(), v.regs.end(), base.regs[component]) != v.regs.end())
+			v.assignable = false;
+		v.regs.push_back(base.regs[component]);
+	}
+	v.type = makeType(base.type.base, (int)v.regs.size());
+	return v;
+}
+
+Value CodeGenerator::index(const Expr& expr)
+{
+	Value base = value(*expr.args[0]);
+	Value i = value(*expr.args[1]);
+	if (failed)
+		return Value();
+	if (!i.type.isScalar() || !isConstant(i.regs[0]))
+	{
+		error(expr, "only constant indices are supported");
+		return Value();
+	}
+	int at = (int)constantValue(i.regs[0]);
+	Value v;
+	v.assignable = base.assignable;
+	if (base.type.isMatrix() && at >= 0 && at < base.type.columns)
+	{
+		v.type = makeType(base.type.base, base.type.rows);
+		v.regs.assign(base.regs.begin() + at * base.type.rows, base.regs.begin() + (at + 1) * base.type.rows);
+		return v;
+	}
+	if (base.type.isVector() && at >= 0 && at < base.type.rows)
+	{
+		v.type = makeType(base.type.base);
+		v.regs = { base.regs[at] };
+		return v;
+	}
+	error(expr, "index out of range or not indexable");
+	return Value();
+}
+
+Value CodeGenerator::convert(const Value& v, BaseType base)
+{
+	if (v.type.base == base)
+		return v;
+	Value out = v;
+	out.type.base = base;
+	out.assignable = false;
+	if (base == TYPE_BOOL)
+	{
+		for (int& reg : out.regs)
+			reg = emit(SOFT_OP_NE, reg, constant(0.0f));
+	}
+	else if (base == TYPE_INT && v.type.base == TYPE_FLOAT)
+	{
+		for (int& reg : out.regs)
+			reg = emit(SOFT_OP_TRUNC, reg);
+	}
+	return out;
+}
+
+Value CodeGenerator::copy(const Value& v)
+{
+	Value out = v;
+	out.assignable = false;
+	for (int& reg : out.regs)
+	{
+		int dst = allocate(1);
+		emitRaw(SOFT_OP_MOV, dst, reg);
+		reg = dst;
+	}
+	return out;
+}
+
+void CodeGenerator::store(const Expr& at, const Value& target, const Value& source)
+{
+	if (failed)
+		return;
+	if (!target.assignable)
+	{
+		error(at, "assignment to something that isn't an l-value");
+		return;
+	}
+	Value src = source;
+	if (src.type.base != target.type.base)
+	{
+		bool allowed = src.type.base == TYPE_INT && target.type.base == TYPE_FLOAT;
+		if (!allowed)
+		{
+			error(at, "can't assign " + typeName(src.type) + " to " + typeName(target.type));
+			return;
+		}
+		src = convert(src, target.type.base);
+	}
+	if (src.regs.size() != target.regs.size())
+	{
+		error(at, "can't assign " + typeName(src.type) + " to " + typeName(target.type));
+		return;
+	}
+
+	// v.xy = v.yx needs the old values
+	for (size_t i = 0; i < src.regs.size(); i++)
+	{
+		for (size_t j = 0; j < target.regs.size(); j++)
+		{
+			if (i != j && src.regs[i] == target.regs[j])
+			{
+				src = copy(src);
+				i = src.regs.size();
+				break;
+			}
+		}
+	}
+
+	bool masked = needsMask();
+	for (size_t i = 0; i < src.regs.size(); i++)
+	{
+		if (src.regs[i] == target.regs[i])
+			continue;
+		if (masked)
+		{
+			emitRaw(SOFT_OP_MOVM, target.regs[i], src.regs[i]);
+			continue;
+		}
+		// write straight into the variable when the value is a temporary
+		// produced by a recent instruction nothing else reads
+		if (isTemporary(src.regs[i]))
+		{
+			int producer = -1;
+			for (int k = (int)code.size() - 1; k >= 0 && k >= (int)code.size() - 32; k--)
+			{
+				const Instr& instr = code[k];
+				if (instr.dst == src.regs[i] && instr.op != SOFT_OP_TEX && instr.op != SOFT_OP_TEXLOD &&
+					instr.op != SOFT_OP_KILL && instr.op != SOFT_OP_CLEAR)
+				{
+					producer = k;
+					break;
+				}
+				if (instr.op >= SOFT_OP_PUSH)
+					break;
+			}
+			bool clean = producer >= 0;
+			for (int k = producer + 1; clean && k < (int)code.size(); k++)
+			{
+				const Instr& instr = code[k];
+				if (instr.a == src.regs[i] || instr.b == src.regs[i] || instr.c == src.regs[i] ||
+					instr.a == target.regs[i] || instr.b == target.regs[i] || instr.c == target.regs[i] ||
+					instr.dst == target.regs[i] || instr.op == SOFT_OP_TEX || instr.op == SOFT_OP_TEXLOD)
+					clean = false;
+			}
+			// a later component may still read this register
+			for (size_t j = i + 1; clean && j < src.regs.size(); j++)
+			{
+				if (src.regs[j] == src.regs[i])
+					clean = false;
+			}
+			if (clean)
+			{
+				code[producer].dst = target.regs[i];
+				continue;
+			}
+		}
+		emitRaw(SOFT_OP_MOV, target.regs[i], src.regs[i]);
+	}
+}
+
+Value CodeGenerator::componentwise(SoftOp op, const Type& type, const vector<Value>& args, const vector<int>& broadcast)
+{
+	Value out;
+	out.type = type;
+	for (int i = 0; i < type.size(); i++)
+	{
+		int operands[3] = { -1, -1, -1 };
+		for (size_t k = 0; k < args.size() && k < 3; k++)
+		{
+			bool scalarArg = args[k].regs.size() == 1;
+			(void)broadcast;
+			operands[k] = args[k].regs[scalarArg ? 0 : i];
+		}
+		out.regs.push_back(emit(op, operands[0], operands[1], operands[2]));
+	}
+	return out;
+}
+
+int CodeGenerator::dot(const Value& a, const Value& b)
+{
+	int sum = emit(SOFT_OP_MUL, a.regs[0], b.regs[0]);
+	for (size_t i = 1; i < a.regs.size(); i++)
+		sum = emit(SOFT_OP_MADD, a.regs[i], b.regs[i], sum);
+	return sum;
+}
+
+Value CodeGenerator::unaryOp(const Expr& expr)
+{
+	Value a = value(*expr.args[0]);
+	if (failed)
+		return Value();
+	if (expr.text == "+")
+		return a;
+	if (expr.text == "-")
+	{
+		if (!a.type.isNumeric())
+		{
+			error(expr, "can't negate " + typeName(a.type));
+			return Value();
+		}
+		return componentwise(SOFT_OP_NEG, a.type, { a });
+	}
+	if (!(a.type.base == TYPE_BOOL && a.type.isScalar()))
+	{
+		error(expr, "! needs a bool");
+		return Value();
+	}
+	return componentwise(SOFT_OP_NOT, a.type, { a });
+}
+
+Value CodeGenerator::arithmetic(const Expr& at, const string& op, Value a, Value b)
+{
+	if (!a.type.isNumeric() || !b.type.isNumeric())
+	{
+		error(at, "operator " + op + " needs numbers, not " + typeName(a.type) + " and " + typeName(b.type));
+		return Value();
+	}
+	// int operands mix with float ones by implicit conversion
+	BaseType base = a.type.base == TYPE_FLOAT || b.type.base == TYPE_FLOAT ? TYPE_FLOAT : TYPE_INT;
+	a.type.base = base;
+	b.type.base = base;
+
+	if (op == "*" && !a.type.isScalar() && !b.type.isScalar() && (a.type.isMatrix() || b.type.isMatrix()))
+	{
+		Value out;
+		if (a.type.isMatrix() && b.type.isVector() && a.type.columns == b.type.rows)
+		{
+			// column-major: result[row] = sum over k of m[k][row] * v[k]
+			out.type = makeType(base, a.type.rows);
+			for (int row = 0; row < a.type.rows; row++)
+			{
+				int sum = emit(SOFT_OP_MUL, a.regs[row], b.regs[0]);
+				for (int k = 1; k < a.type.columns; k++)
+					sum = emit(SOFT_OP_MADD, a.regs[k * a.type.rows + row], b.regs[k], sum);
+				out.regs.push_back(sum);
+			}
+			return out;
+		}
+		if (a.type.isVector() && b.type.isMatrix() && a.type.rows == b.type.rows)
+		{
+			out.type = makeType(base, b.type.columns);
+			for (int column = 0; column < b.type.columns; column++)
+			{
+				Value col;
+				col.regs.assign(b.regs.begin() + column * b.type.rows, b.regs.begin() + (column + 1) * b.type.rows);
+				out.regs.push_back(dot(a, col));
+			}
+			return out;
+		}
+		if (a.type.isMatrix() && b.type.isMatrix() && a.type.columns == b.type.rows)
+		{
+			out.type = makeType(base, a.type.rows, b.type.columns);
+			for (int column = 0; column < b.type.columns; column++)
+			{
+				for (int row = 0; row < a.type.rows; row++)
+				{
+					int sum = emit(SOFT_OP_MUL, a.regs[row], b.regs[column * b.type.rows]);
+					for (int k = 1; k < a.type.columns; k++)
+						sum = emit(SOFT_OP_MADD, a.regs[k * a.type.rows + row], b.regs[column * b.type.rows + k], sum);
+					out.regs.push_back(sum);
+				}
+			}
+			return out;
+		}
+		error(at, "can't multiply " + typeName(a.type) + " by " + typeName(b.type));
+		return Value();
+	}
+
+	if (a.type.size() != b.type.size() && !a.type.isScalar() && !b.type.isScalar())
+	{
+		error(at, "operator " + op + " on " + typeName(a.type) + " and " + typeName(b.type));
+		return Value();
+	}
+	Type type = a.type.isScalar() ? b.type : a.type;
+	SoftOp code;
+	if (op == "+") code = SOFT_OP_ADD;
+	else if (op == "-") code = SOFT_OP_SUB;
+	else if (op == "*") code = SOFT_OP_MUL;
+	else if (op == "/") code = base == TYPE_INT ? SOFT_OP_IDIV : SOFT_OP_DIV;
+	else if (base == TYPE_INT) code = SOFT_OP_IMOD;
+	else
+	{
+		error(at, "% needs int operands");
+		return Value();
+	}
+	return componentwise(code, type, { a, b });
+}
+
+Value CodeGenerator::binaryOp(const Expr& expr)
+{
+	Value a = value(*expr.args[0]);
+	Value b = value(*expr.args[1]);
+	if (failed)
+		return Value();
+	const string& op = expr.text;
+
+	if (op == "&&" || op == "||" || op == "^^")
+	{
+		if (!(a.type == makeType(TYPE_BOOL) && b.type == makeType(TYPE_BOOL)))
+		{
+			error(expr, "operator " + op + " needs bools");
+			return Value();
+		}
+		SoftOp code = op == "&&" ? SOFT_OP_AND : op == "||" ? SOFT_OP_OR : SOFT_OP_XOR;
+		return scalar(emit(code, a.regs[0], b.regs[0]), TYPE_BOOL);
+	}
+	if (op == "==" || op == "!=")
+	{
+		if (a.regs.size() != b.regs.size() || a.regs.empty())
+		{
+			error(expr, "can't compare " + typeName(a.type) + " with " + typeName(b.type));
+			return Value();
+		}
+		bool equal = op == "==";
+		int result = -1;
+		for (size_t i = 0; i < a.regs.size(); i++)
+		{
+			int component = emit(equal ? SOFT_OP_EQ : SOFT_OP_NE, a.regs[i], b.regs[i]);
+			result = result < 0 ? component : emit(equal ? SOFT_OP_AND : SOFT_OP_OR, result, component);
+		}
+		return scalar(result, TYPE_BOOL);
+	}
+	if (op == "<" || op == ">" || op == "<=" || op == ">=")
+	{
+		if (!a.type.isScalar() || !b.type.isScalar() || !a.type.isNumeric() || !b.type.isNumeric())
+		{
+			error(expr, "operator " + op + " needs scalars, use lessThan() and friends for vectors");
+			return Value();
+		}
+		SoftOp code = op == "<" ? SOFT_OP_LT : op == ">" ? SOFT_OP_GT : op == "<=" ? SOFT_OP_LE : SOFT_OP_GE;
+		return scalar(emit(code, a.regs[0], b.regs[0]), TYPE_BOOL);
+	}
+	return arithmetic(expr, op, a, b);
+}
+
+Value CodeGenerator::assign(const Expr& expr)
+{
+	Value target = value(*expr.args[0]);
+	Value source = value(*expr.args[1]);
+	if (failed)
+		return Value();
+	if (expr.text != "=")
+	{
+		string op = expr.text.substr(0, 1);
+		Value current = target;
+		current.assignable = false;
+		source = arithmetic(expr, op, current, source);
+		if (failed)
+			return Value();
+		// v *= m keeps v's type
+		if (source.regs.size() != target.regs.size())
+		{
+			error(expr, "operator " + expr.text + " changes the type of its target");
+			return Value();
+		}
+	}
+	store(expr, target, source);
+	Value result = target;
+	result.assignable = false;
+	return result;
+}
+
+Value CodeGenerator::increment(const Expr& expr)
+{
+	Value target = value(*expr.args[0]);
+	if (failed)
+		return Value();
+	if (!target.type.isNumeric())
+	{
+		error(expr, expr.text + " needs a number");
+		return Value();
+	}
+	Value old = expr.kind == Expr::POSTFIX ? copy(target) : Value();
+	Value updated = componentwise(expr.text == "++" ? SOFT_OP_ADD : SOFT_OP_SUB, target.type, { target, scalar(constant(1.0f)) });
+	store(expr, target, updated);
+	if (expr.kind == Expr::POSTFIX)
+		return old;
+	target.assignable = false;
+	return target;
+}
+
+Value CodeGenerator::ternaryOp(const Expr& expr)
+{
+	Value c = value(*expr.args[0]);
+	Value a = value(*expr.args[1]);
+	Value b = value(*expr.args[2]);
+	if (failed)
+		return Value();
+	if (c.type != makeType(TYPE_BOOL))
+	{
+		error(expr, "?: needs a bool condition");
+		return Value();
+	}
+	if (a.type.base != b.type.base)
+	{
+		a = convert(a, TYPE_FLOAT);
+		b = convert(b, TYPE_FLOAT);
+	}
+	if (a.regs.size() != b.regs.size())
+	{
+		error(expr, "?: branches have different types");
+		return Value();
+	}
+	Value out;
+	out.type = a.type;
+	for (size_t i = 0; i < a.regs.size(); i++)
+		out.regs.push_back(emit(SOFT_OP_SELECT, c.regs[0], a.regs[i], b.regs[i]));
+	return out;
+}
+
+Value CodeGenerator::call(const Expr& expr)
+{
+	vector<Value> args;
+	for (const auto& arg : expr.args)
+	{
+		args.push_back(value(*arg));
+		if (failed)
+			return Value();
+	}
+
+	Type type;
+	if (lookupType(expr.text, type))
+		return construct(expr, type, args);
+
+	Value result;
+	if (builtin(expr, args, result))
+		return result;
+	return userCall(expr, args);
+}
+
+Value CodeGenerator::construct(const Expr& expr, const Type& type, const vector<Value>& args)
+{
+	if (type.base == TYPE_VOID || type.base == TYPE_SAMPLER || args.empty())
+	{
+		error(expr, "bad constructor " + typeName(type));
+		return Value();
+	}
+	vector<int> components;
+	for (const Value& arg : args)
+	{
+		Value converted = convert(arg, type.base);
+		components.insert(components.end(), converted.regs.begin(), converted.regs.end());
+	}
+
+	Value out;
+	out.type = type;
+	if (type.isMatrix())
+	{
+		if (args.size() == 1 && args[0].type.isScalar())
+		{
+			// diagonal
+			for (int column = 0; column < type.columns; column++)
+				for (int row = 0; row < type.rows; row++)
+					out.regs.push_back(row == column ? components[0] : constant(0.0f));
+			return out;
+		}
+		if (args.size() == 1 && args[0].type.isMatrix())
+		{
+			const Type& from = args[0].type;
+			for (int column = 0; column < type.columns; column++)
+			{
+				for (int row = 0; row < type.rows; row++)
+				{
+					if (column < from.columns && row < from.rows)
+						out.regs.push_back(components[column * from.rows + row]);
+					else
+						out.regs.push_back(constant(row == column ? 1.0f : 0.0f));
+				}
+			}
+			return out;
+		}
+		if ((int)components.size() != type.size())
+		{
+			error(expr, "wrong number of components for " + typeName(type));
+			return Value();
+		}
+		out.regs = components;
+		return out;
+	}
+
+	if (args.size() == 1 && args[0].type.isScalar())
+	{
+		out.regs.assign(type.size(), components[0]);
+		return out;
+	}
+	if ((int)components.size() < type.size() || (args.size() > 1 && (int)(components.size() - args.back().regs.size()) >= type.size()))
+	{
+		error(expr, "wrong number of components for " + typeName(type));
+		return Value();
+	}
+	out.regs.assign(components.begin(), components.begin() + type.size());
+	return out;
+}
+
+bool CodeGenerator::builtin(const Expr& expr, const vector<Value>& args, Value& result)
+{
+	const string& name = expr.text;
+	size_t count = args.size();
+	auto arity = [&](size_t n) {
+		if (count != n)
+			error(expr, name + " takes " + to_string(n) + " arguments");
+		return !failed;
+	};
+	auto floats = [&](vector<Value> values) {
+		for (Value& v : values)
+			v = convert(v, TYPE_FLOAT);
+		return values;
+	};
+
+	static const struct { const char* name; SoftOp op; int arguments; } simple[] = {
+		{ "sin", SOFT_OP_SIN, 1 }, { "cos", SOFT_OP_COS, 1 }, { "tan", SOFT_OP_TAN, 1 },
+		{ "asin", SOFT_OP_ASIN, 1 }, { "acos", SOFT_OP_ACOS, 1 },
+		{ "exp", SOFT_OP_EXP, 1 }, { "log", SOFT_OP_LOG, 1 }, { "exp2", SOFT_OP_EXP2, 1 }, { "log2", SOFT_OP_LOG2, 1 },
+		{ "sqrt", SOFT_OP_SQRT, 1 }, { "inversesqrt", SOFT_OP_RSQRT, 1 },
+		{ "abs", SOFT_OP_ABS, 1 }, { "sign", SOFT_OP_SIGN, 1 }, { "floor", SOFT_OP_FLOOR, 1 }, { "ceil", SOFT_OP_CEIL, 1 },
+		{ "fract", SOFT_OP_FRACT, 1 }, { "trunc", SOFT_OP_TRUNC, 1 }, { "round", SOFT_OP_ROUND, 1 }, { "roundEven", SOFT_OP_ROUND, 1 },
+		{ "pow", SOFT_OP_POW, 2 }, { "mod", SOFT_OP_MOD, 2 }, { "min", SOFT_OP_MIN, 2 }, { "max", SOFT_OP_MAX, 2 },
+		{ "step", SOFT_OP_STEP, 2 }, { "clamp", SOFT_OP_CLAMP, 3 }, { "mix", SOFT_OP_MIX, 3 }, { "smoothstep", SOFT_OP_SMOOTHSTEP, 3 },
+		{ "dFdx", SOFT_OP_DFDX, 1 }, { "dFdy", SOFT_OP_DFDY, 1 },
+	};
+	for (const auto& entry : simple)
+	{
+		if (name != entry.name)
+			continue;
+		if (!arity(entry.arguments))
+			return true;
+		if ((entry.op == SOFT_OP_DFDX || entry.op == SOFT_OP_DFDY) && stage != SOFT_FRAGMENT_SHADER)
+		{
+			error(expr, name + " is only available in fragment shaders");
+			return true;
+		}
+		// the widest argument sets the type, scalars broadcast
+		Type type = args[0].type;
+		for (const Value& arg : args)
+		{
+			if (arg.type.size() > type.size())
+				type = arg.type;
+		}
+		for (const Value& arg : args)
+		{
+			if (!arg.type.isNumeric() || (arg.type.size() != type.size() && !arg.type.isScalar()))
+			{
+				error(expr, "bad arguments to " + name);
+				return true;
+			}
+		}
+		bool keepInt = type.base == TYPE_INT && (entry.op == SOFT_OP_MIN || entry.op == SOFT_OP_MAX ||
+			entry.op == SOFT_OP_ABS || entry.op == SOFT_OP_SIGN || entry.op == SOFT_OP_CLAMP);
+		if (!keepInt)
+			type.base = TYPE_FLOAT;
+		result = componentwise(entry.op, type, keepInt ? args : floats(args));
+		return true;
+	}
+
+	if (name == "atan")
+	{
+		if (count == 1)
+			result = componentwise(SOFT_OP_ATAN, makeType(TYPE_FLOAT, args[0].type.rows), floats(args));
+		else if (arity(2))
+			result = componentwise(SOFT_OP_ATAN2, makeType(TYPE_FLOAT, args[0].type.rows), floats(args));
+		return true;
+	}
+	if (name == "radians" || name == "degrees")
+	{
+		if (arity(1))
+		{
+			float scale = name == "radians" ? 3.14159265f / 180.0f : 180.0f / 3.14159265f;
+			result = componentwise(SOFT_OP_MUL, makeType(TYPE_FLOAT, args[0].type.rows), { convert(args[0], TYPE_FLOAT), scalar(constant(scale)) });
+		}
+		return true;
+	}
+	if (name == "dot" || name == "length" || name == "distance" || name == "normalize")
+	{
+		vector<Value> v = floats(args);
+		if (!arity(name == "dot" || name == "distance" ? 2 : 1))
+			return true;
+		if (v.size() == 2 && v[0].regs.size() != v[1].regs.size())
+		{
+			error(expr, "bad arguments to " + name);
+			return true;
+		}
+		if (name == "dot")
+		{
+			result = scalar(dot(v[0], v[1]));
+			return true;
+		}
+		Value x = v[0];
+		if (name == "distance")
+			x = componentwise(SOFT_OP_SUB, v[0].type, v);
+		int squared = dot(x, x);
+		if (name == "normalize")
+			result = componentwise(SOFT_OP_MUL, x.type, { x, scalar(emit(SOFT_OP_RSQRT, squared)) });
+		else
+			result = scalar(emit(SOFT_OP_SQRT, squared));
+		return true;
+	}
+	if (name == "cross")
+	{
+		vector<Value> v = floats(args);
+		if (!arity(2))
+			return true;
+		if (v[0].type.rows != 3 || v[1].type.rows != 3)
+		{
+			error(expr, "cross needs vec3 arguments");
+			return true;
+		}
+		const vector<int>& a = v[0].regs;
+		const vector<int>& b = v[1].regs;
+		result.type = makeType(TYPE_FLOAT, 3);
+		for (int i = 0; i < 3; i++)
+		{
+			int j = (i + 1) % 3, k = (i + 2) % 3;
+			result.regs.push_back(emit(SOFT_OP_SUB, emit(SOFT_OP_MUL, a[j], b[k]), emit(SOFT_OP_MUL, a[k], b[j])));
+		}
+		return true;
+	}
+	if (name == "reflect")
+	{
+		vector<Value> v = floats(args);
+		if (!arity(2))
+			return true;
+		// I - 2 * dot(N, I) * N
+		int d = emit(SOFT_OP_MUL, dot(v[1], v[0]), constant(2.0f));
+		result = componentwise(SOFT_OP_SUB, v[0].type, { v[0], componentwise(SOFT_OP_MUL, v[1].type, { v[1], scalar(d) }) });
+		return true;
+	}
+	if (name == "fwidth")
+	{
+		if (!arity(1))
+			return true;
+		Value x = convert(args[0], TYPE_FLOAT);
+		Value dx = componentwise(SOFT_OP_ABS, x.type, { componentwise(SOFT_OP_DFDX, x.type, { x }) });
+		Value dy = componentwise(SOFT_OP_ABS, x.type, { componentwise(SOFT_OP_DFDY, x.type, { x }) });
+		result = componentwise(SOFT_OP_ADD, x.type, { dx, dy });
+		return true;
+	}
+	static const struct { const char* name; SoftOp op; } comparisons[] = {
+		{ "lessThan", SOFT_OP_LT }, { "lessThanEqual", SOFT_OP_LE }, { "greaterThan", SOFT_OP_GT },
+		{ "greaterThanEqual", SOFT_OP_GE }, { "equal", SOFT_OP_EQ }, { "notEqual", SOFT_OP_NE },
+	};
+	for (const auto& entry : comparisons)
+	{
+		if (name != entry.name)
+			continue;
+		if (arity(2))
+			result = componentwise(entry.op, makeType(TYPE_BOOL, args[0].type.rows), args);
+		return true;
+	}
+	if (name == "any" || name == "all" || name == "not")
+	{
+		if (!arity(1))
+			return true;
+		if (name == "not")
+		{
+			result = componentwise(SOFT_OP_NOT, args[0].type, args);
+			return true;
+		}
+		int r = args[0].regs[0];
+		for (size_t i = 1; i < args[0].regs.size(); i++)
+			r = emit(name == "any" ? SOFT_OP_OR : SOFT_OP_AND, r, args[0].regs[i]);
+		result = scalar(r, TYPE_BOOL);
+		return true;
+	}
+	if (name == "transpose" || name == "matrixCompMult")
+	{
+		if (!arity(name == "transpose" ? 1 : 2))
+			return true;
+		const Type& m = args[0].type;
+		if (name == "matrixCompMult")
+		{
+			result = componentwise(SOFT_OP_MUL, m, args);
+			return true;
+		}
+		result.type = makeType(TYPE_FLOAT, m.columns, m.rows);
+		for (int column = 0; column < m.rows; column++)
+			for (int row = 0; row < m.columns; row++)
+				result.regs.push_back(args[0].regs[row * m.rows + column]);
+		return true;
+	}
+	if (name == "texture" || name == "texture2D" || name == "textureLod")
+	{
+		bool lod = name == "textureLod";
+		if (!arity(lod ? 3 : 2))
+			return true;
+		if (args[0].sampler < 0 || args[1].type.rows != 2)
+		{
+			error(expr, name + " needs a sampler2D and a vec2");
+			return true;
+		}
+		int dst = allocate(4);
+		int lodReg = lod ? args[2].regs[0] : (stage == SOFT_VERTEX_SHADER ? constant(0.0f) : -1);
+		emitRaw(lodReg >= 0 ? SOFT_OP_TEXLOD : SOFT_OP_TEX, dst, args[1].regs[0], args[1].regs[1], lodReg, args[0].sampler);
+		result.type = makeType(TYPE_FLOAT, 4);
+		result.regs = { dst, dst + 1, dst + 2, dst + 3 };
+		return true;
+	}
+	return false;
+}
+
+Value CodeGenerator::userCall(const Expr& expr, vector<Value>& args)
+{
+	// exact parameter types first, then allowing int -> float
+	const Function* function = nullptr;
+	for (int pass = 0; pass < 2 && !function; pass++)
+	{
+		for (const auto& candidate : module.functions)
+		{
+			if (candidate->name != expr.text || candidate->params.size() != args.size())
+				continue;
+			bool match = true;
+			for (size_t i = 0; i < args.size() && match; i++)
+			{
+				const Type& want = candidate->params[i].type;
+				const Type& have = args[i].type;
+				match = want == have || (pass == 1 && want.base == TYPE_FLOAT && have.base == TYPE_INT &&
+					want.rows == have.rows && want.columns == have.columns);
+			}
+			if (match)
+			{
+				function = candidate.get();
+				break;
+			}
+		}
+	}
+	if (!function)
+	{
+		error(expr, "no matching function " + expr.text + "()");
+		return Value();
+	}
+	if (++callDepth > 32)
+	{
+		error(expr, "calls nested too deeply, recursion isn't allowed");
+		return Value();
+	}
+
+	FunctionContext context;
+	context.function = function;
+	context.entryDepth = maskDepth;
+	context.result.clear();
+	int resultReg = allocate(function->returnType.size());
+	for (int i = 0; i < function->returnType.size(); i++)
+		context.result.push_back(resultReg + i);
+
+	// parameters are local copies, inlined into the caller
+	vector<map<string, Variable>> callerScopes;
+	callerScopes.swap(scopes);
+	scopes.push_back(callerScopes.front());		// globals
+	pushScope();
+	vector<Variable> params;
+	for (size_t i = 0; i < args.size(); i++)
+	{
+		const Parameter& param = function->params[i];
+		if (param.type.base == TYPE_SAMPLER)
+		{
+			Variable& variable = scopes.back()[param.name];
+			variable.type = param.type;
+			variable.assignable = false;
+			variable.sampler = args[i].sampler;
+			params.push_back(variable);
+			continue;
+		}
+		Variable& variable = declare(param.name, param.type);
+		if (param.in)
+		{
+			Value source = convert(args[i], param.type.base);
+			for (size_t c = 0; c < variable.regs.size(); c++)
+				emitRaw(SOFT_OP_MOV, variable.regs[c], source.regs[c]);
+		}
+		params.push_back(variable);
+	}
+
+	if (function->divergentReturn)
+	{
+		context.returnReg = allocate(1);
+		emitRaw(SOFT_OP_CLEAR, context.returnReg);
+		emitRaw(SOFT_OP_PUSH, -1);
+	}
+	functions.push_back(context);
+	int outerMark = statementMark;
+	statement(*function->body);
+	statementMark = outerMark;
+	functions.pop_back();
+	if (function->divergentReturn)
+	{
+		emitRaw(SOFT_OP_POP, -1);
+		if (discardReg >= 0)
+			emitRaw(SOFT_OP_EXEC_ANDNOT, -1, discardReg);
+		if (!functions.empty() && !functions.back().loops.empty())
+		{
+			// lanes that broke out of the caller's loop before the call stay off
+			const Loop& loop = functions.back().loops.back();
+			if (loop.breakReg >= 0)
+				emitRaw(SOFT_OP_EXEC_ANDNOT, -1, loop.breakReg);
+			if (loop.continueReg >= 0)
+				emitRaw(SOFT_OP_EXEC_ANDNOT, -1, loop.continueReg);
+		}
+		if (!functions.empty() && functions.back().returnReg >= 0)
+			emitRaw(SOFT_OP_EXEC_ANDNOT, -1, functions.back().returnReg);
+	}
+	scopes.swap(callerScopes);
+	callDepth--;
+
+	// out and inout parameters are copied back
+	for (size_t i = 0; i < args.size() && !failed; i++)
+	{
+		if (!function->params[i].out)
+			continue;
+		Value source;
+		source.type = params[i].type;
+		source.regs = params[i].regs;
+		store(*expr.args[i], args[i], source);
+	}
+
+	Value result;
+	result.type = function->returnType;
+	result.regs = context.result;
+	return result;
+}
+
+}
+
+bool SoftShader::compile(SoftShaderStage shaderStage, const string& source, string* log)
+{
+	string messages;
+	vector<Token> tokens;
+	Preprocessor preprocessor(messages);
+	bool ok = preprocessor.run(source, tokens);
+
+	Module module;
+	if (ok)
+	{
+		Parser parser(tokens, messages);
+		ok = parser.parse(module);
+	}
+
+	*this = SoftShader();
+	if (ok)
+	{
+		CodeGenerator generator(shaderStage, module, *this, messages);
+		ok = generator.generate(tokens);
+	}
+	if (log)
+		*log = messages;
+	return ok;
+}
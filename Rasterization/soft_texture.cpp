@@ -0,0 +1,227 @@
+#include "soft_texture.h"
+
+#include <algorithm>
+#include <cmath>
+
+using namespace std;
+
+// bits 0-2 of a to bits 0, 2 and 4
+static inline int spreadBits(int a)
+{
+	return (a & 1) | ((a & 2) << 1) | ((a & 4) << 2);
+}
+
+static SIMD_INLINE vec8i spreadBits(vec8i a)
+{
+	return (a & vec8i(1)) | shiftLeft<1>(a & vec8i(2)) | shiftLeft<2>(a & vec8i(4));
+}
+
+// after taking the fraction of s a repeating coordinate is in [-1, size]
+static SIMD_INLINE vec8i wrapCoordinate(vec8i x, vec8i size, SoftTextureWrap wrap)
+{
+	if (wrap == SOFT_WRAP_REPEAT)
+		return select(x < vec8i::zero(), x + size, select(x < size, x, x - size));
+	return min(max(x, vec8i::zero()), size - vec8i(1));
+}
+
+static SIMD_INLINE vec8i texelAddress(vec8i x, vec8i y, vec8i pitch, vec8i offset, SoftTextureLayout layout)
+{
+	if (layout == SOFT_TEXTURE_LINEAR)
+		return offset + y * pitch + x;
+	vec8i tile = shiftRight<3>(y) * pitch + shiftRight<3>(x);
+	return offset + shiftLeft<6>(tile) + (spreadBits(x & vec8i(7)) | shiftLeft<1>(spreadBits(y & vec8i(7))));
+}
+
+template<int shift>
+static SIMD_INLINE vec8f channel(vec8i texels)
+{
+	return toFloat(shiftRight<shift>(texels) & vec8i(0xff));
+}
+
+template<int shift>
+static SIMD_INLINE vec8f bilinear(vec8i c00, vec8i c10, vec8i c01, vec8i c11, vec8f fx, vec8f fy)
+{
+	vec8f bottom = lerp(channel<shift>(c00), channel<shift>(c10), fx);
+	vec8f top = lerp(channel<shift>(c01), channel<shift>(c11), fx);
+	return lerp(bottom, top, fy) * vec8f(1.0f / 255.0f);
+}
+
+size_t SoftTexture::address(const Level& level, int x, int y, SoftTextureLayout layout)
+{
+	if (layout == SOFT_TEXTURE_LINEAR)
+		return (size_t)level.offset + (size_t)y * level.pitch + x;
+	size_t tile = (size_t)(y / SOFT_TEXTURE_TILE_SIZE) * level.pitch + x / SOFT_TEXTURE_TILE_SIZE;
+	return (size_t)level.offset + tile * SOFT_TEXTURE_TILE_SIZE * SOFT_TEXTURE_TILE_SIZE
+		+ (spreadBits(x % SOFT_TEXTURE_TILE_SIZE) | (spreadBits(y % SOFT_TEXTURE_TILE_SIZE) << 1));
+}
+
+void SoftTexture::load(int w, int h, const uint32_t* rgba, SoftTextureLayout textureLayout)
+{
+	layout = textureLayout;
+	levels.clear();
+	size_t total = 0;
+	for (int lw = w, lh = h; ; lw = max(1, lw / 2), lh = max(1, lh / 2))
+	{
+		Level level;
+		level.width = lw;
+		level.height = lh;
+		level.offset = (int32_t)total;
+		if (layout == SOFT_TEXTURE_LINEAR)
+		{
+			level.pitch = lw;
+			total += (size_t)lw * lh;
+		}
+		else
+		{
+			int tilesX = (lw + SOFT_TEXTURE_TILE_SIZE - 1) / SOFT_TEXTURE_TILE_SIZE;
+			int tilesY = (lh + SOFT_TEXTURE_TILE_SIZE - 1) / SOFT_TEXTURE_TILE_SIZE;
+			level.pitch = tilesX;
+			total += (size_t)tilesX * tilesY * SOFT_TEXTURE_TILE_SIZE * SOFT_TEXTURE_TILE_SIZE;
+		}
+		levels.push_back(level);
+		if ((lw == 1 && lh == 1) || levels.size() == SOFT_MAX_MIP_LEVELS)
+			break;
+	}
+	texels.assign(total, 0);
+
+	vector<uint32_t> image(rgba, rgba + (size_t)w * h), smaller;
+	for (size_t i = 0; i < levels.size(); i++)
+	{
+		const Level& level = levels[i];
+		for (int y = 0; y < level.height; y++)
+		{
+			for (int x = 0; x < level.width; x++)
+				texels[address(level, x, y)] = image[(size_t)y * level.width + x];
+		}
+		if (i + 1 == levels.size())
+			break;
+
+		// 2x2 box filter, rounded; an odd last row or column is used twice
+		const Level& next = levels[i + 1];
+		smaller.resize((size_t)next.width * next.height);
+		for (int y = 0; y < next.height; y++)
+		{
+			const uint32_t* row0 = &image[(size_t)min(2 * y, level.height - 1) * level.width];
+			const uint32_t* row1 = &image[(size_t)min(2 * y + 1, level.height - 1) * level.width];
+			for (int x = 0; x < next.width; x++)
+			{
+				int x0 = min(2 * x, level.width - 1), x1 = min(2 * x + 1, level.width - 1);
+				uint32_t packed = 0;
+				for (int shift = 0; shift < 32; shift += 8)
+				{
+					uint32_t sum = ((row0[x0] >> shift) & 0xff) + ((row0[x1] >> shift) & 0xff)
+						+ ((row1[x0] >> shift) & 0xff) + ((row1[x1] >> shift) & 0xff);
+					packed |= ((sum + 2) >> 2) << shift;
+				}
+				smaller[(size_t)y * next.width + x] = packed;
+			}
+		}
+		image.swap(smaller);
+	}
+}
+
+// log2 of the larger of the two texel-space derivative lengths, taken from
+// the top left pixel of each quad like dFdxCoarse
+vec8f SoftTexture::quadLod(const vec8f& s, const vec8f& t) const
+{
+	alignas(32) float sv[8], tv[8];
+	s.store(sv);
+	t.store(tv);
+	const float w = (float)levels[0].width, h = (float)levels[0].height;
+	float rho2[2];
+	for (int quad = 0; quad < 2; quad++)
+	{
+		int i = quad * 2;
+		float dsdx = (sv[i + 1] - sv[i]) * w, dtdx = (tv[i + 1] - tv[i]) * h;
+		float dsdy = (sv[i + 4] - sv[i]) * w, dtdy = (tv[i + 4] - tv[i]) * h;
+		rho2[quad] = max(dsdx * dsdx + dtdx * dtdx, dsdy * dsdy + dtdy * dtdy);
+	}
+	// log2 of the squared length is twice the LOD, which saves the sqrt
+	vec8f r(rho2[0], rho2[0], rho2[1], rho2[1], rho2[0], rho2[0], rho2[1], rho2[1]);
+	return log2(r) * vec8f(0.5f);
+}
+
+void SoftTexture::filterLevel(vec8i level, const vec8f& s, const vec8f& t, bool linear, vec8f rgba[4])
+{
+	// the lanes of the two quads can be in different levels, so each lane
+	// gathers its level's size and position
+	const int32_t* table = (const int32_t*)levels.data();
+	vec8i entry = shiftLeft<2>(level);
+	vec8i w = gather(table, entry), h = gather(table, entry + vec8i(1));
+	vec8i pitch = gather(table, entry + vec8i(2)), offset = gather(table, entry + vec8i(3));
+	vec8f fw = toFloat(w), fh = toFloat(h);
+
+	// repeat keeps the fraction, clamp only has to keep the integers in
+	// range; either way a NaN coordinate ends up inside the texture
+	vec8f u = (wrapS == SOFT_WRAP_REPEAT ? max(s - floor(s), vec8f::zero()) : clamp(s, vec8f(-1.0f), vec8f(2.0f))) * fw;
+	vec8f v = (wrapT == SOFT_WRAP_REPEAT ? max(t - floor(t), vec8f::zero()) : clamp(t, vec8f(-1.0f), vec8f(2.0f))) * fh;
+	const int32_t* base = (const int32_t*)texels.data();
+
+	if (!linear)
+	{
+		vec8i x = wrapCoordinate(toIntTruncate(floor(u)), w, wrapS);
+		vec8i y = wrapCoordinate(toIntTruncate(floor(v)), h, wrapT);
+		vec8i c = gather(base, texelAddress(x, y, pitch, offset, layout));
+		rgba[0] = channel<0>(c) * vec8f(1.0f / 255.0f);
+		rgba[1] = channel<8>(c) * vec8f(1.0f / 255.0f);
+		rgba[2] = channel<16>(c) * vec8f(1.0f / 255.0f);
+		rgba[3] = channel<24>(c) * vec8f(1.0f / 255.0f);
+		fetches += 8;
+		return;
+	}
+
+	u = u - vec8f(0.5f);
+	v = v - vec8f(0.5f);
+	vec8f fu = floor(u), fv = floor(v);
+	vec8f fx = u - fu, fy = v - fv;
+	vec8i x = toIntTruncate(fu), y = toIntTruncate(fv);
+	vec8i x0 = wrapCoordinate(x, w, wrapS), x1 = wrapCoordinate(x + vec8i(1), w, wrapS);
+	vec8i y0 = wrapCoordinate(y, h, wrapT), y1 = wrapCoordinate(y + vec8i(1), h, wrapT);
+
+	vec8i c00 = gather(base, texelAddress(x0, y0, pitch, offset, layout));
+	vec8i c10 = gather(base, texelAddress(x1, y0, pitch, offset, layout));
+	vec8i c01 = gather(base, texelAddress(x0, y1, pitch, offset, layout));
+	vec8i c11 = gather(base, texelAddress(x1, y1, pitch, offset, layout));
+	rgba[0] = bilinear<0>(c00, c10, c01, c11, fx, fy);
+	rgba[1] = bilinear<8>(c00, c10, c01, c11, fx, fy);
+	rgba[2] = bilinear<16>(c00, c10, c01, c11, fx, fy);
+	rgba[3] = bilinear<24>(c00, c10, c01, c11, fx, fy);
+	fetches += 32;
+}
+
+void SoftTexture::sample(const vec8f& s, const vec8f& t, const vec8f* lod, vec8f rgba[4])
+{
+	if (levels.empty())
+	{
+		rgba[0] = rgba[1] = rgba[2] = vec8f::zero();
+		rgba[3] = vec8f(1.0f);
+		return;
+	}
+	if (filter != SOFT_FILTER_TRILINEAR)
+	{
+		filterLevel(vec8i::zero(), s, t, filter == SOFT_FILTER_BILINEAR, rgba);
+		return;
+	}
+
+	// a LOD at or below 0 is magnification, where GL_LINEAR on the base
+	// level is the same as the trilinear blend with weight 0
+	const int lastLevel = (int)levels.size() - 1;
+	vec8f l = clamp(lod ? *lod : quadLod(s, t), vec8f::zero(), vec8f((float)lastLevel));
+	vec8i level = toIntTruncate(l);
+	vec8f weight = l - toFloat(level);
+	filterLevel(level, s, t, true, rgba);
+	if (movemask(weight > vec8f::zero()) == 0)
+		return;
+
+	vec8f next[4];
+	filterLevel(min(level + vec8i(1), vec8i(lastLevel)), s, t, true, next);
+	for (int c = 0; c < 4; c++)
+		rgba[c] = lerp(rgba[c], next[c], weight);
+}
+
+uint64_t SoftTexture::takeFetchCount()
+{
+	uint64_t count = fetches;
+	fetches = 0;
+	return count;
+}
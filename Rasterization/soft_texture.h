@@ -0,0 +1,87 @@
+#ifndef SOFT_TEXTURE_H
+#define SOFT_TEXTURE_H
+
+#include <cstdint>
+#include <vector>
+
+#include "simd.h"
+#include "soft_shader.h"
+
+// 8x8 texel tiles in Z-order: each 4x4 quarter is one 64 byte cache line,
+// so a bilinear footprint, and the 2x2 quads around it, usually stay
+// inside one or two lines whatever direction the screen walks the texture
+const int SOFT_TEXTURE_TILE_SIZE = 8;
+const int SOFT_MAX_MIP_LEVELS = 16;
+
+enum SoftTextureFilter
+{
+	SOFT_FILTER_NEAREST,		// GL_NEAREST, base level only
+	SOFT_FILTER_BILINEAR,		// GL_LINEAR, base level only
+	SOFT_FILTER_TRILINEAR,		// GL_LINEAR_MIPMAP_LINEAR, GL_LINEAR when magnified
+};
+
+enum SoftTextureWrap
+{
+	SOFT_WRAP_REPEAT,
+	SOFT_WRAP_CLAMP,			// GL_CLAMP_TO_EDGE
+};
+
+enum SoftTextureLayout
+{
+	SOFT_TEXTURE_MORTON,		// Z-order tiles, the default
+	SOFT_TEXTURE_LINEAR,		// plain rows, for comparison
+};
+
+// RGBA8 2D texture for the CPU shaders. load() builds the whole mip chain
+// with a 2x2 box filter like glGenerateMipmap; sample() filters 8 lanes at
+// once with gathers. For texture() in a fragment shader the LOD comes from
+// the derivatives of s and t across each 2x2 quad, one LOD per quad like
+// the hardware.
+class SoftTexture : public SoftSampler
+{
+public:
+	// width * height texels, rows bottom-up like glTexImage2D, packed like
+	// packRGBA8()
+	void load(int width, int height, const uint32_t* rgba, SoftTextureLayout layout = SOFT_TEXTURE_MORTON);
+
+	void setFilter(SoftTextureFilter f) { filter = f; }
+	void setWrap(SoftTextureWrap s, SoftTextureWrap t) { wrapS = s; wrapT = t; }
+
+	int levelCount() const { return (int)levels.size(); }
+	int width(int level = 0) const { return levels[level].width; }
+	int height(int level = 0) const { return levels[level].height; }
+	uint32_t texel(int level, int x, int y) const { return texels[address(levels[level], x, y)]; }
+	size_t memoryBytes() const { return texels.size() * sizeof(uint32_t); }
+
+	void sample(const vec8f& s, const vec8f& t, const vec8f* lod, vec8f rgba[4]) override;
+
+	// texels read by sample() since the last call, 4 per bilinear lane
+	uint64_t takeFetchCount();
+
+private:
+	struct Level
+	{
+		int32_t width;
+		int32_t height;
+		int32_t pitch;		// tiles per row, or texels per row when linear
+		int32_t offset;		// first texel in texels
+	};
+
+	static size_t address(const Level& level, int x, int y, SoftTextureLayout layout);
+	size_t address(const Level& level, int x, int y) const { return address(level, x, y, layout); }
+
+	vec8f quadLod(const vec8f& s, const vec8f& t) const;
+	// one bilinear (or nearest) lookup per lane in the lanes' own level
+	void filterLevel(vec8i level, const vec8f& s, const vec8f& t, bool linear, vec8f rgba[4]);
+
+	SoftTextureLayout layout = SOFT_TEXTURE_MORTON;
+	SoftTextureFilter filter = SOFT_FILTER_TRILINEAR;
+	SoftTextureWrap wrapS = SOFT_WRAP_REPEAT;
+	SoftTextureWrap wrapT = SOFT_WRAP_REPEAT;
+
+	std::vector<Level> levels;
+	std::vector<uint32_t> texels;
+	uint64_t fetches = 0;
+};
+
+#endif
@@ -0,0 +1,40 @@
+#include "spirv_modules.h"
+
+// generated into $(IntDir)spirv by the custom build step on each shader
+#include "spirv/triangle.vert.spv.h"
+#include "spirv/triangle.frag.spv.h"
+
+#define SPIRV_MODULE(path, words) { path, words, sizeof(words) / sizeof(words[0]) }
+
+static const SpirvModule modules[] = {
+	SPIRV_MODULE("shaders/triangle.vert", triangle_vert_spv),
+	SPIRV_MODULE("shaders/triangle.frag", triangle_frag_spv),
+};
+
+const SpirvModule* findSpirvModule(const std::string& path)
+{
+	for (const SpirvModule& module : modules)
+	{
+		if (path == module.path)
+			return &module;
+	}
+	return nullptr;
+}
+
+bool spirvDeclaresSpecId(const uint32_t* words, size_t wordCount, unsigned int id)
+{
+	const uint32_t OP_DECORATE = 71;
+	const uint32_t DECORATION_SPEC_ID = 1;
+	// after the 5 word header every instruction starts with its word count
+	// in the high half and its opcode in the low half
+	for (size_t i = 5; i < wordCount;)
+	{
+		uint32_t length = words[i] >> 16, opcode = words[i] & 0xffff;
+		if (length == 0 || i + length > wordCount)
+			break;
+		if (opcode == OP_DECORATE && length >= 4 && words[i + 2] == DECORATION_SPEC_ID && words[i + 3] == id)
+			return true;
+		i += length;
+	}
+	return false;
+}
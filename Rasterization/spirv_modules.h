@@ -0,0 +1,26 @@
+#ifndef SPIRV_MODULES_H
+#define SPIRV_MODULES_H
+
+#include <cstddef>
+#include <cstdint>
+#include <string>
+
+// SPIR-V compiled from shaders/ by the glslangValidator build step and
+// embedded into the executable. Only the base permutation (no feature
+// defines) is precompiled, the rest come from GLSL source at runtime.
+struct SpirvModule
+{
+	const char* path;
+	const uint32_t* words;
+	size_t wordCount;
+};
+
+// look a module up by the path the GLSL source is loaded from, null if none
+const SpirvModule* findSpirvModule(const std::string& path);
+
+// whether the module decorates a specialization constant with SpecId id.
+// glSpecializeShader fails on an ID the module doesn't have, so a program's
+// constants are only passed to the stages that declare them.
+bool spirvDeclaresSpecId(const uint32_t* words, size_t wordCount, unsigned int id);
+
+#endif
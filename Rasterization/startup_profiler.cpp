@@ -0,0 +1,43 @@
+#include "startup_profiler.h"
+#include "gl_loader.h"
+
+#include <iomanip>
+#include <iostream>
+
+using namespace std;
+
+StartupProfiler::StartupProfiler()
+	: start(Clock::now()), last(start)
+{
+	phases.reserve(16);
+}
+
+void StartupProfiler::mark(const char* phase)
+{
+	Clock::time_point now = Clock::now();
+	phases.push_back({ phase, chrono::duration<double, milli>(now - last).count() });
+	last = now;
+}
+
+double StartupProfiler::totalMilliseconds() const
+{
+	return chrono::duration<double, milli>(last - start).count();
+}
+
+void StartupProfiler::report(const char* title) const
+{
+	double total = totalMilliseconds();
+	cout << title << ": " << total << " ms to the first frame" << endl;
+	for (const Phase& phase : phases)
+	{
+		cout << "  " << left << setw(22) << phase.name << right << setw(10) << fixed << setprecision(2)
+			<< phase.milliseconds << " ms " << setw(5) << setprecision(1) << (total > 0.0 ? 100.0 * phase.milliseconds / total : 0.0)
+			<< "%" << endl;
+	}
+	cout.unsetf(ios::fixed);
+	cout << setprecision(6);
+
+	GLLoaderStats loader = glLoaderStats();
+	cout << "  GL functions looked up: " << loader.resolved << " of " << loader.functions << ", "
+		<< loader.resolveMilliseconds << " ms" << endl;
+}
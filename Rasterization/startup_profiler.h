@@ -0,0 +1,39 @@
+#ifndef STARTUP_PROFILER_H
+#define STARTUP_PROFILER_H
+
+#include <chrono>
+#include <vector>
+
+// Wall-clock time of each step from the start of main() to the first frame
+// on screen. Construct it first thing, call mark() as each phase ends with
+// its name, a string literal, and report() once the first frame is
+// presented. Render thread only.
+class StartupProfiler
+{
+public:
+	StartupProfiler();
+
+	// ends the phase that ran since the last mark, or since construction
+	void mark(const char* phase);
+
+	double totalMilliseconds() const;
+
+	// each phase, its share of the total, and how much of the GL loader's
+	// table was looked up and how long that took
+	void report(const char* title) const;
+
+private:
+	typedef std::chrono::high_resolution_clock Clock;
+
+	struct Phase
+	{
+		const char* name;
+		double milliseconds;
+	};
+
+	Clock::time_point start;
+	Clock::time_point last;
+	std::vector<Phase> phases;
+};
+
+#endif
@@ -0,0 +1,47 @@
+#include "std140.h"
+
+#include <iostream>
+#include <glad/glad.h>
+
+using namespace std;
+
+bool checkUniformBlockLayout(unsigned int program, const char* blockName,
+	const vector<UniformMemberOffset>& members, size_t size)
+{
+	GLuint blockIndex = glGetUniformBlockIndex(program, blockName);
+	if (blockIndex == GL_INVALID_INDEX)
+	{
+		cout << "ERROR::UNIFORM_BLOCK::NOT_FOUND " << blockName << endl;
+		return false;
+	}
+
+	bool ok = true;
+	int dataSize = 0;
+	glGetActiveUniformBlockiv(program, blockIndex, GL_UNIFORM_BLOCK_DATA_SIZE, &dataSize);
+	if ((size_t)dataSize < size)
+	{
+		cout << "ERROR::UNIFORM_BLOCK::SIZE_MISMATCH " << blockName << ": GL " << dataSize << ", C++ " << size << endl;
+		ok = false;
+	}
+
+	for (const UniformMemberOffset& member : members)
+	{
+		GLuint index = GL_INVALID_INDEX;
+		glGetUniformIndices(program, 1, &member.name, &index);
+		if (index == GL_INVALID_INDEX)
+		{
+			// unused members may be optimized away, nothing to compare then
+			continue;
+		}
+
+		int offset = -1;
+		glGetActiveUniformsiv(program, 1, &index, GL_UNIFORM_OFFSET, &offset);
+		if ((size_t)offset != member.offset)
+		{
+			cout << "ERROR::UNIFORM_BLOCK::OFFSET_MISMATCH " << blockName << "." << member.name
+				<< ": GL " << offset << ", C++ " << member.offset << endl;
+			ok = false;
+		}
+	}
+	return ok;
+}
@@ -0,0 +1,85 @@
+#ifndef STD140_H
+#define STD140_H
+
+#include <cstddef>
+#include <cstdint>
+#include <string>
+#include <vector>
+
+// C++ types that land at the offsets GLSL's std140 / std430 rules give the
+// matching GLSL types, so a uniform block can be mirrored by a plain struct:
+//
+//   struct DrawBlock                        layout (std140) uniform DrawBlock
+//   {                                       {
+//       std140::Vec4 offsetScale;               vec4 offsetScale;
+//       std140::Vec4 color;                     vec4 color;
+//   };                                      };
+//
+// vec3 is padded to 16 bytes, so unlike GLSL a scalar can't share its last
+// 4 bytes; put scalars before vec3s or use vec4. STD140_OFFSET checks the
+// offsets at compile time, checkUniformBlockLayout() against the driver.
+namespace std140
+{
+	struct alignas(4) Float { float x; Float& operator=(float v) { x = v; return *this; } };
+	struct alignas(4) Int { int32_t x; Int& operator=(int32_t v) { x = v; return *this; } };
+	struct alignas(4) UInt { uint32_t x; UInt& operator=(uint32_t v) { x = v; return *this; } };
+	struct alignas(8) Vec2 { float x, y; };
+	struct alignas(16) Vec3 { float x, y, z; };
+	struct alignas(16) Vec4 { float x, y, z, w; };
+	struct alignas(16) IVec4 { int32_t x, y, z, w; };
+	// column major like GLSL, each column is a vec4
+	struct alignas(16) Mat4 { Vec4 columns[4]; };
+
+	// array elements are rounded up to a vec4 in std140
+	template<class T, size_t N>
+	struct alignas(16) Array
+	{
+		struct alignas(16) Element { T value; };
+		Element elements[N];
+
+		T& operator[](size_t i) { return elements[i].value; }
+		const T& operator[](size_t i) const { return elements[i].value; }
+	};
+
+	static_assert(sizeof(Vec3) == 16 && sizeof(Mat4) == 64, "unexpected std140 padding");
+	static_assert(sizeof(Array<Float, 4>) == 64, "std140 arrays must have a 16 byte stride");
+}
+
+// std430 (shader storage blocks) is std140 without rounding arrays and
+// structs up to 16 bytes
+namespace std430
+{
+	using std140::Float;
+	using std140::Int;
+	using std140::UInt;
+	using std140::Vec2;
+	using std140::Vec3;
+	using std140::Vec4;
+	using std140::IVec4;
+	using std140::Mat4;
+
+	template<class T, size_t N>
+	struct Array
+	{
+		T elements[N];
+
+		T& operator[](size_t i) { return elements[i]; }
+		const T& operator[](size_t i) const { return elements[i]; }
+	};
+}
+
+#define STD140_OFFSET(type, member, offset) \
+	static_assert(offsetof(type, member) == (offset), #type "::" #member " is not at std140 offset " #offset)
+
+struct UniformMemberOffset
+{
+	const char* name;
+	size_t offset;
+};
+
+// compare a C++ mirror of a uniform block with what the linked program reports,
+// printing every mismatch. Needs a current context, meant for startup/debug.
+bool checkUniformBlockLayout(unsigned int program, const char* blockName,
+	const std::vector<UniformMemberOffset>& members, size_t size);
+
+#endif
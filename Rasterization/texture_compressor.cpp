@@ -0,0 +1,757 @@
+#include "texture_compressor.h"
+#include "job_system.h"
+#include "simd.h"
+
+#include <algorithm>
+#include <cfloat>
+#include <cstdio>
+#include <cstring>
+#include <filesystem>
+#include <functional>
+#include <thread>
+
+using namespace std;
+namespace fs = std::filesystem;
+
+// bump whenever the encoders write different blocks, so cooked files made
+// by an older version stop matching
+static const uint32_t COOKED_VERSION = 2;
+static const uint32_t COOKED_MAGIC = 0x58544342;		// "BCTX"
+
+const char* blockFormatName(BlockFormat format)
+{
+	switch (format)
+	{
+	case BLOCK_FORMAT_BC1: return "BC1";
+	case BLOCK_FORMAT_BC3: return "BC3";
+	case BLOCK_FORMAT_BC7: return "BC7";
+	default: return "?";
+	}
+}
+
+size_t blockBytes(BlockFormat format)
+{
+	return format == BLOCK_FORMAT_BC1 ? 8 : 16;
+}
+
+size_t compressedLevelBytes(BlockFormat format, int width, int height)
+{
+	return (size_t)((width + 3) / 4) * ((height + 3) / 4) * blockBytes(format);
+}
+
+// a block's channels as floats, 16 texels each; lanes 0-7 are rows 0-1
+struct BlockTexels
+{
+	alignas(32) float c[4][16];		// r, g, b, a
+
+	vec8f half(int channel, int h) const { return vec8f::load(c[channel] + h * 8); }
+};
+
+static void loadBlock(const uint32_t texels[16], BlockTexels& block)
+{
+	for (int h = 0; h < 2; h++)
+	{
+		vec8i p = vec8i::loadu(texels + h * 8);
+		toFloat(p & vec8i(0xff)).store(block.c[0] + h * 8);
+		toFloat(shiftRight<8>(p) & vec8i(0xff)).store(block.c[1] + h * 8);
+		toFloat(shiftRight<16>(p) & vec8i(0xff)).store(block.c[2] + h * 8);
+		toFloat(shiftRight<24>(p)).store(block.c[3] + h * 8);
+	}
+}
+
+// mean and principal axis of channels [first, last): power iteration on
+// the covariance, started from its largest row so it can't start
+// perpendicular to the answer
+static void principalAxis(const BlockTexels& block, int first, int last, float mean[4], float axis[4])
+{
+	vec8f centered[4][2];
+	for (int c = first; c < last; c++)
+	{
+		mean[c] = horizontalSum(block.half(c, 0) + block.half(c, 1)) * (1.0f / 16.0f);
+		for (int h = 0; h < 2; h++)
+			centered[c][h] = block.half(c, h) - vec8f(mean[c]);
+	}
+	float covariance[4][4] = {};
+	int widest = first;
+	for (int i = first; i < last; i++)
+	{
+		for (int j = i; j < last; j++)
+		{
+			covariance[i][j] = covariance[j][i] =
+				horizontalSum(madd(centered[i][0], centered[j][0], centered[i][1] * centered[j][1]));
+		}
+		if (covariance[i][i] > covariance[widest][widest])
+			widest = i;
+	}
+
+	float v[4] = {};
+	for (int c = first; c < last; c++)
+		v[c] = covariance[widest][c];
+	for (int iteration = 0; iteration < 8; iteration++)
+	{
+		float w[4] = {}, largest = 0.0f;
+		for (int i = first; i < last; i++)
+		{
+			for (int j = first; j < last; j++)
+				w[i] += covariance[i][j] * v[j];
+			largest = max(largest, fabsf(w[i]));
+		}
+		if (largest < 1e-8f)
+			break;
+		for (int c = first; c < last; c++)
+			v[c] = w[c] / largest;
+	}
+	float length = 0.0f;
+	for (int c = first; c < last; c++)
+		length += v[c] * v[c];
+	length = sqrtf(length);
+	for (int c = first; c < last; c++)
+		axis[c] = length > 1e-8f ? v[c] / length : 1.0f / sqrtf((float)(last - first));
+}
+
+// the texels' positions along axis, smallest and largest
+static void projectionRange(const BlockTexels& block, int first, int last, const float mean[4], const float axis[4],
+	float& lowest, float& highest)
+{
+	vec8f t[2] = { vec8f::zero(), vec8f::zero() };
+	for (int c = first; c < last; c++)
+	{
+		for (int h = 0; h < 2; h++)
+			t[h] = madd(block.half(c, h) - vec8f(mean[c]), vec8f(axis[c]), t[h]);
+	}
+	lowest = horizontalMin(min(t[0], t[1]));
+	highest = horizontalMax(max(t[0], t[1]));
+}
+
+// the closest of count palette entries for every texel by squared distance
+// over channels [first, last), both halves of the block eight at a time;
+// returns the summed error
+static float selectIndices(const BlockTexels& block, int first, int last, const float palette[][4], int count, int indices[16])
+{
+	float total = 0.0f;
+	for (int h = 0; h < 2; h++)
+	{
+		vec8f best(FLT_MAX);
+		vec8i bestIndex = vec8i::zero();
+		for (int k = 0; k < count; k++)
+		{
+			vec8f error = vec8f::zero();
+			for (int c = first; c < last; c++)
+			{
+				vec8f d = block.half(c, h) - vec8f(palette[k][c]);
+				error = madd(d, d, error);
+			}
+			bestIndex = select(asInt(error < best), vec8i(k), bestIndex);
+			best = min(best, error);
+		}
+		bestIndex.storeu(indices + h * 8);
+		total += horizontalSum(best);
+	}
+	return total;
+}
+
+// Least squares endpoints for fixed indices: texel i should be
+// e0 + (e1 - e0) * weights[indices[i]]. False when every texel picked the
+// same weight and the system has no single answer.
+static bool fitEndpoints(const BlockTexels& block, int first, int last, const int indices[16], const float* weights,
+	float e0[4], float e1[4])
+{
+	float aa = 0.0f, ab = 0.0f, bb = 0.0f;
+	float ax[4] = {}, bx[4] = {};
+	for (int i = 0; i < 16; i++)
+	{
+		float b = weights[indices[i]], a = 1.0f - b;
+		aa += a * a;
+		ab += a * b;
+		bb += b * b;
+		for (int c = first; c < last; c++)
+		{
+			ax[c] += a * block.c[c][i];
+			bx[c] += b * block.c[c][i];
+		}
+	}
+	float determinant = aa * bb - ab * ab;
+	if (fabsf(determinant) < 1e-6f)
+		return false;
+	for (int c = first; c < last; c++)
+	{
+		e0[c] = min(max((bb * ax[c] - ab * bx[c]) / determinant, 0.0f), 255.0f);
+		e1[c] = min(max((aa * bx[c] - ab * ax[c]) / determinant, 0.0f), 255.0f);
+	}
+	return true;
+}
+
+static int quantize(float value, int maxCode)
+{
+	return min(max((int)(value * maxCode / 255.0f + 0.5f), 0), maxCode);
+}
+
+static uint16_t to565(const float color[4])
+{
+	return (uint16_t)(quantize(color[0], 31) << 11 | quantize(color[1], 63) << 5 | quantize(color[2], 31));
+}
+
+static void from565(uint16_t value, int color[3])
+{
+	int r = value >> 11, g = (value >> 5) & 63, b = value & 31;
+	color[0] = r << 3 | r >> 2;
+	color[1] = g << 2 | g >> 4;
+	color[2] = b << 3 | b >> 2;
+}
+
+// the four colors of a BC1 block with c0 > c1, or c0 twice when they're equal
+static int bc1Palette(uint16_t c0, uint16_t c1, float palette[4][4])
+{
+	int a[3], b[3];
+	from565(c0, a);
+	from565(c1, b);
+	for (int c = 0; c < 3; c++)
+	{
+		palette[0][c] = (float)a[c];
+		palette[1][c] = (float)b[c];
+		palette[2][c] = (float)((2 * a[c] + b[c] + 1) / 3);
+		palette[3][c] = (float)((a[c] + 2 * b[c] + 1) / 3);
+	}
+	return c0 == c1 ? 1 : 4;
+}
+
+// BC1 color, always the four color mode
+static void encodeColorBlock(const BlockTexels& block, uint8_t out[8])
+{
+	static const float weights[4] = { 0.0f, 1.0f, 1.0f / 3.0f, 2.0f / 3.0f };
+	float mean[4], axis[4], lowest, highest;
+	principalAxis(block, 0, 3, mean, axis);
+	projectionRange(block, 0, 3, mean, axis, lowest, highest);
+	float e0[4], e1[4];
+	for (int c = 0; c < 3; c++)
+	{
+		e0[c] = mean[c] + axis[c] * highest;
+		e1[c] = mean[c] + axis[c] * lowest;
+	}
+
+	float bestError = FLT_MAX;
+	uint16_t best0 = 0, best1 = 0;
+	int bestIndices[16] = {};
+	for (int iteration = 0; iteration < 3; iteration++)
+	{
+		uint16_t c0 = to565(e0), c1 = to565(e1);
+		if (c0 < c1)
+			swap(c0, c1);
+		float palette[4][4];
+		int indices[16];
+		float error = selectIndices(block, 0, 3, palette, bc1Palette(c0, c1, palette), indices);
+		if (error < bestError)
+		{
+			bestError = error;
+			best0 = c0;
+			best1 = c1;
+			memcpy(bestIndices, indices, sizeof(indices));
+		}
+		if (error == 0.0f || !fitEndpoints(block, 0, 3, indices, weights, e0, e1))
+			break;
+	}
+
+	uint32_t bits = 0;
+	for (int i = 0; i < 16; i++)
+		bits |= (uint32_t)bestIndices[i] << (i * 2);
+	out[0] = (uint8_t)best0;
+	out[1] = (uint8_t)(best0 >> 8);
+	out[2] = (uint8_t)best1;
+	out[3] = (uint8_t)(best1 >> 8);
+	memcpy(out + 4, &bits, 4);
+}
+
+// the eight alphas of a BC4 block
+static void alphaPalette(int a0, int a1, float palette[8][4])
+{
+	palette[0][3] = (float)a0;
+	palette[1][3] = (float)a1;
+	if (a0 > a1)
+	{
+		for (int i = 1; i < 7; i++)
+			palette[i + 1][3] = (float)(((7 - i) * a0 + i * a1) / 7);
+	}
+	else
+	{
+		for (int i = 1; i < 5; i++)
+			palette[i + 1][3] = (float)(((5 - i) * a0 + i * a1) / 5);
+		palette[6][3] = 0.0f;
+		palette[7][3] = 255.0f;
+	}
+}
+
+// BC4 alpha: eight steps between the extremes, or six between the extremes
+// other than 0 and 255 with those two exact, whichever fits better
+static void encodeAlphaBlock(const BlockTexels& block, uint8_t out[8])
+{
+	int lowest = 255, highest = 0, innerLowest = 255, innerHighest = 0;
+	for (int i = 0; i < 16; i++)
+	{
+		int a = (int)block.c[3][i];
+		lowest = min(lowest, a);
+		highest = max(highest, a);
+		if (a != 0 && a != 255)
+		{
+			innerLowest = min(innerLowest, a);
+			innerHighest = max(innerHighest, a);
+		}
+	}
+
+	float palette[8][4];
+	int indices[16], bestIndices[16];
+	alphaPalette(highest, lowest, palette);
+	float bestError = selectIndices(block, 3, 4, palette, highest > lowest ? 8 : 1, bestIndices);
+	int a0 = highest, a1 = lowest;
+	if (bestError > 0.0f && (lowest == 0 || highest == 255))
+	{
+		if (innerLowest > innerHighest)
+			innerLowest = innerHighest = 0;
+		alphaPalette(innerLowest, innerHighest, palette);
+		float error = selectIndices(block, 3, 4, palette, 8, indices);
+		if (error < bestError)
+		{
+			a0 = innerLowest;
+			a1 = innerHighest;
+			memcpy(bestIndices, indices, sizeof(indices));
+		}
+	}
+
+	uint64_t bits = 0;
+	for (int i = 0; i < 16; i++)
+		bits |= (uint64_t)bestIndices[i] << (i * 3);
+	out[0] = (uint8_t)a0;
+	out[1] = (uint8_t)a1;
+	for (int i = 0; i < 6; i++)
+		out[2 + i] = (uint8_t)(bits >> (i * 8));
+}
+
+void compressBlockBC1(const uint32_t texels[16], uint8_t block[8])
+{
+	BlockTexels values;
+	loadBlock(texels, values);
+	encodeColorBlock(values, block);
+}
+
+void compressBlockBC3(const uint32_t texels[16], uint8_t block[16])
+{
+	BlockTexels values;
+	loadBlock(texels, values);
+	encodeAlphaBlock(values, block);
+	encodeColorBlock(values, block + 8);
+}
+
+static const int BC7_WEIGHTS[16] = { 0, 4, 9, 13, 17, 21, 26, 30, 34, 38, 43, 47, 51, 55, 60, 64 };
+
+// a BC7 mode 6 endpoint: seven bits per channel and a shared lowest bit,
+// the bit picked for the smaller error
+static void quantizeBC7Endpoint(const float endpoint[4], int code[4], int& pbit)
+{
+	float bestError = FLT_MAX;
+	for (int p = 0; p < 2; p++)
+	{
+		int candidate[4];
+		float error = 0.0f;
+		for (int c = 0; c < 4; c++)
+		{
+			candidate[c] = min(max((int)((endpoint[c] - p) * 0.5f + 0.5f), 0), 127);
+			float d = endpoint[c] - (float)(candidate[c] << 1 | p);
+			error += d * d;
+		}
+		if (error < bestError)
+		{
+			bestError = error;
+			pbit = p;
+			memcpy(code, candidate, sizeof(candidate));
+		}
+	}
+}
+
+static void bc7Palette(const int code0[4], int p0, const int code1[4], int p1, float palette[16][4])
+{
+	for (int c = 0; c < 4; c++)
+	{
+		int a = code0[c] << 1 | p0, b = code1[c] << 1 | p1;
+		for (int i = 0; i < 16; i++)
+			palette[i][c] = (float)(((64 - BC7_WEIGHTS[i]) * a + BC7_WEIGHTS[i] * b + 32) >> 6);
+	}
+}
+
+// writes fields of up to 32 bits into a 128-bit block, lowest bit first
+struct BlockBitWriter
+{
+	uint8_t* out;
+	int position = 0;
+
+	void put(uint32_t value, int bits)
+	{
+		for (int i = 0; i < bits; i++, position++)
+			out[position >> 3] |= (uint8_t)(((value >> i) & 1) << (position & 7));
+	}
+};
+
+struct BlockBitReader
+{
+	const uint8_t* in;
+	int position = 0;
+
+	uint32_t get(int bits)
+	{
+		uint32_t value = 0;
+		for (int i = 0; i < bits; i++, position++)
+			value |= (uint32_t)((in[position >> 3] >> (position & 7)) & 1) << i;
+		return value;
+	}
+};
+
+// BC7 mode 6: one RGBA line with sixteen steps, the finest mode for a block
+// without sharp edges between different colors
+void compressBlockBC7(const uint32_t texels[16], uint8_t block[16])
+{
+	BlockTexels values;
+	loadBlock(texels, values);
+
+	static float weights[16];
+	static bool weightsReady = [] {
+		for (int i = 0; i < 16; i++)
+			weights[i] = BC7_WEIGHTS[i] / 64.0f;
+		return true;
+	}();
+	(void)weightsReady;
+
+	float mean[4], axis[4], lowest, highest;
+	principalAxis(values, 0, 4, mean, axis);
+	projectionRange(values, 0, 4, mean, axis, lowest, highest);
+	float e0[4], e1[4];
+	for (int c = 0; c < 4; c++)
+	{
+		e0[c] = min(max(mean[c] + axis[c] * lowest, 0.0f), 255.0f);
+		e1[c] = min(max(mean[c] + axis[c] * highest, 0.0f), 255.0f);
+	}
+
+	float bestError = FLT_MAX;
+	int best0[4] = {}, best1[4] = {}, bestP0 = 0, bestP1 = 0, bestIndices[16] = {};
+	for (int iteration = 0; iteration < 3; iteration++)
+	{
+		int code0[4], code1[4], p0, p1;
+		quantizeBC7Endpoint(e0, code0, p0);
+		quantizeBC7Endpoint(e1, code1, p1);
+		float palette[16][4];
+		bc7Palette(code0, p0, code1, p1, palette);
+		int indices[16];
+		float error = selectIndices(values, 0, 4, palette, 16, indices);
+		if (error < bestError)
+		{
+			bestError = error;
+			memcpy(best0, code0, sizeof(code0));
+			memcpy(best1, code1, sizeof(code1));
+			bestP0 = p0;
+			bestP1 = p1;
+			memcpy(bestIndices, indices, sizeof(indices));
+		}
+		if (error == 0.0f || !fitEndpoints(values, 0, 4, indices, weights, e0, e1))
+			break;
+	}
+
+	// the first texel's index is stored without its top bit, so it must be
+	// in the lower half; mirroring the line puts it there
+	if (bestIndices[0] >= 8)
+	{
+		swap(best0, best1);
+		swap(bestP0, bestP1);
+		for (int& index : bestIndices)
+			index = 15 - index;
+	}
+
+	memset(block, 0, 16);
+	BlockBitWriter writer{ block };
+	writer.put(1 << 6, 7);
+	for (int c = 0; c < 4; c++)
+	{
+		writer.put(best0[c], 7);
+		writer.put(best1[c], 7);
+	}
+	writer.put(bestP0, 1);
+	writer.put(bestP1, 1);
+	writer.put(bestIndices[0], 3);
+	for (int i = 1; i < 16; i++)
+		writer.put(bestIndices[i], 4);
+}
+
+static uint32_t packTexel(int r, int g, int b, int a)
+{
+	return (uint32_t)r | (uint32_t)g << 8 | (uint32_t)b << 16 | (uint32_t)a << 24;
+}
+
+static void decodeColorBlock(const uint8_t* in, bool alwaysFourColors, uint32_t texels[16])
+{
+	uint16_t c0 = (uint16_t)(in[0] | in[1] << 8), c1 = (uint16_t)(in[2] | in[3] << 8);
+	int a[3], b[3];
+	from565(c0, a);
+	from565(c1, b);
+	uint32_t colors[4];
+	colors[0] = packTexel(a[0], a[1], a[2], 255);
+	colors[1] = packTexel(b[0], b[1], b[2], 255);
+	if (c0 > c1 || alwaysFourColors)
+	{
+		colors[2] = packTexel((2 * a[0] + b[0] + 1) / 3, (2 * a[1] + b[1] + 1) / 3, (2 * a[2] + b[2] + 1) / 3, 255);
+		colors[3] = packTexel((a[0] + 2 * b[0] + 1) / 3, (a[1] + 2 * b[1] + 1) / 3, (a[2] + 2 * b[2] + 1) / 3, 255);
+	}
+	else
+	{
+		colors[2] = packTexel((a[0] + b[0]) / 2, (a[1] + b[1]) / 2, (a[2] + b[2]) / 2, 255);
+		colors[3] = 0;
+	}
+	uint32_t bits;
+	memcpy(&bits, in + 4, 4);
+	for (int i = 0; i < 16; i++)
+		texels[i] = colors[(bits >> (i * 2)) & 3];
+}
+
+void decompressBlock(BlockFormat format, const uint8_t* block, uint32_t texels[16])
+{
+	if (format == BLOCK_FORMAT_BC1)
+	{
+		decodeColorBlock(block, false, texels);
+	}
+	else if (format == BLOCK_FORMAT_BC3)
+	{
+		decodeColorBlock(block + 8, true, texels);
+		float palette[8][4];
+		alphaPalette(block[0], block[1], palette);
+		uint64_t bits = 0;
+		for (int i = 0; i < 6; i++)
+			bits |= (uint64_t)block[2 + i] << (i * 8);
+		for (int i = 0; i < 16; i++)
+			texels[i] = (texels[i] & 0xffffff) | (uint32_t)palette[(bits >> (i * 3)) & 7][3] << 24;
+	}
+	else
+	{
+		BlockBitReader reader{ block };
+		if (reader.get(7) != 1 << 6)
+		{
+			for (int i = 0; i < 16; i++)
+				texels[i] = 0xffff00ffu;
+			return;
+		}
+		int code0[4], code1[4];
+		for (int c = 0; c < 4; c++)
+		{
+			code0[c] = reader.get(7);
+			code1[c] = reader.get(7);
+		}
+		int p0 = reader.get(1), p1 = reader.get(1);
+		float palette[16][4];
+		bc7Palette(code0, p0, code1, p1, palette);
+		for (int i = 0; i < 16; i++)
+		{
+			const float* color = palette[reader.get(i == 0 ? 3 : 4)];
+			texels[i] = packTexel((int)color[0], (int)color[1], (int)color[2], (int)color[3]);
+		}
+	}
+}
+
+static void compressBlockRows(const RgbaImage& image, BlockFormat format, uint8_t* out, int firstRow, int endRow)
+{
+	const int blocksWide = (image.width + 3) / 4;
+	const size_t bytes = blockBytes(format);
+	uint32_t texels[16];
+	for (int by = firstRow; by < endRow; by++)
+	{
+		uint8_t* block = out + (size_t)by * blocksWide * bytes;
+		for (int bx = 0; bx < blocksWide; bx++, block += bytes)
+		{
+			// past the edge the last row and column repeat
+			for (int y = 0; y < 4; y++)
+			{
+				const uint32_t* row = image.row(min(by * 4 + y, image.height - 1));
+				for (int x = 0; x < 4; x++)
+					texels[y * 4 + x] = row[min(bx * 4 + x, image.width - 1)];
+			}
+			if (format == BLOCK_FORMAT_BC1)
+				compressBlockBC1(texels, block);
+			else if (format == BLOCK_FORMAT_BC3)
+				compressBlockBC3(texels, block);
+			else
+				compressBlockBC7(texels, block);
+		}
+	}
+}
+
+void compressImage(const RgbaImage& image, BlockFormat format, uint8_t* out, JobSystem* jobs)
+{
+	const int blocksHigh = (image.height + 3) / 4;
+	if (!jobs)
+	{
+		compressBlockRows(image, format, out, 0, blocksHigh);
+		return;
+	}
+	jobs->parallelFor(0, blocksHigh, [&](size_t begin, size_t end) {
+		compressBlockRows(image, format, out, (int)begin, (int)end);
+	});
+}
+
+void decompressImage(BlockFormat format, const uint8_t* blocks, int width, int height, RgbaImage& image)
+{
+	image.resize(width, height);
+	const int blocksWide = (width + 3) / 4, blocksHigh = (height + 3) / 4;
+	uint32_t texels[16];
+	for (int by = 0; by < blocksHigh; by++)
+	{
+		for (int bx = 0; bx < blocksWide; bx++, blocks += blockBytes(format))
+		{
+			decompressBlock(format, blocks, texels);
+			for (int y = 0; y < 4 && by * 4 + y < height; y++)
+			{
+				for (int x = 0; x < 4 && bx * 4 + x < width; x++)
+					image.row(by * 4 + y)[bx * 4 + x] = texels[y * 4 + x];
+			}
+		}
+	}
+}
+
+void compressTexture(const RgbaImage& image, BlockFormat format, const MipOptions* mips, CompressedTexture& texture, JobSystem* jobs)
+{
+	vector<RgbaImage> levels;
+	if (mips)
+		generateMips(image, *mips, levels, jobs);
+	compressTexture(image, levels, format, texture, jobs);
+}
+
+void compressTexture(const RgbaImage& image, const vector<RgbaImage>& levels, BlockFormat format,
+	CompressedTexture& texture, JobSystem* jobs)
+{
+	texture.format = format;
+	texture.width = image.width;
+	texture.height = image.height;
+	texture.levelOffsets.assign(1, 0);
+	size_t total = 0;
+	for (int level = 0; level <= (int)levels.size(); level++)
+	{
+		total += compressedLevelBytes(format, texture.levelWidth(level), texture.levelHeight(level));
+		texture.levelOffsets.push_back(total);
+	}
+	texture.data.resize(total);
+	for (int level = 0; level < texture.levelCount(); level++)
+		compressImage(level == 0 ? image : levels[level - 1], format, texture.data.data() + texture.levelOffsets[level], jobs);
+}
+
+bool hashFile(const string& path, uint64_t& hash)
+{
+	FILE* file = fopen(path.c_str(), "rb");
+	if (!file)
+		return false;
+	// eight bytes at a time, multiply-rotate per word and a final mix
+	uint64_t h = 0x243f6a8885a308d3ull, length = 0;
+	uint64_t words[8192];
+	size_t read;
+	while ((read = fread(words, 1, sizeof(words), file)) > 0)
+	{
+		size_t count = read / 8;
+		if (read % 8)
+		{
+			memset((uint8_t*)words + read, 0, 8 - read % 8);
+			count++;
+		}
+		for (size_t i = 0; i < count; i++)
+		{
+			h ^= words[i] * 0x9e3779b97f4a7c15ull;
+			h = (h << 31 | h >> 33) * 0x100000001b3ull;
+		}
+		length += read;
+	}
+	bool ok = !ferror(file);
+	fclose(file);
+	h ^= length;
+	h ^= h >> 33;
+	h *= 0xff51afd7ed558ccdull;
+	h ^= h >> 33;
+	h *= 0xc4ceb9fe1a85ec53ull;
+	h ^= h >> 33;
+	hash = h;
+	return ok;
+}
+
+CookedTextureCache::CookedTextureCache(const string& directory)
+	: root(directory)
+{
+}
+
+uint64_t CookedTextureCache::key(uint64_t contentHash, BlockFormat format, const MipOptions* mips)
+{
+	uint64_t settings = mips ? 1 | (uint64_t)mips->filter << 1 | (uint64_t)mips->srgb << 4 : 0;
+	if (mips && mips->alphaCutoff > 0.0f)
+		settings |= (uint64_t)(mips->alphaCutoff * 255.0f + 0.5f) << 16;
+	uint64_t h = contentHash ^ ((uint64_t)COOKED_VERSION << 56 | (uint64_t)format << 48 | settings);
+	h ^= h >> 33;
+	h *= 0xff51afd7ed558ccdull;
+	h ^= h >> 33;
+	return h;
+}
+
+string CookedTextureCache::path(uint64_t key) const
+{
+	char name[24];
+	snprintf(name, sizeof(name), "%016llx.bct", (unsigned long long)key);
+	return (fs::path(root) / name).string();
+}
+
+// header: magic, version, format, width, height, level count; then the
+// level offsets and the blocks
+bool CookedTextureCache::load(uint64_t key, CompressedTexture& texture) const
+{
+	FILE* file = fopen(path(key).c_str(), "rb");
+	if (!file)
+		return false;
+	uint32_t header[6];
+	bool ok = fread(header, sizeof(header), 1, file) == 1 && header[0] == COOKED_MAGIC && header[1] == COOKED_VERSION
+		&& header[2] <= BLOCK_FORMAT_BC7 && header[3] > 0 && header[4] > 0 && header[5] > 0 && header[5] <= 16;
+	if (ok)
+	{
+		texture.format = (BlockFormat)header[2];
+		texture.width = (int)header[3];
+		texture.height = (int)header[4];
+		vector<uint64_t> offsets(header[5] + 1);
+		ok = fread(offsets.data(), sizeof(uint64_t), offsets.size(), file) == offsets.size() && offsets[0] == 0;
+		texture.levelOffsets.assign(1, 0);
+		for (uint32_t level = 0; level < header[5] && ok; level++)
+		{
+			size_t bytes = compressedLevelBytes(texture.format, texture.levelWidth(level), texture.levelHeight(level));
+			ok = offsets[level + 1] == offsets[level] + bytes;
+			texture.levelOffsets.push_back((size_t)offsets[level + 1]);
+		}
+		if (ok)
+		{
+			texture.data.resize(texture.levelOffsets.back());
+			ok = fread(texture.data.data(), 1, texture.data.size(), file) == texture.data.size();
+		}
+	}
+	fclose(file);
+	return ok;
+}
+
+bool CookedTextureCache::store(uint64_t key, const CompressedTexture& texture) const
+{
+	error_code error;
+	fs::create_directories(root, error);
+	string target = path(key);
+	// two threads cooking the same source write different temporary files
+	string temporary = target + "." + to_string(hash<thread::id>()(this_thread::get_id())) + ".tmp";
+	FILE* file = fopen(temporary.c_str(), "wb");
+	if (!file)
+		return false;
+	uint32_t header[6] = { COOKED_MAGIC, COOKED_VERSION, (uint32_t)texture.format, (uint32_t)texture.width,
+		(uint32_t)texture.height, (uint32_t)texture.levelCount() };
+	vector<uint64_t> offsets(texture.levelOffsets.begin(), texture.levelOffsets.end());
+	bool ok = fwrite(header, sizeof(header), 1, file) == 1
+		&& fwrite(offsets.data(), sizeof(uint64_t), offsets.size(), file) == offsets.size()
+		&& fwrite(texture.data.data(), 1, texture.data.size(), file) == texture.data.size();
+	ok = fclose(file) == 0 && ok;
+	if (ok)
+		fs::rename(temporary, target, error);
+	if (!ok || error)
+	{
+		fs::remove(temporary, error);
+		return false;
+	}
+	return true;
+}
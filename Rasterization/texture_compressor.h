@@ -0,0 +1,98 @@
+#ifndef TEXTURE_COMPRESSOR_H
+#define TEXTURE_COMPRESSOR_H
+
+#include <cstddef>
+#include <cstdint>
+#include <string>
+#include <vector>
+
+#include "image_compare.h"
+#include "mip_generator.h"
+
+class JobSystem;
+
+// GPU block compression formats: 4x4 texel blocks of fixed size
+enum BlockFormat
+{
+	BLOCK_FORMAT_BC1,		// RGB, 8 bytes per block, opaque only
+	BLOCK_FORMAT_BC3,		// RGBA, BC1 color and BC4 alpha, 16 bytes per block
+	BLOCK_FORMAT_BC7,		// RGBA, 16 bytes per block, mode 6 only
+};
+
+const char* blockFormatName(BlockFormat format);
+size_t blockBytes(BlockFormat format);
+// bytes of one width x height level, partial blocks at the edges included
+size_t compressedLevelBytes(BlockFormat format, int width, int height);
+
+// One 4x4 block from 16 texels packed like packRGBA8(), row by row. Each
+// encoder takes the principal axis of the block's colors as the first guess
+// for the endpoints, then alternates picking the closest palette entry for
+// all 16 texels at once in SIMD and solving least squares for the endpoints
+// those picks imply, keeping whichever quantized pair did best.
+void compressBlockBC1(const uint32_t texels[16], uint8_t block[8]);
+void compressBlockBC3(const uint32_t texels[16], uint8_t block[16]);
+void compressBlockBC7(const uint32_t texels[16], uint8_t block[16]);
+
+// the reverse, for checking: BC7 handles every mode 6 block, other modes
+// come out magenta
+void decompressBlock(BlockFormat format, const uint8_t* block, uint32_t texels[16]);
+
+// Every block of image into out, compressedLevelBytes() of it, block rows in
+// the order of the image rows. With a job system the block rows are spread
+// over its threads; call it from the thread that made the job system then.
+void compressImage(const RgbaImage& image, BlockFormat format, uint8_t* out, JobSystem* jobs = nullptr);
+void decompressImage(BlockFormat format, const uint8_t* blocks, int width, int height, RgbaImage& image);
+
+// a compressed mip chain, level 0 first
+struct CompressedTexture
+{
+	BlockFormat format = BLOCK_FORMAT_BC1;
+	int width = 0;
+	int height = 0;
+	std::vector<size_t> levelOffsets;	// into data, one per level and one past the end
+	std::vector<uint8_t> data;
+
+	int levelCount() const { return levelOffsets.empty() ? 0 : (int)levelOffsets.size() - 1; }
+	int levelWidth(int level) const { return width >> level > 0 ? width >> level : 1; }
+	int levelHeight(int level) const { return height >> level > 0 ? height >> level : 1; }
+	const uint8_t* level(int level) const { return data.data() + levelOffsets[level]; }
+	size_t levelBytes(int level) const { return levelOffsets[level + 1] - levelOffsets[level]; }
+};
+
+// compresses image and, with mips, every level down to 1x1 that
+// generateMips() makes from it
+void compressTexture(const RgbaImage& image, BlockFormat format, const MipOptions* mips, CompressedTexture& texture,
+	JobSystem* jobs = nullptr);
+// the same with the levels below image already made
+void compressTexture(const RgbaImage& image, const std::vector<RgbaImage>& mips, BlockFormat format,
+	CompressedTexture& texture, JobSystem* jobs = nullptr);
+
+// 64-bit hash of a file's bytes, false when it can't be read
+bool hashFile(const std::string& path, uint64_t& hash);
+
+// Compressed textures on disk under the hash of what they were made from,
+// so each source is compressed once: the streamer looks a file up by the
+// hash of its bytes, the format and the encoder version before decoding it.
+// Files are written under a temporary name and renamed, so a reader never
+// sees half of one. Safe to use from several threads.
+class CookedTextureCache
+{
+public:
+	explicit CookedTextureCache(const std::string& directory);
+
+	// the key for source bytes hashed to contentHash, cooked to format with
+	// mips, or only the top level without
+	static uint64_t key(uint64_t contentHash, BlockFormat format, const MipOptions* mips);
+
+	bool load(uint64_t key, CompressedTexture& texture) const;
+	bool store(uint64_t key, const CompressedTexture& texture) const;
+
+	const std::string& directory() const { return root; }
+
+private:
+	std::string path(uint64_t key) const;
+
+	std::string root;
+};
+
+#endif
@@ -0,0 +1,494 @@
+#include "texture_streamer.h"
+#include "gl_ext.h"
+#include "gpu_memory.h"
+
+#include <algorithm>
+#include <cctype>
+#include <chrono>
+#include <cstring>
+#include <iostream>
+
+using namespace std;
+
+typedef chrono::high_resolution_clock Clock;
+
+static const int PLACEHOLDER_SIZE = 8;
+
+TextureStreamer::TextureStreamer(int decodeThreads, int stagingBuffers)
+	: decodeThreadCount(decodeThreads > 0 ? decodeThreads : (int)max(1u, thread::hardware_concurrency())),
+	staging(stagingBuffers < 2 ? 2 : stagingBuffers)
+{
+}
+
+TextureStreamer::~TextureStreamer()
+{
+	stop();
+}
+
+void TextureStreamer::setCompression(BlockFormat format, const string& cacheDirectory)
+{
+	compress = true;
+	compressFormat = format;
+	cache.reset(cacheDirectory.empty() ? nullptr : new CookedTextureCache(cacheDirectory));
+}
+
+// the GL format for blocks of format, 0 when the driver can't sample it
+static GLenum compressedInternalFormat(BlockFormat format, bool srgb)
+{
+	switch (format)
+	{
+	case BLOCK_FORMAT_BC1:
+		if (!glext.s3tc || (srgb && !glext.s3tcSrgb))
+			return 0;
+		return srgb ? GL_COMPRESSED_SRGB_S3TC_DXT1_EXT : GL_COMPRESSED_RGB_S3TC_DXT1_EXT;
+	case BLOCK_FORMAT_BC3:
+		if (!glext.s3tc || (srgb && !glext.s3tcSrgb))
+			return 0;
+		return srgb ? GL_COMPRESSED_SRGB_ALPHA_S3TC_DXT5_EXT : GL_COMPRESSED_RGBA_S3TC_DXT5_EXT;
+	case BLOCK_FORMAT_BC7:
+		if (!glext.bptc)
+			return 0;
+		return srgb ? GL_COMPRESSED_SRGB_ALPHA_BPTC_UNORM : GL_COMPRESSED_RGBA_BPTC_UNORM;
+	default:
+		return 0;
+	}
+}
+
+bool TextureStreamer::start(GLFWwindow* mainWindow)
+{
+	// like FrameCapture: a hidden window for a context in the main share
+	// group, the textures, buffers and fences are shared, bindings are not
+	glfwWindowHint(GLFW_VISIBLE, GLFW_FALSE);
+	loaderWindow = glfwCreateWindow(1, 1, "texture loader", NULL, mainWindow);
+	glfwWindowHint(GLFW_VISIBLE, GLFW_TRUE);
+	if (loaderWindow == NULL)
+	{
+		cout << "ERROR::TEXTURE_STREAMER::SHARED_CONTEXT_FAILED" << endl;
+		return false;
+	}
+	if (compress && (!compressedInternalFormat(compressFormat, false) || !compressedInternalFormat(compressFormat, true)))
+	{
+		cout << "ERROR::TEXTURE_STREAMER::COMPRESSION_UNSUPPORTED " << blockFormatName(compressFormat)
+			<< ", loading uncompressed" << endl;
+		compress = false;
+	}
+
+	uint32_t checker[PLACEHOLDER_SIZE * PLACEHOLDER_SIZE];
+	for (int y = 0; y < PLACEHOLDER_SIZE; y++)
+	{
+		for (int x = 0; x < PLACEHOLDER_SIZE; x++)
+			checker[y * PLACEHOLDER_SIZE + x] = ((x / 4) ^ (y / 4)) & 1 ? 0xffff00ffu : 0xff808080u;
+	}
+	placeholderTexture = GLTexture::create();
+	glBindTexture(GL_TEXTURE_2D, placeholderTexture.get());
+	glPixelStorei(GL_UNPACK_ALIGNMENT, 4);
+	glTexImage2D(GL_TEXTURE_2D, 0, GL_SRGB8_ALPHA8, PLACEHOLDER_SIZE, PLACEHOLDER_SIZE, 0, GL_RGBA, GL_UNSIGNED_BYTE, checker);
+	glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MIN_FILTER, GL_NEAREST);
+	glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MAG_FILTER, GL_NEAREST);
+	glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MAX_LEVEL, 0);
+	glBindTexture(GL_TEXTURE_2D, 0);
+	gpuMemory.trackTexture(placeholderTexture.get(), GPU_MEMORY_TEXTURE, gpuImageBytes(GL_SRGB8_ALPHA8, PLACEHOLDER_SIZE, PLACEHOLDER_SIZE));
+
+	for (StagingBuffer& slot : staging)
+		glGenBuffers(1, &slot.buffer);
+	nextStaging = 0;
+	stopping = false;
+	counters = Stats();
+	for (int i = 0; i < decodeThreadCount; i++)
+		decoders.emplace_back(&TextureStreamer::decodeLoop, this);
+	loader = thread(&TextureStreamer::loaderLoop, this);
+	return true;
+}
+
+void TextureStreamer::stop()
+{
+	if (!loader.joinable())
+		return;
+	{
+		lock_guard<mutex> lock(queueMutex);
+		stopping = true;
+	}
+	decodeReady.notify_all();
+	uploadReady.notify_one();
+	for (thread& decoder : decoders)
+		decoder.join();
+	decoders.clear();
+	loader.join();
+
+	// uploads nobody picked up yet own their texture and fence
+	decodeQueue.clear();
+	uploadQueue.clear();
+	for (unique_ptr<Request>& request : uploaded)
+		fenced.push_back(move(request));
+	uploaded.clear();
+	for (unique_ptr<Request>& request : fenced)
+	{
+		if (request->fence)
+			glDeleteSync(request->fence);
+		if (request->texture)
+		{
+			gpuMemory.forgetTexture(request->texture);
+			glDeleteTextures(1, &request->texture);
+		}
+	}
+	fenced.clear();
+
+	for (StagingBuffer& slot : staging)
+	{
+		if (slot.fence)
+			glDeleteSync(slot.fence);
+		gpuMemory.forgetBuffer(slot.buffer);
+		glDeleteBuffers(1, &slot.buffer);
+		slot = StagingBuffer();
+	}
+	entries.clear();
+	settled = 0;
+	placeholderTexture.reset();
+	glfwDestroyWindow(loaderWindow);
+	loaderWindow = nullptr;
+}
+
+int TextureStreamer::load(const string& path, bool srgb)
+{
+	int handle = (int)entries.size();
+	entries.emplace_back();
+	lock_guard<mutex> lock(queueMutex);
+	counters.requested++;
+	if (!loader.joinable())
+	{
+		entries.back().failed = true;
+		settled++;
+		counters.failed++;
+		return handle;
+	}
+	unique_ptr<Request> request = make_unique<Request>();
+	request->handle = handle;
+	request->path = path;
+	request->srgb = srgb;
+	decodeQueue.push_back(move(request));
+	decodeReady.notify_one();
+	return handle;
+}
+
+void TextureStreamer::update()
+{
+	auto start = Clock::now();
+	{
+		lock_guard<mutex> lock(queueMutex);
+		for (unique_ptr<Request>& request : uploaded)
+			fenced.push_back(move(request));
+		uploaded.clear();
+	}
+
+	uint64_t nowResident = 0, nowFailed = 0;
+	for (size_t i = 0; i < fenced.size();)
+	{
+		Request& request = *fenced[i];
+		Entry& entry = entries[request.handle];
+		if (request.ok)
+		{
+			// asks, doesn't wait: an upload that isn't done shows next frame
+			GLint status = GL_UNSIGNALED;
+			glGetSynciv(request.fence, GL_SYNC_STATUS, 1, NULL, &status);
+			if (status != GL_SIGNALED)
+			{
+				i++;
+				continue;
+			}
+			glDeleteSync(request.fence);
+			entry.texture.reset(request.texture);
+			entry.resident = true;
+			nowResident++;
+		}
+		else
+		{
+			entry.failed = true;
+			nowFailed++;
+		}
+		settled++;
+		fenced[i] = move(fenced.back());
+		fenced.pop_back();
+	}
+
+	double milliseconds = chrono::duration<double, milli>(Clock::now() - start).count();
+	lock_guard<mutex> lock(queueMutex);
+	counters.resident += nowResident;
+	counters.failed += nowFailed;
+	counters.updateMilliseconds += milliseconds;
+	counters.maxUpdateMilliseconds = max(counters.maxUpdateMilliseconds, milliseconds);
+}
+
+GLuint TextureStreamer::texture(int handle) const
+{
+	if (resident(handle))
+		return entries[handle].texture.get();
+	return placeholderTexture.get();
+}
+
+bool TextureStreamer::resident(int handle) const
+{
+	return handle >= 0 && handle < (int)entries.size() && entries[handle].resident;
+}
+
+bool TextureStreamer::failed(int handle) const
+{
+	return handle >= 0 && handle < (int)entries.size() && entries[handle].failed;
+}
+
+TextureStreamer::Stats TextureStreamer::stats() const
+{
+	lock_guard<mutex> lock(queueMutex);
+	return counters;
+}
+
+static bool readImage(const string& path, RgbaImage& image)
+{
+	string extension = path.substr(min(path.find_last_of('.'), path.size()));
+	transform(extension.begin(), extension.end(), extension.begin(), [](char c) { return (char)tolower((unsigned char)c); });
+	if (extension == ".qoi")
+		return readQOI(path, image);
+	if (extension == ".ppm")
+		return readPPM(path, image);
+	return false;
+}
+
+// decode thread: the pixels and their mips, or the compressed mip chain
+// from the cache or made from them
+void TextureStreamer::decode(Request& request)
+{
+	MipOptions options = mipOptions;
+	options.srgb = request.srgb;
+	uint64_t contentHash = 0, key = 0;
+	bool cached = compress && cache && hashFile(request.path, contentHash);
+	if (cached)
+	{
+		key = CookedTextureCache::key(contentHash, compressFormat, &options);
+		if (cache->load(key, request.compressed) && request.compressed.format == compressFormat)
+		{
+			request.ok = true;
+			lock_guard<mutex> lock(queueMutex);
+			counters.cacheHits++;
+			return;
+		}
+	}
+
+	request.ok = readImage(request.path, request.image);
+	if (!request.ok)
+	{
+		cout << "ERROR::TEXTURE_STREAMER::DECODE_FAILED " << request.path << endl;
+		return;
+	}
+	auto start = Clock::now();
+	generateMips(request.image, options, request.mips);
+	double mipMilliseconds = chrono::duration<double, milli>(Clock::now() - start).count();
+	double compressMilliseconds = 0.0;
+	if (compress)
+	{
+		start = Clock::now();
+		compressTexture(request.image, request.mips, compressFormat, request.compressed);
+		vector<uint32_t>().swap(request.image.pixels);
+		vector<RgbaImage>().swap(request.mips);
+		if (cached && !cache->store(key, request.compressed))
+			cout << "ERROR::TEXTURE_STREAMER::CACHE_WRITE_FAILED " << request.path << endl;
+		compressMilliseconds = chrono::duration<double, milli>(Clock::now() - start).count();
+	}
+	lock_guard<mutex> lock(queueMutex);
+	counters.mipMilliseconds += mipMilliseconds;
+	counters.compressMilliseconds += compressMilliseconds;
+}
+
+void TextureStreamer::decodeLoop()
+{
+	for (;;)
+	{
+		unique_lock<mutex> lock(queueMutex);
+		decodeReady.wait(lock, [this] { return !decodeQueue.empty() || stopping; });
+		if (stopping)
+			break;
+		unique_ptr<Request> request = move(decodeQueue.front());
+		decodeQueue.pop_front();
+		lock.unlock();
+
+		auto start = Clock::now();
+		decode(*request);
+		double milliseconds = chrono::duration<double, milli>(Clock::now() - start).count();
+
+		lock.lock();
+		counters.decodeMilliseconds += milliseconds;
+		if (request->ok)
+		{
+			uploadQueue.push_back(move(request));
+			uploadReady.notify_one();
+		}
+		else
+		{
+			uploaded.push_back(move(request));
+		}
+	}
+}
+
+void TextureStreamer::loaderLoop()
+{
+	glfwMakeContextCurrent(loaderWindow);
+
+	for (;;)
+	{
+		unique_lock<mutex> lock(queueMutex);
+		uploadReady.wait(lock, [this] { return !uploadQueue.empty() || stopping; });
+		if (stopping)
+			break;
+		unique_ptr<Request> request = move(uploadQueue.front());
+		uploadQueue.pop_front();
+		lock.unlock();
+
+		upload(*request);
+
+		lock.lock();
+		uploaded.push_back(move(request));
+	}
+
+	glfwMakeContextCurrent(NULL);
+}
+
+void TextureStreamer::upload(Request& request)
+{
+	auto start = Clock::now();
+	const CompressedTexture& blocks = request.compressed;
+	const bool compressed = blocks.levelCount() > 0;
+	const int width = compressed ? blocks.width : request.image.width;
+	const int height = compressed ? blocks.height : request.image.height;
+	const GLenum internalFormat = compressed ? compressedInternalFormat(blocks.format, request.srgb)
+		: request.srgb ? GL_SRGB8_ALPHA8 : GL_RGBA8;
+	const int levels = compressed ? blocks.levelCount() : 1 + (int)request.mips.size();
+	auto level = [&request](int i) -> const RgbaImage& { return i == 0 ? request.image : request.mips[i - 1]; };
+	size_t bytes = blocks.data.size();
+	if (!compressed)
+	{
+		bytes = 0;
+		for (int i = 0; i < levels; i++)
+			bytes += level(i).pixels.size() * sizeof(uint32_t);
+	}
+
+	// storage first: with an unpack buffer bound the null pointers below
+	// would be offsets into it
+	glGenTextures(1, &request.texture);
+	glBindTexture(GL_TEXTURE_2D, request.texture);
+	if (glext.textureStorage)
+	{
+		glext.TexStorage2D(GL_TEXTURE_2D, levels, internalFormat, width, height);
+	}
+	else if (compressed)
+	{
+		// glCompressedTexImage2D from the unpack buffer below makes the levels
+		glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MAX_LEVEL, levels - 1);
+	}
+	else
+	{
+		for (int i = 0; i < levels; i++)
+			glTexImage2D(GL_TEXTURE_2D, i, internalFormat, level(i).width, level(i).height, 0, GL_RGBA, GL_UNSIGNED_BYTE, NULL);
+		glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MAX_LEVEL, levels - 1);
+	}
+
+	// the oldest staging buffer, free once the upload that last used it is done
+	bool waited = false;
+	StagingBuffer& slot = staging[nextStaging++ % staging.size()];
+	if (slot.fence)
+	{
+		GLenum status = glClientWaitSync(slot.fence, 0, 0);
+		waited = status == GL_TIMEOUT_EXPIRED;
+		while (status == GL_TIMEOUT_EXPIRED)
+			status = glClientWaitSync(slot.fence, 0, 1000000000ull);
+		glDeleteSync(slot.fence);
+		slot.fence = 0;
+	}
+	glBindBuffer(GL_PIXEL_UNPACK_BUFFER, slot.buffer);
+	if (slot.bytes < bytes)
+	{
+		glBufferData(GL_PIXEL_UNPACK_BUFFER, bytes, NULL, GL_STREAM_DRAW);
+		gpuMemory.trackBuffer(slot.buffer, GPU_MEMORY_UPLOAD, bytes);
+		slot.bytes = bytes;
+	}
+	// nothing reads the buffer any more, so no need for the driver to check
+	void* mapped = glMapBufferRange(GL_PIXEL_UNPACK_BUFFER, 0, bytes,
+		GL_MAP_WRITE_BIT | GL_MAP_INVALIDATE_RANGE_BIT | GL_MAP_UNSYNCHRONIZED_BIT);
+	if (mapped && compressed)
+	{
+		memcpy(mapped, blocks.data.data(), bytes);
+		request.ok = glUnmapBuffer(GL_PIXEL_UNPACK_BUFFER) == GL_TRUE;
+	}
+	else if (mapped)
+	{
+		// the levels one after another, largest first
+		uint8_t* out = (uint8_t*)mapped;
+		for (int i = 0; i < levels; i++)
+		{
+			memcpy(out, level(i).pixels.data(), level(i).pixels.size() * sizeof(uint32_t));
+			out += level(i).pixels.size() * sizeof(uint32_t);
+		}
+		request.ok = glUnmapBuffer(GL_PIXEL_UNPACK_BUFFER) == GL_TRUE;
+	}
+	else
+	{
+		request.ok = false;
+	}
+	if (request.ok && compressed)
+	{
+		// every level is already there, each at its offset into the buffer
+		for (int i = 0; i < levels; i++)
+		{
+			const void* offset = (const void*)blocks.levelOffsets[i];
+			if (glext.textureStorage)
+				glCompressedTexSubImage2D(GL_TEXTURE_2D, i, 0, 0, blocks.levelWidth(i), blocks.levelHeight(i),
+					internalFormat, (GLsizei)blocks.levelBytes(i), offset);
+			else
+				glCompressedTexImage2D(GL_TEXTURE_2D, i, internalFormat, blocks.levelWidth(i), blocks.levelHeight(i),
+					0, (GLsizei)blocks.levelBytes(i), offset);
+		}
+	}
+	else if (request.ok)
+	{
+		glPixelStorei(GL_UNPACK_ALIGNMENT, 4);
+		size_t offset = 0;
+		for (int i = 0; i < levels; i++)
+		{
+			glTexSubImage2D(GL_TEXTURE_2D, i, 0, 0, level(i).width, level(i).height, GL_RGBA, GL_UNSIGNED_BYTE, (const void*)offset);
+			offset += level(i).pixels.size() * sizeof(uint32_t);
+		}
+	}
+	glBindBuffer(GL_PIXEL_UNPACK_BUFFER, 0);
+	// the decoded pixels are in the buffer now
+	vector<uint32_t>().swap(request.image.pixels);
+	vector<RgbaImage>().swap(request.mips);
+	vector<uint8_t>().swap(request.compressed.data);
+
+	if (request.ok)
+	{
+		glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MIN_FILTER, GL_LINEAR_MIPMAP_LINEAR);
+		glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MAG_FILTER, GL_LINEAR);
+		glBindTexture(GL_TEXTURE_2D, 0);
+		gpuMemory.trackTexture(request.texture, GPU_MEMORY_TEXTURE, gpuImageBytes(internalFormat, width, height, 1, true));
+		// one fence for the staging buffer, one the render thread deletes
+		slot.fence = glFenceSync(GL_SYNC_GPU_COMMANDS_COMPLETE, 0);
+		request.fence = glFenceSync(GL_SYNC_GPU_COMMANDS_COMPLETE, 0);
+	}
+	else
+	{
+		cout << "ERROR::TEXTURE_STREAMER::MAP_FAILED " << request.path << endl;
+		glBindTexture(GL_TEXTURE_2D, 0);
+		glDeleteTextures(1, &request.texture);
+		request.texture = 0;
+	}
+	// the render thread can only see a fence this context has flushed
+	glFlush();
+
+	double milliseconds = chrono::duration<double, milli>(Clock::now() - start).count();
+	lock_guard<mutex> lock(queueMutex);
+	counters.uploadMilliseconds += milliseconds;
+	if (request.ok)
+	{
+		counters.uploadedBytes += bytes;
+		counters.textureBytes += gpuImageBytes(internalFormat, width, height, 1, true);
+	}
+	if (waited)
+		counters.stagingWaits++;
+}
@@ -0,0 +1,152 @@
+#ifndef TEXTURE_STREAMER_H
+#define TEXTURE_STREAMER_H
+
+#include <condition_variable>
+#include <cstdint>
+#include <deque>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <vector>
+
+#include <glad/glad.h>
+#include <GLFW/glfw3.h>
+
+#include "gl_objects.h"
+#include "image_compare.h"
+#include "mip_generator.h"
+#include "texture_compressor.h"
+
+// Loads textures without the render thread ever waiting for one. load()
+// queues the file and returns a handle at once; a pool of threads decodes
+// it and filters its mip chain with generateMips(), and a loader thread with
+// its own context in the main window's share group copies every level into
+// a pixel unpack buffer, uploads them from there into an immutable
+// glTexStorage2D texture and puts a fence behind it. update() swaps the texture in once that fence has
+// signaled, only asking whether it has. Until then texture() returns a grey
+// and magenta checkerboard, so frames draw with whatever is resident.
+// With setCompression() the decode threads turn each file into a BC1, BC3 or
+// BC7 mip chain instead, or take the one cooked for the same bytes from the
+// cache, and the loader uploads the blocks with glCompressedTexSubImage2D.
+class TextureStreamer
+{
+public:
+	// 0 decode threads for one per core; stagingBuffers pixel unpack
+	// buffers are in flight at most, the loader waits for the oldest
+	explicit TextureStreamer(int decodeThreads = 0, int stagingBuffers = 4);
+	~TextureStreamer();
+
+	TextureStreamer(const TextureStreamer&) = delete;
+	TextureStreamer& operator=(const TextureStreamer&) = delete;
+
+	// compress every texture to format, cooked once per file content under
+	// cacheDirectory, or every time when it's empty; call before start(),
+	// which loads uncompressed when the driver can't sample format
+	void setCompression(BlockFormat format, const std::string& cacheDirectory = "");
+
+	// the filter and alpha cutoff of the mip chains, Kaiser and none unless
+	// set; srgb is load()'s. Call before start().
+	void setMipOptions(const MipOptions& options) { mipOptions = options; }
+
+	// must be called on the main thread with mainWindow's context current
+	bool start(GLFWwindow* mainWindow);
+
+	// drops the loads in progress, stops the threads and deletes every
+	// texture; call before glObjects.release() and glfwTerminate()
+	void stop();
+
+	// .qoi or .ppm, sRGB unless srgb is false; render thread
+	int load(const std::string& path, bool srgb = true);
+
+	// call once per frame on the render thread, never blocks
+	void update();
+
+	// the texture to bind for handle: the placeholder until it's resident
+	// or when it failed to load
+	GLuint texture(int handle) const;
+	bool resident(int handle) const;
+	bool failed(int handle) const;
+	// every load() so far is resident or failed
+	bool idle() const { return settled == entries.size(); }
+
+	struct Stats
+	{
+		uint64_t requested = 0;
+		uint64_t resident = 0;
+		uint64_t failed = 0;
+		uint64_t uploadedBytes = 0;			// mip chains through the staging buffers
+		uint64_t textureBytes = 0;			// GPU memory of the textures uploaded
+		uint64_t cacheHits = 0;				// compressed textures read from the cache
+		uint64_t stagingWaits = 0;			// uploads that waited for a staging buffer
+		double decodeMilliseconds = 0.0;	// summed over the decode threads, mips and compression included
+		double mipMilliseconds = 0.0;		// of that, filtering mip chains
+		double compressMilliseconds = 0.0;	// and compressing
+		double uploadMilliseconds = 0.0;	// loader thread, staging waits included
+		double updateMilliseconds = 0.0;	// render thread in update()
+		double maxUpdateMilliseconds = 0.0;
+	};
+	Stats stats() const;
+
+private:
+	struct Request
+	{
+		int handle;
+		std::string path;
+		bool srgb;
+		RgbaImage image;
+		std::vector<RgbaImage> mips;	// levels 1 and down
+		CompressedTexture compressed;	// instead of image and mips when compressing
+		bool ok = false;
+		GLuint texture = 0;		// made by the loader, the render thread's once fenced
+		GLsync fence = 0;
+	};
+
+	struct Entry
+	{
+		GLTexture texture;
+		bool resident = false;
+		bool failed = false;
+	};
+
+	struct StagingBuffer
+	{
+		GLuint buffer = 0;
+		size_t bytes = 0;
+		GLsync fence = 0;		// behind the last upload from it
+	};
+
+	void decode(Request& request);
+	void decodeLoop();
+	void loaderLoop();
+	void upload(Request& request);
+
+	int decodeThreadCount;
+	bool compress = false;
+	BlockFormat compressFormat = BLOCK_FORMAT_BC1;
+	std::unique_ptr<CookedTextureCache> cache;
+	MipOptions mipOptions;
+	std::vector<StagingBuffer> staging;
+	size_t nextStaging = 0;
+	GLTexture placeholderTexture;
+	GLFWwindow* loaderWindow = nullptr;
+	std::vector<std::thread> decoders;
+	std::thread loader;
+
+	// render thread only
+	std::vector<Entry> entries;
+	std::vector<std::unique_ptr<Request>> fenced;	// uploaded, fence not signaled yet
+	size_t settled = 0;
+
+	mutable std::mutex queueMutex;
+	std::condition_variable decodeReady;
+	std::condition_variable uploadReady;
+	std::deque<std::unique_ptr<Request>> decodeQueue;
+	std::deque<std::unique_ptr<Request>> uploadQueue;
+	std::vector<std::unique_ptr<Request>> uploaded;	// for update() to pick up
+	bool stopping = false;
+
+	Stats counters;
+};
+
+#endif
@@ -0,0 +1,158 @@
+#include "uniform_arena.h"
+#include "gl_ext.h"
+#include "gpu_memory.h"
+
+#include <iostream>
+
+using namespace std;
+
+static size_t alignUp(size_t value, size_t alignment)
+{
+	return (value + alignment - 1) / alignment * alignment;
+}
+
+UniformArena::~UniformArena()
+{
+	release();
+}
+
+bool UniformArena::init(GLenum bufferTarget, size_t bytesPerFrame, int framesInFlight)
+{
+	release();
+	if (framesInFlight < 1 || framesInFlight > (int)(sizeof(fences) / sizeof(fences[0])))
+	{
+		cout << "ERROR::UNIFORM_ARENA::BAD_FRAME_COUNT " << framesInFlight << endl;
+		return false;
+	}
+	if (bufferTarget == GL_SHADER_STORAGE_BUFFER && !glext.shaderStorage)
+	{
+		cout << "ERROR::UNIFORM_ARENA::NO_SHADER_STORAGE" << endl;
+		return false;
+	}
+
+	target = bufferTarget;
+	int alignment = 0;
+	glGetIntegerv(target == GL_SHADER_STORAGE_BUFFER ? GL_SHADER_STORAGE_BUFFER_OFFSET_ALIGNMENT : GL_UNIFORM_BUFFER_OFFSET_ALIGNMENT, &alignment);
+	offsetAlignment = alignment > 0 ? (size_t)alignment : 256;
+	frameSize = alignUp(bytesPerFrame, offsetAlignment);
+	frameCount = framesInFlight;
+	frameIndex = 0;
+	used = flushed = 0;
+	overflows = overflowBytes = 0;
+	size_t totalSize = frameSize * frameCount;
+
+	glGenBuffers(1, &buffer);
+	glBindBuffer(target, buffer);
+	if (glext.bufferStorage)
+	{
+		GLbitfield flags = GL_MAP_WRITE_BIT | GL_MAP_PERSISTENT_BIT | GL_MAP_COHERENT_BIT;
+		glext.BufferStorage(target, totalSize, NULL, flags);
+		mapped = (unsigned char*)glMapBufferRange(target, 0, totalSize, flags);
+	}
+	if (!mapped)
+	{
+		if (glext.bufferStorage)
+		{
+			// the storage is immutable now and glBufferData on it fails: start
+			// over with a new name
+			glDeleteBuffers(1, &buffer);
+			glGenBuffers(1, &buffer);
+			glBindBuffer(target, buffer);
+		}
+		glBufferData(target, totalSize, NULL, GL_STREAM_DRAW);
+		staging = new unsigned char[frameSize];
+	}
+	glBindBuffer(target, 0);
+	gpuMemory.trackBuffer(buffer, target == GL_SHADER_STORAGE_BUFFER ? GPU_MEMORY_STORAGE : GPU_MEMORY_UNIFORM, totalSize);
+	return true;
+}
+
+void UniformArena::release()
+{
+	reportOverflow();
+	for (GLsync& fence : fences)
+	{
+		if (fence)
+			glDeleteSync(fence);
+		fence = 0;
+	}
+	if (mapped)
+	{
+		glBindBuffer(target, buffer);
+		glUnmapBuffer(target);
+		glBindBuffer(target, 0);
+		mapped = nullptr;
+	}
+	if (buffer)
+	{
+		gpuMemory.forgetBuffer(buffer);
+		glDeleteBuffers(1, &buffer);
+		buffer = 0;
+	}
+	delete[] staging;
+	staging = nullptr;
+}
+
+void UniformArena::beginFrame()
+{
+	frameIndex = (frameIndex + 1) % frameCount;
+	used = flushed = 0;
+
+	// the region was last used framesInFlight frames ago, normally long done
+	GLsync& fence = fences[frameIndex];
+	if (fence)
+	{
+		while (glClientWaitSync(fence, GL_SYNC_FLUSH_COMMANDS_BIT, 1000000000) == GL_TIMEOUT_EXPIRED)
+			;
+		glDeleteSync(fence);
+		fence = 0;
+	}
+}
+
+UniformSlice UniformArena::allocate(size_t size)
+{
+	UniformSlice slice;
+	size_t offset = alignUp(used, offsetAlignment);
+	if (offset + size > frameSize)
+	{
+		overflows++;
+		overflowBytes += size;
+		return slice;
+	}
+
+	slice.buffer = buffer;
+	slice.offset = (GLintptr)(frameIndex * frameSize + offset);
+	slice.size = (GLsizeiptr)size;
+	slice.data = mapped ? mapped + slice.offset : staging + offset;
+	used = offset + size;
+	return slice;
+}
+
+void UniformArena::flush()
+{
+	if (mapped || used <= flushed)
+		return;
+
+	glBindBuffer(target, buffer);
+	glBufferSubData(target, frameIndex * frameSize + flushed, used - flushed, staging + flushed);
+	glBindBuffer(target, 0);
+	flushed = used;
+}
+
+void UniformArena::endFrame()
+{
+	flush();
+	fences[frameIndex] = glFenceSync(GL_SYNC_GPU_COMMANDS_COMPLETE, 0);
+	reportOverflow();
+}
+
+void UniformArena::reportOverflow()
+{
+	// once for the frame that ran out, not once per draw that didn't fit
+	if (overflows)
+	{
+		cout << "ERROR::UNIFORM_ARENA::OUT_OF_SPACE " << overflows << " allocations, " << overflowBytes
+			<< " bytes, didn't fit in " << frameSize << " bytes per frame" << endl;
+		overflows = overflowBytes = 0;
+	}
+}
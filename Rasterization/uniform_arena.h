@@ -0,0 +1,91 @@
+#ifndef UNIFORM_ARENA_H
+#define UNIFORM_ARENA_H
+
+#include <cstddef>
+#include <cstring>
+
+#include <glad/glad.h>
+
+// A range of the arena's buffer holding one draw's uniform/storage data,
+// bound with glBindBufferRange instead of setting uniforms one by one.
+struct UniformSlice
+{
+	GLuint buffer = 0;
+	GLintptr offset = 0;
+	GLsizeiptr size = 0;
+	void* data = nullptr;
+};
+
+// Hands out aligned slices of one large buffer, split into a region per
+// frame in flight. Each region is reused only after the fence of the frame
+// that last used it signaled, so writing never stalls on the GPU.
+//
+// With GL_ARB_buffer_storage the buffer is persistently mapped and slices
+// are written in place. Otherwise they are written to CPU memory and
+// flush() uploads the whole frame with one glBufferSubData, so draws that
+// use the slices must be issued after flush():
+//
+//   arena.beginFrame();
+//   UniformSlice slice = arena.push(drawBlock);   // for each draw
+//   arena.flush();
+//   arena.bind(slice, 0); glDrawArrays(...);      // for each draw
+//   arena.endFrame();
+class UniformArena
+{
+public:
+	UniformArena() = default;
+	~UniformArena();
+
+	UniformArena(const UniformArena&) = delete;
+	UniformArena& operator=(const UniformArena&) = delete;
+
+	// target is GL_UNIFORM_BUFFER or GL_SHADER_STORAGE_BUFFER
+	bool init(GLenum target, size_t bytesPerFrame, int framesInFlight = 3);
+	void release();
+
+	void beginFrame();
+	void flush();
+	void endFrame();
+
+	// an empty slice when the frame's region is full, counted and reported
+	// by endFrame(), or release() for a frame that never ended
+	UniformSlice allocate(size_t size);
+
+	template<class T>
+	UniformSlice push(const T& value)
+	{
+		UniformSlice slice = allocate(sizeof(T));
+		if (slice.data)
+			memcpy(slice.data, &value, sizeof(T));
+		return slice;
+	}
+
+	void bind(const UniformSlice& slice, GLuint bindingPoint) const
+	{
+		glBindBufferRange(target, bindingPoint, slice.buffer, slice.offset, slice.size);
+	}
+
+	size_t alignment() const { return offsetAlignment; }
+	size_t bytesUsed() const { return used; }
+	bool persistent() const { return mapped != nullptr; }
+
+private:
+	GLenum target = GL_UNIFORM_BUFFER;
+	GLuint buffer = 0;
+	size_t frameSize = 0;
+	int frameCount = 0;
+	int frameIndex = 0;
+	size_t offsetAlignment = 256;
+	size_t used = 0;
+	size_t flushed = 0;
+	size_t overflows = 0;		// allocations this frame that didn't fit
+	size_t overflowBytes = 0;
+
+	unsigned char* mapped = nullptr;
+	unsigned char* staging = nullptr;
+	GLsync fences[8] = {};
+
+	void reportOverflow();
+};
+
+#endif
@@ -0,0 +1,303 @@
+#include "video_sink.h"
+#include "simd.h"
+
+#include <algorithm>
+#include <chrono>
+#include <cstring>
+#include <iostream>
+#ifdef _WIN32
+#include <fcntl.h>
+#include <io.h>
+#endif
+
+using namespace std;
+
+typedef chrono::high_resolution_clock Clock;
+
+// BT.709 limited range, in 1/16384: Y = 16 + 219/255 * (Kr R + Kg G + Kb B)
+// and U, V = 128 + 224/255 * the scaled differences. Each chroma row sums
+// to 0 so the four pixels of a block can be summed before the multiply.
+static const int Y_R = 2992, Y_G = 10064, Y_B = 1016;
+static const int U_R = -1649, U_G = -5547, U_B = 7196;
+static const int V_R = 7196, V_G = -6536, V_B = -660;
+static const int LUMA_BIAS = (16 << 14) + (1 << 13);
+static const int CHROMA_BIAS = (128 << 16) + (1 << 15);	// 4 pixels, rounded
+
+static SIMD_INLINE int lumaOf(uint32_t p)
+{
+	return (Y_R * (int)(p & 0xff) + Y_G * (int)(p >> 8 & 0xff) + Y_B * (int)(p >> 16 & 0xff) + LUMA_BIAS) >> 14;
+}
+
+// rows y and y + 1 of the output from x0 (even) to the end; row1 == row0
+// and luma1 == nullptr for the last row of an odd height
+static void convertRowsScalar(const uint32_t* row0, const uint32_t* row1, int width, int x0,
+	uint8_t* luma0, uint8_t* luma1, uint8_t* u, uint8_t* v, int chromaStep)
+{
+	for (int x = x0; x < width; x += 2)
+	{
+		const int x1 = min(x + 1, width - 1);
+		const uint32_t block[4] = { row0[x], row0[x1], row1[x], row1[x1] };
+		luma0[x] = (uint8_t)lumaOf(block[0]);
+		if (x + 1 < width)
+			luma0[x + 1] = (uint8_t)lumaOf(block[1]);
+		if (luma1)
+		{
+			luma1[x] = (uint8_t)lumaOf(block[2]);
+			if (x + 1 < width)
+				luma1[x + 1] = (uint8_t)lumaOf(block[3]);
+		}
+
+		int r = 0, g = 0, b = 0;
+		for (uint32_t p : block)
+		{
+			r += p & 0xff;
+			g += p >> 8 & 0xff;
+			b += p >> 16 & 0xff;
+		}
+		const size_t c = (size_t)(x / 2) * chromaStep;
+		u[c] = (uint8_t)((U_R * r + U_G * g + U_B * b + CHROMA_BIAS) >> 16);
+		v[c] = (uint8_t)((V_R * r + V_G * g + V_B * b + CHROMA_BIAS) >> 16);
+	}
+}
+
+void convertFrameYUV420Reference(const CapturedFrame& frame, uint8_t* y, uint8_t* u, uint8_t* v, int chromaStep)
+{
+	const int width = frame.width, height = frame.height;
+	const size_t chromaRow = (size_t)(width + 1) / 2 * chromaStep;
+	for (int row = 0; row < height; row += 2)
+	{
+		// glReadPixels rows are bottom-up, video top-down
+		const uint32_t* in0 = frame.pixels + (size_t)(height - 1 - row) * width;
+		const bool pair = row + 1 < height;
+		convertRowsScalar(in0, pair ? in0 - width : in0, width, 0, y + (size_t)row * width,
+			pair ? y + (size_t)(row + 1) * width : nullptr, u + row / 2 * chromaRow, v + row / 2 * chromaRow, chromaStep);
+	}
+}
+
+#if SIMD_AVX2
+// per pixel sums of coefficient * channel for 8 pixels widened to 16 bits
+// as unpacklo (pixels 0, 1 | 4, 5) and unpackhi (2, 3 | 6, 7); the
+// horizontal add puts them back in order within each half: 0-3 | 4-7
+static SIMD_INLINE __m256i weightedSums(__m256i lo, __m256i hi, __m256i coefficients)
+{
+	return _mm256_hadd_epi32(_mm256_madd_epi16(lo, coefficients), _mm256_madd_epi16(hi, coefficients));
+}
+
+static SIMD_INLINE void storeLuma(uint8_t* out, __m256i sums)
+{
+	__m256i luma = _mm256_srai_epi32(_mm256_add_epi32(sums, _mm256_set1_epi32(LUMA_BIAS)), 14);
+	luma = _mm256_packus_epi16(_mm256_packus_epi32(luma, luma), luma);
+	luma = _mm256_permutevar8x32_epi32(luma, _mm256_setr_epi32(0, 4, 0, 4, 0, 4, 0, 4));
+	_mm_storel_epi64((__m128i*)out, _mm256_castsi256_si128(luma));
+}
+#endif
+
+void convertFrameYUV420(const CapturedFrame& frame, uint8_t* y, uint8_t* u, uint8_t* v, int chromaStep)
+{
+#if SIMD_AVX2
+	const int width = frame.width, height = frame.height;
+	const size_t chromaRow = (size_t)(width + 1) / 2 * chromaStep;
+	const bool planar = chromaStep == 1, interleaved = chromaStep == 2 && v == u + 1;
+	const __m256i zero = _mm256_setzero_si256();
+	const __m256i lumaCoefficients = _mm256_setr_epi16(Y_R, Y_G, Y_B, 0, Y_R, Y_G, Y_B, 0, Y_R, Y_G, Y_B, 0, Y_R, Y_G, Y_B, 0);
+	const __m256i uCoefficients = _mm256_setr_epi16(U_R, U_G, U_B, 0, U_R, U_G, U_B, 0, U_R, U_G, U_B, 0, U_R, U_G, U_B, 0);
+	const __m256i vCoefficients = _mm256_setr_epi16(V_R, V_G, V_B, 0, V_R, V_G, V_B, 0, V_R, V_G, V_B, 0, V_R, V_G, V_B, 0);
+	const __m256i chromaOrder = _mm256_setr_epi32(0, 1, 4, 5, 2, 3, 6, 7);
+
+	int row = 0;
+	for (; row + 1 < height; row += 2)
+	{
+		const uint32_t* in0 = frame.pixels + (size_t)(height - 1 - row) * width;
+		const uint32_t* in1 = in0 - width;
+		uint8_t* luma0 = y + (size_t)row * width;
+		uint8_t* luma1 = luma0 + width;
+		uint8_t* uRow = u + row / 2 * chromaRow;
+		uint8_t* vRow = v + row / 2 * chromaRow;
+		int x = 0;
+		for (; x + 8 <= width; x += 8)
+		{
+			const __m256i p0 = _mm256_loadu_si256((const __m256i*)(in0 + x));
+			const __m256i p1 = _mm256_loadu_si256((const __m256i*)(in1 + x));
+			const __m256i lo0 = _mm256_unpacklo_epi8(p0, zero), hi0 = _mm256_unpackhi_epi8(p0, zero);
+			const __m256i lo1 = _mm256_unpacklo_epi8(p1, zero), hi1 = _mm256_unpackhi_epi8(p1, zero);
+			storeLuma(luma0 + x, weightedSums(lo0, hi0, lumaCoefficients));
+			storeLuma(luma1 + x, weightedSums(lo1, hi1, lumaCoefficients));
+
+			// columns summed over both rows, then adjacent columns: u0 u1 v0 v1 | u2 u3 v2 v3
+			const __m256i lo = _mm256_add_epi16(lo0, lo1), hi = _mm256_add_epi16(hi0, hi1);
+			__m256i chroma = _mm256_hadd_epi32(weightedSums(lo, hi, uCoefficients), weightedSums(lo, hi, vCoefficients));
+			chroma = _mm256_srai_epi32(_mm256_add_epi32(chroma, _mm256_set1_epi32(CHROMA_BIAS)), 16);
+			chroma = _mm256_permutevar8x32_epi32(chroma, chromaOrder);
+			chroma = _mm256_packus_epi16(_mm256_packus_epi32(chroma, chroma), chroma);
+			const __m128i uBytes = _mm256_castsi256_si128(chroma), vBytes = _mm256_extracti128_si256(chroma, 1);
+			const size_t c = (size_t)(x / 2) * chromaStep;
+			if (interleaved)
+			{
+				_mm_storel_epi64((__m128i*)(uRow + c), _mm_unpacklo_epi8(uBytes, vBytes));
+			}
+			else if (planar)
+			{
+				const int uWord = _mm_cvtsi128_si32(uBytes), vWord = _mm_cvtsi128_si32(vBytes);
+				memcpy(uRow + c, &uWord, 4);
+				memcpy(vRow + c, &vWord, 4);
+			}
+			else
+			{
+				for (int i = 0; i < 4; i++)
+				{
+					uRow[c + (size_t)i * chromaStep] = (uint8_t)(_mm_cvtsi128_si32(uBytes) >> (i * 8));
+					vRow[c + (size_t)i * chromaStep] = (uint8_t)(_mm_cvtsi128_si32(vBytes) >> (i * 8));
+				}
+			}
+		}
+		convertRowsScalar(in0, in1, width, x, luma0, luma1, uRow, vRow, chromaStep);
+	}
+	if (row < height)
+	{
+		const uint32_t* in0 = frame.pixels;
+		convertRowsScalar(in0, in0, width, 0, y + (size_t)row * width, nullptr, u + row / 2 * chromaRow,
+			v + row / 2 * chromaRow, chromaStep);
+	}
+#else
+	convertFrameYUV420Reference(frame, y, u, v, chromaStep);
+#endif
+}
+
+VideoSink::VideoSink(const string& outputPath, VideoLayout videoLayout, int fps)
+	: path(outputPath), layout(videoLayout), framesPerSecond(max(fps, 1))
+{
+	if (path == "-")
+	{
+#ifdef _WIN32
+		_setmode(_fileno(stdout), _O_BINARY);
+#endif
+		file = stdout;
+	}
+	else if (!path.empty())
+	{
+		file = fopen(path.c_str(), "wb");
+		if (!file)
+		{
+			cout << "ERROR::VIDEO::OPEN_FAILED " << path << endl;
+			failed = true;
+		}
+	}
+	writer = thread(&VideoSink::writerLoop, this);
+}
+
+VideoSink::~VideoSink()
+{
+	finish();
+}
+
+void VideoSink::consume(const CapturedFrame& frame)
+{
+	if (width == 0)
+	{
+		width = frame.width;
+		height = frame.height;
+		const size_t bytes = (size_t)width * height + (size_t)(width + 1) / 2 * ((height + 1) / 2) * 2;
+		buffers[0].resize(bytes);
+		buffers[1].resize(bytes);
+	}
+	if (frame.width != width || frame.height != height)
+	{
+		if (!sizeChanged)
+			cout << "ERROR::VIDEO::FRAME_SIZE_CHANGED " << frame.width << "x" << frame.height << endl;
+		sizeChanged = true;
+		return;
+	}
+
+	auto start = Clock::now();
+	uint8_t* luma = buffers[next].data();
+	uint8_t* chroma = luma + (size_t)width * height;
+	if (layout == VIDEO_LAYOUT_NV12)
+		convertFrameYUV420(frame, luma, chroma, chroma + 1, 2);
+	else
+		convertFrameYUV420(frame, luma, chroma, chroma + (size_t)(width + 1) / 2 * ((height + 1) / 2), 1);
+	auto converted = Clock::now();
+
+	unique_lock<mutex> lock(writeMutex);
+	if (pendingBuffer >= 0)
+	{
+		counters.writeWaits++;
+		written.wait(lock, [this] { return pendingBuffer < 0; });
+	}
+	counters.frames++;
+	counters.convertMilliseconds += chrono::duration<double, milli>(converted - start).count();
+	counters.waitMilliseconds += chrono::duration<double, milli>(Clock::now() - converted).count();
+	pendingBuffer = next;
+	next ^= 1;
+	pending.notify_one();
+}
+
+void VideoSink::finish()
+{
+	if (!writer.joinable())
+		return;
+	{
+		lock_guard<mutex> lock(writeMutex);
+		stopping = true;
+	}
+	pending.notify_one();
+	writer.join();
+	if (file == stdout)
+		fflush(stdout);
+	else if (file)
+		fclose(file);
+	file = nullptr;
+}
+
+VideoSink::Stats VideoSink::stats() const
+{
+	lock_guard<mutex> lock(writeMutex);
+	return counters;
+}
+
+void VideoSink::writerLoop()
+{
+	bool headerWritten = false;
+	for (;;)
+	{
+		int buffer;
+		{
+			unique_lock<mutex> lock(writeMutex);
+			pending.wait(lock, [this] { return pendingBuffer >= 0 || stopping; });
+			if (pendingBuffer < 0)
+				return;
+			buffer = pendingBuffer;
+		}
+
+		// writes go straight from the buffer; only this thread touches file
+		const vector<uint8_t>& data = buffers[buffer];
+		bool ok = true;
+		size_t bytes = data.size();
+		if (file && !failed)
+		{
+			if (layout == VIDEO_LAYOUT_Y4M)
+			{
+				char header[96];
+				int length = 0;
+				if (!headerWritten)
+					length = snprintf(header, sizeof(header), "YUV4MPEG2 W%d H%d F%d:1 Ip A1:1 C420jpeg XYSCSS=420JPEG\n",
+						width, height, framesPerSecond);
+				length += snprintf(header + length, sizeof(header) - length, "FRAME\n");
+				ok = fwrite(header, 1, length, file) == (size_t)length;
+				bytes += length;
+				headerWritten = true;
+			}
+			ok = ok && fwrite(data.data(), 1, data.size(), file) == data.size();
+		}
+
+		lock_guard<mutex> lock(writeMutex);
+		if (!ok && !failed)
+		{
+			// a closed pipe ends up here too, e.g. when the encoder quits early
+			cout << "ERROR::VIDEO::WRITE_FAILED " << path << endl;
+			failed = true;
+		}
+		counters.bytes += bytes;
+		pendingBuffer = -1;
+		written.notify_one();
+	}
+}
@@ -0,0 +1,82 @@
+#ifndef VIDEO_SINK_H
+#define VIDEO_SINK_H
+
+#include <condition_variable>
+#include <cstdint>
+#include <cstdio>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <vector>
+
+#include "frame_capture.h"
+
+enum VideoLayout
+{
+	VIDEO_LAYOUT_Y4M,	// YUV4MPEG2 stream, planar 4:2:0, what ffmpeg -f yuv4mpegpipe reads
+	VIDEO_LAYOUT_NV12,	// raw frames, luma then interleaved U/V; ffmpeg needs -f rawvideo -pix_fmt nv12 -s WxH
+};
+
+// BT.709 limited range 4:2:0 from a captured RGBA frame, rows top-down. Each
+// chroma sample is the average of a 2x2 block (centered, like C420jpeg); odd
+// sizes repeat the last row and column. u and v advance by chromaStep per
+// sample: 1 for planar I420, 2 with v = u + 1 for NV12.
+void convertFrameYUV420(const CapturedFrame& frame, uint8_t* y, uint8_t* u, uint8_t* v, int chromaStep);
+// the same one pixel at a time, for checking the SIMD path
+void convertFrameYUV420Reference(const CapturedFrame& frame, uint8_t* y, uint8_t* u, uint8_t* v, int chromaStep);
+
+// A FrameSink that streams frames as raw video into a file, or into stdout
+// when path is "-" so it can be piped into an encoder. Two frame buffers:
+// consume() converts into one while a writer thread pushes the other out,
+// so conversion overlaps the write and consume() only waits when the
+// pipe is more than a frame behind. Every frame must have the size of the
+// first. An empty path converts without writing, for benchmarks.
+class VideoSink : public FrameSink
+{
+public:
+	VideoSink(const std::string& path, VideoLayout layout, int framesPerSecond = 60);
+	~VideoSink();
+
+	VideoSink(const VideoSink&) = delete;
+	VideoSink& operator=(const VideoSink&) = delete;
+
+	void consume(const CapturedFrame& frame) override;
+	// waits for the last frame to be written and closes the file
+	void finish() override;
+
+	struct Stats
+	{
+		uint64_t frames = 0;
+		uint64_t writeWaits = 0;			// consume() calls that waited for the writer
+		double convertMilliseconds = 0.0;
+		double waitMilliseconds = 0.0;
+		uint64_t bytes = 0;
+	};
+	Stats stats() const;
+
+private:
+	void writerLoop();
+
+	std::string path;
+	VideoLayout layout;
+	int framesPerSecond;
+	FILE* file = nullptr;
+	int width = 0;
+	int height = 0;
+
+	// buffers[next] belongs to consume(), the other one to the writer while pending
+	std::vector<uint8_t> buffers[2];
+	int next = 0;
+	std::thread writer;
+	mutable std::mutex writeMutex;
+	std::condition_variable written;
+	std::condition_variable pending;
+	int pendingBuffer = -1;
+	bool stopping = false;
+	bool failed = false;			// written by the writer thread
+	bool sizeChanged = false;		// consume() only
+
+	Stats counters;
+};
+
+#endif
@@ -0,0 +1,742 @@
+#include "virtual_texture.h"
+#include "gpu_memory.h"
+
+#include <algorithm>
+#include <chrono>
+#include <cmath>
+#include <iostream>
+#include <iterator>
+
+using namespace std;
+
+typedef chrono::high_resolution_clock Clock;
+
+// pages queued for the loaders at once; the queue is rebuilt from every
+// feedback, so this only bounds how far ahead they can get
+static const size_t MAX_QUEUED_TILES = 256;
+static const int FEEDBACK_RING_SIZE = 3;
+
+// the coarsest octave of the terrain, in texels of level 0
+static const int TERRAIN_LARGEST_WAVELENGTH = 8192;
+
+// level in the top byte, then 12 bits of y and 12 of x
+static inline uint32_t pageKey(int level, int x, int y)
+{
+	return (uint32_t)level << 24 | (uint32_t)y << 12 | (uint32_t)x;
+}
+
+static inline int pageLevel(uint32_t page) { return (int)(page >> 24); }
+static inline int pageX(uint32_t page) { return (int)(page & 0xfff); }
+static inline int pageY(uint32_t page) { return (int)((page >> 12) & 0xfff); }
+
+// the level of the page a page table entry points at
+static inline int entryLevel(uint32_t entry) { return (int)((entry >> 16) & 0xff); }
+
+// a tile is its page's texels and the border around them
+static void readTile(const VirtualTextureSource& source, uint32_t page, uint32_t* texels)
+{
+	source.readTexels(pageLevel(page), pageX(page) * VIRTUAL_TILE_CONTENT - VIRTUAL_TILE_BORDER,
+		pageY(page) * VIRTUAL_TILE_CONTENT - VIRTUAL_TILE_BORDER, VIRTUAL_TILE_SIZE, VIRTUAL_TILE_SIZE, texels);
+}
+
+static inline uint32_t hashLattice(int x, int y, uint32_t seed)
+{
+	uint32_t h = (uint32_t)x * 0x8da6b343u ^ (uint32_t)y * 0xd8163841u ^ seed * 0xcb1ab31fu;
+	h ^= h >> 15;
+	h *= 0x2c1b3c6du;
+	h ^= h >> 12;
+	h *= 0x297a2d39u;
+	h ^= h >> 15;
+	return h;
+}
+
+// value noise in [-1, 1] with cells wavelength texels of level 0 wide
+static float valueNoise(double x, double y, int wavelength, uint32_t seed)
+{
+	double fx = x / wavelength, fy = y / wavelength;
+	double cx = floor(fx), cy = floor(fy);
+	float tx = (float)(fx - cx), ty = (float)(fy - cy);
+	int ix = (int)cx, iy = (int)cy;
+	// quintic fade: no creases along the cell edges
+	tx = tx * tx * tx * (tx * (tx * 6.0f - 15.0f) + 10.0f);
+	ty = ty * ty * ty * (ty * (ty * 6.0f - 15.0f) + 10.0f);
+	const float scale = 2.0f / 4294967295.0f;
+	float a = hashLattice(ix, iy, seed) * scale - 1.0f;
+	float b = hashLattice(ix + 1, iy, seed) * scale - 1.0f;
+	float c = hashLattice(ix, iy + 1, seed) * scale - 1.0f;
+	float d = hashLattice(ix + 1, iy + 1, seed) * scale - 1.0f;
+	return a + (b - a) * tx + (c - a) * ty + (a - b - c + d) * tx * ty;
+}
+
+struct TerrainBand
+{
+	float height;
+	float rgb[3];
+};
+
+// sRGB colors by height, mixed linearly in between
+static const TerrainBand TERRAIN_BANDS[] =
+{
+	{ -1.0f, { 15.0f, 35.0f, 90.0f } },		// deep water
+	{ -0.22f, { 40.0f, 100.0f, 150.0f } },	// shallows
+	{ -0.16f, { 194.0f, 178.0f, 128.0f } },	// sand
+	{ -0.1f, { 70.0f, 115.0f, 45.0f } },	// grass
+	{ 0.25f, { 95.0f, 110.0f, 55.0f } },
+	{ 0.4f, { 115.0f, 105.0f, 95.0f } },	// rock
+	{ 0.55f, { 135.0f, 130.0f, 125.0f } },
+	{ 0.65f, { 235.0f, 235.0f, 240.0f } },	// snow
+};
+
+ProceduralTerrainSource::ProceduralTerrainSource(int pages, uint32_t terrainSeed)
+	: pageCount(pages), seed(terrainSeed)
+{
+}
+
+void ProceduralTerrainSource::readTexels(int level, int x, int y, int width, int height, uint32_t* texels) const
+{
+	const int size = max(pageCount >> level, 1) * VIRTUAL_TILE_CONTENT;
+	const double texel = (double)(1 << level);
+	const int bandCount = (int)(sizeof(TERRAIN_BANDS) / sizeof(TERRAIN_BANDS[0]));
+	for (int j = 0; j < height; j++)
+	{
+		double py = (min(max(y + j, 0), size - 1) + 0.5) * texel;
+		for (int i = 0; i < width; i++)
+		{
+			double px = (min(max(x + i, 0), size - 1) + 0.5) * texel;
+			// 1/f octaves, the coarse ones shaping the land and the fine ones
+			// shading it; an octave fades out between 4 and 2 texels of this
+			// level and the finer ones are left out, which is what its mip
+			// would have averaged away
+			float shape = 0.0f, detail = 0.0f;
+			for (int wavelength = TERRAIN_LARGEST_WAVELENGTH; wavelength >= 2; wavelength /= 2)
+			{
+				float fade = min(max((float)(wavelength / texel) * 0.5f - 1.0f, 0.0f), 1.0f);
+				if (fade <= 0.0f)
+					break;
+				float n = valueNoise(px, py, wavelength, seed + (uint32_t)wavelength) * fade;
+				if (wavelength >= 256)
+					shape += n * wavelength / TERRAIN_LARGEST_WAVELENGTH;
+				else
+					detail += n * wavelength / 128.0f;
+			}
+			float h = shape * 0.6f;
+
+			int band = 0;
+			while (band + 2 < bandCount && h >= TERRAIN_BANDS[band + 1].height)
+				band++;
+			const TerrainBand& low = TERRAIN_BANDS[band];
+			const TerrainBand& high = TERRAIN_BANDS[band + 1];
+			float t = min(max((h - low.height) / (high.height - low.height), 0.0f), 1.0f);
+			// water stays smooth, land gets the fine octaves as light and shade
+			float shade = 1.0f + (h < TERRAIN_BANDS[2].height ? 0.05f : 0.25f) * detail;
+			uint32_t pixel = 0xff000000u;
+			for (int c = 0; c < 3; c++)
+			{
+				float value = (low.rgb[c] + (high.rgb[c] - low.rgb[c]) * t) * shade;
+				pixel |= (uint32_t)min(max(value + 0.5f, 0.0f), 255.0f) << (c * 8);
+			}
+			texels[(size_t)j * width + i] = pixel;
+		}
+	}
+}
+
+ImageTileSource::ImageTileSource(const RgbaImage& image, const MipOptions& options, JobSystem* jobs)
+	: pageCount(1)
+{
+	while (pageCount * VIRTUAL_TILE_CONTENT < max(image.width, image.height) && pageCount < MAX_VIRTUAL_PAGES)
+		pageCount *= 2;
+	const int size = pageCount * VIRTUAL_TILE_CONTENT;
+	RgbaImage padded;
+	padded.resize(size, size);
+	for (int y = 0; y < size; y++)
+	{
+		const uint32_t* row = image.row(min(y, image.height - 1));
+		uint32_t* out = padded.row(y);
+		for (int x = 0; x < size; x++)
+			out[x] = row[min(x, image.width - 1)];
+	}
+	vector<RgbaImage> lower;
+	generateMips(padded, options, lower, jobs);
+	mips.push_back(move(padded));
+	mips.insert(mips.end(), make_move_iterator(lower.begin()), make_move_iterator(lower.end()));
+}
+
+void ImageTileSource::readTexels(int level, int x, int y, int width, int height, uint32_t* texels) const
+{
+	const RgbaImage& mip = mips[min(level, (int)mips.size() - 1)];
+	for (int j = 0; j < height; j++)
+	{
+		const uint32_t* row = mip.row(min(max(y + j, 0), mip.height - 1));
+		for (int i = 0; i < width; i++)
+			texels[(size_t)j * width + i] = row[min(max(x + i, 0), mip.width - 1)];
+	}
+}
+
+VirtualTexture::VirtualTexture(const VirtualTextureSource& textureSource, int tiles, int loaderThreads, int uploads)
+	: source(textureSource), pageCount(textureSource.pages()), levelCount(0), physicalTiles(max(tiles, 2)),
+	loaderThreadCount(loaderThreads > 0 ? loaderThreads : (int)max(1u, thread::hardware_concurrency())),
+	uploadsPerFrame(max(uploads, 1))
+{
+	while (levelCount < 31 && (1 << levelCount) <= pageCount)
+		levelCount++;
+}
+
+VirtualTexture::~VirtualTexture()
+{
+	release();
+}
+
+bool VirtualTexture::init()
+{
+	if (pageCount < 1 || pageCount > MAX_VIRTUAL_PAGES || (pageCount & (pageCount - 1)) != 0)
+	{
+		cout << "ERROR::VIRTUAL_TEXTURE::BAD_PAGE_COUNT " << pageCount << " pages, needs a power of two up to "
+			<< MAX_VIRTUAL_PAGES << endl;
+		return false;
+	}
+	// slot coordinates are a byte each in the page table
+	GLint maxSize = 0;
+	glGetIntegerv(GL_MAX_TEXTURE_SIZE, &maxSize);
+	physicalTiles = min(physicalTiles, min(256, (int)maxSize / VIRTUAL_TILE_SIZE));
+	const int atlasSize = physicalTiles * VIRTUAL_TILE_SIZE;
+
+	// sRGB so the bilinear filter blends light, not its encoding
+	atlas = GLTexture::create();
+	glBindTexture(GL_TEXTURE_2D, atlas.get());
+	glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MIN_FILTER, GL_LINEAR);
+	glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MAG_FILTER, GL_LINEAR);
+	glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_WRAP_S, GL_CLAMP_TO_EDGE);
+	glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_WRAP_T, GL_CLAMP_TO_EDGE);
+	glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MAX_LEVEL, 0);
+	glTexImage2D(GL_TEXTURE_2D, 0, GL_SRGB8_ALPHA8, atlasSize, atlasSize, 0, GL_RGBA, GL_UNSIGNED_BYTE, NULL);
+	gpuMemory.trackTexture(atlas.get(), GPU_MEMORY_TEXTURE, gpuImageBytes(GL_SRGB8_ALPHA8, atlasSize, atlasSize));
+
+	// every entry of the page table starts out pointing nowhere, level 255,
+	// until install() of the coarsest page below covers them all
+	pageTable.assign(levelCount, vector<uint32_t>());
+	dirty.assign(levelCount, DirtyRect());
+	pageTableTexture = GLTexture::create();
+	glBindTexture(GL_TEXTURE_2D, pageTableTexture.get());
+	glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MIN_FILTER, GL_NEAREST_MIPMAP_NEAREST);
+	glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MAG_FILTER, GL_NEAREST);
+	glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MAX_LEVEL, levelCount - 1);
+	for (int level = 0; level < levelCount; level++)
+	{
+		int width = pageCount >> level;
+		pageTable[level].assign((size_t)width * width, 0xffffffffu);
+		glTexImage2D(GL_TEXTURE_2D, level, GL_RGBA8, width, width, 0, GL_RGBA, GL_UNSIGNED_BYTE, NULL);
+	}
+	gpuMemory.trackTexture(pageTableTexture.get(), GPU_MEMORY_TEXTURE, gpuImageBytes(GL_RGBA8, pageCount, pageCount, 1, true));
+
+	// slot 0 holds the coarsest page for good, the rest are the LRU list,
+	// empty ones at the tail
+	slots.assign((size_t)physicalTiles * physicalTiles, Slot());
+	lruHead = lruTail = -1;
+	feedbackIndex = 0;
+	for (int i = 0; i < (int)slots.size(); i++)
+	{
+		slots[i].page = NO_PAGE;
+		if (i > 0)
+			touch(i);
+	}
+	lastFeedbackComplete = false;
+
+	// the loaders read into these and nothing else
+	tileBuffers.assign(loaderThreadCount + 2 * uploadsPerFrame, vector<uint32_t>((size_t)VIRTUAL_TILE_SIZE * VIRTUAL_TILE_SIZE));
+	freeBuffers.clear();
+	for (int i = 0; i < (int)tileBuffers.size(); i++)
+		freeBuffers.push_back(i);
+	loaded.clear();
+	loaded.reserve(tileBuffers.size());
+	uploading.reserve(tileBuffers.size());
+	loadQueue.clear();
+	loadQueue.reserve(MAX_QUEUED_TILES);
+	queueHead = 0;
+	loading.assign(loaderThreadCount, NO_PAGE);
+
+	uint32_t top = pageKey(levelCount - 1, 0, 0);
+	readTile(source, top, tileBuffers[0].data());
+	glBindTexture(GL_TEXTURE_2D, atlas.get());
+	glPixelStorei(GL_UNPACK_ALIGNMENT, 4);
+	glTexSubImage2D(GL_TEXTURE_2D, 0, 0, 0, VIRTUAL_TILE_SIZE, VIRTUAL_TILE_SIZE, GL_RGBA, GL_UNSIGNED_BYTE, tileBuffers[0].data());
+	glBindTexture(GL_TEXTURE_2D, 0);
+	install(top, 0);
+	uploadPageTable();
+
+	feedbackRing.clear();
+	feedbackRing.resize(FEEDBACK_RING_SIZE);
+	for (FeedbackBuffer& buffer : feedbackRing)
+		buffer.buffer = GLBuffer::create();
+	feedbackIssued = feedbackConsumed = 0;
+
+	counters = Stats();
+	counters.atlasBytes = gpuImageBytes(GL_SRGB8_ALPHA8, atlasSize, atlasSize);
+	counters.pageTableBytes = gpuImageBytes(GL_RGBA8, pageCount, pageCount, 1, true);
+	stopping = false;
+	for (int i = 0; i < loaderThreadCount; i++)
+		loaders.push_back(thread(&VirtualTexture::loaderLoop, this, i));
+	return true;
+}
+
+void VirtualTexture::release()
+{
+	{
+		lock_guard<mutex> lock(queueMutex);
+		stopping = true;
+	}
+	loadReady.notify_all();
+	for (thread& loader : loaders)
+		loader.join();
+	loaders.clear();
+
+	for (FeedbackBuffer& buffer : feedbackRing)
+	{
+		if (buffer.fence)
+			glDeleteSync(buffer.fence);
+	}
+	feedbackRing.clear();
+	feedbackFramebuffer.reset();
+	feedbackColor.reset();
+	feedbackDepth.reset();
+	feedbackWidth = feedbackHeight = 0;
+	pageTableTexture.reset();
+	atlas.reset();
+}
+
+void VirtualTexture::beginFeedback(int width, int height)
+{
+	screenWidth = width;
+	screenHeight = height;
+	int targetWidth = max(width / FEEDBACK_DIVISOR, 1), targetHeight = max(height / FEEDBACK_DIVISOR, 1);
+	if (targetWidth != feedbackWidth || targetHeight != feedbackHeight)
+	{
+		feedbackColor = GLTexture::create();
+		glBindTexture(GL_TEXTURE_2D, feedbackColor.get());
+		glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MIN_FILTER, GL_NEAREST);
+		glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MAG_FILTER, GL_NEAREST);
+		glTexImage2D(GL_TEXTURE_2D, 0, GL_RGBA8, targetWidth, targetHeight, 0, GL_RGBA, GL_UNSIGNED_BYTE, NULL);
+		gpuMemory.trackTexture(feedbackColor.get(), GPU_MEMORY_RENDER_TARGET, gpuImageBytes(GL_RGBA8, targetWidth, targetHeight));
+		feedbackDepth = GLTexture::create();
+		glBindTexture(GL_TEXTURE_2D, feedbackDepth.get());
+		glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MIN_FILTER, GL_NEAREST);
+		glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MAG_FILTER, GL_NEAREST);
+		glTexImage2D(GL_TEXTURE_2D, 0, GL_DEPTH_COMPONENT24, targetWidth, targetHeight, 0, GL_DEPTH_COMPONENT, GL_UNSIGNED_INT, NULL);
+		gpuMemory.trackTexture(feedbackDepth.get(), GPU_MEMORY_RENDER_TARGET,
+			gpuImageBytes(GL_DEPTH_COMPONENT24, targetWidth, targetHeight));
+		glBindTexture(GL_TEXTURE_2D, 0);
+
+		feedbackFramebuffer = GLFramebuffer::create();
+		glBindFramebuffer(GL_FRAMEBUFFER, feedbackFramebuffer.get());
+		glFramebufferTexture2D(GL_FRAMEBUFFER, GL_COLOR_ATTACHMENT0, GL_TEXTURE_2D, feedbackColor.get(), 0);
+		glFramebufferTexture2D(GL_FRAMEBUFFER, GL_DEPTH_ATTACHMENT, GL_TEXTURE_2D, feedbackDepth.get(), 0);
+		if (glCheckFramebufferStatus(GL_FRAMEBUFFER) != GL_FRAMEBUFFER_COMPLETE)
+			cout << "ERROR::VIRTUAL_TEXTURE::FEEDBACK_FRAMEBUFFER_INCOMPLETE" << endl;
+		feedbackWidth = targetWidth;
+		feedbackHeight = targetHeight;
+
+		// the free readback buffers get their storage now rather than over
+		// the next frames; one still in flight is resized once it's reused
+		size_t bytes = (size_t)feedbackWidth * feedbackHeight * 4;
+		for (FeedbackBuffer& buffer : feedbackRing)
+		{
+			if (buffer.fence || buffer.bytes == bytes)
+				continue;
+			glBindBuffer(GL_PIXEL_PACK_BUFFER, buffer.buffer.get());
+			glBufferData(GL_PIXEL_PACK_BUFFER, bytes, NULL, GL_STREAM_READ);
+			gpuMemory.trackBuffer(buffer.buffer.get(), GPU_MEMORY_READBACK, bytes);
+			buffer.bytes = bytes;
+		}
+		glBindBuffer(GL_PIXEL_PACK_BUFFER, 0);
+	}
+
+	glBindFramebuffer(GL_FRAMEBUFFER, feedbackFramebuffer.get());
+	glViewport(0, 0, feedbackWidth, feedbackHeight);
+	// alpha 255 is a level no page has: nothing drawn there
+	glClearColor(0.0f, 0.0f, 0.0f, 1.0f);
+	glClear(GL_COLOR_BUFFER_BIT | GL_DEPTH_BUFFER_BIT);
+}
+
+void VirtualTexture::endFeedback()
+{
+	if (feedbackIssued - feedbackConsumed == feedbackRing.size())
+	{
+		counters.feedbackDropped++;
+	}
+	else
+	{
+		FeedbackBuffer& buffer = feedbackRing[feedbackIssued % feedbackRing.size()];
+		glBindBuffer(GL_PIXEL_PACK_BUFFER, buffer.buffer.get());
+		size_t bytes = (size_t)feedbackWidth * feedbackHeight * 4;
+		if (buffer.bytes != bytes)
+		{
+			glBufferData(GL_PIXEL_PACK_BUFFER, bytes, NULL, GL_STREAM_READ);
+			gpuMemory.trackBuffer(buffer.buffer.get(), GPU_MEMORY_READBACK, bytes);
+			buffer.bytes = bytes;
+		}
+		buffer.width = feedbackWidth;
+		buffer.height = feedbackHeight;
+		glPixelStorei(GL_PACK_ALIGNMENT, 4);
+		glReadPixels(0, 0, feedbackWidth, feedbackHeight, GL_RGBA, GL_UNSIGNED_BYTE, (void*)0);
+		glBindBuffer(GL_PIXEL_PACK_BUFFER, 0);
+		buffer.fence = glFenceSync(GL_SYNC_GPU_COMMANDS_COMPLETE, 0);
+		feedbackIssued++;
+	}
+	glBindFramebuffer(GL_FRAMEBUFFER, 0);
+	glViewport(0, 0, screenWidth, screenHeight);
+}
+
+void VirtualTexture::update()
+{
+	auto start = Clock::now();
+
+	// fences signal in order: skip to the newest readback that is done,
+	// older ones only name pages of frames already gone
+	FeedbackBuffer* ready = nullptr;
+	while (feedbackConsumed < feedbackIssued)
+	{
+		FeedbackBuffer& buffer = feedbackRing[feedbackConsumed % feedbackRing.size()];
+		GLenum status = glClientWaitSync(buffer.fence, GL_SYNC_FLUSH_COMMANDS_BIT, 0);
+		if (status == GL_TIMEOUT_EXPIRED)
+			break;
+		glDeleteSync(buffer.fence);
+		buffer.fence = 0;
+		feedbackConsumed++;
+		ready = status == GL_WAIT_FAILED ? nullptr : &buffer;
+	}
+	if (ready)
+	{
+		glBindBuffer(GL_PIXEL_PACK_BUFFER, ready->buffer.get());
+		const void* pixels = glMapBufferRange(GL_PIXEL_PACK_BUFFER, 0, ready->bytes, GL_MAP_READ_BIT);
+		if (pixels)
+		{
+			processFeedback((const uint32_t*)pixels, (size_t)ready->width * ready->height);
+			glUnmapBuffer(GL_PIXEL_PACK_BUFFER);
+		}
+		glBindBuffer(GL_PIXEL_PACK_BUFFER, 0);
+	}
+
+	uploadTiles();
+	uploadPageTable();
+
+	double milliseconds = chrono::duration<double, milli>(Clock::now() - start).count();
+	lock_guard<mutex> lock(queueMutex);
+	counters.updateMilliseconds += milliseconds;
+	counters.maxUpdateMilliseconds = max(counters.maxUpdateMilliseconds, milliseconds);
+}
+
+void VirtualTexture::bind(GLuint program, bool feedback) const
+{
+	glActiveTexture(GL_TEXTURE0);
+	glBindTexture(GL_TEXTURE_2D, pageTableTexture.get());
+	glActiveTexture(GL_TEXTURE1);
+	glBindTexture(GL_TEXTURE_2D, atlas.get());
+	glActiveTexture(GL_TEXTURE0);
+	glUniform1i(glGetUniformLocation(program, "pageTable"), 0);
+	glUniform1i(glGetUniformLocation(program, "atlas"), 1);
+	glUniform1i(glGetUniformLocation(program, "pages"), pageCount);
+	glUniform1i(glGetUniformLocation(program, "maxLevel"), levelCount - 1);
+	glUniform1f(glGetUniformLocation(program, "atlasTiles"), (float)physicalTiles);
+	// the feedback target's texels are FEEDBACK_DIVISOR pixels wide: the
+	// derivatives come out that much larger
+	glUniform1f(glGetUniformLocation(program, "lodBias"), feedback ? -log2f((float)FEEDBACK_DIVISOR) : 0.0f);
+}
+
+bool VirtualTexture::settled() const
+{
+	lock_guard<mutex> lock(queueMutex);
+	if (!lastFeedbackComplete || queueHead < loadQueue.size() || !loaded.empty())
+		return false;
+	for (uint32_t page : loading)
+	{
+		if (page != NO_PAGE)
+			return false;
+	}
+	return true;
+}
+
+VirtualTexture::Stats VirtualTexture::stats() const
+{
+	Stats result;
+	{
+		lock_guard<mutex> lock(queueMutex);
+		result = counters;
+	}
+	result.slots = (int)slots.size();
+	for (const Slot& slot : slots)
+		result.residentTiles += slot.page != NO_PAGE ? 1 : 0;
+	return result;
+}
+
+void VirtualTexture::processFeedback(const uint32_t* pixels, size_t count)
+{
+	// feedback pixels are x and y's low bytes, their high nibbles, and the level
+	requested.clear();
+	for (size_t i = 0; i < count; i++)
+	{
+		uint32_t pixel = pixels[i];
+		int level = (int)(pixel >> 24);
+		if (level >= levelCount)
+			continue;
+		int x = (int)(pixel & 0xff) | (int)((pixel >> 16) & 0xf) << 8;
+		int y = (int)((pixel >> 8) & 0xff) | (int)((pixel >> 20) & 0xf) << 8;
+		requested.push_back(pageKey(level, x, y));
+	}
+	sort(requested.begin(), requested.end());
+	requested.erase(unique(requested.begin(), requested.end()), requested.end());
+
+	// a page in use keeps its ancestors, what the draw falls back to; the
+	// ones missing are loaded too, so a fallback arrives ahead of each page
+	feedbackIndex++;
+	missing.clear();
+	uint64_t alreadyResident = 0;
+	for (uint32_t page : requested)
+	{
+		int x = pageX(page), y = pageY(page);
+		for (int level = pageLevel(page); level < levelCount; level++, x >>= 1, y >>= 1)
+		{
+			uint32_t value = entry(level, x, y);
+			if (entryLevel(value) == level)
+			{
+				touch((int)(value & 0xff) + (int)((value >> 8) & 0xff) * physicalTiles);
+				alreadyResident += level == pageLevel(page) ? 1 : 0;
+			}
+			else
+			{
+				missing.push_back(pageKey(level, x, y));
+			}
+		}
+	}
+	// the level is the key's top byte: descending is coarsest first
+	sort(missing.begin(), missing.end(), greater<uint32_t>());
+	missing.erase(unique(missing.begin(), missing.end()), missing.end());
+	lastFeedbackComplete = missing.empty();
+
+	{
+		lock_guard<mutex> lock(queueMutex);
+		counters.feedbackFrames++;
+		counters.pagesRequested += requested.size();
+		counters.pagesResident += alreadyResident;
+		loadQueue.clear();
+		queueHead = 0;
+		for (uint32_t page : missing)
+		{
+			if (loadQueue.size() == MAX_QUEUED_TILES)
+				break;
+			bool pending = find(loading.begin(), loading.end(), page) != loading.end();
+			for (size_t i = 0; i < loaded.size() && !pending; i++)
+				pending = loaded[i].page == page;
+			if (!pending)
+				loadQueue.push_back(page);
+		}
+	}
+	loadReady.notify_all();
+}
+
+void VirtualTexture::uploadTiles()
+{
+	uploading.clear();
+	{
+		lock_guard<mutex> lock(queueMutex);
+		size_t count = min(loaded.size(), (size_t)uploadsPerFrame);
+		uploading.assign(loaded.begin(), loaded.begin() + count);
+		loaded.erase(loaded.begin(), loaded.begin() + count);
+	}
+	if (uploading.empty())
+		return;
+
+	uint64_t uploaded = 0, evicted = 0, dropped = 0;
+	glBindTexture(GL_TEXTURE_2D, atlas.get());
+	glPixelStorei(GL_UNPACK_ALIGNMENT, 4);
+	for (const LoadedTile& tile : uploading)
+	{
+		if (resident(pageLevel(tile.page), pageX(tile.page), pageY(tile.page)))
+			continue;
+		// a slot the latest feedback needed stays: the cache is too small for
+		// the view, dropping the tile beats thrashing
+		int slot = lruTail;
+		if (slot < 0 || (slots[slot].page != NO_PAGE && slots[slot].lastUsed == feedbackIndex))
+		{
+			dropped++;
+			continue;
+		}
+		if (slots[slot].page != NO_PAGE)
+		{
+			evict(slot);
+			evicted++;
+		}
+		glTexSubImage2D(GL_TEXTURE_2D, 0, (slot % physicalTiles) * VIRTUAL_TILE_SIZE, (slot / physicalTiles) * VIRTUAL_TILE_SIZE,
+			VIRTUAL_TILE_SIZE, VIRTUAL_TILE_SIZE, GL_RGBA, GL_UNSIGNED_BYTE, tileBuffers[tile.buffer].data());
+		install(tile.page, slot);
+		touch(slot);
+		uploaded++;
+	}
+	glBindTexture(GL_TEXTURE_2D, 0);
+
+	{
+		lock_guard<mutex> lock(queueMutex);
+		for (const LoadedTile& tile : uploading)
+			freeBuffers.push_back(tile.buffer);
+		counters.tilesUploaded += uploaded;
+		counters.evictions += evicted;
+		counters.cacheFull += dropped;
+	}
+	loadReady.notify_all();
+}
+
+// only the rectangles of each level that changed since the last call
+void VirtualTexture::uploadPageTable()
+{
+	glBindTexture(GL_TEXTURE_2D, pageTableTexture.get());
+	glPixelStorei(GL_UNPACK_ALIGNMENT, 4);
+	for (int level = 0; level < levelCount; level++)
+	{
+		DirtyRect& rect = dirty[level];
+		if (rect.x0 >= rect.x1)
+			continue;
+		int width = pageCount >> level;
+		glPixelStorei(GL_UNPACK_ROW_LENGTH, width);
+		glTexSubImage2D(GL_TEXTURE_2D, level, rect.x0, rect.y0, rect.x1 - rect.x0, rect.y1 - rect.y0, GL_RGBA, GL_UNSIGNED_BYTE,
+			&pageTable[level][(size_t)rect.y0 * width + rect.x0]);
+		rect = DirtyRect();
+	}
+	glPixelStorei(GL_UNPACK_ROW_LENGTH, 0);
+	glBindTexture(GL_TEXTURE_2D, 0);
+}
+
+bool VirtualTexture::resident(int level, int x, int y) const
+{
+	return entryLevel(pageTable[level][(size_t)y * (pageCount >> level) + x]) == level;
+}
+
+// the page and every finer page under it that has nothing closer resident
+// now sample slot
+void VirtualTexture::install(uint32_t page, int slot)
+{
+	const int level = pageLevel(page), px = pageX(page), py = pageY(page);
+	const uint32_t value = (uint32_t)(slot % physicalTiles) | (uint32_t)(slot / physicalTiles) << 8 | (uint32_t)level << 16 | 0xff000000u;
+	for (int l = level; l >= 0; l--)
+	{
+		int shift = level - l, width = pageCount >> l;
+		int x0 = px << shift, y0 = py << shift, x1 = (px + 1) << shift, y1 = (py + 1) << shift;
+		for (int y = y0; y < y1; y++)
+		{
+			uint32_t* row = &pageTable[l][(size_t)y * width];
+			for (int x = x0; x < x1; x++)
+			{
+				if (entryLevel(row[x]) > level)
+					row[x] = value;
+			}
+		}
+		markDirty(l, x0, y0, x1, y1);
+	}
+	slots[slot].page = page;
+}
+
+// what pointed at the slot's page falls back to whatever its parent's entry
+// points at, the parent or its closest resident ancestor
+void VirtualTexture::evict(int slot)
+{
+	const uint32_t page = slots[slot].page;
+	const int level = pageLevel(page), px = pageX(page), py = pageY(page);
+	const uint32_t fallback = entry(level + 1, px >> 1, py >> 1);
+	for (int l = level; l >= 0; l--)
+	{
+		int shift = level - l, width = pageCount >> l;
+		int x0 = px << shift, y0 = py << shift, x1 = (px + 1) << shift, y1 = (py + 1) << shift;
+		for (int y = y0; y < y1; y++)
+		{
+			uint32_t* row = &pageTable[l][(size_t)y * width];
+			for (int x = x0; x < x1; x++)
+			{
+				if (entryLevel(row[x]) == level)
+					row[x] = fallback;
+			}
+		}
+		markDirty(l, x0, y0, x1, y1);
+	}
+	slots[slot].page = NO_PAGE;
+}
+
+// most recently used to the head of the list; slot 0 isn't in it
+void VirtualTexture::touch(int slot)
+{
+	slots[slot].lastUsed = feedbackIndex;
+	if (slot == 0)
+		return;
+	unlink(slot);
+	slots[slot].next = lruHead;
+	if (lruHead >= 0)
+		slots[lruHead].previous = slot;
+	lruHead = slot;
+	if (lruTail < 0)
+		lruTail = slot;
+}
+
+void VirtualTexture::unlink(int slot)
+{
+	Slot& s = slots[slot];
+	if (s.previous >= 0)
+		slots[s.previous].next = s.next;
+	else if (lruHead == slot)
+		lruHead = s.next;
+	if (s.next >= 0)
+		slots[s.next].previous = s.previous;
+	else if (lruTail == slot)
+		lruTail = s.previous;
+	s.previous = s.next = -1;
+}
+
+void VirtualTexture::markDirty(int level, int x0, int y0, int x1, int y1)
+{
+	DirtyRect& rect = dirty[level];
+	if (rect.x0 >= rect.x1)
+	{
+		rect.x0 = x0;
+		rect.y0 = y0;
+		rect.x1 = x1;
+		rect.y1 = y1;
+		return;
+	}
+	rect.x0 = min(rect.x0, x0);
+	rect.y0 = min(rect.y0, y0);
+	rect.x1 = max(rect.x1, x1);
+	rect.y1 = max(rect.y1, y1);
+}
+
+void VirtualTexture::loaderLoop(int index)
+{
+	for (;;)
+	{
+		unique_lock<mutex> lock(queueMutex);
+		loadReady.wait(lock, [this] { return stopping || (queueHead < loadQueue.size() && !freeBuffers.empty()); });
+		if (stopping)
+			break;
+		uint32_t page = loadQueue[queueHead++];
+		int buffer = freeBuffers.back();
+		freeBuffers.pop_back();
+		loading[index] = page;
+		lock.unlock();
+
+		auto start = Clock::now();
+		readTile(source, page, tileBuffers[buffer].data());
+		double milliseconds = chrono::duration<double, milli>(Clock::now() - start).count();
+
+		lock.lock();
+		loading[index] = NO_PAGE;
+		LoadedTile tile = { page, buffer };
+		loaded.push_back(tile);
+		counters.tilesLoaded++;
+		counters.loadMilliseconds += milliseconds;
+	}
+}
+
+Mat4 terrainCamera(float time, float aspect)
+{
+	// a slow circle around the middle of the square, low, looking ahead and down
+	float angle = time * 0.05f;
+	Vec3 eye = { sinf(angle) * 400.0f, 6.0f, cosf(angle) * 400.0f };
+	Vec3 ahead = { cosf(angle), 0.0f, -sinf(angle) };
+	Vec3 target = eye + ahead * 40.0f;
+	target.y = 0.0f;
+	return perspective(1.0f, aspect, 0.1f, 3000.0f) * lookAt(eye, target, { 0.0f, 1.0f, 0.0f });
+}
@@ -0,0 +1,252 @@
+#ifndef VIRTUAL_TEXTURE_H
+#define VIRTUAL_TEXTURE_H
+
+#include <condition_variable>
+#include <cstdint>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+#include <glad/glad.h>
+
+#include "gl_objects.h"
+#include "image_compare.h"
+#include "math3d.h"
+#include "mip_generator.h"
+
+// A tile of the physical cache: VIRTUAL_TILE_CONTENT texels of its page and
+// a border of the neighbouring pages' texels all around, so bilinear
+// filtering near a page edge never reads another tile of the atlas.
+// shaders/virtual_texture.frag has the same numbers.
+const int VIRTUAL_TILE_CONTENT = 120;
+const int VIRTUAL_TILE_BORDER = 4;
+const int VIRTUAL_TILE_SIZE = VIRTUAL_TILE_CONTENT + 2 * VIRTUAL_TILE_BORDER;
+
+// feedback pixels store page coordinates in 12 bits each
+const int MAX_VIRTUAL_PAGES = 4096;
+
+// Where the texels of a virtual texture come from. Level 0 is pages() x
+// pages() pages of VIRTUAL_TILE_CONTENT texels, pages() a power of two, and
+// level l has pages() >> l down to one page.
+class VirtualTextureSource
+{
+public:
+	virtual ~VirtualTextureSource() {}
+	virtual int pages() const = 0;
+	// width x height sRGB RGBA8 texels of level from x, y on, rows in
+	// increasing y like glTexSubImage2D takes them, coordinates outside the
+	// level clamped to its edges. Called from the loader threads, several at
+	// once.
+	virtual void readTexels(int level, int x, int y, int width, int height, uint32_t* texels) const = 0;
+};
+
+// Terrain made up as it is read: fractal value noise for height, colored by
+// height, each level leaving out the octaves finer than its texels.
+// Nothing is stored, so pages can be as many as MAX_VIRTUAL_PAGES.
+class ProceduralTerrainSource : public VirtualTextureSource
+{
+public:
+	explicit ProceduralTerrainSource(int pages, uint32_t seed = 1);
+	int pages() const override { return pageCount; }
+	void readTexels(int level, int x, int y, int width, int height, uint32_t* texels) const override;
+
+private:
+	int pageCount;
+	uint32_t seed;
+};
+
+// An image in memory with the mip chain of generateMips(), padded by its edge
+// texels to the next power of two of pages; what a scan or a baked terrain
+// texture would be streamed from, and the reference to check against.
+class ImageTileSource : public VirtualTextureSource
+{
+public:
+	ImageTileSource(const RgbaImage& image, const MipOptions& options, JobSystem* jobs = nullptr);
+	int pages() const override { return pageCount; }
+	void readTexels(int level, int x, int y, int width, int height, uint32_t* texels) const override;
+
+	// level 0 padded and levels 1 and down, rows bottom-up for glTexImage2D
+	const std::vector<RgbaImage>& levels() const { return mips; }
+
+private:
+	int pageCount;
+	std::vector<RgbaImage> mips;
+};
+
+// Sparse virtual texturing: a texture of any size sampled through a fixed
+// size cache. The atlas holds physicalTiles x physicalTiles tiles, and a page
+// table texture, one texel per page of every level, says where in it each
+// page is, or its closest resident ancestor when it isn't, so a draw samples
+// whatever is resident and sharpens as tiles arrive. The coarsest page is
+// loaded by init() and never evicted.
+//
+// Which pages a frame needs comes from the frame itself: a feedback pass
+// draws the scene at 1/FEEDBACK_DIVISOR of its size with the feedback shader
+// variant, which writes the page and level every pixel would sample, and
+// endFeedback() reads it into a pixel pack buffer behind a fence. update()
+// takes the newest readback whose fence has signaled, a few frames later and
+// without ever waiting, marks the resident pages it names and their
+// ancestors used, and queues the missing ones coarsest first for the loader
+// threads, which read them from the source. It uploads at most
+// uploadsPerFrame of the loaded tiles per call, each into the least recently
+// used slot unless that one was needed by the same feedback, and patches
+// the page table where residency changed. GPU memory is the atlas, the page
+// table at 4 bytes a page and the feedback target: none of it grows with
+// what is looked at, and the loaders only have a fixed number of tile
+// buffers to read into.
+class VirtualTexture
+{
+public:
+	static const int FEEDBACK_DIVISOR = 8;
+
+	// source must outlive the VirtualTexture; 0 loader threads for one per core
+	explicit VirtualTexture(const VirtualTextureSource& source, int physicalTiles = 16, int loaderThreads = 0,
+		int uploadsPerFrame = 8);
+	~VirtualTexture();
+
+	VirtualTexture(const VirtualTexture&) = delete;
+	VirtualTexture& operator=(const VirtualTexture&) = delete;
+
+	// creates the textures, loads the coarsest page and starts the loaders;
+	// render thread with the context current
+	bool init();
+
+	// stops the loaders and retires the GL objects; before glObjects.release()
+	void release();
+
+	// binds a feedback target for a screenWidth x screenHeight frame and
+	// clears it; draw the scene with the feedback variant, then endFeedback()
+	void beginFeedback(int screenWidth, int screenHeight);
+	// queues the readback and binds framebuffer 0 again. When every buffer
+	// of the ring is still waiting for the GPU the frame's feedback is dropped.
+	void endFeedback();
+
+	// call once per frame on the render thread, never blocks
+	void update();
+
+	// binds the page table to texture unit 0 and the atlas to unit 1 and sets
+	// the uniforms of program, which is in use; feedback for the feedback pass
+	void bind(GLuint program, bool feedback) const;
+
+	// the last feedback read back found every page it asked for resident and
+	// nothing is loading
+	bool settled() const;
+
+	struct Stats
+	{
+		uint64_t feedbackFrames = 0;	// readbacks processed
+		uint64_t feedbackDropped = 0;	// frames without a free readback buffer
+		uint64_t pagesRequested = 0;	// distinct pages over all feedback
+		uint64_t pagesResident = 0;		// of those, resident when their feedback came in
+		uint64_t tilesLoaded = 0;
+		uint64_t tilesUploaded = 0;
+		uint64_t evictions = 0;
+		uint64_t cacheFull = 0;			// tiles dropped: every slot was needed by the latest feedback
+		int residentTiles = 0;
+		int slots = 0;
+		size_t atlasBytes = 0;
+		size_t pageTableBytes = 0;
+		double loadMilliseconds = 0.0;	// summed over the loader threads
+		double updateMilliseconds = 0.0;
+		double maxUpdateMilliseconds = 0.0;
+	};
+	Stats stats() const;
+
+private:
+	struct Slot
+	{
+		uint32_t page;			// NO_PAGE when empty
+		uint64_t lastUsed = 0;	// the feedback that last needed it
+		int previous = -1;		// LRU list, most recent at head
+		int next = -1;
+	};
+
+	struct LoadedTile
+	{
+		uint32_t page;
+		int buffer;
+	};
+
+	struct FeedbackBuffer
+	{
+		GLBuffer buffer;
+		size_t bytes = 0;
+		int width = 0;
+		int height = 0;
+		GLsync fence = 0;		// 0 when free
+	};
+
+	struct DirtyRect
+	{
+		int x0 = 0, y0 = 0, x1 = 0, y1 = 0;
+	};
+
+	static constexpr uint32_t NO_PAGE = 0xffffffffu;
+
+	void processFeedback(const uint32_t* pixels, size_t count);
+	void uploadTiles();
+	void uploadPageTable();
+	void loaderLoop(int index);
+
+	bool resident(int level, int x, int y) const;
+	uint32_t& entry(int level, int x, int y) { return pageTable[level][(size_t)y * (pageCount >> level) + x]; }
+	void install(uint32_t page, int slot);
+	void evict(int slot);
+	void touch(int slot);
+	void unlink(int slot);
+	void markDirty(int level, int x0, int y0, int x1, int y1);
+
+	const VirtualTextureSource& source;
+	int pageCount;
+	int levelCount;
+	int physicalTiles;
+	int loaderThreadCount;
+	int uploadsPerFrame;
+
+	GLTexture pageTableTexture;
+	GLTexture atlas;
+	GLTexture feedbackColor;
+	GLTexture feedbackDepth;
+	GLFramebuffer feedbackFramebuffer;
+	int feedbackWidth = 0;
+	int feedbackHeight = 0;
+	int screenWidth = 0;		// the viewport endFeedback() goes back to
+	int screenHeight = 0;
+	std::vector<FeedbackBuffer> feedbackRing;
+	size_t feedbackIssued = 0;
+	size_t feedbackConsumed = 0;
+
+	// render thread only: the page table as uploaded, an RGBA8 entry per page
+	// (slot x, slot y, level of the page in it), and the slots
+	std::vector<std::vector<uint32_t>> pageTable;
+	std::vector<DirtyRect> dirty;
+	std::vector<Slot> slots;
+	int lruHead = -1;
+	int lruTail = -1;
+	uint64_t feedbackIndex = 0;
+	bool lastFeedbackComplete = false;
+	std::vector<uint32_t> requested;
+	std::vector<uint32_t> missing;
+	std::vector<LoadedTile> uploading;
+
+	// shared with the loaders
+	mutable std::mutex queueMutex;
+	std::condition_variable loadReady;
+	std::vector<uint32_t> loadQueue;		// coarsest first, from queueHead on
+	size_t queueHead = 0;
+	std::vector<uint32_t> loading;			// a page per loader, NO_PAGE when idle
+	std::vector<LoadedTile> loaded;
+	std::vector<std::vector<uint32_t>> tileBuffers;
+	std::vector<int> freeBuffers;
+	bool stopping = false;
+	std::vector<std::thread> loaders;
+
+	Stats counters;
+};
+
+// the demo's and the benchmark's ground: a square of TERRAIN_PLANE_SIZE
+// units at y = 0 with the whole virtual texture on it, flown over low
+const float TERRAIN_PLANE_SIZE = 2000.0f;
+Mat4 terrainCamera(float time, float aspect);
+
+#endif